@@ -88,7 +88,13 @@ This script provides helpers for building msquic.
     Uses shared execution contexts (threads) where possible.
 
 .PARAMETER UseXdp
-    Use XDP for the datapath instead of system socket APIs.
+    Use XDP for the datapath instead of system socket APIs. Uses AF_XDP on Linux.
+
+.PARAMETER EnablePosixGro
+    Enables UDP GRO receive coalescing on Linux.
+
+.PARAMETER UseIoUring
+    Use io_uring for the datapath on Linux.
 
 .PARAMETER ExtraArtifactDir
     Add an extra classifier to the artifact directory to allow publishing alternate builds of same base library
@@ -193,6 +199,12 @@ param (
     [Parameter(Mandatory = $false)]
     [switch]$UseXdp = $false,
 
+    [Parameter(Mandatory = $false)]
+    [switch]$EnablePosixGro = $false,
+
+    [Parameter(Mandatory = $false)]
+    [switch]$UseIoUring = $false,
+
     [Parameter(Mandatory = $false)]
     [string]$ExtraArtifactDir = "",
 
@@ -420,6 +432,12 @@ function CMake-Generate {
     if ($UseXdp) {
         $Arguments += " -DQUIC_USE_XDP=on"
     }
+    if ($EnablePosixGro) {
+        $Arguments += " -DQUIC_ENABLE_POSIX_GRO=on"
+    }
+    if ($UseIoUring) {
+        $Arguments += " -DQUIC_LINUX_IOURING=on"
+    }
     if ($Platform -eq "android") {
         $env:PATH = "$env:ANDROID_NDK_ROOT/toolchains/llvm/prebuilt/linux-x86_64/bin:$env:PATH"
         switch ($Arch) {
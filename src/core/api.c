@@ -664,6 +664,7 @@ MsQuicStreamOpen(
             FALSE,
             !!(Flags & QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL),
             !!(Flags & QUIC_STREAM_OPEN_FLAG_0_RTT),
+            !!(Flags & QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS),
             (QUIC_STREAM**)NewStream);
     if (QUIC_FAILED(Status)) {
         goto Error;
@@ -1222,6 +1223,142 @@ Error:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamProvideReceiveBuffers(
+    _In_ _Pre_defensive_ HQUIC Handle,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection;
+    QUIC_OPERATION* Oper;
+    QUIC_BUFFER* BuffersCopy = NULL;
+    uint64_t TotalLength = 0;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_PROVIDE_RECEIVE_BUFFERS,
+        Handle);
+
+    if (!IS_STREAM_HANDLE(Handle) ||
+        Buffers == NULL ||
+        BufferCount == 0) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        if (Buffers[i].Buffer == NULL || Buffers[i].Length == 0) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+        TotalLength += Buffers[i].Length;
+    }
+
+    if (TotalLength > UINT32_MAX) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Error;
+    }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+    Stream = (QUIC_STREAM*)Handle;
+
+    CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+    CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+    if (Stream->Flags.RemoteNotAllowed) {
+        //
+        // The stream has no receive direction. This never changes, so it's
+        // checked here instead of failing the queued call.
+        //
+        Status = QUIC_STATUS_INVALID_STATE;
+        goto Error;
+    }
+
+    Connection = Stream->Connection;
+
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    if (Connection->WorkerThreadID == CxPlatCurThreadID()) {
+        //
+        // Execute inline if called on the worker thread, so that buffers
+        // provided from the PEER_STREAM_STARTED callback are in place before
+        // any data is received.
+        //
+        BOOLEAN AlreadyInline = Connection->State.InlineApiExecution;
+        if (!AlreadyInline) {
+            Connection->State.InlineApiExecution = TRUE;
+        }
+        Status = QuicStreamProvideRecvBuffers(Stream, BufferCount, Buffers);
+        if (!AlreadyInline) {
+            Connection->State.InlineApiExecution = FALSE;
+        }
+        goto Error;
+    }
+
+    BuffersCopy =
+        CXPLAT_ALLOC_NONPAGED(
+            BufferCount * sizeof(QUIC_BUFFER),
+            QUIC_POOL_PROVIDED_RECV_BUFFERS);
+    if (BuffersCopy == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Provided receive buffers",
+            BufferCount * sizeof(QUIC_BUFFER));
+        goto Error;
+    }
+    CxPlatCopyMemory(BuffersCopy, Buffers, BufferCount * sizeof(QUIC_BUFFER));
+
+    Oper = QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_PROVIDE_RECV_BUFFERS, operation",
+            0);
+        CXPLAT_FREE(BuffersCopy, QUIC_POOL_PROVIDED_RECV_BUFFERS);
+        goto Error;
+    }
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS;
+    Oper->API_CALL.Context->STRM_PROVIDE_RECV_BUFFERS.Stream = Stream;
+    Oper->API_CALL.Context->STRM_PROVIDE_RECV_BUFFERS.BufferCount = BufferCount;
+    Oper->API_CALL.Context->STRM_PROVIDE_RECV_BUFFERS.Buffers = BuffersCopy;
+
+    //
+    // Async stream operations need to hold a ref on the stream so that the
+    // stream isn't freed before the operation can be processed. The ref is
+    // released after the operation is processed.
+    //
+    QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+
+    //
+    // Queue the operation but don't wait for the completion.
+    //
+    QuicConnQueueOper(Connection, Oper);
+    Status = QUIC_STATUS_PENDING;
+
+Error:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QUIC_API
@@ -1549,8 +1686,8 @@ MsQuicDatagramSend(
 {
     QUIC_STATUS Status;
     QUIC_CONNECTION* Connection;
-    uint64_t TotalLength;
     QUIC_SEND_REQUEST* SendRequest;
+    uint64_t ExpirationTime = 0;
 
     QuicTraceEvent(
         ApiEnter,
@@ -1558,9 +1695,7 @@ MsQuicDatagramSend(
         QUIC_TRACE_API_DATAGRAM_SEND,
         Handle);
 
-    if (!IS_CONN_HANDLE(Handle) ||
-        Buffers == NULL ||
-        BufferCount == 0) {
+    if (!IS_CONN_HANDLE(Handle)) {
         Status = QUIC_STATUS_INVALID_PARAMETER;
         goto Error;
     }
@@ -1570,36 +1705,84 @@ MsQuicDatagramSend(
 
     CXPLAT_TEL_ASSERT(!Connection->State.Freed);
 
-    TotalLength = 0;
-    for (uint32_t i = 0; i < BufferCount; ++i) {
-        TotalLength += Buffers[i].Length;
+    Status =
+        QuicDatagramSendRequestAlloc(
+            &Connection->Datagram,
+            Buffers,
+            BufferCount,
+            Flags,
+            ClientSendContext,
+            &ExpirationTime,
+            &SendRequest);
+    if (QUIC_FAILED(Status)) {
+        goto Error;
     }
 
-    if (TotalLength > UINT16_MAX) {
-        QuicTraceEvent(
-            ConnError,
-            "[conn][%p] ERROR, %s.",
-            Connection,
-            "Send request total length exceeds max");
+    Status = QuicDatagramQueueSend(&Connection->Datagram, SendRequest);
+
+Error:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicDatagramSendBatch(
+    _In_ uint32_t EntryCount,
+    _Inout_updates_(EntryCount) _Pre_defensive_
+        QUIC_DATAGRAM_SEND_ENTRY* Entries
+    )
+{
+    QUIC_STATUS Status;
+    uint32_t i, j;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
+        Entries);
+
+    if (Entries == NULL || EntryCount == 0) {
         Status = QUIC_STATUS_INVALID_PARAMETER;
         goto Error;
     }
 
-#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (...).")
-    SendRequest = CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
-    if (SendRequest == NULL) {
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        goto Error;
-    }
+    //
+    // Each run of consecutive entries for the same connection is queued with
+    // a single acquisition of its datagram lock and at most one operation.
+    //
+    for (i = 0; i < EntryCount; i = j) {
+        HQUIC Handle = Entries[i].Connection;
+        for (j = i + 1; j < EntryCount && Entries[j].Connection == Handle; ++j) { }
 
-    SendRequest->Next = NULL;
-    SendRequest->Buffers = Buffers;
-    SendRequest->BufferCount = BufferCount;
-    SendRequest->Flags = Flags;
-    SendRequest->TotalLength = TotalLength;
-    SendRequest->ClientContext = ClientSendContext;
+        if (!IS_CONN_HANDLE(Handle)) {
+            for (uint32_t k = i; k < j; ++k) {
+                Entries[k].Status = QUIC_STATUS_INVALID_PARAMETER;
+            }
+            continue;
+        }
 
-    Status = QuicDatagramQueueSend(&Connection->Datagram, SendRequest);
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+        QUIC_CONNECTION* Connection = (QUIC_CONNECTION*)Handle;
+
+        CXPLAT_TEL_ASSERT(!Connection->State.Freed);
+
+        QuicDatagramQueueSendBatch(&Connection->Datagram, j - i, Entries + i);
+    }
+
+    Status = QUIC_STATUS_PENDING;
+    for (i = 0; i < EntryCount; ++i) {
+        if (Entries[i].Status != QUIC_STATUS_PENDING) {
+            Status = Entries[i].Status;
+            break;
+        }
+    }
 
 Error:
 
@@ -0,0 +1,1186 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    BBRv2 congestion control (draft-cardwell-iccrg-bbr-congestion-control-02).
+
+    Instead of reacting to loss, BBR builds a model of the path from the
+    delivery rate and RTT samples provided by loss detection: the bottleneck
+    bandwidth (windowed max of the delivery rate) and the round trip
+    propagation time (windowed min RTT). The send rate is then paced at a gain
+    over the bandwidth estimate, and the window is set to a gain over the
+    bandwidth-delay product. Loss and ECN CE marks only bound the model
+    (InflightHi/Lo, BwLo).
+
+Future work:
+
+    - ACK aggregation (extra_acked) compensation in the window.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "bbr.c.clog.h"
+#endif
+
+#include "bbr.h"
+
+//
+// Gains are fixed point with 8 fractional bits.
+//
+#define BBR_UNIT 256
+
+#define BBR_STARTUP_PACING_GAIN 709 // 2.77
+#define BBR_DRAIN_PACING_GAIN 92 // 1 / 2.77
+#define BBR_DEFAULT_CWND_GAIN 512 // 2.0
+#define BBR_PROBE_DOWN_PACING_GAIN 230 // 0.9
+#define BBR_PROBE_UP_PACING_GAIN 320 // 1.25
+#define BBR_PROBE_UP_CWND_GAIN 576 // 2.25
+#define BBR_PROBE_RTT_CWND_GAIN 128 // 0.5
+
+//
+// Multiplicative decrease of the short term model bounds on loss, and the
+// fraction of InflightHi to leave free for other flows when cruising.
+//
+#define BBR_BETA 179 // 0.7
+#define BBR_HEADROOM 218 // 0.85
+
+//
+// STARTUP exits after this many rounds without 25% bandwidth growth.
+//
+#define BBR_STARTUP_GROWTH_TARGET 320 // 1.25
+#define BBR_STARTUP_FULL_BW_ROUNDS 3
+
+//
+// The maximum tolerated per-round loss rate while probing for bandwidth.
+//
+#define BBR_LOSS_THRESH_PERCENT 2
+
+//
+// The maximum tolerated per-round fraction of CE marked packets while probing
+// for bandwidth, and the minimum number of packets with ECN feedback in the
+// round needed to judge it.
+//
+#define BBR_ECN_THRESH_PERCENT 50
+#define BBR_ECN_MIN_PACKETS 4
+
+//
+// Pace slightly below the estimated bandwidth to drain queues.
+//
+#define BBR_PACING_MARGIN_PERCENT 1
+
+#define BBR_MAX_BW_FILTER_LEN 2 // bandwidth probing cycles
+#define BBR_MIN_RTT_FILTER_LEN S_TO_US(10)
+#define BBR_PROBE_RTT_INTERVAL S_TO_US(5)
+#define BBR_PROBE_RTT_DURATION MS_TO_US(200)
+#define BBR_PROBE_BW_MAX_ROUNDS 63
+#define BBR_PROBE_BW_WAIT_BASE S_TO_US(2)
+#define BBR_PROBE_BW_WAIT_RAND S_TO_US(1)
+
+#define BBR_MIN_CWND_PACKETS 4
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrMaxFilterReset(
+    _Inout_ BBR_MAX_FILTER* Filter,
+    _In_ uint64_t Time,
+    _In_ uint64_t Value
+    )
+{
+    Filter->Samples[0].Time = Filter->Samples[1].Time = Filter->Samples[2].Time = Time;
+    Filter->Samples[0].Value = Filter->Samples[1].Value = Filter->Samples[2].Value = Value;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrMaxFilterUpdate(
+    _Inout_ BBR_MAX_FILTER* Filter,
+    _In_ uint64_t Window,
+    _In_ uint64_t Time,
+    _In_ uint64_t Value
+    )
+{
+    const BBR_MAX_FILTER_SAMPLE New = { Time, Value };
+
+    if (Value >= Filter->Samples[0].Value ||
+        Time - Filter->Samples[2].Time > Window) {
+        //
+        // New best sample, or nothing left in the window.
+        //
+        BbrMaxFilterReset(Filter, Time, Value);
+        return;
+    }
+
+    if (Value >= Filter->Samples[1].Value) {
+        Filter->Samples[2] = Filter->Samples[1] = New;
+    } else if (Value >= Filter->Samples[2].Value) {
+        Filter->Samples[2] = New;
+    }
+
+    //
+    // Age out the best samples as they leave the window, and keep the
+    // second and third best from different quarters/halves of the window.
+    //
+    const uint64_t Elapsed = Time - Filter->Samples[0].Time;
+    if (Elapsed > Window) {
+        Filter->Samples[0] = Filter->Samples[1];
+        Filter->Samples[1] = Filter->Samples[2];
+        Filter->Samples[2] = New;
+        if (Time - Filter->Samples[0].Time > Window) {
+            Filter->Samples[0] = Filter->Samples[1];
+            Filter->Samples[1] = Filter->Samples[2];
+            Filter->Samples[2] = New;
+        }
+    } else if (Filter->Samples[1].Time == Filter->Samples[0].Time &&
+               Elapsed > Window / 4) {
+        Filter->Samples[2] = Filter->Samples[1] = New;
+    } else if (Filter->Samples[2].Time == Filter->Samples[1].Time &&
+               Elapsed > Window / 2) {
+        Filter->Samples[2] = New;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnLogBbr(
+    _In_ const QUIC_CONNECTION* const Connection
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Connection->CongestionControl.Bbr;
+    UNREFERENCED_PARAMETER(Bbr);
+
+    QuicTraceLogConnVerbose(
+        ConnBbr,
+        Connection,
+        "BBR: State=%hhu Phase=%hhu MaxBw=%llu MinRtt=%u PacingRate=%llu CWnd=%u InflightHi=%u",
+        Bbr->State,
+        Bbr->ProbeBwPhase,
+        Bbr->MaxBwFilter.Samples[0].Value,
+        Bbr->MinRtt,
+        Bbr->PacingRate,
+        Bbr->CongestionWindow,
+        Bbr->InflightHi);
+}
+
+//
+// The bandwidth estimate used for pacing and the window, in bytes per second.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+BbrGetBandwidth(
+    _In_ const QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    return CXPLAT_MIN(Bbr->MaxBwFilter.Samples[0].Value, Bbr->BwLo);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+BbrGetMinCongestionWindow(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    return
+        (uint32_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+        BBR_MIN_CWND_PACKETS;
+}
+
+//
+// Returns Gain times the estimated bandwidth-delay product, in bytes.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+BbrGetBdp(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t Gain
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint64_t Bandwidth = BbrGetBandwidth(Bbr);
+
+    uint64_t Bdp;
+    if (Bbr->MinRtt == UINT32_MAX || Bandwidth == 0) {
+        //
+        // No model yet, so fall back to the initial window.
+        //
+        Bdp =
+            (uint64_t)QuicPathGetDatagramPayloadSize(&Connection->Paths[0]) *
+            Bbr->InitialWindowPackets;
+    } else {
+        Bdp = Bandwidth * Bbr->MinRtt / S_TO_US(1);
+    }
+
+    Bdp = Bdp * Gain / BBR_UNIT;
+    return (uint32_t)CXPLAT_MIN(Bdp, UINT32_MAX);
+}
+
+//
+// The amount of inflight data to leave free for other flows when cruising.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+BbrGetInflightWithHeadroom(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    if (Bbr->InflightHi == UINT32_MAX) {
+        return UINT32_MAX;
+    }
+    return
+        CXPLAT_MAX(
+            (uint32_t)((uint64_t)Bbr->InflightHi * BBR_HEADROOM / BBR_UNIT),
+            BbrGetMinCongestionWindow(QuicCongestionControlGetConnection(Cc)));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrStartRound(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    Bbr->NextRoundDelivered = Bbr->DeliveredBytes;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrResetLowerBounds(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    Bbr->BwLo = UINT64_MAX;
+    Bbr->InflightLo = UINT32_MAX;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrSetPacingRate(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    const uint64_t Bandwidth = BbrGetBandwidth(Bbr);
+    if (Bandwidth == 0) {
+        return;
+    }
+
+    const uint64_t Rate =
+        Bandwidth * Bbr->PacingGain / BBR_UNIT *
+        (100 - BBR_PACING_MARGIN_PERCENT) / 100;
+
+    //
+    // Until the pipe is full, never slow down below the initial pacing rate.
+    //
+    if (Bbr->FilledPipe || Rate > Bbr->PacingRate) {
+        Bbr->PacingRate = Rate;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrEnterStartup(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr
+    )
+{
+    Bbr->State = BBR_STATE_STARTUP;
+    Bbr->PacingGain = BBR_STARTUP_PACING_GAIN;
+    Bbr->CwndGain = BBR_DEFAULT_CWND_GAIN;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrStartProbeBwDown(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    uint32_t Random;
+    CxPlatRandom(sizeof(Random), &Random);
+
+    Bbr->State = BBR_STATE_PROBE_BW;
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_DOWN;
+    Bbr->PacingGain = BBR_PROBE_DOWN_PACING_GAIN;
+    Bbr->CwndGain = BBR_DEFAULT_CWND_GAIN;
+    Bbr->BwProbeUpRounds = 0;
+    Bbr->RoundsSinceBwProbe = 0;
+    Bbr->BwProbeWait = BBR_PROBE_BW_WAIT_BASE + (Random % BBR_PROBE_BW_WAIT_RAND);
+    Bbr->CycleStartTime = TimeNow;
+    Bbr->PhaseStartTime = TimeNow;
+
+    //
+    // Each new cycle advances the max bandwidth filter's time base.
+    //
+    Bbr->CycleCount++;
+    BbrStartRound(Bbr);
+
+    QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrStartProbeBwCruise(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr,
+    _In_ uint64_t TimeNow
+    )
+{
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_CRUISE;
+    Bbr->PacingGain = BBR_UNIT;
+    Bbr->CwndGain = BBR_DEFAULT_CWND_GAIN;
+    Bbr->PhaseStartTime = TimeNow;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrStartProbeBwRefill(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr,
+    _In_ uint64_t TimeNow
+    )
+{
+    BbrResetLowerBounds(Bbr);
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_REFILL;
+    Bbr->PacingGain = BBR_UNIT;
+    Bbr->CwndGain = BBR_DEFAULT_CWND_GAIN;
+    Bbr->BwProbeUpRounds = 0;
+    Bbr->PhaseStartTime = TimeNow;
+    BbrStartRound(Bbr);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrStartProbeBwUp(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr,
+    _In_ uint64_t TimeNow
+    )
+{
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_UP;
+    Bbr->PacingGain = BBR_PROBE_UP_PACING_GAIN;
+    Bbr->CwndGain = BBR_PROBE_UP_CWND_GAIN;
+    Bbr->PhaseStartTime = TimeNow;
+    BbrStartRound(Bbr);
+}
+
+//
+// Returns TRUE if the cycle moved on to probing for more bandwidth.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCheckTimeToProbeBw(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr,
+    _In_ uint64_t TimeNow
+    )
+{
+    if (CxPlatTimeDiff64(Bbr->CycleStartTime, TimeNow) > Bbr->BwProbeWait ||
+        Bbr->RoundsSinceBwProbe >= BBR_PROBE_BW_MAX_ROUNDS) {
+        BbrStartProbeBwRefill(Bbr, TimeNow);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrUpdateProbeBwCyclePhase(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    switch (Bbr->ProbeBwPhase) {
+    case BBR_PROBE_BW_DOWN:
+        if (BbrCheckTimeToProbeBw(Bbr, TimeNow)) {
+            break;
+        }
+        //
+        // Cruise once the queue built up while probing has drained.
+        //
+        if (Bbr->BytesInFlight <= BbrGetInflightWithHeadroom(Cc) &&
+            Bbr->BytesInFlight <= BbrGetBdp(Cc, BBR_UNIT)) {
+            BbrStartProbeBwCruise(Bbr, TimeNow);
+        }
+        break;
+
+    case BBR_PROBE_BW_CRUISE:
+        (void)BbrCheckTimeToProbeBw(Bbr, TimeNow);
+        break;
+
+    case BBR_PROBE_BW_REFILL:
+        //
+        // Spend one round refilling the pipe at the estimated bandwidth
+        // before probing above it.
+        //
+        if (Bbr->RoundStart) {
+            BbrStartProbeBwUp(Bbr, TimeNow);
+        }
+        break;
+
+    case BBR_PROBE_BW_UP:
+        if (CxPlatTimeDiff64(Bbr->PhaseStartTime, TimeNow) > Bbr->MinRtt &&
+            Bbr->BytesInFlight > BbrGetBdp(Cc, BBR_PROBE_UP_PACING_GAIN)) {
+            BbrStartProbeBwDown(Cc, TimeNow);
+        }
+        break;
+    }
+}
+
+//
+// Called when the loss rate while probing (in STARTUP or PROBE_BW UP) shows
+// the path can't hold the current inflight data.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrHandleInflightTooHigh(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t PriorBytesInFlight
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+
+    QuicTraceEvent(
+        ConnCongestion,
+        "[conn][%p] Congestion event",
+        Connection);
+    Connection->Stats.Send.CongestionCount++;
+
+    Bbr->InflightHi =
+        CXPLAT_MAX(
+            PriorBytesInFlight,
+            (uint32_t)((uint64_t)BbrGetBdp(Cc, BBR_UNIT) * BBR_BETA / BBR_UNIT));
+
+    if (Bbr->State == BBR_STATE_STARTUP) {
+        Bbr->FilledPipe = TRUE;
+    } else if (Bbr->ProbeBwPhase == BBR_PROBE_BW_UP) {
+        BbrStartProbeBwDown(Cc, CxPlatTimeUs64());
+    }
+}
+
+//
+// Once per round with loss (and while not probing), reduce the short term
+// model bounds towards what was actually delivered in that round.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrAdaptLowerBounds(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    if (Bbr->State == BBR_STATE_STARTUP ||
+        (Bbr->State == BBR_STATE_PROBE_BW &&
+         (Bbr->ProbeBwPhase == BBR_PROBE_BW_REFILL ||
+          Bbr->ProbeBwPhase == BBR_PROBE_BW_UP))) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    Connection->Stats.Send.CongestionCount++;
+
+    if (Bbr->BwLo == UINT64_MAX) {
+        Bbr->BwLo = Bbr->MaxBwFilter.Samples[0].Value;
+    }
+    if (Bbr->InflightLo == UINT32_MAX) {
+        Bbr->InflightLo = Bbr->CongestionWindow;
+    }
+
+    Bbr->BwLo = CXPLAT_MAX(Bbr->BwLatest, Bbr->BwLo * BBR_BETA / BBR_UNIT);
+    Bbr->InflightLo =
+        (uint32_t)CXPLAT_MAX(
+            CXPLAT_MIN(Bbr->DeliveredInRound, UINT32_MAX),
+            (uint64_t)Bbr->InflightLo * BBR_BETA / BBR_UNIT);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrUpdateMinRtt(
+    _In_ QUIC_CONGESTION_CONTROL_BBR* Bbr,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    const uint64_t TimeNow = AckEvent->TimeNow;
+
+    Bbr->ProbeRttExpired =
+        CxPlatTimeDiff64(Bbr->ProbeRttMinTimestamp, TimeNow) > BBR_PROBE_RTT_INTERVAL;
+    if (AckEvent->LatestRtt != 0 &&
+        (AckEvent->LatestRtt < Bbr->ProbeRttMinRtt || Bbr->ProbeRttExpired)) {
+        Bbr->ProbeRttMinRtt = AckEvent->LatestRtt;
+        Bbr->ProbeRttMinTimestamp = TimeNow;
+    }
+
+    if (Bbr->ProbeRttMinRtt < Bbr->MinRtt ||
+        CxPlatTimeDiff64(Bbr->MinRttTimestamp, TimeNow) > BBR_MIN_RTT_FILTER_LEN) {
+        Bbr->MinRtt = Bbr->ProbeRttMinRtt;
+        Bbr->MinRttTimestamp = Bbr->ProbeRttMinTimestamp;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCheckProbeRtt(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    if (Bbr->State != BBR_STATE_PROBE_RTT && Bbr->ProbeRttExpired) {
+        Bbr->State = BBR_STATE_PROBE_RTT;
+        Bbr->PacingGain = BBR_UNIT;
+        Bbr->CwndGain = BBR_PROBE_RTT_CWND_GAIN;
+        Bbr->PriorCongestionWindow = Bbr->CongestionWindow;
+        Bbr->ProbeRttDoneTime = 0;
+        QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (Bbr->State != BBR_STATE_PROBE_RTT) {
+        return;
+    }
+
+    const uint32_t ProbeRttCwnd =
+        CXPLAT_MAX(
+            BbrGetBdp(Cc, BBR_PROBE_RTT_CWND_GAIN),
+            BbrGetMinCongestionWindow(QuicCongestionControlGetConnection(Cc)));
+
+    if (Bbr->ProbeRttDoneTime == 0) {
+        if (Bbr->BytesInFlight <= ProbeRttCwnd) {
+            //
+            // Hold the reduced inflight for at least BBR_PROBE_RTT_DURATION
+            // and one round trip.
+            //
+            Bbr->ProbeRttDoneTime = TimeNow + BBR_PROBE_RTT_DURATION;
+            Bbr->ProbeRttRoundDone = FALSE;
+            BbrStartRound(Bbr);
+        }
+        return;
+    }
+
+    if (Bbr->RoundStart) {
+        Bbr->ProbeRttRoundDone = TRUE;
+    }
+
+    if (Bbr->ProbeRttRoundDone &&
+        CxPlatTimeAtOrBefore64(Bbr->ProbeRttDoneTime, TimeNow)) {
+        Bbr->ProbeRttMinTimestamp = TimeNow;
+        Bbr->CongestionWindow =
+            CXPLAT_MAX(Bbr->CongestionWindow, Bbr->PriorCongestionWindow);
+        BbrResetLowerBounds(Bbr);
+        if (Bbr->FilledPipe) {
+            BbrStartProbeBwDown(Cc, TimeNow);
+            BbrStartProbeBwCruise(Bbr, TimeNow);
+        } else {
+            BbrEnterStartup(Bbr);
+            QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
+        }
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrUpdateCongestionWindow(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t BytesAcked
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    const uint32_t MinCwnd = BbrGetMinCongestionWindow(Connection);
+
+    //
+    // Allow a few extra packets over the target to absorb send batching.
+    //
+    const uint64_t Target =
+        (uint64_t)BbrGetBdp(Cc, Bbr->CwndGain) + 3 * DatagramPayloadLength;
+
+    uint64_t Cwnd = Bbr->CongestionWindow;
+    if (Bbr->FilledPipe) {
+        Cwnd = CXPLAT_MIN(Cwnd + BytesAcked, Target);
+    } else if (Cwnd < Target ||
+               Bbr->DeliveredBytes < (uint64_t)DatagramPayloadLength * Bbr->InitialWindowPackets) {
+        Cwnd += BytesAcked;
+    }
+
+    //
+    // Bound the window by the model.
+    //
+    uint64_t Cap = UINT32_MAX;
+    if (Bbr->State == BBR_STATE_PROBE_BW && Bbr->ProbeBwPhase != BBR_PROBE_BW_CRUISE) {
+        Cap = Bbr->InflightHi;
+    } else if (Bbr->State == BBR_STATE_PROBE_RTT ||
+               (Bbr->State == BBR_STATE_PROBE_BW && Bbr->ProbeBwPhase == BBR_PROBE_BW_CRUISE)) {
+        Cap = BbrGetInflightWithHeadroom(Cc);
+    }
+    Cap = CXPLAT_MIN(Cap, Bbr->InflightLo);
+    Cap = CXPLAT_MAX(Cap, MinCwnd);
+    Cwnd = CXPLAT_MIN(Cwnd, Cap);
+
+    if (Bbr->State == BBR_STATE_PROBE_RTT) {
+        Cwnd =
+            CXPLAT_MIN(
+                Cwnd,
+                CXPLAT_MAX(BbrGetBdp(Cc, BBR_PROBE_RTT_CWND_GAIN), MinCwnd));
+    }
+
+    Bbr->CongestionWindow = (uint32_t)CXPLAT_MAX(Cwnd, MinCwnd);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlCanSend(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    return Bbr->BytesInFlight < Bbr->CongestionWindow || Bbr->Exemptions > 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlSetExemption(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint8_t NumPackets
+    )
+{
+    Cc->Bbr.Exemptions = NumPackets;
+}
+
+//
+// Resets the path model and starts over in STARTUP.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrResetModel(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const uint16_t DatagramPayloadLength =
+        QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+    const uint64_t TimeNow = CxPlatTimeUs64();
+
+    Bbr->FilledPipe = FALSE;
+    Bbr->RoundStart = FALSE;
+    Bbr->ProbeRttRoundDone = FALSE;
+    Bbr->ProbeRttExpired = FALSE;
+    Bbr->LossInRound = FALSE;
+    Bbr->EcnInRound = FALSE;
+    Bbr->CongestionWindow = DatagramPayloadLength * Bbr->InitialWindowPackets;
+    Bbr->PriorCongestionWindow = Bbr->CongestionWindow;
+    Bbr->BytesInFlightMax = Bbr->CongestionWindow / 2;
+    Bbr->LastSendAllowance = 0;
+    Bbr->ProbeBwPhase = BBR_PROBE_BW_DOWN;
+    BbrEnterStartup(Bbr);
+
+    BbrMaxFilterReset(&Bbr->MaxBwFilter, 0, 0);
+    Bbr->CycleCount = 0;
+    Bbr->MinRtt = UINT32_MAX;
+    Bbr->MinRttTimestamp = TimeNow;
+    Bbr->ProbeRttMinRtt = UINT32_MAX;
+    Bbr->ProbeRttMinTimestamp = TimeNow;
+    Bbr->ProbeRttDoneTime = 0;
+    Bbr->RoundCount = 0;
+    Bbr->NextRoundDelivered = 0;
+    Bbr->FullBw = 0;
+    Bbr->FullBwCount = 0;
+    Bbr->CycleStartTime = TimeNow;
+    Bbr->PhaseStartTime = TimeNow;
+    Bbr->BwProbeWait = 0;
+    Bbr->RoundsSinceBwProbe = 0;
+    Bbr->BwProbeUpRounds = 0;
+    Bbr->InflightHi = UINT32_MAX;
+    BbrResetLowerBounds(Bbr);
+    Bbr->RoundStartDelivered = Bbr->DeliveredBytes;
+    Bbr->DeliveredInRound = 0;
+    Bbr->LostInRound = 0;
+    Bbr->BwLatest = 0;
+    Bbr->EctInRound = 0;
+    Bbr->CeInRound = 0;
+
+    //
+    // Until there is a bandwidth sample, pace the initial window over the
+    // (initial) RTT at the STARTUP gain.
+    //
+    const uint32_t Rtt =
+        CXPLAT_MAX(Connection->Paths[0].SmoothedRtt, 1);
+    Bbr->PacingRate =
+        (uint64_t)Bbr->CongestionWindow * S_TO_US(1) / Rtt *
+        BBR_STARTUP_PACING_GAIN / BBR_UNIT;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlReset(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN FullReset
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    BbrResetModel(Cc);
+    if (FullReset) {
+        Bbr->BytesInFlight = 0;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    QuicConnLogBbr(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+BbrCongestionControlGetSendAllowance(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint64_t TimeSinceLastSend, // microsec
+    _In_ BOOLEAN TimeSinceLastSendValid
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    uint32_t SendAllowance;
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (Bbr->BytesInFlight >= Bbr->CongestionWindow) {
+        //
+        // We are CC blocked, so we can't send anything.
+        //
+        SendAllowance = 0;
+
+    } else if (
+        !TimeSinceLastSendValid ||
+        !Connection->Settings.PacingEnabled ||
+        !Connection->Paths[0].GotFirstRttSample ||
+        Connection->Paths[0].SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        //
+        // We're not in the necessary state to pace.
+        //
+        SendAllowance = Bbr->CongestionWindow - Bbr->BytesInFlight;
+
+    } else {
+        //
+        // We are pacing, so the send allowance is the pacing rate times the
+        // time since the last send. Anything beyond one RTT's worth would be
+        // capped by the window anyway, so limit the time to avoid overflow.
+        //
+        if (TimeSinceLastSend > Connection->Paths[0].SmoothedRtt) {
+            TimeSinceLastSend = Connection->Paths[0].SmoothedRtt;
+        }
+        const uint64_t Allowance =
+            Bbr->LastSendAllowance + Bbr->PacingRate * TimeSinceLastSend / S_TO_US(1);
+        if (Allowance > (Bbr->CongestionWindow - Bbr->BytesInFlight)) {
+            SendAllowance = Bbr->CongestionWindow - Bbr->BytesInFlight;
+        } else {
+            SendAllowance = (uint32_t)Allowance;
+        }
+
+        Bbr->LastSendAllowance = SendAllowance;
+    }
+    return SendAllowance;
+}
+
+//
+// Returns TRUE if we became unblocked.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlUpdateBlockedState(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ BOOLEAN PreviousCanSendState
+    )
+{
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    QuicConnLogOutFlowStats(Connection);
+    if (PreviousCanSendState != BbrCongestionControlCanSend(Cc)) {
+        if (PreviousCanSendState) {
+            QuicConnAddOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+        } else {
+            QuicConnRemoveOutFlowBlockedReason(
+                Connection, QUIC_FLOW_BLOCKED_CONGESTION_CONTROL);
+            Connection->Send.LastFlushTime = CxPlatTimeUs64(); // Reset last flush time
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+BbrCongestionControlOnDataSent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+
+    Bbr->BytesInFlight += NumRetransmittableBytes;
+    if (Bbr->BytesInFlightMax < Bbr->BytesInFlight) {
+        Bbr->BytesInFlightMax = Bbr->BytesInFlight;
+        QuicSendBufferConnectionAdjust(QuicCongestionControlGetConnection(Cc));
+    }
+
+    if (NumRetransmittableBytes > Bbr->LastSendAllowance) {
+        Bbr->LastSendAllowance = 0;
+    } else {
+        Bbr->LastSendAllowance -= NumRetransmittableBytes;
+    }
+
+    if (Bbr->Exemptions > 0) {
+        --Bbr->Exemptions;
+    }
+
+    BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlOnDataInvalidated(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ uint32_t NumRetransmittableBytes
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+
+    CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= NumRetransmittableBytes);
+    Bbr->BytesInFlight -= NumRetransmittableBytes;
+
+    return BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlOnDataAcknowledged(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    const uint64_t TimeNow = AckEvent->TimeNow;
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+    const uint8_t PreviousState = Bbr->State;
+
+    CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= AckEvent->NumRetransmittableBytes);
+    Bbr->BytesInFlight -= AckEvent->NumRetransmittableBytes;
+
+    //
+    // Update the round trip count and the latest delivery signals.
+    //
+    Bbr->DeliveredBytes = AckEvent->DeliveredBytes;
+    Bbr->DeliveredInRound = Bbr->DeliveredBytes - Bbr->RoundStartDelivered;
+    Bbr->RoundStart = FALSE;
+    if (AckEvent->IsPriorDeliveredValid &&
+        AckEvent->PriorDeliveredBytes >= Bbr->NextRoundDelivered) {
+        BbrStartRound(Bbr);
+        Bbr->RoundCount++;
+        Bbr->RoundsSinceBwProbe++;
+        Bbr->RoundStart = TRUE;
+    }
+
+    //
+    // App-limited samples only underestimate the bandwidth, so they are only
+    // used if they raise the estimate.
+    //
+    if (AckEvent->DeliveryRate != 0 &&
+        (!AckEvent->IsAppLimited ||
+         AckEvent->DeliveryRate >= Bbr->MaxBwFilter.Samples[0].Value)) {
+        Bbr->BwLatest = CXPLAT_MAX(Bbr->BwLatest, AckEvent->DeliveryRate);
+        BbrMaxFilterUpdate(
+            &Bbr->MaxBwFilter,
+            BBR_MAX_BW_FILTER_LEN,
+            Bbr->CycleCount,
+            AckEvent->DeliveryRate);
+    }
+
+    if (Bbr->RoundStart) {
+        if (Bbr->LossInRound || Bbr->EcnInRound) {
+            BbrAdaptLowerBounds(Cc);
+        } else if (
+            Bbr->State == BBR_STATE_PROBE_BW &&
+            Bbr->ProbeBwPhase == BBR_PROBE_BW_UP &&
+            Bbr->InflightHi != UINT32_MAX) {
+            //
+            // No loss while probing up, so raise the long term inflight bound,
+            // doubling the step every round.
+            //
+            const uint32_t Step =
+                (uint32_t)QuicPathGetDatagramPayloadSize(
+                    &QuicCongestionControlGetConnection(Cc)->Paths[0]) <<
+                CXPLAT_MIN(Bbr->BwProbeUpRounds, 16);
+            Bbr->InflightHi =
+                Bbr->InflightHi + Step < Bbr->InflightHi ? // Overflow case
+                    UINT32_MAX - 1 : Bbr->InflightHi + Step;
+            Bbr->BwProbeUpRounds++;
+        }
+
+        if (Bbr->State == BBR_STATE_STARTUP && !Bbr->FilledPipe &&
+            !AckEvent->IsAppLimited) {
+            //
+            // The pipe is full once the bandwidth stopped growing (while the
+            // app was keeping it busy).
+            //
+            const uint64_t MaxBw = Bbr->MaxBwFilter.Samples[0].Value;
+            if (MaxBw >= Bbr->FullBw * BBR_STARTUP_GROWTH_TARGET / BBR_UNIT) {
+                Bbr->FullBw = MaxBw;
+                Bbr->FullBwCount = 0;
+            } else if (++Bbr->FullBwCount >= BBR_STARTUP_FULL_BW_ROUNDS) {
+                Bbr->FilledPipe = TRUE;
+            }
+        }
+    }
+
+    if (Bbr->State == BBR_STATE_STARTUP && Bbr->FilledPipe) {
+        Bbr->State = BBR_STATE_DRAIN;
+        Bbr->PacingGain = BBR_DRAIN_PACING_GAIN;
+        Bbr->CwndGain = BBR_DEFAULT_CWND_GAIN;
+    }
+    if (Bbr->State == BBR_STATE_DRAIN &&
+        Bbr->BytesInFlight <= BbrGetBdp(Cc, BBR_UNIT)) {
+        BbrStartProbeBwDown(Cc, TimeNow);
+    }
+    if (Bbr->State == BBR_STATE_PROBE_BW) {
+        BbrUpdateProbeBwCyclePhase(Cc, TimeNow);
+    }
+
+    BbrUpdateMinRtt(Bbr, AckEvent);
+    BbrCheckProbeRtt(Cc, TimeNow);
+
+    if (Bbr->RoundStart) {
+        Bbr->RoundStartDelivered = Bbr->DeliveredBytes;
+        Bbr->DeliveredInRound = 0;
+        Bbr->LostInRound = 0;
+        Bbr->LossInRound = FALSE;
+        Bbr->BwLatest = 0;
+        Bbr->EctInRound = 0;
+        Bbr->CeInRound = 0;
+        Bbr->EcnInRound = FALSE;
+    }
+
+    BbrSetPacingRate(Cc);
+    BbrUpdateCongestionWindow(Cc, AckEvent->NumRetransmittableBytes);
+
+    if (PreviousState != Bbr->State) {
+        QuicConnLogBbr(QuicCongestionControlGetConnection(Cc));
+    }
+
+    return BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlOnDataLost(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_LOSS_EVENT* LossEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+    const uint32_t PriorBytesInFlight = Bbr->BytesInFlight;
+
+    CXPLAT_DBG_ASSERT(Bbr->BytesInFlight >= LossEvent->NumRetransmittableBytes);
+    Bbr->BytesInFlight -= LossEvent->NumRetransmittableBytes;
+
+    Bbr->LostInRound += LossEvent->NumRetransmittableBytes;
+    Bbr->LossInRound = TRUE;
+
+    if (LossEvent->PersistentCongestion) {
+        QuicTraceEvent(
+            ConnPersistentCongestion,
+            "[conn][%p] Persistent congestion event",
+            Connection);
+        Connection->Stats.Send.PersistentCongestionCount++;
+#ifdef QUIC_USE_RAW_DATAPATH
+        Connection->Paths[0].Route.State = RouteSuspected;
+#endif
+        Bbr->PriorCongestionWindow =
+            CXPLAT_MAX(Bbr->PriorCongestionWindow, Bbr->CongestionWindow);
+        Bbr->CongestionWindow = BbrGetMinCongestionWindow(Connection);
+
+    } else if (
+        Bbr->State == BBR_STATE_STARTUP ||
+        (Bbr->State == BBR_STATE_PROBE_BW && Bbr->ProbeBwPhase == BBR_PROBE_BW_UP)) {
+        //
+        // While probing, check whether the loss rate of this round shows we
+        // went past what the path can hold.
+        //
+        if (Bbr->LostInRound * 100 >
+                (Bbr->LostInRound + Bbr->DeliveredInRound) * BBR_LOSS_THRESH_PERCENT) {
+            BbrHandleInflightTooHigh(Cc, PriorBytesInFlight);
+        }
+    }
+
+    BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogBbr(Connection);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+BbrCongestionControlOnSpuriousCongestionEvent(
+    _In_ QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    //
+    // Loss only bounds the model, which adapts back on its own, so there is
+    // no state to revert.
+    //
+    UNREFERENCED_PARAMETER(Cc);
+    return FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    Bbr->EctInRound += EcnEvent->NumEctPackets;
+    Bbr->CeInRound += EcnEvent->NumCePackets;
+    if (EcnEvent->NumCePackets == 0) {
+        return;
+    }
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = BbrCongestionControlCanSend(Cc);
+
+    //
+    // As in BBRv2, CE marks are a congestion signal like loss: a round with
+    // any CE marks adapts the short term model bounds when it ends, and
+    // probing stops as soon as the CE marked fraction of the round shows the
+    // inflight data is above what the path can hold without queuing.
+    //
+    if (!Bbr->EcnInRound) {
+        Connection->Stats.Send.EcnCongestionCount++;
+        Bbr->EcnInRound = TRUE;
+    }
+
+    if ((Bbr->State == BBR_STATE_STARTUP ||
+         (Bbr->State == BBR_STATE_PROBE_BW && Bbr->ProbeBwPhase == BBR_PROBE_BW_UP)) &&
+        Bbr->EctInRound >= BBR_ECN_MIN_PACKETS &&
+        Bbr->CeInRound * 100 > Bbr->EctInRound * BBR_ECN_THRESH_PERCENT) {
+        BbrHandleInflightTooHigh(Cc, Bbr->BytesInFlight);
+    }
+
+    BbrCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogBbr(Connection);
+}
+
+void
+BbrCongestionControlLogOutFlowStatus(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    const QUIC_PATH* Path = &Connection->Paths[0];
+    const QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    //
+    // BBR has no slow start threshold; report the long term inflight bound.
+    //
+    QuicTraceEvent(
+        ConnOutFlowStats,
+        "[conn][%p] OUT: BytesSent=%llu InFlight=%u InFlightMax=%u CWnd=%u SSThresh=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%u",
+        Connection,
+        Connection->Stats.Send.TotalBytes,
+        Bbr->BytesInFlight,
+        Bbr->BytesInFlightMax,
+        Bbr->CongestionWindow,
+        Bbr->InflightHi,
+        Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent,
+        Connection->SendBuffer.IdealBytes,
+        Connection->SendBuffer.PostedBytes,
+        Path->GotFirstRttSample ? Path->SmoothedRtt : 0);
+}
+
+uint32_t
+BbrCongestionControlGetBytesInFlightMax(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr.BytesInFlightMax;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint8_t
+BbrCongestionControlGetExemptions(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr.Exemptions;
+}
+
+uint32_t
+BbrCongestionControlGetCongestionWindow(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->Bbr.CongestionWindow;
+}
+
+uint64_t
+BbrCongestionControlGetPacingRate(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (!Connection->Settings.PacingEnabled ||
+        !Connection->Paths[0].GotFirstRttSample ||
+        Connection->Paths[0].SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        return 0;
+    }
+    return Cc->Bbr.PacingRate;
+}
+
+static const QUIC_CONGESTION_CONTROL QuicCongestionControlBbr = {
+    .Name = "BBR",
+    .QuicCongestionControlCanSend = BbrCongestionControlCanSend,
+    .QuicCongestionControlSetExemption = BbrCongestionControlSetExemption,
+    .QuicCongestionControlReset = BbrCongestionControlReset,
+    .QuicCongestionControlGetSendAllowance = BbrCongestionControlGetSendAllowance,
+    .QuicCongestionControlOnDataSent = BbrCongestionControlOnDataSent,
+    .QuicCongestionControlOnDataInvalidated = BbrCongestionControlOnDataInvalidated,
+    .QuicCongestionControlOnDataAcknowledged = BbrCongestionControlOnDataAcknowledged,
+    .QuicCongestionControlOnDataLost = BbrCongestionControlOnDataLost,
+    .QuicCongestionControlOnSpuriousCongestionEvent = BbrCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlOnEcn = BbrCongestionControlOnEcn,
+    .QuicCongestionControlLogOutFlowStatus = BbrCongestionControlLogOutFlowStatus,
+    .QuicCongestionControlGetExemptions = BbrCongestionControlGetExemptions,
+    .QuicCongestionControlGetBytesInFlightMax = BbrCongestionControlGetBytesInFlightMax,
+    .QuicCongestionControlGetCongestionWindow = BbrCongestionControlGetCongestionWindow,
+    .QuicCongestionControlGetPacingRate = BbrCongestionControlGetPacingRate,
+};
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    )
+{
+    *Cc = QuicCongestionControlBbr;
+
+    QUIC_CONGESTION_CONTROL_BBR* Bbr = &Cc->Bbr;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    Bbr->InitialWindowPackets = Settings->InitialWindowPackets;
+    Bbr->DeliveredBytes = Connection->LossDetection.DeliveredBytes;
+    BbrResetModel(Cc);
+
+    QuicConnLogOutFlowStats(Connection);
+    QuicConnLogBbr(Connection);
+}
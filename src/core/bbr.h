@@ -0,0 +1,207 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef enum BBR_STATE {
+    BBR_STATE_STARTUP,
+    BBR_STATE_DRAIN,
+    BBR_STATE_PROBE_BW,
+    BBR_STATE_PROBE_RTT
+} BBR_STATE;
+
+typedef enum BBR_PROBE_BW_PHASE {
+    BBR_PROBE_BW_DOWN,
+    BBR_PROBE_BW_CRUISE,
+    BBR_PROBE_BW_REFILL,
+    BBR_PROBE_BW_UP
+} BBR_PROBE_BW_PHASE;
+
+//
+// Windowed max filter, tracking the best, second best and third best samples
+// over the window (Kathleen Nichols' algorithm). Time is in caller defined
+// units; BBR uses the bandwidth probing cycle count.
+//
+typedef struct BBR_MAX_FILTER_SAMPLE {
+    uint64_t Time;
+    uint64_t Value;
+} BBR_MAX_FILTER_SAMPLE;
+
+typedef struct BBR_MAX_FILTER {
+    BBR_MAX_FILTER_SAMPLE Samples[3];
+} BBR_MAX_FILTER;
+
+typedef struct QUIC_CONGESTION_CONTROL_BBR {
+
+    //
+    // TRUE once STARTUP decided the bottleneck bandwidth has been reached.
+    //
+    BOOLEAN FilledPipe : 1;
+
+    //
+    // TRUE if the current ACK starts a new round trip.
+    //
+    BOOLEAN RoundStart : 1;
+
+    //
+    // TRUE once a full round has passed at the PROBE_RTT inflight target.
+    //
+    BOOLEAN ProbeRttRoundDone : 1;
+
+    //
+    // TRUE if the PROBE_RTT min RTT sample wasn't refreshed for
+    // BBR_PROBE_RTT_INTERVAL.
+    //
+    BOOLEAN ProbeRttExpired : 1;
+
+    //
+    // TRUE if any packet was declared lost in the current round.
+    //
+    BOOLEAN LossInRound : 1;
+
+    //
+    // TRUE if any packet was reported CE marked in the current round.
+    //
+    BOOLEAN EcnInRound : 1;
+
+    //
+    // The size of the initial congestion window, in packets.
+    //
+    uint32_t InitialWindowPackets;
+
+    uint32_t CongestionWindow; // bytes
+    uint32_t PriorCongestionWindow; // bytes, saved across PROBE_RTT
+
+    //
+    // The number of bytes considered to be still in the network.
+    //
+    uint32_t BytesInFlight;
+    uint32_t BytesInFlightMax;
+
+    //
+    // The leftover send allowance from a previous send. Only used when pacing.
+    //
+    uint32_t LastSendAllowance; // bytes
+
+    //
+    // A count of packets which can be sent ignoring CongestionWindow.
+    //
+    uint8_t Exemptions;
+
+    uint8_t State; // BBR_STATE
+    uint8_t ProbeBwPhase; // BBR_PROBE_BW_PHASE
+
+    //
+    // Gains applied to the bandwidth (pacing) and BDP (window), in units of
+    // BBR_UNIT.
+    //
+    uint32_t PacingGain;
+    uint32_t CwndGain;
+
+    uint64_t PacingRate; // bytes per second
+
+    //
+    // The max delivery rate over the last BBR_MAX_BW_FILTER_LEN probing
+    // cycles, and the cycle count used as the filter's time base.
+    //
+    BBR_MAX_FILTER MaxBwFilter;
+    uint64_t CycleCount;
+
+    //
+    // Windowed min RTT. The PROBE_RTT sample is refreshed at least every
+    // BBR_PROBE_RTT_INTERVAL and feeds MinRtt, which has a longer window.
+    //
+    uint32_t MinRtt; // microseconds
+    uint64_t MinRttTimestamp; // microseconds
+    uint32_t ProbeRttMinRtt; // microseconds
+    uint64_t ProbeRttMinTimestamp; // microseconds
+    uint64_t ProbeRttDoneTime; // microseconds, zero if not set
+
+    //
+    // Round trip counting: a round ends when a packet sent after the round
+    // started (i.e. after NextRoundDelivered bytes were delivered) is acked.
+    //
+    uint64_t RoundCount;
+    uint64_t NextRoundDelivered;
+
+    //
+    // STARTUP exit: the bandwidth seen when growth last exceeded
+    // BBR_STARTUP_GROWTH_TARGET, and the number of rounds without it since.
+    //
+    uint64_t FullBw;
+    uint32_t FullBwCount;
+
+    //
+    // PROBE_BW cycle state.
+    //
+    uint64_t CycleStartTime; // microseconds
+    uint64_t PhaseStartTime; // microseconds
+    uint64_t BwProbeWait; // microseconds
+    uint32_t RoundsSinceBwProbe;
+    uint32_t BwProbeUpRounds;
+
+    //
+    // Long term (Hi) and short term (Lo) model bounds, adapted in response
+    // to loss. UINT32_MAX/UINT64_MAX mean unbounded.
+    //
+    uint32_t InflightHi; // bytes
+    uint32_t InflightLo; // bytes
+    uint64_t BwLo; // bytes per second
+
+    //
+    // Per-round delivery and loss accounting. DeliveredBytes is the latest
+    // total reported by loss detection.
+    //
+    uint64_t DeliveredBytes;
+    uint64_t RoundStartDelivered;
+    uint64_t DeliveredInRound; // bytes
+    uint64_t LostInRound; // bytes
+    uint64_t BwLatest; // bytes per second
+
+    //
+    // Per-round ECN feedback, in packets. EctInRound includes the CE marked
+    // ones.
+    //
+    uint64_t EctInRound;
+    uint64_t CeInRound;
+
+} QUIC_CONGESTION_CONTROL_BBR;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrCongestionControlInitialize(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_SETTINGS_INTERNAL* Settings
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrMaxFilterReset(
+    _Inout_ BBR_MAX_FILTER* Filter,
+    _In_ uint64_t Time,
+    _In_ uint64_t Value
+    );
+
+//
+// Adds a sample to the filter. Samples older than Window are aged out.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+BbrMaxFilterUpdate(
+    _Inout_ BBR_MAX_FILTER* Filter,
+    _In_ uint64_t Window,
+    _In_ uint64_t Time,
+    _In_ uint64_t Value
+    );
+
+#if defined(__cplusplus)
+}
+#endif
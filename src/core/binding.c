@@ -991,6 +991,16 @@ QuicBindingProcessStatelessOperation(
         uint8_t NewDestCid[QUIC_CID_MAX_LENGTH];
         CXPLAT_DBG_ASSERT(sizeof(NewDestCid) >= MsQuicLib.CidTotalLength);
         CxPlatRandom(sizeof(NewDestCid), NewDestCid);
+        if (MsQuicLib.CidQuicLb) {
+            //
+            // Make the retried Initial routable back to this server.
+            //
+            QuicLibraryGenerateLbServerId(NewDestCid);
+            if (MsQuicLib.CidEncrypted &&
+                QUIC_FAILED(QuicLibraryEncryptCid(NewDestCid))) {
+                goto Exit;
+            }
+        }
 
         QUIC_RETRY_TOKEN_CONTENTS Token = { 0 };
         Token.Authenticated.Timestamp = CxPlatTimeEpochMs64();
@@ -10,9 +10,10 @@ Abstract:
 --*/
 
 //
-// The maximum CID server ID length used by MsQuic.
+// The maximum CID server ID length used by MsQuic. The largest is QUIC-LB
+// plaintext mode: the first octet plus up to a 10 byte server ID.
 //
-#define QUIC_MAX_CID_SID_LENGTH                 5
+#define QUIC_MAX_CID_SID_LENGTH                 11
 
 //
 // The index of the byte we use for partition ID lookup, in the connection ID.
@@ -26,6 +27,20 @@ Abstract:
 //
 #define QUIC_CID_PAYLOAD_LENGTH                 7
 
+//
+// The QUIC-LB first octet encodes the config ID in its top three bits and the
+// length of the rest of the CID in the low five bits.
+//
+#define QUIC_CID_LB_CONFIG_ID_SHIFT             5
+#define QUIC_CID_LB_LENGTH_MASK                 0x1F
+
+//
+// QUIC-LB single pass encryption covers exactly one AES block following the
+// first octet, so the server ID is padded with random bytes to fill it.
+//
+#define QUIC_CID_LB_ENCRYPTED_SID_LENGTH \
+    (CXPLAT_BLOCK_LENGTH - QUIC_CID_PID_LENGTH - QUIC_CID_PAYLOAD_LENGTH)
+
 //
 // The minimum number of bytes that should be purely random in a CID.
 //
@@ -165,7 +180,6 @@ typedef struct QUIC_CID_LIST_ENTRY {
 
 typedef struct QUIC_CID_HASH_ENTRY {
 
-    CXPLAT_HASHTABLE_ENTRY Entry;
     CXPLAT_SLIST_ENTRY Link;
     QUIC_CONNECTION* Connection;
     QUIC_CID CID;
@@ -6,6 +6,7 @@
 --*/
 
 #include "cubic.h"
+#include "bbr.h"
 
 typedef struct QUIC_ACK_EVENT {
 
@@ -17,6 +18,36 @@ typedef struct QUIC_ACK_EVENT {
 
     uint32_t SmoothedRtt;
 
+    //
+    // The RTT sample taken from this ACK (adjusted for ACK delay), or zero if
+    // the ACK didn't produce one.
+    //
+    uint32_t LatestRtt;
+
+    //
+    // Total ack-eliciting bytes delivered so far, and the total at the time
+    // the most recently sent packet acknowledged by this ACK was sent. The
+    // latter is only valid if IsPriorDeliveredValid is set.
+    //
+    uint64_t DeliveredBytes;
+    uint64_t PriorDeliveredBytes;
+
+    //
+    // Delivery rate sample for this ACK, in bytes per second, and the
+    // interval it was measured over. Both are zero if no valid sample could
+    // be taken.
+    //
+    uint64_t DeliveryRate;
+    uint32_t DeliveryInterval; // microseconds
+
+    BOOLEAN IsPriorDeliveredValid : 1;
+
+    //
+    // TRUE if the sample was taken while the application, not the network,
+    // limited the send rate, i.e. it may underestimate the bandwidth.
+    //
+    BOOLEAN IsAppLimited : 1;
+
 } QUIC_ACK_EVENT;
 
 typedef struct QUIC_LOSS_EVENT {
@@ -31,6 +62,18 @@ typedef struct QUIC_LOSS_EVENT {
 
 } QUIC_LOSS_EVENT;
 
+typedef struct QUIC_ECN_EVENT {
+
+    uint64_t LargestPacketNumberAcked;
+
+    uint64_t LargestSentPacketNumber;
+
+    uint64_t NumEctPackets; // Newly reported ECT and CE marked packets.
+
+    uint64_t NumCePackets; // Newly reported CE marked packets.
+
+} QUIC_ECN_EVENT;
+
 typedef struct QUIC_CONGESTION_CONTROL {
 
     //
@@ -82,6 +125,11 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _In_ struct QUIC_CONGESTION_CONTROL* Cc
         );
 
+    void (*QuicCongestionControlOnEcn)(
+        _In_ struct QUIC_CONGESTION_CONTROL* Cc,
+        _In_ const QUIC_ECN_EVENT* EcnEvent
+        );
+
     void (*QuicCongestionControlLogOutFlowStatus)(
         _In_ const struct QUIC_CONGESTION_CONTROL* Cc
         );
@@ -98,11 +146,16 @@ typedef struct QUIC_CONGESTION_CONTROL {
         _In_ const struct QUIC_CONGESTION_CONTROL* Cc
         );
 
+    uint64_t (*QuicCongestionControlGetPacingRate)(
+        _In_ const struct QUIC_CONGESTION_CONTROL* Cc
+        );
+
     //
     // Algorithm specific state.
     //
     union {
         QUIC_CONGESTION_CONTROL_CUBIC Cubic;
+        QUIC_CONGESTION_CONTROL_BBR Bbr;
     };
 
 } QUIC_CONGESTION_CONTROL;
@@ -237,6 +290,20 @@ QuicCongestionControlOnSpuriousCongestionEvent(
     return Cc->QuicCongestionControlOnSpuriousCongestionEvent(Cc);
 }
 
+//
+// Called when an ACK frame reports newly ECN marked packets.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    Cc->QuicCongestionControlOnEcn(Cc, EcnEvent);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 inline
 uint8_t
@@ -276,3 +343,17 @@ QuicCongestionControlGetCongestionWindow(
 {
     return Cc->QuicCongestionControlGetCongestionWindow(Cc);
 }
+
+//
+// Returns the rate (in bytes per second) sends should be paced at, or zero if
+// not currently pacing.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+uint64_t
+QuicCongestionControlGetPacingRate(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    return Cc->QuicCongestionControlGetPacingRate(Cc);
+}
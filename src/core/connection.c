@@ -177,6 +177,8 @@ QuicConnAlloc(
                     ((uint8_t*)&Datagram->Route->LocalAddress.Ipv6.sin6_addr) + 12,
                     4);
             }
+        } else if (MsQuicLib.CidQuicLb) {
+            QuicLibraryGenerateLbServerId(Connection->ServerID);
         }
 
         Connection->Stats.QuicVersion = Packet->Invariant->LONG_HDR.Version;
@@ -840,6 +842,59 @@ QuicConnUpdateRtt(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnOnBytesDelivered(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t BytesDelivered
+    )
+{
+    QUIC_SEND* Send = &Connection->Send;
+    Send->MaxData += BytesDelivered;
+    Send->RecvWindowBytesDelivered += BytesDelivered;
+
+    const uint64_t DrainThreshold = Send->RecvWindow / QUIC_RECV_BUFFER_DRAIN_RATIO;
+    if (Send->RecvWindowBytesDelivered < DrainThreshold) {
+        return FALSE;
+    }
+
+    //
+    // Estimate the BDP as the bytes the app drained per RTT since the last
+    // update. If the app drains more than 1 / QUIC_RECV_BUFFER_DRAIN_RATIO of
+    // the window per RTT, the window is what limits throughput, so double it,
+    // within the library's memory budget for auto-tuned windows.
+    //
+    BOOLEAN Grew = FALSE;
+    const uint32_t TimeNow = CxPlatTimeUs32();
+    uint32_t Elapsed = CxPlatTimeDiff32(Send->RecvWindowLastUpdate, TimeNow);
+    if (Elapsed == 0) {
+        Elapsed = 1;
+    }
+    const uint64_t Bdp =
+        (Send->RecvWindowBytesDelivered * Connection->Paths[0].SmoothedRtt) / Elapsed;
+    if (Bdp >= DrainThreshold && Send->RecvWindow < QUIC_MAX_CONN_FLOW_CONTROL_WINDOW) {
+        const uint64_t Increase =
+            CXPLAT_MIN(Send->RecvWindow, QUIC_MAX_CONN_FLOW_CONTROL_WINDOW - Send->RecvWindow);
+        if (QuicLibraryTryAddRecvWindowMemory(Increase)) {
+            QuicTraceLogConnVerbose(
+                IncreaseConnRxWindow,
+                Connection,
+                "Increasing connection flow control window to %llu (Bdp=%llu)",
+                Send->RecvWindow + Increase,
+                Bdp);
+            Send->RecvWindow += Increase;
+            Send->RecvWindowGrowth += Increase;
+            Send->MaxData += Increase;
+            Connection->Stats.Recv.WindowAutoTuneCount++;
+            Grew = TRUE;
+        }
+    }
+
+    Send->RecvWindowLastUpdate = TimeNow;
+    Send->RecvWindowBytesDelivered = 0;
+    return Grew;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_CID_HASH_ENTRY*
 QuicConnGenerateNewSourceCid(
@@ -3948,68 +4003,55 @@ QuicConnRecvPrepareDecrypt(
 }
 
 //
-// Decrypts the packet's payload and authenticates the whole packet. On
-// successful authentication of the packet, does some final processing of the
-// packet header (key and CID updates). Returns TRUE if the packet should
-// continue to be processed further.
+// Copies the end of the packet, which may be a stateless reset token, before
+// attempting decryption, as a failed decryption trashes it. Returns TRUE if
+// the packet could be a stateless reset.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
-QuicConnRecvDecryptAndAuthenticate(
-    _In_ QUIC_CONNECTION* Connection,
-    _In_ QUIC_PATH* Path,
-    _In_ CXPLAT_RECV_PACKET* Packet
+QuicConnRecvSaveResetToken(
+    _In_ const QUIC_CONNECTION* Connection,
+    _In_ const CXPLAT_RECV_PACKET* Packet,
+    _Out_writes_(QUIC_STATELESS_RESET_TOKEN_LENGTH)
+        uint8_t* PacketResetToken
     )
 {
-    CXPLAT_DBG_ASSERT(Packet->BufferLength >= Packet->HeaderLength + Packet->PayloadLength);
-
-    const uint8_t* Payload = Packet->Buffer + Packet->HeaderLength;
-
-    //
-    // We need to copy the end of the packet before trying decryption, as a
-    // failed decryption trashes the stateless reset token.
-    //
-    BOOLEAN CanCheckForStatelessReset = FALSE;
-    uint8_t PacketResetToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
     if (QuicConnIsClient(Connection) &&
         Packet->IsShortHeader &&
         Packet->HeaderLength + Packet->PayloadLength >= QUIC_MIN_STATELESS_RESET_PACKET_LENGTH) {
-        CanCheckForStatelessReset = TRUE;
         CxPlatCopyMemory(
             PacketResetToken,
-            Payload + Packet->PayloadLength - QUIC_STATELESS_RESET_TOKEN_LENGTH,
+            Packet->Buffer + Packet->HeaderLength + Packet->PayloadLength - QUIC_STATELESS_RESET_TOKEN_LENGTH,
             QUIC_STATELESS_RESET_TOKEN_LENGTH);
+        return TRUE;
     }
+    return FALSE;
+}
 
-    CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
-    QuicTraceEvent(
-        PacketDecrypt,
-        "[pack][%llu] Decrypting",
-        Packet->PacketId);
-
-    uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
-    QuicCryptoCombineIvAndPacketNumber(
-        Connection->Crypto.TlsState.ReadKeys[Packet->KeyType]->Iv,
-        (uint8_t*)&Packet->PacketNumber,
-        Iv);
-
-    //
-    // Decrypt the payload with the appropriate key.
-    //
-    if (Packet->Encrypted &&
-        QUIC_FAILED(
-        CxPlatDecrypt(
-            Connection->Crypto.TlsState.ReadKeys[Packet->KeyType]->PacketKey,
-            Iv,
-            Packet->HeaderLength,   // HeaderLength
-            Packet->Buffer,         // Header
-            Packet->PayloadLength,  // BufferLength
-            (uint8_t*)Payload))) {  // Buffer
+//
+// Completes the authentication of a packet after its payload has been
+// decrypted with result 'DecryptStatus'. On successful authentication of the
+// packet, does some final processing of the packet header (key and CID
+// updates). Returns TRUE if the packet should continue to be processed
+// further.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnRecvAuthenticate(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path,
+    _In_ CXPLAT_RECV_PACKET* Packet,
+    _In_ QUIC_STATUS DecryptStatus,
+    _In_reads_opt_(QUIC_STATELESS_RESET_TOKEN_LENGTH)
+        const uint8_t* PacketResetToken
+    )
+{
+    if (QUIC_FAILED(DecryptStatus)) {
 
         //
         // Check for a stateless reset packet.
         //
-        if (CanCheckForStatelessReset) {
+        if (PacketResetToken != NULL) {
             for (CXPLAT_LIST_ENTRY* Entry = Connection->DestCids.Flink;
                     Entry != &Connection->DestCids;
                     Entry = Entry->Flink) {
@@ -4227,6 +4269,60 @@ QuicConnRecvDecryptAndAuthenticate(
     return TRUE;
 }
 
+//
+// Decrypts the packet's payload and authenticates the whole packet. Returns
+// TRUE if the packet should continue to be processed further.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnRecvDecryptAndAuthenticate(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path,
+    _In_ CXPLAT_RECV_PACKET* Packet
+    )
+{
+    CXPLAT_DBG_ASSERT(Packet->BufferLength >= Packet->HeaderLength + Packet->PayloadLength);
+
+    uint8_t PacketResetToken[QUIC_STATELESS_RESET_TOKEN_LENGTH];
+    BOOLEAN CanCheckForStatelessReset =
+        QuicConnRecvSaveResetToken(Connection, Packet, PacketResetToken);
+
+    CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
+    QuicTraceEvent(
+        PacketDecrypt,
+        "[pack][%llu] Decrypting",
+        Packet->PacketId);
+
+    //
+    // Decrypt the payload with the appropriate key.
+    //
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    if (Packet->Encrypted) {
+        uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+        QuicCryptoCombineIvAndPacketNumber(
+            Connection->Crypto.TlsState.ReadKeys[Packet->KeyType]->Iv,
+            (uint8_t*)&Packet->PacketNumber,
+            Iv);
+
+        Status =
+            CxPlatDecrypt(
+                Connection->Crypto.TlsState.ReadKeys[Packet->KeyType]->PacketKey,
+                Iv,
+                Packet->HeaderLength,   // HeaderLength
+                Packet->Buffer,         // Header
+                Packet->PayloadLength,  // BufferLength
+                (uint8_t*)Packet->Buffer + Packet->HeaderLength); // Buffer
+    }
+
+    return
+        QuicConnRecvAuthenticate(
+            Connection,
+            Path,
+            Packet,
+            Status,
+            CanCheckForStatelessReset ? PacketResetToken : NULL);
+}
+
 //
 // Reads the frames in a packet, and if everything is successful marks the
 // packet for acknowledgement and returns TRUE.
@@ -5250,6 +5346,60 @@ QuicConnRecvPostProcessing(
     }
 }
 
+//
+// Finishes processing a packet from a receive batch, after it has been
+// decrypted and authenticated (or failed to be).
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicConnRecvBatchedPacket(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_ QUIC_PATH** Path,
+    _In_ CXPLAT_RECV_DATA* Datagram,
+    _In_ BOOLEAN Authenticated,
+    _Inout_ QUIC_RECEIVE_PROCESSING_STATE* RecvState
+    )
+{
+    CXPLAT_RECV_PACKET* Packet = CxPlatDataPathRecvDataToRecvPacket(Datagram);
+    CXPLAT_ECN_TYPE ECN = CXPLAT_ECN_FROM_TOS(Datagram->TypeOfService);
+
+    if (Authenticated &&
+        QuicConnRecvFrames(Connection, *Path, Packet, ECN)) {
+
+        QuicConnRecvPostProcessing(Connection, Path, Packet);
+        RecvState->ResetIdleTimeout |= Packet->CompletelyValid;
+
+        if (Connection->Registration != NULL && !Connection->Registration->NoPartitioning &&
+            (*Path)->IsActive && !(*Path)->PartitionUpdated && Packet->CompletelyValid &&
+            (Datagram->PartitionIndex % MsQuicLib.PartitionCount) != RecvState->PartitionIndex) {
+            RecvState->PartitionIndex = Datagram->PartitionIndex % MsQuicLib.PartitionCount;
+            RecvState->UpdatePartitionId = TRUE;
+            (*Path)->PartitionUpdated = TRUE;
+        }
+
+        if (Packet->IsShortHeader && Packet->NewLargestPacketNumber) {
+
+            if (QuicConnIsServer(Connection)) {
+                (*Path)->SpinBit = Packet->SH->SpinBit;
+            } else {
+                (*Path)->SpinBit = !Packet->SH->SpinBit;
+            }
+        }
+
+    } else {
+        Connection->Stats.Recv.DroppedPackets++;
+        if (Connection->State.CompatibleVerNegotiationAttempted &&
+            !Connection->State.CompatibleVerNegotiationCompleted) {
+            //
+            // The packet which initiated compatible version negotation failed
+            // decryption, so undo the version change.
+            //
+            Connection->Stats.QuicVersion = Connection->OriginalQuicVersion;
+            Connection->State.CompatibleVerNegotiationAttempted = FALSE;
+        }
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnRecvDatagramBatch(
@@ -5293,48 +5443,95 @@ QuicConnRecvDatagramBatch(
         CxPlatZeroMemory(HpMask, BatchCount * CXPLAT_HP_SAMPLE_LENGTH);
     }
 
-    for (uint8_t i = 0; i < BatchCount; ++i) {
-        CXPLAT_DBG_ASSERT(Datagrams[i]->Allocated);
-        CXPLAT_ECN_TYPE ECN = CXPLAT_ECN_FROM_TOS(Datagrams[i]->TypeOfService);
-        Packet = CxPlatDataPathRecvDataToRecvPacket(Datagrams[i]);
-        CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
-        if (QuicConnRecvPrepareDecrypt(
-                Connection, Packet, HpMask + i * CXPLAT_HP_SAMPLE_LENGTH) &&
-            QuicConnRecvDecryptAndAuthenticate(Connection, Path, Packet) &&
-            QuicConnRecvFrames(Connection, Path, Packet, ECN)) {
-
-            QuicConnRecvPostProcessing(Connection, &Path, Packet);
-            RecvState->ResetIdleTimeout |= Packet->CompletelyValid;
-
-            if (Connection->Registration != NULL && !Connection->Registration->NoPartitioning &&
-                Path->IsActive && !Path->PartitionUpdated && Packet->CompletelyValid &&
-                (Datagrams[i]->PartitionIndex % MsQuicLib.PartitionCount) != RecvState->PartitionIndex) {
-                RecvState->PartitionIndex = Datagrams[i]->PartitionIndex % MsQuicLib.PartitionCount;
-                RecvState->UpdatePartitionId = TRUE;
-                Path->PartitionUpdated = TRUE;
+    uint8_t i = 0;
+    while (i < BatchCount) {
+
+        //
+        // Remove header protection from as many packets as possible that can
+        // be decrypted together with the current 1-RTT key. The first packet
+        // that can't (if any) ends the run and is handled on its own after
+        // the run. Decrypting the run ahead of frame processing doesn't change
+        // the key phase state used to prepare the packets after it, because a
+        // packet that would move the current key phase's start packet number
+        // also ends the run.
+        //
+        CXPLAT_RECV_PACKET* Run[QUIC_MAX_CRYPTO_BATCH_COUNT];
+        uint8_t RunCount = 0;
+        BOOLEAN LastPrepared = FALSE;
+        uint8_t End = i;
+        while (End < BatchCount) {
+            CXPLAT_DBG_ASSERT(Datagrams[End]->Allocated);
+            Packet = CxPlatDataPathRecvDataToRecvPacket(Datagrams[End]);
+            CXPLAT_DBG_ASSERT(Packet->PacketId != 0);
+            LastPrepared =
+                QuicConnRecvPrepareDecrypt(
+                    Connection, Packet, HpMask + End * CXPLAT_HP_SAMPLE_LENGTH);
+            ++End;
+            if (!LastPrepared ||
+                !Packet->IsShortHeader ||
+                !Packet->Encrypted ||
+                Packet->KeyType != QUIC_PACKET_KEY_1_RTT ||
+                Packet->PacketNumber <
+                    Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT]->ReadKeyPhaseStartPacketNumber) {
+                break;
             }
+            Run[RunCount++] = Packet;
+            LastPrepared = FALSE;
+        }
 
-            if (Packet->IsShortHeader && Packet->NewLargestPacketNumber) {
+        if (RunCount != 0) {
+            QUIC_PACKET_KEY* Key = Connection->Crypto.TlsState.ReadKeys[QUIC_PACKET_KEY_1_RTT];
+            CXPLAT_CRYPT_BATCH_ENTRY Batch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+            QUIC_STATUS Results[QUIC_MAX_CRYPTO_BATCH_COUNT];
+            uint8_t ResetTokens[QUIC_MAX_CRYPTO_BATCH_COUNT][QUIC_STATELESS_RESET_TOKEN_LENGTH];
+            BOOLEAN CanCheckForStatelessReset[QUIC_MAX_CRYPTO_BATCH_COUNT];
 
-                if (QuicConnIsServer(Connection)) {
-                    Path->SpinBit = Packet->SH->SpinBit;
-                } else {
-                    Path->SpinBit = !Packet->SH->SpinBit;
-                }
+            for (uint8_t j = 0; j < RunCount; ++j) {
+                CanCheckForStatelessReset[j] =
+                    QuicConnRecvSaveResetToken(Connection, Run[j], ResetTokens[j]);
+                QuicTraceEvent(
+                    PacketDecrypt,
+                    "[pack][%llu] Decrypting",
+                    Run[j]->PacketId);
+                QuicCryptoCombineIvAndPacketNumber(
+                    Key->Iv,
+                    (uint8_t*)&Run[j]->PacketNumber,
+                    Batch[j].Iv);
+                Batch[j].AuthData = Run[j]->Buffer;
+                Batch[j].AuthDataLength = Run[j]->HeaderLength;
+                Batch[j].Buffer = (uint8_t*)Run[j]->Buffer + Run[j]->HeaderLength;
+                Batch[j].BufferLength = Run[j]->PayloadLength;
             }
 
-        } else {
-            Connection->Stats.Recv.DroppedPackets++;
-            if (Connection->State.CompatibleVerNegotiationAttempted &&
-                !Connection->State.CompatibleVerNegotiationCompleted) {
-                //
-                // The packet which initiated compatible version negotation failed
-                // decryption, so undo the version change.
-                //
-                Connection->Stats.QuicVersion = Connection->OriginalQuicVersion;
-                Connection->State.CompatibleVerNegotiationAttempted = FALSE;
+            (void)CxPlatDecryptBatch(Key->PacketKey, RunCount, Batch, Results);
+
+            for (uint8_t j = 0; j < RunCount; ++j, ++i) {
+                QuicConnRecvBatchedPacket(
+                    Connection,
+                    &Path,
+                    Datagrams[i],
+                    QuicConnRecvAuthenticate(
+                        Connection,
+                        Path,
+                        Run[j],
+                        Results[j],
+                        CanCheckForStatelessReset[j] ? ResetTokens[j] : NULL),
+                    RecvState);
             }
         }
+
+        if (i < End) {
+            CXPLAT_DBG_ASSERT(i + 1 == End);
+            Packet = CxPlatDataPathRecvDataToRecvPacket(Datagrams[i]);
+            QuicConnRecvBatchedPacket(
+                Connection,
+                &Path,
+                Datagrams[i],
+                LastPrepared &&
+                    QuicConnRecvDecryptAndAuthenticate(Connection, Path, Packet),
+                RecvState);
+            ++i;
+        }
     }
 }
 
@@ -6201,6 +6398,9 @@ QuicConnParamSet(
 
         Connection->State.UseRoundRobinStreamScheduling =
             Scheme == QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        Connection->State.UseExtensiblePriorityStreamScheduling =
+            Scheme == QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY;
+        QuicSendUpdateStreamSchedulingScheme(&Connection->Send);
 
         QuicTraceLogConnInfo(
             UpdateStreamSchedulingScheme,
@@ -6368,6 +6568,12 @@ QuicConnParamSet(
             //
             return QUIC_STATUS_INVALID_STATE;
         }
+        if (MsQuicLib.CidEncrypted) {
+            //
+            // Encrypted QUIC-LB connection IDs hide the CIBIR ID.
+            //
+            return QUIC_STATUS_NOT_SUPPORTED;
+        }
 
         if (BufferLength > QUIC_MAX_CIBIR_LENGTH + 1) {
             return QUIC_STATUS_INVALID_PARAMETER;
@@ -6586,6 +6792,39 @@ QuicConnGetV2Statistics(
     if (STATISTICS_HAS_FIELD(*StatsLength, SendCongestionWindow)) {
         Stats->SendCongestionWindow = QuicCongestionControlGetCongestionWindow(&Connection->CongestionControl);
     }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendEcnCongestionCount)) {
+        Stats->SendEcnCongestionCount = Connection->Stats.Send.EcnCongestionCount;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendDeliveryRate)) {
+        Stats->SendDeliveryRate = Connection->Stats.Send.DeliveryRate;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendMaxDeliveryRate)) {
+        Stats->SendMaxDeliveryRate = Connection->Stats.Send.MaxDeliveryRate;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendBufferBytes)) {
+        Stats->SendBufferBytes = Connection->SendBuffer.BufferedBytes;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendBufferAllocatedBytes)) {
+        Stats->SendBufferAllocatedBytes = Connection->SendBuffer.AllocatedBytes;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, RecvConnFlowControlWindow)) {
+        Stats->RecvConnFlowControlWindow = Connection->Send.RecvWindow;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, RecvMaxStreamFlowControlWindow)) {
+        Stats->RecvMaxStreamFlowControlWindow =
+            CXPLAT_MAX(
+                Connection->Stats.Recv.MaxStreamWindow,
+                Connection->Settings.StreamRecvWindowDefault);
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, RecvWindowAutoTuneCount)) {
+        Stats->RecvWindowAutoTuneCount = Connection->Stats.Recv.WindowAutoTuneCount;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendDatagramsExpired)) {
+        Stats->SendDatagramsExpired = Connection->Stats.Send.DatagramsExpired;
+    }
+    if (STATISTICS_HAS_FIELD(*StatsLength, SendDatagramsDropped)) {
+        Stats->SendDatagramsDropped = Connection->Stats.Send.DatagramsDropped;
+    }
 
     *StatsLength = CXPLAT_MIN(*StatsLength, sizeof(QUIC_STATISTICS_V2));
 
@@ -6882,6 +7121,8 @@ QuicConnParamGet(
 
         *BufferLength = sizeof(QUIC_STREAM_SCHEDULING_SCHEME);
         *(QUIC_STREAM_SCHEDULING_SCHEME*)Buffer =
+            Connection->State.UseExtensiblePriorityStreamScheduling ?
+                QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY :
             Connection->State.UseRoundRobinStreamScheduling ?
                 QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN : QUIC_STREAM_SCHEDULING_SCHEME_FIFO;
 
@@ -7152,6 +7393,24 @@ QuicConnProcessApiOperation(
                 ApiCtx->STRM_RECV_SET_ENABLED.IsEnabled);
         break;
 
+    case QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS:
+        Status =
+            QuicStreamProvideRecvBuffers(
+                ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Stream,
+                ApiCtx->STRM_PROVIDE_RECV_BUFFERS.BufferCount,
+                ApiCtx->STRM_PROVIDE_RECV_BUFFERS.Buffers);
+        if (QUIC_FAILED(Status)) {
+            //
+            // The app was already told the call is pending, and it expects
+            // data to keep landing in the buffers it provides, in order. There
+            // is no way to continue without these, so fail the connection,
+            // which reports the status to the app.
+            //
+            QuicConnFatalError(
+                Connection, Status, "Failed to add provided receive buffers");
+        }
+        break;
+
     case QUIC_API_TYPE_SET_PARAM:
         Status =
             QuicLibrarySetParam(
@@ -140,6 +140,12 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN UseRoundRobinStreamScheduling : 1;
 
+        //
+        // Indicates the connection is using the RFC 9218 extensible priority
+        // stream scheduling scheme.
+        //
+        BOOLEAN UseExtensiblePriorityStreamScheduling : 1;
+
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -267,6 +273,13 @@ typedef struct QUIC_CONN_STATS {
 
         uint32_t CongestionCount;
         uint32_t PersistentCongestionCount;
+        uint32_t EcnCongestionCount;
+
+        uint64_t DeliveryRate;          // Latest delivery rate sample, in bytes per second
+        uint64_t MaxDeliveryRate;       // Largest delivery rate sample, in bytes per second
+
+        uint64_t DatagramsExpired;      // Datagrams canceled because their deadline passed
+        uint64_t DatagramsDropped;      // Datagrams canceled because the send queue was full
     } Send;
 
     struct {
@@ -280,6 +293,9 @@ typedef struct QUIC_CONN_STATS {
 
         uint64_t TotalBytes;            // Sum of UDP payloads
         uint64_t TotalStreamBytes;      // Sum of stream payloads
+
+        uint32_t MaxStreamWindow;       // Largest stream flow control window
+        uint32_t WindowAutoTuneCount;   // Times a flow control window was grown
     } Recv;
 
     struct {
@@ -754,6 +770,19 @@ QuicLossDetectionGetConnection(
     return CXPLAT_CONTAINING_RECORD(LossDetection, QUIC_CONNECTION, LossDetection);
 }
 
+//
+// Helper to get the owning QUIC_CONNECTION for the send buffer.
+//
+inline
+_Ret_notnull_
+QUIC_CONNECTION*
+QuicSendBufferGetConnection(
+    _In_ QUIC_SEND_BUFFER* SendBuffer
+    )
+{
+    return CXPLAT_CONTAINING_RECORD(SendBuffer, QUIC_CONNECTION, SendBuffer);
+}
+
 //
 // Helper to get the owning QUIC_CONNECTION for datagram.
 //
@@ -1202,6 +1231,18 @@ QuicConnUpdateRtt(
     _In_ uint32_t LatestRtt
     );
 
+//
+// Moves the connection flow control window forward as stream data is
+// delivered to the app, and auto-tunes its size. Returns TRUE if the window
+// grew, so a MAX_DATA frame should be sent.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicConnOnBytesDelivered(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint64_t BytesDelivered
+    );
+
 //
 // Sets a new timer delay in microseconds.
 //
@@ -26,6 +26,14 @@ Future work:
 #define TEN_TIMES_BETA_CUBIC 7
 #define TEN_TIMES_C_CUBIC 4
 
+//
+// Fixed point representation of the L4S alpha (the fraction of CE marked
+// packets), and the gain used to update it once per round, 1/16 (RFC 8257).
+//
+#define ECN_ALPHA_SHIFT 10
+#define ECN_ALPHA_ONE (1 << ECN_ALPHA_SHIFT)
+#define ECN_ALPHA_GAIN_SHIFT 4
+
 //
 // Shifting nth root algorithm.
 //
@@ -129,6 +137,32 @@ CubicCongestionControlReset(
     QuicConnLogCubic(Connection);
 }
 
+//
+// Since the window grows via ACK feedback and since we defer packets when
+// pacing, using the current window to calculate the pacing interval can slow
+// the growth of the window. So instead, use the predicted window of the next
+// round trip. In slowstart, this is double the current window. In congestion
+// avoidance the growth function is more complicated, and we use a simple
+// estimate of 25% growth.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+CubicCongestionControlGetEstimatedWindow(
+    _In_ const QUIC_CONGESTION_CONTROL_CUBIC* Cubic
+    )
+{
+    uint64_t EstimatedWnd;
+    if (Cubic->CongestionWindow < Cubic->SlowStartThreshold) {
+        EstimatedWnd = (uint64_t)Cubic->CongestionWindow << 1;
+        if (EstimatedWnd > Cubic->SlowStartThreshold) {
+            EstimatedWnd = Cubic->SlowStartThreshold;
+        }
+    } else {
+        EstimatedWnd = Cubic->CongestionWindow + (Cubic->CongestionWindow >> 2); // CongestionWindow * 1.25
+    }
+    return EstimatedWnd;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint32_t
 CubicCongestionControlGetSendAllowance(
@@ -165,23 +199,7 @@ CubicCongestionControlGetSendAllowance(
         // size) as the time since the last send times the pacing rate (CWND / RTT).
         //
 
-        //
-        // Since the window grows via ACK feedback and since we defer packets
-        // when pacing, using the current window to calculate the pacing
-        // interval can slow the growth of the window. So instead, use the
-        // predicted window of the next round trip. In slowstart, this is double
-        // the current window. In congestion avoidance the growth function is
-        // more complicated, and we use a simple estimate of 25% growth.
-        //
-        uint64_t EstimatedWnd;
-        if (Cubic->CongestionWindow < Cubic->SlowStartThreshold) {
-            EstimatedWnd = (uint64_t)Cubic->CongestionWindow << 1;
-            if (EstimatedWnd > Cubic->SlowStartThreshold) {
-                EstimatedWnd = Cubic->SlowStartThreshold;
-            }
-        } else {
-            EstimatedWnd = Cubic->CongestionWindow + (Cubic->CongestionWindow >> 2); // CongestionWindow * 1.25
-        }
+        const uint64_t EstimatedWnd = CubicCongestionControlGetEstimatedWindow(Cubic);
 
         SendAllowance =
             Cubic->LastSendAllowance +
@@ -618,6 +636,101 @@ CubicCongestionControlOnSpuriousCongestionEvent(
     return Result;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CubicCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    )
+{
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic = &Cc->Cubic;
+
+    QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    BOOLEAN PreviousCanSendState = CubicCongestionControlCanSend(Cc);
+
+    if (!Cubic->L4sEnabled) {
+        //
+        // Classic ECN (RFC 9002 Section 7.1): respond to CE marks as if a
+        // packet was lost, at most once per round trip.
+        //
+        if (EcnEvent->NumCePackets == 0 ||
+            (Cubic->HasHadCongestionEvent &&
+             EcnEvent->LargestPacketNumberAcked <= Cubic->RecoverySentPacketNumber)) {
+            return;
+        }
+
+        Connection->Stats.Send.EcnCongestionCount++;
+        Cubic->RecoverySentPacketNumber = EcnEvent->LargestSentPacketNumber;
+        CubicCongestionControlOnCongestionEvent(Cc, FALSE);
+
+        //
+        // Unlike loss, a CE mark can't turn out to be spurious. Make sure a
+        // later spurious loss doesn't revert the reduction.
+        //
+        Cubic->PrevWindowMax = Cubic->WindowMax;
+        Cubic->PrevWindowLastMax = Cubic->WindowLastMax;
+        Cubic->PrevKCubic = Cubic->KCubic;
+        Cubic->PrevSlowStartThreshold = Cubic->SlowStartThreshold;
+        Cubic->PrevCongestionWindow = Cubic->CongestionWindow;
+        Cubic->PrevAimdWindow = Cubic->AimdWindow;
+
+    } else {
+        //
+        // L4S: scale the reduction by the fraction of CE marked packets, as
+        // DCTCP does (RFC 8257), once per round and without entering
+        // recovery.
+        //
+        Cubic->EcnRoundEctCount += EcnEvent->NumEctPackets;
+        Cubic->EcnRoundCeCount += EcnEvent->NumCePackets;
+        if (EcnEvent->LargestPacketNumberAcked <= Cubic->EcnRoundEndPacketNumber ||
+            Cubic->EcnRoundEctCount == 0) {
+            return;
+        }
+
+        uint32_t Fraction =
+            (uint32_t)((CXPLAT_MIN(Cubic->EcnRoundCeCount, Cubic->EcnRoundEctCount)
+                << ECN_ALPHA_SHIFT) / Cubic->EcnRoundEctCount);
+        Cubic->EcnAlpha =
+            Cubic->EcnAlpha - (Cubic->EcnAlpha >> ECN_ALPHA_GAIN_SHIFT) +
+            (Fraction >> ECN_ALPHA_GAIN_SHIFT);
+
+        if (Cubic->EcnRoundCeCount > 0) {
+            const uint16_t DatagramPayloadLength =
+                QuicPathGetDatagramPayloadSize(&Connection->Paths[0]);
+            Connection->Stats.Send.EcnCongestionCount++;
+
+            uint32_t Reduction =
+                (uint32_t)(((uint64_t)Cubic->CongestionWindow * Cubic->EcnAlpha) >>
+                    (ECN_ALPHA_SHIFT + 1));
+            Cubic->SlowStartThreshold =
+            Cubic->CongestionWindow =
+            Cubic->AimdWindow =
+            Cubic->WindowMax =
+                CXPLAT_MAX(
+                    (uint32_t)DatagramPayloadLength * QUIC_PERSISTENT_CONGESTION_WINDOW_PACKETS,
+                    Cubic->CongestionWindow - Reduction);
+            Cubic->WindowLastMax = Cubic->WindowMax;
+            Cubic->AimdAccumulator = 0;
+            Cubic->KCubic = 0;
+            Cubic->TimeOfCongAvoidStart = CxPlatTimeUs64();
+
+            QuicTraceLogConnVerbose(
+                EcnL4sWindowReduction,
+                Connection,
+                "L4S window reduction, alpha=%u/1024, CongestionWindow=%u",
+                Cubic->EcnAlpha,
+                Cubic->CongestionWindow);
+        }
+
+        Cubic->EcnRoundEctCount = 0;
+        Cubic->EcnRoundCeCount = 0;
+        Cubic->EcnRoundEndPacketNumber = EcnEvent->LargestSentPacketNumber;
+    }
+
+    CubicCongestionControlUpdateBlockedState(Cc, PreviousCanSendState);
+    QuicConnLogCubic(Connection);
+}
+
 void
 CubicCongestionControlLogOutFlowStatus(
     _In_ const QUIC_CONGESTION_CONTROL* Cc
@@ -667,6 +780,26 @@ CubicCongestionControlGetCongestionWindow(
     return Cc->Cubic.CongestionWindow;
 }
 
+uint64_t
+CubicCongestionControlGetPacingRate(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    )
+{
+    const QUIC_CONNECTION* Connection = QuicCongestionControlGetConnection(Cc);
+    if (!Connection->Settings.PacingEnabled ||
+        !Connection->Paths[0].GotFirstRttSample ||
+        Connection->Paths[0].SmoothedRtt < QUIC_MIN_PACING_RTT) {
+        return 0;
+    }
+
+    //
+    // The same rate GetSendAllowance spreads the window out at.
+    //
+    return
+        CubicCongestionControlGetEstimatedWindow(&Cc->Cubic) * S_TO_US(1) /
+        Connection->Paths[0].SmoothedRtt;
+}
+
 static const QUIC_CONGESTION_CONTROL QuicCongestionControlCubic = {
     .Name = "Cubic",
     .QuicCongestionControlCanSend = CubicCongestionControlCanSend,
@@ -678,10 +811,12 @@ static const QUIC_CONGESTION_CONTROL QuicCongestionControlCubic = {
     .QuicCongestionControlOnDataAcknowledged = CubicCongestionControlOnDataAcknowledged,
     .QuicCongestionControlOnDataLost = CubicCongestionControlOnDataLost,
     .QuicCongestionControlOnSpuriousCongestionEvent = CubicCongestionControlOnSpuriousCongestionEvent,
+    .QuicCongestionControlOnEcn = CubicCongestionControlOnEcn,
     .QuicCongestionControlLogOutFlowStatus = CubicCongestionControlLogOutFlowStatus,
     .QuicCongestionControlGetExemptions = CubicCongestionControlGetExemptions,
     .QuicCongestionControlGetBytesInFlightMax = CubicCongestionControlGetBytesInFlightMax,
     .QuicCongestionControlGetCongestionWindow = CubicCongestionControlGetCongestionWindow,
+    .QuicCongestionControlGetPacingRate = CubicCongestionControlGetPacingRate,
 };
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -701,6 +836,8 @@ CubicCongestionControlInitialize(
     Cubic->SlowStartThreshold = UINT32_MAX;
     Cubic->SendIdleTimeoutMs = Settings->SendIdleTimeoutMs;
     Cubic->InitialWindowPackets = Settings->InitialWindowPackets;
+    Cubic->L4sEnabled = Settings->EcnEnabled && Settings->L4sEnabled;
+    Cubic->EcnAlpha = ECN_ALPHA_ONE;
     Cubic->CongestionWindow = DatagramPayloadLength * Cubic->InitialWindowPackets;
     Cubic->BytesInFlightMax = Cubic->CongestionWindow / 2;
 
@@ -7,6 +7,10 @@
 
 #pragma once
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
 
     //
@@ -32,6 +36,12 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
     //
     BOOLEAN TimeOfLastAckValid : 1;
 
+    //
+    // TRUE if CE marks get the scalable (L4S) response instead of the classic
+    // one, which treats them like loss.
+    //
+    BOOLEAN L4sEnabled : 1;
+
     //
     // The size of the initial congestion window, in packets.
     //
@@ -90,6 +100,16 @@ typedef struct QUIC_CONGESTION_CONTROL_CUBIC {
     //
     uint64_t RecoverySentPacketNumber;
 
+    //
+    // L4S state. EcnAlpha is the moving average of the fraction of CE marked
+    // packets, in fixed point. The round counts accumulate ECN feedback until
+    // a packet sent after EcnRoundEndPacketNumber is acknowledged.
+    //
+    uint32_t EcnAlpha;
+    uint64_t EcnRoundEctCount;
+    uint64_t EcnRoundCeCount;
+    uint64_t EcnRoundEndPacketNumber;
+
 } QUIC_CONGESTION_CONTROL_CUBIC;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -98,3 +118,7 @@ CubicCongestionControlInitialize(
     _In_ QUIC_CONGESTION_CONTROL* Cc,
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     );
+
+#if defined(__cplusplus)
+}
+#endif
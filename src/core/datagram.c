@@ -47,11 +47,14 @@ QuicDatagramValidate(
     if (!Datagram->SendEnabled) {
         CXPLAT_DBG_ASSERT(Datagram->MaxSendLength == 0);
     } else {
+        uint32_t SendQueueCount = 0;
         QUIC_SEND_REQUEST* SendRequest = Datagram->SendQueue;
         while (SendRequest) {
             CXPLAT_DBG_ASSERT(SendRequest->TotalLength <= (uint64_t)Datagram->MaxSendLength);
             SendRequest = SendRequest->Next;
+            SendQueueCount++;
         }
+        CXPLAT_DBG_ASSERT(SendQueueCount == Datagram->SendQueueCount);
     }
 }
 #else
@@ -81,6 +84,7 @@ QuicDatagramInitialize(
     Datagram->MaxSendLength = UINT16_MAX;
     Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
     Datagram->SendQueueTail = &Datagram->SendQueue;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockInitialize(&Datagram->ApiQueueLock);
     QuicDatagramValidate(Datagram);
 }
@@ -122,6 +126,69 @@ QuicDatagramCancelSend(
     CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
 }
 
+//
+// Unlinks the send request that Link points to from the send queue.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_SEND_REQUEST*
+QuicDatagramSendQueueRemove(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ QUIC_SEND_REQUEST** Link
+    )
+{
+    QUIC_SEND_REQUEST* SendRequest = *Link;
+    if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
+        Datagram->PrioritySendQueueTail = Link;
+    }
+    if (Datagram->SendQueueTail == &SendRequest->Next) {
+        Datagram->SendQueueTail = Link;
+    }
+    *Link = SendRequest->Next;
+    CXPLAT_DBG_ASSERT(Datagram->SendQueueCount != 0);
+    Datagram->SendQueueCount--;
+    return SendRequest;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramExpireSend(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_SEND_REQUEST* SendRequest
+    )
+{
+    QuicTraceLogConnVerbose(
+        DatagramSendExpired,
+        Connection,
+        "Datagram [%p] expired before it was sent",
+        SendRequest);
+    Connection->Stats.Send.DatagramsExpired++;
+    QuicDatagramCancelSend(Connection, SendRequest);
+}
+
+//
+// Cancels all queued send requests whose deadline has passed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicDatagramSendQueueExpire(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ uint64_t TimeNow
+    )
+{
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+    QUIC_SEND_REQUEST** SendQueue = &Datagram->SendQueue;
+    while (*SendQueue != NULL) {
+        if (((*SendQueue)->Flags & QUIC_SEND_FLAG_DGRAM_EXPIRE) &&
+            (*SendQueue)->ExpirationTime <= TimeNow) {
+            QuicDatagramExpireSend(
+                Connection,
+                QuicDatagramSendQueueRemove(Datagram, SendQueue));
+        } else {
+            SendQueue = &((*SendQueue)->Next);
+        }
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramCompleteSend(
@@ -172,6 +239,7 @@ QuicDatagramSendShutdown(
     Datagram->MaxSendLength = 0;
     QUIC_SEND_REQUEST* ApiQueue = Datagram->ApiQueue;
     Datagram->ApiQueue = NULL;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
     QuicSendClearSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
@@ -186,6 +254,7 @@ QuicDatagramSendShutdown(
     }
     Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
     Datagram->SendQueueTail = &Datagram->SendQueue;
+    Datagram->SendQueueCount = 0;
 
     while (ApiQueue != NULL) {
         QUIC_SEND_REQUEST* SendRequest = ApiQueue;
@@ -210,17 +279,14 @@ QuicDatagramOnMaxSendLengthChanged(
     QUIC_SEND_REQUEST** SendQueue = &Datagram->SendQueue;
     while (*SendQueue != NULL) {
         if ((*SendQueue)->TotalLength > (uint64_t)Datagram->MaxSendLength) {
-            QUIC_SEND_REQUEST* SendRequest = *SendQueue;
-            if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-                Datagram->PrioritySendQueueTail = SendQueue;
-            }
-            *SendQueue = SendRequest->Next;
-            QuicDatagramCancelSend(Connection, SendRequest);
+            QuicDatagramCancelSend(
+                Connection,
+                QuicDatagramSendQueueRemove(Datagram, SendQueue));
         } else {
             SendQueue = &((*SendQueue)->Next);
         }
     }
-    Datagram->SendQueueTail = SendQueue;
+    CXPLAT_DBG_ASSERT(Datagram->SendQueueTail == SendQueue);
 
     if (Datagram->SendQueue != NULL) {
         QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
@@ -319,6 +385,126 @@ QuicDatagramOnSendStateChanged(
     QuicDatagramValidate(Datagram);
 }
 
+//
+// Returns the time a datagram sent now with QUIC_SEND_FLAG_DGRAM_EXPIRE
+// expires.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+QuicDatagramSendExpirationTime(
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    const uint32_t TtlMs = Connection->Settings.DatagramSendTtlMs;
+    return TtlMs == 0 ? UINT64_MAX : CxPlatTimeUs64() + MS_TO_US((uint64_t)TtlMs);
+}
+
+//
+// Allocates the operation that moves the API queue onto the send queue.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_OPERATION*
+QuicDatagramSendOperAlloc(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_OPERATION* Oper =
+        QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "DATAGRAM_SEND operation",
+            0);
+        return NULL;
+    }
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_DATAGRAM_SEND;
+    return Oper;
+}
+
+//
+// Queues the operation that moves the API queue onto the send queue.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicDatagramQueueSendOper(
+    _In_ QUIC_CONNECTION* Connection
+    )
+{
+    QUIC_OPERATION* Oper = QuicDatagramSendOperAlloc(Connection);
+    if (Oper == NULL) {
+        return FALSE;
+    }
+
+    //
+    // Queue the operation but don't wait for the completion.
+    //
+    QuicConnQueueOper(Connection, Oper);
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicDatagramSendRequestAlloc(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* const Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext,
+    _Inout_ uint64_t* ExpirationTime,
+    _Outptr_ QUIC_SEND_REQUEST** NewSendRequest
+    )
+{
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+    *NewSendRequest = NULL;
+
+    if (Buffers == NULL || BufferCount == 0) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (!Datagram->SendEnabled) {
+        return QUIC_STATUS_INVALID_STATE; // Checked again when queued.
+    }
+
+    uint64_t TotalLength = 0;
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        TotalLength += Buffers[i].Length;
+    }
+
+    if (TotalLength > (uint64_t)Datagram->MaxSendLength) {
+        QuicTraceEvent(
+            ConnError,
+            "[conn][%p] ERROR, %s.",
+            Connection,
+            "Datagram send request is longer than allowed");
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (...).")
+    QUIC_SEND_REQUEST* SendRequest =
+        CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
+    if (SendRequest == NULL) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    SendRequest->Next = NULL;
+    SendRequest->Buffers = Buffers;
+    SendRequest->BufferCount = BufferCount;
+    SendRequest->Flags = Flags;
+    SendRequest->TotalLength = TotalLength;
+    SendRequest->ClientContext = ClientSendContext;
+    if (Flags & QUIC_SEND_FLAG_DGRAM_EXPIRE) {
+        if (*ExpirationTime == 0) {
+            *ExpirationTime = QuicDatagramSendExpirationTime(Connection);
+        }
+        SendRequest->ExpirationTime = *ExpirationTime;
+    }
+
+    *NewSendRequest = SendRequest;
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicDatagramQueueSend(
@@ -339,22 +525,12 @@ QuicDatagramQueueSend(
             "Datagram send while disabled");
         Status = QUIC_STATUS_INVALID_STATE;
     } else {
-        if (SendRequest->TotalLength > (uint64_t)Datagram->MaxSendLength) {
-            QuicTraceEvent(
-                ConnError,
-                "[conn][%p] ERROR, %s.",
-                Connection,
-                "Datagram send request is longer than allowed");
-            Status = QUIC_STATUS_INVALID_PARAMETER;
-        } else {
-            QUIC_SEND_REQUEST** ApiQueueTail = &Datagram->ApiQueue;
-            while (*ApiQueueTail != NULL) {
-                ApiQueueTail = &((*ApiQueueTail)->Next);
-                QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
-            }
-            *ApiQueueTail = SendRequest;
-            Status = QUIC_STATUS_SUCCESS;
+        if (Datagram->ApiQueue != NULL) {
+            QueueOper = FALSE; // Not necessary if the previous send hasn't been flushed yet.
         }
+        *Datagram->ApiQueueTail = SendRequest;
+        Datagram->ApiQueueTail = &SendRequest->Next;
+        Status = QUIC_STATUS_SUCCESS;
     }
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
 
@@ -363,24 +539,9 @@ QuicDatagramQueueSend(
         goto Exit;
     }
 
-    if (QueueOper) {
-        QUIC_OPERATION* Oper =
-            QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
-        if (Oper == NULL) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "DATAGRAM_SEND operation",
-                0);
-            goto Exit;
-        }
-        Oper->API_CALL.Context->Type = QUIC_API_TYPE_DATAGRAM_SEND;
-
-        //
-        // Queue the operation but don't wait for the completion.
-        //
-        QuicConnQueueOper(Connection, Oper);
+    if (QueueOper && !QuicDatagramQueueSendOper(Connection)) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Exit;
     }
 
     Status = QUIC_STATUS_PENDING;
@@ -390,6 +551,119 @@ Exit:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicDatagramQueueSendBatch(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ uint32_t EntryCount,
+    _Inout_updates_(EntryCount)
+        QUIC_DATAGRAM_SEND_ENTRY* Entries
+    )
+{
+    QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+    QUIC_SEND_REQUEST* SendQueue = NULL;
+    QUIC_SEND_REQUEST** SendQueueTail = &SendQueue;
+    uint64_t ExpirationTime = 0;
+    QUIC_OPERATION* Oper;
+    QUIC_STATUS FailStatus;
+    BOOLEAN SendEnabled;
+    BOOLEAN QueueOper = FALSE;
+    uint32_t i;
+
+    if (!Datagram->SendEnabled) {
+        for (i = 0; i < EntryCount; ++i) {
+            Entries[i].Status = QUIC_STATUS_INVALID_STATE;
+        }
+        goto Disabled; // Checked again under the lock below.
+    }
+
+    //
+    // Validate the entries and build the chain of send requests before taking
+    // the lock, so that it is only held to splice the whole chain onto the
+    // API queue.
+    //
+    for (i = 0; i < EntryCount; ++i) {
+        QUIC_DATAGRAM_SEND_ENTRY* Entry = &Entries[i];
+        QUIC_SEND_REQUEST* SendRequest;
+
+        Entry->Status =
+            QuicDatagramSendRequestAlloc(
+                Datagram,
+                Entry->Buffers,
+                Entry->BufferCount,
+                Entry->Flags,
+                Entry->ClientSendContext,
+                &ExpirationTime,
+                &SendRequest);
+        if (QUIC_FAILED(Entry->Status)) {
+            continue;
+        }
+
+        *SendQueueTail = SendRequest;
+        SendQueueTail = &SendRequest->Next;
+        Entry->Status = QUIC_STATUS_PENDING;
+    }
+
+    if (SendQueue == NULL) {
+        return;
+    }
+
+    //
+    // The operation that flushes the chain is allocated up front, whether or
+    // not it ends up being needed, so that failing to allocate it fails the
+    // batch instead of leaving it queued with nothing to flush it.
+    //
+    Oper = QuicDatagramSendOperAlloc(Connection);
+    if (Oper != NULL) {
+        CxPlatDispatchLockAcquire(&Datagram->ApiQueueLock);
+        SendEnabled = Datagram->SendEnabled;
+        if (SendEnabled) {
+            QueueOper = Datagram->ApiQueue == NULL;
+            *Datagram->ApiQueueTail = SendQueue;
+            Datagram->ApiQueueTail = SendQueueTail;
+        }
+        CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
+
+        if (SendEnabled && QueueOper) {
+            //
+            // Queue the operation but don't wait for the completion.
+            //
+            QuicConnQueueOper(Connection, Oper);
+            return;
+        }
+        QuicOperationFree(Connection->Worker, Oper);
+        if (SendEnabled) {
+            return; // The previous send's operation flushes this one too.
+        }
+        FailStatus = QUIC_STATUS_INVALID_STATE;
+    } else {
+        FailStatus = QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    while (SendQueue != NULL) {
+        QUIC_SEND_REQUEST* SendRequest = SendQueue;
+        SendQueue = SendQueue->Next;
+        CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+    }
+    for (i = 0; i < EntryCount; ++i) {
+        if (Entries[i].Status == QUIC_STATUS_PENDING) {
+            Entries[i].Status = FailStatus;
+        }
+    }
+
+    if (FailStatus == QUIC_STATUS_OUT_OF_MEMORY) {
+        return;
+    }
+
+Disabled:
+
+    QuicTraceEvent(
+        ConnError,
+        "[conn][%p] ERROR, %s.",
+        Connection,
+        "Datagram send while disabled");
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramSendFlush(
@@ -399,6 +673,7 @@ QuicDatagramSendFlush(
     CxPlatDispatchLockAcquire(&Datagram->ApiQueueLock);
     QUIC_SEND_REQUEST* ApiQueue = Datagram->ApiQueue;
     Datagram->ApiQueue = NULL;
+    Datagram->ApiQueueTail = &Datagram->ApiQueue;
     CxPlatDispatchLockRelease(&Datagram->ApiQueueLock);
     uint64_t TotalBytesSent = 0;
 
@@ -407,6 +682,10 @@ QuicDatagramSendFlush(
     }
 
     QUIC_CONNECTION* Connection = QuicDatagramGetConnection(Datagram);
+    const uint16_t QueueLimit = Connection->Settings.DatagramSendQueueLimit;
+    uint64_t TimeNow = 0;
+    BOOLEAN QueueExpired = FALSE;
+
     while (ApiQueue != NULL) {
 
         QUIC_SEND_REQUEST* SendRequest = ApiQueue;
@@ -420,7 +699,60 @@ QuicDatagramSendFlush(
             QuicDatagramCancelSend(Connection, SendRequest);
             continue;
         }
+
+        if (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_EXPIRE) {
+            if (TimeNow == 0) {
+                TimeNow = CxPlatTimeUs64();
+            }
+            if (SendRequest->ExpirationTime <= TimeNow) {
+                QuicDatagramExpireSend(Connection, SendRequest);
+                continue;
+            }
+        }
+
+        if (QueueLimit != 0 && Datagram->SendQueueCount >= QueueLimit) {
+            //
+            // The queue is full. Make room by dropping anything that has
+            // already expired (at most once per flush) before applying the
+            // drop policy.
+            //
+            if (!QueueExpired) {
+                if (TimeNow == 0) {
+                    TimeNow = CxPlatTimeUs64();
+                }
+                QuicDatagramSendQueueExpire(Datagram, TimeNow);
+                QueueExpired = TRUE;
+            }
+            if (Datagram->SendQueueCount >= QueueLimit) {
+                QUIC_SEND_REQUEST* DroppedRequest;
+                if (Connection->Settings.DatagramSendDropPolicy == QUIC_DATAGRAM_DROP_NEWEST) {
+                    DroppedRequest = SendRequest;
+                    SendRequest = NULL;
+                } else {
+                    //
+                    // Drop the oldest normal priority datagram, or the oldest
+                    // priority datagram if there are only priority ones.
+                    //
+                    QUIC_SEND_REQUEST** Oldest =
+                        *Datagram->PrioritySendQueueTail != NULL ?
+                            Datagram->PrioritySendQueueTail : &Datagram->SendQueue;
+                    DroppedRequest = QuicDatagramSendQueueRemove(Datagram, Oldest);
+                }
+                QuicTraceLogConnVerbose(
+                    DatagramSendDropped,
+                    Connection,
+                    "Datagram [%p] dropped, send queue full",
+                    DroppedRequest);
+                Connection->Stats.Send.DatagramsDropped++;
+                QuicDatagramCancelSend(Connection, DroppedRequest);
+                if (SendRequest == NULL) {
+                    continue;
+                }
+            }
+        }
+
         TotalBytesSent += SendRequest->TotalLength;
+        Datagram->SendQueueCount++;
 
         if (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_PRIORITY) {
             SendRequest->Next = *Datagram->PrioritySendQueueTail;
@@ -443,7 +775,9 @@ QuicDatagramSendFlush(
             SendRequest->Flags);
     }
 
-    if (Connection->State.PeerTransportParameterValid && Datagram->SendQueue != NULL) {
+    if (Datagram->SendQueue == NULL) {
+        QuicSendClearSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
+    } else if (Connection->State.PeerTransportParameterValid) {
         CXPLAT_DBG_ASSERT(Datagram->SendEnabled);
         QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_DATAGRAM);
     }
@@ -465,9 +799,22 @@ QuicDatagramWriteFrame(
 
     QuicDatagramValidate(Datagram);
 
+    uint64_t TimeNow = 0;
     while (Datagram->SendQueue != NULL) {
         QUIC_SEND_REQUEST* SendRequest = Datagram->SendQueue;
 
+        if (SendRequest->Flags & QUIC_SEND_FLAG_DGRAM_EXPIRE) {
+            if (TimeNow == 0) {
+                TimeNow = CxPlatTimeUs64();
+            }
+            if (SendRequest->ExpirationTime <= TimeNow) {
+                QuicDatagramExpireSend(
+                    Connection,
+                    QuicDatagramSendQueueRemove(Datagram, &Datagram->SendQueue));
+                continue;
+            }
+        }
+
         if (Builder->Metadata->Flags.KeyType == QUIC_PACKET_KEY_0_RTT &&
             !(SendRequest->Flags & QUIC_SEND_FLAG_ALLOW_0_RTT)) {
             CXPLAT_DBG_ASSERT(FALSE);
@@ -503,13 +850,7 @@ QuicDatagramWriteFrame(
             goto Exit;
         }
 
-        if (Datagram->PrioritySendQueueTail == &SendRequest->Next) {
-            Datagram->PrioritySendQueueTail = &Datagram->SendQueue;
-        }
-        if (Datagram->SendQueueTail == &SendRequest->Next) {
-            Datagram->SendQueueTail = &Datagram->SendQueue;
-        }
-        Datagram->SendQueue = SendRequest->Next;
+        (void)QuicDatagramSendQueueRemove(Datagram, &Datagram->SendQueue);
 
         Builder->Metadata->Flags.IsAckEliciting = TRUE;
         Builder->Metadata->Frames[Builder->Metadata->FrameCount].Type = QUIC_FRAME_DATAGRAM;
@@ -8,11 +8,12 @@
 typedef struct QUIC_DATAGRAM {
 
     //
-    // Datagram send queue.
+    // Datagram send queue, and the number of requests in it.
     //
     QUIC_SEND_REQUEST* SendQueue;
     QUIC_SEND_REQUEST** PrioritySendQueueTail;
     QUIC_SEND_REQUEST** SendQueueTail;
+    uint32_t SendQueueCount;
 
     //
     // API calls to DatagramSend queue the send request here and then queue the
@@ -20,6 +21,7 @@ typedef struct QUIC_DATAGRAM {
     // send queue.
     //
     QUIC_SEND_REQUEST* ApiQueue;
+    QUIC_SEND_REQUEST** ApiQueueTail;
     CXPLAT_DISPATCH_LOCK ApiQueueLock;
 
     //
@@ -64,6 +66,24 @@ QuicDatagramOnSendStateChanged(
     _In_ QUIC_DATAGRAM* Datagram
     );
 
+//
+// Validates a datagram send and allocates its send request, for both the
+// single and batch send APIs. ExpirationTime is set on first use, so the
+// sends of a batch share it; pass in 0.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicDatagramSendRequestAlloc(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* const Buffers,
+    _In_ uint32_t BufferCount,
+    _In_ QUIC_SEND_FLAGS Flags,
+    _In_opt_ void* ClientSendContext,
+    _Inout_ uint64_t* ExpirationTime,
+    _Outptr_ QUIC_SEND_REQUEST** NewSendRequest
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicDatagramQueueSend(
@@ -71,6 +91,19 @@ QuicDatagramQueueSend(
     _In_ QUIC_SEND_REQUEST* SendRequest
     );
 
+//
+// Queues the sends for a run of batch entries that are all for this
+// connection, writing each entry's result to its Status field.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicDatagramQueueSendBatch(
+    _In_ QUIC_DATAGRAM* Datagram,
+    _In_ uint32_t EntryCount,
+    _Inout_updates_(EntryCount)
+        QUIC_DATAGRAM_SEND_ENTRY* Entries
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicDatagramSendFlush(
@@ -359,6 +359,13 @@ QuicCongestionControlOnSpuriousCongestionEvent(
     _In_ QUIC_CONGESTION_CONTROL* Cc
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCongestionControlOnEcn(
+    _In_ QUIC_CONGESTION_CONTROL* Cc,
+    _In_ const QUIC_ECN_EVENT* EcnEvent
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint8_t
 QuicCongestionControlGetExemptions(
@@ -383,6 +390,12 @@ QuicCongestionControlGetBytesInFlightMax(
     _In_ const QUIC_CONGESTION_CONTROL* Cc
     );
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint64_t
+QuicCongestionControlGetPacingRate(
+    _In_ const QUIC_CONGESTION_CONTROL* Cc
+    );
+
 QUIC_CONNECTION*
 QuicCongestionControlGetConnection(
     _In_ const QUIC_CONGESTION_CONTROL* Cc
@@ -398,6 +411,11 @@ QuicDatagramGetConnection(
     _In_ const QUIC_DATAGRAM* const Datagram
     );
 
+QUIC_CONNECTION*
+QuicSendBufferGetConnection(
+    _In_ QUIC_SEND_BUFFER* SendBuffer
+    );
+
 uint8_t
 QuicEncryptLevelToPacketType(
     QUIC_ENCRYPT_LEVEL Level
@@ -706,6 +724,17 @@ QuicPacketBuilderHasAllowance(
     _In_ const QUIC_PACKET_BUILDER* Builder
     );
 
+void
+QuicPacketBuilderCompleteDatagram(
+    _Inout_ QUIC_PACKET_BUILDER* Builder
+    );
+
+uint64_t
+QuicPacketBuilderGetBatchTxTime(
+    _In_ QUIC_PACKET_BUILDER* Builder,
+    _In_ uint64_t TimeNow
+    );
+
 QUIC_CID_HASH_ENTRY*
 QuicConnGetSourceCidFromSeq(
     _In_ QUIC_CONNECTION* Connection,
@@ -734,6 +763,22 @@ QuicPacketTraceType(
     _In_ const QUIC_SENT_PACKET_METADATA* Metadata
     );
 
+uint64_t
+QuicSentPacketRingEnd(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    );
+
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingGet(
+    _In_ const QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint64_t PacketNumber
+    );
+
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingFirst(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    );
+
 int64_t
 CxPlatTimeEpochMs64(
     void
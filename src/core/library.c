@@ -47,6 +47,7 @@ MsQuicLibraryLoad(
         CxPlatLockInitialize(&MsQuicLib.Lock);
         CxPlatDispatchLockInitialize(&MsQuicLib.DatapathLock);
         CxPlatDispatchLockInitialize(&MsQuicLib.StatelessRetryKeysLock);
+        CxPlatDispatchLockInitialize(&MsQuicLib.CidKeyLock);
         CxPlatListInitializeHead(&MsQuicLib.Registrations);
         CxPlatListInitializeHead(&MsQuicLib.Bindings);
         QuicTraceRundownCallback = QuicTraceRundown;
@@ -73,6 +74,7 @@ MsQuicLibraryUnload(
         QUIC_LIB_VERIFY(MsQuicLib.OpenRefCount == 0);
         QUIC_LIB_VERIFY(!MsQuicLib.InUse);
         MsQuicLib.Loaded = FALSE;
+        CxPlatDispatchLockUninitialize(&MsQuicLib.CidKeyLock);
         CxPlatDispatchLockUninitialize(&MsQuicLib.StatelessRetryKeysLock);
         CxPlatDispatchLockUninitialize(&MsQuicLib.DatapathLock);
         CxPlatLockUninitialize(&MsQuicLib.Lock);
@@ -202,6 +204,9 @@ MsQuicLibraryOnSettingsChanged(
         (MsQuicLib.Settings.RetryMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
     QuicLibraryEvaluateSendRetryState();
 
+    MsQuicLib.RecvWindowMemoryLimit =
+        (MsQuicLib.Settings.RecvWindowMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
+
     if (UpdateRegistrations) {
         CxPlatLockAcquire(&MsQuicLib.Lock);
 
@@ -543,6 +548,14 @@ MsQuicLibraryUninitialize(
         MsQuicLib.StatelessRetryKeys[i] = NULL;
     }
 
+    if (MsQuicLib.CidKey != NULL) {
+        CxPlatBlockKeyFree(MsQuicLib.CidKey);
+        MsQuicLib.CidKey = NULL;
+    }
+    CxPlatSecureZeroMemory(&MsQuicLib.LoadBalancingConfig, sizeof(MsQuicLib.LoadBalancingConfig));
+    MsQuicLib.CidQuicLb = FALSE;
+    MsQuicLib.CidEncrypted = FALSE;
+
     QuicSettingsCleanup(&MsQuicLib.Settings);
 
     CXPLAT_FREE(MsQuicLib.DefaultCompatibilityList, QUIC_POOL_DEFAULT_COMPAT_VER_LIST);
@@ -688,13 +701,86 @@ MsQuicSetCallbackHandler(
     Handle->ClientContext = Context;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicLibraryLbConfigSupportsMode(
+    _In_ uint16_t Mode
+    )
+{
+    const QUIC_LOAD_BALANCING_CONFIG* Config = &MsQuicLib.LoadBalancingConfig;
+    switch (Mode) {
+    case QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT:
+        return Config->ServerIdLength != 0;
+    case QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED:
+        return
+            Config->ServerIdLength != 0 &&
+            Config->ServerIdLength <= QUIC_CID_LB_ENCRYPTED_SID_LENGTH &&
+            MsQuicLib.CidKey != NULL;
+    default:
+        return TRUE;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryGenerateLbServerId(
+    _Out_writes_(MsQuicLib.CidServerIdLength)
+        uint8_t* ServerID
+    )
+{
+    const QUIC_LOAD_BALANCING_CONFIG* Config = &MsQuicLib.LoadBalancingConfig;
+    CXPLAT_DBG_ASSERT(MsQuicLib.CidQuicLb);
+    CXPLAT_DBG_ASSERT(MsQuicLib.CidServerIdLength > Config->ServerIdLength);
+
+    ServerID[0] =
+        (uint8_t)(Config->ConfigId << QUIC_CID_LB_CONFIG_ID_SHIFT) |
+        (uint8_t)((MsQuicLib.CidTotalLength - 1) & QUIC_CID_LB_LENGTH_MASK);
+    CxPlatCopyMemory(ServerID + 1, Config->ServerId, Config->ServerIdLength);
+
+    uint8_t PadLength =
+        MsQuicLib.CidServerIdLength - 1 - Config->ServerIdLength;
+    if (PadLength != 0) {
+        CxPlatRandom(PadLength, ServerID + 1 + Config->ServerIdLength);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicLibraryEncryptCid(
+    _Inout_updates_(MsQuicLib.CidTotalLength)
+        uint8_t* Cid
+    )
+{
+    CXPLAT_DBG_ASSERT(MsQuicLib.CidEncrypted);
+    CXPLAT_DBG_ASSERT(MsQuicLib.CidTotalLength == 1 + CXPLAT_BLOCK_LENGTH);
+
+    CxPlatDispatchLockAcquire(&MsQuicLib.CidKeyLock);
+    QUIC_STATUS Status = CxPlatBlockEncrypt(MsQuicLib.CidKey, Cid + 1, Cid + 1);
+    CxPlatDispatchLockRelease(&MsQuicLib.CidKeyLock);
+
+    return Status;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLibApplyLoadBalancingSetting(
     void
     )
 {
-    switch (MsQuicLib.Settings.LoadBalancingMode) {
+    uint16_t Mode = MsQuicLib.Settings.LoadBalancingMode;
+    if (Mode >= QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT &&
+        !QuicLibraryLbConfigSupportsMode(Mode)) {
+        QuicTraceLogWarning(
+            LibraryLoadBalancingConfigMissing,
+            "[ lib] No valid QUIC-LB config for load balancing mode %hu",
+            Mode);
+        Mode = QUIC_LOAD_BALANCING_DISABLED;
+    }
+
+    MsQuicLib.CidQuicLb = FALSE;
+    MsQuicLib.CidEncrypted = FALSE;
+
+    switch (Mode) {
     case QUIC_LOAD_BALANCING_DISABLED:
     default:
         MsQuicLib.CidServerIdLength = 0;
@@ -702,6 +788,15 @@ QuicLibApplyLoadBalancingSetting(
     case QUIC_LOAD_BALANCING_SERVER_ID_IP:
         MsQuicLib.CidServerIdLength = 5; // 1 + 4 for v4 IP address
         break;
+    case QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT:
+        MsQuicLib.CidServerIdLength = 1 + MsQuicLib.LoadBalancingConfig.ServerIdLength;
+        MsQuicLib.CidQuicLb = TRUE;
+        break;
+    case QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED:
+        MsQuicLib.CidServerIdLength = 1 + QUIC_CID_LB_ENCRYPTED_SID_LENGTH;
+        MsQuicLib.CidQuicLb = TRUE;
+        MsQuicLib.CidEncrypted = TRUE;
+        break;
     }
 
     MsQuicLib.CidTotalLength =
@@ -756,11 +851,20 @@ QuicLibrarySetGlobalParam(
             break;
         }
 
-        if (*(uint16_t*)Buffer > QUIC_LOAD_BALANCING_SERVER_ID_IP) {
+        if (*(uint16_t*)Buffer >= QUIC_LOAD_BALANCING_COUNT) {
             Status = QUIC_STATUS_INVALID_PARAMETER;
             break;
         }
 
+        if (!QuicLibraryLbConfigSupportsMode(*(uint16_t*)Buffer)) {
+            QuicTraceLogError(
+                LibraryLoadBalancingModeMissingConfig,
+                "[ lib] No valid QUIC-LB config for load balancing mode %hu",
+                *(uint16_t*)Buffer);
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
         if (MsQuicLib.InUse &&
             MsQuicLib.Settings.LoadBalancingMode != *(uint16_t*)Buffer) {
             QuicTraceLogError(
@@ -777,10 +881,61 @@ QuicLibrarySetGlobalParam(
             "[ lib] Updated load balancing mode = %hu",
             MsQuicLib.Settings.LoadBalancingMode);
 
+        if (!MsQuicLib.InUse) {
+            QuicLibApplyLoadBalancingSetting();
+        }
+
         Status = QUIC_STATUS_SUCCESS;
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG: {
+
+        if (BufferLength != sizeof(QUIC_LOAD_BALANCING_CONFIG) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        const QUIC_LOAD_BALANCING_CONFIG* Config =
+            (const QUIC_LOAD_BALANCING_CONFIG*)Buffer;
+        if (Config->ConfigId > QUIC_LOAD_BALANCING_MAX_CONFIG_ID ||
+            Config->ServerIdLength == 0 ||
+            Config->ServerIdLength > QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH ||
+            (MsQuicLib.Settings.LoadBalancingMode == QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED &&
+             Config->ServerIdLength > QUIC_CID_LB_ENCRYPTED_SID_LENGTH)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (MsQuicLib.InUse) {
+            QuicTraceLogError(
+                LibraryLoadBalancingConfigSetAfterInUse,
+                "[ lib] Tried to change load balancing config after library in use!");
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        CXPLAT_BLOCK_KEY* NewKey;
+        Status = CxPlatBlockKeyCreate(Config->Key, &NewKey);
+        if (QUIC_FAILED(Status)) {
+            break;
+        }
+
+        if (MsQuicLib.CidKey != NULL) {
+            CxPlatBlockKeyFree(MsQuicLib.CidKey);
+        }
+        MsQuicLib.CidKey = NewKey;
+        MsQuicLib.LoadBalancingConfig = *Config;
+        QuicTraceLogInfo(
+            LibraryLoadBalancingConfigSet,
+            "[ lib] Updated load balancing config, ID = %hhu, server ID length = %hhu",
+            Config->ConfigId,
+            Config->ServerIdLength);
+
+        QuicLibApplyLoadBalancingSetting();
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_SETTINGS:
 
         if (Buffer == NULL) {
@@ -1021,6 +1176,31 @@ QuicLibraryGetGlobalParam(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG:
+
+        if (*BufferLength < sizeof(QUIC_LOAD_BALANCING_CONFIG)) {
+            *BufferLength = sizeof(QUIC_LOAD_BALANCING_CONFIG);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The key is never handed back out.
+        //
+        *BufferLength = sizeof(QUIC_LOAD_BALANCING_CONFIG);
+        CxPlatCopyMemory(Buffer, &MsQuicLib.LoadBalancingConfig, sizeof(QUIC_LOAD_BALANCING_CONFIG));
+        CxPlatZeroMemory(
+            ((QUIC_LOAD_BALANCING_CONFIG*)Buffer)->Key,
+            sizeof(((QUIC_LOAD_BALANCING_CONFIG*)Buffer)->Key));
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     case QUIC_PARAM_GLOBAL_PERF_COUNTERS: {
 
         if (*BufferLength < sizeof(int64_t)) {
@@ -1458,6 +1638,8 @@ MsQuicOpenVersion(
     Api->StreamSend = MsQuicStreamSend;
     Api->StreamReceiveComplete = MsQuicStreamReceiveComplete;
     Api->StreamReceiveSetEnabled = MsQuicStreamReceiveSetEnabled;
+    Api->StreamProvideReceiveBuffers = MsQuicStreamProvideReceiveBuffers;
+    Api->DatagramSendBatch = MsQuicDatagramSendBatch;
 
     Api->DatagramSend = MsQuicDatagramSend;
 
@@ -2055,6 +2237,36 @@ QuicLibraryOnHandshakeConnectionRemoved(
     QuicLibraryEvaluateSendRetryState();
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLibraryTryAddRecvWindowMemory(
+    _In_ uint64_t Bytes
+    )
+{
+    const uint64_t NewUsage =
+        (uint64_t)InterlockedExchangeAdd64(
+            (int64_t*)&MsQuicLib.CurrentRecvWindowMemoryUsage,
+            (int64_t)Bytes) + Bytes;
+    if (NewUsage > MsQuicLib.RecvWindowMemoryLimit) {
+        InterlockedExchangeAdd64(
+            (int64_t*)&MsQuicLib.CurrentRecvWindowMemoryUsage,
+            -1 * (int64_t)Bytes);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryRemoveRecvWindowMemory(
+    _In_ uint64_t Bytes
+    )
+{
+    InterlockedExchangeAdd64(
+        (int64_t*)&MsQuicLib.CurrentRecvWindowMemoryUsage,
+        -1 * (int64_t)Bytes);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicLibraryEvaluateSendRetryState(
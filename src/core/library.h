@@ -111,6 +111,13 @@ typedef struct QUIC_LIBRARY {
     //
     BOOLEAN CurrentStatelessRetryKey;
 
+    //
+    // Indicates if locally generated CIDs use the QUIC-LB format, and if so,
+    // whether the server ID and nonce are encrypted with CidKey.
+    //
+    BOOLEAN CidQuicLb;
+    BOOLEAN CidEncrypted;
+
     //
     // Current binary version.
     //
@@ -200,6 +207,13 @@ typedef struct QUIC_LIBRARY {
     //
     uint64_t CurrentHandshakeMemoryUsage;
 
+    //
+    // The maximum total memory receive window auto-tuning may commit, beyond
+    // the connections' initial flow control windows, and the current total.
+    //
+    uint64_t RecvWindowMemoryLimit;
+    uint64_t CurrentRecvWindowMemoryUsage;
+
     //
     // Handle to global persistent storage (registry).
     //
@@ -246,6 +260,21 @@ typedef struct QUIC_LIBRARY {
     //
     int64_t StatelessRetryKeysExpiration[2];
 
+    //
+    // Configuration for the QUIC_LOAD_BALANCING_QUIC_LB_* modes.
+    //
+    QUIC_LOAD_BALANCING_CONFIG LoadBalancingConfig;
+
+    //
+    // Controls access to the CID key, which can't be used concurrently.
+    //
+    CXPLAT_DISPATCH_LOCK CidKeyLock;
+
+    //
+    // Key used for QUIC-LB single pass encryption of locally generated CIDs.
+    //
+    CXPLAT_BLOCK_KEY* CidKey;
+
     //
     // The Toeplitz hash used for hashing received long header packets.
     //
@@ -401,6 +430,27 @@ QuicPerfCounterTrySnapShot(
     QuicPerfCounterSnapShot(TimeDiff);
 }
 
+//
+// Writes the server ID portion of a QUIC-LB connection ID: the first octet,
+// the configured server ID and, when encrypted, random padding.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryGenerateLbServerId(
+    _Out_writes_(MsQuicLib.CidServerIdLength)
+        uint8_t* ServerID
+    );
+
+//
+// Encrypts a locally generated QUIC-LB connection ID in place.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicLibraryEncryptCid(
+    _Inout_updates_(MsQuicLib.CidTotalLength)
+        uint8_t* Cid
+    );
+
 //
 // Creates a random, new source connection ID, that will be used on the receive
 // path.
@@ -452,6 +502,12 @@ QuicCidNewRandomSource(
         }
 
         CxPlatRandom(QUIC_CID_PAYLOAD_LENGTH - PrefixLength, Data);
+
+        if (ServerID != NULL && MsQuicLib.CidEncrypted &&
+            QUIC_FAILED(QuicLibraryEncryptCid(Entry->CID.Data))) {
+            CXPLAT_FREE(Entry, QUIC_POOL_CIDHASH);
+            Entry = NULL;
+        }
     }
 
     return Entry;
@@ -583,6 +639,25 @@ QuicLibraryOnHandshakeConnectionRemoved(
     void
     );
 
+//
+// Reserves memory for growing a connection's flow control window. Returns
+// FALSE if it would exceed the receive window memory budget.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicLibraryTryAddRecvWindowMemory(
+    _In_ uint64_t Bytes
+    );
+
+//
+// Releases memory reserved with QuicLibraryTryAddRecvWindowMemory.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLibraryRemoveRecvWindowMemory(
+    _In_ uint64_t Bytes
+    );
+
 //
 // Generates a stateless reset token for the given connection ID.
 //
@@ -243,6 +243,14 @@ MsQuicListenerStart(
         goto Exit;
     }
 
+    if (Listener->CibirId[0] != 0 && MsQuicLib.CidEncrypted) {
+        //
+        // The load balancing mode may have changed since the CIBIR ID was set.
+        //
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        goto Exit;
+    }
+
     AlpnList = CXPLAT_ALLOC_NONPAGED(AlpnListLength, QUIC_POOL_ALPN);
     if (AlpnList == NULL) {
         QuicTraceEvent(
@@ -297,6 +305,19 @@ MsQuicListenerStart(
     UdpConfig.RemoteAddress = NULL;
     UdpConfig.Flags = CXPLAT_SOCKET_FLAG_SHARE | CXPLAT_SOCKET_SERVER_OWNED; // Listeners always share the binding.
     UdpConfig.InterfaceIndex = 0;
+    //
+    // Steering received packets by the partition in their CID is opt-in.
+    // Encrypted QUIC-LB CIDs hide the partition ID, so they can't be steered,
+    // and split partitioning moves connections off the partition encoded in
+    // their CIDs, so steering to it would only add a cross-processor hop.
+    //
+    UdpConfig.PartitionCount =
+        MsQuicLib.Settings.CidSteeringEnabled &&
+        !MsQuicLib.CidEncrypted &&
+        !Listener->Registration->SplitPartitioning ?
+            MsQuicLib.PartitionCount : 0;
+    UdpConfig.PartitionMask = MsQuicLib.PartitionMask;
+    UdpConfig.PartitionIdOffset = MsQuicLib.CidServerIdLength;
 #ifdef QUIC_COMPARTMENT_ID
     UdpConfig.CompartmentId = QuicCompartmentIdGetCurrent();
 #endif
@@ -732,6 +753,14 @@ QuicListenerParamSet(
             return QUIC_STATUS_NOT_SUPPORTED; // Not yet supproted.
         }
 
+        if (MsQuicLib.CidEncrypted) {
+            //
+            // The CIBIR ID follows the server ID in the CID, and encrypted
+            // QUIC-LB CIDs hide it.
+            //
+            return QUIC_STATUS_NOT_SUPPORTED;
+        }
+
         Listener->CibirId[0] = (uint8_t)BufferLength - 1;
         memcpy(Listener->CibirId + 1, Buffer, BufferLength);
 
@@ -14,13 +14,75 @@ Abstract:
 #include "lookup.c.clog.h"
 #endif
 
+//
+// An open addressing table of local CIDs, which lock-free readers probe while
+// writers (serialized by the lookup's RwLock) modify it. A slot's entry only
+// changes from NULL to a CID and from a CID to the tombstone, which may later
+// be reused for another CID. Entries are never moved; the whole slot array is
+// replaced instead when too many of its slots have been used.
+//
+typedef struct QUIC_CID_SLOT {
+
+    uint32_t Hash;
+    QUIC_CID_HASH_ENTRY* Entry;
+
+} QUIC_CID_SLOT;
+
+typedef struct QUIC_CID_TABLE {
+
+    //
+    // The number of slots, minus one. The number of slots is a power of two.
+    //
+    uint32_t Mask;
+
+    //
+    // The number of slots that are no longer NULL, including tombstones.
+    //
+    uint32_t Used;
+
+    QUIC_CID_SLOT Slots[0];
+
+} QUIC_CID_TABLE;
+
+#define QUIC_CID_TABLE_MIN_SIZE     16
+
+//
+// Marks the slot of a removed CID, so that probes continue past it.
+//
+#define QUIC_CID_SLOT_TOMBSTONE     ((QUIC_CID_HASH_ENTRY*)(size_t)1)
+
 typedef struct QUIC_CACHEALIGN QUIC_PARTITIONED_HASHTABLE {
 
-    CXPLAT_DISPATCH_RW_LOCK RwLock;
-    CXPLAT_HASHTABLE Table;
+    QUIC_CID_TABLE* Table;
+
+    //
+    // The number of CIDs in the table.
+    //
+    uint32_t NumEntries;
+
+    //
+    // The number of partitions in the array this table belongs to, so that
+    // lock-free readers don't depend on Lookup->PartitionCount to index it.
+    //
+    uint16_t PartitionCount;
 
 } QUIC_PARTITIONED_HASHTABLE;
 
+//
+// Counts of the lock-free readers that ran on one processor, for each reader
+// phase. A phase has no readers left once its exited count catches up with
+// its entered count.
+//
+typedef union QUIC_CACHEALIGN QUIC_LOOKUP_READERS {
+
+    struct {
+        volatile int64_t Entered[2];
+        volatile int64_t Exited[2];
+    };
+    uint8_t Padding[64]; // Keep each processor's counts on their own cache line.
+
+} QUIC_LOOKUP_READERS;
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicLookupInsertLocalCid(
@@ -40,6 +102,22 @@ QuicLookupInitialize(
     CxPlatDispatchRwLockInitialize(&Lookup->RwLock);
 }
 
+//
+// Frees an array of partitioned hash tables.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupFreeHashTable(
+    _In_ QUIC_PARTITIONED_HASHTABLE* Tables,
+    _In_ uint16_t PartitionCount
+    )
+{
+    for (uint16_t i = 0; i < PartitionCount; i++) {
+        CXPLAT_FREE(Tables[i].Table, QUIC_POOL_LOOKUP_HASHTABLE);
+    }
+    CXPLAT_FREE(Tables, QUIC_POOL_LOOKUP_HASHTABLE);
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicLookupUninitialize(
@@ -52,16 +130,16 @@ QuicLookupUninitialize(
         CXPLAT_DBG_ASSERT(Lookup->SINGLE.Connection == NULL);
     } else {
         CXPLAT_DBG_ASSERT(Lookup->HASH.Tables != NULL);
+#if DEBUG
         for (uint16_t i = 0; i < Lookup->PartitionCount; i++) {
-            QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[i];
-            CXPLAT_DBG_ASSERT(Table->Table.NumEntries == 0);
-#pragma warning(push)
-#pragma warning(disable:6001)
-            CxPlatHashtableUninitialize(&Table->Table);
-#pragma warning(pop)
-            CxPlatDispatchRwLockUninitialize(&Table->RwLock);
+            CXPLAT_DBG_ASSERT(Lookup->HASH.Tables[i].NumEntries == 0);
         }
-        CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
+#endif
+        QuicLookupFreeHashTable(Lookup->HASH.Tables, Lookup->PartitionCount);
+    }
+
+    if (Lookup->Readers != NULL) {
+        CXPLAT_FREE(Lookup->Readers, QUIC_POOL_LOOKUP_HASHTABLE);
     }
 
     if (Lookup->MaximizePartitioning) {
@@ -73,47 +151,248 @@ QuicLookupUninitialize(
 }
 
 //
-// Allocates and initializes a new partitioned hash table.
+// Waits until no lock-free reader remains in the given phase.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupWaitForReaderPhase(
+    _In_ const QUIC_LOOKUP* Lookup,
+    _In_ uint8_t Phase
+    )
+{
+    const uint32_t ReaderCount = CxPlatProcMaxCount();
+    while (TRUE) {
+        //
+        // Sum the exited counts first. A reader counted as exited was also
+        // counted as entered, so the sums are only equal if every reader that
+        // entered before the second sum has exited.
+        //
+        int64_t Exited = 0;
+        for (uint32_t i = 0; i < ReaderCount; ++i) {
+            Exited += Lookup->Readers[i].Exited[Phase];
+        }
+        MemoryBarrier();
+        int64_t Entered = 0;
+        for (uint32_t i = 0; i < ReaderCount; ++i) {
+            Entered += Lookup->Readers[i].Entered[Phase];
+        }
+        if (Entered == Exited) {
+            break;
+        }
+        YieldProcessor();
+    }
+}
+
+//
+// Waits for a grace period: until every lock-free reader that might still be
+// using something removed from the lookup before the call is done with it.
+// Requires the Lookup->RwLock to be exclusively held.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLookupWaitForReaders(
+    _In_ QUIC_LOOKUP* Lookup
+    )
+{
+    if (Lookup->Readers == NULL) {
+        return; // All readers take the RwLock.
+    }
+
+    //
+    // A reader that read the phase before the previous flip may have counted
+    // itself against the current inactive phase after that flip's wait, so
+    // wait for those readers too, before flipping and waiting for the readers
+    // of the current phase.
+    //
+    const uint8_t Phase = Lookup->ReaderPhase;
+    MemoryBarrier();
+    QuicLookupWaitForReaderPhase(Lookup, Phase ^ 1);
+    MemoryBarrier();
+    Lookup->ReaderPhase = Phase ^ 1;
+    MemoryBarrier();
+    QuicLookupWaitForReaderPhase(Lookup, Phase);
+    MemoryBarrier();
+}
+
+//
+// Allocates an empty CID table with room for at least Count CIDs.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_CID_TABLE*
+QuicCidTableAlloc(
+    _In_ uint32_t Count
+    )
+{
+    uint32_t SlotCount = QUIC_CID_TABLE_MIN_SIZE;
+    while (SlotCount < 2 * Count) {
+        SlotCount <<= 1;
+    }
+
+    QUIC_CID_TABLE* Table =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_CID_TABLE) + SlotCount * sizeof(QUIC_CID_SLOT),
+            QUIC_POOL_LOOKUP_HASHTABLE);
+    if (Table != NULL) {
+        CxPlatZeroMemory(
+            Table, sizeof(QUIC_CID_TABLE) + SlotCount * sizeof(QUIC_CID_SLOT));
+        Table->Mask = SlotCount - 1;
+    }
+    return Table;
+}
+
+//
+// Adds a CID to the first empty or tombstone slot of its probe sequence. The
+// hash is written before the entry is published, so a reader that sees the
+// entry also sees its hash. Only tombstones whose removal has already waited
+// for a grace period may be reused, so no reader still holds their old entry.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicCidTableAdd(
+    _In_ QUIC_CID_TABLE* Table,
+    _In_ uint32_t Hash,
+    _In_ QUIC_CID_HASH_ENTRY* SourceCid
+    )
+{
+    uint32_t i = Hash & Table->Mask;
+    while (Table->Slots[i].Entry != NULL &&
+           Table->Slots[i].Entry != QUIC_CID_SLOT_TOMBSTONE) {
+        i = (i + 1) & Table->Mask;
+    }
+    if (Table->Slots[i].Entry == NULL) {
+        Table->Used++;
+    }
+    Table->Slots[i].Hash = Hash;
+    QuicWritePtrRelease(&Table->Slots[i].Entry, SourceCid);
+}
+
+//
+// Inserts a CID into a partition, first replacing its slot array if it is
+// getting full. If Lookup is NULL, the partition isn't visible to readers yet
+// and the old slot array is freed right away.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
+QuicPartitionedHashTableInsert(
+    _In_opt_ QUIC_LOOKUP* Lookup,
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table,
+    _In_ uint32_t Hash,
+    _In_ QUIC_CID_HASH_ENTRY* SourceCid
+    )
+{
+    QUIC_CID_TABLE* CidTable = Table->Table;
+    if (CidTable->Used + 1 > (CidTable->Mask + 1) / 4 * 3) {
+        QUIC_CID_TABLE* NewCidTable = QuicCidTableAlloc(Table->NumEntries + 1);
+        if (NewCidTable == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "CID table",
+                sizeof(QUIC_CID_TABLE) + 2 * (Table->NumEntries + 1) * sizeof(QUIC_CID_SLOT));
+            return FALSE;
+        }
+        for (uint32_t i = 0; i <= CidTable->Mask; ++i) {
+            if (CidTable->Slots[i].Entry != NULL &&
+                CidTable->Slots[i].Entry != QUIC_CID_SLOT_TOMBSTONE) {
+                QuicCidTableAdd(
+                    NewCidTable,
+                    CidTable->Slots[i].Hash,
+                    CidTable->Slots[i].Entry);
+            }
+        }
+        QuicWritePtrRelease(&Table->Table, NewCidTable);
+        if (Lookup != NULL) {
+            QuicLookupWaitForReaders(Lookup);
+        }
+        CXPLAT_FREE(CidTable, QUIC_POOL_LOOKUP_HASHTABLE);
+        CidTable = NewCidTable;
+    }
+
+    QuicCidTableAdd(CidTable, Hash, SourceCid);
+    Table->NumEntries++;
+    return TRUE;
+}
+
+//
+// Replaces the CID's slot with a tombstone. The entry may still be in use by
+// lock-free readers until the caller waits for a grace period.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicPartitionedHashTableRemove(
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table,
+    _In_ QUIC_CID_HASH_ENTRY* SourceCid
+    )
+{
+    QUIC_CID_TABLE* CidTable = Table->Table;
+    uint32_t i = CxPlatHashSimple(SourceCid->CID.Length, SourceCid->CID.Data) & CidTable->Mask;
+    while (CidTable->Slots[i].Entry != SourceCid) {
+        CXPLAT_DBG_ASSERT(CidTable->Slots[i].Entry != NULL);
+        i = (i + 1) & CidTable->Mask;
+    }
+    QuicWritePtrRelease(&CidTable->Slots[i].Entry, QUIC_CID_SLOT_TOMBSTONE);
+    Table->NumEntries--;
+}
+
+//
+// Allocates and initializes a new array of partitioned hash tables, each with
+// room for Count CIDs.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_PARTITIONED_HASHTABLE*
 QuicLookupCreateHashTable(
-    _In_ QUIC_LOOKUP* Lookup,
-    _In_range_(>, 0) uint16_t PartitionCount
+    _In_range_(>, 0) uint16_t PartitionCount,
+    _In_ uint32_t Count
     )
 {
-    CXPLAT_DBG_ASSERT(Lookup->LookupTable == NULL);
     CXPLAT_FRE_ASSERT(PartitionCount > 0);
 
-    Lookup->HASH.Tables =
+    QUIC_PARTITIONED_HASHTABLE* Tables =
         CXPLAT_ALLOC_NONPAGED(
             sizeof(QUIC_PARTITIONED_HASHTABLE) * PartitionCount,
             QUIC_POOL_LOOKUP_HASHTABLE);
 
-    if (Lookup->HASH.Tables != NULL) {
-
-        uint16_t Cleanup = 0;
-        uint8_t Failed = FALSE;
+    if (Tables != NULL) {
+        CxPlatZeroMemory(Tables, sizeof(QUIC_PARTITIONED_HASHTABLE) * PartitionCount);
         for (uint16_t i = 0; i < PartitionCount; i++) {
-            if (!CxPlatHashtableInitializeEx(&Lookup->HASH.Tables[i].Table, CXPLAT_HASH_MIN_SIZE)) {
-                Cleanup = i;
-                Failed = TRUE;
+            Tables[i].PartitionCount = PartitionCount;
+            Tables[i].Table = QuicCidTableAlloc(Count);
+            if (Tables[i].Table == NULL) {
+                QuicLookupFreeHashTable(Tables, i);
+                Tables = NULL;
                 break;
             }
-            CxPlatDispatchRwLockInitialize(&Lookup->HASH.Tables[i].RwLock);
-        }
-        if (Failed) {
-            for (uint16_t i = 0; i < Cleanup; i++) {
-                CxPlatHashtableUninitialize(&Lookup->HASH.Tables[i].Table);
-            }
-            CXPLAT_FREE(Lookup->HASH.Tables, QUIC_POOL_LOOKUP_HASHTABLE);
-            Lookup->HASH.Tables = NULL;
-        } else {
-            Lookup->PartitionCount = PartitionCount;
         }
     }
 
-    return Lookup->HASH.Tables != NULL;
+    return Tables;
+}
+
+//
+// Returns the partition of the given tables that the CID belongs in.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_PARTITIONED_HASHTABLE*
+QuicLookupGetPartition(
+    _In_ QUIC_PARTITIONED_HASHTABLE* Tables,
+    _In_reads_(CIDLen)
+        const uint8_t* const CID,
+    _In_ uint8_t CIDLen
+    )
+{
+    CXPLAT_DBG_ASSERT(CIDLen >= MsQuicLib.CidServerIdLength + QUIC_CID_PID_LENGTH);
+    UNREFERENCED_PARAMETER(CIDLen);
+
+    //
+    // Use the connection ID to get the index into the partitioned hash table
+    // array.
+    //
+    CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
+    uint16_t PartitionIndex;
+    CxPlatCopyMemory(&PartitionIndex, CID + MsQuicLib.CidServerIdLength, 2);
+    PartitionIndex &= MsQuicLib.PartitionMask;
+    PartitionIndex %= Tables->PartitionCount;
+    return &Tables[PartitionIndex];
 }
 
 //
@@ -154,24 +433,38 @@ QuicLookupRebalance(
 
         uint16_t PreviousPartitionCount = Lookup->PartitionCount;
         void* PreviousLookup = Lookup->LookupTable;
-        Lookup->LookupTable = NULL;
+        QUIC_LOOKUP_READERS* Readers = NULL;
+        QUIC_PARTITIONED_HASHTABLE* Tables = NULL;
 
         CXPLAT_DBG_ASSERT(PartitionCount != 0);
 
-        if (!QuicLookupCreateHashTable(Lookup, PartitionCount)) {
-            Lookup->LookupTable = PreviousLookup;
-            return FALSE;
+        if (Lookup->Readers == NULL) {
+            CXPLAT_DBG_ASSERT(PreviousPartitionCount == 0);
+            Readers =
+                CXPLAT_ALLOC_NONPAGED(
+                    sizeof(QUIC_LOOKUP_READERS) * CxPlatProcMaxCount(),
+                    QUIC_POOL_LOOKUP_HASHTABLE);
+            if (Readers == NULL) {
+                return FALSE;
+            }
+            CxPlatZeroMemory(Readers, sizeof(QUIC_LOOKUP_READERS) * CxPlatProcMaxCount());
+        }
+
+        Tables = QuicLookupCreateHashTable(PartitionCount, Lookup->CidCount);
+        if (Tables == NULL) {
+            goto Error;
         }
 
         //
-        // Move the CIDs to the new table.
+        // Copy the CIDs to the new tables. Lock-free readers keep using the
+        // previous tables until the new ones are published below.
         //
 
         if (PreviousPartitionCount == 0) {
 
             //
             // Only a single connection before. Enumerate all CIDs on the
-            // connection and reinsert them into the new table(s).
+            // connection and insert them into the new table(s).
             //
 
             if (PreviousLookup != NULL) {
@@ -184,56 +477,77 @@ QuicLookupRebalance(
                             Entry,
                             QUIC_CID_HASH_ENTRY,
                             Link);
-                    (void)QuicLookupInsertLocalCid(
-                        Lookup,
-                        CxPlatHashSimple(CID->CID.Length, CID->CID.Data),
-                        CID,
-                        FALSE);
+                    if (!QuicPartitionedHashTableInsert(
+                            NULL,
+                            QuicLookupGetPartition(Tables, CID->CID.Data, CID->CID.Length),
+                            CxPlatHashSimple(CID->CID.Length, CID->CID.Data),
+                            CID)) {
+                        goto Error;
+                    }
                     Entry = Entry->Next;
                 }
+
+                for (Entry = ((QUIC_CONNECTION*)PreviousLookup)->SourceCids.Next;
+                     Entry != NULL;
+                     Entry = Entry->Next) {
+                    CXPLAT_CONTAINING_RECORD(
+                        Entry,
+                        QUIC_CID_HASH_ENTRY,
+                        Link)->CID.IsInLookupTable = TRUE;
+                }
             }
 
         } else {
 
             //
-            // Changes the number of partitioned tables. Remove all the CIDs
-            // from the old tables and insert them into the new tables.
+            // Changes the number of partitioned tables. Copy all the CIDs from
+            // the old tables into the new tables.
             //
 
-            QUIC_PARTITIONED_HASHTABLE* PreviousTable = PreviousLookup;
+            QUIC_PARTITIONED_HASHTABLE* PreviousTables = PreviousLookup;
             for (uint16_t i = 0; i < PreviousPartitionCount; i++) {
-                CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-#pragma warning(push)
-#pragma warning(disable:6001)
-                CxPlatHashtableEnumerateBegin(&PreviousTable[i].Table, &Enumerator);
-#pragma warning(pop)
-                while (TRUE) {
-                    CXPLAT_HASHTABLE_ENTRY* Entry =
-                        CxPlatHashtableEnumerateNext(&PreviousTable[i].Table, &Enumerator);
-                    if (Entry == NULL) {
-                        CxPlatHashtableEnumerateEnd(&PreviousTable[i].Table, &Enumerator);
-                        break;
+                const QUIC_CID_TABLE* CidTable = PreviousTables[i].Table;
+                for (uint32_t j = 0; j <= CidTable->Mask; ++j) {
+                    QUIC_CID_HASH_ENTRY* CID = CidTable->Slots[j].Entry;
+                    if (CID == NULL || CID == QUIC_CID_SLOT_TOMBSTONE) {
+                        continue;
+                    }
+                    if (!QuicPartitionedHashTableInsert(
+                            NULL,
+                            QuicLookupGetPartition(Tables, CID->CID.Data, CID->CID.Length),
+                            CidTable->Slots[j].Hash,
+                            CID)) {
+                        goto Error;
                     }
-                    CxPlatHashtableRemove(&PreviousTable[i].Table, Entry, NULL);
-
-                    QUIC_CID_HASH_ENTRY *CID =
-                        CXPLAT_CONTAINING_RECORD(
-                            Entry,
-                            QUIC_CID_HASH_ENTRY,
-                            Entry);
-                    (void)QuicLookupInsertLocalCid(
-                        Lookup,
-                        CxPlatHashSimple(CID->CID.Length, CID->CID.Data),
-                        CID,
-                        FALSE);
                 }
-#pragma warning(push)
-#pragma warning(disable:6001)
-                CxPlatHashtableUninitialize(&PreviousTable[i].Table);
-#pragma warning(pop)
             }
-            CXPLAT_FREE(PreviousTable, QUIC_POOL_LOOKUP_HASHTABLE);
         }
+
+        QuicWritePtrRelease(&Lookup->LookupTable, Tables);
+        Lookup->PartitionCount = PartitionCount;
+
+        if (Readers != NULL) {
+            //
+            // Publishing the readers switches local CID lookups from the RwLock
+            // to the lock-free path.
+            //
+            QuicWritePtrRelease(&Lookup->Readers, Readers);
+        } else {
+            QuicLookupWaitForReaders(Lookup);
+            QuicLookupFreeHashTable(PreviousLookup, PreviousPartitionCount);
+        }
+
+        return TRUE;
+
+Error:
+
+        if (Tables != NULL) {
+            QuicLookupFreeHashTable(Tables, PartitionCount);
+        }
+        if (Readers != NULL) {
+            CXPLAT_FREE(Readers, QUIC_POOL_LOOKUP_HASHTABLE);
+        }
+        return FALSE;
     }
 
     return TRUE;
@@ -301,31 +615,37 @@ QuicCidMatchConnection(
 //
 // Uses the hash and destination connection ID to look up the connection in the
 // hash table. Returns the pointer to the connection if found; NULL otherwise.
+// Safe to call without the lock, from a lock-free reader.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_CONNECTION*
 QuicHashLookupConnection(
-    _In_ CXPLAT_HASHTABLE* Table,
+    _In_ QUIC_PARTITIONED_HASHTABLE* Table,
     _In_reads_(Length)
         const uint8_t* const DestCid,
     _In_ uint8_t Length,
     _In_ uint32_t Hash
     )
 {
-    CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
-    CXPLAT_HASHTABLE_ENTRY* TableEntry =
-        CxPlatHashtableLookup(Table, Hash, &Context);
+    const QUIC_CID_TABLE* CidTable = QuicReadPtrAcquire(&Table->Table);
 
-    while (TableEntry != NULL) {
-        QUIC_CID_HASH_ENTRY* CIDEntry =
-            CXPLAT_CONTAINING_RECORD(TableEntry, QUIC_CID_HASH_ENTRY, Entry);
+    //
+    // At most three quarters of the slots are ever used, so the probe always
+    // ends at an empty slot.
+    //
+    for (uint32_t i = Hash & CidTable->Mask; ; i = (i + 1) & CidTable->Mask) {
+        const QUIC_CID_HASH_ENTRY* CIDEntry =
+            QuicReadPtrAcquire(&CidTable->Slots[i].Entry);
+        if (CIDEntry == NULL) {
+            break;
+        }
 
-        if (CIDEntry->CID.Length == Length &&
+        if (CIDEntry != QUIC_CID_SLOT_TOMBSTONE &&
+            CidTable->Slots[i].Hash == Hash &&
+            CIDEntry->CID.Length == Length &&
             memcmp(DestCid, CIDEntry->CID.Data, Length) == 0) {
             return CIDEntry->Connection;
         }
-
-        TableEntry = CxPlatHashtableLookupNext(Table, &Context);
     }
 
     return NULL;
@@ -358,25 +678,17 @@ QuicLookupFindConnectionByLocalCidInternal(
         CXPLAT_DBG_ASSERT(CID != NULL);
 
         //
-        // Use the destination connection ID to get the index into the
-        // partitioned hash table array, and look up the connection in that
-        // hash table.
+        // Look up the connection in the destination connection ID's partition.
+        // The tables may be replaced by a concurrent rebalance, so lock-free
+        // readers must only index them with their own partition count.
         //
-        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
-        uint16_t PartitionIndex;
-        CxPlatCopyMemory(&PartitionIndex, CID + MsQuicLib.CidServerIdLength, 2);
-        PartitionIndex &= MsQuicLib.PartitionMask;
-        PartitionIndex %= Lookup->PartitionCount;
-        QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
-
-        CxPlatDispatchRwLockAcquireShared(&Table->RwLock);
+        QUIC_PARTITIONED_HASHTABLE* Tables = QuicReadPtrAcquire(&Lookup->HASH.Tables);
         Connection =
             QuicHashLookupConnection(
-                &Table->Table,
+                QuicLookupGetPartition(Tables, CID, CIDLen),
                 CID,
                 CIDLen,
                 Hash);
-        CxPlatDispatchRwLockReleaseShared(&Table->RwLock);
     }
 
 #if QUIC_DEBUG_HASHTABLE_LOOKUP
@@ -475,25 +787,19 @@ QuicLookupInsertLocalCid(
         }
 
     } else {
-        CXPLAT_DBG_ASSERT(SourceCid->CID.Length >= MsQuicLib.CidServerIdLength + QUIC_CID_PID_LENGTH);
-
         //
         // Insert the source connection ID into the hash table.
         //
-        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
-        uint16_t PartitionIndex;
-        CxPlatCopyMemory(&PartitionIndex, SourceCid->CID.Data + MsQuicLib.CidServerIdLength, 2);
-        PartitionIndex &= MsQuicLib.PartitionMask;
-        PartitionIndex %= Lookup->PartitionCount;
-        QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
-
-        CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock);
-        CxPlatHashtableInsert(
-            &Table->Table,
-            &SourceCid->Entry,
-            Hash,
-            NULL);
-        CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock);
+        if (!QuicPartitionedHashTableInsert(
+                Lookup,
+                QuicLookupGetPartition(
+                    Lookup->HASH.Tables,
+                    SourceCid->CID.Data,
+                    SourceCid->CID.Length),
+                Hash,
+                SourceCid)) {
+            return FALSE;
+        }
     }
 
     if (UpdateRefCount) {
@@ -575,7 +881,8 @@ QuicLookupInsertRemoteHash(
 
 //
 // Removes a source connection ID from the lookup table. Requires the
-// Lookup->RwLock to be exlusively held.
+// Lookup->RwLock to be exlusively held. The caller must wait for lock-free
+// readers before freeing the CID or releasing the connection.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
@@ -606,20 +913,15 @@ QuicLookupRemoveLocalCidInt(
             Lookup->SINGLE.Connection = NULL;
         }
     } else {
-        CXPLAT_DBG_ASSERT(SourceCid->CID.Length >= MsQuicLib.CidServerIdLength + QUIC_CID_PID_LENGTH);
-
         //
         // Remove the source connection ID from the multi-hash table.
         //
-        CXPLAT_STATIC_ASSERT(QUIC_CID_PID_LENGTH == 2, "The code below assumes 2 bytes");
-        uint16_t PartitionIndex;
-        CxPlatCopyMemory(&PartitionIndex, SourceCid->CID.Data + MsQuicLib.CidServerIdLength, 2);
-        PartitionIndex &= MsQuicLib.PartitionMask;
-        PartitionIndex %= Lookup->PartitionCount;
-        QUIC_PARTITIONED_HASHTABLE* Table = &Lookup->HASH.Tables[PartitionIndex];
-        CxPlatDispatchRwLockAcquireExclusive(&Table->RwLock);
-        CxPlatHashtableRemove(&Table->Table, &SourceCid->Entry, NULL);
-        CxPlatDispatchRwLockReleaseExclusive(&Table->RwLock);
+        QuicPartitionedHashTableRemove(
+            QuicLookupGetPartition(
+                Lookup->HASH.Tables,
+                SourceCid->CID.Data,
+                SourceCid->CID.Length),
+            SourceCid);
     }
 }
 
@@ -633,21 +935,49 @@ QuicLookupFindConnectionByLocalCid(
     )
 {
     uint32_t Hash = CxPlatHashSimple(CIDLen, CID);
+    QUIC_CONNECTION* ExistingConnection;
 
-    CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock);
+    QUIC_LOOKUP_READERS* Readers = QuicReadPtrAcquire(&Lookup->Readers);
+    if (Readers != NULL) {
+        //
+        // The lookup is partitioned, so the lookup doesn't need the RwLock.
+        // Instead, the reader counts itself against the current phase, so
+        // that writers wait for it before freeing anything it might use,
+        // including the lookup table's reference on the connection.
+        //
+        QUIC_LOOKUP_READERS* Reader = &Readers[CxPlatProcCurrentNumber()];
+        const uint8_t Phase = Lookup->ReaderPhase;
+        InterlockedIncrement64(&Reader->Entered[Phase]);
 
-    QUIC_CONNECTION* ExistingConnection =
-        QuicLookupFindConnectionByLocalCidInternal(
-            Lookup,
-            CID,
-            CIDLen,
-            Hash);
+        ExistingConnection =
+            QuicLookupFindConnectionByLocalCidInternal(
+                Lookup,
+                CID,
+                CIDLen,
+                Hash);
 
-    if (ExistingConnection != NULL) {
-        QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
-    }
+        if (ExistingConnection != NULL) {
+            QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
 
-    CxPlatDispatchRwLockReleaseShared(&Lookup->RwLock);
+        InterlockedIncrement64(&Reader->Exited[Phase]);
+
+    } else {
+        CxPlatDispatchRwLockAcquireShared(&Lookup->RwLock);
+
+        ExistingConnection =
+            QuicLookupFindConnectionByLocalCidInternal(
+                Lookup,
+                CID,
+                CIDLen,
+                Hash);
+
+        if (ExistingConnection != NULL) {
+            QuicConnAddRef(ExistingConnection, QUIC_CONN_REF_LOOKUP_RESULT);
+        }
+
+        CxPlatDispatchRwLockReleaseShared(&Lookup->RwLock);
+    }
 
     return ExistingConnection;
 }
@@ -830,6 +1160,7 @@ QuicLookupRemoveLocalCid(
     QuicLookupRemoveLocalCidInt(Lookup, SourceCid);
     SourceCid->CID.IsInLookupTable = FALSE;
     *Entry = (*Entry)->Next;
+    QuicLookupWaitForReaders(Lookup);
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock);
     QuicConnRelease(SourceCid->Connection, QUIC_CONN_REF_LOOKUP_TABLE);
 }
@@ -867,12 +1198,14 @@ QuicLookupRemoveLocalCids(
     )
 {
     uint8_t ReleaseRefCount = 0;
+    CXPLAT_SLIST_ENTRY RemovedCids = { NULL };
 
     CxPlatDispatchRwLockAcquireExclusive(&Lookup->RwLock);
     while (Connection->SourceCids.Next != NULL) {
+        CXPLAT_SLIST_ENTRY* Link = CxPlatListPopEntry(&Connection->SourceCids);
         QUIC_CID_HASH_ENTRY *CID =
             CXPLAT_CONTAINING_RECORD(
-                CxPlatListPopEntry(&Connection->SourceCids),
+                Link,
                 QUIC_CID_HASH_ENTRY,
                 Link);
         if (CID->CID.IsInLookupTable) {
@@ -880,10 +1213,22 @@ QuicLookupRemoveLocalCids(
             CID->CID.IsInLookupTable = FALSE;
             ReleaseRefCount++;
         }
-        CXPLAT_FREE(CID, QUIC_POOL_CIDHASH);
+        CxPlatListPushEntry(&RemovedCids, Link);
+    }
+    if (ReleaseRefCount != 0) {
+        QuicLookupWaitForReaders(Lookup);
     }
     CxPlatDispatchRwLockReleaseExclusive(&Lookup->RwLock);
 
+    while (RemovedCids.Next != NULL) {
+        CXPLAT_FREE(
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListPopEntry(&RemovedCids),
+                QUIC_CID_HASH_ENTRY,
+                Link),
+            QUIC_POOL_CIDHASH);
+    }
+
     for (uint8_t i = 0; i < ReleaseRefCount; i++) {
 #pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
         QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
@@ -899,6 +1244,7 @@ QuicLookupMoveLocalConnectionIDs(
     )
 {
     CXPLAT_SLIST_ENTRY* Entry = Connection->SourceCids.Next;
+    uint8_t ReleaseRefCount = 0;
 
     CxPlatDispatchRwLockAcquireExclusive(&LookupSrc->RwLock);
     while (Entry != NULL) {
@@ -909,12 +1255,19 @@ QuicLookupMoveLocalConnectionIDs(
                 Link);
         if (CID->CID.IsInLookupTable) {
             QuicLookupRemoveLocalCidInt(LookupSrc, CID);
-            QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+            ReleaseRefCount++;
         }
         Entry = Entry->Next;
     }
+    if (ReleaseRefCount != 0) {
+        QuicLookupWaitForReaders(LookupSrc);
+    }
     CxPlatDispatchRwLockReleaseExclusive(&LookupSrc->RwLock);
 
+    for (uint8_t i = 0; i < ReleaseRefCount; i++) {
+        QuicConnRelease(Connection, QUIC_CONN_REF_LOOKUP_TABLE);
+    }
+
     CxPlatDispatchRwLockAcquireExclusive(&LookupDest->RwLock);
 #pragma prefast(suppress:6001, "SAL doesn't understand ref counts")
     Entry = Connection->SourceCids.Next;
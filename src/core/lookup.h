@@ -5,7 +5,12 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_PARTITIONED_HASHTABLE QUIC_PARTITIONED_HASHTABLE;
+typedef union QUIC_LOOKUP_READERS QUIC_LOOKUP_READERS;
 
 typedef struct QUIC_REMOTE_HASH_ENTRY {
 
@@ -34,10 +39,17 @@ typedef struct QUIC_LOOKUP {
     uint32_t CidCount;
 
     //
-    // Lock for accessing the lookup data.
+    // Lock for accessing the lookup data. Once the lookup is partitioned, local
+    // CID lookups no longer take it; they are tracked in Readers instead.
     //
     CXPLAT_DISPATCH_RW_LOCK RwLock;
 
+    //
+    // The phase (0 or 1) new lock-free readers count themselves against.
+    // Flipped by writers waiting for a grace period.
+    //
+    volatile uint8_t ReaderPhase;
+
     //
     // The number of partitions used for lookup tables. Value of 0 (default)
     // indicates only a single connection (may be NULL) is bound.
@@ -64,6 +76,12 @@ typedef struct QUIC_LOOKUP {
         } HASH;
     };
 
+    //
+    // Per processor counts of lock-free readers of the partitioned tables.
+    // NULL until the lookup is first partitioned, which it then stays.
+    //
+    QUIC_LOOKUP_READERS* Readers;
+
     //
     // Remote Hash lookup.
     //
@@ -200,3 +218,7 @@ QuicLookupMoveLocalConnectionIDs(
     _In_ QUIC_LOOKUP* LookupDest,
     _In_ QUIC_CONNECTION* Connection
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -78,6 +78,8 @@ QuicLossDetectionInitializeInternalState(
 {
     LossDetection->PacketsInFlight = 0;
     LossDetection->ProbeCount = 0;
+    LossDetection->RateSample.IsValid = FALSE;
+    LossDetection->AppLimited = FALSE;
 }
 
 #if DEBUG
@@ -88,18 +90,27 @@ QuicLossValidate(
     )
 {
     uint32_t AckElicitingPackets = 0;
-    QUIC_SENT_PACKET_METADATA** Tail = &LossDetection->SentPackets;
-    while (*Tail) {
-        CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
-        if ((*Tail)->Flags.IsAckEliciting) {
+    uint32_t SentPackets = 0;
+    const QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+    for (uint64_t PacketNumber = Ring->BasePacketNumber;
+        PacketNumber < QuicSentPacketRingEnd(Ring);
+        PacketNumber++) {
+        const QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(Ring, PacketNumber);
+        if (Packet == NULL) {
+            continue;
+        }
+        CXPLAT_DBG_ASSERT(!Packet->Flags.Freed);
+        CXPLAT_DBG_ASSERT(Packet->PacketNumber == PacketNumber);
+        SentPackets++;
+        if (Packet->Flags.IsAckEliciting) {
             AckElicitingPackets++;
         }
-        Tail = &((*Tail)->Next);
     }
-    CXPLAT_DBG_ASSERT(Tail == LossDetection->SentPacketsTail);
+    CXPLAT_DBG_ASSERT(Ring->PacketCount == SentPackets);
     CXPLAT_DBG_ASSERT(LossDetection->PacketsInFlight == AckElicitingPackets);
 
-    Tail = &LossDetection->LostPackets;
+    QUIC_SENT_PACKET_METADATA** Tail = &LossDetection->LostPackets;
     while (*Tail) {
         CXPLAT_DBG_ASSERT(!(*Tail)->Flags.Freed);
         Tail = &((*Tail)->Next);
@@ -116,10 +127,12 @@ QuicLossDetectionInitialize(
     _Inout_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    LossDetection->SentPackets = NULL;
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
+    QuicSentPacketRingInitialize(&LossDetection->SentPackets);
     LossDetection->LostPackets = NULL;
     LossDetection->LostPacketsTail = &LossDetection->LostPackets;
+    LossDetection->DeliveredBytes = 0;
+    LossDetection->DeliveredTime = 0;
+    LossDetection->FirstSentTime = 0;
     QuicLossDetectionInitializeInternalState(LossDetection);
 }
 
@@ -131,9 +144,9 @@ QuicLossDetectionUninitialize(
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
+    QUIC_SENT_PACKET_METADATA* Packet;
+    while ((Packet = QuicSentPacketRingFirst(&LossDetection->SentPackets)) != NULL) {
+        QuicSentPacketRingRemove(&LossDetection->SentPackets, Packet->PacketNumber);
 
         if (Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
@@ -146,8 +159,10 @@ QuicLossDetectionUninitialize(
 
         QuicLossDetectionOnPacketDiscarded(LossDetection, Packet, FALSE);
     }
+    QuicSentPacketRingUninitialize(&LossDetection->SentPackets);
+
     while (LossDetection->LostPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
+        Packet = LossDetection->LostPackets;
         LossDetection->LostPackets = LossDetection->LostPackets->Next;
 
         QuicTraceLogVerbose(
@@ -179,15 +194,14 @@ QuicLossDetectionReset(
     // Throw away any outstanding packets.
     //
 
-    while (LossDetection->SentPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-        LossDetection->SentPackets = LossDetection->SentPackets->Next;
+    QUIC_SENT_PACKET_METADATA* Packet;
+    while ((Packet = QuicSentPacketRingFirst(&LossDetection->SentPackets)) != NULL) {
+        QuicSentPacketRingRemove(&LossDetection->SentPackets, Packet->PacketNumber);
         QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
     }
-    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
 
     while (LossDetection->LostPackets != NULL) {
-        QUIC_SENT_PACKET_METADATA* Packet = LossDetection->LostPackets;
+        Packet = LossDetection->LostPackets;
         LossDetection->LostPackets = LossDetection->LostPackets->Next;
         QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
     }
@@ -207,11 +221,17 @@ QuicLossDetectionOldestOutstandingPacket(
     _In_ QUIC_LOSS_DETECTION* LossDetection
     )
 {
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-    while (Packet != NULL && !Packet->Flags.IsAckEliciting) {
-        Packet = Packet->Next;
+    const QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+    for (uint64_t PacketNumber = Ring->BasePacketNumber;
+        PacketNumber < QuicSentPacketRingEnd(Ring);
+        PacketNumber++) {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(Ring, PacketNumber);
+        if (Packet != NULL && Packet->Flags.IsAckEliciting) {
+            return Packet;
+        }
     }
-    return Packet;
+    return NULL;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -424,12 +444,31 @@ QuicLossDetectionOnPacketSent(
 
     LossDetection->LargestSentPacketNumber = TempSentPacket->PacketNumber;
 
+    if (LossDetection->PacketsInFlight == 0) {
+        //
+        // Nothing is outstanding, so the time spent idle must not count
+        // against the delivery rate of the packets sent from now on.
+        //
+        LossDetection->FirstSentTime = SentPacket->SentTime;
+        LossDetection->DeliveredTime = SentPacket->SentTime;
+    }
+    SentPacket->DeliveredTime = LossDetection->DeliveredTime;
+    SentPacket->FirstSentTime = LossDetection->FirstSentTime;
+    SentPacket->DeliveredBytes = LossDetection->DeliveredBytes;
+    SentPacket->Flags.IsAppLimited = LossDetection->AppLimited;
+
     //
-    // Add to the outstanding-packet queue.
+    // Add to the outstanding packets.
     //
     SentPacket->Next = NULL;
-    *LossDetection->SentPacketsTail = SentPacket;
-    LossDetection->SentPacketsTail = &SentPacket->Next;
+    if (!QuicSentPacketRingPush(&LossDetection->SentPackets, SentPacket)) {
+        //
+        // We can't track this packet, so mark the data in it as lost right
+        // away, the same as when the metadata allocation fails.
+        //
+        QuicLossDetectionRetransmitFrames(LossDetection, SentPacket, TRUE);
+        return;
+    }
 
     CXPLAT_DBG_ASSERT(
         SentPacket->Flags.KeyType != QUIC_PACKET_KEY_0_RTT ||
@@ -459,12 +498,28 @@ QuicLossDetectionOnPacketSent(
     QuicLossValidate(LossDetection);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionOnAppLimited(
+    _In_ QUIC_LOSS_DETECTION* LossDetection
+    )
+{
+    //
+    // The delivery rate can't be measured accurately until everything sent
+    // up to now, and while the application is limiting the send rate, has
+    // been acknowledged.
+    //
+    LossDetection->AppLimited = TRUE;
+    LossDetection->AppLimitedPacketNumber = LossDetection->LargestSentPacketNumber;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLossDetectionOnPacketAcknowledged(
     _In_ QUIC_LOSS_DETECTION* LossDetection,
     _In_ QUIC_ENCRYPT_LEVEL EncryptLevel,
-    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    _In_ QUIC_SENT_PACKET_METADATA* Packet,
+    _In_ uint32_t TimeNow // microseconds
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
@@ -486,6 +541,36 @@ QuicLossDetectionOnPacketAcknowledged(
         QuicCryptoHandshakeConfirmed(&Connection->Crypto);
     }
 
+    if (Packet->Flags.IsAckEliciting) {
+        //
+        // Update the delivery rate state. The rate sample for the current ACK
+        // is taken relative to the most recently sent packet it acknowledges,
+        // which is the one with the largest delivered snapshot.
+        //
+        QUIC_RATE_SAMPLE* RateSample = &LossDetection->RateSample;
+        LossDetection->DeliveredBytes += Packet->PacketLength;
+        LossDetection->DeliveredTime = TimeNow;
+        if (!RateSample->IsValid ||
+            Packet->DeliveredBytes >= RateSample->PriorDelivered) {
+            RateSample->PriorDelivered = Packet->DeliveredBytes;
+            RateSample->PriorTime = Packet->DeliveredTime;
+            RateSample->SendElapsed =
+                CxPlatTimeDiff32(Packet->FirstSentTime, Packet->SentTime);
+            RateSample->IsAppLimited = Packet->Flags.IsAppLimited;
+            RateSample->IsValid = TRUE;
+
+            //
+            // The next send interval starts with this packet.
+            //
+            LossDetection->FirstSentTime = Packet->SentTime;
+        }
+
+        if (LossDetection->AppLimited &&
+            Packet->PacketNumber > LossDetection->AppLimitedPacketNumber) {
+            LossDetection->AppLimited = FALSE;
+        }
+    }
+
     QUIC_PACKET_SPACE* PacketSpace = Connection->Packets[QUIC_ENCRYPT_LEVEL_1_RTT];
     if (EncryptLevel == QUIC_ENCRYPT_LEVEL_1_RTT &&
         PacketSpace->AwaitingKeyPhaseConfirmation &&
@@ -912,7 +997,7 @@ QuicLossDetectionDetectAndHandleLostPackets(
         QuicLossValidate(LossDetection);
     }
 
-    if (LossDetection->SentPackets != NULL) {
+    if (LossDetection->SentPackets.PacketCount != 0) {
         //
         // Remove "suspect" packets inferred lost from out-of-order ACKs.
         // The spec has:
@@ -925,9 +1010,21 @@ QuicLossDetectionDetectAndHandleLostPackets(
         uint32_t Rtt = CXPLAT_MAX(Path->SmoothedRtt, Path->LatestRttSample);
         uint32_t TimeReorderThreshold = QUIC_TIME_REORDER_THRESHOLD(Rtt);
         uint64_t LargestLostPacketNumber = 0;
-        QUIC_SENT_PACKET_METADATA* PrevPacket = NULL;
-        Packet = LossDetection->SentPackets;
-        while (Packet != NULL) {
+
+        //
+        // Only packets smaller than the largest acknowledged packet number can
+        // be inferred lost, so there is no need to look any further.
+        //
+        QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+        for (uint64_t PacketNumber = Ring->BasePacketNumber;
+            PacketNumber < QuicSentPacketRingEnd(Ring) &&
+            PacketNumber < LossDetection->LargestAck;
+            PacketNumber++) {
+
+            Packet = QuicSentPacketRingGet(Ring, PacketNumber);
+            if (Packet == NULL) {
+                continue;
+            }
 
             BOOLEAN NonretransmittableHandshakePacket =
                 !Packet->Flags.IsAckEliciting &&
@@ -936,8 +1033,6 @@ QuicLossDetectionDetectAndHandleLostPackets(
                 QuicKeyTypeToEncryptLevel(Packet->Flags.KeyType);
 
             if (EncryptLevel > LossDetection->LargestAckEncryptLevel) {
-                PrevPacket = Packet;
-                Packet = Packet->Next;
                 continue;
             }
 
@@ -987,21 +1082,10 @@ QuicLossDetectionDetectAndHandleLostPackets(
             }
 
             LargestLostPacketNumber = Packet->PacketNumber;
-            if (PrevPacket == NULL) {
-                LossDetection->SentPackets = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            } else {
-                PrevPacket->Next = Packet->Next;
-                if (Packet->Next == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            }
+            QuicSentPacketRingRemove(Ring, PacketNumber);
 
             *LossDetection->LostPacketsTail = Packet;
             LossDetection->LostPacketsTail = &Packet->Next;
-            Packet = Packet->Next;
             *LossDetection->LostPacketsTail = NULL;
         }
 
@@ -1086,7 +1170,7 @@ QuicLossDetectionDiscardPackets(
                 Connection,
                 Packet->PacketNumber,
                 QuicPacketTraceType(Packet));
-            QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet);
+            QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet, TimeNow);
 
             Packet = NextPacket;
 
@@ -1098,23 +1182,14 @@ QuicLossDetectionDiscardPackets(
 
     QuicLossValidate(LossDetection);
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
+    QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+    for (uint64_t PacketNumber = Ring->BasePacketNumber;
+        PacketNumber < QuicSentPacketRingEnd(Ring);
+        PacketNumber++) {
 
-        if (Packet->Flags.KeyType == KeyType) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
+        Packet = QuicSentPacketRingGet(Ring, PacketNumber);
+        if (Packet != NULL && Packet->Flags.KeyType == KeyType) {
+            QuicSentPacketRingRemove(Ring, PacketNumber);
 
             QuicTraceLogVerbose(
                 PacketTxAckedImplicit,
@@ -1133,13 +1208,7 @@ QuicLossDetectionDiscardPackets(
                 AckedRetransmittableBytes += Packet->PacketLength;
             }
 
-            QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet);
-
-            Packet = NextPacket;
-
-        } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
+            QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet, TimeNow);
         }
     }
 
@@ -1152,7 +1221,8 @@ QuicLossDetectionDiscardPackets(
             .TimeNow = TimeNow,
             .LargestPacketNumberAcked = LossDetection->LargestAck,
             .NumRetransmittableBytes = AckedRetransmittableBytes,
-            .SmoothedRtt = Path->SmoothedRtt
+            .SmoothedRtt = Path->SmoothedRtt,
+            .DeliveredBytes = LossDetection->DeliveredBytes
         };
 
         if (QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent)) {
@@ -1171,31 +1241,21 @@ QuicLossDetectionOnZeroRttRejected(
     )
 {
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
-    QUIC_SENT_PACKET_METADATA* PrevPacket;
-    QUIC_SENT_PACKET_METADATA* Packet;
     uint32_t CountRetransmittableBytes = 0;
 
     //
     // Marks all the packets as lost so they can be retransmitted immediately.
     //
 
-    PrevPacket = NULL;
-    Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        QUIC_SENT_PACKET_METADATA* NextPacket = Packet->Next;
+    QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+    for (uint64_t PacketNumber = Ring->BasePacketNumber;
+        PacketNumber < QuicSentPacketRingEnd(Ring);
+        PacketNumber++) {
 
-        if (Packet->Flags.KeyType == QUIC_PACKET_KEY_0_RTT) {
-            if (PrevPacket != NULL) {
-                PrevPacket->Next = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &PrevPacket->Next;
-                }
-            } else {
-                LossDetection->SentPackets = NextPacket;
-                if (NextPacket == NULL) {
-                    LossDetection->SentPacketsTail = &LossDetection->SentPackets;
-                }
-            }
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(Ring, PacketNumber);
+        if (Packet != NULL && Packet->Flags.KeyType == QUIC_PACKET_KEY_0_RTT) {
+            QuicSentPacketRingRemove(Ring, PacketNumber);
 
             QuicTraceLogVerbose(
                 PacketTx0RttRejected,
@@ -1209,12 +1269,6 @@ QuicLossDetectionOnZeroRttRejected(
             CountRetransmittableBytes += Packet->PacketLength;
 
             QuicLossDetectionRetransmitFrames(LossDetection, Packet, TRUE);
-
-            Packet = NextPacket;
-
-        } else {
-            PrevPacket = Packet;
-            Packet = NextPacket;
         }
     }
 
@@ -1232,6 +1286,145 @@ QuicLossDetectionOnZeroRttRejected(
     }
 }
 
+//
+// Validates the ECN counts of a newly received ACK frame (RFC 9000 Section
+// 13.4.2.1) and informs congestion control of any newly reported marks.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionProcessEcn(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _In_ QUIC_PATH* Path,
+    _In_ QUIC_ENCRYPT_LEVEL EncryptLevel,
+    _In_opt_ const QUIC_ACK_ECN_EX* Ecn,
+    _In_ uint64_t EcnEctAcked
+    )
+{
+    QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    QUIC_PACKET_SPACE* Packets = Connection->Packets[EncryptLevel];
+    BOOLEAN EcnValidated = TRUE;
+    uint64_t EctCount = 0;
+    uint64_t NewEctCount = 0;
+    uint64_t NewCeCount = 0;
+
+    if (Ecn == NULL) {
+        //
+        // ECT marked packets were acknowledged without any ECN feedback, so
+        // either the path or the peer is clearing the marks.
+        //
+        EcnValidated = EcnEctAcked == 0;
+
+    } else {
+        uint64_t OtherEctCount;
+        if (Connection->Settings.L4sEnabled) {
+            EctCount = Ecn->ECT_1_Count;
+            OtherEctCount = Ecn->ECT_0_Count;
+        } else {
+            EctCount = Ecn->ECT_0_Count;
+            OtherEctCount = Ecn->ECT_1_Count;
+        }
+
+        if (EctCount < Packets->EcnEctCounter ||
+            Ecn->CE_Count < Packets->EcnCeCounter) {
+            //
+            // The peer's counts went backwards.
+            //
+            EcnValidated = FALSE;
+        } else {
+            NewEctCount = EctCount - Packets->EcnEctCounter;
+            NewCeCount = Ecn->CE_Count - Packets->EcnCeCounter;
+            if (NewEctCount + NewCeCount < EcnEctAcked ||
+                OtherEctCount != 0 ||
+                EctCount + Ecn->CE_Count > Packets->EcnEctSent) {
+                //
+                // Marks were cleared or rewritten on the path, or the peer
+                // reported more marked packets than were ever sent.
+                //
+                EcnValidated = FALSE;
+            }
+        }
+    }
+
+    if (!EcnValidated) {
+        Path->EcnValidationState = ECN_VALIDATION_FAILED;
+        QuicTraceLogConnInfo(
+            EcnValidationFailure,
+            Connection,
+            "Path[%hhu] ECN validation failed",
+            Path->ID);
+        return;
+    }
+
+    if (Ecn == NULL) {
+        return;
+    }
+
+    Packets->EcnEctCounter = EctCount;
+    Packets->EcnCeCounter = Ecn->CE_Count;
+
+    if (EcnEctAcked > 0 && Path->EcnValidationState != ECN_VALIDATION_CAPABLE) {
+        Path->EcnValidationState = ECN_VALIDATION_CAPABLE;
+        QuicTraceLogConnInfo(
+            EcnValidationSuccess,
+            Connection,
+            "Path[%hhu] ECN validation succeeded",
+            Path->ID);
+    }
+
+    if (NewEctCount + NewCeCount > 0) {
+        QUIC_ECN_EVENT EcnEvent = {
+            .LargestPacketNumberAcked = LossDetection->LargestAck,
+            .LargestSentPacketNumber = LossDetection->LargestSentPacketNumber,
+            .NumEctPackets = NewEctCount + NewCeCount,
+            .NumCePackets = NewCeCount
+        };
+        QuicCongestionControlOnEcn(&Connection->CongestionControl, &EcnEvent);
+    }
+}
+
+//
+// Computes the delivery rate sample for the ACK frame being processed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionGenerateRateSample(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _Inout_ QUIC_ACK_EVENT* AckEvent
+    )
+{
+    QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
+    const QUIC_RATE_SAMPLE* RateSample = &LossDetection->RateSample;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    if (!RateSample->IsValid) {
+        return;
+    }
+
+    //
+    // The delivery rate is the data acknowledged over the longer of the send
+    // and ACK intervals, so that neither a send burst nor ACK compression
+    // overestimates it. Intervals still shorter than the minimum RTT can't
+    // be trusted and are discarded.
+    //
+    const uint32_t AckElapsed =
+        CxPlatTimeDiff32(RateSample->PriorTime, LossDetection->DeliveredTime);
+    const uint32_t Interval = CXPLAT_MAX(RateSample->SendElapsed, AckElapsed);
+    if (Interval == 0 ||
+        (Path->GotFirstRttSample && Interval < Path->MinRtt)) {
+        return;
+    }
+
+    AckEvent->DeliveryInterval = Interval;
+    AckEvent->DeliveryRate =
+        (LossDetection->DeliveredBytes - RateSample->PriorDelivered) *
+        S_TO_US(1) / Interval;
+
+    Connection->Stats.Send.DeliveryRate = AckEvent->DeliveryRate;
+    if (Connection->Stats.Send.MaxDeliveryRate < AckEvent->DeliveryRate) {
+        Connection->Stats.Send.MaxDeliveryRate = AckEvent->DeliveryRate;
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLossDetectionProcessAckBlocks(
@@ -1240,6 +1433,7 @@ QuicLossDetectionProcessAckBlocks(
     _In_ QUIC_ENCRYPT_LEVEL EncryptLevel,
     _In_ uint64_t AckDelay,
     _In_ QUIC_RANGE* AckBlocks,
+    _In_opt_ const QUIC_ACK_ECN_EX* Ecn,
     _Out_ BOOLEAN* InvalidAckBlock
     )
 {
@@ -1247,17 +1441,20 @@ QuicLossDetectionProcessAckBlocks(
     QUIC_SENT_PACKET_METADATA** AckedPacketsTail = &AckedPackets;
 
     uint32_t AckedRetransmittableBytes = 0;
+    uint64_t EcnEctAcked = 0;
     QUIC_CONNECTION* Connection = QuicLossDetectionGetConnection(LossDetection);
     uint64_t TimeNow = CxPlatTimeUs64();
     uint32_t SmallestRtt = (uint32_t)(-1);
+    uint32_t LatestRtt = 0;
     BOOLEAN NewLargestAck = FALSE;
     BOOLEAN NewLargestAckRetransmittable = FALSE;
     BOOLEAN NewLargestAckDifferentPath = FALSE;
 
     *InvalidAckBlock = FALSE;
+    LossDetection->RateSample.IsValid = FALSE;
 
     QUIC_SENT_PACKET_METADATA** LostPacketsStart = &LossDetection->LostPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsStart = &LossDetection->SentPackets;
+    QUIC_SENT_PACKET_RING* SentPackets = &LossDetection->SentPackets;
     QUIC_SENT_PACKET_METADATA* LargestAckedPacket = NULL;
 
     uint32_t i = 0;
@@ -1318,36 +1515,37 @@ QuicLossDetectionProcessAckBlocks(
         }
 
         //
-        // Now find all the acknowledged packets in the SentPackets list.
+        // Now remove all the acknowledged packets from the SentPackets ring.
+        // Only the part of the ACK block the ring covers needs to be visited.
         //
-        if (*SentPacketsStart != NULL) {
-            while (*SentPacketsStart && (*SentPacketsStart)->PacketNumber < AckBlock->Low) {
-                SentPacketsStart = &((*SentPacketsStart)->Next);
-            }
-
-            QUIC_SENT_PACKET_METADATA** End = SentPacketsStart;
-            while (*End && (*End)->PacketNumber <= QuicRangeGetHigh(AckBlock)) {
+        if (SentPackets->PacketCount != 0) {
+            uint64_t PacketNumber =
+                CXPLAT_MAX(AckBlock->Low, SentPackets->BasePacketNumber);
+            const uint64_t End =
+                CXPLAT_MIN(
+                    QuicRangeGetHigh(AckBlock) + 1,
+                    QuicSentPacketRingEnd(SentPackets));
+            BOOLEAN PacketsRemoved = FALSE;
+
+            for (; PacketNumber < End; PacketNumber++) {
+                QUIC_SENT_PACKET_METADATA* Packet =
+                    QuicSentPacketRingRemove(SentPackets, PacketNumber);
+                if (Packet == NULL) {
+                    continue;
+                }
 
-                if ((*End)->Flags.IsAckEliciting) {
+                if (Packet->Flags.IsAckEliciting) {
                     LossDetection->PacketsInFlight--;
-                    AckedRetransmittableBytes += (*End)->PacketLength;
+                    AckedRetransmittableBytes += Packet->PacketLength;
                 }
-                LargestAckedPacket = *End;
-                End = &((*End)->Next);
+                LargestAckedPacket = Packet;
+                *AckedPacketsTail = Packet;
+                AckedPacketsTail = &Packet->Next;
+                PacketsRemoved = TRUE;
             }
 
-            if (SentPacketsStart != End) {
-                //
-                // Remove the ACKed packets from the outstanding packet list.
-                //
-                *AckedPacketsTail = *SentPacketsStart;
-                AckedPacketsTail = End;
-                *SentPacketsStart = *End;
-                *End = NULL;
-                if (End == LossDetection->SentPacketsTail) {
-                    LossDetection->SentPacketsTail = SentPacketsStart;
-                }
-
+            if (PacketsRemoved) {
+                *AckedPacketsTail = NULL;
                 QuicLossValidate(LossDetection);
             }
         }
@@ -1406,7 +1604,12 @@ QuicLossDetectionProcessAckBlocks(
 
         SmallestRtt = CXPLAT_MIN(SmallestRtt, PacketRtt);
 
-        QuicLossDetectionOnPacketAcknowledged(LossDetection, EncryptLevel, Packet);
+        if (Packet->Flags.EcnEctSet) {
+            EcnEctAcked++;
+        }
+
+        QuicLossDetectionOnPacketAcknowledged(
+            LossDetection, EncryptLevel, Packet, (uint32_t)TimeNow);
     }
 
     QuicLossValidate(LossDetection);
@@ -1424,6 +1627,7 @@ QuicLossDetectionProcessAckBlocks(
             SmallestRtt -= (uint32_t)AckDelay;
         }
         QuicConnUpdateRtt(Connection, Path, SmallestRtt);
+        LatestRtt = SmallestRtt;
     }
 
     if (NewLargestAck) {
@@ -1433,6 +1637,18 @@ QuicLossDetectionProcessAckBlocks(
         // calculation for congestion events.
         //
         QuicLossDetectionDetectAndHandleLostPackets(LossDetection, (uint32_t)TimeNow);
+
+        //
+        // ECN counts only grow with the largest acknowledged packet number, so
+        // they are only checked for ACKs that advance it. This also ignores
+        // reordered ACK frames.
+        //
+        if (Connection->Settings.EcnEnabled &&
+            !NewLargestAckDifferentPath &&
+            Path->EcnValidationState != ECN_VALIDATION_FAILED) {
+            QuicLossDetectionProcessEcn(
+                LossDetection, Path, EncryptLevel, Ecn, EcnEctAcked);
+        }
     }
 
     if (NewLargestAck || AckedRetransmittableBytes > 0) {
@@ -1440,9 +1656,18 @@ QuicLossDetectionProcessAckBlocks(
             .TimeNow = TimeNow,
             .LargestPacketNumberAcked = LossDetection->LargestAck,
             .NumRetransmittableBytes = AckedRetransmittableBytes,
-            .SmoothedRtt = Connection->Paths[0].SmoothedRtt
+            .SmoothedRtt = Connection->Paths[0].SmoothedRtt,
+            .LatestRtt = LatestRtt,
+            .DeliveredBytes = LossDetection->DeliveredBytes,
+            .PriorDeliveredBytes = LossDetection->RateSample.PriorDelivered,
+            .DeliveryRate = 0,
+            .DeliveryInterval = 0,
+            .IsPriorDeliveredValid = LossDetection->RateSample.IsValid,
+            .IsAppLimited = LossDetection->RateSample.IsAppLimited
         };
 
+        QuicLossDetectionGenerateRateSample(LossDetection, &AckEvent);
+
         if (QuicCongestionControlOnDataAcknowledged(&Connection->CongestionControl, &AckEvent)) {
             //
             // We were previously blocked and are now unblocked.
@@ -1510,7 +1735,6 @@ QuicLossDetectionProcessAckFrame(
 
         } else {
 
-            // TODO - Use ECN information.
             AckDelay <<= Connection->PeerTransportParams.AckDelayExponent;
 
             QuicLossDetectionProcessAckBlocks(
@@ -1519,6 +1743,7 @@ QuicLossDetectionProcessAckFrame(
                 EncryptLevel,
                 AckDelay,
                 &Connection->DecodedAckRanges,
+                FrameType == QUIC_FRAME_ACK_1 ? &Ecn : NULL,
                 InvalidFrame);
         }
     }
@@ -1587,9 +1812,13 @@ QuicLossDetectionScheduleProbe(
     // Not enough new stream data exists to fill the probing packets. Schedule
     // retransmits if possible.
     //
-    QUIC_SENT_PACKET_METADATA* Packet = LossDetection->SentPackets;
-    while (Packet != NULL) {
-        if (Packet->Flags.IsAckEliciting) {
+    const QUIC_SENT_PACKET_RING* Ring = &LossDetection->SentPackets;
+    for (uint64_t PacketNumber = Ring->BasePacketNumber;
+        PacketNumber < QuicSentPacketRingEnd(Ring);
+        PacketNumber++) {
+        QUIC_SENT_PACKET_METADATA* Packet =
+            QuicSentPacketRingGet(Ring, PacketNumber);
+        if (Packet != NULL && Packet->Flags.IsAckEliciting) {
             QuicTraceLogVerbose(
                 PacketTxProbeRetransmit,
                 "[%c][TX][%llu] Probe Retransmit",
@@ -1607,7 +1836,6 @@ QuicLossDetectionScheduleProbe(
                 return;
             }
         }
-        Packet = Packet->Next;
     }
 
     //
@@ -1657,7 +1885,7 @@ QuicLossDetectionProcessTimerOperation(
         CxPlatTimeDiff32(OldestPacket->SentTime, TimeNow) >=
             MS_TO_US(Connection->Settings.DisconnectTimeoutMs)) {
         //
-        // OldestPacket has been in the SentPackets list for at least
+        // OldestPacket has been in SentPackets for at least
         // DisconnectTimeoutUs without an ACK for either OldestPacket or for any
         // packets sent more than the reordering threshold after it. Assume the
         // path is dead and close the connection.
@@ -5,6 +5,20 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct QUIC_RATE_SAMPLE {
+
+    uint64_t PriorDelivered;
+    uint32_t PriorTime; // microseconds
+    uint32_t SendElapsed; // microseconds
+    BOOLEAN IsValid : 1;
+    BOOLEAN IsAppLimited : 1;
+
+} QUIC_RATE_SAMPLE;
+
 typedef struct QUIC_LOSS_DETECTION {
 
     //
@@ -23,23 +37,49 @@ typedef struct QUIC_LOSS_DETECTION {
     QUIC_ENCRYPT_LEVEL LargestAckEncryptLevel;
 
     //
-    // N.B.: SentPackets and LostPackets are generally kept in ascending packet
-    // number order, and packets in the LostPackets list generally have smaller
-    // numbers than those in the SentPackets list. The only case this is not
-    // true is during the handshake. Since multiple encryption levels are used
-    // in parallel, higher numbered packets in lower encryption levels can be
-    // "lost" sooner than the higher encryption levels.
+    // N.B.: LostPackets is generally kept in ascending packet number order,
+    // and packets in the LostPackets list generally have smaller numbers than
+    // those in SentPackets. The only case this is not true is during the
+    // handshake. Since multiple encryption levels are used in parallel, higher
+    // numbered packets in lower encryption levels can be "lost" sooner than
+    // the higher encryption levels.
     //
 
     //
-    // Outstanding packets.
+    // Outstanding packets, indexed by packet number so that processing an ACK
+    // frame only touches the acknowledged packets.
     //
     uint64_t LargestSentPacketNumber;
-    QUIC_SENT_PACKET_METADATA* SentPackets;
-    QUIC_SENT_PACKET_METADATA** SentPacketsTail;
+    QUIC_SENT_PACKET_RING SentPackets;
 
     uint32_t TimeOfLastPacketSent;
 
+    //
+    // Delivery rate estimation state (draft-cheng-iccrg-delivery-rate-estimation).
+    // DeliveredBytes is the total number of ack-eliciting bytes acknowledged
+    // so far and DeliveredTime is when it was last updated (or when sending
+    // resumed after an idle period). FirstSentTime is the send time of the
+    // packet that started the current send interval. Each sent packet records
+    // a snapshot of all three.
+    //
+    uint64_t DeliveredBytes;
+    uint32_t DeliveredTime; // microseconds
+    uint32_t FirstSentTime; // microseconds
+
+    //
+    // Set when the application ran out of data to send while the congestion
+    // window was open. Packets sent until a packet numbered above
+    // AppLimitedPacketNumber is acknowledged produce app-limited samples.
+    //
+    BOOLEAN AppLimited;
+    uint64_t AppLimitedPacketNumber;
+
+    //
+    // The rate sample for the ACK frame currently being processed, taken from
+    // the snapshot of the most recently sent packet it acknowledges.
+    //
+    QUIC_RATE_SAMPLE RateSample;
+
     //
     // Lost packets. The purpose of this list is to remember packets a little
     // while after we decide they are lost, in case we were wrong and the ACK
@@ -126,6 +166,16 @@ QuicLossDetectionOnPacketSent(
     _In_ QUIC_SENT_PACKET_METADATA* SentPacket
     );
 
+//
+// Called when the application has no more data to send while the congestion
+// window still allows sending.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionOnAppLimited(
+    _In_ QUIC_LOSS_DETECTION* LossDetection
+    );
+
 //
 // Processes a received ACK frame. Returns true if the frame could be
 // successfully processed. On failure, 'InvalidFrame' indicates if the frame
@@ -145,6 +195,21 @@ QuicLossDetectionProcessAckFrame(
     _Out_ BOOLEAN* InvalidFrame
     );
 
+//
+// Validates the ECN counts of a newly received ACK frame, given the number of
+// ECT marked packets it newly acknowledged, and informs congestion control of
+// any newly reported marks.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLossDetectionProcessEcn(
+    _In_ QUIC_LOSS_DETECTION* LossDetection,
+    _In_ QUIC_PATH* Path,
+    _In_ QUIC_ENCRYPT_LEVEL EncryptLevel,
+    _In_opt_ const QUIC_ACK_ECN_EX* Ecn,
+    _In_ uint64_t EcnEctAcked
+    );
+
 //
 // Called when the loss detection timer fires.
 //
@@ -153,3 +218,7 @@ void
 QuicLossDetectionProcessTimerOperation(
     _In_ QUIC_LOSS_DETECTION* LossDetection
     );
+
+#if defined(__cplusplus)
+}
+#endif
@@ -128,11 +128,23 @@ QuicPacketBuilderInitialize(
     } else {
         TimeSinceLastSend = 0;
     }
+
+    //
+    // When pacing is offloaded, each batch is stamped with a departure time
+    // and the datapath spaces them out, so the whole window may be sent now.
+    //
+    Builder->PacingRate = 0;
+    if (Connection->Settings.PacingOffloadEnabled &&
+        (CxPlatDataPathGetSupportedFeatures(MsQuicLib.Datapath) & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME)) {
+        Builder->PacingRate =
+            QuicCongestionControlGetPacingRate(&Connection->CongestionControl);
+    }
+
     Builder->SendAllowance =
         QuicCongestionControlGetSendAllowance(
             &Connection->CongestionControl,
             TimeSinceLastSend,
-            Connection->Send.LastFlushTimeValid);
+            Connection->Send.LastFlushTimeValid && Builder->PacingRate == 0);
     if (Builder->SendAllowance > Path->Allowance) {
         Builder->SendAllowance = Path->Allowance;
     }
@@ -245,10 +257,12 @@ QuicPacketBuilderPrepare(
         if (Builder->SendData == NULL) {
             Builder->BatchId =
                 ProcShifted | InterlockedIncrement64((int64_t*)&MsQuicLib.PerProc[Proc].SendBatchId);
+            CXPLAT_ECN_TYPE ECN = QuicPathGetSendEcn(Connection, Builder->Path);
+            Builder->EcnEctSet = ECN != CXPLAT_ECN_NON_ECT;
             Builder->SendData =
                 CxPlatSendDataAlloc(
                     Builder->Path->Binding->Socket,
-                    CXPLAT_ECN_NON_ECT,
+                    ECN,
                     IsPathMtuDiscovery ?
                         0 :
                         MaxUdpPayloadSizeForFamily(
@@ -366,6 +380,7 @@ QuicPacketBuilderPrepare(
         Builder->Metadata->Flags.IsAckEliciting = FALSE;
         Builder->Metadata->Flags.IsMtuProbe = IsPathMtuDiscovery;
         Builder->Metadata->Flags.SuspectedLost = FALSE;
+        Builder->Metadata->Flags.EcnEctSet = Builder->EcnEctSet;
 #if DEBUG
         Builder->Metadata->Flags.Freed = FALSE;
 #endif
@@ -604,13 +619,52 @@ QuicPacketBuilderPrepareForStreamFrames(
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-QuicPacketBuilderFinalizeHeaderProtection(
+QuicPacketBuilderFinalizeBatch(
     _Inout_ QUIC_PACKET_BUILDER* Builder
     )
 {
     CXPLAT_DBG_ASSERT(Builder->Key != NULL);
+    CXPLAT_DBG_ASSERT(Builder->BatchCount != 0);
+
+    CXPLAT_CRYPT_BATCH_ENTRY Batch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+    for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
+        QuicCryptoCombineIvAndPacketNumber(
+            Builder->Key->Iv,
+            (uint8_t*)&Builder->PacketNumberBatch[i],
+            Batch[i].Iv);
+        Batch[i].AuthData = Builder->HeaderBatch[i];
+        Batch[i].AuthDataLength = Builder->HeaderLengthBatch[i];
+        Batch[i].Buffer = Builder->HeaderBatch[i] + Builder->HeaderLengthBatch[i];
+        Batch[i].BufferLength = Builder->PayloadLengthBatch[i];
+    }
 
     QUIC_STATUS Status;
+    if (QUIC_FAILED(
+        Status =
+        CxPlatEncryptBatch(
+            Builder->Key->PacketKey,
+            Builder->BatchCount,
+            Batch))) {
+        QuicConnFatalError(Builder->Connection, Status, "Encryption failure");
+        goto Exit;
+    }
+
+    if (!Builder->Connection->State.HeaderProtectionEnabled) {
+        goto Exit;
+    }
+
+    //
+    // The header protection sample starts 4 bytes after the start of the
+    // packet number, which may be before the start of the payload.
+    //
+    const uint8_t SampleOffset = 4 - Builder->PacketNumberLength;
+    for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
+        CxPlatCopyMemory(
+            Builder->CipherBatch + i * CXPLAT_HP_SAMPLE_LENGTH,
+            Batch[i].Buffer + SampleOffset,
+            CXPLAT_HP_SAMPLE_LENGTH);
+    }
+
     if (QUIC_FAILED(
         Status =
         CxPlatHpComputeMask(
@@ -620,7 +674,7 @@ QuicPacketBuilderFinalizeHeaderProtection(
             Builder->HpMask))) {
         CXPLAT_TEL_ASSERT(FALSE);
         QuicConnFatalError(Builder->Connection, Status, "HP failure");
-        return;
+        goto Exit;
     }
 
     for (uint8_t i = 0; i < Builder->BatchCount; ++i) {
@@ -633,6 +687,9 @@ QuicPacketBuilderFinalizeHeaderProtection(
         }
     }
 
+Exit:
+
+    CxPlatSecureZeroMemory(Batch, sizeof(Batch));
     Builder->BatchCount = 0;
 }
 
@@ -783,51 +840,52 @@ QuicPacketBuilderFinalize(
 
         uint8_t* Payload = Header + Builder->HeaderLength;
 
-        uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
-        QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Iv);
-
         QUIC_STATUS Status;
-        if (QUIC_FAILED(
-            Status =
-            CxPlatEncrypt(
-                Builder->Key->PacketKey,
-                Iv,
-                Builder->HeaderLength,
-                Header,
-                PayloadLength,
-                Payload))) {
-            QuicConnFatalError(Connection, Status, "Encryption failure");
-            goto Exit;
-        }
+        if (Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE) {
+            CXPLAT_DBG_ASSERT(Builder->BatchCount < QUIC_MAX_CRYPTO_BATCH_COUNT);
 
-        if (Connection->State.HeaderProtectionEnabled) {
+            //
+            // Batch the encryption and header protection for short header
+            // packets. They are all sent with the same 1-RTT key and are
+            // completed together before the datagrams are sent out.
+            //
 
-            uint8_t* PnStart = Payload - Builder->PacketNumberLength;
+            Builder->HeaderBatch[Builder->BatchCount] = Header;
+            Builder->PacketNumberBatch[Builder->BatchCount] = Builder->Metadata->PacketNumber;
+            Builder->HeaderLengthBatch[Builder->BatchCount] = Builder->HeaderLength;
+            Builder->PayloadLengthBatch[Builder->BatchCount] = PayloadLength;
 
-            if (Builder->PacketType == SEND_PACKET_SHORT_HEADER_TYPE) {
-                CXPLAT_DBG_ASSERT(Builder->BatchCount < QUIC_MAX_CRYPTO_BATCH_COUNT);
+            if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT) {
+                QuicPacketBuilderFinalizeBatch(Builder);
+            }
 
-                //
-                // Batch the header protection for short header packets.
-                //
+        } else {
+            CXPLAT_DBG_ASSERT(Builder->BatchCount == 0);
 
-                CxPlatCopyMemory(
-                    Builder->CipherBatch + Builder->BatchCount * CXPLAT_HP_SAMPLE_LENGTH,
-                    PnStart + 4,
-                    CXPLAT_HP_SAMPLE_LENGTH);
-                Builder->HeaderBatch[Builder->BatchCount] = Header;
+            //
+            // Individually encrypt and do header protection for long header
+            // packets as they generally use different keys.
+            //
 
-                if (++Builder->BatchCount == QUIC_MAX_CRYPTO_BATCH_COUNT) {
-                    QuicPacketBuilderFinalizeHeaderProtection(Builder);
-                }
+            uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+            QuicCryptoCombineIvAndPacketNumber(Builder->Key->Iv, (uint8_t*) &Builder->Metadata->PacketNumber, Iv);
+
+            if (QUIC_FAILED(
+                Status =
+                CxPlatEncrypt(
+                    Builder->Key->PacketKey,
+                    Iv,
+                    Builder->HeaderLength,
+                    Header,
+                    PayloadLength,
+                    Payload))) {
+                QuicConnFatalError(Connection, Status, "Encryption failure");
+                goto Exit;
+            }
 
-            } else {
-                CXPLAT_DBG_ASSERT(Builder->BatchCount == 0);
+            if (Connection->State.HeaderProtectionEnabled) {
 
-                //
-                // Individually do header protection for long header packets as
-                // they generally use different keys.
-                //
+                uint8_t* PnStart = Payload - Builder->PacketNumberLength;
 
                 if (QUIC_FAILED(
                     Status =
@@ -864,6 +922,13 @@ QuicPacketBuilderFinalize(
             !PacketSpace->AwaitingKeyPhaseConfirmation &&
             Connection->State.HandshakeConfirmed) {
 
+            //
+            // Packets already batched must be encrypted with the current key.
+            //
+            if (Builder->BatchCount != 0) {
+                QuicPacketBuilderFinalizeBatch(Builder);
+            }
+
             Status = QuicCryptoGenerateNewKeys(Connection);
             if (QUIC_FAILED(Status)) {
                 QuicTraceEvent(
@@ -908,6 +973,9 @@ QuicPacketBuilderFinalize(
         Builder->Metadata->PacketNumber,
         QuicPacketTraceType(Builder->Metadata),
         Builder->Metadata->PacketLength);
+    if (Builder->Metadata->Flags.EcnEctSet) {
+        Connection->Packets[Builder->EncryptLevel]->EcnEctSent++;
+    }
     QuicLossDetectionOnPacketSent(
         &Connection->LossDetection,
         Builder->Path,
@@ -917,6 +985,7 @@ QuicPacketBuilderFinalize(
 
     if (Builder->Metadata->Flags.IsAckEliciting) {
         Builder->PacketBatchRetransmittable = TRUE;
+        Builder->SendDataAckEliciting = TRUE;
 
         //
         // Remove the bytes from the allowance.
@@ -936,16 +1005,12 @@ Exit:
 
     if (FinalQuicPacket) {
         if (Builder->Datagram != NULL) {
-            Builder->Datagram->Length = Builder->DatagramLength;
-            Builder->Datagram = NULL;
-            Builder->DatagramLength = 0;
-            ++Builder->TotalCountDatagrams;
-            Builder->TotalDatagramsLength += Builder->DatagramLength;
+            QuicPacketBuilderCompleteDatagram(Builder);
         }
 
         if (FlushBatchedDatagrams || CxPlatSendDataIsFull(Builder->SendData)) {
             if (Builder->BatchCount != 0) {
-                QuicPacketBuilderFinalizeHeaderProtection(Builder);
+                QuicPacketBuilderFinalizeBatch(Builder);
             }
             CXPLAT_DBG_ASSERT(Builder->TotalCountDatagrams > 0);
             QuicPacketBuilderSendBatch(Builder);
@@ -996,6 +1061,18 @@ QuicPacketBuilderSendBatch(
         "Sending batch. %hu datagrams",
         (uint16_t)Builder->TotalCountDatagrams);
 
+    if (Builder->PacingRate != 0 && Builder->SendDataAckEliciting) {
+        //
+        // Schedule the batch to leave right after the previous one has drained
+        // at the pacing rate. Batches without ack-eliciting packets (i.e. only
+        // ACKs) aren't paced, so they go out immediately.
+        //
+        CxPlatSendDataSetTxTime(
+            Builder->SendData,
+            QuicPacketBuilderGetBatchTxTime(Builder, CxPlatTimeUs64()));
+    }
+    Builder->SendDataAckEliciting = FALSE;
+
     QuicBindingSend(
         Builder->Path->Binding,
         &Builder->Path->Route,
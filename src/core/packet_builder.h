@@ -57,6 +57,18 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     uint8_t* HeaderBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
 
+    //
+    // Packet numbers of the batched packets, used to compute their IVs.
+    //
+    uint64_t PacketNumberBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+
+    //
+    // Header and payload (including encryption overhead) lengths of the
+    // batched packets.
+    //
+    uint16_t HeaderLengthBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+    uint16_t PayloadLengthBatch[QUIC_MAX_CRYPTO_BATCH_COUNT];
+
     //
     // Indicates a batch of packets has been sent.
     //
@@ -69,10 +81,20 @@ typedef struct QUIC_PACKET_BUILDER {
     uint8_t PacketBatchRetransmittable : 1;
 
     //
-    // The number of batched packets to do header protection on.
+    // The number of batched packets to encrypt and do header protection on.
     //
     uint8_t BatchCount : 4;
 
+    //
+    // Indicates the current send data is marked with an ECT codepoint.
+    //
+    uint8_t EcnEctSet : 1;
+
+    //
+    // Indicates the current send data includes an ack-eliciting packet.
+    //
+    uint8_t SendDataAckEliciting : 1;
+
     //
     // The total number of datagrams that have been created.
     //
@@ -136,6 +158,12 @@ typedef struct QUIC_PACKET_BUILDER {
     //
     uint32_t SendAllowance;
 
+    //
+    // The pacing rate (bytes per second) used to stamp departure times on the
+    // send data when pacing is offloaded to the datapath. Zero otherwise.
+    //
+    uint64_t PacingRate;
+
     uint64_t BatchId;
 
     //
@@ -214,6 +242,44 @@ QuicPacketBuilderFinalize(
     _In_ BOOLEAN FlushBatchedDatagrams
     );
 
+//
+// Completes the current datagram and adds it to the batch.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicPacketBuilderCompleteDatagram(
+    _Inout_ QUIC_PACKET_BUILDER* Builder
+    )
+{
+    Builder->Datagram->Length = Builder->DatagramLength;
+    ++Builder->TotalCountDatagrams;
+    Builder->TotalDatagramsLength += Builder->DatagramLength;
+    Builder->Datagram = NULL;
+    Builder->DatagramLength = 0;
+}
+
+//
+// Returns the departure time for the current (paced) batch: right after the
+// previous one has drained at the pacing rate. The next batch's departure is
+// then pushed back by this batch's length at the pacing rate.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+uint64_t
+QuicPacketBuilderGetBatchTxTime(
+    _In_ QUIC_PACKET_BUILDER* Builder,
+    _In_ uint64_t TimeNow
+    )
+{
+    CXPLAT_DBG_ASSERT(Builder->PacingRate != 0);
+    QUIC_SEND* Send = &Builder->Connection->Send;
+    const uint64_t TxTime = CXPLAT_MAX(TimeNow, Send->NextTxTime);
+    Send->NextTxTime =
+        TxTime + S_TO_US((uint64_t)Builder->TotalDatagramsLength) / Builder->PacingRate;
+    return TxTime;
+}
+
 //
 // Returns TRUE if congestion control isn't currently blocking sends.
 //
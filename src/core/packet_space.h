@@ -104,6 +104,18 @@ typedef struct QUIC_PACKET_SPACE {
     //
     BOOLEAN AwaitingKeyPhaseConfirmation: 1;
 
+    //
+    // The number of ECT marked packets sent in this packet space.
+    //
+    uint64_t EcnEctSent;
+
+    //
+    // The largest ECT(0|1) and CE counts reported by the peer so far. Used to
+    // compute the newly marked packets on each ACK_ECN frame.
+    //
+    uint64_t EcnEctCounter;
+    uint64_t EcnCeCounter;
+
 } QUIC_PACKET_SPACE;
 
 //
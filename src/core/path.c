@@ -70,6 +70,48 @@ QuicPathRemove(
     Connection->PathsCount--;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_ECN_TYPE
+QuicPathGetSendEcn(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path
+    )
+{
+    if (!Connection->Settings.EcnEnabled) {
+        return CXPLAT_ECN_NON_ECT;
+    }
+
+    if (Path->EcnValidationState == ECN_VALIDATION_TESTING) {
+        //
+        // Packets are marked for three PTOs after the first marked packet is
+        // sent. If no ECN feedback has arrived by then, stop marking until some
+        // does (RFC 9000 Appendix A.4).
+        //
+        const uint32_t TimeNow = CxPlatTimeUs32();
+        if (!Path->EcnTestingStarted) {
+            Path->EcnTestingStarted = TRUE;
+            Path->EcnTestingEndTime =
+                TimeNow +
+                QuicLossDetectionComputeProbeTimeout(
+                    &Connection->LossDetection, Path, QUIC_ECN_TESTING_PTO_COUNT);
+        } else if (CxPlatTimeAtOrBefore32(Path->EcnTestingEndTime, TimeNow)) {
+            Path->EcnValidationState = ECN_VALIDATION_UNKNOWN;
+            QuicTraceLogConnInfo(
+                EcnValidationUnknown,
+                Connection,
+                "Path[%hhu] ECN validation testing complete; state unknown",
+                Path->ID);
+        }
+    }
+
+    if (Path->EcnValidationState == ECN_VALIDATION_TESTING ||
+        Path->EcnValidationState == ECN_VALIDATION_CAPABLE) {
+        return Connection->Settings.L4sEnabled ? CXPLAT_ECN_ECT_1 : CXPLAT_ECN_ECT_0;
+    }
+
+    return CXPLAT_ECN_NON_ECT;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicPathSetAllowance(
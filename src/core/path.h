@@ -5,6 +5,22 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// ECN validation state of a path, as described in RFC 9000 Appendix A.4.
+//
+typedef enum QUIC_ECN_VALIDATION_STATE {
+
+    ECN_VALIDATION_TESTING,     // Sending ECT marked packets to test the path.
+    ECN_VALIDATION_UNKNOWN,     // Testing done; waiting for ECN feedback.
+    ECN_VALIDATION_CAPABLE,     // Path and peer correctly handle ECN.
+    ECN_VALIDATION_FAILED       // Validation failed; stop marking packets.
+
+} QUIC_ECN_VALIDATION_STATE;
+
 //
 // Represents all the per-path information of a connection.
 //
@@ -67,6 +83,16 @@ typedef struct QUIC_PATH {
     //
     uint8_t PartitionUpdated : 1;
 
+    //
+    // ECN validation state of the path (QUIC_ECN_VALIDATION_STATE).
+    //
+    uint8_t EcnValidationState : 2;
+
+    //
+    // Indicates the ECN validation testing period has started.
+    //
+    uint8_t EcnTestingStarted : 1;
+
     //
     // The currently calculated path MTU.
     //
@@ -129,6 +155,12 @@ typedef struct QUIC_PATH {
     //
     uint32_t PathValidationStartTime;
 
+    //
+    // Time when ECN validation testing ends, in microseconds. Only valid once
+    // EcnTestingStarted is set.
+    //
+    uint32_t EcnTestingEndTime;
+
 } QUIC_PATH;
 
 #if DEBUG
@@ -160,6 +192,17 @@ QuicPathRemove(
     _In_ uint8_t Index
     );
 
+//
+// Returns the ECN codepoint to mark the next packets sent on the path with,
+// moving ECN validation out of the testing state once its period is over.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_ECN_TYPE
+QuicPathGetSendEcn(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ QUIC_PATH* Path
+    );
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicPathSetAllowance(
@@ -254,3 +297,7 @@ QuicCopyRouteInfo(
     _Inout_ CXPLAT_ROUTE* DstRoute,
     _In_ CXPLAT_ROUTE* SrcRoute
     );
+
+#if defined(__cplusplus)
+}
+#endif
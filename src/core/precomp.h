@@ -74,3 +74,4 @@
 #include "packet_builder.h"
 #include "listener.h"
 #include "cubic.h"
+#include "bbr.h"
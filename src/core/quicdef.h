@@ -151,6 +151,30 @@ typedef struct QUIC_PATH QUIC_PATH;
 //
 #define QUIC_MAX_WORKER_QUEUE_DELAY             250
 
+//
+// By default, workers don't spin while waiting for a timer to expire. When
+// set, a worker spins instead of sleeping once the next timer is less than
+// this many microseconds away.
+//
+#define QUIC_DEFAULT_WORKER_TIMER_SPIN_US       0
+
+//
+// The maximum allowed worker timer spin duration, in microseconds.
+//
+#define QUIC_MAX_WORKER_TIMER_SPIN_US           1000
+
+//
+// How often (in us) a worker reports statistics on how late it woke up for
+// timers.
+//
+#define QUIC_WORKER_TIMER_STATS_INTERVAL        (1000 * 1000)
+
+//
+// The default maximum number of freed streams each worker keeps, with their
+// receive buffers, for reuse by newly opened streams.
+//
+#define QUIC_DEFAULT_STREAM_CACHE_SIZE          64
+
 //
 // The maximum number of simultaneous stateless operations that can be queued on
 // a single worker.
@@ -188,6 +212,14 @@ typedef struct QUIC_PATH QUIC_PATH;
 //
 #define QUIC_STREAM_SEND_BATCH_COUNT            8
 
+//
+// The initial and maximum number of slots in the window of streams the stream
+// set indexes directly, per stream type. Must be powers of 2. Open streams
+// that fall out of the window are kept in a hash table instead.
+//
+#define QUIC_STREAM_WINDOW_INITIAL_SIZE         16
+#define QUIC_STREAM_WINDOW_MAX_SIZE             0x10000
+
 //
 // The maximum number of received packets to batch process at a time.
 //
@@ -241,11 +273,28 @@ typedef struct QUIC_PATH QUIC_PATH;
 //
 #define QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE    0x1000  // 4096
 
+//
+// The size of the chunks stream receive buffers are built from. They come from
+// the same per-worker pool as the default stream receive buffer.
+//
+#define QUIC_RECV_BUFFER_CHUNK_SIZE             QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE
+
 //
 // The default connection flow control window value, in bytes.
 //
 #define QUIC_DEFAULT_CONN_FLOW_CONTROL_WINDOW   0x1000000  // 16MB
 
+//
+// The largest connection flow control window auto-tuning grows to, in bytes.
+//
+#define QUIC_MAX_CONN_FLOW_CONTROL_WINDOW       0x40000000  // 1GB
+
+//
+// The default fraction (N/65535) of total memory that auto-tuning may add to
+// connection flow control windows, across all connections.
+//
+#define QUIC_DEFAULT_RECV_WINDOW_MEMORY_LIMIT   6554  // ~10%
+
 //
 // Maximum memory allocated (in bytes) for different range tracking structures
 //
@@ -330,6 +379,11 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_RECV_BUFFER_DRAIN_RATIO            4
 
+//
+// The maximum number of buffers indicated in a single stream receive event.
+//
+#define QUIC_MAX_RECEIVE_BUFFER_COUNT           16
+
 //
 // The default value for send buffering being enabled or not.
 //
@@ -346,6 +400,16 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_MAX_IDEAL_SEND_BUFFER_SIZE         0x8000000 // 134217728
 
+//
+// The size classes of the pooled slabs buffered send requests are copied
+// into: 4KB, 16KB and 64KB. Requests of up to QUIC_SEND_BUFFER_COALESCE_MAX
+// bytes share slabs of the smallest class; larger ones get a slab of their
+// own, or a separate allocation if they don't fit the largest class.
+//
+#define QUIC_SEND_BUFFER_SLAB_CLASS_COUNT       3
+#define QUIC_SEND_BUFFER_SLAB_SIZE(Class)       (0x1000u << (2 * (Class)))
+#define QUIC_SEND_BUFFER_COALESCE_MAX           1024
+
 //
 // The minimum number of bytes of send allowance we must have before we will
 // send another packet.
@@ -391,6 +455,18 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_SEND_PACING_INTERVAL               1000
 
+//
+// By default, pacing is done in software, by the send path, rather than by
+// handing departure times to the kernel.
+//
+#define QUIC_DEFAULT_PACING_OFFLOAD_ENABLED     FALSE
+
+//
+// When pacing is offloaded, how far ahead of the current time (in us) packets
+// may be scheduled to leave the host before the send path waits.
+//
+#define QUIC_SEND_PACING_OFFLOAD_HORIZON        (10 * QUIC_SEND_PACING_INTERVAL)
+
 //
 // The maximum number of bytes to send in a given key phase
 // before performing a key phase update. Roughly, 274GB.
@@ -423,6 +499,12 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_LOAD_BALANCING_MODE        QUIC_LOAD_BALANCING_DISABLED
 
+//
+// The default value for steering received packets to the partition in their
+// CID (instead of by CPU) being enabled or not.
+//
+#define QUIC_DEFAULT_CID_STEERING_ENABLED       FALSE
+
 //
 // The default value for datagrams being enabled or not.
 //
@@ -434,6 +516,23 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_MAX_DATAGRAM_LENGTH        0xFFFF
 
+//
+// The default lifetime (in ms) of a datagram sent with
+// QUIC_SEND_FLAG_DGRAM_EXPIRE. Zero means such datagrams never expire.
+//
+#define QUIC_DEFAULT_DATAGRAM_SEND_TTL_MS       0
+
+//
+// The default maximum number of datagrams queued for send. Zero means the
+// queue is unbounded.
+//
+#define QUIC_DEFAULT_DATAGRAM_SEND_QUEUE_LIMIT  0
+
+//
+// The default datagram to cancel when the send queue is full.
+//
+#define QUIC_DEFAULT_DATAGRAM_SEND_DROP_POLICY  QUIC_DATAGRAM_DROP_OLDEST
+
 //
 // By default, resumption and 0-RTT are not enabled for servers.
 // If an application want to use these features, it must explicitly enable them.
@@ -457,6 +556,23 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_VERSION_NEGOTIATION_EXT_ENABLED    FALSE
 
+//
+// By default, ECN marking of sent packets is disabled.
+//
+#define QUIC_DEFAULT_ECN_ENABLED                FALSE
+
+//
+// By default, L4S (ECT(1) marking and scalable congestion response) is
+// disabled. Only takes effect when ECN is also enabled.
+//
+#define QUIC_DEFAULT_L4S_ENABLED                FALSE
+
+//
+// The number of PTOs ECN validation stays in the testing state before
+// moving to unknown, if no ECN feedback was received.
+//
+#define QUIC_ECN_TESTING_PTO_COUNT              3
+
 //
 // The AEAD Integrity limit for maximum failed decryption packets over the
 // lifetime of a connection. Set to the lowest limit, which is for
@@ -537,3 +653,20 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_MTU_MISSING_PROBE_COUNT        "MtuDiscoveryMissingProbeCount"
 
 #define QUIC_SETTING_CONGESTION_CONTROL_ALGORITHM   "CongestionControlAlgorithm"
+
+#define QUIC_SETTING_ECN_ENABLED                    "EcnEnabled"
+#define QUIC_SETTING_L4S_ENABLED                    "L4sEnabled"
+
+#define QUIC_SETTING_WORKER_TIMER_SPIN_US           "WorkerTimerSpinUs"
+
+#define QUIC_SETTING_PACING_OFFLOAD_ENABLED         "PacingOffloadEnabled"
+
+#define QUIC_SETTING_STREAM_CACHE_SIZE              "StreamCacheSize"
+
+#define QUIC_SETTING_RECV_WINDOW_MEMORY_LIMIT       "RecvWindowMemoryLimit"
+
+#define QUIC_SETTING_CID_STEERING_ENABLED           "CidSteeringEnabled"
+
+#define QUIC_SETTING_DATAGRAM_SEND_TTL_MS           "DatagramSendTtlMs"
+#define QUIC_SETTING_DATAGRAM_SEND_QUEUE_LIMIT      "DatagramSendQueueLimit"
+#define QUIC_SETTING_DATAGRAM_SEND_DROP_POLICY      "DatagramSendDropPolicy"
@@ -40,6 +40,21 @@ Abstract:
 
     Currently, only growing the virtual buffer length is supported.
 
+    In chunked mode (ChunkPool != NULL) the physical buffer is instead a
+    circular array of fixed size chunks. Growing only appends chunks (and
+    occasionally doubles the array of chunk pointers), so buffered bytes are
+    never copied, and chunks are returned to the pool as they are drained.
+    Reads may then return one buffer per chunk.
+
+    In app-owned mode (AppOwned) the chunks are buffers the application
+    provided. Data is written straight into them, so it's only copied once
+    from the packet. Their total length is the window advertised to the peer;
+    drained chunks are dropped from the array, and the window only moves when
+    the application provides more. The peer may already have been allowed to
+    send more than the first buffers hold (the initial window), so the pooled
+    chunks covering that window are kept ahead of the app's buffers until
+    they are drained.
+
 --*/
 
 #include "precomp.h"
@@ -47,53 +62,203 @@ Abstract:
 #include "recv_buffer.c.clog.h"
 #endif
 
+//
+// Returns the Index'th chunk, counting from the first.
+//
+#define QuicRecvBufferChunk(RecvBuffer, Index) \
+    (RecvBuffer)->Chunks[((RecvBuffer)->FirstChunk + (Index)) & ((RecvBuffer)->ChunkSlots - 1)]
+
+//
+// Grows the circular array of chunks to hold at least TargetChunkCount. Only
+// the chunk descriptors are copied.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferReserveChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t TargetChunkCount
+    )
+{
+    if (TargetChunkCount <= RecvBuffer->ChunkSlots) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    uint32_t NewChunkSlots = RecvBuffer->ChunkSlots << 1;
+    while (NewChunkSlots < TargetChunkCount) {
+        NewChunkSlots <<= 1;
+    }
+    QUIC_BUFFER* NewChunks = NULL;
+    if (NewChunkSlots != 0 && NewChunkSlots <= UINT32_MAX / sizeof(QUIC_BUFFER)) {
+        NewChunks =
+            CXPLAT_ALLOC_NONPAGED(NewChunkSlots * sizeof(QUIC_BUFFER), QUIC_POOL_RECVBUF);
+    }
+    if (NewChunks == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer chunks",
+            (uint64_t)NewChunkSlots * sizeof(QUIC_BUFFER));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    for (uint32_t i = 0; i < RecvBuffer->ChunkCount; ++i) {
+        NewChunks[i] = QuicRecvBufferChunk(RecvBuffer, i);
+    }
+    if (RecvBuffer->Chunks != RecvBuffer->InlineChunks) {
+        CXPLAT_FREE(RecvBuffer->Chunks, QUIC_POOL_RECVBUF);
+    }
+    RecvBuffer->Chunks = NewChunks;
+    RecvBuffer->ChunkSlots = NewChunkSlots;
+    RecvBuffer->FirstChunk = 0;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Adds pooled chunks until AllocBufferLength is at least TargetBufferLength.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
-QUIC_STATUS // TODO - Can only fail if PreallocatedBuffer == NULL
+QUIC_STATUS
+QuicRecvBufferAddChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t TargetBufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->ChunkPool != NULL);
+    const uint32_t TargetChunkCount =
+        (TargetBufferLength + QUIC_RECV_BUFFER_CHUNK_SIZE - 1) / QUIC_RECV_BUFFER_CHUNK_SIZE;
+
+    QUIC_STATUS Status = QuicRecvBufferReserveChunks(RecvBuffer, TargetChunkCount);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    while (RecvBuffer->ChunkCount < TargetChunkCount) {
+        uint8_t* Chunk = CxPlatPoolAlloc(RecvBuffer->ChunkPool);
+        if (Chunk == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "recv_buffer chunk",
+                QUIC_RECV_BUFFER_CHUNK_SIZE);
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        QuicRecvBufferChunk(RecvBuffer, RecvBuffer->ChunkCount).Buffer = Chunk;
+        QuicRecvBufferChunk(RecvBuffer, RecvBuffer->ChunkCount).Length = QUIC_RECV_BUFFER_CHUNK_SIZE;
+        RecvBuffer->ChunkCount++;
+        RecvBuffer->AllocBufferLength += QUIC_RECV_BUFFER_CHUNK_SIZE;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Converts *Offset, relative to the start of the first chunk, to the offset in
+// the chunk holding that byte, and returns the chunk's index.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+QuicRecvBufferFindChunk(
+    _In_ const QUIC_RECV_BUFFER* RecvBuffer,
+    _Inout_ uint32_t* Offset
+    )
+{
+    uint32_t Index;
+    if (!RecvBuffer->AppOwned) {
+        Index = *Offset / QUIC_RECV_BUFFER_CHUNK_SIZE;
+        *Offset %= QUIC_RECV_BUFFER_CHUNK_SIZE;
+    } else {
+        Index = 0;
+        while (*Offset >= QuicRecvBufferChunk(RecvBuffer, Index).Length) {
+            *Offset -= QuicRecvBufferChunk(RecvBuffer, Index).Length;
+            Index++;
+            CXPLAT_DBG_ASSERT(Index < RecvBuffer->ChunkCount);
+        }
+    }
+    return Index;
+}
+
+//
+// Releases all chunks and the chunk array.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferFreeChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    if (RecvBuffer->ChunkPool != NULL) {
+        const uint32_t PooledChunkCount =
+            RecvBuffer->AppOwned ? RecvBuffer->PooledChunkCount : RecvBuffer->ChunkCount;
+        for (uint32_t i = 0; i < PooledChunkCount; ++i) {
+            CxPlatPoolFree(RecvBuffer->ChunkPool, QuicRecvBufferChunk(RecvBuffer, i).Buffer);
+        }
+    }
+    if (RecvBuffer->Chunks != RecvBuffer->InlineChunks) {
+        CXPLAT_FREE(RecvBuffer->Chunks, QUIC_POOL_RECVBUF);
+    }
+    RecvBuffer->Chunks = RecvBuffer->InlineChunks;
+    RecvBuffer->ChunkSlots = QUIC_RECV_BUFFER_INLINE_CHUNKS;
+    RecvBuffer->ChunkCount = 0;
+    RecvBuffer->PooledChunkCount = 0;
+    RecvBuffer->FirstChunk = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
 QuicRecvBufferInitialize(
     _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
     _In_ uint32_t AllocBufferLength,
     _In_ uint32_t VirtualBufferLength,
     _In_ BOOLEAN CopyOnDrain,
-    _In_opt_ uint8_t* PreallocatedBuffer
+    _In_opt_ CXPLAT_POOL* ChunkPool
     )
 {
     QUIC_STATUS Status;
 
-    CXPLAT_DBG_ASSERT(AllocBufferLength != 0 && (AllocBufferLength & (AllocBufferLength - 1)) == 0);       // Power of 2
+    CXPLAT_DBG_ASSERT((AllocBufferLength != 0 || ChunkPool != NULL) && (AllocBufferLength & (AllocBufferLength - 1)) == 0); // Power of 2, or 0 chunks
     CXPLAT_DBG_ASSERT(VirtualBufferLength != 0 && (VirtualBufferLength & (VirtualBufferLength - 1)) == 0); // Power of 2
     CXPLAT_DBG_ASSERT(AllocBufferLength <= VirtualBufferLength);
-
-    if (PreallocatedBuffer != NULL) {
-        RecvBuffer->PreallocatedBuffer = PreallocatedBuffer;
-        RecvBuffer->Buffer = PreallocatedBuffer;
-    } else {
-        RecvBuffer->PreallocatedBuffer = NULL;
-        RecvBuffer->Buffer = CXPLAT_ALLOC_NONPAGED(AllocBufferLength, QUIC_POOL_RECVBUF);
-        if (RecvBuffer->Buffer == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "recv_buffer",
-                AllocBufferLength);
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Error;
-        }
-    }
+    CXPLAT_DBG_ASSERT(ChunkPool == NULL || !CopyOnDrain);
 
     QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &RecvBuffer->WrittenRanges);
 
-    RecvBuffer->AllocBufferLength = AllocBufferLength;
     RecvBuffer->VirtualBufferLength = VirtualBufferLength;
     RecvBuffer->BufferStart = 0;
     RecvBuffer->BaseOffset = 0;
     RecvBuffer->CopyOnDrain = CopyOnDrain;
     RecvBuffer->ExternalBufferReference = FALSE;
+    RecvBuffer->AppOwned = FALSE;
+    RecvBuffer->PooledChunkCount = 0;
     RecvBuffer->OldBuffer = NULL;
-    Status = QUIC_STATUS_SUCCESS;
+    RecvBuffer->Buffer = NULL;
+    RecvBuffer->ChunkPool = ChunkPool;
+    RecvBuffer->Chunks = RecvBuffer->InlineChunks;
+    RecvBuffer->ChunkSlots = QUIC_RECV_BUFFER_INLINE_CHUNKS;
+    RecvBuffer->ChunkCount = 0;
+    RecvBuffer->FirstChunk = 0;
+
+    if (ChunkPool != NULL) {
+        RecvBuffer->AllocBufferLength = 0;
+        Status = QuicRecvBufferAddChunks(RecvBuffer, AllocBufferLength);
+        if (QUIC_FAILED(Status)) {
+            QuicRecvBufferUninitialize(RecvBuffer);
+        }
+        return Status;
+    }
 
-Error:
+    RecvBuffer->Buffer = CXPLAT_ALLOC_NONPAGED(AllocBufferLength, QUIC_POOL_RECVBUF);
+    if (RecvBuffer->Buffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer",
+            AllocBufferLength);
+        QuicRangeUninitialize(&RecvBuffer->WrittenRanges);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    RecvBuffer->AllocBufferLength = AllocBufferLength;
 
-    return Status;
+    return QUIC_STATUS_SUCCESS;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -103,17 +268,151 @@ QuicRecvBufferUninitialize(
     )
 {
     QuicRangeUninitialize(&RecvBuffer->WrittenRanges);
-    if (RecvBuffer->Buffer != RecvBuffer->PreallocatedBuffer) {
+    QuicRecvBufferFreeChunks(RecvBuffer);
+    RecvBuffer->AllocBufferLength = 0;
+    if (RecvBuffer->Buffer != NULL) {
         CXPLAT_FREE(RecvBuffer->Buffer, QUIC_POOL_RECVBUF);
     }
     RecvBuffer->Buffer = NULL;
-    if (RecvBuffer->OldBuffer != NULL &&
-        RecvBuffer->OldBuffer != RecvBuffer->PreallocatedBuffer) {
+    if (RecvBuffer->OldBuffer != NULL) {
         CXPLAT_FREE(RecvBuffer->OldBuffer, QUIC_POOL_RECVBUF);
     }
     RecvBuffer->OldBuffer = NULL;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferReset(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocBufferLength,
+    _In_ uint32_t VirtualBufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT((AllocBufferLength & (AllocBufferLength - 1)) == 0);                                  // Power of 2, or 0 chunks
+    CXPLAT_DBG_ASSERT(VirtualBufferLength != 0 && (VirtualBufferLength & (VirtualBufferLength - 1)) == 0); // Power of 2
+    CXPLAT_DBG_ASSERT(AllocBufferLength <= VirtualBufferLength);
+    CXPLAT_DBG_ASSERT(RecvBuffer->ChunkPool != NULL);
+    CXPLAT_DBG_ASSERT(!RecvBuffer->AppOwned);
+    CXPLAT_DBG_ASSERT(!RecvBuffer->ExternalBufferReference);
+
+    //
+    // Return the chunks past AllocBufferLength, and move back to the inline
+    // chunk array if the rest fit.
+    //
+    const uint32_t TargetChunkCount =
+        (AllocBufferLength + QUIC_RECV_BUFFER_CHUNK_SIZE - 1) / QUIC_RECV_BUFFER_CHUNK_SIZE;
+    while (RecvBuffer->ChunkCount > TargetChunkCount) {
+        RecvBuffer->ChunkCount--;
+        CxPlatPoolFree(
+            RecvBuffer->ChunkPool,
+            QuicRecvBufferChunk(RecvBuffer, RecvBuffer->ChunkCount).Buffer);
+    }
+    if (RecvBuffer->Chunks != RecvBuffer->InlineChunks &&
+        RecvBuffer->ChunkCount <= QUIC_RECV_BUFFER_INLINE_CHUNKS) {
+        for (uint32_t i = 0; i < RecvBuffer->ChunkCount; ++i) {
+            RecvBuffer->InlineChunks[i] = QuicRecvBufferChunk(RecvBuffer, i);
+        }
+        CXPLAT_FREE(RecvBuffer->Chunks, QUIC_POOL_RECVBUF);
+        RecvBuffer->Chunks = RecvBuffer->InlineChunks;
+        RecvBuffer->ChunkSlots = QUIC_RECV_BUFFER_INLINE_CHUNKS;
+        RecvBuffer->FirstChunk = 0;
+    }
+
+    QuicRangeReset(&RecvBuffer->WrittenRanges);
+    RecvBuffer->AllocBufferLength = RecvBuffer->ChunkCount * QUIC_RECV_BUFFER_CHUNK_SIZE;
+    RecvBuffer->VirtualBufferLength = VirtualBufferLength;
+    RecvBuffer->BufferStart = 0;
+    RecvBuffer->BaseOffset = 0;
+
+    QUIC_STATUS Status = QuicRecvBufferAddChunks(RecvBuffer, AllocBufferLength);
+    if (QUIC_FAILED(Status)) {
+        QuicRecvBufferUninitialize(RecvBuffer);
+    }
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferProvideChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* Buffers
+    )
+{
+    QUIC_STATUS Status;
+    BOOLEAN ReplacePooledChunks = FALSE;
+
+    uint64_t ProvidedLength = 0;
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        ProvidedLength += Buffers[i].Length;
+    }
+
+    if (!RecvBuffer->AppOwned) {
+        CXPLAT_DBG_ASSERT(RecvBuffer->ChunkPool != NULL);
+        if (!RecvBuffer->ExternalBufferReference &&
+            !QuicRecvBufferHasUnreadData(RecvBuffer) &&
+            ProvidedLength >= RecvBuffer->VirtualBufferLength) {
+            //
+            // Nothing is buffered, and the app's buffers cover everything the
+            // peer may already send, so they replace the pooled chunks.
+            //
+            ReplacePooledChunks = TRUE;
+        } else {
+            //
+            // Keep the buffered data (and anything the app is still reading)
+            // where it is, and make sure pooled chunks cover the rest of the
+            // current window. The app's buffers start where it ends.
+            //
+            Status =
+                QuicRecvBufferAddChunks(
+                    RecvBuffer,
+                    RecvBuffer->BufferStart + RecvBuffer->VirtualBufferLength);
+            if (QUIC_FAILED(Status)) {
+                return Status;
+            }
+        }
+    }
+
+    const uint64_t NewAllocBufferLength =
+        (ReplacePooledChunks ? 0 : RecvBuffer->AllocBufferLength) + ProvidedLength;
+    if (NewAllocBufferLength > UINT32_MAX) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    Status =
+        QuicRecvBufferReserveChunks(
+            RecvBuffer,
+            (ReplacePooledChunks ? 0 : RecvBuffer->ChunkCount) + BufferCount);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    if (!RecvBuffer->AppOwned) {
+        if (ReplacePooledChunks) {
+            for (uint32_t i = 0; i < RecvBuffer->ChunkCount; ++i) {
+                CxPlatPoolFree(RecvBuffer->ChunkPool, QuicRecvBufferChunk(RecvBuffer, i).Buffer);
+            }
+            RecvBuffer->ChunkCount = 0;
+            RecvBuffer->FirstChunk = 0;
+            RecvBuffer->BufferStart = 0;
+        }
+        RecvBuffer->PooledChunkCount = RecvBuffer->ChunkCount;
+        RecvBuffer->AppOwned = TRUE;
+    }
+
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        CXPLAT_DBG_ASSERT(Buffers[i].Length != 0);
+        QuicRecvBufferChunk(RecvBuffer, RecvBuffer->ChunkCount) = Buffers[i];
+        RecvBuffer->ChunkCount++;
+    }
+    RecvBuffer->AllocBufferLength = (uint32_t)NewAllocBufferLength;
+    RecvBuffer->VirtualBufferLength =
+        RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 uint64_t
 QuicRecvBufferGetTotalLength(
@@ -191,7 +490,7 @@ QuicRecvBufferResize(
 
         if (RecvBuffer->ExternalBufferReference && RecvBuffer->OldBuffer == NULL) {
             RecvBuffer->OldBuffer = RecvBuffer->Buffer;
-        } else if (RecvBuffer->Buffer != RecvBuffer->PreallocatedBuffer) {
+        } else {
             CXPLAT_FREE(RecvBuffer->Buffer, QUIC_POOL_RECVBUF);
         }
 
@@ -290,7 +589,25 @@ QuicRecvBufferWrite(
     // Check to see if the input buffer is trying to write beyond the
     // currently allocated length.
     //
-    if (AbsoluteLength > RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength) {
+    if (RecvBuffer->AppOwned) {
+        //
+        // VirtualBufferLength never exceeds the provided buffers.
+        //
+        CXPLAT_DBG_ASSERT(
+            RecvBuffer->BufferStart + AbsoluteLength - RecvBuffer->BaseOffset <=
+            RecvBuffer->AllocBufferLength);
+
+    } else if (RecvBuffer->ChunkPool != NULL) {
+        const uint32_t TargetBufferLength =
+            RecvBuffer->BufferStart + (uint32_t)(AbsoluteLength - RecvBuffer->BaseOffset);
+        if (TargetBufferLength > RecvBuffer->AllocBufferLength) {
+            Status = QuicRecvBufferAddChunks(RecvBuffer, TargetBufferLength);
+            if (QUIC_FAILED(Status)) {
+                goto Error;
+            }
+        }
+
+    } else if (AbsoluteLength > RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength) {
 
         //
         // Make room for the new data.
@@ -345,6 +662,31 @@ QuicRecvBufferWrite(
         RelativeOffset = (uint32_t)(BufferOffset - RecvBuffer->BaseOffset);
     }
 
+    if (RecvBuffer->ChunkPool != NULL || RecvBuffer->AppOwned) {
+        //
+        // Copy the data into each chunk it spans.
+        //
+        uint32_t ChunkOffset = RecvBuffer->BufferStart + RelativeOffset;
+        uint32_t ChunkIndex = QuicRecvBufferFindChunk(RecvBuffer, &ChunkOffset);
+        while (BufferLength != 0) {
+            const QUIC_BUFFER* Chunk = &QuicRecvBufferChunk(RecvBuffer, ChunkIndex);
+            uint16_t CopyLength =
+                (uint16_t)CXPLAT_MIN(BufferLength, Chunk->Length - ChunkOffset);
+            CxPlatCopyMemory(
+                Chunk->Buffer + ChunkOffset,
+                Buffer,
+                CopyLength);
+            Buffer += CopyLength;
+            BufferLength -= CopyLength;
+            ChunkOffset = 0;
+            ChunkIndex++;
+        }
+
+        *ReadyToRead = UpdatedRange->Low == 0;
+        Status = QUIC_STATUS_SUCCESS;
+        goto Error;
+    }
+
     //
     // Calculate the actual starting point in the buffer that we will write to,
     // accounting for wrap around.
@@ -438,7 +780,25 @@ QuicRecvBufferRead(
     RecvBuffer->ExternalBufferReference = TRUE;
     *BufferOffset = RecvBuffer->BaseOffset;
 
-    if (RecvBuffer->BufferStart + WrittenRangeLength > RecvBuffer->AllocBufferLength) {
+    if (RecvBuffer->ChunkPool != NULL || RecvBuffer->AppOwned) {
+        //
+        // Return a buffer for each chunk, as long as there's room for them.
+        //
+        uint32_t Count = 0;
+        uint32_t ChunkOffset = RecvBuffer->BufferStart;
+        while (WrittenRangeLength != 0 && Count < *BufferCount) {
+            const QUIC_BUFFER* Chunk = &QuicRecvBufferChunk(RecvBuffer, Count);
+            Buffers[Count].Length =
+                (uint32_t)CXPLAT_MIN(WrittenRangeLength, Chunk->Length - ChunkOffset);
+            Buffers[Count].Buffer = Chunk->Buffer + ChunkOffset;
+            WrittenRangeLength -= Buffers[Count].Length;
+            ChunkOffset = 0;
+            Count++;
+        }
+        CXPLAT_DBG_ASSERT(Count != 0);
+        *BufferCount = Count;
+
+    } else if (RecvBuffer->BufferStart + WrittenRangeLength > RecvBuffer->AllocBufferLength) {
         //
         // Circular buffer wrap around case.
         //
@@ -470,9 +830,7 @@ QuicRecvBufferDrain(
     RecvBuffer->ExternalBufferReference = FALSE;
 
     if (RecvBuffer->OldBuffer != NULL) {
-        if (RecvBuffer->OldBuffer != RecvBuffer->PreallocatedBuffer) {
-            CXPLAT_FREE(RecvBuffer->OldBuffer, QUIC_POOL_RECVBUF);
-        }
+        CXPLAT_FREE(RecvBuffer->OldBuffer, QUIC_POOL_RECVBUF);
         RecvBuffer->OldBuffer = NULL;
     }
 
@@ -483,7 +841,46 @@ QuicRecvBufferDrain(
     RecvBuffer->BaseOffset += BufferLength;
     uint64_t TotalWrittenLength = QuicRangeGetMax(&RecvBuffer->WrittenRanges) + 1;
 
+    if (RecvBuffer->ChunkPool != NULL || RecvBuffer->AppOwned) {
+        //
+        // Return the chunks that were completely drained to the pool, or hand
+        // them back to the app.
+        //
+        uint64_t ChunkOffset = RecvBuffer->BufferStart + BufferLength;
+        while (RecvBuffer->ChunkCount != 0 &&
+               ChunkOffset >= QuicRecvBufferChunk(RecvBuffer, 0).Length) {
+            const uint32_t ChunkLength = QuicRecvBufferChunk(RecvBuffer, 0).Length;
+            if (!RecvBuffer->AppOwned || RecvBuffer->PooledChunkCount != 0) {
+                CxPlatPoolFree(RecvBuffer->ChunkPool, QuicRecvBufferChunk(RecvBuffer, 0).Buffer);
+                if (RecvBuffer->AppOwned) {
+                    RecvBuffer->PooledChunkCount--;
+                }
+            }
+            RecvBuffer->FirstChunk = (RecvBuffer->FirstChunk + 1) & (RecvBuffer->ChunkSlots - 1);
+            RecvBuffer->ChunkCount--;
+            RecvBuffer->AllocBufferLength -= ChunkLength;
+            ChunkOffset -= ChunkLength;
+        }
+        CXPLAT_DBG_ASSERT(ChunkOffset == 0 || RecvBuffer->ChunkCount != 0);
+        RecvBuffer->BufferStart = (uint32_t)ChunkOffset;
+        if (RecvBuffer->AppOwned) {
+            //
+            // The window ends with the provided buffers, so draining doesn't
+            // move it; only providing more buffers does.
+            //
+            RecvBuffer->VirtualBufferLength =
+                RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart;
+        }
+    }
+
     if (RecvBuffer->BaseOffset == TotalWrittenLength) {
+        if (RecvBuffer->AppOwned) {
+            //
+            // App buffers are only written once, so keep writing after the
+            // drained bytes.
+            //
+            return TRUE;
+        }
         //
         // All buffer has been drained. Just reset start back to beginning.
         //
@@ -500,7 +897,7 @@ QuicRecvBufferDrain(
             RecvBuffer->Buffer,
             RecvBuffer->Buffer + BufferLength,
             (size_t)(TotalWrittenLength - RecvBuffer->BaseOffset));
-    } else {
+    } else if (RecvBuffer->ChunkPool == NULL && !RecvBuffer->AppOwned) {
         //
         // Increment the buffer start, making sure to account for circular
         // buffer wrap around.
@@ -5,6 +5,16 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// The number of chunks tracked in the receive buffer itself, before a separate
+// array is needed.
+//
+#define QUIC_RECV_BUFFER_INLINE_CHUNKS 4
+
 typedef struct QUIC_RECV_BUFFER {
 
     //
@@ -20,6 +30,20 @@ typedef struct QUIC_RECV_BUFFER {
     //
     BOOLEAN ExternalBufferReference : 1;
 
+    //
+    // Flag to indicate the chunks are buffers provided by the application
+    // (app-owned mode). They are written in place and dropped, not freed, once
+    // drained. Only the application adds more.
+    //
+    BOOLEAN AppOwned : 1;
+
+    //
+    // In app-owned mode, the number of leading chunks that still come from
+    // ChunkPool. They hold what the peer was allowed to send before the app
+    // provided its buffers, and are returned to the pool once drained.
+    //
+    uint32_t PooledChunkCount;
+
     //
     // Previous buffer that needs to be freed as soon as the external reference
     // is released.
@@ -27,18 +51,33 @@ typedef struct QUIC_RECV_BUFFER {
     uint8_t * OldBuffer;
 
     //
-    // Circular buffer used for storing the writes.
+    // Circular buffer used for storing the writes. Unused in chunked and
+    // app-owned modes.
     //
     uint8_t * Buffer;
 
     //
-    // Optional, preallocated initial buffer.
+    // Optional pool of QUIC_RECV_BUFFER_CHUNK_SIZE chunks. If set, the buffer
+    // is made of chunks instead of one contiguous allocation (chunked mode),
+    // and it grows by adding chunks instead of reallocating and copying.
     //
-    uint8_t * PreallocatedBuffer;
+    CXPLAT_POOL* ChunkPool;
 
     //
-    // Length of memory allocated for 'Buffer'. Dynamically grows up to
-    // VirtualBufferLength.
+    // Circular array of ChunkSlots (a power of 2) chunks, ChunkCount of which
+    // are in use; the chunk holding the byte at BufferStart is at FirstChunk.
+    // Only used in chunked and app-owned modes.
+    //
+    QUIC_BUFFER* Chunks;
+    uint32_t ChunkSlots;
+    uint32_t ChunkCount;
+    uint32_t FirstChunk;
+    QUIC_BUFFER InlineChunks[QUIC_RECV_BUFFER_INLINE_CHUNKS];
+
+    //
+    // Length of memory allocated for 'Buffer' (or the chunks). Dynamically
+    // grows up to VirtualBufferLength. In app-owned mode, it's the length of
+    // the chunks, and VirtualBufferLength covers exactly them.
     //
     uint32_t AllocBufferLength;
 
@@ -53,7 +92,7 @@ typedef struct QUIC_RECV_BUFFER {
     uint64_t BaseOffset;
 
     //
-    // Start of the head in the circular 'Buffer'.
+    // Start of the head in the circular 'Buffer', or in the first chunk.
     //
     uint32_t BufferStart;
 
@@ -71,7 +110,7 @@ QuicRecvBufferInitialize(
     _In_ uint32_t AllocBufferLength,
     _In_ uint32_t VirtualBufferLength,
     _In_ BOOLEAN CopyOnDrain,
-    _In_opt_ uint8_t* PreallocatedBuffer
+    _In_opt_ CXPLAT_POOL* ChunkPool
     );
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -80,6 +119,35 @@ QuicRecvBufferUninitialize(
     _In_ QUIC_RECV_BUFFER* RecvBuffer
     );
 
+//
+// Returns a chunked receive buffer to the state QuicRecvBufferInitialize
+// leaves it in, dropping any buffered data but keeping the chunks it already
+// has, up to AllocBufferLength. On failure, the buffer is uninitialized.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferReset(
+    _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t AllocBufferLength,
+    _In_ uint32_t VirtualBufferLength
+    );
+
+//
+// Appends application provided buffers to a chunked receive buffer, and grows
+// VirtualBufferLength to include them. The first call switches the buffer to
+// app-owned mode. Unless nothing is buffered and the new buffers cover the
+// whole current window, the pooled chunks are kept (and added to) so they
+// cover that window, and the app's buffers are filled after them.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferProvideChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* Buffers
+    );
+
 //
 // Get the buffer's total length from 0.
 //
@@ -132,6 +200,9 @@ QuicRecvBufferWrite(
 // Since this returns an internal pointer, the caller must retain
 // exclusive access to the buffer until it calls QuicRecvBufferDrain.
 //
+// In chunked and app-owned modes, data spanning more than *BufferCount chunks
+// is only partially returned.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
@@ -157,3 +228,7 @@ QuicRecvBufferDrain(
     _In_ QUIC_RECV_BUFFER* RecvBuffer,
     _In_ uint64_t BufferLength
     );
+
+#if defined(__cplusplus)
+}
+#endif
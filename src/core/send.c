@@ -34,6 +34,8 @@ QuicSendInitialize(
 {
     CxPlatListInitializeHead(&Send->SendStreams);
     Send->MaxData = Settings->ConnFlowControlWindow;
+    Send->RecvWindow = Settings->ConnFlowControlWindow;
+    Send->RecvWindowLastUpdate = CxPlatTimeUs32();
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -44,6 +46,11 @@ QuicSendUninitialize(
 {
     Send->DelayedAckTimerActive = FALSE;
 
+    if (Send->RecvWindowGrowth != 0) {
+        QuicLibraryRemoveRecvWindowMemory(Send->RecvWindowGrowth);
+        Send->RecvWindowGrowth = 0;
+    }
+
     if (Send->InitialToken != NULL) {
         CXPLAT_FREE(Send->InitialToken, QUIC_POOL_INITIAL_TOKEN);
         Send->InitialToken = NULL;
@@ -74,7 +81,9 @@ QuicSendApplyNewSettings(
     _In_ const QUIC_SETTINGS_INTERNAL* Settings
     )
 {
+    CXPLAT_DBG_ASSERT(Send->RecvWindowGrowth == 0);
     Send->MaxData = Settings->ConnFlowControlWindow;
+    Send->RecvWindow = Settings->ConnFlowControlWindow;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -85,6 +94,7 @@ QuicSendReset(
 {
     Send->SendFlags = 0;
     Send->LastFlushTime = 0;
+    Send->NextTxTime = 0;
     if (Send->DelayedAckTimerActive) {
         QuicConnTimerCancel(QuicSendGetConnection(Send), QUIC_CONN_TIMER_ACK_DELAY);
         Send->DelayedAckTimerActive = FALSE;
@@ -135,7 +145,8 @@ QuicSendQueueFlush(
         QuicConnAddRef(Connection, QUIC_CONN_REF_ROUTE);
         Status =
             CxPlatResolveRoute(
-                Path->Binding->Socket, &Path->Route, Path->ID, (void*)Connection, QuicConnQueueRouteCompletion);
+                Path->Binding->Socket, &Path->Route, Path->ID, (void*)Connection,
+                (CXPLAT_ROUTE_RESOLUTION_CALLBACK_HANDLER)QuicConnQueueRouteCompletion);
         if (Status == QUIC_STATUS_SUCCESS) {
             QuicConnRelease(Connection, QUIC_CONN_REF_ROUTE);
         } else {
@@ -168,19 +179,37 @@ QuicSendQueueFlush(
 }
 #pragma warning(pop)
 
+//
+// Inserts the stream into the send queue, after any streams of the same or
+// higher priority.
+//
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
-QuicSendQueueFlushForStream(
+QuicSendInsertStream(
     _In_ QUIC_SEND* Send,
-    _In_ QUIC_STREAM* Stream,
-    _In_ BOOLEAN DelaySend
+    _In_ QUIC_STREAM* Stream
     )
 {
-    if (Stream->SendLink.Flink == NULL) {
+    CXPLAT_LIST_ENTRY* Entry;
+
+    if (QuicSendGetConnection(Send)->State.UseExtensiblePriorityStreamScheduling) {
         //
-        // Not previously queued, so add the stream to the end of the queue.
+        // Insert after the last stream of the same urgency, or of the closest
+        // more urgent level, or else at the front of the queue.
         //
-        CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
+        uint8_t Urgency = QUIC_STREAM_PRIORITY_URGENCY(Stream->SendPriority);
+        Stream->SendUrgency = Urgency;
+        Entry = &Send->SendStreams;
+        for (int32_t i = Urgency; i >= 0; --i) {
+            if (Send->SendStreamsUrgencyTail[i] != NULL) {
+                Entry = Send->SendStreamsUrgencyTail[i];
+                break;
+            }
+        }
+        Send->SendStreamsUrgencyTail[Urgency] = &Stream->SendLink;
+
+    } else {
+        Entry = Send->SendStreams.Blink;
         while (Entry != &Send->SendStreams) {
             //
             // Search back to front for the right place (based on priority) to
@@ -192,7 +221,45 @@ QuicSendQueueFlushForStream(
             }
             Entry = Entry->Blink;
         }
-        CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+    }
+
+    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
+}
+
+//
+// Removes the stream from the send queue.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendRemoveStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (QuicSendGetConnection(Send)->State.UseExtensiblePriorityStreamScheduling &&
+        Send->SendStreamsUrgencyTail[Stream->SendUrgency] == &Stream->SendLink) {
+        CXPLAT_LIST_ENTRY* Prev = Stream->SendLink.Blink;
+        Send->SendStreamsUrgencyTail[Stream->SendUrgency] =
+            Prev != &Send->SendStreams &&
+            CXPLAT_CONTAINING_RECORD(Prev, QUIC_STREAM, SendLink)->SendUrgency == Stream->SendUrgency ?
+                Prev : NULL;
+    }
+    CxPlatListEntryRemove(&Stream->SendLink);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendQueueFlushForStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ BOOLEAN DelaySend
+    )
+{
+    if (Stream->SendLink.Flink == NULL) {
+        //
+        // Not previously queued, so add the stream to the queue.
+        //
+        QuicSendInsertStream(Send, Stream);
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
     }
 
@@ -222,21 +289,34 @@ QuicSendUpdateStreamPriority(
     )
 {
     CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
-    CxPlatListEntryRemove(&Stream->SendLink);
+    QuicSendRemoveStream(Send, Stream);
+    QuicSendInsertStream(Send, Stream);
+}
 
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Blink;
-    while (Entry != &Send->SendStreams) {
-        //
-        // Search back to front for the right place (based on priority) to
-        // insert the stream.
-        //
-        if (Stream->SendPriority <=
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink)->SendPriority) {
-            break;
-        }
-        Entry = Entry->Blink;
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUpdateStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send
+    )
+{
+    //
+    // Requeue all the streams in their current order. The list is ordered by
+    // priority in the FIFO and round robin schemes, which only keeps it in
+    // order of urgency for the extensible priority scheme, and not the other
+    // way around.
+    //
+    CXPLAT_LIST_ENTRY Streams;
+    CxPlatListInitializeHead(&Streams);
+    CxPlatListMoveItems(&Send->SendStreams, &Streams);
+    CxPlatZeroMemory(
+        Send->SendStreamsUrgencyTail, sizeof(Send->SendStreamsUrgencyTail));
+
+    while (!CxPlatListIsEmpty(&Streams)) {
+        QuicSendInsertStream(
+            Send,
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Streams), QUIC_STREAM, SendLink));
     }
-    CxPlatListInsertHead(Entry, &Stream->SendLink); // Insert after current Entry
 }
 
 #if DEBUG
@@ -298,6 +378,8 @@ QuicSendClear(
 
         QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
     }
+    CxPlatZeroMemory(
+        Send->SendStreamsUrgencyTail, sizeof(Send->SendStreamsUrgencyTail));
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -460,8 +542,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -479,7 +559,7 @@ QuicSendClearStreamSendFlag(
             //
             // Since there are no flags left, remove the stream from the queue.
             //
-            CxPlatListEntryRemove(&Stream->SendLink);
+            QuicSendRemoveStream(Send, Stream);
             Stream->SendLink.Flink = NULL;
             QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
         }
@@ -959,7 +1039,26 @@ QuicSendGetNextStream(
         //
         if (QuicSendCanSendStreamNow(Stream)) {
 
-            if (Connection->State.UseRoundRobinStreamScheduling) {
+            if (Connection->State.UseExtensiblePriorityStreamScheduling) {
+                if (QUIC_STREAM_PRIORITY_INCREMENTAL(Stream->SendPriority)) {
+                    //
+                    // Incremental streams share the bandwidth of their urgency
+                    // level, so move the stream to the end of its level.
+                    //
+                    if (Send->SendStreamsUrgencyTail[Stream->SendUrgency] != &Stream->SendLink) {
+                        QuicSendRemoveStream(Send, Stream);
+                        QuicSendInsertStream(Send, Stream);
+                    }
+                    *PacketCount = QUIC_STREAM_SEND_BATCH_COUNT;
+
+                } else {
+                    //
+                    // Non-incremental streams are sent one after the other.
+                    //
+                    *PacketCount = UINT32_MAX;
+                }
+
+            } else if (Connection->State.UseRoundRobinStreamScheduling) {
                 //
                 // Move the stream after any streams of the same priority. Start
                 // with the "next" entry in the list and keep going until the
@@ -1139,6 +1238,12 @@ QuicSendFlush(
     }
     _Analysis_assume_(Builder.Metadata != NULL);
 
+    //
+    // Let the datapath hand all the batches built by this flush to the kernel
+    // together.
+    //
+    CxPlatSocketSendBatchBegin();
+
     QuicTraceEvent(
         ConnFlushSend,
         "[conn][%p] Flushing Send. Allowance=%u bytes",
@@ -1174,6 +1279,28 @@ QuicSendFlush(
             SendFlags &= ~QUIC_CONN_SEND_FLAG_DATAGRAM;
         }
 
+        if (Builder.PacingRate != 0 &&
+            !(SendFlags & QUIC_CONN_SEND_FLAGS_BYPASS_CC)) {
+            //
+            // When pacing is offloaded, don't queue more than the scheduling
+            // horizon ahead in the datapath. Come back when the queued batches
+            // have (mostly) departed.
+            //
+            const uint64_t TimeNow = CxPlatTimeUs64();
+            if (Send->NextTxTime > TimeNow + QUIC_SEND_PACING_OFFLOAD_HORIZON) {
+                QuicConnAddOutFlowBlockedReason(
+                    Connection, QUIC_FLOW_BLOCKED_PACING);
+                QuicConnTimerSet(
+                    Connection,
+                    QUIC_CONN_TIMER_PACING,
+                    CXPLAT_MAX(
+                        Send->NextTxTime - TimeNow - QUIC_SEND_PACING_OFFLOAD_HORIZON,
+                        QUIC_SEND_PACING_INTERVAL));
+                Result = QUIC_SEND_DELAYED_PACING;
+                break;
+            }
+        }
+
         if (!QuicPacketBuilderHasAllowance(&Builder)) {
             //
             // While we are CC blocked, very few things are still allowed to
@@ -1267,7 +1394,7 @@ QuicSendFlush(
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
+                QuicSendRemoveStream(Send, Stream);
                 Stream->SendLink.Flink = NULL;
                 QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
                 Stream = NULL;
@@ -1282,8 +1409,11 @@ QuicSendFlush(
 
         } else {
             //
-            // Nothing else left to send right now.
+            // Nothing else left to send right now. Since the congestion
+            // window isn't the limit, delivery rate samples taken from here
+            // on only reflect how fast the app is sending.
             //
+            QuicLossDetectionOnAppLimited(&Connection->LossDetection);
             Result = QUIC_SEND_COMPLETE;
             break;
         }
@@ -1325,6 +1455,7 @@ QuicSendFlush(
     }
 
     QuicPacketBuilderCleanup(&Builder);
+    CxPlatSocketSendBatchEnd();
 
     QuicTraceLogConnVerbose(
         SendFlushComplete,
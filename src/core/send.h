@@ -194,11 +194,28 @@ typedef struct QUIC_SEND {
     //
     uint64_t LastFlushTime;
 
+    //
+    // The earliest departure time (in microseconds) for the next paced batch
+    // when pacing is offloaded to the datapath.
+    //
+    uint64_t NextTxTime;
+
     //
     // The value we send in MAX_DATA frames.
     //
     uint64_t MaxData;
 
+    //
+    // The connection flow control window: how far MaxData is kept ahead of
+    // the bytes delivered to the app. It starts at the ConnFlowControlWindow
+    // setting and is auto-tuned up from there. RecvWindowGrowth is how much
+    // it grew, which is charged to the library's receive window memory budget.
+    //
+    uint64_t RecvWindow;
+    uint64_t RecvWindowGrowth;
+    uint64_t RecvWindowBytesDelivered;
+    uint32_t RecvWindowLastUpdate;
+
     //
     // The max value received in MAX_DATA frames.
     //
@@ -226,6 +243,13 @@ typedef struct QUIC_SEND {
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // With the extensible priority scheduling scheme, the last stream in
+    // SendStreams at each urgency level (NULL if none), so that streams can be
+    // queued without searching the list.
+    //
+    CXPLAT_LIST_ENTRY* SendStreamsUrgencyTail[QUIC_STREAM_PRIORITY_URGENCY_COUNT];
+
     //
     // The current token to send with an Initial packet.
     //
@@ -322,6 +346,15 @@ QuicSendUpdateStreamPriority(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Reorders the queued streams after the stream scheduling scheme changed.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUpdateStreamSchedulingScheme(
+    _In_ QUIC_SEND* Send
+    );
+
 //
 // Tries to drain all queued data that needs to be sent. Returns TRUE if all the
 // data was drained.
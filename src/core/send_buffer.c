@@ -15,7 +15,12 @@ Abstract:
     bytes it should keep posted.
 
     We copy requests into fixed-sized blocks when possible, and fall back on
-    CXPLAT_ALLOC for large send requests.
+    CXPLAT_ALLOC for large send requests. The blocks are slabs from per-worker
+    pools, in a few size classes (QUIC_SEND_BUFFER_SLAB_SIZE). Small requests
+    are coalesced into a shared slab, one after the other, so that many small
+    sends cost a single pool allocation; the slab goes back to the pool once
+    all of them are freed. If the current shared slab empties out first, it is
+    simply reused from the start.
 
     We buffer send requests until we've buffered AT LEAST the desired number
     of bytes, rather than using the ideal buffer size as a hard limit. This
@@ -68,13 +73,67 @@ QuicSendBufferInitialize(
     SendBuffer->IdealBytes = QUIC_DEFAULT_IDEAL_SEND_BUFFER_SIZE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_SEND_BUFFER_SLAB*
+QuicSendBufferSlabAlloc(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ uint32_t Class
+    )
+{
+    QUIC_WORKER* Worker = QuicSendBufferGetConnection(SendBuffer)->Worker;
+    CXPLAT_POOL* Pool = &Worker->SendBufferSlabPools[Class];
+
+    QUIC_SEND_BUFFER_SLAB* Slab = CxPlatPoolAlloc(Pool);
+    if (Slab == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "sendbuffer slab",
+            QUIC_SEND_BUFFER_SLAB_SIZE(Class));
+        return NULL;
+    }
+
+    Slab->Pool = Pool;
+    Slab->Size = QUIC_SEND_BUFFER_SLAB_SIZE(Class) - sizeof(QUIC_SEND_BUFFER_SLAB);
+    Slab->Used = 0;
+    Slab->RefCount = 1;
+    SendBuffer->AllocatedBytes += QUIC_SEND_BUFFER_SLAB_SIZE(Class);
+
+    return Slab;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSendBufferSlabRelease(
+    _Inout_ QUIC_SEND_BUFFER* SendBuffer,
+    _In_ QUIC_SEND_BUFFER_SLAB* Slab
+    )
+{
+    CXPLAT_DBG_ASSERT(Slab->RefCount != 0);
+    if (--Slab->RefCount == 0) {
+        SendBuffer->AllocatedBytes -= Slab->Size + sizeof(QUIC_SEND_BUFFER_SLAB);
+        CxPlatPoolFree(Slab->Pool, Slab);
+
+    } else if (Slab->RefCount == 1 && Slab == SendBuffer->CurrentSlab) {
+        //
+        // Only the send buffer references its current slab now, so start
+        // over at the beginning of it.
+        //
+        Slab->Used = 0;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicSendBufferUninitialize(
     _In_ QUIC_SEND_BUFFER* SendBuffer
     )
 {
-    UNREFERENCED_PARAMETER(SendBuffer);
+    if (SendBuffer->CurrentSlab != NULL) {
+        QUIC_SEND_BUFFER_SLAB* Slab = SendBuffer->CurrentSlab;
+        SendBuffer->CurrentSlab = NULL;
+        QuicSendBufferSlabRelease(SendBuffer, Slab);
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -82,21 +141,69 @@ _Success_(return != NULL)
 uint8_t*
 QuicSendBufferAlloc(
     _Inout_ QUIC_SEND_BUFFER* SendBuffer,
-    _In_ uint32_t Size
+    _In_ uint32_t Size,
+    _Out_ QUIC_SEND_BUFFER_SLAB** Slab
     )
 {
-    uint8_t* Buf = (uint8_t*)CXPLAT_ALLOC_NONPAGED(Size, QUIC_POOL_SENDBUF);
+    uint8_t* Buf;
+    *Slab = NULL;
+
+    if (Size <= QUIC_SEND_BUFFER_COALESCE_MAX) {
+        //
+        // Carve the request out of the current shared slab, replacing it if
+        // it's full.
+        //
+        QUIC_SEND_BUFFER_SLAB* Current = SendBuffer->CurrentSlab;
+        if (Current == NULL || Current->Size - Current->Used < Size) {
+            Current = QuicSendBufferSlabAlloc(SendBuffer, 0);
+            if (Current == NULL) {
+                return NULL;
+            }
+            if (SendBuffer->CurrentSlab != NULL) {
+                QUIC_SEND_BUFFER_SLAB* Previous = SendBuffer->CurrentSlab;
+                SendBuffer->CurrentSlab = Current;
+                QuicSendBufferSlabRelease(SendBuffer, Previous);
+            } else {
+                SendBuffer->CurrentSlab = Current;
+            }
+        }
+        Buf = (uint8_t*)(Current + 1) + Current->Used;
+        Current->Used += Size;
+        Current->RefCount++;
+        *Slab = Current;
 
-    if (Buf != NULL) {
-        SendBuffer->BufferedBytes += Size;
     } else {
-        QuicTraceEvent(
-            AllocFailure,
-            "Allocation of '%s' failed. (%llu bytes)",
-            "sendbuffer",
-            Size);
+        uint32_t Class = 1;
+        while (Class < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT &&
+               Size > QUIC_SEND_BUFFER_SLAB_SIZE(Class) - sizeof(QUIC_SEND_BUFFER_SLAB)) {
+            Class++;
+        }
+
+        if (Class < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT) {
+            QUIC_SEND_BUFFER_SLAB* Dedicated = QuicSendBufferSlabAlloc(SendBuffer, Class);
+            if (Dedicated == NULL) {
+                return NULL;
+            }
+            Dedicated->Used = Size;
+            Buf = (uint8_t*)(Dedicated + 1);
+            *Slab = Dedicated;
+
+        } else {
+            Buf = (uint8_t*)CXPLAT_ALLOC_NONPAGED(Size, QUIC_POOL_SENDBUF);
+            if (Buf == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "sendbuffer",
+                    Size);
+                return NULL;
+            }
+            SendBuffer->AllocatedBytes += Size;
+        }
     }
 
+    SendBuffer->BufferedBytes += Size;
+
     return Buf;
 }
 
@@ -105,10 +212,18 @@ void
 QuicSendBufferFree(
     _Inout_ QUIC_SEND_BUFFER* SendBuffer,
     _In_ uint8_t* Buf,
-    _In_ uint32_t Size
+    _In_ uint32_t Size,
+    _In_opt_ QUIC_SEND_BUFFER_SLAB* Slab
     )
 {
-    CXPLAT_FREE(Buf, QUIC_POOL_SENDBUF);
+    if (Slab != NULL) {
+        CXPLAT_DBG_ASSERT(Buf >= (uint8_t*)(Slab + 1));
+        CXPLAT_DBG_ASSERT(Buf + Size <= (uint8_t*)(Slab + 1) + Slab->Size);
+        QuicSendBufferSlabRelease(SendBuffer, Slab);
+    } else {
+        CXPLAT_FREE(Buf, QUIC_POOL_SENDBUF);
+        SendBuffer->AllocatedBytes -= Size;
+    }
     SendBuffer->BufferedBytes -= Size;
 }
 
@@ -252,8 +367,7 @@ QuicSendBufferConnectionAdjust(
     _In_ QUIC_CONNECTION* Connection
     )
 {
-    if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE ||
-        Connection->Streams.StreamTable == NULL) {
+    if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE) {
         return; // Nothing to do.
     }
 
@@ -268,16 +382,15 @@ QuicSendBufferConnectionAdjust(
     if (NewIdealBytes > Connection->SendBuffer.IdealBytes) {
         Connection->SendBuffer.IdealBytes = NewIdealBytes;
 
-        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-        CXPLAT_HASHTABLE_ENTRY* Entry;
-        CxPlatHashtableEnumerateBegin(Connection->Streams.StreamTable, &Enumerator);
-        while ((Entry = CxPlatHashtableEnumerateNext(Connection->Streams.StreamTable, &Enumerator)) != NULL) {
-            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+        QUIC_STREAM_SET_ENUMERATOR Enumerator;
+        QUIC_STREAM* Stream;
+        QuicStreamSetEnumerateBegin(&Connection->Streams, &Enumerator);
+        while ((Stream = QuicStreamSetEnumerateNext(&Connection->Streams, &Enumerator)) != NULL) {
             if (Stream->Flags.SendEnabled) {
                 QuicSendBufferStreamAdjust(Stream);
             }
         }
-        CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
+        QuicStreamSetEnumerateEnd(&Connection->Streams, &Enumerator);
 
         if (Connection->Settings.SendBufferingEnabled) {
             QuicSendBufferFill(Connection);
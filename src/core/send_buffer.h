@@ -5,6 +5,37 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// A pooled block that buffered send requests are copied into, followed by its
+// data. A slab of the smallest class is shared by small requests, which are
+// carved out of it in order; a slab of a larger class holds one request.
+//
+typedef struct QUIC_SEND_BUFFER_SLAB {
+
+    //
+    // The per-worker pool the slab came from and goes back to.
+    //
+    CXPLAT_POOL* Pool;
+
+    //
+    // The number of data bytes in the slab, and how many of them have been
+    // handed out.
+    //
+    uint32_t Size;
+    uint32_t Used;
+
+    //
+    // The number of requests using the slab, plus one while it's the current
+    // shared slab of its send buffer.
+    //
+    uint32_t RefCount;
+
+} QUIC_SEND_BUFFER_SLAB;
+
 typedef struct QUIC_SEND_BUFFER {
 
     //
@@ -27,6 +58,17 @@ typedef struct QUIC_SEND_BUFFER {
     //
     uint64_t IdealBytes;
 
+    //
+    // Bytes of memory held for buffered requests: whole slabs, including the
+    // unused part of shared slabs, and separately allocated large requests.
+    //
+    uint64_t AllocatedBytes;
+
+    //
+    // The shared slab new small requests are coalesced into.
+    //
+    QUIC_SEND_BUFFER_SLAB* CurrentSlab;
+
 } QUIC_SEND_BUFFER;
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -41,23 +83,29 @@ QuicSendBufferUninitialize(
     _In_ QUIC_SEND_BUFFER* SendBuffer
     );
 
+//
+// Returns Size bytes to copy a buffered request into, and the slab they are
+// in (NULL if they were allocated separately).
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != NULL)
 uint8_t*
 QuicSendBufferAlloc(
     _Inout_ QUIC_SEND_BUFFER* SendBuffer,
-    _In_ uint32_t Size
+    _In_ uint32_t Size,
+    _Out_ QUIC_SEND_BUFFER_SLAB** Slab
     );
 
 //
-// Caller must pass the same size that was passed to QuicSendBufferAlloc.
+// Caller must pass the same size and slab that QuicSendBufferAlloc returned.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicSendBufferFree(
     _Inout_ QUIC_SEND_BUFFER* SendBuffer,
     _In_ uint8_t* Buf,
-    _In_ uint32_t Size
+    _In_ uint32_t Size,
+    _In_opt_ QUIC_SEND_BUFFER_SLAB* Slab
     );
 
 //
@@ -87,3 +135,7 @@ void
 QuicSendBufferConnectionAdjust(
     _In_ QUIC_CONNECTION* Connection
     );
+
+#if defined(__cplusplus)
+}
+#endif
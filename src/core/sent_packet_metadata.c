@@ -121,3 +121,165 @@ QuicSentPacketPoolReturnPacketMetadata(
     QuicSentPacketMetadataReleaseFrames(Metadata);
     CxPlatPoolFree(Pool->Pools + Metadata->FrameCount - 1, Metadata);
 }
+
+//
+// The number of slots allocated the first time a packet is added to a ring.
+//
+#define QUIC_SENT_PACKET_RING_INITIAL_CAPACITY 64
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingInitialize(
+    _Out_ QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    CxPlatZeroMemory(Ring, sizeof(*Ring));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingUninitialize(
+    _In_ QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    CXPLAT_DBG_ASSERT(Ring->PacketCount == 0);
+    if (Ring->Slots != NULL) {
+        CXPLAT_FREE(Ring->Slots, QUIC_POOL_SENT_PACKET_RING);
+        Ring->Slots = NULL;
+    }
+    Ring->Capacity = 0;
+    Ring->Count = 0;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+BOOLEAN
+QuicSentPacketRingGrow(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint32_t MinCapacity
+    )
+{
+    uint32_t NewCapacity =
+        Ring->Capacity == 0 ?
+            QUIC_SENT_PACKET_RING_INITIAL_CAPACITY : Ring->Capacity;
+    while (NewCapacity < MinCapacity) {
+        if (NewCapacity >= 0x80000000u) {
+            return FALSE;
+        }
+        NewCapacity <<= 1;
+    }
+
+    QUIC_SENT_PACKET_METADATA** NewSlots =
+        CXPLAT_ALLOC_NONPAGED(
+            NewCapacity * sizeof(QUIC_SENT_PACKET_METADATA*),
+            QUIC_POOL_SENT_PACKET_RING);
+    if (NewSlots == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Sent packet ring",
+            NewCapacity * sizeof(QUIC_SENT_PACKET_METADATA*));
+        return FALSE;
+    }
+
+    //
+    // Unwrap the existing slots so the head ends up at index zero.
+    //
+    if (Ring->Count != 0) {
+        const uint32_t FirstPart =
+            CXPLAT_MIN(Ring->Count, Ring->Capacity - Ring->Head);
+        CxPlatCopyMemory(
+            NewSlots,
+            Ring->Slots + Ring->Head,
+            FirstPart * sizeof(QUIC_SENT_PACKET_METADATA*));
+        CxPlatCopyMemory(
+            NewSlots + FirstPart,
+            Ring->Slots,
+            (Ring->Count - FirstPart) * sizeof(QUIC_SENT_PACKET_METADATA*));
+    }
+
+    if (Ring->Slots != NULL) {
+        CXPLAT_FREE(Ring->Slots, QUIC_POOL_SENT_PACKET_RING);
+    }
+    Ring->Slots = NewSlots;
+    Ring->Capacity = NewCapacity;
+    Ring->Head = 0;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketRingPush(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    )
+{
+    if (Ring->Count == 0) {
+        Ring->BasePacketNumber = Packet->PacketNumber;
+        Ring->Head = 0;
+    }
+    CXPLAT_DBG_ASSERT(Packet->PacketNumber >= QuicSentPacketRingEnd(Ring));
+
+    //
+    // Packet numbers skipped since the last push become holes.
+    //
+    const uint64_t NewCount = Packet->PacketNumber - Ring->BasePacketNumber + 1;
+    if (NewCount > Ring->Capacity) {
+        if (NewCount > UINT32_MAX ||
+            !QuicSentPacketRingGrow(Ring, (uint32_t)NewCount)) {
+            return FALSE;
+        }
+    }
+
+    const uint32_t Mask = Ring->Capacity - 1;
+    while (Ring->Count < (uint32_t)NewCount - 1) {
+        Ring->Slots[(Ring->Head + Ring->Count++) & Mask] = NULL;
+    }
+    Ring->Slots[(Ring->Head + Ring->Count++) & Mask] = Packet;
+    Ring->PacketCount++;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingRemove(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint64_t PacketNumber
+    )
+{
+    if (PacketNumber < Ring->BasePacketNumber ||
+        PacketNumber >= QuicSentPacketRingEnd(Ring)) {
+        return NULL;
+    }
+
+    const uint32_t Mask = Ring->Capacity - 1;
+    const uint32_t Index =
+        (Ring->Head + (uint32_t)(PacketNumber - Ring->BasePacketNumber)) & Mask;
+    QUIC_SENT_PACKET_METADATA* Packet = Ring->Slots[Index];
+    if (Packet == NULL) {
+        return NULL;
+    }
+    Ring->Slots[Index] = NULL;
+    Ring->PacketCount--;
+
+    if (Ring->PacketCount == 0) {
+        Ring->BasePacketNumber += Ring->Count;
+        Ring->Head = 0;
+        Ring->Count = 0;
+        return Packet;
+    }
+
+    //
+    // Trim holes from the head so it always holds the oldest packet. Holes at
+    // the tail are left alone; trimming them too would make removing the
+    // newest packets cost as much as the holes before them.
+    //
+    while (Ring->Slots[Ring->Head] == NULL) {
+        Ring->Head = (Ring->Head + 1) & Mask;
+        Ring->BasePacketNumber++;
+        Ring->Count--;
+    }
+
+    return Packet;
+}
@@ -5,6 +5,10 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 //
 // The maximum number of frames we will write to a single packet.
 //
@@ -88,6 +92,8 @@ typedef struct QUIC_SEND_PACKET_FLAGS {
     BOOLEAN IsMtuProbe              : 1;
     BOOLEAN KeyPhase                : 1;
     BOOLEAN SuspectedLost           : 1;
+    BOOLEAN EcnEctSet               : 1;
+    BOOLEAN IsAppLimited            : 1;
 #if DEBUG
     BOOLEAN Freed                   : 1;
 #endif
@@ -107,6 +113,14 @@ typedef struct QUIC_SENT_PACKET_METADATA {
     uint16_t PacketLength;
     uint8_t PathId;
 
+    //
+    // Snapshot of the connection's delivery rate state when the packet was
+    // sent (see QUIC_LOSS_DETECTION).
+    //
+    uint32_t DeliveredTime; // In microseconds
+    uint32_t FirstSentTime; // In microseconds
+    uint64_t DeliveredBytes;
+
     //
     // Hints about the QUIC packet and included frames.
     //
@@ -196,3 +210,128 @@ QuicSentPacketPoolReturnPacketMetadata(
     _In_ QUIC_SENT_PACKET_POOL* Pool,
     _In_ QUIC_SENT_PACKET_METADATA* Metadata
     );
+
+//
+// Outstanding sent packets, indexed by packet number. Since packet numbers
+// only increase, packets are always appended at the tail and the slot for
+// packet number N is at offset (N - BasePacketNumber) from Head. Removing a
+// packet leaves a NULL hole, which is trimmed as soon as it reaches the head,
+// so the head slot (if any) always holds the oldest outstanding packet.
+//
+typedef struct QUIC_SENT_PACKET_RING {
+
+    QUIC_SENT_PACKET_METADATA** Slots;
+
+    //
+    // The number of allocated slots. Always zero or a power of 2.
+    //
+    uint32_t Capacity;
+
+    //
+    // The index of the slot holding BasePacketNumber.
+    //
+    uint32_t Head;
+
+    //
+    // The number of slots (including holes) between the head and the tail.
+    //
+    uint32_t Count;
+
+    //
+    // The number of packets (non-NULL slots) in the ring.
+    //
+    uint32_t PacketCount;
+
+    //
+    // The packet number of the head slot.
+    //
+    uint64_t BasePacketNumber;
+
+} QUIC_SENT_PACKET_RING;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingInitialize(
+    _Out_ QUIC_SENT_PACKET_RING* Ring
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicSentPacketRingUninitialize(
+    _In_ QUIC_SENT_PACKET_RING* Ring
+    );
+
+//
+// Appends a packet to the ring. Its packet number must be larger than any
+// packet number previously added. Returns FALSE if the ring needed to grow
+// and the allocation failed.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicSentPacketRingPush(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ QUIC_SENT_PACKET_METADATA* Packet
+    );
+
+//
+// Removes and returns the packet with the given packet number, or NULL if it
+// isn't in the ring.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingRemove(
+    _Inout_ QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint64_t PacketNumber
+    );
+
+//
+// Returns one past the largest packet number the ring currently covers. All
+// packets in the ring have packet numbers in [BasePacketNumber, End).
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+uint64_t
+QuicSentPacketRingEnd(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    return Ring->BasePacketNumber + Ring->Count;
+}
+
+//
+// Returns the packet with the given packet number, or NULL if it isn't in the
+// ring.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingGet(
+    _In_ const QUIC_SENT_PACKET_RING* Ring,
+    _In_ uint64_t PacketNumber
+    )
+{
+    if (PacketNumber < Ring->BasePacketNumber ||
+        PacketNumber >= QuicSentPacketRingEnd(Ring)) {
+        return NULL;
+    }
+    const uint32_t Offset = (uint32_t)(PacketNumber - Ring->BasePacketNumber);
+    return Ring->Slots[(Ring->Head + Offset) & (Ring->Capacity - 1)];
+}
+
+//
+// Returns the oldest packet in the ring, or NULL if it is empty.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+QUIC_SENT_PACKET_METADATA*
+QuicSentPacketRingFirst(
+    _In_ const QUIC_SENT_PACKET_RING* Ring
+    )
+{
+    return Ring->Count == 0 ? NULL : Ring->Slots[Ring->Head];
+}
+
+#if defined(__cplusplus)
+}
+#endif
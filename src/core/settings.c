@@ -101,6 +101,36 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.VersionNegotiationExtEnabled) {
         Settings->VersionNegotiationExtEnabled = QUIC_DEFAULT_VERSION_NEGOTIATION_EXT_ENABLED;
     }
+    if (!Settings->IsSet.EcnEnabled) {
+        Settings->EcnEnabled = QUIC_DEFAULT_ECN_ENABLED;
+    }
+    if (!Settings->IsSet.L4sEnabled) {
+        Settings->L4sEnabled = QUIC_DEFAULT_L4S_ENABLED;
+    }
+    if (!Settings->IsSet.WorkerTimerSpinUs) {
+        Settings->WorkerTimerSpinUs = QUIC_DEFAULT_WORKER_TIMER_SPIN_US;
+    }
+    if (!Settings->IsSet.StreamCacheSize) {
+        Settings->StreamCacheSize = QUIC_DEFAULT_STREAM_CACHE_SIZE;
+    }
+    if (!Settings->IsSet.RecvWindowMemoryLimit) {
+        Settings->RecvWindowMemoryLimit = QUIC_DEFAULT_RECV_WINDOW_MEMORY_LIMIT;
+    }
+    if (!Settings->IsSet.CidSteeringEnabled) {
+        Settings->CidSteeringEnabled = QUIC_DEFAULT_CID_STEERING_ENABLED;
+    }
+    if (!Settings->IsSet.PacingOffloadEnabled) {
+        Settings->PacingOffloadEnabled = QUIC_DEFAULT_PACING_OFFLOAD_ENABLED;
+    }
+    if (!Settings->IsSet.DatagramSendTtlMs) {
+        Settings->DatagramSendTtlMs = QUIC_DEFAULT_DATAGRAM_SEND_TTL_MS;
+    }
+    if (!Settings->IsSet.DatagramSendQueueLimit) {
+        Settings->DatagramSendQueueLimit = QUIC_DEFAULT_DATAGRAM_SEND_QUEUE_LIMIT;
+    }
+    if (!Settings->IsSet.DatagramSendDropPolicy) {
+        Settings->DatagramSendDropPolicy = QUIC_DEFAULT_DATAGRAM_SEND_DROP_POLICY;
+    }
     if (!Settings->IsSet.MinimumMtu) {
         Settings->MinimumMtu = QUIC_DPLPMUTD_DEFAULT_MIN_MTU;
     }
@@ -212,6 +242,36 @@ QuicSettingsCopy(
     if (!Destination->IsSet.VersionNegotiationExtEnabled) {
         Destination->VersionNegotiationExtEnabled = Source->VersionNegotiationExtEnabled;
     }
+    if (!Destination->IsSet.EcnEnabled) {
+        Destination->EcnEnabled = Source->EcnEnabled;
+    }
+    if (!Destination->IsSet.L4sEnabled) {
+        Destination->L4sEnabled = Source->L4sEnabled;
+    }
+    if (!Destination->IsSet.WorkerTimerSpinUs) {
+        Destination->WorkerTimerSpinUs = Source->WorkerTimerSpinUs;
+    }
+    if (!Destination->IsSet.StreamCacheSize) {
+        Destination->StreamCacheSize = Source->StreamCacheSize;
+    }
+    if (!Destination->IsSet.RecvWindowMemoryLimit) {
+        Destination->RecvWindowMemoryLimit = Source->RecvWindowMemoryLimit;
+    }
+    if (!Destination->IsSet.CidSteeringEnabled) {
+        Destination->CidSteeringEnabled = Source->CidSteeringEnabled;
+    }
+    if (!Destination->IsSet.PacingOffloadEnabled) {
+        Destination->PacingOffloadEnabled = Source->PacingOffloadEnabled;
+    }
+    if (!Destination->IsSet.DatagramSendTtlMs) {
+        Destination->DatagramSendTtlMs = Source->DatagramSendTtlMs;
+    }
+    if (!Destination->IsSet.DatagramSendQueueLimit) {
+        Destination->DatagramSendQueueLimit = Source->DatagramSendQueueLimit;
+    }
+    if (!Destination->IsSet.DatagramSendDropPolicy) {
+        Destination->DatagramSendDropPolicy = Source->DatagramSendDropPolicy;
+    }
     if (!Destination->IsSet.MinimumMtu) {
         Destination->MinimumMtu = Source->MinimumMtu;
     }
@@ -271,7 +331,7 @@ QuicSettingApply(
         Destination->IsSet.RetryMemoryLimit = TRUE;
     }
     if (Source->IsSet.LoadBalancingMode && (!Destination->IsSet.LoadBalancingMode || OverWrite)) {
-        if (Source->LoadBalancingMode > QUIC_LOAD_BALANCING_SERVER_ID_IP) {
+        if (Source->LoadBalancingMode >= QUIC_LOAD_BALANCING_COUNT) {
             return FALSE;
         }
         Destination->LoadBalancingMode = Source->LoadBalancingMode;
@@ -488,6 +548,53 @@ QuicSettingApply(
         Destination->IsSet.CongestionControlAlgorithm = TRUE;
     }
 
+    if (Source->IsSet.EcnEnabled && (!Destination->IsSet.EcnEnabled || OverWrite)) {
+        Destination->EcnEnabled = Source->EcnEnabled;
+        Destination->IsSet.EcnEnabled = TRUE;
+    }
+    if (Source->IsSet.L4sEnabled && (!Destination->IsSet.L4sEnabled || OverWrite)) {
+        Destination->L4sEnabled = Source->L4sEnabled;
+        Destination->IsSet.L4sEnabled = TRUE;
+    }
+    if (Source->IsSet.WorkerTimerSpinUs && (!Destination->IsSet.WorkerTimerSpinUs || OverWrite)) {
+        if (Source->WorkerTimerSpinUs > QUIC_MAX_WORKER_TIMER_SPIN_US) {
+            return FALSE;
+        }
+        Destination->WorkerTimerSpinUs = Source->WorkerTimerSpinUs;
+        Destination->IsSet.WorkerTimerSpinUs = TRUE;
+    }
+    if (Source->IsSet.StreamCacheSize && (!Destination->IsSet.StreamCacheSize || OverWrite)) {
+        Destination->StreamCacheSize = Source->StreamCacheSize;
+        Destination->IsSet.StreamCacheSize = TRUE;
+    }
+    if (Source->IsSet.RecvWindowMemoryLimit && (!Destination->IsSet.RecvWindowMemoryLimit || OverWrite)) {
+        Destination->RecvWindowMemoryLimit = Source->RecvWindowMemoryLimit;
+        Destination->IsSet.RecvWindowMemoryLimit = TRUE;
+    }
+    if (Source->IsSet.CidSteeringEnabled && (!Destination->IsSet.CidSteeringEnabled || OverWrite)) {
+        Destination->CidSteeringEnabled = Source->CidSteeringEnabled;
+        Destination->IsSet.CidSteeringEnabled = TRUE;
+    }
+    if (Source->IsSet.PacingOffloadEnabled && (!Destination->IsSet.PacingOffloadEnabled || OverWrite)) {
+        Destination->PacingOffloadEnabled = Source->PacingOffloadEnabled;
+        Destination->IsSet.PacingOffloadEnabled = TRUE;
+    }
+    if (Source->IsSet.DatagramSendTtlMs && (!Destination->IsSet.DatagramSendTtlMs || OverWrite)) {
+        Destination->DatagramSendTtlMs = Source->DatagramSendTtlMs;
+        Destination->IsSet.DatagramSendTtlMs = TRUE;
+    }
+    if (Source->IsSet.DatagramSendQueueLimit && (!Destination->IsSet.DatagramSendQueueLimit || OverWrite)) {
+        Destination->DatagramSendQueueLimit = Source->DatagramSendQueueLimit;
+        Destination->IsSet.DatagramSendQueueLimit = TRUE;
+    }
+    if (Source->IsSet.DatagramSendDropPolicy && (!Destination->IsSet.DatagramSendDropPolicy || OverWrite)) {
+        if (Source->DatagramSendDropPolicy >= QUIC_DATAGRAM_DROP_POLICY_MAX) {
+            return FALSE;
+        }
+        Destination->DatagramSendDropPolicy = Source->DatagramSendDropPolicy;
+        Destination->IsSet.DatagramSendDropPolicy = TRUE;
+    }
+
     return TRUE;
 }
 
@@ -599,7 +706,7 @@ QuicSettingsLoad(
             QUIC_SETTING_LOAD_BALANCING_MODE,
             (uint8_t*)&Value,
             &ValueLen);
-        if (Value <= QUIC_LOAD_BALANCING_SERVER_ID_IP) {
+        if (Value < QUIC_LOAD_BALANCING_COUNT) {
             Settings->LoadBalancingMode = (uint16_t)Value;
         }
     }
@@ -893,6 +1000,114 @@ QuicSettingsLoad(
             Settings->CongestionControlAlgorithm = (QUIC_CONGESTION_CONTROL_ALGORITHM)Value;
         }
     }
+    if (!Settings->IsSet.EcnEnabled) {
+        Value = QUIC_DEFAULT_ECN_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ECN_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->EcnEnabled = !!Value;
+    }
+    if (!Settings->IsSet.L4sEnabled) {
+        Value = QUIC_DEFAULT_L4S_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_L4S_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->L4sEnabled = !!Value;
+    }
+    if (!Settings->IsSet.WorkerTimerSpinUs) {
+        Value = QUIC_DEFAULT_WORKER_TIMER_SPIN_US;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_WORKER_TIMER_SPIN_US,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value <= QUIC_MAX_WORKER_TIMER_SPIN_US) {
+            Settings->WorkerTimerSpinUs = (uint16_t)Value;
+        }
+    }
+    if (!Settings->IsSet.StreamCacheSize) {
+        Value = QUIC_DEFAULT_STREAM_CACHE_SIZE;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_STREAM_CACHE_SIZE,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value <= UINT16_MAX) {
+            Settings->StreamCacheSize = (uint16_t)Value;
+        }
+    }
+    if (!Settings->IsSet.RecvWindowMemoryLimit) {
+        Value = QUIC_DEFAULT_RECV_WINDOW_MEMORY_LIMIT;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_RECV_WINDOW_MEMORY_LIMIT,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value <= UINT16_MAX) {
+            Settings->RecvWindowMemoryLimit = (uint16_t)Value;
+        }
+    }
+    if (!Settings->IsSet.CidSteeringEnabled) {
+        Value = QUIC_DEFAULT_CID_STEERING_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_CID_STEERING_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->CidSteeringEnabled = !!Value;
+    }
+    if (!Settings->IsSet.PacingOffloadEnabled) {
+        Value = QUIC_DEFAULT_PACING_OFFLOAD_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_PACING_OFFLOAD_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->PacingOffloadEnabled = !!Value;
+    }
+    if (!Settings->IsSet.DatagramSendTtlMs) {
+        ValueLen = sizeof(Settings->DatagramSendTtlMs);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_DATAGRAM_SEND_TTL_MS,
+            (uint8_t*)&Settings->DatagramSendTtlMs,
+            &ValueLen);
+    }
+    if (!Settings->IsSet.DatagramSendQueueLimit) {
+        Value = QUIC_DEFAULT_DATAGRAM_SEND_QUEUE_LIMIT;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_DATAGRAM_SEND_QUEUE_LIMIT,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value <= UINT16_MAX) {
+            Settings->DatagramSendQueueLimit = (uint16_t)Value;
+        }
+    }
+    if (!Settings->IsSet.DatagramSendDropPolicy) {
+        Value = QUIC_DEFAULT_DATAGRAM_SEND_DROP_POLICY;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_DATAGRAM_SEND_DROP_POLICY,
+            (uint8_t*)&Value,
+            &ValueLen);
+        if (Value < QUIC_DATAGRAM_DROP_POLICY_MAX) {
+            Settings->DatagramSendDropPolicy = (uint8_t)Value;
+        }
+    }
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -940,6 +1155,16 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingDumpMaxBindingStatelessOper, "[sett] MaxBindingStatelessOper= %hu", Settings->MaxBindingStatelessOperations);
     QuicTraceLogVerbose(SettingDumpStatelessOperExpirMs,    "[sett] StatelessOperExpirMs   = %hu", Settings->StatelessOperationExpirationMs);
     QuicTraceLogVerbose(SettingCongestionControlAlgorithm,  "[sett] CongestionControlAlgorithm = %hu", Settings->CongestionControlAlgorithm);
+    QuicTraceLogVerbose(SettingDumpEcnEnabled,              "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
+    QuicTraceLogVerbose(SettingDumpL4sEnabled,              "[sett] L4sEnabled             = %hhu", Settings->L4sEnabled);
+    QuicTraceLogVerbose(SettingDumpWorkerTimerSpinUs,       "[sett] WorkerTimerSpinUs      = %hu", Settings->WorkerTimerSpinUs);
+    QuicTraceLogVerbose(SettingDumpStreamCacheSize,         "[sett] StreamCacheSize        = %hu", Settings->StreamCacheSize);
+    QuicTraceLogVerbose(SettingDumpRecvWindowMemoryLimit,   "[sett] RecvWindowMemoryLimit  = %hu", Settings->RecvWindowMemoryLimit);
+    QuicTraceLogVerbose(SettingDumpCidSteeringEnabled,      "[sett] CidSteeringEnabled     = %hu", Settings->CidSteeringEnabled);
+    QuicTraceLogVerbose(SettingDumpPacingOffloadEnabled,    "[sett] PacingOffloadEnabled   = %hhu", Settings->PacingOffloadEnabled);
+    QuicTraceLogVerbose(SettingDumpDatagramSendTtlMs,       "[sett] DatagramSendTtlMs      = %u", Settings->DatagramSendTtlMs);
+    QuicTraceLogVerbose(SettingDumpDatagramSendQueueLimit,  "[sett] DatagramSendQueueLimit = %hu", Settings->DatagramSendQueueLimit);
+    QuicTraceLogVerbose(SettingDumpDatagramSendDropPolicy,  "[sett] DatagramSendDropPolicy = %hhu", Settings->DatagramSendDropPolicy);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1061,6 +1286,36 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.CongestionControlAlgorithm) {
         QuicTraceLogVerbose(SettingCongestionControlAlgorithm,      "[sett] CongestionControlAlgorithm = %hu", Settings->CongestionControlAlgorithm);
     }
+    if (Settings->IsSet.EcnEnabled) {
+        QuicTraceLogVerbose(SettingDumpEcnEnabled,                  "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
+    }
+    if (Settings->IsSet.L4sEnabled) {
+        QuicTraceLogVerbose(SettingDumpL4sEnabled,                  "[sett] L4sEnabled             = %hhu", Settings->L4sEnabled);
+    }
+    if (Settings->IsSet.WorkerTimerSpinUs) {
+        QuicTraceLogVerbose(SettingDumpWorkerTimerSpinUs,           "[sett] WorkerTimerSpinUs      = %hu", Settings->WorkerTimerSpinUs);
+    }
+    if (Settings->IsSet.StreamCacheSize) {
+        QuicTraceLogVerbose(SettingDumpStreamCacheSize,             "[sett] StreamCacheSize        = %hu", Settings->StreamCacheSize);
+    }
+    if (Settings->IsSet.RecvWindowMemoryLimit) {
+        QuicTraceLogVerbose(SettingDumpRecvWindowMemoryLimit,       "[sett] RecvWindowMemoryLimit  = %hu", Settings->RecvWindowMemoryLimit);
+    }
+    if (Settings->IsSet.CidSteeringEnabled) {
+        QuicTraceLogVerbose(SettingDumpCidSteeringEnabled,          "[sett] CidSteeringEnabled     = %hu", Settings->CidSteeringEnabled);
+    }
+    if (Settings->IsSet.PacingOffloadEnabled) {
+        QuicTraceLogVerbose(SettingDumpPacingOffloadEnabled,        "[sett] PacingOffloadEnabled   = %hhu", Settings->PacingOffloadEnabled);
+    }
+    if (Settings->IsSet.DatagramSendTtlMs) {
+        QuicTraceLogVerbose(SettingDumpDatagramSendTtlMs,           "[sett] DatagramSendTtlMs      = %u", Settings->DatagramSendTtlMs);
+    }
+    if (Settings->IsSet.DatagramSendQueueLimit) {
+        QuicTraceLogVerbose(SettingDumpDatagramSendQueueLimit,      "[sett] DatagramSendQueueLimit = %hu", Settings->DatagramSendQueueLimit);
+    }
+    if (Settings->IsSet.DatagramSendDropPolicy) {
+        QuicTraceLogVerbose(SettingDumpDatagramSendDropPolicy,      "[sett] DatagramSendDropPolicy = %hhu", Settings->DatagramSendDropPolicy);
+    }
 }
 
 #define SETTINGS_SIZE_THRU_FIELD(SettingsType, Field) \
@@ -1079,6 +1334,12 @@ QuicSettingsDumpNew(
         InternalSettings->Field = Settings->Field;                                                      \
     }
 
+#define SETTING_COPY_FLAG_TO_INTERNAL_SIZED(FlagField, Flag, SettingsType, Settings, SettingsSize, InternalSettings) \
+    if (SETTING_HAS_FIELD(SettingsType, SettingsSize, FlagField)) {                                                 \
+        InternalSettings->IsSet.Flag = Settings->IsSet.Flag;                                                        \
+        InternalSettings->Flag = Settings->Flag;                                                                    \
+    }
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicSettingsGlobalSettingsToInternal(
@@ -1100,6 +1361,34 @@ QuicSettingsGlobalSettingsToInternal(
     // N.B. Anything after this needs to be size checked
     //
 
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        WorkerTimerSpinUs,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        StreamCacheSize,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        RecvWindowMemoryLimit,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        CidSteeringEnabled,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -1182,6 +1471,8 @@ QuicSettingsSettingsToInternal(
     SETTING_COPY_TO_INTERNAL(MigrationEnabled, Settings, InternalSettings);
     SETTING_COPY_TO_INTERNAL(DatagramReceiveEnabled, Settings, InternalSettings);
     SETTING_COPY_TO_INTERNAL(ServerResumptionLevel, Settings, InternalSettings);
+    SETTING_COPY_TO_INTERNAL(EcnEnabled, Settings, InternalSettings);
+    SETTING_COPY_TO_INTERNAL(L4sEnabled, Settings, InternalSettings);
 
     //
     // N.B. Anything after this needs to be size checked
@@ -1197,6 +1488,35 @@ QuicSettingsSettingsToInternal(
     //     SettingsSize,
     //     InternalSettings);
 
+    SETTING_COPY_FLAG_TO_INTERNAL_SIZED(
+        Flags,
+        PacingOffloadEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        DatagramSendTtlMs,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        DatagramSendQueueLimit,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
+    SETTING_COPY_TO_INTERNAL_SIZED(
+        DatagramSendDropPolicy,
+        QUIC_SETTINGS,
+        Settings,
+        SettingsSize,
+        InternalSettings);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -1210,6 +1530,12 @@ QuicSettingsSettingsToInternal(
         Settings->Field = InternalSettings->Field;                                                      \
     }
 
+#define SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(FlagField, Flag, SettingsType, Settings, SettingsSize, InternalSettings) \
+    if (SETTING_HAS_FIELD(SettingsType, SettingsSize, FlagField)) {                                                   \
+        Settings->IsSet.Flag = InternalSettings->IsSet.Flag;                                                          \
+        Settings->Flag = InternalSettings->Flag;                                                                      \
+    }
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicSettingsGetSettings(
@@ -1267,6 +1593,8 @@ QuicSettingsGetSettings(
     SETTING_COPY_FROM_INTERNAL(MigrationEnabled, Settings, InternalSettings);
     SETTING_COPY_FROM_INTERNAL(DatagramReceiveEnabled, Settings, InternalSettings);
     SETTING_COPY_FROM_INTERNAL(ServerResumptionLevel, Settings, InternalSettings);
+    SETTING_COPY_FROM_INTERNAL(EcnEnabled, Settings, InternalSettings);
+    SETTING_COPY_FROM_INTERNAL(L4sEnabled, Settings, InternalSettings);
 
     //
     // N.B. Anything after this needs to be size checked
@@ -1282,6 +1610,35 @@ QuicSettingsGetSettings(
     //     *SettingsLength,
     //     InternalSettings);
 
+    SETTING_COPY_FLAG_FROM_INTERNAL_SIZED(
+        Flags,
+        PacingOffloadEnabled,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        DatagramSendTtlMs,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        DatagramSendQueueLimit,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        DatagramSendDropPolicy,
+        QUIC_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
@@ -1320,6 +1677,34 @@ QuicSettingsGetGlobalSettings(
     // N.B. Anything after this needs to be size checked
     //
 
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        WorkerTimerSpinUs,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        StreamCacheSize,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        RecvWindowMemoryLimit,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
+    SETTING_COPY_FROM_INTERNAL_SIZED(
+        CidSteeringEnabled,
+        QUIC_GLOBAL_SETTINGS,
+        Settings,
+        *SettingsLength,
+        InternalSettings);
+
     *SettingsLength = CXPLAT_MIN(*SettingsLength, sizeof(QUIC_GLOBAL_SETTINGS));
 
     return QUIC_STATUS_SUCCESS;
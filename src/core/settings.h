@@ -49,7 +49,17 @@ typedef struct QUIC_SETTINGS_INTERNAL {
             uint64_t MaxBindingStatelessOperations          : 1;
             uint64_t StatelessOperationExpirationMs         : 1;
             uint64_t CongestionControlAlgorithm             : 1;
-            uint64_t RESERVED                               : 29;
+            uint64_t EcnEnabled                             : 1;
+            uint64_t L4sEnabled                             : 1;
+            uint64_t WorkerTimerSpinUs                      : 1;
+            uint64_t PacingOffloadEnabled                   : 1;
+            uint64_t StreamCacheSize                        : 1;
+            uint64_t RecvWindowMemoryLimit                  : 1;
+            uint64_t DatagramSendTtlMs                      : 1;
+            uint64_t DatagramSendQueueLimit                 : 1;
+            uint64_t DatagramSendDropPolicy                 : 1;
+            uint64_t CidSteeringEnabled                     : 1;
+            uint64_t RESERVED                               : 19;
         } IsSet;
     };
 
@@ -81,6 +91,9 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint8_t ServerResumptionLevel           : 2;    // QUIC_SERVER_RESUMPTION_LEVEL
     uint8_t VersionNegotiationExtEnabled    : 1;
     uint8_t RESERVED                        : 1;
+    uint8_t EcnEnabled                      : 1;
+    uint8_t L4sEnabled                      : 1;    // Requires EcnEnabled
+    uint8_t PacingOffloadEnabled            : 1;    // Requires PacingEnabled
     const uint32_t* DesiredVersionsList;
     uint32_t DesiredVersionsListLength;
     uint16_t MinimumMtu;
@@ -90,6 +103,13 @@ typedef struct QUIC_SETTINGS_INTERNAL {
     uint16_t MaxBindingStatelessOperations;
     uint16_t StatelessOperationExpirationMs;
     uint16_t CongestionControlAlgorithm;
+    uint16_t WorkerTimerSpinUs;             // Global only
+    uint16_t StreamCacheSize;               // Global only
+    uint16_t RecvWindowMemoryLimit;         // Global only
+    uint32_t DatagramSendTtlMs;
+    uint16_t DatagramSendQueueLimit;
+    uint8_t DatagramSendDropPolicy;         // QUIC_DATAGRAM_DROP_POLICY
+    uint16_t CidSteeringEnabled;            // Global only
 
 } QUIC_SETTINGS_INTERNAL;
 
@@ -15,6 +15,90 @@ Abstract:
 #include "stream.c.clog.h"
 #endif
 
+//
+// Takes a freed stream from the worker's cache, if there is one. It still
+// holds its receive buffer chunks and receive complete operation; nothing
+// else in it is initialized.
+//
+// Send requests are not kept with the stream: they are already allocated from
+// and returned to the worker's SendRequestPool as each send completes, so a
+// freed stream never owns any, and caching them here would only move them
+// between two per-worker caches.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STREAM*
+QuicStreamCachePop(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    QUIC_STREAM* Stream = NULL;
+    CxPlatDispatchLockAcquire(&Worker->StreamCacheLock);
+    CXPLAT_SLIST_ENTRY* Entry = CxPlatListPopEntry(&Worker->StreamCache);
+    if (Entry != NULL) {
+        Worker->StreamCacheDepth--;
+        Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, CacheLink);
+    }
+    CxPlatDispatchLockRelease(&Worker->StreamCacheLock);
+    QuicPerfCounterIncrement(
+        Stream != NULL ?
+            QUIC_PERF_COUNTER_STRM_CACHE_HIT :
+            QUIC_PERF_COUNTER_STRM_CACHE_MISS);
+    return Stream;
+}
+
+//
+// Keeps a freed stream in the worker's cache, if it has room. Only streams
+// with a chunked receive buffer from this worker's pool, small enough to still
+// use the inline chunk array and not holding app buffers, are kept.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamCachePush(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->RecvBuffer.ChunkPool != &Worker->DefaultReceiveBufferPool ||
+        Stream->RecvBuffer.Chunks != Stream->RecvBuffer.InlineChunks ||
+        Stream->RecvBuffer.AppOwned) {
+        return FALSE;
+    }
+
+    BOOLEAN Cached = FALSE;
+    CxPlatDispatchLockAcquire(&Worker->StreamCacheLock);
+    if (Worker->StreamCacheDepth < MsQuicLib.Settings.StreamCacheSize) {
+        CxPlatListPushEntry(&Worker->StreamCache, &Stream->CacheLink);
+        Worker->StreamCacheDepth++;
+        Cached = TRUE;
+    }
+    CxPlatDispatchLockRelease(&Worker->StreamCacheLock);
+    return Cached;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamCacheFlush(
+    _In_ QUIC_WORKER* Worker
+    )
+{
+    CxPlatDispatchLockAcquire(&Worker->StreamCacheLock);
+    CXPLAT_SLIST_ENTRY* Entry = Worker->StreamCache.Next;
+    Worker->StreamCache.Next = NULL;
+    Worker->StreamCacheDepth = 0;
+    CxPlatDispatchLockRelease(&Worker->StreamCacheLock);
+
+    while (Entry != NULL) {
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, CacheLink);
+        Entry = Entry->Next;
+        QuicRecvBufferUninitialize(&Stream->RecvBuffer);
+        if (Stream->ReceiveCompleteOperation) {
+            QuicOperationFree(Worker, Stream->ReceiveCompleteOperation);
+        }
+        CxPlatPoolFree(&Worker->StreamPool, Stream);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicStreamInitialize(
@@ -22,20 +106,28 @@ QuicStreamInitialize(
     _In_ BOOLEAN OpenedRemotely,
     _In_ BOOLEAN Unidirectional,
     _In_ BOOLEAN Opened0Rtt,
+    _In_ BOOLEAN AppOwnedBuffers,
     _Outptr_ _At_(*NewStream, __drv_allocatesMem(Mem))
         QUIC_STREAM** NewStream
     )
 {
     QUIC_STATUS Status;
     QUIC_STREAM* Stream;
-    uint8_t* PreallocatedRecvBuffer = NULL;
-    uint32_t InitialRecvBufferLength;
     QUIC_WORKER* Worker = Connection->Worker;
-
-    Stream = CxPlatPoolAlloc(&Worker->StreamPool);
-    if (Stream == NULL) {
-        Status = QUIC_STATUS_OUT_OF_MEMORY;
-        goto Exit;
+    QUIC_RECV_BUFFER CachedRecvBuffer;
+    QUIC_OPERATION* ReceiveCompleteOperation = NULL;
+
+    Stream = QuicStreamCachePop(Worker);
+    const BOOLEAN FromCache = Stream != NULL;
+    if (FromCache) {
+        CachedRecvBuffer = Stream->RecvBuffer;
+        ReceiveCompleteOperation = Stream->ReceiveCompleteOperation;
+    } else {
+        Stream = CxPlatPoolAlloc(&Worker->StreamPool);
+        if (Stream == NULL) {
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Exit;
+        }
     }
 
     QuicTraceEvent(
@@ -44,6 +136,7 @@ QuicStreamInitialize(
         Stream,
         Connection);
     CxPlatZeroMemory(Stream, sizeof(QUIC_STREAM));
+    Stream->ReceiveCompleteOperation = ReceiveCompleteOperation;
 
 #if DEBUG
     CxPlatDispatchLockAcquire(&Connection->Streams.AllStreamsLock);
@@ -99,22 +192,32 @@ QuicStreamInitialize(
         }
     }
 
-    InitialRecvBufferLength = Connection->Settings.StreamRecvBufferDefault;
-    if (InitialRecvBufferLength == QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE) {
-        PreallocatedRecvBuffer = CxPlatPoolAlloc(&Worker->DefaultReceiveBufferPool);
-        if (PreallocatedRecvBuffer == NULL) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Exit;
-        }
+    //
+    // A stream that will receive into app buffers only needs pooled chunks for
+    // data that arrives before the app provides them, so none are allocated up
+    // front.
+    //
+    const uint32_t RecvBufferLength =
+        AppOwnedBuffers ? 0 : Connection->Settings.StreamRecvBufferDefault;
+    if (FromCache) {
+        //
+        // Reuse the chunks the cached stream's receive buffer already has.
+        //
+        Stream->RecvBuffer = CachedRecvBuffer;
+        Status =
+            QuicRecvBufferReset(
+                &Stream->RecvBuffer,
+                RecvBufferLength,
+                Connection->Settings.StreamRecvWindowDefault);
+    } else {
+        Status =
+            QuicRecvBufferInitialize(
+                &Stream->RecvBuffer,
+                RecvBufferLength,
+                Connection->Settings.StreamRecvWindowDefault,
+                FALSE,
+                &Worker->DefaultReceiveBufferPool);
     }
-
-    Status =
-        QuicRecvBufferInitialize(
-            &Stream->RecvBuffer,
-            InitialRecvBufferLength,
-            Connection->Settings.StreamRecvWindowDefault,
-            FALSE,
-            PreallocatedRecvBuffer);
     if (QUIC_FAILED(Status)) {
         goto Exit;
     }
@@ -125,7 +228,6 @@ QuicStreamInitialize(
     Stream->Flags.Initialized = TRUE;
     *NewStream = Stream;
     Stream = NULL;
-    PreallocatedRecvBuffer = NULL;
 
 Exit:
 
@@ -137,13 +239,12 @@ Exit:
 #endif
         QuicPerfCounterDecrement(QUIC_PERF_COUNTER_STRM_ACTIVE);
         CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
+        if (Stream->ReceiveCompleteOperation) {
+            QuicOperationFree(Worker, Stream->ReceiveCompleteOperation);
+        }
         Stream->Flags.Freed = TRUE;
         CxPlatPoolFree(&Worker->StreamPool, Stream);
     }
-    if (PreallocatedRecvBuffer) {
-        CxPlatPoolFree(&Worker->DefaultReceiveBufferPool, PreallocatedRecvBuffer);
-    }
-
     return Status;
 }
 
@@ -175,23 +276,18 @@ QuicStreamFree(
 #endif
     QuicPerfCounterDecrement(QUIC_PERF_COUNTER_STRM_ACTIVE);
 
-    QuicRecvBufferUninitialize(&Stream->RecvBuffer);
     QuicRangeUninitialize(&Stream->SparseAckRanges);
     CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
     CxPlatRefUninitialize(&Stream->RefCount);
 
-    if (Stream->ReceiveCompleteOperation) {
-        QuicOperationFree(Worker, Stream->ReceiveCompleteOperation);
-    }
-
-    if (Stream->RecvBuffer.PreallocatedBuffer) {
-        CxPlatPoolFree(
-            &Worker->DefaultReceiveBufferPool,
-            Stream->RecvBuffer.PreallocatedBuffer);
-    }
-
     Stream->Flags.Freed = TRUE;
-    CxPlatPoolFree(&Worker->StreamPool, Stream);
+    if (!QuicStreamCachePush(Worker, Stream)) {
+        QuicRecvBufferUninitialize(&Stream->RecvBuffer);
+        if (Stream->ReceiveCompleteOperation) {
+            QuicOperationFree(Worker, Stream->ReceiveCompleteOperation);
+        }
+        CxPlatPoolFree(&Worker->StreamPool, Stream);
+    }
 
     if (WasStarted) {
 #pragma warning(push)
@@ -9,6 +9,10 @@
 #include "stream.h.clog.h"
 #endif
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
 typedef struct QUIC_CONNECTION QUIC_CONNECTION;
 
 //
@@ -90,9 +94,17 @@ typedef struct QUIC_SEND_REQUEST {
     uint64_t TotalLength;
 
     //
-    // Data descriptor for buffered requests.
+    // Data descriptor for buffered requests, and the send buffer slab the
+    // data is in.
     //
     QUIC_BUFFER InternalBuffer;
+    QUIC_SEND_BUFFER_SLAB* InternalSlab;
+
+    //
+    // For datagrams sent with QUIC_SEND_FLAG_DGRAM_EXPIRE, the time (in us)
+    // after which the datagram is canceled instead of sent.
+    //
+    uint64_t ExpirationTime;
 
     //
     // API Client completion context.
@@ -216,6 +228,11 @@ typedef struct QUIC_STREAM {
         // The entry in the connection's list of closed streams to clean up.
         //
         CXPLAT_LIST_ENTRY ClosedLink;
+
+        //
+        // The entry in the worker's cache of freed streams.
+        //
+        CXPLAT_SLIST_ENTRY CacheLink;
     };
 
     //
@@ -350,6 +367,12 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendPriority;
 
+    //
+    // The RFC 9218 urgency level the stream is queued at, with the extensible
+    // priority scheduling scheme.
+    //
+    uint8_t SendUrgency;
+
     //
     // Recv State
     //
@@ -496,6 +519,7 @@ QuicStreamInitialize(
     _In_ BOOLEAN OpenedRemotely,
     _In_ BOOLEAN Unidirectional,
     _In_ BOOLEAN Opened0Rtt,
+    _In_ BOOLEAN AppOwnedBuffers,
     _Outptr_ _At_(*Stream, __drv_allocatesMem(Mem))
         QUIC_STREAM** Stream
     );
@@ -509,6 +533,36 @@ QuicStreamFree(
     _In_ __drv_freesMem(Mem) QUIC_STREAM* Stream
     );
 
+//
+// Takes a freed stream from the worker's stream cache, or returns NULL if it
+// is empty. Counts a cache hit or miss.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STREAM*
+QuicStreamCachePop(
+    _In_ QUIC_WORKER* Worker
+    );
+
+//
+// Keeps a freed stream in the worker's stream cache. Returns FALSE if the
+// stream can't be cached or the cache is already at the StreamCacheSize limit.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamCachePush(
+    _In_ QUIC_WORKER* Worker,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Frees all the streams in the worker's stream cache.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamCacheFlush(
+    _In_ QUIC_WORKER* Worker
+    );
+
 //
 // Associates a new ID with the stream and inserts it into the connection's
 // table.
@@ -883,6 +937,19 @@ QuicStreamRecvFlush(
     _In_ QUIC_STREAM* Stream
     );
 
+//
+// Adds application owned buffers for receiving stream data, switching the
+// stream to app-owned receive buffers on the first call.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamProvideRecvBuffers(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* Buffers
+    );
+
 //
 // Enables or disables receive callbacks for the stream.
 //
@@ -892,3 +959,7 @@ QuicStreamRecvSetEnabledState(
     _In_ QUIC_STREAM* Stream,
     _In_ BOOLEAN NewRecvEnabled
     );
+
+#if defined(__cplusplus)
+}
+#endif
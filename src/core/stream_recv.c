@@ -644,21 +644,36 @@ QuicStreamOnBytesDelivered(
     _In_ uint64_t BytesDelivered
     )
 {
+    if (Stream->RecvBuffer.AppOwned) {
+        //
+        // The stream window ends with the app's buffers, so it only moves when
+        // more are provided (QuicStreamProvideRecvBuffers). The connection
+        // window still moves with the delivered bytes.
+        //
+        QuicConnOnBytesDelivered(Stream->Connection, BytesDelivered);
+        QuicSendSetSendFlag(
+            &Stream->Connection->Send,
+            QUIC_CONN_SEND_FLAG_MAX_DATA);
+        return;
+    }
+
     const uint64_t RecvBufferDrainThreshold =
         Stream->RecvBuffer.VirtualBufferLength / QUIC_RECV_BUFFER_DRAIN_RATIO;
 
     Stream->RecvWindowBytesDelivered += BytesDelivered;
-    Stream->Connection->Send.MaxData += BytesDelivered;
+    const BOOLEAN ConnWindowGrew =
+        QuicConnOnBytesDelivered(Stream->Connection, BytesDelivered);
 
     if (Stream->RecvWindowBytesDelivered >= RecvBufferDrainThreshold) {
 
         uint32_t TimeNow = CxPlatTimeUs32();
 
         //
-        // Limit stream FC window growth by the connection FC window size.
+        // Limit stream FC window growth by the (auto-tuned) connection FC
+        // window size.
         //
         if (Stream->RecvBuffer.VirtualBufferLength <
-            Stream->Connection->Settings.ConnFlowControlWindow) {
+            Stream->Connection->Send.RecvWindow) {
 
             uint32_t TimeThreshold = (uint32_t)
                 ((Stream->RecvWindowBytesDelivered * Stream->Connection->Paths[0].SmoothedRtt) / RecvBufferDrainThreshold);
@@ -695,6 +710,12 @@ QuicStreamOnBytesDelivered(
                 QuicRecvBufferSetVirtualBufferLength(
                     &Stream->RecvBuffer,
                     Stream->RecvBuffer.VirtualBufferLength * 2);
+
+                QUIC_CONN_STATS* Stats = &Stream->Connection->Stats;
+                Stats->Recv.WindowAutoTuneCount++;
+                if (Stats->Recv.MaxStreamWindow < Stream->RecvBuffer.VirtualBufferLength) {
+                    Stats->Recv.MaxStreamWindow = Stream->RecvBuffer.VirtualBufferLength;
+                }
             }
         }
 
@@ -705,8 +726,13 @@ QuicStreamOnBytesDelivered(
         //
         // We haven't hit the drain limit AND we don't have any ACKs to send
         // immediately, so we don't need to immediately update the max data
-        // values.
+        // values, unless the connection window just grew.
         //
+        if (ConnWindowGrew) {
+            QuicSendSetSendFlag(
+                &Stream->Connection->Send,
+                QUIC_CONN_SEND_FLAG_MAX_DATA);
+        }
         return;
     }
 
@@ -758,10 +784,10 @@ QuicStreamRecvFlush(
     while (FlushRecv) {
         CXPLAT_DBG_ASSERT(!Stream->Flags.SentStopSending);
 
-        QUIC_BUFFER RecvBuffers[2];
+        QUIC_BUFFER RecvBuffers[QUIC_MAX_RECEIVE_BUFFER_COUNT];
         QUIC_STREAM_EVENT Event = {0};
         Event.Type = QUIC_STREAM_EVENT_RECEIVE;
-        Event.RECEIVE.BufferCount = 2;
+        Event.RECEIVE.BufferCount = ARRAYSIZE(RecvBuffers);
         Event.RECEIVE.Buffers = RecvBuffers;
 
         //
@@ -1012,6 +1038,55 @@ QuicStreamReceiveComplete(
     return FALSE;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicStreamProvideRecvBuffers(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount)
+        const QUIC_BUFFER* Buffers
+    )
+{
+    QUIC_STATUS Status;
+
+    if (Stream->Flags.RemoteNotAllowed) {
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
+    //
+    // Anything already received, or still allowed by the window the peer was
+    // given before these buffers, stays in internal buffers ahead of them.
+    //
+    Status = QuicRecvBufferProvideChunks(&Stream->RecvBuffer, BufferCount, Buffers);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    const uint64_t NewMaxAllowedRecvOffset =
+        Stream->RecvBuffer.BaseOffset + Stream->RecvBuffer.VirtualBufferLength;
+
+    QuicTraceLogStreamVerbose(
+        ProvideRecvBuffers,
+        Stream,
+        "App provided %u receive buffers, window end %llu",
+        BufferCount,
+        NewMaxAllowedRecvOffset);
+
+    if (NewMaxAllowedRecvOffset > Stream->MaxAllowedRecvOffset) {
+        //
+        // The new buffers extend past the window already given to the peer.
+        //
+        Stream->MaxAllowedRecvOffset = NewMaxAllowedRecvOffset;
+        QuicSendSetStreamSendFlag(
+            &Stream->Connection->Send,
+            Stream,
+            QUIC_STREAM_SEND_FLAG_MAX_DATA,
+            FALSE);
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamRecvSetEnabledState(
@@ -403,7 +403,8 @@ QuicStreamCompleteSendRequest(
         QuicSendBufferFree(
             &Connection->SendBuffer,
             SendRequest->InternalBuffer.Buffer,
-            SendRequest->InternalBuffer.Length);
+            SendRequest->InternalBuffer.Length,
+            SendRequest->InternalSlab);
     }
 
     if (PreviouslyPosted) {
@@ -436,7 +437,8 @@ QuicStreamSendBufferRequest(
         uint8_t* Buf =
             QuicSendBufferAlloc(
                 &Connection->SendBuffer,
-                (uint32_t)Req->TotalLength);
+                (uint32_t)Req->TotalLength,
+                &Req->InternalSlab);
         if (Buf == NULL) {
             return QUIC_STATUS_OUT_OF_MEMORY;
         }
@@ -449,6 +451,7 @@ QuicStreamSendBufferRequest(
         Req->InternalBuffer.Buffer = Buf;
     } else {
         Req->InternalBuffer.Buffer = NULL;
+        Req->InternalSlab = NULL;
     }
     Req->BufferCount = 1;
     Req->Buffers = &Req->InternalBuffer;
@@ -9,6 +9,13 @@ Abstract:
     keeps track of locally and remotely initiated streams, and synchronizes max
     stream IDs with the peer.
 
+    Stream IDs of each type are handed out in order, so the open streams of a
+    type are mostly found in a small range of IDs. Each type keeps a window
+    array over that range, indexed directly by (ID >> 2), which makes looking
+    up the stream for a received frame a bounds check and a load. The window
+    grows while it's dense and slides forward when it's sparse; any stream it
+    slides past (e.g. a long lived control stream) moves to a hash table.
+
 --*/
 
 #include "precomp.h"
@@ -23,20 +30,17 @@ QuicStreamSetValidate(
     _In_ QUIC_STREAM_SET* StreamSet
     )
 {
-    if (StreamSet->StreamTable == NULL) {
-        return; // No streams have been created.
-    }
     QUIC_CONNECTION* Connection = QuicStreamSetGetConnection(StreamSet);
-    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-    CXPLAT_HASHTABLE_ENTRY* Entry;
-    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-        const QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
         CXPLAT_DBG_ASSERT(Stream->Type == QUIC_HANDLE_TYPE_STREAM);
         CXPLAT_DBG_ASSERT(Stream->Connection == Connection);
-        UNREFERENCED_PARAMETER(Stream);
+        CXPLAT_DBG_ASSERT(QuicStreamSetLookupStream(StreamSet, Stream->ID) == Stream);
+        UNREFERENCED_PARAMETER(Connection);
     }
-    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 #else
 #define QuicStreamSetValidate(StreamSet)
@@ -61,6 +65,11 @@ QuicStreamSetUninitialize(
     _Inout_ QUIC_STREAM_SET* StreamSet
     )
 {
+    for (uint32_t i = 0; i < NUMBER_OF_STREAM_TYPES; ++i) {
+        if (StreamSet->Types[i].Window.Slots != NULL) {
+            CXPLAT_FREE(StreamSet->Types[i].Window.Slots, QUIC_POOL_STREAM_WINDOW);
+        }
+    }
     if (StreamSet->StreamTable != NULL) {
         CxPlatHashtableUninitialize(StreamSet->StreamTable);
     }
@@ -75,24 +84,22 @@ QuicStreamSetTraceRundown(
     _In_ QUIC_STREAM_SET* StreamSet
     )
 {
-    if (StreamSet->StreamTable == NULL) {
-        return; // No streams have been created yet.
-    }
-
-    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-    CXPLAT_HASHTABLE_ENTRY* Entry;
-    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-        QuicStreamTraceRundown(
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry));
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
+        QuicStreamTraceRundown(Stream);
     }
-    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 
+//
+// Inserts the stream into the hash table of streams outside their window.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Success_(return != FALSE)
 BOOLEAN
-QuicStreamSetInsertStream(
+QuicStreamSetInsertTableStream(
     _Inout_ QUIC_STREAM_SET* StreamSet,
     _In_ QUIC_STREAM* Stream
     )
@@ -118,6 +125,151 @@ QuicStreamSetInsertStream(
     return TRUE;
 }
 
+//
+// Doubles the size of the window. Returns FALSE if the window is already at
+// its maximum size or the allocation fails.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamWindowGrow(
+    _Inout_ QUIC_STREAM_WINDOW* Window
+    )
+{
+    if (Window->Capacity >= QUIC_STREAM_WINDOW_MAX_SIZE) {
+        return FALSE;
+    }
+
+    const uint32_t NewCapacity = Window->Capacity * 2;
+    QUIC_STREAM** NewSlots =
+        CXPLAT_ALLOC_NONPAGED(NewCapacity * sizeof(QUIC_STREAM*), QUIC_POOL_STREAM_WINDOW);
+    if (NewSlots == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "streamset window",
+            NewCapacity * sizeof(QUIC_STREAM*));
+        return FALSE;
+    }
+
+    CxPlatZeroMemory(NewSlots, NewCapacity * sizeof(QUIC_STREAM*));
+    for (uint64_t i = Window->BaseIndex; i < Window->BaseIndex + Window->Capacity; ++i) {
+        NewSlots[i & (NewCapacity - 1)] = Window->Slots[i & (Window->Capacity - 1)];
+    }
+
+    CXPLAT_FREE(Window->Slots, QUIC_POOL_STREAM_WINDOW);
+    Window->Slots = NewSlots;
+    Window->Capacity = NewCapacity;
+
+    return TRUE;
+}
+
+//
+// Moves the window's base past any closed streams.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamWindowTrim(
+    _Inout_ QUIC_STREAM_WINDOW* Window
+    )
+{
+    while (Window->Count != 0 &&
+           Window->Slots[Window->BaseIndex & (Window->Capacity - 1)] == NULL) {
+        Window->BaseIndex++;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicStreamSetInsertStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_STREAM_WINDOW* Window = &StreamSet->Types[Stream->ID & STREAM_ID_MASK].Window;
+    const uint64_t Index = Stream->ID >> 2;
+
+    if (Window->Slots == NULL) {
+        //
+        // Lazily initialize the window. If that fails, the hash table will do.
+        //
+        Window->Slots =
+            CXPLAT_ALLOC_NONPAGED(
+                QUIC_STREAM_WINDOW_INITIAL_SIZE * sizeof(QUIC_STREAM*),
+                QUIC_POOL_STREAM_WINDOW);
+        if (Window->Slots == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "streamset window",
+                QUIC_STREAM_WINDOW_INITIAL_SIZE * sizeof(QUIC_STREAM*));
+            return QuicStreamSetInsertTableStream(StreamSet, Stream);
+        }
+        CxPlatZeroMemory(
+            Window->Slots, QUIC_STREAM_WINDOW_INITIAL_SIZE * sizeof(QUIC_STREAM*));
+        Window->Capacity = QUIC_STREAM_WINDOW_INITIAL_SIZE;
+    }
+
+    if (Window->Count == 0) {
+        Window->BaseIndex = Index;
+
+    } else if (Index < Window->BaseIndex) {
+        return QuicStreamSetInsertTableStream(StreamSet, Stream);
+    }
+
+    while (Index - Window->BaseIndex >= Window->Capacity) {
+        //
+        // The stream is past the end of the window. Grow the window if it's
+        // at least half full. Otherwise, the open streams are sparse, so slide
+        // the window forward instead, moving the oldest stream to the hash
+        // table.
+        //
+        if (Window->Count >= Window->Capacity / 2 && QuicStreamWindowGrow(Window)) {
+            continue;
+        }
+
+        QUIC_STREAM** Slot = &Window->Slots[Window->BaseIndex & (Window->Capacity - 1)];
+        CXPLAT_DBG_ASSERT(*Slot != NULL);
+        if (!QuicStreamSetInsertTableStream(StreamSet, *Slot)) {
+            return FALSE;
+        }
+        *Slot = NULL;
+        Window->Count--;
+        Window->BaseIndex++;
+        QuicStreamWindowTrim(Window);
+
+        if (Window->Count == 0) {
+            Window->BaseIndex = Index;
+        }
+    }
+
+    Window->Slots[Index & (Window->Capacity - 1)] = Stream;
+    Window->Count++;
+
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetRemoveStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    QUIC_STREAM_WINDOW* Window = &StreamSet->Types[Stream->ID & STREAM_ID_MASK].Window;
+    const uint64_t Index = Stream->ID >> 2;
+
+    if (Index - Window->BaseIndex < Window->Capacity &&
+        Window->Slots[Index & (Window->Capacity - 1)] == Stream) {
+        Window->Slots[Index & (Window->Capacity - 1)] = NULL;
+        Window->Count--;
+        QuicStreamWindowTrim(Window);
+
+    } else {
+        CxPlatHashtableRemove(StreamSet->StreamTable, &Stream->TableEntry, NULL);
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Ret_maybenull_
 QUIC_STREAM*
@@ -126,8 +278,19 @@ QuicStreamSetLookupStream(
     _In_ uint64_t ID
     )
 {
+    const QUIC_STREAM_WINDOW* Window = &StreamSet->Types[ID & STREAM_ID_MASK].Window;
+    const uint64_t Index = ID >> 2;
+
+    if (Index - Window->BaseIndex < Window->Capacity) {
+        QUIC_STREAM* Stream = Window->Slots[Index & (Window->Capacity - 1)];
+        if (Stream != NULL) {
+            CXPLAT_DBG_ASSERT(Stream->ID == ID);
+            return Stream;
+        }
+    }
+
     if (StreamSet->StreamTable == NULL) {
-        return NULL; // No streams have been created yet.
+        return NULL; // No streams outside the windows.
     }
 
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
@@ -144,22 +307,81 @@ QuicStreamSetLookupStream(
     return NULL;
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
+_IRQL_requires_max_(DISPATCH_LEVEL)
 void
-QuicStreamSetShutdown(
-    _Inout_ QUIC_STREAM_SET* StreamSet
+QuicStreamSetEnumerateBegin(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Out_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    )
+{
+    Enumerator->Type = 0;
+    Enumerator->Index = StreamSet->Types[0].Window.BaseIndex;
+    Enumerator->InTable = FALSE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_STREAM*
+QuicStreamSetEnumerateNext(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
     )
 {
+    //
+    // First walk each type's window, then the hash table.
+    //
+    while (Enumerator->Type < NUMBER_OF_STREAM_TYPES) {
+        const QUIC_STREAM_WINDOW* Window = &StreamSet->Types[Enumerator->Type].Window;
+        if (Enumerator->Index < Window->BaseIndex) {
+            Enumerator->Index = Window->BaseIndex; // Streams were released.
+        }
+        while (Enumerator->Index - Window->BaseIndex < Window->Capacity) {
+            QUIC_STREAM* Stream =
+                Window->Slots[Enumerator->Index++ & (Window->Capacity - 1)];
+            if (Stream != NULL) {
+                return Stream;
+            }
+        }
+        Enumerator->Type++;
+        Enumerator->Index = 0;
+    }
+
     if (StreamSet->StreamTable == NULL) {
-        return; // No streams have been created.
+        return NULL;
     }
 
-    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-    CXPLAT_HASHTABLE_ENTRY* Entry;
-    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-        QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+    if (!Enumerator->InTable) {
+        CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator->TableEnumerator);
+        Enumerator->InTable = TRUE;
+    }
 
+    CXPLAT_HASHTABLE_ENTRY* Entry =
+        CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator->TableEnumerator);
+    return Entry == NULL ? NULL : CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateEnd(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    )
+{
+    if (Enumerator->InTable) {
+        CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator->TableEnumerator);
+        Enumerator->InTable = FALSE;
+    }
+}
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicStreamSetShutdown(
+    _Inout_ QUIC_STREAM_SET* StreamSet
+    )
+{
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
         QuicStreamShutdown(
             Stream,
             QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND |
@@ -167,7 +389,7 @@ QuicStreamSetShutdown(
             QUIC_STREAM_SHUTDOWN_SILENT,
             0);
     }
-    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -180,7 +402,7 @@ QuicStreamSetReleaseStream(
     //
     // Remove the stream from the list of open streams.
     //
-    CxPlatHashtableRemove(StreamSet->StreamTable, &Stream->TableEntry, NULL);
+    QuicStreamSetRemoveStream(StreamSet, Stream);
     CxPlatListInsertTail(&StreamSet->ClosedStreams, &Stream->ClosedLink);
 
     uint8_t Flags = (uint8_t)(Stream->ID & STREAM_ID_MASK);
@@ -298,46 +520,43 @@ QuicStreamSetInitializeTransportParameters(
         UpdateAvailableStreams = TRUE;
     }
 
-    if (StreamSet->StreamTable != NULL) {
-        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-        CXPLAT_HASHTABLE_ENTRY* Entry;
-        CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-        while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
-            uint8_t FlowBlockedFlagsToRemove = 0;
-
-            uint64_t StreamType = Stream->ID & STREAM_ID_MASK;
-            uint64_t StreamCount = (Stream->ID >> 2) + 1;
-            const QUIC_STREAM_TYPE_INFO* Info =
-                &Stream->Connection->Streams.Types[StreamType];
-            if (Info->MaxTotalStreamCount >= StreamCount &&
-                Stream->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL) {
-                FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL;
-                QuicStreamIndicatePeerAccepted(Stream);
-            }
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
 
-            uint64_t NewMaxAllowedSendOffset =
-                QuicStreamGetInitialMaxDataFromTP(
-                    Stream->ID,
-                    QuicConnIsServer(Connection),
-                    &Connection->PeerTransportParams);
+        uint8_t FlowBlockedFlagsToRemove = 0;
 
-            if (Stream->MaxAllowedSendOffset < NewMaxAllowedSendOffset) {
-                Stream->MaxAllowedSendOffset = NewMaxAllowedSendOffset;
-                FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL;
-                Stream->SendWindow = (uint32_t)CXPLAT_MIN(Stream->MaxAllowedSendOffset, UINT32_MAX);
-            }
+        uint64_t StreamType = Stream->ID & STREAM_ID_MASK;
+        uint64_t StreamCount = (Stream->ID >> 2) + 1;
+        const QUIC_STREAM_TYPE_INFO* Info =
+            &Stream->Connection->Streams.Types[StreamType];
+        if (Info->MaxTotalStreamCount >= StreamCount &&
+            Stream->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL) {
+            FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL;
+            QuicStreamIndicatePeerAccepted(Stream);
+        }
 
-            if (FlowBlockedFlagsToRemove) {
-                QuicStreamRemoveOutFlowBlockedReason(
-                    Stream, FlowBlockedFlagsToRemove);
-                QuicStreamSendDumpState(Stream);
-                MightBeUnblocked = TRUE;
-            }
+        uint64_t NewMaxAllowedSendOffset =
+            QuicStreamGetInitialMaxDataFromTP(
+                Stream->ID,
+                QuicConnIsServer(Connection),
+                &Connection->PeerTransportParams);
+
+        if (Stream->MaxAllowedSendOffset < NewMaxAllowedSendOffset) {
+            Stream->MaxAllowedSendOffset = NewMaxAllowedSendOffset;
+            FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL;
+            Stream->SendWindow = (uint32_t)CXPLAT_MIN(Stream->MaxAllowedSendOffset, UINT32_MAX);
+        }
+
+        if (FlowBlockedFlagsToRemove) {
+            QuicStreamRemoveOutFlowBlockedReason(
+                Stream, FlowBlockedFlagsToRemove);
+            QuicStreamSendDumpState(Stream);
+            MightBeUnblocked = TRUE;
         }
-        CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
     }
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 
     if (UpdateAvailableStreams) {
         QuicStreamSetIndicateStreamsAvailable(StreamSet);
@@ -391,27 +610,23 @@ QuicStreamSetUpdateMaxStreams(
             MaxStreams);
 
         BOOLEAN FlushSend = FALSE;
-        if (StreamSet->StreamTable != NULL) {
-
-            CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-            CXPLAT_HASHTABLE_ENTRY* Entry;
-            CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-            while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-                QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
-                uint64_t Count = (Stream->ID >> 2) + 1;
-
-                if ((Stream->ID & STREAM_ID_MASK) == Mask &&
-                    Count > Info->MaxTotalStreamCount &&
-                    Count <= MaxStreams &&
-                    QuicStreamRemoveOutFlowBlockedReason(
-                        Stream, QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL)) {
-                    QuicStreamIndicatePeerAccepted(Stream);
-                    FlushSend = TRUE;
-                }
+        QUIC_STREAM_SET_ENUMERATOR Enumerator;
+        QUIC_STREAM* Stream;
+        QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+        while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
+
+            uint64_t Count = (Stream->ID >> 2) + 1;
+
+            if ((Stream->ID & STREAM_ID_MASK) == Mask &&
+                Count > Info->MaxTotalStreamCount &&
+                Count <= MaxStreams &&
+                QuicStreamRemoveOutFlowBlockedReason(
+                    Stream, QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL)) {
+                QuicStreamIndicatePeerAccepted(Stream);
+                FlushSend = TRUE;
             }
-            CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
         }
+        QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 
         Info->MaxTotalStreamCount = MaxStreams;
 
@@ -487,27 +702,24 @@ QuicStreamSetGetFlowControlSummary(
     *FcAvailable = 0;
     *SendWindow = 0;
 
-    if (StreamSet->StreamTable != NULL) {
-        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-        CXPLAT_HASHTABLE_ENTRY* Entry;
-        CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-        while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
-            if ((UINT64_MAX - *FcAvailable) >= (Stream->MaxAllowedSendOffset - Stream->NextSendOffset)) {
-                *FcAvailable += Stream->MaxAllowedSendOffset - Stream->NextSendOffset;
-            } else {
-                *FcAvailable = UINT64_MAX;
-            }
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
 
-            if ((UINT64_MAX - *SendWindow) >= Stream->SendWindow) {
-                *SendWindow += Stream->SendWindow;
-            } else {
-                *SendWindow = UINT64_MAX;
-            }
+        if ((UINT64_MAX - *FcAvailable) >= (Stream->MaxAllowedSendOffset - Stream->NextSendOffset)) {
+            *FcAvailable += Stream->MaxAllowedSendOffset - Stream->NextSendOffset;
+        } else {
+            *FcAvailable = UINT64_MAX;
+        }
+
+        if ((UINT64_MAX - *SendWindow) >= Stream->SendWindow) {
+            *SendWindow += Stream->SendWindow;
+        } else {
+            *SendWindow = UINT64_MAX;
         }
-        CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
     }
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -641,6 +853,7 @@ QuicStreamSetGetStreamForPeer(
                     TRUE,
                     STREAM_ID_IS_UNI_DIR(StreamId), // Unidirectional
                     FrameIn0Rtt,                    // Opened0Rtt
+                    FALSE,                          // AppOwnedBuffers
                     &Stream);
             if (QUIC_FAILED(Status)) {
                 *FatalError = TRUE;
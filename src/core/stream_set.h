@@ -5,6 +5,28 @@
 
 --*/
 
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//
+// A sliding window of streams of one type, indexed by (ID >> 2). Slots hold
+// the streams from BaseIndex to BaseIndex + Capacity - 1, at (ID >> 2) modulo
+// Capacity; closed or unopened streams have NULL slots.
+//
+typedef struct QUIC_STREAM_WINDOW {
+
+    QUIC_STREAM** Slots;
+    uint64_t BaseIndex;
+    uint32_t Capacity;
+
+    //
+    // The number of non-NULL slots.
+    //
+    uint32_t Count;
+
+} QUIC_STREAM_WINDOW;
+
 //
 // Info for a particular type of stream (client/server;bidir/unidir)
 //
@@ -32,6 +54,11 @@ typedef struct QUIC_STREAM_TYPE_INFO {
     //
     uint16_t CurrentStreamCount;
 
+    //
+    // The open streams of this type, for direct look up.
+    //
+    QUIC_STREAM_WINDOW Window;
+
 } QUIC_STREAM_TYPE_INFO;
 
 typedef struct QUIC_STREAM_SET {
@@ -42,7 +69,7 @@ typedef struct QUIC_STREAM_SET {
     QUIC_STREAM_TYPE_INFO Types[NUMBER_OF_STREAM_TYPES];
 
     //
-    // The hash table of all active streams.
+    // The hash table of active streams that aren't in their type's window.
     //
     CXPLAT_HASHTABLE* StreamTable;
 
@@ -61,6 +88,19 @@ typedef struct QUIC_STREAM_SET {
 
 } QUIC_STREAM_SET;
 
+//
+// State for enumerating all the active streams of a stream set. Streams may be
+// released while being enumerated, but not inserted.
+//
+typedef struct QUIC_STREAM_SET_ENUMERATOR {
+
+    uint8_t Type;
+    uint64_t Index;
+    BOOLEAN InTable;
+    CXPLAT_HASHTABLE_ENUMERATOR TableEnumerator;
+
+} QUIC_STREAM_SET_ENUMERATOR;
+
 //
 // Initializes the stream set.
 //
@@ -79,6 +119,63 @@ QuicStreamSetUninitialize(
     _Inout_ QUIC_STREAM_SET* StreamSet
     );
 
+//
+// Adds a stream to the set of active streams, by its ID.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicStreamSetInsertStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Removes a stream from the set of active streams.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetRemoveStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Finds an active stream by its ID.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_STREAM*
+QuicStreamSetLookupStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ uint64_t ID
+    );
+
+//
+// Enumerates all the active streams.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateBegin(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Out_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_STREAM*
+QuicStreamSetEnumerateNext(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateEnd(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    );
+
 //
 // Tracing rundown for the stream set.
 //
@@ -211,3 +308,7 @@ QuicStreamSetGetMaxStreamIDs(
     _Out_writes_all_(NUMBER_OF_STREAM_TYPES)
         uint64_t* MaxStreamIds
     );
+
+#if defined(__cplusplus)
+}
+#endif
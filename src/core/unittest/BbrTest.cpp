@@ -0,0 +1,421 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the BBR congestion control algorithm: the windowed max
+    bandwidth filter, the state machine, the loss driven model bounds and the
+    pacing limited send allowance.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "BbrTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+//
+// g++ doesn't support the anonymous QUIC_HANDLE member that starts
+// QUIC_CONNECTION, so C++ code sees the other connection fields at a different
+// offset than the core does. The connection is laid out the core's way, and
+// its fields are accessed through Conn.
+//
+const size_t BbrConnHandleSize =
+    offsetof(QUIC_CONNECTION, RegistrationLink) == 0 ? sizeof(QUIC_HANDLE) : 0;
+
+const uint32_t TestRtt = MS_TO_US(50);
+const uint64_t TestBandwidth = 1250000; // bytes per second (10 Mbps)
+const uint32_t TestAckBytes = 1200;
+
+//
+// A zeroed connection with just enough state for the congestion controller,
+// and helpers to feed it ACKs that each complete a round trip.
+//
+struct SmartBbr {
+    std::vector<uint64_t> Memory;
+    QUIC_CONNECTION* Conn;
+    QUIC_CONGESTION_CONTROL* Cc;
+    QUIC_CONGESTION_CONTROL_BBR* Bbr;
+    uint64_t Delivered {0};
+    uint64_t TimeNow;
+
+    SmartBbr(bool Pacing = false) :
+        Memory((sizeof(QUIC_CONNECTION) + BbrConnHandleSize + 7) / 8) {
+        Conn = (QUIC_CONNECTION*)((uint8_t*)Memory.data() + BbrConnHandleSize);
+        QuicAddrSetFamily(&Conn->Paths[0].Route.RemoteAddress, QUIC_ADDRESS_FAMILY_INET);
+        Conn->Paths[0].Mtu = QUIC_DPLPMUTD_MIN_MTU;
+        Conn->Paths[0].SmoothedRtt = TestRtt;
+        Conn->Paths[0].GotFirstRttSample = TRUE;
+        Conn->Settings.PacingEnabled = Pacing;
+        Conn->SendBuffer.IdealBytes = QUIC_MAX_IDEAL_SEND_BUFFER_SIZE;
+
+        QUIC_SETTINGS_INTERNAL Settings;
+        CxPlatZeroMemory(&Settings, sizeof(Settings));
+        Settings.InitialWindowPackets = 10;
+        Settings.CongestionControlAlgorithm = QUIC_CONGESTION_CONTROL_ALGORITHM_BBR;
+
+        Cc = &Conn->CongestionControl;
+        Bbr = &Cc->Bbr;
+        BbrCongestionControlInitialize(Cc, &Settings);
+        TimeNow = CxPlatTimeUs64();
+    }
+
+    uint16_t DatagramSize() const {
+        return QuicPathGetDatagramPayloadSize(&Conn->Paths[0]);
+    }
+
+    void Send(uint32_t Bytes) {
+        Cc->QuicCongestionControlOnDataSent(Cc, Bytes);
+    }
+
+    //
+    // Acknowledges Bytes sent after the last ACK, so every call starts a new
+    // round.
+    //
+    BOOLEAN Ack(
+        uint32_t Bytes = TestAckBytes,
+        uint64_t Rate = TestBandwidth,
+        uint32_t Rtt = TestRtt,
+        uint64_t Elapsed = TestRtt
+        ) {
+        TimeNow += Elapsed;
+        QUIC_ACK_EVENT AckEvent;
+        CxPlatZeroMemory(&AckEvent, sizeof(AckEvent));
+        AckEvent.TimeNow = TimeNow;
+        AckEvent.NumRetransmittableBytes = Bytes;
+        AckEvent.SmoothedRtt = Rtt;
+        AckEvent.LatestRtt = Rtt;
+        AckEvent.PriorDeliveredBytes = Delivered;
+        AckEvent.IsPriorDeliveredValid = TRUE;
+        Delivered += Bytes;
+        AckEvent.DeliveredBytes = Delivered;
+        AckEvent.DeliveryRate = Rate;
+        AckEvent.DeliveryInterval = Rtt;
+        return Cc->QuicCongestionControlOnDataAcknowledged(Cc, &AckEvent);
+    }
+
+    void Lose(uint32_t Bytes) {
+        QUIC_LOSS_EVENT LossEvent;
+        CxPlatZeroMemory(&LossEvent, sizeof(LossEvent));
+        LossEvent.NumRetransmittableBytes = Bytes;
+        Cc->QuicCongestionControlOnDataLost(Cc, &LossEvent);
+    }
+
+    void Ecn(uint64_t EctPackets, uint64_t CePackets) {
+        QUIC_ECN_EVENT EcnEvent;
+        CxPlatZeroMemory(&EcnEvent, sizeof(EcnEvent));
+        EcnEvent.NumEctPackets = EctPackets;
+        EcnEvent.NumCePackets = CePackets;
+        Cc->QuicCongestionControlOnEcn(Cc, &EcnEvent);
+    }
+
+    //
+    // Acks rounds at a constant rate until STARTUP finds the pipe full, and
+    // then drains into PROBE_BW.
+    //
+    void RunToProbeBw() {
+        Send(100 * TestAckBytes);
+        for (uint32_t i = 0; i < 10 && Bbr->State == BBR_STATE_STARTUP; ++i) {
+            Ack();
+        }
+        ASSERT_EQ(BBR_STATE_DRAIN, Bbr->State);
+        Cc->QuicCongestionControlOnDataInvalidated(Cc, Bbr->BytesInFlight - TestAckBytes);
+        Ack();
+        ASSERT_EQ(BBR_STATE_PROBE_BW, Bbr->State);
+    }
+
+    uint32_t Bdp() const {
+        return (uint32_t)(TestBandwidth * TestRtt / S_TO_US(1));
+    }
+};
+
+TEST(BbrTest, MaxFilter)
+{
+    const uint64_t Window = 2;
+    BBR_MAX_FILTER Filter;
+    BbrMaxFilterReset(&Filter, 0, 100);
+
+    //
+    // Smaller samples don't replace the best one; a bigger one replaces all.
+    //
+    BbrMaxFilterUpdate(&Filter, Window, 0, 50);
+    ASSERT_EQ(100ull, Filter.Samples[0].Value);
+    BbrMaxFilterUpdate(&Filter, Window, 1, 200);
+    ASSERT_EQ(200ull, Filter.Samples[0].Value);
+    ASSERT_EQ(200ull, Filter.Samples[2].Value);
+
+    //
+    // Lesser samples later in the window are kept as second and third best.
+    //
+    BbrMaxFilterUpdate(&Filter, Window, 2, 150);
+    ASSERT_EQ(200ull, Filter.Samples[0].Value);
+    ASSERT_EQ(150ull, Filter.Samples[1].Value);
+    BbrMaxFilterUpdate(&Filter, Window, 3, 120);
+    ASSERT_EQ(200ull, Filter.Samples[0].Value);
+    ASSERT_EQ(150ull, Filter.Samples[1].Value);
+    ASSERT_EQ(120ull, Filter.Samples[2].Value);
+
+    //
+    // Once the best sample leaves the window, the next best takes over.
+    //
+    BbrMaxFilterUpdate(&Filter, Window, 4, 100);
+    ASSERT_EQ(150ull, Filter.Samples[0].Value);
+    BbrMaxFilterUpdate(&Filter, Window, 5, 90);
+    ASSERT_EQ(120ull, Filter.Samples[0].Value);
+
+    //
+    // With every sample out of the window, the new one is the best.
+    //
+    BbrMaxFilterUpdate(&Filter, Window, 9, 10);
+    ASSERT_EQ(10ull, Filter.Samples[0].Value);
+    ASSERT_EQ(10ull, Filter.Samples[1].Value);
+    ASSERT_EQ(10ull, Filter.Samples[2].Value);
+}
+
+TEST(BbrTest, StartupDrainProbeBw)
+{
+    SmartBbr Test;
+    ASSERT_EQ(BBR_STATE_STARTUP, Test.Bbr->State);
+    const uint32_t InitialWindow = Test.Bbr->CongestionWindow;
+    ASSERT_EQ((uint32_t)Test.DatagramSize() * 10, InitialWindow);
+
+    //
+    // The bandwidth doesn't grow, so STARTUP ends after the first sample plus
+    // three rounds without growth, and DRAIN holds while the queue built up
+    // in STARTUP is still inflight.
+    //
+    Test.Send(100 * TestAckBytes);
+    for (uint32_t i = 0; i < 3; ++i) {
+        Test.Ack();
+        ASSERT_EQ(BBR_STATE_STARTUP, Test.Bbr->State);
+        ASSERT_EQ(709u, Test.Bbr->PacingGain);
+    }
+    ASSERT_EQ(TestBandwidth, Test.Bbr->MaxBwFilter.Samples[0].Value);
+    ASSERT_EQ(TestRtt, Test.Bbr->MinRtt);
+    ASSERT_GT(Test.Bbr->CongestionWindow, InitialWindow);
+
+    Test.Ack();
+    ASSERT_TRUE(Test.Bbr->FilledPipe);
+    ASSERT_EQ(BBR_STATE_DRAIN, Test.Bbr->State);
+    ASSERT_EQ(92u, Test.Bbr->PacingGain);
+    ASSERT_GT(Test.Bbr->BytesInFlight, Test.Bdp());
+    Test.Ack();
+    ASSERT_EQ(BBR_STATE_DRAIN, Test.Bbr->State);
+
+    //
+    // Once inflight is down to the BDP, PROBE_BW starts, and cruises right
+    // away since there is no queue left to drain.
+    //
+    Test.Cc->QuicCongestionControlOnDataInvalidated(
+        Test.Cc, Test.Bbr->BytesInFlight - TestAckBytes);
+    Test.Ack();
+    ASSERT_EQ(BBR_STATE_PROBE_BW, Test.Bbr->State);
+    ASSERT_EQ(BBR_PROBE_BW_CRUISE, Test.Bbr->ProbeBwPhase);
+    ASSERT_EQ(256u, Test.Bbr->PacingGain);
+    ASSERT_EQ(1ull, Test.Bbr->CycleCount);
+}
+
+TEST(BbrTest, ProbeBwCycle)
+{
+    SmartBbr Test;
+    Test.RunToProbeBw();
+    ASSERT_EQ(BBR_PROBE_BW_CRUISE, Test.Bbr->ProbeBwPhase);
+
+    //
+    // After the randomized 2-3s wait, REFILL for a round and then probe UP.
+    //
+    Test.Send(10 * TestAckBytes);
+    Test.Ack(TestAckBytes, TestBandwidth, TestRtt, S_TO_US(3));
+    ASSERT_EQ(BBR_PROBE_BW_REFILL, Test.Bbr->ProbeBwPhase);
+    Test.Ack();
+    ASSERT_EQ(BBR_PROBE_BW_UP, Test.Bbr->ProbeBwPhase);
+    ASSERT_EQ(320u, Test.Bbr->PacingGain);
+}
+
+TEST(BbrTest, ProbeRtt)
+{
+    SmartBbr Test;
+    Test.RunToProbeBw();
+    const uint32_t Cwnd = Test.Bbr->CongestionWindow;
+
+    //
+    // No lower RTT sample for over 5s, so PROBE_RTT cuts the window to half
+    // the BDP (or the minimum window).
+    //
+    Test.Send(Cwnd / 2);
+    Test.Ack(TestAckBytes, TestBandwidth, TestRtt, S_TO_US(6));
+    ASSERT_EQ(BBR_STATE_PROBE_RTT, Test.Bbr->State);
+    const uint32_t ProbeRttCwnd =
+        CXPLAT_MAX(Test.Bdp() / 2, (uint32_t)Test.DatagramSize() * 4);
+    ASSERT_LE(Test.Bbr->CongestionWindow, ProbeRttCwnd);
+
+    //
+    // Held for at least 200ms and a round once inflight got that low.
+    //
+    Test.Cc->QuicCongestionControlOnDataInvalidated(Test.Cc, Test.Bbr->BytesInFlight);
+    Test.Send(TestAckBytes * 2);
+    Test.Ack(TestAckBytes, TestBandwidth, TestRtt, MS_TO_US(1));
+    ASSERT_EQ(BBR_STATE_PROBE_RTT, Test.Bbr->State);
+    Test.Ack(TestAckBytes / 2, TestBandwidth, TestRtt, MS_TO_US(1));
+    ASSERT_EQ(BBR_STATE_PROBE_RTT, Test.Bbr->State);
+    Test.Ack(TestAckBytes / 2, TestBandwidth, TestRtt, MS_TO_US(250));
+
+    //
+    // Back to PROBE_BW, with the window from before PROBE_RTT restored.
+    //
+    ASSERT_EQ(BBR_STATE_PROBE_BW, Test.Bbr->State);
+    ASSERT_EQ(BBR_PROBE_BW_CRUISE, Test.Bbr->ProbeBwPhase);
+    ASSERT_GE(Test.Bbr->CongestionWindow, Cwnd);
+}
+
+TEST(BbrTest, LossInStartupSetsInflightHi)
+{
+    SmartBbr Test;
+    Test.Send(100 * TestAckBytes);
+    Test.Ack();
+    ASSERT_EQ(UINT32_MAX, Test.Bbr->InflightHi);
+
+    //
+    // A round loss rate above 2% ends STARTUP and caps the long term bound
+    // at the inflight data when the loss was detected.
+    //
+    const uint32_t PriorInFlight = Test.Bbr->BytesInFlight;
+    Test.Lose(TestAckBytes);
+    ASSERT_TRUE(Test.Bbr->FilledPipe);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.CongestionCount);
+    ASSERT_EQ(
+        CXPLAT_MAX(PriorInFlight, Test.Bdp() * 179 / 256),
+        Test.Bbr->InflightHi);
+
+    Test.Ack();
+    ASSERT_EQ(BBR_STATE_DRAIN, Test.Bbr->State);
+}
+
+TEST(BbrTest, LossInProbeBwSetsInflightLo)
+{
+    SmartBbr Test;
+    Test.RunToProbeBw();
+    ASSERT_EQ(BBR_PROBE_BW_CRUISE, Test.Bbr->ProbeBwPhase);
+    ASSERT_EQ(UINT32_MAX, Test.Bbr->InflightLo);
+    ASSERT_EQ(UINT64_MAX, Test.Bbr->BwLo);
+
+    //
+    // Loss while cruising doesn't touch InflightHi, but at the end of the
+    // round cuts the short term bounds by beta (0.7), or to what was
+    // delivered in the round if more.
+    //
+    Test.Send(10 * TestAckBytes);
+    Test.Lose(TestAckBytes);
+    ASSERT_EQ(UINT32_MAX, Test.Bbr->InflightHi);
+    ASSERT_EQ(UINT32_MAX, Test.Bbr->InflightLo);
+
+    const uint32_t Cwnd = Test.Bbr->CongestionWindow;
+    Test.Ack(TestAckBytes, TestBandwidth / 2);
+    ASSERT_EQ(TestBandwidth * 179 / 256, Test.Bbr->BwLo);
+    ASSERT_EQ((uint32_t)((uint64_t)Cwnd * 179 / 256), Test.Bbr->InflightLo);
+    ASSERT_LE(Test.Bbr->CongestionWindow, Test.Bbr->InflightLo);
+
+    //
+    // The bounds keep shrinking on every round with loss.
+    //
+    const uint32_t InflightLo = Test.Bbr->InflightLo;
+    Test.Lose(TestAckBytes);
+    Test.Ack(TestAckBytes, TestBandwidth / 2);
+    ASSERT_EQ((uint32_t)((uint64_t)InflightLo * 179 / 256), Test.Bbr->InflightLo);
+}
+
+TEST(BbrTest, EcnInStartupSetsInflightHi)
+{
+    SmartBbr Test;
+    Test.Send(20 * TestAckBytes);
+    Test.Ack();
+
+    //
+    // A few CE marks don't stop STARTUP, but they count as a congestion
+    // event once per round.
+    //
+    Test.Ecn(10, 1);
+    ASSERT_FALSE(Test.Bbr->FilledPipe);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.EcnCongestionCount);
+    Test.Ecn(0, 1);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.EcnCongestionCount);
+
+    //
+    // More than half the round CE marked does.
+    //
+    const uint32_t PriorInFlight = Test.Bbr->BytesInFlight;
+    Test.Ecn(10, 9);
+    ASSERT_TRUE(Test.Bbr->FilledPipe);
+    ASSERT_EQ(
+        CXPLAT_MAX(PriorInFlight, Test.Bdp() * 179 / 256),
+        Test.Bbr->InflightHi);
+}
+
+TEST(BbrTest, EcnInProbeBwSetsInflightLo)
+{
+    SmartBbr Test;
+    Test.RunToProbeBw();
+
+    Test.Send(10 * TestAckBytes);
+    Test.Ecn(10, 1);
+    const uint32_t Cwnd = Test.Bbr->CongestionWindow;
+    Test.Ack();
+    ASSERT_EQ((uint32_t)((uint64_t)Cwnd * 179 / 256), Test.Bbr->InflightLo);
+    ASSERT_EQ(UINT32_MAX, Test.Bbr->InflightHi);
+
+    //
+    // A round without CE marks leaves the bounds alone.
+    //
+    const uint32_t InflightLo = Test.Bbr->InflightLo;
+    Test.Ecn(10, 0);
+    Test.Ack();
+    ASSERT_EQ(InflightLo, Test.Bbr->InflightLo);
+}
+
+TEST(BbrTest, PacedSendAllowance)
+{
+    SmartBbr Test(true);
+    const uint32_t Cwnd = Test.Bbr->CongestionWindow;
+    const uint64_t PacingRate = Test.Bbr->PacingRate;
+    ASSERT_NE(0ull, PacingRate);
+    ASSERT_EQ(PacingRate, Test.Cc->QuicCongestionControlGetPacingRate(Test.Cc));
+
+    //
+    // Without a valid time since the last send, the whole window is allowed.
+    //
+    ASSERT_EQ(Cwnd, Test.Cc->QuicCongestionControlGetSendAllowance(Test.Cc, 0, FALSE));
+
+    //
+    // Otherwise the pacing rate times the elapsed time.
+    //
+    const uint64_t Elapsed = 1000; // us
+    const uint32_t Allowance = (uint32_t)(PacingRate * Elapsed / S_TO_US(1));
+    ASSERT_LT(Allowance, Cwnd);
+    ASSERT_EQ(Allowance, Test.Cc->QuicCongestionControlGetSendAllowance(Test.Cc, Elapsed, TRUE));
+
+    //
+    // Unused allowance carries over to the next send.
+    //
+    Test.Send(Allowance / 2);
+    ASSERT_EQ(
+        Allowance - Allowance / 2 + Allowance,
+        Test.Cc->QuicCongestionControlGetSendAllowance(Test.Cc, Elapsed, TRUE));
+
+    //
+    // Never more than the window allows.
+    //
+    ASSERT_EQ(
+        Cwnd - Test.Bbr->BytesInFlight,
+        Test.Cc->QuicCongestionControlGetSendAllowance(Test.Cc, S_TO_US(1), TRUE));
+
+    //
+    // And nothing when congestion blocked.
+    //
+    Test.Send(Cwnd);
+    ASSERT_FALSE(Test.Cc->QuicCongestionControlCanSend(Test.Cc));
+    ASSERT_EQ(0u, Test.Cc->QuicCongestionControlGetSendAllowance(Test.Cc, Elapsed, TRUE));
+}
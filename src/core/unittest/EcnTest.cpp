@@ -0,0 +1,386 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the per path ECN validation state machine and the CUBIC
+    response to CE marks.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "EcnTest.cpp.clog.h"
+#endif
+
+#include <memory>
+#include <vector>
+
+//
+// g++ doesn't support the anonymous QUIC_HANDLE member that starts
+// QUIC_CONNECTION, so C++ code sees the other connection fields at a different
+// offset than the core does. The connection is laid out the core's way and
+// passed to the core as CoreConn, and its fields are accessed through Conn.
+//
+const size_t EcnConnHandleSize =
+    offsetof(QUIC_CONNECTION, RegistrationLink) == 0 ? sizeof(QUIC_HANDLE) : 0;
+
+const QUIC_ENCRYPT_LEVEL EcnTestLevel = QUIC_ENCRYPT_LEVEL_1_RTT;
+
+//
+// A zeroed connection with ECN enabled, one active path, a 1-RTT packet space
+// and CUBIC, and helpers to send packets and feed back ACK_ECN counts the way
+// the peer would.
+//
+struct SmartEcnConn {
+    std::vector<uint64_t> Memory;
+    std::unique_ptr<QUIC_PACKET_SPACE> Packets {new QUIC_PACKET_SPACE()};
+    QUIC_CID_LIST_ENTRY DestCid;
+    QUIC_CONNECTION* CoreConn;
+    QUIC_CONNECTION* Conn;
+    QUIC_ACK_ECN_EX Counts;
+    uint64_t EctSentSinceAck {0};
+
+    SmartEcnConn(bool L4s = false) :
+        Memory((sizeof(QUIC_CONNECTION) + EcnConnHandleSize + 7) / 8) {
+        CxPlatZeroMemory(&DestCid, sizeof(DestCid));
+        CxPlatZeroMemory(&Counts, sizeof(Counts));
+        CoreConn = (QUIC_CONNECTION*)Memory.data();
+        Conn = (QUIC_CONNECTION*)((uint8_t*)Memory.data() + EcnConnHandleSize);
+        Conn->Settings.EcnEnabled = TRUE;
+        Conn->Settings.L4sEnabled = L4s;
+        Conn->Settings.MinimumMtu = QUIC_DPLPMUTD_MIN_MTU;
+        Conn->Settings.InitialRttMs = 50;
+        Conn->Packets[EcnTestLevel] = Packets.get();
+
+        QuicPathInitialize(CoreConn, &Conn->Paths[0]);
+        QuicAddrSetFamily(&Conn->Paths[0].Route.RemoteAddress, QUIC_ADDRESS_FAMILY_INET);
+        QuicAddrSetPort(&Conn->Paths[0].Route.RemoteAddress, 4433);
+        Conn->Paths[0].DestCid = &DestCid;
+        Conn->Paths[0].IsActive = TRUE;
+        Conn->PathsCount = 1;
+
+        QUIC_SETTINGS_INTERNAL Settings;
+        CxPlatZeroMemory(&Settings, sizeof(Settings));
+        Settings.InitialWindowPackets = 10;
+        Settings.EcnEnabled = TRUE;
+        Settings.L4sEnabled = L4s;
+        CubicCongestionControlInitialize(&Conn->CongestionControl, &Settings);
+    }
+
+    QUIC_PATH* Path() { return &Conn->Paths[0]; }
+
+    QUIC_CONGESTION_CONTROL_CUBIC* Cubic() { return &Conn->CongestionControl.Cubic; }
+
+    QUIC_ECN_VALIDATION_STATE State() {
+        return (QUIC_ECN_VALIDATION_STATE)Path()->EcnValidationState;
+    }
+
+    //
+    // Sends Count packets, with the marking the path currently uses, and
+    // returns that marking.
+    //
+    CXPLAT_ECN_TYPE Send(uint32_t Count = 1) {
+        CXPLAT_ECN_TYPE Ecn = CXPLAT_ECN_NON_ECT;
+        for (uint32_t i = 0; i < Count; ++i) {
+            Ecn = QuicPathGetSendEcn(CoreConn, Path());
+            if (Ecn != CXPLAT_ECN_NON_ECT) {
+                Packets->EcnEctSent++;
+                EctSentSinceAck++;
+            }
+            Conn->LossDetection.LargestSentPacketNumber++;
+        }
+        return Ecn;
+    }
+
+    //
+    // Acknowledges everything sent so far. The peer reports CePackets of the
+    // newly acknowledged ECT packets as CE and the rest with the ECT codepoint
+    // they were sent with.
+    //
+    void Ack(uint64_t CePackets = 0) {
+        AckUpTo(Conn->LossDetection.LargestSentPacketNumber, EctSentSinceAck, CePackets);
+    }
+
+    //
+    // Acknowledges packets up to LargestAck, EctAcked of which are newly
+    // acknowledged ECT packets, CePackets of those reported as CE.
+    //
+    void AckUpTo(uint64_t LargestAck, uint64_t EctAcked, uint64_t CePackets) {
+        ASSERT_LE(EctAcked, EctSentSinceAck);
+        ASSERT_LE(CePackets, EctAcked);
+        if (Conn->Settings.L4sEnabled) {
+            Counts.ECT_1_Count += EctAcked - CePackets;
+        } else {
+            Counts.ECT_0_Count += EctAcked - CePackets;
+        }
+        Counts.CE_Count += CePackets;
+        Process(LargestAck, &Counts, EctAcked);
+    }
+
+    //
+    // Acknowledges everything sent so far with the given ACK_ECN counts, or
+    // a plain ACK frame if Ecn is NULL.
+    //
+    void AckWith(const QUIC_ACK_ECN_EX* Ecn) {
+        Process(Conn->LossDetection.LargestSentPacketNumber, Ecn, EctSentSinceAck);
+    }
+
+    void Process(uint64_t LargestAck, const QUIC_ACK_ECN_EX* Ecn, uint64_t EctAcked) {
+        Conn->LossDetection.LargestAck = LargestAck;
+        QuicLossDetectionProcessEcn(
+            &Conn->LossDetection, Path(), EcnTestLevel, Ecn, EctAcked);
+        EctSentSinceAck -= EctAcked;
+    }
+
+    //
+    // Makes the path's testing period end.
+    //
+    void ExpireTesting() {
+        ASSERT_TRUE(Path()->EcnTestingStarted);
+        Path()->EcnTestingEndTime = CxPlatTimeUs32();
+    }
+};
+
+TEST(EcnTest, Disabled)
+{
+    SmartEcnConn Test;
+    Test.Conn->Settings.EcnEnabled = FALSE;
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+    ASSERT_EQ(0ull, Test.Packets->EcnEctSent);
+}
+
+TEST(EcnTest, ValidationSucceeds)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(ECN_VALIDATION_TESTING, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(3));
+    ASSERT_TRUE(Test.Path()->EcnTestingStarted);
+
+    Test.Ack();
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+    ASSERT_EQ(3ull, Test.Packets->EcnEctCounter);
+    ASSERT_EQ(0ull, Test.Packets->EcnCeCounter);
+
+    //
+    // A capable path keeps marking after the testing period.
+    //
+    Test.ExpireTesting();
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send());
+    Test.Ack();
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+}
+
+TEST(EcnTest, ValidationSucceedsL4s)
+{
+    SmartEcnConn Test(true);
+    ASSERT_EQ(CXPLAT_ECN_ECT_1, Test.Send(2));
+    Test.Ack();
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+
+    //
+    // ECT(0) counts mean the marks were rewritten on the path.
+    //
+    ASSERT_EQ(CXPLAT_ECN_ECT_1, Test.Send());
+    Test.Counts.ECT_1_Count++;
+    Test.Counts.ECT_0_Count++;
+    Test.AckWith(&Test.Counts);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+}
+
+TEST(EcnTest, TestingTimesOutThenSucceeds)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send());
+
+    //
+    // With no ECN feedback for three PTOs, marking stops, but late feedback
+    // still validates the path.
+    //
+    Test.ExpireTesting();
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+    ASSERT_EQ(ECN_VALIDATION_UNKNOWN, Test.State());
+
+    Test.Ack();
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send());
+}
+
+TEST(EcnTest, ValidationFailsWithoutCounts)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(2));
+
+    //
+    // ECT packets acknowledged by a plain ACK frame.
+    //
+    Test.AckWith(nullptr);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+}
+
+TEST(EcnTest, ValidationFailsOnMissingMarks)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(2));
+
+    //
+    // Only one of the two newly acknowledged ECT packets is counted, so the
+    // other's mark was cleared on the path.
+    //
+    Test.Counts.ECT_0_Count = 1;
+    Test.AckWith(&Test.Counts);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+}
+
+TEST(EcnTest, ValidationFailsOnDecreasingCounts)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(2));
+    Test.Ack(1);
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+
+    //
+    // The CE count goes backwards, even though the total still covers the
+    // newly acknowledged packet.
+    //
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send());
+    Test.Counts.ECT_0_Count += 2;
+    Test.Counts.CE_Count--;
+    Test.AckWith(&Test.Counts);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+}
+
+TEST(EcnTest, ValidationFailsOnTooManyMarks)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(2));
+
+    //
+    // The peer reports more marked packets than were ever sent.
+    //
+    Test.Counts.ECT_0_Count = 3;
+    Test.AckWith(&Test.Counts);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.State());
+}
+
+TEST(EcnTest, RevalidateAfterPathChange)
+{
+    SmartEcnConn Test;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send());
+    Test.AckWith(nullptr);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_NON_ECT, Test.Send());
+
+    //
+    // The peer moves to a new port (a NAT rebinding). The new path starts
+    // testing again, and is validated on its own.
+    //
+    QUIC_PATH* NewPath = &Test.Conn->Paths[1];
+    QuicPathInitialize(Test.CoreConn, NewPath);
+    NewPath->Route.RemoteAddress = Test.Path()->Route.RemoteAddress;
+    QuicAddrSetPort(&NewPath->Route.RemoteAddress, 4434);
+    NewPath->DestCid = &Test.DestCid;
+    Test.Conn->PathsCount = 2;
+    const uint8_t NewPathId = NewPath->ID;
+    QuicPathSetActive(Test.CoreConn, NewPath);
+    ASSERT_EQ(NewPathId, Test.Path()->ID);
+    ASSERT_EQ(ECN_VALIDATION_FAILED, Test.Conn->Paths[1].EcnValidationState);
+
+    ASSERT_EQ(ECN_VALIDATION_TESTING, Test.State());
+    ASSERT_FALSE(Test.Path()->EcnTestingStarted);
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(2));
+    Test.Ack();
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send());
+}
+
+TEST(EcnTest, CeCongestionResponse)
+{
+    SmartEcnConn Test;
+    const uint32_t InitialWindow = Test.Cubic()->CongestionWindow;
+    ASSERT_EQ(CXPLAT_ECN_ECT_0, Test.Send(4));
+
+    //
+    // ECT marks alone are not congestion.
+    //
+    Test.Ack();
+    ASSERT_EQ(InitialWindow, Test.Cubic()->CongestionWindow);
+    ASSERT_EQ(0u, Test.Conn->Stats.Send.EcnCongestionCount);
+
+    //
+    // A CE mark reduces the window like a loss. The first ACK only covers
+    // half of the packets sent.
+    //
+    Test.Send(4);
+    const uint64_t LargestSent = Test.Conn->LossDetection.LargestSentPacketNumber;
+    Test.AckUpTo(LargestSent - 2, 2, 1);
+    const uint32_t ReducedWindow = InitialWindow * 7 / 10;
+    ASSERT_EQ(ReducedWindow, Test.Cubic()->CongestionWindow);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.EcnCongestionCount);
+    ASSERT_TRUE(Test.Cubic()->IsInRecovery);
+
+    //
+    // More CE marks for packets sent before the reduction are part of the
+    // same congestion event.
+    //
+    Test.AckUpTo(LargestSent, 2, 2);
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+    ASSERT_EQ(ReducedWindow, Test.Cubic()->CongestionWindow);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.EcnCongestionCount);
+}
+
+TEST(EcnTest, CeOncePerRound)
+{
+    SmartEcnConn Test;
+    const uint32_t InitialWindow = Test.Cubic()->CongestionWindow;
+    Test.Send(4);
+    Test.Ack(1);
+    ASSERT_EQ(InitialWindow * 7 / 10, Test.Cubic()->CongestionWindow);
+
+    //
+    // The reduction is not undone if a loss later turns out to be spurious.
+    //
+    ASSERT_EQ(Test.Cubic()->CongestionWindow, Test.Cubic()->PrevCongestionWindow);
+
+    //
+    // A CE mark for a packet sent after the reduction starts a new event.
+    //
+    Test.Send(4);
+    Test.Ack(1);
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+    ASSERT_EQ(2u, Test.Conn->Stats.Send.EcnCongestionCount);
+    ASSERT_LT(Test.Cubic()->CongestionWindow, InitialWindow * 7 / 10);
+}
+
+TEST(EcnTest, CeCongestionResponseL4s)
+{
+    SmartEcnConn Test(true);
+    const uint32_t InitialWindow = Test.Cubic()->CongestionWindow;
+
+    //
+    // Every packet CE marked: alpha stays at one, and the window is halved
+    // without entering recovery.
+    //
+    ASSERT_EQ(CXPLAT_ECN_ECT_1, Test.Send(4));
+    Test.Ack(4);
+    ASSERT_EQ(ECN_VALIDATION_CAPABLE, Test.State());
+    ASSERT_EQ(InitialWindow / 2, Test.Cubic()->CongestionWindow);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.EcnCongestionCount);
+    ASSERT_FALSE(Test.Cubic()->IsInRecovery);
+
+    //
+    // A round without CE marks lowers alpha and leaves the window alone.
+    //
+    const uint32_t Alpha = Test.Cubic()->EcnAlpha;
+    Test.Send(4);
+    Test.Ack();
+    ASSERT_LT(Test.Cubic()->EcnAlpha, Alpha);
+    ASSERT_EQ(InitialWindow / 2, Test.Cubic()->CongestionWindow);
+    ASSERT_EQ(1u, Test.Conn->Stats.Send.EcnCongestionCount);
+}
@@ -0,0 +1,494 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the lookup's lock-free local CID tables, and a multi-threaded
+    benchmark comparing them to reader/writer locked hash tables.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "LookupTest.cpp.clog.h"
+#endif
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+//
+// g++ doesn't support the anonymous QUIC_HANDLE member that starts
+// QUIC_CONNECTION, so C++ code sees the other connection fields at a different
+// offset than the core does. Connections passed to the core are laid out the
+// core's way, and their fields are read through ConnFields.
+//
+const size_t ConnHandleSize =
+    offsetof(QUIC_CONNECTION, RegistrationLink) == 0 ? sizeof(QUIC_HANDLE) : 0;
+
+QUIC_CONNECTION* ConnFields(QUIC_CONNECTION* Connection) {
+    return (QUIC_CONNECTION*)((uint8_t*)Connection + ConnHandleSize);
+}
+
+const uint8_t TestCidLength = 8;
+
+//
+// Sets up the library's partitioning for the duration of a test, the way
+// library initialization would.
+//
+struct LookupTestPartitioning {
+    uint16_t PartitionCount {MsQuicLib.PartitionCount};
+    uint16_t PartitionMask {MsQuicLib.PartitionMask};
+    uint8_t CidServerIdLength {MsQuicLib.CidServerIdLength};
+    LookupTestPartitioning() {
+        MsQuicLib.PartitionCount =
+            (uint16_t)CXPLAT_MIN(CxPlatProcMaxCount(), QUIC_MAX_PARTITION_COUNT);
+        MsQuicLib.PartitionMask = 1;
+        while (MsQuicLib.PartitionMask < MsQuicLib.PartitionCount) {
+            MsQuicLib.PartitionMask <<= 1;
+        }
+        MsQuicLib.PartitionMask--;
+        MsQuicLib.CidServerIdLength = 0;
+    }
+    ~LookupTestPartitioning() {
+        MsQuicLib.PartitionCount = PartitionCount;
+        MsQuicLib.PartitionMask = PartitionMask;
+        MsQuicLib.CidServerIdLength = CidServerIdLength;
+    }
+};
+
+//
+// Zeroed connections, laid out the core's way, with enough references that
+// the lookup never releases the last one.
+//
+struct TestConnections {
+    const size_t Stride {(sizeof(QUIC_CONNECTION) + ConnHandleSize + 7) / 8};
+    std::vector<uint64_t> Memory;
+    TestConnections(uint32_t Count) : Memory(Count * Stride) {
+        for (uint32_t i = 0; i < Count; ++i) {
+            ConnFields(Get(i))->RefCount = 0x10000000;
+        }
+    }
+    QUIC_CONNECTION* Get(uint32_t Index) {
+        return (QUIC_CONNECTION*)&Memory[Index * Stride];
+    }
+};
+
+QUIC_CID_HASH_ENTRY* NewTestCid(QUIC_CONNECTION* Connection, std::mt19937& Rng) {
+    uint8_t Data[TestCidLength];
+    for (uint8_t i = 0; i < TestCidLength; ++i) {
+        Data[i] = (uint8_t)Rng();
+    }
+    return QuicCidNewSource(Connection, TestCidLength, Data);
+}
+
+struct SmartLookup {
+    LookupTestPartitioning Partitioning;
+    QUIC_LOOKUP Lookup;
+    SmartLookup() {
+        QuicLookupInitialize(&Lookup);
+        EXPECT_TRUE(QuicLookupMaximizePartitioning(&Lookup));
+    }
+    ~SmartLookup() {
+        QuicLookupUninitialize(&Lookup);
+    }
+    bool Add(QUIC_CID_HASH_ENTRY* Cid) {
+        QUIC_CONNECTION* Collision;
+        bool Added = QuicLookupAddLocalCid(&Lookup, Cid, &Collision);
+        EXPECT_EQ(Added, Collision == nullptr);
+        return Added;
+    }
+    void Remove(QUIC_CID_HASH_ENTRY* Cid) {
+        CXPLAT_SLIST_ENTRY* Link = &Cid->Link;
+        Cid->Link.Next = NULL;
+        QuicLookupRemoveLocalCid(&Lookup, Cid, &Link);
+        ASSERT_EQ(nullptr, Link);
+    }
+    QUIC_CONNECTION* Find(const QUIC_CID_HASH_ENTRY* Cid) {
+        return QuicLookupFindConnectionByLocalCid(&Lookup, Cid->CID.Data, Cid->CID.Length);
+    }
+};
+
+TEST(LookupTest, AddFindRemove)
+{
+    SmartLookup Lookup;
+    TestConnections Connections(100);
+    std::mt19937 Rng(1);
+
+    std::vector<QUIC_CID_HASH_ENTRY*> Cids;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        QUIC_CID_HASH_ENTRY* Cid = NewTestCid(Connections.Get(i % 100), Rng);
+        ASSERT_NE(nullptr, Cid);
+        ASSERT_TRUE(Lookup.Add(Cid));
+        Cids.push_back(Cid);
+    }
+    for (auto Cid : Cids) {
+        ASSERT_EQ(Cid->Connection, Lookup.Find(Cid));
+    }
+
+    //
+    // The same CID can't be added twice.
+    //
+    QUIC_CID_HASH_ENTRY* Duplicate =
+        QuicCidNewSource(Connections.Get(0), TestCidLength, Cids[1]->CID.Data);
+    ASSERT_NE(nullptr, Duplicate);
+    QUIC_CONNECTION* Collision;
+    ASSERT_FALSE(QuicLookupAddLocalCid(&Lookup.Lookup, Duplicate, &Collision));
+    ASSERT_EQ(Cids[1]->Connection, Collision);
+    CXPLAT_FREE(Duplicate, QUIC_POOL_CIDHASH);
+
+    QUIC_CID_HASH_ENTRY* Unknown = NewTestCid(Connections.Get(0), Rng);
+    ASSERT_NE(nullptr, Unknown);
+    ASSERT_EQ(nullptr, Lookup.Find(Unknown));
+
+    //
+    // Remove every other CID, and add new ones in the tombstones they leave.
+    //
+    for (size_t i = 0; i < Cids.size(); i += 2) {
+        Lookup.Remove(Cids[i]);
+        ASSERT_EQ(nullptr, Lookup.Find(Cids[i]));
+        CXPLAT_FREE(Cids[i], QUIC_POOL_CIDHASH);
+        Cids[i] = NewTestCid(Connections.Get((uint32_t)i % 100), Rng);
+        ASSERT_NE(nullptr, Cids[i]);
+        ASSERT_TRUE(Lookup.Add(Cids[i]));
+    }
+    for (auto Cid : Cids) {
+        ASSERT_EQ(Cid->Connection, Lookup.Find(Cid));
+    }
+    ASSERT_EQ(nullptr, Lookup.Find(Unknown));
+    CXPLAT_FREE(Unknown, QUIC_POOL_CIDHASH);
+
+    for (auto Cid : Cids) {
+        Lookup.Remove(Cid);
+        ASSERT_EQ(nullptr, Lookup.Find(Cid));
+        CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+    }
+    ASSERT_EQ(0u, Lookup.Lookup.CidCount);
+}
+
+TEST(LookupTest, Churn)
+{
+    SmartLookup Lookup;
+    TestConnections Connections(1);
+    std::mt19937 Rng(2);
+
+    //
+    // Repeatedly replacing CIDs fills the tables with tombstones, which forces
+    // them to be rebuilt.
+    //
+    std::vector<QUIC_CID_HASH_ENTRY*> Cids(64);
+    for (auto& Cid : Cids) {
+        ASSERT_NE(nullptr, Cid = NewTestCid(Connections.Get(0), Rng));
+        ASSERT_TRUE(Lookup.Add(Cid));
+    }
+    for (uint32_t i = 0; i < 10000; ++i) {
+        QUIC_CID_HASH_ENTRY*& Cid = Cids[Rng() % Cids.size()];
+        Lookup.Remove(Cid);
+        CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+        ASSERT_NE(nullptr, Cid = NewTestCid(Connections.Get(0), Rng));
+        ASSERT_TRUE(Lookup.Add(Cid));
+    }
+    for (auto Cid : Cids) {
+        ASSERT_EQ(Cid->Connection, Lookup.Find(Cid));
+        Lookup.Remove(Cid);
+        CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+    }
+}
+
+//
+// A locked lookup of the same shape as the lookup's partitioned tables before
+// they became lock-free: an exclusive lock for writers, and a reader/writer
+// lock per partition.
+//
+struct RwLockLookup {
+    struct Partition {
+        CXPLAT_DISPATCH_RW_LOCK RwLock;
+        CXPLAT_HASHTABLE Table;
+        uint8_t Padding[64];
+    };
+    struct Entry {
+        CXPLAT_HASHTABLE_ENTRY TableEntry;
+        QUIC_CID_HASH_ENTRY* Cid;
+    };
+    LookupTestPartitioning Partitioning;
+    CXPLAT_DISPATCH_RW_LOCK RwLock;
+    std::vector<Partition> Partitions;
+    RwLockLookup() : Partitions(MsQuicLib.PartitionCount) {
+        CxPlatDispatchRwLockInitialize(&RwLock);
+        for (auto& Partition : Partitions) {
+            CxPlatDispatchRwLockInitialize(&Partition.RwLock);
+            EXPECT_TRUE(CxPlatHashtableInitializeEx(&Partition.Table, CXPLAT_HASH_MIN_SIZE));
+        }
+    }
+    ~RwLockLookup() {
+        for (auto& Partition : Partitions) {
+            CxPlatHashtableUninitialize(&Partition.Table);
+            CxPlatDispatchRwLockUninitialize(&Partition.RwLock);
+        }
+        CxPlatDispatchRwLockUninitialize(&RwLock);
+    }
+    Partition& GetPartition(const uint8_t* Cid) {
+        uint16_t PartitionIndex;
+        CxPlatCopyMemory(&PartitionIndex, Cid + MsQuicLib.CidServerIdLength, 2);
+        PartitionIndex &= MsQuicLib.PartitionMask;
+        PartitionIndex %= MsQuicLib.PartitionCount;
+        return Partitions[PartitionIndex];
+    }
+    void Add(Entry* Entry) {
+        Partition& Partition = GetPartition(Entry->Cid->CID.Data);
+        CxPlatDispatchRwLockAcquireExclusive(&RwLock);
+        CxPlatDispatchRwLockAcquireExclusive(&Partition.RwLock);
+        CxPlatHashtableInsert(
+            &Partition.Table,
+            &Entry->TableEntry,
+            CxPlatHashSimple(Entry->Cid->CID.Length, Entry->Cid->CID.Data),
+            NULL);
+        CxPlatDispatchRwLockReleaseExclusive(&Partition.RwLock);
+        CxPlatDispatchRwLockReleaseExclusive(&RwLock);
+    }
+    void Remove(Entry* Entry) {
+        Partition& Partition = GetPartition(Entry->Cid->CID.Data);
+        CxPlatDispatchRwLockAcquireExclusive(&RwLock);
+        CxPlatDispatchRwLockAcquireExclusive(&Partition.RwLock);
+        CxPlatHashtableRemove(&Partition.Table, &Entry->TableEntry, NULL);
+        CxPlatDispatchRwLockReleaseExclusive(&Partition.RwLock);
+        CxPlatDispatchRwLockReleaseExclusive(&RwLock);
+    }
+    QUIC_CONNECTION* Find(const QUIC_CID_HASH_ENTRY* Cid) {
+        const uint32_t Hash = CxPlatHashSimple(Cid->CID.Length, Cid->CID.Data);
+        Partition& Partition = GetPartition(Cid->CID.Data);
+        QUIC_CONNECTION* Connection = NULL;
+        CxPlatDispatchRwLockAcquireShared(&RwLock);
+        CxPlatDispatchRwLockAcquireShared(&Partition.RwLock);
+        CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+        CXPLAT_HASHTABLE_ENTRY* TableEntry =
+            CxPlatHashtableLookup(&Partition.Table, Hash, &Context);
+        while (TableEntry != NULL) {
+            QUIC_CID_HASH_ENTRY* Found =
+                CXPLAT_CONTAINING_RECORD(TableEntry, Entry, TableEntry)->Cid;
+            if (Found->CID.Length == Cid->CID.Length &&
+                memcmp(Found->CID.Data, Cid->CID.Data, Cid->CID.Length) == 0) {
+                Connection = Found->Connection;
+                InterlockedIncrement((volatile long*)&ConnFields(Connection)->RefCount);
+                break;
+            }
+            TableEntry = CxPlatHashtableLookupNext(&Partition.Table, &Context);
+        }
+        CxPlatDispatchRwLockReleaseShared(&Partition.RwLock);
+        CxPlatDispatchRwLockReleaseShared(&RwLock);
+        return Connection;
+    }
+};
+
+struct ReaderContext {
+    std::vector<QUIC_CID_HASH_ENTRY*>* Cids;
+    uint32_t Lookups;
+    uint32_t Seed;
+    uint32_t Misses;
+    QUIC_CONNECTION* (*Find)(void* Lookup, const QUIC_CID_HASH_ENTRY* Cid);
+    void* Lookup;
+    long volatile* ActiveReaders;
+};
+
+static CXPLAT_THREAD_CALLBACK(LookupReaderThread, Context)
+{
+    ReaderContext* Ctx = (ReaderContext*)Context;
+    std::mt19937 Rng(Ctx->Seed);
+    for (uint32_t i = 0; i < Ctx->Lookups; ++i) {
+        const QUIC_CID_HASH_ENTRY* Cid = (*Ctx->Cids)[Rng() % Ctx->Cids->size()];
+        if (Ctx->Find(Ctx->Lookup, Cid) != Cid->Connection) {
+            Ctx->Misses++;
+        }
+    }
+    InterlockedDecrement(Ctx->ActiveReaders);
+    CXPLAT_THREAD_RETURN(0);
+}
+
+//
+// Runs ReaderCount threads that each do Lookups lookups of random CIDs, while
+// the calling thread churns other CIDs through the lookup with ChurnOnce.
+// Returns the time the readers took.
+//
+template<typename FindFn, typename ChurnFn>
+uint64_t
+RunReaders(
+    std::vector<QUIC_CID_HASH_ENTRY*>& Cids,
+    uint32_t ReaderCount,
+    uint32_t Lookups,
+    void* Lookup,
+    FindFn Find,
+    ChurnFn ChurnOnce,
+    _Out_ uint32_t* Misses,
+    _Out_ uint32_t* ChurnCount
+    )
+{
+    long volatile ActiveReaders = (long)ReaderCount;
+    std::vector<ReaderContext> Readers(ReaderCount);
+    std::vector<CXPLAT_THREAD> Threads(ReaderCount);
+
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < ReaderCount; ++i) {
+        Readers[i] = { &Cids, Lookups, i, 0, Find, Lookup, &ActiveReaders };
+        CXPLAT_THREAD_CONFIG Config = { 0, 0, "LookupReader", LookupReaderThread, &Readers[i] };
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, CxPlatThreadCreate(&Config, &Threads[i]));
+    }
+    *ChurnCount = 0;
+    while (ActiveReaders != 0) {
+        ChurnOnce();
+        ++*ChurnCount;
+    }
+    for (auto& Thread : Threads) {
+        CxPlatThreadWait(&Thread);
+        CxPlatThreadDelete(&Thread);
+    }
+    const uint64_t Time = CxPlatTimeUs64() - Start;
+
+    *Misses = 0;
+    for (auto& Reader : Readers) {
+        *Misses += Reader.Misses;
+    }
+    return Time;
+}
+
+QUIC_CONNECTION* FindLockFree(void* Lookup, const QUIC_CID_HASH_ENTRY* Cid) {
+    return ((SmartLookup*)Lookup)->Find(Cid);
+}
+
+QUIC_CONNECTION* FindRwLock(void* Lookup, const QUIC_CID_HASH_ENTRY* Cid) {
+    return ((RwLockLookup*)Lookup)->Find(Cid);
+}
+
+TEST(LookupTest, ConcurrentChurn)
+{
+    SmartLookup Lookup;
+    TestConnections Connections(101);
+    std::mt19937 Rng(3);
+
+    std::vector<QUIC_CID_HASH_ENTRY*> Cids(1000);
+    for (uint32_t i = 0; i < Cids.size(); ++i) {
+        ASSERT_NE(nullptr, Cids[i] = NewTestCid(Connections.Get(i % 100), Rng));
+        ASSERT_TRUE(Lookup.Add(Cids[i]));
+    }
+
+    //
+    // Add and remove batches of CIDs for another connection, which grows and
+    // rebuilds the tables under the readers. None of the readers' lookups may
+    // fail in the meantime.
+    //
+    std::vector<QUIC_CID_HASH_ENTRY*> ChurnCids(200);
+    uint32_t Misses, ChurnCount;
+    RunReaders(
+        Cids,
+        CXPLAT_MAX(2u, CXPLAT_MIN(CxPlatProcMaxCount(), 8u)),
+        100000,
+        &Lookup,
+        FindLockFree,
+        [&]() {
+            for (auto& Cid : ChurnCids) {
+                Cid = NewTestCid(Connections.Get(100), Rng);
+                ASSERT_NE(nullptr, Cid);
+                ASSERT_TRUE(Lookup.Add(Cid));
+            }
+            for (auto Cid : ChurnCids) {
+                Lookup.Remove(Cid);
+                CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+            }
+        },
+        &Misses,
+        &ChurnCount);
+    ASSERT_EQ(0u, Misses);
+    ASSERT_NE(0u, ChurnCount);
+
+    for (auto Cid : Cids) {
+        Lookup.Remove(Cid);
+        CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+    }
+}
+
+//
+// Prints the lookup latency of the lock-free table next to a reader/writer
+// locked one. Timing only, so it's left out of the normal unit test pass; run
+// it with --gtest_also_run_disabled_tests.
+//
+TEST(LookupTest, DISABLED_LookupBenchmark)
+{
+    const uint32_t Lookups = 200000;
+    TestConnections Connections(1001);
+    std::mt19937 Rng(4);
+
+    SmartLookup Lookup;
+    RwLockLookup Locked;
+    std::vector<QUIC_CID_HASH_ENTRY*> Cids(10000);
+    std::vector<RwLockLookup::Entry> Entries(Cids.size());
+    for (uint32_t i = 0; i < Cids.size(); ++i) {
+        ASSERT_NE(nullptr, Cids[i] = NewTestCid(Connections.Get(i % 1000), Rng));
+        ASSERT_TRUE(Lookup.Add(Cids[i]));
+        Entries[i].Cid = Cids[i];
+        Locked.Add(&Entries[i]);
+    }
+
+    //
+    // Each reader thread stands in for a datapath thread looking up received
+    // packets, while the test thread rotates a connection's CID, as a worker
+    // would.
+    //
+    for (uint32_t ReaderCount : { 1u, 2u, 4u, 8u, 16u }) {
+        if (ReaderCount > 1 && ReaderCount > CxPlatProcMaxCount()) {
+            break;
+        }
+
+        uint32_t Misses, RwLockChurn, LockFreeChurn;
+        const uint64_t RwLockTime =
+            RunReaders(
+                Cids,
+                ReaderCount,
+                Lookups,
+                &Locked,
+                FindRwLock,
+                [&]() {
+                    RwLockLookup::Entry Entry;
+                    Entry.Cid = NewTestCid(Connections.Get(1000), Rng);
+                    ASSERT_NE(nullptr, Entry.Cid);
+                    Locked.Add(&Entry);
+                    Locked.Remove(&Entry);
+                    CXPLAT_FREE(Entry.Cid, QUIC_POOL_CIDHASH);
+                },
+                &Misses,
+                &RwLockChurn);
+        ASSERT_EQ(0u, Misses);
+
+        const uint64_t LockFreeTime =
+            RunReaders(
+                Cids,
+                ReaderCount,
+                Lookups,
+                &Lookup,
+                FindLockFree,
+                [&]() {
+                    QUIC_CID_HASH_ENTRY* Cid = NewTestCid(Connections.Get(1000), Rng);
+                    ASSERT_NE(nullptr, Cid);
+                    ASSERT_TRUE(Lookup.Add(Cid));
+                    Lookup.Remove(Cid);
+                    CXPLAT_FREE(Cid, QUIC_POOL_CIDHASH);
+                },
+                &Misses,
+                &LockFreeChurn);
+        ASSERT_EQ(0u, Misses);
+
+        std::cout
+            << "Readers " << ReaderCount
+            << ": rw lock " << (RwLockTime * 1000.0 / Lookups) << " ns/lookup"
+            << " (" << RwLockChurn << " CID rotations)"
+            << ", lock-free " << (LockFreeTime * 1000.0 / Lookups) << " ns/lookup"
+            << " (" << LockFreeChurn << " CID rotations)"
+            << std::endl;
+    }
+
+    for (uint32_t i = 0; i < Cids.size(); ++i) {
+        Locked.Remove(&Entries[i]);
+        Lookup.Remove(Cids[i]);
+        CXPLAT_FREE(Cids[i], QUIC_POOL_CIDHASH);
+    }
+}
@@ -0,0 +1,98 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the packet builder's batch accounting and the departure
+    times it stamps on batches when pacing is offloaded.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "PacketBuilderTest.cpp.clog.h"
+#endif
+
+#include <memory>
+
+struct SmartPacketBuilder {
+    std::unique_ptr<QUIC_CONNECTION> Connection {new QUIC_CONNECTION()};
+    QUIC_PACKET_BUILDER Builder;
+    QUIC_BUFFER Datagrams[4];
+    SmartPacketBuilder(uint64_t PacingRate) {
+        CxPlatZeroMemory(&Builder, sizeof(Builder));
+        CxPlatZeroMemory(Datagrams, sizeof(Datagrams));
+        Builder.Connection = Connection.get();
+        Builder.PacingRate = PacingRate;
+    }
+    //
+    // Fills a batch with datagrams of the given lengths.
+    //
+    void Batch(std::initializer_list<uint16_t> Lengths) {
+        ASSERT_LE(Lengths.size(), ARRAYSIZE(Datagrams));
+        Builder.TotalCountDatagrams = 0;
+        Builder.TotalDatagramsLength = 0;
+        uint32_t i = 0;
+        for (uint16_t Length : Lengths) {
+            Builder.Datagram = &Datagrams[i++];
+            Builder.DatagramLength = Length;
+            QuicPacketBuilderCompleteDatagram(&Builder);
+        }
+    }
+};
+
+TEST(PacketBuilderTest, CompleteDatagram)
+{
+    SmartPacketBuilder Test(0);
+    Test.Batch({1200, 1000, 37});
+    ASSERT_EQ(3u, (uint32_t)Test.Builder.TotalCountDatagrams);
+    ASSERT_EQ(2237u, Test.Builder.TotalDatagramsLength);
+    ASSERT_EQ(1200u, Test.Datagrams[0].Length);
+    ASSERT_EQ(1000u, Test.Datagrams[1].Length);
+    ASSERT_EQ(37u, Test.Datagrams[2].Length);
+    ASSERT_EQ(nullptr, Test.Builder.Datagram);
+    ASSERT_EQ(0u, (uint32_t)Test.Builder.DatagramLength);
+}
+
+TEST(PacketBuilderTest, BatchTxTime)
+{
+    const uint64_t PacingRate = 1000000; // bytes per second, so 1 byte per us
+    const uint64_t Start = 1000000;
+    SmartPacketBuilder Test(PacingRate);
+
+    //
+    // The first batch leaves now.
+    //
+    Test.Batch({1200, 1200});
+    ASSERT_EQ(Start, QuicPacketBuilderGetBatchTxTime(&Test.Builder, Start));
+    ASSERT_EQ(Start + 2400, Test.Connection->Send.NextTxTime);
+
+    //
+    // Batches built before the previous one drained leave one after another,
+    // each spaced by the previous one's length at the pacing rate.
+    //
+    Test.Batch({1200, 1200, 1200, 1200});
+    ASSERT_EQ(Start + 2400, QuicPacketBuilderGetBatchTxTime(&Test.Builder, Start + 10));
+    ASSERT_EQ(Start + 7200, Test.Connection->Send.NextTxTime);
+
+    Test.Batch({600});
+    ASSERT_EQ(Start + 7200, QuicPacketBuilderGetBatchTxTime(&Test.Builder, Start + 20));
+    ASSERT_EQ(Start + 7800, Test.Connection->Send.NextTxTime);
+
+    //
+    // After going idle, the next batch leaves now again.
+    //
+    Test.Batch({1200});
+    ASSERT_EQ(Start + 100000, QuicPacketBuilderGetBatchTxTime(&Test.Builder, Start + 100000));
+    ASSERT_EQ(Start + 101200, Test.Connection->Send.NextTxTime);
+
+    //
+    // The spacing scales with the pacing rate.
+    //
+    Test.Builder.PacingRate = PacingRate * 4;
+    Test.Batch({1200, 1200});
+    ASSERT_EQ(Start + 101200, QuicPacketBuilderGetBatchTxTime(&Test.Builder, Start + 100001));
+    ASSERT_EQ(Start + 101800, Test.Connection->Send.NextTxTime);
+}
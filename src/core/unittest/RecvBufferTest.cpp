@@ -0,0 +1,408 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_RECV_BUFFER stream reassembly buffer.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "RecvBufferTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+struct SmartRecvBuffer {
+    QUIC_RECV_BUFFER RecvBuf;
+    CXPLAT_POOL ChunkPool;
+    bool Chunked;
+    SmartRecvBuffer(
+        bool Chunked,
+        uint32_t AllocBufferLength = QUIC_RECV_BUFFER_CHUNK_SIZE,
+        uint32_t VirtualBufferLength = 0x100000
+        ) : Chunked(Chunked) {
+        CxPlatPoolInitialize(FALSE, QUIC_RECV_BUFFER_CHUNK_SIZE, QUIC_POOL_TEST, &ChunkPool);
+        EXPECT_EQ(
+            QUIC_STATUS_SUCCESS,
+            QuicRecvBufferInitialize(
+                &RecvBuf,
+                AllocBufferLength,
+                VirtualBufferLength,
+                FALSE,
+                Chunked ? &ChunkPool : NULL));
+    }
+    ~SmartRecvBuffer() {
+        QuicRecvBufferUninitialize(&RecvBuf);
+        CxPlatPoolUninitialize(&ChunkPool);
+    }
+    //
+    // Writes bytes whose value is derived from their stream offset.
+    //
+    QUIC_STATUS Write(uint64_t Offset, uint16_t Length, BOOLEAN* ReadyToRead) {
+        std::vector<uint8_t> Data(Length);
+        for (uint16_t i = 0; i < Length; ++i) {
+            Data[i] = (uint8_t)(Offset + i);
+        }
+        uint64_t WriteLength = UINT64_MAX;
+        return QuicRecvBufferWrite(&RecvBuf, Offset, Length, Data.data(), &WriteLength, ReadyToRead);
+    }
+    //
+    // Reads everything available and validates it, returning the length.
+    //
+    uint64_t ReadAndValidate(uint32_t* BufferCount) {
+        QUIC_BUFFER Buffers[QUIC_MAX_RECEIVE_BUFFER_COUNT];
+        uint64_t Offset;
+        if (!QuicRecvBufferRead(&RecvBuf, &Offset, BufferCount, Buffers)) {
+            return 0;
+        }
+        uint64_t Length = 0;
+        for (uint32_t i = 0; i < *BufferCount; ++i) {
+            for (uint32_t j = 0; j < Buffers[i].Length; ++j) {
+                EXPECT_EQ((uint8_t)(Offset + Length + j), Buffers[i].Buffer[j]);
+            }
+            Length += Buffers[i].Length;
+        }
+        return Length;
+    }
+};
+
+TEST(RecvBufferTest, CircularWriteReadDrain)
+{
+    SmartRecvBuffer Buffer(false);
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 1000, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+
+    uint32_t BufferCount = 2;
+    ASSERT_EQ(1000ull, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_EQ(1u, BufferCount);
+    ASSERT_TRUE(QuicRecvBufferDrain(&Buffer.RecvBuf, 1000));
+
+    //
+    // Growing the circular buffer reallocates it.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(1000, 1000, &ReadyToRead));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(2000 + QUIC_RECV_BUFFER_CHUNK_SIZE, 1000, &ReadyToRead));
+    ASSERT_EQ(2u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+}
+
+TEST(RecvBufferTest, ChunkedWriteAcrossChunks)
+{
+    SmartRecvBuffer Buffer(true);
+    ASSERT_EQ((uint32_t)QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+
+    //
+    // Fill three chunks with writes that straddle the chunk boundaries.
+    //
+    BOOLEAN ReadyToRead;
+    const uint16_t WriteLength = 1000;
+    const uint64_t TotalLength = 3 * QUIC_RECV_BUFFER_CHUNK_SIZE;
+    for (uint64_t Offset = 0; Offset < TotalLength; Offset += WriteLength) {
+        const uint16_t Length = (uint16_t)CXPLAT_MIN(WriteLength, TotalLength - Offset);
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(Offset, Length, &ReadyToRead));
+        ASSERT_TRUE(ReadyToRead);
+    }
+    ASSERT_EQ(3u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+
+    uint32_t BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    ASSERT_EQ(TotalLength, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_EQ(3u, BufferCount);
+    ASSERT_TRUE(QuicRecvBufferDrain(&Buffer.RecvBuf, TotalLength));
+}
+
+TEST(RecvBufferTest, ChunkedGrowDoesNotMoveData)
+{
+    SmartRecvBuffer Buffer(true);
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 100, &ReadyToRead));
+    uint8_t* FirstChunk = Buffer.RecvBuf.Chunks[Buffer.RecvBuf.FirstChunk].Buffer;
+
+    //
+    // An out of order write far ahead adds chunks (and grows the chunk pointer
+    // array past its inline slots) without touching the existing bytes.
+    //
+    const uint64_t FarOffset = 20 * QUIC_RECV_BUFFER_CHUNK_SIZE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(FarOffset, 100, &ReadyToRead));
+    ASSERT_FALSE(ReadyToRead);
+    ASSERT_EQ(21u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+    ASSERT_NE(Buffer.RecvBuf.InlineChunks, Buffer.RecvBuf.Chunks);
+    ASSERT_EQ(FirstChunk, Buffer.RecvBuf.Chunks[Buffer.RecvBuf.FirstChunk].Buffer);
+
+    //
+    // Fill the gap; everything is then readable.
+    //
+    for (uint64_t Offset = 100; Offset < FarOffset; Offset += 1000) {
+        const uint16_t Length = (uint16_t)CXPLAT_MIN(1000, FarOffset - Offset);
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(Offset, Length, &ReadyToRead));
+    }
+    uint64_t Read = 0;
+    while (Read < FarOffset + 100) {
+        uint32_t BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+        uint64_t Length = Buffer.ReadAndValidate(&BufferCount);
+        ASSERT_NE(0ull, Length);
+        Read += Length;
+        QuicRecvBufferDrain(&Buffer.RecvBuf, Length);
+    }
+    ASSERT_EQ(FarOffset + 100, Read);
+}
+
+TEST(RecvBufferTest, ChunkedPartialRead)
+{
+    SmartRecvBuffer Buffer(true);
+    BOOLEAN ReadyToRead;
+    const uint64_t TotalLength = 4 * QUIC_RECV_BUFFER_CHUNK_SIZE;
+    for (uint64_t Offset = 0; Offset < TotalLength; Offset += 1000) {
+        const uint16_t Length = (uint16_t)CXPLAT_MIN(1000, TotalLength - Offset);
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(Offset, Length, &ReadyToRead));
+    }
+
+    //
+    // Only as many chunks as there are buffers are returned.
+    //
+    uint32_t BufferCount = 2;
+    ASSERT_EQ(2ull * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_EQ(2u, BufferCount);
+
+    //
+    // Draining part of the data frees the chunks that were fully consumed.
+    //
+    ASSERT_FALSE(QuicRecvBufferDrain(&Buffer.RecvBuf, QUIC_RECV_BUFFER_CHUNK_SIZE + 10));
+    ASSERT_EQ(3u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+    ASSERT_EQ(10u, Buffer.RecvBuf.BufferStart);
+
+    BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    ASSERT_EQ(3ull * QUIC_RECV_BUFFER_CHUNK_SIZE - 10, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_EQ(3u, BufferCount);
+    ASSERT_TRUE(QuicRecvBufferDrain(&Buffer.RecvBuf, 3ull * QUIC_RECV_BUFFER_CHUNK_SIZE - 10));
+}
+
+TEST(RecvBufferTest, ChunkedWindowLimit)
+{
+    SmartRecvBuffer Buffer(true, QUIC_RECV_BUFFER_CHUNK_SIZE, 2 * QUIC_RECV_BUFFER_CHUNK_SIZE);
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        Buffer.Write(2 * QUIC_RECV_BUFFER_CHUNK_SIZE - 10, 20, &ReadyToRead));
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        Buffer.Write(2 * QUIC_RECV_BUFFER_CHUNK_SIZE - 20, 20, &ReadyToRead));
+    ASSERT_EQ(2u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+}
+
+TEST(RecvBufferTest, ChunkedReset)
+{
+    SmartRecvBuffer Buffer(true);
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 1000, &ReadyToRead));
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        Buffer.Write(10 * QUIC_RECV_BUFFER_CHUNK_SIZE, 1000, &ReadyToRead));
+    ASSERT_NE(Buffer.RecvBuf.InlineChunks, Buffer.RecvBuf.Chunks);
+    uint8_t* FirstChunk = Buffer.RecvBuf.Chunks[Buffer.RecvBuf.FirstChunk].Buffer;
+
+    //
+    // Resetting drops the buffered data and the extra chunks, but keeps the
+    // first ones.
+    //
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicRecvBufferReset(&Buffer.RecvBuf, 2 * QUIC_RECV_BUFFER_CHUNK_SIZE, 0x10000));
+    ASSERT_EQ(2u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+    ASSERT_EQ(0x10000u, Buffer.RecvBuf.VirtualBufferLength);
+    ASSERT_EQ(Buffer.RecvBuf.InlineChunks, Buffer.RecvBuf.Chunks);
+    ASSERT_EQ(FirstChunk, Buffer.RecvBuf.Chunks[Buffer.RecvBuf.FirstChunk].Buffer);
+    ASSERT_FALSE(QuicRecvBufferHasUnreadData(&Buffer.RecvBuf));
+
+    //
+    // The buffer then works like a newly initialized one.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 1000, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+    uint32_t BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    ASSERT_EQ(1000ull, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_TRUE(QuicRecvBufferDrain(&Buffer.RecvBuf, 1000));
+
+    //
+    // Growing on reset adds chunks.
+    //
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicRecvBufferReset(&Buffer.RecvBuf, 4 * QUIC_RECV_BUFFER_CHUNK_SIZE, 0x10000));
+    ASSERT_EQ(4u * QUIC_RECV_BUFFER_CHUNK_SIZE, Buffer.RecvBuf.AllocBufferLength);
+    ASSERT_EQ(0ull, Buffer.RecvBuf.BaseOffset);
+}
+
+TEST(RecvBufferTest, AppOwnedWriteInPlace)
+{
+    SmartRecvBuffer Buffer(true, 0, 2048);
+
+    //
+    // Buffers covering the whole window replace the pooled chunks.
+    //
+    uint8_t AppMemory[3000];
+    QUIC_BUFFER AppBuffers[] = {
+        { 1000, AppMemory }, { 500, AppMemory + 1000 }, { 1500, AppMemory + 1500 }
+    };
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicRecvBufferProvideChunks(&Buffer.RecvBuf, 3, AppBuffers));
+    ASSERT_TRUE(Buffer.RecvBuf.AppOwned);
+    ASSERT_EQ(0u, Buffer.RecvBuf.PooledChunkCount);
+    ASSERT_EQ(3u, Buffer.RecvBuf.ChunkCount);
+    ASSERT_EQ(3000u, Buffer.RecvBuf.VirtualBufferLength);
+
+    //
+    // Data lands directly in the app's memory, across buffer boundaries.
+    //
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(900, 700, &ReadyToRead));
+    ASSERT_FALSE(ReadyToRead);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 900, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+    for (uint32_t i = 0; i < 1600; ++i) {
+        ASSERT_EQ((uint8_t)i, AppMemory[i]);
+    }
+    ASSERT_EQ(QUIC_STATUS_BUFFER_TOO_SMALL, Buffer.Write(2900, 101, &ReadyToRead));
+
+    QUIC_BUFFER Buffers[QUIC_MAX_RECEIVE_BUFFER_COUNT];
+    uint32_t BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    uint64_t Offset;
+    ASSERT_TRUE(QuicRecvBufferRead(&Buffer.RecvBuf, &Offset, &BufferCount, Buffers));
+    ASSERT_EQ(3u, BufferCount);
+    ASSERT_EQ(AppMemory, Buffers[0].Buffer);
+    ASSERT_EQ(1000u, Buffers[0].Length);
+    ASSERT_EQ(500u, Buffers[1].Length);
+    ASSERT_EQ(AppMemory + 1500, Buffers[2].Buffer);
+    ASSERT_EQ(100u, Buffers[2].Length);
+}
+
+TEST(RecvBufferTest, AppOwnedKeepsEarlyData)
+{
+    SmartRecvBuffer Buffer(true, QUIC_RECV_BUFFER_CHUNK_SIZE, 2 * QUIC_RECV_BUFFER_CHUNK_SIZE);
+
+    //
+    // The peer sends before the app provides anything.
+    //
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 1000, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+
+    //
+    // The buffered data stays in pooled chunks, which are topped up to cover
+    // the window the peer already has; the app's buffers come after it.
+    //
+    uint8_t AppMemory[2000];
+    QUIC_BUFFER AppBuffers[] = { { 1000, AppMemory }, { 1000, AppMemory + 1000 } };
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicRecvBufferProvideChunks(&Buffer.RecvBuf, 2, AppBuffers));
+    ASSERT_TRUE(Buffer.RecvBuf.AppOwned);
+    ASSERT_EQ(2u, Buffer.RecvBuf.PooledChunkCount);
+    ASSERT_EQ(4u, Buffer.RecvBuf.ChunkCount);
+    ASSERT_EQ(
+        2ull * QUIC_RECV_BUFFER_CHUNK_SIZE + 2000,
+        Buffer.RecvBuf.BaseOffset + Buffer.RecvBuf.VirtualBufferLength);
+
+    //
+    // The rest of the original window can still be received, and what follows
+    // it lands in the app's memory.
+    //
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        Buffer.Write(1000, 2 * QUIC_RECV_BUFFER_CHUNK_SIZE - 1000, &ReadyToRead));
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        Buffer.Write(2 * QUIC_RECV_BUFFER_CHUNK_SIZE, 1500, &ReadyToRead));
+    for (uint32_t i = 0; i < 1500; ++i) {
+        ASSERT_EQ((uint8_t)(2 * QUIC_RECV_BUFFER_CHUNK_SIZE + i), AppMemory[i]);
+    }
+    ASSERT_EQ(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        Buffer.Write(2 * QUIC_RECV_BUFFER_CHUNK_SIZE + 1500, 501, &ReadyToRead));
+
+    uint32_t BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    ASSERT_EQ(2ull * QUIC_RECV_BUFFER_CHUNK_SIZE + 1500, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_EQ(4u, BufferCount);
+
+    //
+    // Draining returns the pooled chunks and then hands back the app's.
+    //
+    ASSERT_FALSE(QuicRecvBufferDrain(&Buffer.RecvBuf, 2ull * QUIC_RECV_BUFFER_CHUNK_SIZE + 1000));
+    ASSERT_EQ(0u, Buffer.RecvBuf.PooledChunkCount);
+    ASSERT_EQ(1u, Buffer.RecvBuf.ChunkCount);
+    ASSERT_EQ(AppMemory + 1000, Buffer.RecvBuf.Chunks[Buffer.RecvBuf.FirstChunk].Buffer);
+}
+
+TEST(RecvBufferTest, AppOwnedPartialWindow)
+{
+    SmartRecvBuffer Buffer(true, QUIC_RECV_BUFFER_CHUNK_SIZE, 2 * QUIC_RECV_BUFFER_CHUNK_SIZE);
+
+    //
+    // Even with nothing received, buffers smaller than the window the peer
+    // already has go after pooled chunks covering it, so the peer can't
+    // overrun them.
+    //
+    uint8_t AppMemory[1000];
+    QUIC_BUFFER AppBuffer = { sizeof(AppMemory), AppMemory };
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicRecvBufferProvideChunks(&Buffer.RecvBuf, 1, &AppBuffer));
+    ASSERT_EQ(2u, Buffer.RecvBuf.PooledChunkCount);
+    ASSERT_EQ(
+        2ull * QUIC_RECV_BUFFER_CHUNK_SIZE + sizeof(AppMemory),
+        Buffer.RecvBuf.VirtualBufferLength);
+
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 2 * QUIC_RECV_BUFFER_CHUNK_SIZE, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+}
+
+TEST(RecvBufferTest, AppOwnedDrainKeepsWindowEnd)
+{
+    SmartRecvBuffer Buffer(true, 0, 1024);
+
+    uint8_t AppMemory[2000];
+    QUIC_BUFFER AppBuffers[] = { { 1000, AppMemory }, { 1000, AppMemory + 1000 } };
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, QuicRecvBufferProvideChunks(&Buffer.RecvBuf, 2, AppBuffers));
+
+    BOOLEAN ReadyToRead;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(0, 1200, &ReadyToRead));
+    uint32_t BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    ASSERT_EQ(1200ull, Buffer.ReadAndValidate(&BufferCount));
+
+    //
+    // Draining hands the first buffer back, but the window still ends after
+    // the last provided buffer, and the drained space isn't reused.
+    //
+    ASSERT_TRUE(QuicRecvBufferDrain(&Buffer.RecvBuf, 1200));
+    ASSERT_EQ(1u, Buffer.RecvBuf.ChunkCount);
+    ASSERT_EQ(200u, Buffer.RecvBuf.BufferStart);
+    ASSERT_EQ(2000ull, Buffer.RecvBuf.BaseOffset + Buffer.RecvBuf.VirtualBufferLength);
+    ASSERT_EQ(QUIC_STATUS_BUFFER_TOO_SMALL, Buffer.Write(1200, 801, &ReadyToRead));
+
+    //
+    // More buffers extend the window. Enough of them grow the chunk array past
+    // its inline slots.
+    //
+    std::vector<uint8_t> MoreMemory(8 * 100);
+    std::vector<QUIC_BUFFER> MoreBuffers(8);
+    for (uint32_t i = 0; i < 8; ++i) {
+        MoreBuffers[i].Length = 100;
+        MoreBuffers[i].Buffer = MoreMemory.data() + i * 100;
+    }
+    ASSERT_EQ(
+        QUIC_STATUS_SUCCESS,
+        QuicRecvBufferProvideChunks(&Buffer.RecvBuf, 8, MoreBuffers.data()));
+    ASSERT_NE(Buffer.RecvBuf.InlineChunks, Buffer.RecvBuf.Chunks);
+    ASSERT_EQ(2800ull, Buffer.RecvBuf.BaseOffset + Buffer.RecvBuf.VirtualBufferLength);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Buffer.Write(1200, 1600, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+    for (uint32_t i = 0; i < 800; ++i) {
+        ASSERT_EQ((uint8_t)(2000 + i), MoreMemory[i]);
+    }
+
+    BufferCount = QUIC_MAX_RECEIVE_BUFFER_COUNT;
+    ASSERT_EQ(1600ull, Buffer.ReadAndValidate(&BufferCount));
+    ASSERT_EQ(9u, BufferCount);
+    ASSERT_TRUE(QuicRecvBufferDrain(&Buffer.RecvBuf, 1600));
+    ASSERT_EQ(0u, Buffer.RecvBuf.ChunkCount);
+    ASSERT_EQ(0u, Buffer.RecvBuf.VirtualBufferLength);
+}
@@ -0,0 +1,274 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for copying buffered send requests into send buffer slabs.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SendBufferTest.cpp.clog.h"
+#endif
+
+#include <memory>
+#include <vector>
+
+//
+// g++ doesn't support the anonymous QUIC_HANDLE member that starts
+// QUIC_CONNECTION, so C++ code sees the other connection fields at a different
+// offset than the core does. The connection is laid out the core's way, and
+// its fields are accessed through Conn.
+//
+const size_t SendBufferConnHandleSize =
+    offsetof(QUIC_CONNECTION, RegistrationLink) == 0 ? sizeof(QUIC_HANDLE) : 0;
+
+const uint32_t SlabHeader = (uint32_t)sizeof(QUIC_SEND_BUFFER_SLAB);
+
+//
+// A send buffer in a zeroed connection, whose worker has just its slab pools.
+//
+struct SmartSendBuffer {
+    std::vector<uint64_t> Memory;
+    std::unique_ptr<QUIC_WORKER> Worker {new QUIC_WORKER()};
+    QUIC_CONNECTION* Conn;
+    QUIC_SEND_BUFFER* SendBuffer;
+
+    SmartSendBuffer() :
+        Memory((sizeof(QUIC_CONNECTION) + SendBufferConnHandleSize + 7) / 8) {
+        for (uint32_t i = 0; i < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT; ++i) {
+            CxPlatPoolInitialize(
+                FALSE,
+                QUIC_SEND_BUFFER_SLAB_SIZE(i),
+                QUIC_POOL_SENDBUF_SLAB,
+                &Worker->SendBufferSlabPools[i]);
+        }
+        Conn = (QUIC_CONNECTION*)((uint8_t*)Memory.data() + SendBufferConnHandleSize);
+        Conn->Worker = Worker.get();
+        SendBuffer = &Conn->SendBuffer;
+        QuicSendBufferInitialize(SendBuffer);
+    }
+
+    ~SmartSendBuffer() {
+        QuicSendBufferUninitialize(SendBuffer);
+        EXPECT_EQ(0ull, SendBuffer->AllocatedBytes);
+        EXPECT_EQ(0ull, SendBuffer->BufferedBytes);
+        for (uint32_t i = 0; i < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT; ++i) {
+            CxPlatPoolUninitialize(&Worker->SendBufferSlabPools[i]);
+        }
+    }
+
+    struct Request {
+        uint8_t* Buf;
+        uint32_t Size;
+        QUIC_SEND_BUFFER_SLAB* Slab;
+    };
+
+    Request Alloc(uint32_t Size) {
+        Request Req = { nullptr, Size, nullptr };
+        Req.Buf = QuicSendBufferAlloc(SendBuffer, Size, &Req.Slab);
+        EXPECT_NE(nullptr, Req.Buf);
+        if (Req.Buf != nullptr) {
+            CxPlatZeroMemory(Req.Buf, Size);
+        }
+        return Req;
+    }
+
+    void Free(const Request& Req) {
+        QuicSendBufferFree(SendBuffer, Req.Buf, Req.Size, Req.Slab);
+    }
+};
+
+TEST(SendBufferTest, SharedSlabCarving)
+{
+    SmartSendBuffer Test;
+
+    //
+    // Small requests are carved one after the other out of one shared slab.
+    //
+    auto A = Test.Alloc(100);
+    auto B = Test.Alloc(200);
+    auto C = Test.Alloc(QUIC_SEND_BUFFER_COALESCE_MAX);
+    ASSERT_NE(nullptr, A.Slab);
+    ASSERT_EQ(A.Slab, B.Slab);
+    ASSERT_EQ(A.Slab, C.Slab);
+    ASSERT_EQ(A.Slab, Test.SendBuffer->CurrentSlab);
+    ASSERT_EQ((uint8_t*)(A.Slab + 1), A.Buf);
+    ASSERT_EQ(A.Buf + 100, B.Buf);
+    ASSERT_EQ(B.Buf + 200, C.Buf);
+    ASSERT_EQ(300u + QUIC_SEND_BUFFER_COALESCE_MAX, A.Slab->Used);
+    ASSERT_EQ(QUIC_SEND_BUFFER_SLAB_SIZE(0) - SlabHeader, A.Slab->Size);
+    ASSERT_EQ(4u, A.Slab->RefCount);
+    ASSERT_EQ((uint64_t)QUIC_SEND_BUFFER_SLAB_SIZE(0), Test.SendBuffer->AllocatedBytes);
+    ASSERT_EQ(300ull + QUIC_SEND_BUFFER_COALESCE_MAX, Test.SendBuffer->BufferedBytes);
+
+    //
+    // Freeing some of them doesn't give any of the slab back.
+    //
+    Test.Free(B);
+    ASSERT_EQ(3u, A.Slab->RefCount);
+    ASSERT_EQ(300u + QUIC_SEND_BUFFER_COALESCE_MAX, A.Slab->Used);
+    ASSERT_EQ(100ull + QUIC_SEND_BUFFER_COALESCE_MAX, Test.SendBuffer->BufferedBytes);
+
+    Test.Free(A);
+    Test.Free(C);
+}
+
+TEST(SendBufferTest, SharedSlabReuse)
+{
+    SmartSendBuffer Test;
+
+    auto A = Test.Alloc(100);
+    auto B = Test.Alloc(100);
+    QUIC_SEND_BUFFER_SLAB* Slab = A.Slab;
+
+    //
+    // Once the send buffer holds the only reference, the slab is reused from
+    // offset 0.
+    //
+    Test.Free(A);
+    ASSERT_EQ(200u, Slab->Used);
+    Test.Free(B);
+    ASSERT_EQ(1u, Slab->RefCount);
+    ASSERT_EQ(0u, Slab->Used);
+    ASSERT_EQ(Slab, Test.SendBuffer->CurrentSlab);
+    ASSERT_EQ((uint64_t)QUIC_SEND_BUFFER_SLAB_SIZE(0), Test.SendBuffer->AllocatedBytes);
+
+    auto C = Test.Alloc(50);
+    ASSERT_EQ(Slab, C.Slab);
+    ASSERT_EQ((uint8_t*)(Slab + 1), C.Buf);
+    Test.Free(C);
+}
+
+TEST(SendBufferTest, SharedSlabReplaced)
+{
+    SmartSendBuffer Test;
+    const uint32_t SlabSize = QUIC_SEND_BUFFER_SLAB_SIZE(0);
+    const uint32_t PerSlab = (SlabSize - SlabHeader) / QUIC_SEND_BUFFER_COALESCE_MAX;
+
+    std::vector<SmartSendBuffer::Request> Requests;
+    for (uint32_t i = 0; i < PerSlab; ++i) {
+        Requests.push_back(Test.Alloc(QUIC_SEND_BUFFER_COALESCE_MAX));
+        ASSERT_EQ(Requests[0].Slab, Requests[i].Slab);
+    }
+    QUIC_SEND_BUFFER_SLAB* First = Requests[0].Slab;
+
+    //
+    // A request that doesn't fit in what's left starts a new shared slab.
+    // The old one lives on until its requests are freed.
+    //
+    auto Next = Test.Alloc(QUIC_SEND_BUFFER_COALESCE_MAX);
+    ASSERT_NE(First, Next.Slab);
+    ASSERT_EQ(Next.Slab, Test.SendBuffer->CurrentSlab);
+    ASSERT_EQ(PerSlab, First->RefCount);
+    ASSERT_EQ(2ull * SlabSize, Test.SendBuffer->AllocatedBytes);
+
+    for (auto& Req : Requests) {
+        Test.Free(Req);
+    }
+    ASSERT_EQ((uint64_t)SlabSize, Test.SendBuffer->AllocatedBytes);
+    ASSERT_EQ((uint64_t)QUIC_SEND_BUFFER_COALESCE_MAX, Test.SendBuffer->BufferedBytes);
+    Test.Free(Next);
+}
+
+TEST(SendBufferTest, ClassSelection)
+{
+    SmartSendBuffer Test;
+
+    //
+    // Larger requests get a slab of their own, of the smallest class whose
+    // data fits them.
+    //
+    for (uint32_t Class = 1; Class < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT; ++Class) {
+        const uint32_t SlabSize = QUIC_SEND_BUFFER_SLAB_SIZE(Class);
+
+        auto Lower = Test.Alloc(QUIC_SEND_BUFFER_SLAB_SIZE(Class - 1) - SlabHeader + 1);
+        ASSERT_NE(nullptr, Lower.Slab);
+        ASSERT_EQ(&Test.Worker->SendBufferSlabPools[Class], Lower.Slab->Pool);
+        ASSERT_EQ((uint8_t*)(Lower.Slab + 1), Lower.Buf);
+        ASSERT_EQ(1u, Lower.Slab->RefCount);
+
+        auto Exact = Test.Alloc(SlabSize - SlabHeader);
+        ASSERT_NE(nullptr, Exact.Slab);
+        ASSERT_EQ(&Test.Worker->SendBufferSlabPools[Class], Exact.Slab->Pool);
+        ASSERT_EQ(SlabSize - SlabHeader, Exact.Slab->Used);
+        ASSERT_EQ(2ull * SlabSize, Test.SendBuffer->AllocatedBytes);
+
+        Test.Free(Lower);
+        Test.Free(Exact);
+        ASSERT_EQ(0ull, Test.SendBuffer->AllocatedBytes);
+    }
+
+    //
+    // One byte over the smallest class's data size goes to the next class.
+    //
+    auto Small = Test.Alloc(QUIC_SEND_BUFFER_COALESCE_MAX + 1);
+    ASSERT_NE(nullptr, Small.Slab);
+    ASSERT_EQ(&Test.Worker->SendBufferSlabPools[1], Small.Slab->Pool);
+    Test.Free(Small);
+}
+
+TEST(SendBufferTest, LargeRequestFallback)
+{
+    SmartSendBuffer Test;
+    const uint32_t Largest =
+        QUIC_SEND_BUFFER_SLAB_SIZE(QUIC_SEND_BUFFER_SLAB_CLASS_COUNT - 1) - SlabHeader;
+
+    //
+    // Requests too big for the largest class are allocated separately, and
+    // account for exactly their size.
+    //
+    auto Big = Test.Alloc(Largest + 1);
+    ASSERT_EQ(nullptr, Big.Slab);
+    ASSERT_EQ((uint64_t)Largest + 1, Test.SendBuffer->AllocatedBytes);
+    ASSERT_EQ((uint64_t)Largest + 1, Test.SendBuffer->BufferedBytes);
+
+    auto Huge = Test.Alloc(1024 * 1024);
+    ASSERT_EQ(nullptr, Huge.Slab);
+    ASSERT_EQ((uint64_t)Largest + 1 + 1024 * 1024, Test.SendBuffer->AllocatedBytes);
+
+    Test.Free(Big);
+    ASSERT_EQ(1024ull * 1024, Test.SendBuffer->AllocatedBytes);
+    ASSERT_EQ(1024ull * 1024, Test.SendBuffer->BufferedBytes);
+    Test.Free(Huge);
+}
+
+TEST(SendBufferTest, Accounting)
+{
+    SmartSendBuffer Test;
+    const uint32_t Sizes[] = {
+        1, 10, 1000, QUIC_SEND_BUFFER_COALESCE_MAX, 5000, 20000, 70000, 3, 16000
+    };
+
+    std::vector<SmartSendBuffer::Request> Requests;
+    uint64_t Buffered = 0;
+    for (uint32_t Size : Sizes) {
+        Requests.push_back(Test.Alloc(Size));
+        Buffered += Size;
+        ASSERT_EQ(Buffered, Test.SendBuffer->BufferedBytes);
+        ASSERT_GE(Test.SendBuffer->AllocatedBytes, Test.SendBuffer->BufferedBytes);
+    }
+
+    //
+    // 4KB shared slab: 1, 10, 1000, 1024, 3. 16KB: 5000, 16000. 64KB: 20000.
+    // Separately: 70000.
+    //
+    ASSERT_EQ(
+        (uint64_t)QUIC_SEND_BUFFER_SLAB_SIZE(0) + 2 * QUIC_SEND_BUFFER_SLAB_SIZE(1) +
+            QUIC_SEND_BUFFER_SLAB_SIZE(2) + 70000,
+        Test.SendBuffer->AllocatedBytes);
+
+    for (auto& Req : Requests) {
+        Test.Free(Req);
+        Buffered -= Req.Size;
+        ASSERT_EQ(Buffered, Test.SendBuffer->BufferedBytes);
+    }
+
+    //
+    // Only the (now empty) shared slab is still held.
+    //
+    ASSERT_EQ((uint64_t)QUIC_SEND_BUFFER_SLAB_SIZE(0), Test.SendBuffer->AllocatedBytes);
+}
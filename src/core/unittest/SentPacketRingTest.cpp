@@ -0,0 +1,256 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_SENT_PACKET_RING outstanding packet tracker, and a
+    benchmark of ACK processing cost as the number of in-flight packets grows.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "SentPacketRingTest.cpp.clog.h"
+#endif
+
+#include <vector>
+
+struct SmartSentPacketRing {
+    QUIC_SENT_PACKET_RING Ring;
+    std::vector<QUIC_SENT_PACKET_METADATA> Packets;
+    SmartSentPacketRing(uint64_t MaxPacketNumber) : Packets((size_t)MaxPacketNumber) {
+        QuicSentPacketRingInitialize(&Ring);
+        for (uint64_t i = 0; i < MaxPacketNumber; ++i) {
+            Packets[(size_t)i].PacketNumber = i;
+        }
+    }
+    ~SmartSentPacketRing() {
+        while (QuicSentPacketRingFirst(&Ring) != NULL) {
+            QuicSentPacketRingRemove(&Ring, QuicSentPacketRingFirst(&Ring)->PacketNumber);
+        }
+        QuicSentPacketRingUninitialize(&Ring);
+    }
+    void Push(uint64_t PacketNumber) {
+        ASSERT_TRUE(QuicSentPacketRingPush(&Ring, &Packets[(size_t)PacketNumber]));
+    }
+    bool Contains(uint64_t PacketNumber) {
+        QUIC_SENT_PACKET_METADATA* Packet = QuicSentPacketRingGet(&Ring, PacketNumber);
+        if (Packet != NULL) {
+            EXPECT_EQ(PacketNumber, Packet->PacketNumber);
+        }
+        return Packet != NULL;
+    }
+    void Remove(uint64_t PacketNumber) {
+        ASSERT_EQ(&Packets[(size_t)PacketNumber], QuicSentPacketRingRemove(&Ring, PacketNumber));
+    }
+};
+
+TEST(SentPacketRingTest, Empty)
+{
+    SmartSentPacketRing ring(1);
+    ASSERT_EQ(nullptr, QuicSentPacketRingFirst(&ring.Ring));
+    ASSERT_FALSE(ring.Contains(0));
+    ASSERT_EQ(nullptr, QuicSentPacketRingRemove(&ring.Ring, 0));
+    ASSERT_EQ(QuicSentPacketRingEnd(&ring.Ring), ring.Ring.BasePacketNumber);
+}
+
+TEST(SentPacketRingTest, PushRemoveInOrder)
+{
+    SmartSentPacketRing ring(100);
+    for (uint64_t i = 0; i < 100; ++i) {
+        ring.Push(i);
+    }
+    ASSERT_EQ(100u, ring.Ring.PacketCount);
+    for (uint64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(i, QuicSentPacketRingFirst(&ring.Ring)->PacketNumber);
+        ring.Remove(i);
+        ASSERT_FALSE(ring.Contains(i));
+    }
+    ASSERT_EQ(0u, ring.Ring.PacketCount);
+    ASSERT_EQ(nullptr, QuicSentPacketRingFirst(&ring.Ring));
+}
+
+TEST(SentPacketRingTest, Holes)
+{
+    SmartSentPacketRing ring(10);
+    ring.Push(0);
+    ring.Push(1);
+    ring.Push(2);
+    ring.Push(5); // 3 and 4 skipped
+    ASSERT_EQ(4u, ring.Ring.PacketCount);
+    ASSERT_EQ(6ull, QuicSentPacketRingEnd(&ring.Ring));
+    ASSERT_FALSE(ring.Contains(3));
+    ASSERT_FALSE(ring.Contains(4));
+    ASSERT_TRUE(ring.Contains(5));
+
+    //
+    // Removing from the middle leaves the ends untouched.
+    //
+    ring.Remove(1);
+    ASSERT_EQ(0ull, ring.Ring.BasePacketNumber);
+    ASSERT_EQ(nullptr, QuicSentPacketRingRemove(&ring.Ring, 1));
+
+    //
+    // Removing the head trims the holes after it.
+    //
+    ring.Remove(0);
+    ASSERT_EQ(2ull, ring.Ring.BasePacketNumber);
+    ASSERT_EQ(2ull, QuicSentPacketRingFirst(&ring.Ring)->PacketNumber);
+
+    //
+    // Removing the tail leaves a hole there.
+    //
+    ring.Remove(5);
+    ASSERT_EQ(6ull, QuicSentPacketRingEnd(&ring.Ring));
+    ASSERT_FALSE(ring.Contains(5));
+    ring.Remove(2);
+    ASSERT_EQ(0u, ring.Ring.Count);
+
+    //
+    // Once empty, the ring restarts at the next packet number pushed.
+    //
+    ring.Push(9);
+    ASSERT_EQ(9ull, ring.Ring.BasePacketNumber);
+    ASSERT_EQ(9ull, QuicSentPacketRingFirst(&ring.Ring)->PacketNumber);
+}
+
+TEST(SentPacketRingTest, GrowWrapped)
+{
+    SmartSentPacketRing ring(1000);
+    for (uint64_t i = 0; i < 50; ++i) {
+        ring.Push(i);
+    }
+    for (uint64_t i = 0; i < 40; ++i) {
+        ring.Remove(i);
+    }
+
+    //
+    // The head is now in the middle of the slots, so the ring wraps before it
+    // has to grow.
+    //
+    for (uint64_t i = 50; i < 1000; ++i) {
+        ring.Push(i);
+    }
+    ASSERT_EQ(960u, ring.Ring.PacketCount);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(i >= 40, ring.Contains(i));
+    }
+    for (uint64_t i = 999; i >= 40; --i) {
+        ring.Remove(i);
+    }
+    ASSERT_EQ(0u, ring.Ring.PacketCount);
+}
+
+//
+// Baseline for the benchmark below: the singly linked list and ACK block walk
+// loss detection used before the ring.
+//
+struct SentPacketList {
+    QUIC_SENT_PACKET_METADATA* Head {nullptr};
+    QUIC_SENT_PACKET_METADATA** Tail {&Head};
+    void Push(QUIC_SENT_PACKET_METADATA* Packet) {
+        Packet->Next = NULL;
+        *Tail = Packet;
+        Tail = &Packet->Next;
+    }
+    uint32_t Ack(uint64_t Low, uint64_t High) {
+        uint32_t Acked = 0;
+        QUIC_SENT_PACKET_METADATA** Start = &Head;
+        while (*Start && (*Start)->PacketNumber < Low) {
+            Start = &((*Start)->Next);
+        }
+        QUIC_SENT_PACKET_METADATA** End = Start;
+        while (*End && (*End)->PacketNumber <= High) {
+            Acked++;
+            End = &((*End)->Next);
+        }
+        if (Start != End) {
+            *Start = *End;
+            if (End == Tail) {
+                Tail = Start;
+            }
+        }
+        return Acked;
+    }
+};
+
+uint32_t
+RingAck(
+    QUIC_SENT_PACKET_RING* Ring,
+    uint64_t Low,
+    uint64_t High
+    )
+{
+    uint32_t Acked = 0;
+    uint64_t PacketNumber = CXPLAT_MAX(Low, Ring->BasePacketNumber);
+    const uint64_t End = CXPLAT_MIN(High + 1, QuicSentPacketRingEnd(Ring));
+    for (; PacketNumber < End; PacketNumber++) {
+        if (QuicSentPacketRingRemove(Ring, PacketNumber) != NULL) {
+            Acked++;
+        }
+    }
+    return Acked;
+}
+
+//
+// Keeps InFlight packets outstanding while each ACK frame acknowledges the two
+// most recently sent packets, with the oldest packets still waiting for their
+// ACK. This is the worst case for the list, which has to walk past every older
+// packet to find the ACK block, while the ring goes straight to it.
+//
+// Disabled by default since it measures rather than checks anything. Use
+// --gtest_also_run_disabled_tests to run it.
+//
+TEST(SentPacketRingTest, DISABLED_AckProcessingBenchmark)
+{
+    const uint32_t AckFrames = 2000;
+    for (uint32_t InFlight : { 64u, 512u, 4096u, 32768u }) {
+        const uint64_t MaxPacketNumber = InFlight + 2ull * AckFrames;
+        SmartSentPacketRing ring(MaxPacketNumber);
+        std::vector<QUIC_SENT_PACKET_METADATA> ListPackets((size_t)MaxPacketNumber);
+        SentPacketList list;
+        for (uint64_t i = 0; i < MaxPacketNumber; ++i) {
+            ListPackets[(size_t)i].PacketNumber = i;
+        }
+
+        uint64_t NextPacketNumber = 0;
+        for (; NextPacketNumber < InFlight; ++NextPacketNumber) {
+            ring.Push(NextPacketNumber);
+            list.Push(&ListPackets[(size_t)NextPacketNumber]);
+        }
+
+        const uint64_t FirstPacketNumber = NextPacketNumber;
+        uint32_t RingAcked = 0, ListAcked = 0;
+
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < AckFrames; ++i) {
+            ring.Push(NextPacketNumber);
+            ring.Push(NextPacketNumber + 1);
+            RingAcked += RingAck(&ring.Ring, NextPacketNumber, NextPacketNumber + 1);
+            NextPacketNumber += 2;
+        }
+        const uint64_t RingTime = CxPlatTimeUs64() - Start;
+
+        NextPacketNumber = FirstPacketNumber;
+        Start = CxPlatTimeUs64();
+        for (uint32_t i = 0; i < AckFrames; ++i) {
+            list.Push(&ListPackets[(size_t)NextPacketNumber]);
+            list.Push(&ListPackets[(size_t)NextPacketNumber + 1]);
+            ListAcked += list.Ack(NextPacketNumber, NextPacketNumber + 1);
+            NextPacketNumber += 2;
+        }
+        const uint64_t ListTime = CxPlatTimeUs64() - Start;
+
+        ASSERT_EQ(2 * AckFrames, RingAcked);
+        ASSERT_EQ(2 * AckFrames, ListAcked);
+        ASSERT_EQ(InFlight, ring.Ring.PacketCount);
+
+        std::cout
+            << "InFlight " << InFlight
+            << ": ring " << (RingTime * 1000.0 / AckFrames) << " ns/ACK"
+            << ", list " << (ListTime * 1000.0 / AckFrames) << " ns/ACK"
+            << std::endl;
+    }
+}
@@ -113,6 +113,12 @@ TEST(SettingsTest, TestAllSettingsFieldsSet)
     SETTINGS_FEATURE_SET_TEST(MigrationEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(DatagramReceiveEnabled, QuicSettingsSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(ServerResumptionLevel, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(EcnEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(L4sEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(PacingOffloadEnabled, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(DatagramSendTtlMs, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(DatagramSendQueueLimit, QuicSettingsSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(DatagramSendDropPolicy, QuicSettingsSettingsToInternal);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -127,6 +133,10 @@ TEST(SettingsTest, TestAllGlobalSettingsFieldsSet)
 
     SETTINGS_FEATURE_SET_TEST(RetryMemoryLimit, QuicSettingsGlobalSettingsToInternal);
     SETTINGS_FEATURE_SET_TEST(LoadBalancingMode, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(WorkerTimerSpinUs, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(StreamCacheSize, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(RecvWindowMemoryLimit, QuicSettingsGlobalSettingsToInternal);
+    SETTINGS_FEATURE_SET_TEST(CidSteeringEnabled, QuicSettingsGlobalSettingsToInternal);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -186,6 +196,12 @@ TEST(SettingsTest, TestAllSettingsFieldsGet)
     SETTINGS_FEATURE_GET_TEST(MigrationEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(DatagramReceiveEnabled, QuicSettingsGetSettings);
     SETTINGS_FEATURE_GET_TEST(ServerResumptionLevel, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(EcnEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(L4sEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(PacingOffloadEnabled, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(DatagramSendTtlMs, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(DatagramSendQueueLimit, QuicSettingsGetSettings);
+    SETTINGS_FEATURE_GET_TEST(DatagramSendDropPolicy, QuicSettingsGetSettings);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
@@ -201,6 +217,10 @@ TEST(SettingsTest, TestAllGlobalSettingsFieldsGet)
 
     SETTINGS_FEATURE_GET_TEST(RetryMemoryLimit, QuicSettingsGetGlobalSettings);
     SETTINGS_FEATURE_GET_TEST(LoadBalancingMode, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(WorkerTimerSpinUs, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(StreamCacheSize, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(RecvWindowMemoryLimit, QuicSettingsGetGlobalSettings);
+    SETTINGS_FEATURE_GET_TEST(CidSteeringEnabled, QuicSettingsGetGlobalSettings);
 
     Settings.IsSetFlags = 0;
     Settings.IsSet.RESERVED = ~Settings.IsSet.RESERVED;
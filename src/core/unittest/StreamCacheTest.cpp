@@ -0,0 +1,229 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the per-worker cache of freed streams.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "StreamCacheTest.cpp.clog.h"
+#endif
+
+#include <memory>
+#include <vector>
+
+//
+// g++ doesn't support the anonymous QUIC_HANDLE member that starts QUIC_STREAM,
+// so C++ code sees the other stream fields at a different offset than the core
+// does. Streams are laid out the core's way, and their fields are accessed
+// through CacheStreamFields.
+//
+const size_t CacheStreamHandleSize =
+    offsetof(QUIC_STREAM, RefCount) == 0 ? sizeof(QUIC_HANDLE) : 0;
+
+QUIC_STREAM* CacheStreamFields(QUIC_STREAM* Stream) {
+    return (QUIC_STREAM*)((uint8_t*)Stream + CacheStreamHandleSize);
+}
+
+const uint16_t TestStreamCacheSize = 4;
+
+//
+// A worker with just its stream pools and cache, and the library state the
+// cache uses (the StreamCacheSize setting and the perf counters), set up for
+// the duration of a test.
+//
+struct SmartStreamCache {
+    std::unique_ptr<QUIC_WORKER> Worker {new QUIC_WORKER()};
+    std::vector<QUIC_LIBRARY_PP> PerProc;
+    QUIC_LIBRARY_PP* SavedPerProc {MsQuicLib.PerProc};
+    uint16_t SavedPartitionCount {MsQuicLib.PartitionCount};
+    uint16_t SavedStreamCacheSize {MsQuicLib.Settings.StreamCacheSize};
+
+    SmartStreamCache() : PerProc(CxPlatProcMaxCount()) {
+        CxPlatZeroMemory(PerProc.data(), PerProc.size() * sizeof(QUIC_LIBRARY_PP));
+        MsQuicLib.PerProc = PerProc.data();
+        MsQuicLib.PartitionCount = (uint16_t)PerProc.size();
+        MsQuicLib.Settings.StreamCacheSize = TestStreamCacheSize;
+
+        CxPlatPoolInitialize(
+            FALSE,
+            (uint32_t)(sizeof(QUIC_STREAM) + CacheStreamHandleSize),
+            QUIC_POOL_STREAM,
+            &Worker->StreamPool);
+        CxPlatPoolInitialize(
+            FALSE,
+            QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE,
+            QUIC_POOL_SBUF,
+            &Worker->DefaultReceiveBufferPool);
+        CxPlatDispatchLockInitialize(&Worker->StreamCacheLock);
+    }
+
+    ~SmartStreamCache() {
+        QuicStreamCacheFlush(Worker.get());
+        EXPECT_EQ(0u, Worker->StreamCacheDepth);
+        CxPlatDispatchLockUninitialize(&Worker->StreamCacheLock);
+        CxPlatPoolUninitialize(&Worker->StreamPool);
+        CxPlatPoolUninitialize(&Worker->DefaultReceiveBufferPool);
+
+        MsQuicLib.Settings.StreamCacheSize = SavedStreamCacheSize;
+        MsQuicLib.PartitionCount = SavedPartitionCount;
+        MsQuicLib.PerProc = SavedPerProc;
+    }
+
+    int64_t Counter(QUIC_PERFORMANCE_COUNTERS Type) const {
+        int64_t Total = 0;
+        for (const QUIC_LIBRARY_PP& Proc : PerProc) {
+            Total += Proc.PerfCounters[Type];
+        }
+        return Total;
+    }
+
+    //
+    // A freed stream, as QuicStreamFree would hand it to the cache, with a
+    // receive buffer from ChunkPool.
+    //
+    QUIC_STREAM* NewStream(CXPLAT_POOL* ChunkPool) {
+        QUIC_STREAM* Stream = (QUIC_STREAM*)CxPlatPoolAlloc(&Worker->StreamPool);
+        if (Stream == nullptr) {
+            return nullptr;
+        }
+        CxPlatZeroMemory(Stream, sizeof(QUIC_STREAM) + CacheStreamHandleSize);
+        QUIC_STATUS Status =
+            QuicRecvBufferInitialize(
+                &CacheStreamFields(Stream)->RecvBuffer,
+                QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE,
+                QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE,
+                FALSE,
+                ChunkPool);
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, Status);
+        return Stream;
+    }
+
+    QUIC_STREAM* NewStream() {
+        return NewStream(&Worker->DefaultReceiveBufferPool);
+    }
+
+    void FreeStream(QUIC_STREAM* Stream) {
+        QuicRecvBufferUninitialize(&CacheStreamFields(Stream)->RecvBuffer);
+        CxPlatPoolFree(&Worker->StreamPool, Stream);
+    }
+};
+
+TEST(StreamCacheTest, ReleasedStreamIsReused)
+{
+    SmartStreamCache Cache;
+    QUIC_STREAM* Stream = Cache.NewStream();
+    ASSERT_NE(nullptr, Stream);
+
+    ASSERT_TRUE(QuicStreamCachePush(Cache.Worker.get(), Stream));
+    ASSERT_EQ(1u, Cache.Worker->StreamCacheDepth);
+
+    QUIC_STREAM* Reused = QuicStreamCachePop(Cache.Worker.get());
+    ASSERT_EQ(Stream, Reused);
+    ASSERT_EQ(0u, Cache.Worker->StreamCacheDepth);
+
+    //
+    // The cached stream still holds its receive buffer chunks.
+    //
+    ASSERT_EQ(
+        &Cache.Worker->DefaultReceiveBufferPool,
+        CacheStreamFields(Reused)->RecvBuffer.ChunkPool);
+    ASSERT_EQ(
+        CacheStreamFields(Reused)->RecvBuffer.InlineChunks,
+        CacheStreamFields(Reused)->RecvBuffer.Chunks);
+
+    ASSERT_EQ(nullptr, QuicStreamCachePop(Cache.Worker.get()));
+    Cache.FreeStream(Reused);
+}
+
+TEST(StreamCacheTest, CacheLimit)
+{
+    SmartStreamCache Cache;
+    QUIC_STREAM* Streams[TestStreamCacheSize + 1];
+    for (uint16_t i = 0; i < TestStreamCacheSize; ++i) {
+        Streams[i] = Cache.NewStream();
+        ASSERT_NE(nullptr, Streams[i]);
+        ASSERT_TRUE(QuicStreamCachePush(Cache.Worker.get(), Streams[i]));
+        ASSERT_EQ((uint32_t)i + 1, Cache.Worker->StreamCacheDepth);
+    }
+
+    //
+    // Once the cache is full, freed streams are rejected and must be freed by
+    // the caller.
+    //
+    Streams[TestStreamCacheSize] = Cache.NewStream();
+    ASSERT_NE(nullptr, Streams[TestStreamCacheSize]);
+    ASSERT_FALSE(QuicStreamCachePush(Cache.Worker.get(), Streams[TestStreamCacheSize]));
+    ASSERT_EQ((uint32_t)TestStreamCacheSize, Cache.Worker->StreamCacheDepth);
+    Cache.FreeStream(Streams[TestStreamCacheSize]);
+
+    //
+    // Streams come back most recently freed first.
+    //
+    QUIC_STREAM* Reused = QuicStreamCachePop(Cache.Worker.get());
+    ASSERT_EQ(Streams[TestStreamCacheSize - 1], Reused);
+    ASSERT_TRUE(QuicStreamCachePush(Cache.Worker.get(), Reused));
+    ASSERT_EQ((uint32_t)TestStreamCacheSize, Cache.Worker->StreamCacheDepth);
+}
+
+TEST(StreamCacheTest, CacheDisabled)
+{
+    SmartStreamCache Cache;
+    MsQuicLib.Settings.StreamCacheSize = 0;
+    QUIC_STREAM* Stream = Cache.NewStream();
+    ASSERT_NE(nullptr, Stream);
+    ASSERT_FALSE(QuicStreamCachePush(Cache.Worker.get(), Stream));
+    ASSERT_EQ(0u, Cache.Worker->StreamCacheDepth);
+    Cache.FreeStream(Stream);
+}
+
+TEST(StreamCacheTest, ForeignReceiveBufferNotCached)
+{
+    SmartStreamCache Cache;
+    CXPLAT_POOL OtherPool;
+    CxPlatPoolInitialize(
+        FALSE,
+        QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE,
+        QUIC_POOL_SBUF,
+        &OtherPool);
+
+    QUIC_STREAM* Stream = Cache.NewStream(&OtherPool);
+    ASSERT_NE(nullptr, Stream);
+    ASSERT_FALSE(QuicStreamCachePush(Cache.Worker.get(), Stream));
+    ASSERT_EQ(0u, Cache.Worker->StreamCacheDepth);
+    Cache.FreeStream(Stream);
+
+    CxPlatPoolUninitialize(&OtherPool);
+}
+
+TEST(StreamCacheTest, PerfCounters)
+{
+    SmartStreamCache Cache;
+    ASSERT_EQ(0, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_HIT));
+    ASSERT_EQ(0, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_MISS));
+
+    ASSERT_EQ(nullptr, QuicStreamCachePop(Cache.Worker.get()));
+    ASSERT_EQ(0, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_HIT));
+    ASSERT_EQ(1, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_MISS));
+
+    QUIC_STREAM* Stream = Cache.NewStream();
+    ASSERT_NE(nullptr, Stream);
+    ASSERT_TRUE(QuicStreamCachePush(Cache.Worker.get(), Stream));
+    ASSERT_EQ(Stream, QuicStreamCachePop(Cache.Worker.get()));
+    ASSERT_EQ(1, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_HIT));
+    ASSERT_EQ(1, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_MISS));
+
+    //
+    // Flushing the cache on worker cleanup isn't counted as a hit.
+    //
+    ASSERT_TRUE(QuicStreamCachePush(Cache.Worker.get(), Stream));
+    QuicStreamCacheFlush(Cache.Worker.get());
+    ASSERT_EQ(0u, Cache.Worker->StreamCacheDepth);
+    ASSERT_EQ(1, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_HIT));
+    ASSERT_EQ(1, Cache.Counter(QUIC_PERF_COUNTER_STRM_CACHE_MISS));
+}
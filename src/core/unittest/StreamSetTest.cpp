@@ -0,0 +1,274 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the stream set's table of active streams, and a benchmark of
+    stream look up with many concurrently open streams.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "StreamSetTest.cpp.clog.h"
+#endif
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+//
+// g++ doesn't support the anonymous QUIC_HANDLE member that starts QUIC_STREAM,
+// so C++ code sees the other stream fields at a different offset than the core
+// does. Streams passed to the core are laid out the core's way, and their
+// fields are read through StreamFields.
+//
+const size_t StreamHandleSize =
+    offsetof(QUIC_STREAM, RefCount) == 0 ? sizeof(QUIC_HANDLE) : 0;
+
+QUIC_STREAM* StreamFields(QUIC_STREAM* Stream) {
+    return (QUIC_STREAM*)((uint8_t*)Stream + StreamHandleSize);
+}
+
+struct SmartStreamSet {
+    QUIC_STREAM_SET StreamSet;
+    const size_t StreamStride {(sizeof(QUIC_STREAM) + StreamHandleSize + 7) / 8};
+    std::vector<uint64_t> StreamMemory;
+    SmartStreamSet(uint32_t MaxStreamsPerType) :
+        StreamMemory((size_t)MaxStreamsPerType * NUMBER_OF_STREAM_TYPES * StreamStride) {
+        CxPlatZeroMemory(&StreamSet, sizeof(StreamSet));
+        QuicStreamSetInitialize(&StreamSet);
+        for (size_t i = 0; i < StreamCount(); ++i) {
+            StreamFields(Stream(i))->ID = i; // Index (i >> 2), type (i & 3)
+        }
+    }
+    ~SmartStreamSet() {
+        QuicStreamSetUninitialize(&StreamSet);
+    }
+    size_t StreamCount() const {
+        return StreamMemory.size() / StreamStride;
+    }
+    QUIC_STREAM* Stream(uint64_t ID) {
+        return (QUIC_STREAM*)&StreamMemory[(size_t)ID * StreamStride];
+    }
+    void Insert(uint64_t ID) {
+        ASSERT_TRUE(QuicStreamSetInsertStream(&StreamSet, Stream(ID)));
+    }
+    void Remove(uint64_t ID) {
+        QuicStreamSetRemoveStream(&StreamSet, Stream(ID));
+    }
+    bool Contains(uint64_t ID) {
+        QUIC_STREAM* Found = QuicStreamSetLookupStream(&StreamSet, ID);
+        if (Found != NULL) {
+            EXPECT_EQ(Stream(ID), Found);
+        }
+        return Found != NULL;
+    }
+    uint32_t Count() {
+        uint32_t Count = 0;
+        QUIC_STREAM_SET_ENUMERATOR Enumerator;
+        QuicStreamSetEnumerateBegin(&StreamSet, &Enumerator);
+        while (QuicStreamSetEnumerateNext(&StreamSet, &Enumerator) != NULL) {
+            Count++;
+        }
+        QuicStreamSetEnumerateEnd(&StreamSet, &Enumerator);
+        return Count;
+    }
+};
+
+TEST(StreamSetTest, Empty)
+{
+    SmartStreamSet Set(1);
+    for (uint64_t ID = 0; ID < NUMBER_OF_STREAM_TYPES; ++ID) {
+        ASSERT_FALSE(Set.Contains(ID));
+    }
+    ASSERT_EQ(0u, Set.Count());
+}
+
+TEST(StreamSetTest, DenseWindow)
+{
+    const uint32_t StreamCount = 1000;
+    SmartStreamSet Set(StreamCount);
+    for (uint64_t ID = 0; ID < StreamCount * NUMBER_OF_STREAM_TYPES; ++ID) {
+        Set.Insert(ID);
+    }
+    for (uint64_t ID = 0; ID < StreamCount * NUMBER_OF_STREAM_TYPES; ++ID) {
+        ASSERT_TRUE(Set.Contains(ID));
+    }
+    ASSERT_EQ(StreamCount * NUMBER_OF_STREAM_TYPES, Set.Count());
+
+    //
+    // All the open streams fit in the windows.
+    //
+    ASSERT_EQ(nullptr, Set.StreamSet.StreamTable);
+    for (uint32_t Type = 0; Type < NUMBER_OF_STREAM_TYPES; ++Type) {
+        ASSERT_EQ(StreamCount, Set.StreamSet.Types[Type].Window.Count);
+        ASSERT_GE(Set.StreamSet.Types[Type].Window.Capacity, StreamCount);
+    }
+
+    //
+    // Closing streams from the front slides the window.
+    //
+    for (uint64_t ID = 0; ID < 100 * NUMBER_OF_STREAM_TYPES; ++ID) {
+        Set.Remove(ID);
+        ASSERT_FALSE(Set.Contains(ID));
+    }
+    for (uint32_t Type = 0; Type < NUMBER_OF_STREAM_TYPES; ++Type) {
+        ASSERT_EQ(100ull, Set.StreamSet.Types[Type].Window.BaseIndex);
+    }
+    for (uint64_t ID = 100 * NUMBER_OF_STREAM_TYPES; ID < StreamCount * NUMBER_OF_STREAM_TYPES; ++ID) {
+        Set.Remove(ID);
+    }
+    ASSERT_EQ(0u, Set.Count());
+}
+
+TEST(StreamSetTest, SparseWindow)
+{
+    //
+    // Stream 0 stays open while many short lived streams come and go after it,
+    // so the window slides past it and it moves to the hash table.
+    //
+    const uint32_t StreamCount = 20000;
+    SmartStreamSet Set(StreamCount);
+    Set.Insert(0);
+    for (uint64_t i = 1; i < StreamCount; ++i) {
+        Set.Insert(i << 2);
+        if (i > 8) {
+            Set.Remove((i - 8) << 2);
+        }
+    }
+    ASSERT_NE(nullptr, Set.StreamSet.StreamTable);
+    ASSERT_LE(Set.StreamSet.Types[0].Window.Capacity, 32u);
+    ASSERT_EQ(9u, Set.Count());
+    ASSERT_TRUE(Set.Contains(0));
+    ASSERT_FALSE(Set.Contains(4));
+    ASSERT_FALSE(Set.Contains((uint64_t)(StreamCount - 9) << 2));
+    for (uint64_t i = StreamCount - 8; i < StreamCount; ++i) {
+        ASSERT_TRUE(Set.Contains(i << 2));
+    }
+
+    Set.Remove(0);
+    ASSERT_FALSE(Set.Contains(0));
+    for (uint64_t i = StreamCount - 8; i < StreamCount; ++i) {
+        Set.Remove(i << 2);
+    }
+    ASSERT_EQ(0u, Set.Count());
+}
+
+TEST(StreamSetTest, RemoveWhileEnumerating)
+{
+    const uint32_t StreamCount = 300;
+    SmartStreamSet Set(StreamCount);
+    for (uint64_t ID = 0; ID < StreamCount * NUMBER_OF_STREAM_TYPES; ++ID) {
+        Set.Insert(ID);
+    }
+    Set.Remove(1 << 2); // Make a hole.
+
+    //
+    // Close every stream as it's returned, like connection shutdown does.
+    //
+    std::vector<bool> Seen(Set.StreamCount());
+    uint32_t Count = 0;
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(&Set.StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(&Set.StreamSet, &Enumerator)) != NULL) {
+        const uint64_t ID = StreamFields(Stream)->ID;
+        ASSERT_FALSE(Seen[(size_t)ID]);
+        Seen[(size_t)ID] = true;
+        Count++;
+        QuicStreamSetRemoveStream(&Set.StreamSet, Stream);
+    }
+    QuicStreamSetEnumerateEnd(&Set.StreamSet, &Enumerator);
+
+    ASSERT_EQ(StreamCount * NUMBER_OF_STREAM_TYPES - 1, Count);
+    ASSERT_EQ(0u, Set.Count());
+}
+
+//
+// Baseline for the benchmark below: the hash table the stream set used for
+// all its streams before the windows.
+//
+struct StreamHashTable {
+    CXPLAT_HASHTABLE* Table {nullptr};
+    StreamHashTable() { EXPECT_TRUE(CxPlatHashtableInitialize(&Table, CXPLAT_HASH_MIN_SIZE)); }
+    ~StreamHashTable() {
+        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
+        CXPLAT_HASHTABLE_ENTRY* Entry;
+        CxPlatHashtableEnumerateBegin(Table, &Enumerator);
+        while ((Entry = CxPlatHashtableEnumerateNext(Table, &Enumerator)) != NULL) {
+            CxPlatHashtableRemove(Table, Entry, NULL);
+        }
+        CxPlatHashtableEnumerateEnd(Table, &Enumerator);
+        CxPlatHashtableUninitialize(Table);
+    }
+    void Insert(QUIC_STREAM* Stream) {
+        CxPlatHashtableInsert(Table, &Stream->TableEntry, (uint32_t)Stream->ID, NULL);
+    }
+    QUIC_STREAM* Lookup(uint64_t ID) {
+        CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+        CXPLAT_HASHTABLE_ENTRY* Entry = CxPlatHashtableLookup(Table, (uint32_t)ID, &Context);
+        while (Entry != NULL) {
+            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+            if (Stream->ID == ID) {
+                return Stream;
+            }
+            Entry = CxPlatHashtableLookupNext(Table, &Context);
+        }
+        return NULL;
+    }
+};
+
+//
+// Looks up randomly chosen streams among OpenStreams concurrently open client
+// bidirectional streams, as the STREAM frames of a busy connection would.
+// This only reports timings and is disabled unless the unit tests are run
+// with --gtest_also_run_disabled_tests.
+//
+TEST(StreamSetTest, DISABLED_LookupBenchmark)
+{
+    const uint32_t Lookups = 100000;
+    for (uint32_t OpenStreams : { 100u, 1000u, 10000u, 20000u }) {
+        SmartStreamSet Set(OpenStreams);
+        std::vector<QUIC_STREAM> TableStreams(OpenStreams);
+        StreamHashTable Table;
+        for (uint32_t i = 0; i < OpenStreams; ++i) {
+            Set.Insert((uint64_t)i << 2);
+            TableStreams[i].ID = (uint64_t)i << 2;
+            Table.Insert(&TableStreams[i]);
+        }
+
+        std::mt19937 Rng(OpenStreams);
+        std::vector<uint64_t> IDs(Lookups);
+        for (auto& ID : IDs) {
+            ID = (uint64_t)(Rng() % OpenStreams) << 2;
+        }
+
+        uint64_t Found = 0;
+        uint64_t Start = CxPlatTimeUs64();
+        for (uint64_t ID : IDs) {
+            Found += QuicStreamSetLookupStream(&Set.StreamSet, ID) != NULL;
+        }
+        const uint64_t WindowTime = CxPlatTimeUs64() - Start;
+
+        Start = CxPlatTimeUs64();
+        for (uint64_t ID : IDs) {
+            Found += Table.Lookup(ID) != NULL;
+        }
+        const uint64_t TableTime = CxPlatTimeUs64() - Start;
+
+        ASSERT_EQ(2ull * Lookups, Found);
+
+        std::cout
+            << "OpenStreams " << OpenStreams
+            << ": window " << (WindowTime * 1000.0 / Lookups) << " ns/lookup"
+            << ", hash table " << (TableTime * 1000.0 / Lookups) << " ns/lookup"
+            << std::endl;
+
+        for (uint32_t i = 0; i < OpenStreams; ++i) {
+            Set.Remove((uint64_t)i << 2);
+        }
+    }
+}
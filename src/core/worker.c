@@ -87,10 +87,14 @@ QuicWorkerInitialize(
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STREAM), QUIC_POOL_STREAM, &Worker->StreamPool);
     CxPlatPoolInitialize(FALSE, QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE, QUIC_POOL_SBUF, &Worker->DefaultReceiveBufferPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_SEND_REQUEST), QUIC_POOL_SEND_REQUEST, &Worker->SendRequestPool);
+    for (uint32_t i = 0; i < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT; ++i) {
+        CxPlatPoolInitialize(FALSE, QUIC_SEND_BUFFER_SLAB_SIZE(i), QUIC_POOL_SENDBUF_SLAB, &Worker->SendBufferSlabPools[i]);
+    }
     QuicSentPacketPoolInitialize(&Worker->SentPacketPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_API_CONTEXT), QUIC_POOL_API_CTX, &Worker->ApiContextPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STATELESS_CONTEXT), QUIC_POOL_STATELESS_CTX, &Worker->StatelessContextPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_OPERATION), QUIC_POOL_OPER, &Worker->OperPool);
+    CxPlatDispatchLockInitialize(&Worker->StreamCacheLock);
 
     Status = QuicTimerWheelInitialize(&Worker->TimerWheel);
     if (QUIC_FAILED(Status)) {
@@ -171,9 +175,14 @@ QuicWorkerUninitialize(
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Worker->Connections));
     CXPLAT_TEL_ASSERT(CxPlatListIsEmpty(&Worker->Operations));
 
+    QuicStreamCacheFlush(Worker);
+    CxPlatDispatchLockUninitialize(&Worker->StreamCacheLock);
     CxPlatPoolUninitialize(&Worker->StreamPool);
     CxPlatPoolUninitialize(&Worker->DefaultReceiveBufferPool);
     CxPlatPoolUninitialize(&Worker->SendRequestPool);
+    for (uint32_t i = 0; i < QUIC_SEND_BUFFER_SLAB_CLASS_COUNT; ++i) {
+        CxPlatPoolUninitialize(&Worker->SendBufferSlabPools[i]);
+    }
     QuicSentPacketPoolUninitialize(&Worker->SentPacketPool);
     CxPlatPoolUninitialize(&Worker->ApiContextPool);
     CxPlatPoolUninitialize(&Worker->StatelessContextPool);
@@ -720,6 +729,85 @@ QuicWorkerLoop(
 }
 
 #ifndef QUIC_USE_EXECUTION_CONTEXTS
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerReportTimerStats(
+    _In_ QUIC_WORKER* Worker,
+    _In_ uint64_t TimeNow
+    )
+{
+    if (Worker->TimerStats.Wakeups != 0) {
+        QuicTraceLogVerbose(
+            WorkerTimerStats,
+            "[wrkr][%p] Timer wakeups %u (spun %u), lateness avg %llu us, max %llu us",
+            Worker,
+            Worker->TimerStats.Wakeups,
+            Worker->TimerStats.SpinWakeups,
+            Worker->TimerStats.TotalLatenessUs / Worker->TimerStats.Wakeups,
+            Worker->TimerStats.MaxLatenessUs);
+    }
+    CxPlatZeroMemory(&Worker->TimerStats, sizeof(Worker->TimerStats));
+    Worker->TimerStats.LastReportTime = TimeNow;
+}
+
+//
+// Waits until the worker is signaled or the next timer expires, whichever comes
+// first, and returns the current time. Timers closer than WorkerTimerSpinUs are
+// waited on by spinning, so that their wakeup doesn't depend on the OS timer
+// resolution. The spin only polls the execution context's ready flag, which
+// QuicWorkerThreadWake sets before signaling the event, so it makes no system
+// calls. A wake seen while spinning leaves the event set, which just costs an
+// extra pass of the worker loop later.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+uint64_t
+QuicWorkerWaitForTimer(
+    _In_ QUIC_WORKER* Worker,
+    _In_ uint64_t NextTimeUs,
+    _In_ uint64_t TimeNow
+    )
+{
+    BOOLEAN Signaled;
+    BOOLEAN Spun = FALSE;
+    uint64_t Delay = NextTimeUs - TimeNow;
+
+    if (Delay < MsQuicLib.Settings.WorkerTimerSpinUs) {
+        Spun = TRUE;
+        do {
+            Signaled = *(volatile BOOLEAN*)&Worker->ExecutionContext.Ready;
+            TimeNow = CxPlatTimeUs64();
+        } while (!Signaled && TimeNow < NextTimeUs);
+
+    } else {
+        if (Delay >= MS_TO_US((uint64_t)UINT32_MAX)) {
+            Delay = MS_TO_US((uint64_t)UINT32_MAX - 1); // Max has special meaning for most platforms.
+        }
+        Signaled = CxPlatEventWaitWithTimeoutUs(Worker->Ready, Delay);
+        TimeNow = CxPlatTimeUs64();
+    }
+
+    if (!Signaled && TimeNow >= NextTimeUs) {
+        const uint64_t Lateness = TimeNow - NextTimeUs;
+        Worker->TimerStats.Wakeups++;
+        QuicPerfCounterIncrement(QUIC_PERF_COUNTER_WORK_TIMER_WAKEUPS);
+        if (Spun) {
+            Worker->TimerStats.SpinWakeups++;
+            QuicPerfCounterIncrement(QUIC_PERF_COUNTER_WORK_TIMER_SPINS);
+        }
+        Worker->TimerStats.TotalLatenessUs += Lateness;
+        QuicPerfCounterAdd(QUIC_PERF_COUNTER_WORK_TIMER_LATENESS, (int64_t)Lateness);
+        if (Lateness > Worker->TimerStats.MaxLatenessUs) {
+            Worker->TimerStats.MaxLatenessUs = Lateness;
+        }
+    }
+
+    if (TimeNow - Worker->TimerStats.LastReportTime >= QUIC_WORKER_TIMER_STATS_INTERVAL) {
+        QuicWorkerReportTimerStats(Worker, TimeNow);
+    }
+
+    return TimeNow;
+}
+
 CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context)
 {
     QUIC_WORKER* Worker = (QUIC_WORKER*)Context;
@@ -732,6 +820,7 @@ CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context)
         Worker);
 
     uint64_t TimeNow = CxPlatTimeUs64();
+    Worker->TimerStats.LastReportTime = TimeNow;
     while (QuicWorkerLoop(EC, &TimeNow, ThreadID)) {
         if (!EC->Ready) {
             if (EC->NextTimeUs == UINT64_MAX) {
@@ -739,16 +828,12 @@ CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context)
                 TimeNow = CxPlatTimeUs64();
 
             } else if (EC->NextTimeUs > TimeNow) {
-                uint64_t Delay = US_TO_MS(EC->NextTimeUs - TimeNow) + 1;
-                if (Delay >= (uint64_t)UINT32_MAX) {
-                    Delay = UINT32_MAX - 1; // Max has special meaning for most platforms.
-                }
-                CxPlatEventWaitWithTimeout(Worker->Ready, (uint32_t)Delay);
-                TimeNow = CxPlatTimeUs64();
+                TimeNow = QuicWorkerWaitForTimer(Worker, EC->NextTimeUs, TimeNow);
             }
         }
     }
 
+    QuicWorkerReportTimerStats(Worker, TimeNow);
     QuicTraceEvent(
         WorkerStop,
         "[wrkr][%p] Stop",
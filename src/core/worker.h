@@ -63,6 +63,18 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     // A thread for draining operations from queued connections.
     //
     CXPLAT_THREAD Thread;
+
+    //
+    // How late the thread woke up for timers, relative to the timer's
+    // expiration, since LastReportTime.
+    //
+    struct {
+        uint64_t LastReportTime;    // microseconds
+        uint32_t Wakeups;
+        uint32_t SpinWakeups;
+        uint64_t TotalLatenessUs;
+        uint64_t MaxLatenessUs;
+    } TimerStats;
 #endif // QUIC_USE_EXECUTION_CONTEXTS
 
     //
@@ -85,11 +97,20 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     CXPLAT_POOL StreamPool; // QUIC_STREAM
     CXPLAT_POOL DefaultReceiveBufferPool; // QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE
     CXPLAT_POOL SendRequestPool; // QUIC_SEND_REQUEST
+    CXPLAT_POOL SendBufferSlabPools[QUIC_SEND_BUFFER_SLAB_CLASS_COUNT]; // QUIC_SEND_BUFFER_SLAB_SIZE(i)
     QUIC_SENT_PACKET_POOL SentPacketPool; // QUIC_SENT_PACKET_METADATA
     CXPLAT_POOL ApiContextPool; // QUIC_API_CONTEXT
     CXPLAT_POOL StatelessContextPool; // QUIC_STATELESS_CONTEXT
     CXPLAT_POOL OperPool; // QUIC_OPERATION
 
+    //
+    // Freed streams kept for reuse, up to the StreamCacheSize setting. They
+    // still hold their receive buffer chunks and receive complete operation.
+    //
+    CXPLAT_DISPATCH_LOCK StreamCacheLock;
+    CXPLAT_SLIST_ENTRY StreamCache;
+    uint32_t StreamCacheDepth;
+
 } QUIC_WORKER;
 
 //
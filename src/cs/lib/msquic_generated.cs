@@ -23,6 +23,9 @@ namespace Microsoft.Quic
     {
         QUIC_LOAD_BALANCING_DISABLED,
         QUIC_LOAD_BALANCING_SERVER_ID_IP,
+        QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT,
+        QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED,
+        QUIC_LOAD_BALANCING_COUNT,
     }
 
     public enum QUIC_CREDENTIAL_TYPE
@@ -98,6 +101,7 @@ namespace Microsoft.Quic
     {
         QUIC_STREAM_SCHEDULING_SCHEME_FIFO = 0x0000,
         QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN = 0x0001,
+        QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY = 0x0002,
         QUIC_STREAM_SCHEDULING_SCHEME_COUNT,
     }
 
@@ -107,6 +111,7 @@ namespace Microsoft.Quic
         QUIC_STREAM_OPEN_FLAG_NONE = 0x0000,
         QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL = 0x0001,
         QUIC_STREAM_OPEN_FLAG_0_RTT = 0x0002,
+        QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS = 0x0004,
     }
 
     [System.Flags]
@@ -148,6 +153,7 @@ namespace Microsoft.Quic
         QUIC_SEND_FLAG_FIN = 0x0004,
         QUIC_SEND_FLAG_DGRAM_PRIORITY = 0x0008,
         QUIC_SEND_FLAG_DELAY_SEND = 0x0010,
+        QUIC_SEND_FLAG_DGRAM_EXPIRE = 0x0020,
     }
 
     public enum QUIC_DATAGRAM_SEND_STATE
@@ -403,9 +409,17 @@ namespace Microsoft.Quic
     public enum QUIC_CONGESTION_CONTROL_ALGORITHM
     {
         QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC,
+        QUIC_CONGESTION_CONTROL_ALGORITHM_BBR,
         QUIC_CONGESTION_CONTROL_ALGORITHM_MAX,
     }
 
+    public enum QUIC_DATAGRAM_DROP_POLICY
+    {
+        QUIC_DATAGRAM_DROP_OLDEST,
+        QUIC_DATAGRAM_DROP_NEWEST,
+        QUIC_DATAGRAM_DROP_POLICY_MAX,
+    }
+
     public partial struct QUIC_HANDSHAKE_INFO
     {
         public QUIC_TLS_PROTOCOL_VERSION TlsProtocolVersion;
@@ -749,6 +763,36 @@ namespace Microsoft.Quic
 
         [NativeTypeName("uint32_t")]
         public uint SendCongestionWindow;
+
+        [NativeTypeName("uint32_t")]
+        public uint SendEcnCongestionCount;
+
+        [NativeTypeName("uint64_t")]
+        public ulong SendDeliveryRate;
+
+        [NativeTypeName("uint64_t")]
+        public ulong SendMaxDeliveryRate;
+
+        [NativeTypeName("uint64_t")]
+        public ulong SendBufferBytes;
+
+        [NativeTypeName("uint64_t")]
+        public ulong SendBufferAllocatedBytes;
+
+        [NativeTypeName("uint64_t")]
+        public ulong RecvConnFlowControlWindow;
+
+        [NativeTypeName("uint32_t")]
+        public uint RecvMaxStreamFlowControlWindow;
+
+        [NativeTypeName("uint32_t")]
+        public uint RecvWindowAutoTuneCount;
+
+        [NativeTypeName("uint64_t")]
+        public ulong SendDatagramsExpired;
+
+        [NativeTypeName("uint64_t")]
+        public ulong SendDatagramsDropped;
     }
 
     public partial struct QUIC_LISTENER_STATISTICS
@@ -796,6 +840,11 @@ namespace Microsoft.Quic
         QUIC_PERF_COUNTER_PATH_FAILURE,
         QUIC_PERF_COUNTER_SEND_STATELESS_RESET,
         QUIC_PERF_COUNTER_SEND_STATELESS_RETRY,
+        QUIC_PERF_COUNTER_STRM_CACHE_HIT,
+        QUIC_PERF_COUNTER_STRM_CACHE_MISS,
+        QUIC_PERF_COUNTER_WORK_TIMER_WAKEUPS,
+        QUIC_PERF_COUNTER_WORK_TIMER_SPINS,
+        QUIC_PERF_COUNTER_WORK_TIMER_LATENESS,
         QUIC_PERF_COUNTER_MAX,
     }
 
@@ -831,6 +880,18 @@ namespace Microsoft.Quic
         [NativeTypeName("uint16_t")]
         public ushort LoadBalancingMode;
 
+        [NativeTypeName("uint16_t")]
+        public ushort WorkerTimerSpinUs;
+
+        [NativeTypeName("uint16_t")]
+        public ushort StreamCacheSize;
+
+        [NativeTypeName("uint16_t")]
+        public ushort RecvWindowMemoryLimit;
+
+        [NativeTypeName("uint16_t")]
+        public ushort CidSteeringEnabled;
+
         public ref ulong IsSetFlags
         {
             get
@@ -890,27 +951,98 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 62")]
+                [NativeTypeName("uint64_t : 1")]
+                public ulong WorkerTimerSpinUs
+                {
+                    get
+                    {
+                        return (_bitfield >> 2) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 2)) | ((value & 0x1UL) << 2);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong StreamCacheSize
+                {
+                    get
+                    {
+                        return (_bitfield >> 3) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 3)) | ((value & 0x1UL) << 3);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong RecvWindowMemoryLimit
+                {
+                    get
+                    {
+                        return (_bitfield >> 4) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 4)) | ((value & 0x1UL) << 4);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong CidSteeringEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 5) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 5)) | ((value & 0x1UL) << 5);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 58")]
                 public ulong RESERVED
                 {
                     get
                     {
-                        return (_bitfield >> 2) & 0x3FFFFFFFUL;
+                        return (_bitfield >> 6) & 0x3FFFFFFUL;
                     }
 
                     set
                     {
-                        _bitfield = (_bitfield & ~(0x3FFFFFFFUL << 2)) | ((value & 0x3FFFFFFFUL) << 2);
+                        _bitfield = (_bitfield & ~(0x3FFFFFFUL << 6)) | ((value & 0x3FFFFFFUL) << 6);
                     }
                 }
             }
         }
     }
 
+    public unsafe partial struct QUIC_LOAD_BALANCING_CONFIG
+    {
+        [NativeTypeName("uint8_t")]
+        public byte ConfigId;
+
+        [NativeTypeName("uint8_t")]
+        public byte ServerIdLength;
+
+        [NativeTypeName("uint8_t [10]")]
+        public fixed byte ServerId[10];
+
+        [NativeTypeName("uint8_t [16]")]
+        public fixed byte Key[16];
+    }
+
     public partial struct QUIC_SETTINGS
     {
         [NativeTypeName("QUIC_SETTINGS::(anonymous union)")]
-        public _Anonymous_e__Union Anonymous;
+        public _Anonymous1_e__Union Anonymous1;
 
         [NativeTypeName("uint64_t")]
         public ulong MaxBytesPerKey;
@@ -1056,17 +1188,31 @@ namespace Microsoft.Quic
             }
         }
 
-        [NativeTypeName("uint8_t : 2")]
-        public byte RESERVED
+        [NativeTypeName("uint8_t : 1")]
+        public byte EcnEnabled
         {
             get
             {
-                return (byte)((_bitfield >> 6) & 0x3u);
+                return (byte)((_bitfield >> 6) & 0x1u);
             }
 
             set
             {
-                _bitfield = (byte)((_bitfield & ~(0x3u << 6)) | ((value & 0x3u) << 6));
+                _bitfield = (byte)((_bitfield & ~(0x1u << 6)) | ((value & 0x1u) << 6));
+            }
+        }
+
+        [NativeTypeName("uint8_t : 1")]
+        public byte L4sEnabled
+        {
+            get
+            {
+                return (byte)((_bitfield >> 7) & 0x1u);
+            }
+
+            set
+            {
+                _bitfield = (byte)((_bitfield & ~(0x1u << 7)) | ((value & 0x1u) << 7));
             }
         }
 
@@ -1076,24 +1222,70 @@ namespace Microsoft.Quic
         [NativeTypeName("uint8_t")]
         public byte MtuDiscoveryMissingProbeCount;
 
+        [NativeTypeName("QUIC_SETTINGS::(anonymous union)")]
+        public _Anonymous2_e__Union Anonymous2;
+
+        [NativeTypeName("uint32_t")]
+        public uint DatagramSendTtlMs;
+
+        [NativeTypeName("uint16_t")]
+        public ushort DatagramSendQueueLimit;
+
+        [NativeTypeName("uint8_t")]
+        public byte DatagramSendDropPolicy;
+
         public ref ulong IsSetFlags
         {
             get
             {
-                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.IsSetFlags, 1));
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous1.IsSetFlags, 1));
             }
         }
 
-        public ref _Anonymous_e__Union._IsSet_e__Struct IsSet
+        public ref _Anonymous1_e__Union._IsSet_e__Struct IsSet
         {
             get
             {
-                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous.IsSet, 1));
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous1.IsSet, 1));
+            }
+        }
+
+        public ref ulong Flags
+        {
+            get
+            {
+                return ref MemoryMarshal.GetReference(MemoryMarshal.CreateSpan(ref Anonymous2.Flags, 1));
+            }
+        }
+
+        public ulong PacingOffloadEnabled
+        {
+            get
+            {
+                return Anonymous2.Anonymous.PacingOffloadEnabled;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.PacingOffloadEnabled = value;
+            }
+        }
+
+        public ulong ReservedFlags
+        {
+            get
+            {
+                return Anonymous2.Anonymous.ReservedFlags;
+            }
+
+            set
+            {
+                Anonymous2.Anonymous.ReservedFlags = value;
             }
         }
 
         [StructLayout(LayoutKind.Explicit)]
-        public partial struct _Anonymous_e__Union
+        public partial struct _Anonymous1_e__Union
         {
             [FieldOffset(0)]
             [NativeTypeName("uint64_t")]
@@ -1541,8 +1733,8 @@ namespace Microsoft.Quic
                     }
                 }
 
-                [NativeTypeName("uint64_t : 33")]
-                public ulong RESERVED
+                [NativeTypeName("uint64_t : 1")]
+                public ulong EcnEnabled
                 {
                     get
                     {
@@ -1554,6 +1746,135 @@ namespace Microsoft.Quic
                         _bitfield = (_bitfield & ~(0x1UL << 31)) | ((value & 0x1UL) << 31);
                     }
                 }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong L4sEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 32) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 32)) | ((value & 0x1UL) << 32);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong PacingOffloadEnabled
+                {
+                    get
+                    {
+                        return (_bitfield >> 33) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 33)) | ((value & 0x1UL) << 33);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong DatagramSendTtlMs
+                {
+                    get
+                    {
+                        return (_bitfield >> 34) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 34)) | ((value & 0x1UL) << 34);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong DatagramSendQueueLimit
+                {
+                    get
+                    {
+                        return (_bitfield >> 35) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 35)) | ((value & 0x1UL) << 35);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong DatagramSendDropPolicy
+                {
+                    get
+                    {
+                        return (_bitfield >> 36) & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x1UL << 36)) | ((value & 0x1UL) << 36);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 27")]
+                public ulong RESERVED
+                {
+                    get
+                    {
+                        return (_bitfield >> 37) & 0x7FFFFFFUL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x7FFFFFFUL << 37)) | ((value & 0x7FFFFFFUL) << 37);
+                    }
+                }
+            }
+        }
+
+        [StructLayout(LayoutKind.Explicit)]
+        public partial struct _Anonymous2_e__Union
+        {
+            [FieldOffset(0)]
+            [NativeTypeName("uint64_t")]
+            public ulong Flags;
+
+            [FieldOffset(0)]
+            [NativeTypeName("QUIC_SETTINGS::(anonymous struct)")]
+            public _Anonymous_e__Struct Anonymous;
+
+            public partial struct _Anonymous_e__Struct
+            {
+                public ulong _bitfield;
+
+                [NativeTypeName("uint64_t : 1")]
+                public ulong PacingOffloadEnabled
+                {
+                    get
+                    {
+                        return _bitfield & 0x1UL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~0x1UL) | (value & 0x1UL);
+                    }
+                }
+
+                [NativeTypeName("uint64_t : 63")]
+                public ulong ReservedFlags
+                {
+                    get
+                    {
+                        return (_bitfield >> 1) & 0x7FFFFFFFFFFFFFFFUL;
+                    }
+
+                    set
+                    {
+                        _bitfield = (_bitfield & ~(0x7FFFFFFFFFFFFFFFUL << 1)) | ((value & 0x7FFFFFFFFFFFFFFFUL) << 1);
+                    }
+                }
             }
         }
     }
@@ -2387,6 +2708,25 @@ namespace Microsoft.Quic
         }
     }
 
+    public unsafe partial struct QUIC_DATAGRAM_SEND_ENTRY
+    {
+        [NativeTypeName("HQUIC")]
+        public QUIC_HANDLE* Connection;
+
+        [NativeTypeName("const QUIC_BUFFER *")]
+        public QUIC_BUFFER* Buffers;
+
+        [NativeTypeName("uint32_t")]
+        public uint BufferCount;
+
+        public QUIC_SEND_FLAGS Flags;
+
+        public void* ClientSendContext;
+
+        [NativeTypeName("QUIC_STATUS")]
+        public int Status;
+    }
+
     public unsafe partial struct QUIC_API_TABLE
     {
         [NativeTypeName("QUIC_SET_CONTEXT_FN")]
@@ -2475,6 +2815,12 @@ namespace Microsoft.Quic
 
         [NativeTypeName("QUIC_DATAGRAM_SEND_FN")]
         public delegate* unmanaged[Cdecl]<QUIC_HANDLE*, QUIC_BUFFER*, uint, QUIC_SEND_FLAGS, void*, int> DatagramSend;
+
+        [NativeTypeName("QUIC_STREAM_PROVIDE_RECEIVE_BUFFERS_FN")]
+        public delegate* unmanaged[Cdecl]<QUIC_HANDLE*, uint, QUIC_BUFFER*, int> StreamProvideReceiveBuffers;
+
+        [NativeTypeName("QUIC_DATAGRAM_SEND_BATCH_FN")]
+        public delegate* unmanaged[Cdecl]<uint, QUIC_DATAGRAM_SEND_ENTRY*, int> DatagramSendBatch;
     }
 
     public static unsafe partial class MsQuic
@@ -2501,6 +2847,15 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_TLS_SECRETS_MAX_SECRET_LEN 64")]
         public const int QUIC_TLS_SECRETS_MAX_SECRET_LEN = 64;
 
+        [NativeTypeName("#define QUIC_LOAD_BALANCING_MAX_CONFIG_ID 6")]
+        public const int QUIC_LOAD_BALANCING_MAX_CONFIG_ID = 6;
+
+        [NativeTypeName("#define QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH 10")]
+        public const int QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH = 10;
+
+        [NativeTypeName("#define QUIC_LOAD_BALANCING_KEY_LENGTH 16")]
+        public const int QUIC_LOAD_BALANCING_KEY_LENGTH = 16;
+
         [NativeTypeName("#define QUIC_PARAM_PREFIX_GLOBAL 0x01000000")]
         public const int QUIC_PARAM_PREFIX_GLOBAL = 0x01000000;
 
@@ -2552,6 +2907,9 @@ namespace Microsoft.Quic
         [NativeTypeName("#define QUIC_PARAM_GLOBAL_LIBRARY_GIT_HASH 0x01000008")]
         public const int QUIC_PARAM_GLOBAL_LIBRARY_GIT_HASH = 0x01000008;
 
+        [NativeTypeName("#define QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG 0x01000009")]
+        public const int QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG = 0x01000009;
+
         [NativeTypeName("#define QUIC_PARAM_CONFIGURATION_SETTINGS 0x03000000")]
         public const int QUIC_PARAM_CONFIGURATION_SETTINGS = 0x03000000;
 
@@ -0,0 +1,115 @@
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnBbr
+// [conn][%p] BBR: State=%hhu Phase=%hhu MaxBw=%llu MinRtt=%u PacingRate=%llu CWnd=%u InflightHi=%u
+// QuicTraceLogConnVerbose(ConnBbr, Connection, "BBR: State=%hhu Phase=%hhu MaxBw=%llu MinRtt=%u PacingRate=%llu CWnd=%u InflightHi=%u", Bbr->State, Bbr->ProbeBwPhase, Bbr->MaxBwFilter.Samples[0].Value, Bbr->MinRtt, Bbr->PacingRate, Bbr->CongestionWindow, Bbr->InflightHi);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Bbr->State = arg3
+// arg4 = arg4 = Bbr->ProbeBwPhase = arg4
+// arg5 = arg5 = Bbr->MaxBwFilter.Samples[0].Value = arg5
+// arg6 = arg6 = Bbr->MinRtt = arg6
+// arg7 = arg7 = Bbr->PacingRate = arg7
+// arg8 = arg8 = Bbr->CongestionWindow = arg8
+// arg9 = arg9 = Bbr->InflightHi = arg9
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_BBR_C, ConnBbr,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3,
+        unsigned char, arg4,
+        unsigned long long, arg5,
+        unsigned int, arg6,
+        unsigned long long, arg7,
+        unsigned int, arg8,
+        unsigned int, arg9), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+        ctf_integer(unsigned char, arg4, arg4)
+        ctf_integer(uint64_t, arg5, arg5)
+        ctf_integer(unsigned int, arg6, arg6)
+        ctf_integer(uint64_t, arg7, arg7)
+        ctf_integer(unsigned int, arg8, arg8)
+        ctf_integer(unsigned int, arg9, arg9)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnCongestion
+// [conn][%p] Congestion event
+// QuicTraceEvent(ConnCongestion, "[conn][%p] Congestion event", Connection);
+// arg2 = arg2 = Connection = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_BBR_C, ConnCongestion,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnPersistentCongestion
+// [conn][%p] Persistent congestion event
+// QuicTraceEvent(ConnPersistentCongestion, "[conn][%p] Persistent congestion event", Connection);
+// arg2 = arg2 = Connection = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_BBR_C, ConnPersistentCongestion,
+    TP_ARGS(
+        const void *, arg2), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for ConnOutFlowStats
+// [conn][%p] OUT: BytesSent=%llu InFlight=%u InFlightMax=%u CWnd=%u SSThresh=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%u
+// QuicTraceEvent(ConnOutFlowStats, "[conn][%p] OUT: BytesSent=%llu InFlight=%u InFlightMax=%u CWnd=%u SSThresh=%u ConnFC=%llu ISB=%llu PostedBytes=%llu SRtt=%u", Connection, Connection->Stats.Send.TotalBytes, Bbr->BytesInFlight, Bbr->BytesInFlightMax, Bbr->CongestionWindow, Bbr->InflightHi, Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent, Connection->SendBuffer.IdealBytes, Connection->SendBuffer.PostedBytes, Path->GotFirstRttSample ? Path->SmoothedRtt : 0);
+// arg2 = arg2 = Connection = arg2
+// arg3 = arg3 = Connection->Stats.Send.TotalBytes = arg3
+// arg4 = arg4 = Bbr->BytesInFlight = arg4
+// arg5 = arg5 = Bbr->BytesInFlightMax = arg5
+// arg6 = arg6 = Bbr->CongestionWindow = arg6
+// arg7 = arg7 = Bbr->InflightHi = arg7
+// arg8 = arg8 = Connection->Send.PeerMaxData - Connection->Send.OrderedStreamBytesSent = arg8
+// arg9 = arg9 = Connection->SendBuffer.IdealBytes = arg9
+// arg10 = arg10 = Connection->SendBuffer.PostedBytes = arg10
+// arg11 = arg11 = Path->GotFirstRttSample ? Path->SmoothedRtt : 0 = arg11
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_BBR_C, ConnOutFlowStats,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned long long, arg3,
+        unsigned int, arg4,
+        unsigned int, arg5,
+        unsigned int, arg6,
+        unsigned int, arg7,
+        unsigned long long, arg8,
+        unsigned long long, arg9,
+        unsigned long long, arg10,
+        unsigned int, arg11), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, arg2)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(unsigned int, arg5, arg5)
+        ctf_integer(unsigned int, arg6, arg6)
+        ctf_integer(unsigned int, arg7, arg7)
+        ctf_integer(uint64_t, arg8, arg8)
+        ctf_integer(uint64_t, arg9, arg9)
+        ctf_integer(uint64_t, arg10, arg10)
+        ctf_integer(unsigned int, arg11, arg11)
+    )
+)
+
+
+
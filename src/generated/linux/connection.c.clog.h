@@ -2079,6 +2079,23 @@ tracepoint(CLOG_CONNECTION_C, ConnLocalAddrRemoved , arg2, arg3_len, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for IncreaseConnRxWindow
+// [conn][%p] Increasing connection flow control window to %llu (Bdp=%llu)
+// QuicTraceLogConnVerbose(IncreaseConnRxWindow, Connection, "Increasing connection flow control window to %llu (Bdp=%llu)", Send->RecvWindow + Increase, Bdp);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Send->RecvWindow + Increase = arg3
+// arg4 = arg4 = Bdp = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_IncreaseConnRxWindow
+#define _clog_5_ARGS_TRACE_IncreaseConnRxWindow(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CONNECTION_C, IncreaseConnRxWindow , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
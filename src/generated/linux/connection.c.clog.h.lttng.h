@@ -2339,3 +2339,25 @@ TRACEPOINT_EVENT(CLOG_CONNECTION_C, ConnLocalAddrRemoved,
         ctf_sequence(char, arg3, arg3, unsigned int, arg3_len)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for IncreaseConnRxWindow
+// [conn][%p] Increasing connection flow control window to %llu (Bdp=%llu)
+// QuicTraceLogConnVerbose(IncreaseConnRxWindow, Connection, "Increasing connection flow control window to %llu (Bdp=%llu)", Send->RecvWindow + Increase, Bdp);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Send->RecvWindow + Increase = arg3
+// arg4 = arg4 = Bdp = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CONNECTION_C, IncreaseConnRxWindow,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned long long, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(uint64_t, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
@@ -18,6 +18,10 @@
 #define _clog_MACRO_QuicTraceEvent  1
 #define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
 #endif
+#ifndef _clog_MACRO_QuicTraceLogConnVerbose
+#define _clog_MACRO_QuicTraceLogConnVerbose  1
+#define QuicTraceLogConnVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -155,6 +159,23 @@ tracepoint(CLOG_CUBIC_C, ConnOutFlowStats , arg2, arg3, arg4, arg5, arg6, arg7,
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EcnL4sWindowReduction
+// [conn][%p] L4S window reduction, alpha=%u/1024, CongestionWindow=%u
+// QuicTraceLogConnVerbose(EcnL4sWindowReduction, Connection, "L4S window reduction, alpha=%u/1024, CongestionWindow=%u", Cubic->EcnAlpha, Cubic->CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Cubic->EcnAlpha = arg3
+// arg4 = arg4 = Cubic->CongestionWindow = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_EcnL4sWindowReduction
+#define _clog_5_ARGS_TRACE_EcnL4sWindowReduction(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_CUBIC_C, EcnL4sWindowReduction , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
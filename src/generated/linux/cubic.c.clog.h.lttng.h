@@ -164,3 +164,25 @@ TRACEPOINT_EVENT(CLOG_CUBIC_C, ConnOutFlowStats,
         ctf_integer(unsigned int, arg11, arg11)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for EcnL4sWindowReduction
+// [conn][%p] L4S window reduction, alpha=%u/1024, CongestionWindow=%u
+// QuicTraceLogConnVerbose(EcnL4sWindowReduction, Connection, "L4S window reduction, alpha=%u/1024, CongestionWindow=%u", Cubic->EcnAlpha, Cubic->CongestionWindow);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Cubic->EcnAlpha = arg3
+// arg4 = arg4 = Cubic->CongestionWindow = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_CUBIC_C, EcnL4sWindowReduction,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned int, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+    )
+)
+
+
+
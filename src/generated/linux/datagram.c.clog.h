@@ -169,6 +169,38 @@ tracepoint(CLOG_DATAGRAM_C, AllocFailure , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendExpired
+// [conn][%p] Datagram [%p] expired before it was sent
+// QuicTraceLogConnVerbose(DatagramSendExpired, Connection, "Datagram [%p] expired before it was sent", SendRequest);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = SendRequest = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DatagramSendExpired
+#define _clog_4_ARGS_TRACE_DatagramSendExpired(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_DATAGRAM_C, DatagramSendExpired , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendDropped
+// [conn][%p] Datagram [%p] dropped, send queue full
+// QuicTraceLogConnVerbose(DatagramSendDropped, Connection, "Datagram [%p] dropped, send queue full", DroppedRequest);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = DroppedRequest = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_DatagramSendDropped
+#define _clog_4_ARGS_TRACE_DatagramSendDropped(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_DATAGRAM_C, DatagramSendDropped , arg1, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
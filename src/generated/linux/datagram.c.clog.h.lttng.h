@@ -167,3 +167,41 @@ TRACEPOINT_EVENT(CLOG_DATAGRAM_C, AllocFailure,
         ctf_integer(uint64_t, arg3, arg3)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendExpired
+// [conn][%p] Datagram [%p] expired before it was sent
+// QuicTraceLogConnVerbose(DatagramSendExpired, Connection, "Datagram [%p] expired before it was sent", SendRequest);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = SendRequest = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramSendExpired,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer_hex(uint64_t, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for DatagramSendDropped
+// [conn][%p] Datagram [%p] dropped, send queue full
+// QuicTraceLogConnVerbose(DatagramSendDropped, Connection, "Datagram [%p] dropped, send queue full", DroppedRequest);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = DroppedRequest = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_DATAGRAM_C, DatagramSendDropped,
+    TP_ARGS(
+        const void *, arg1,
+        const void *, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer_hex(uint64_t, arg3, arg3)
+    )
+)
+
+
+
@@ -560,6 +560,66 @@ tracepoint(CLOG_LIBRARY_C, PerfCountersRundown , arg2_len, arg2);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigMissing
+// [ lib] No valid QUIC-LB config for load balancing mode %hu
+// QuicTraceLogWarning(LibraryLoadBalancingConfigMissing, "[ lib] No valid QUIC-LB config for load balancing mode %hu", Mode);
+// arg2 = arg2 = Mode = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryLoadBalancingConfigMissing
+#define _clog_3_ARGS_TRACE_LibraryLoadBalancingConfigMissing(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingConfigMissing , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingModeMissingConfig
+// [ lib] No valid QUIC-LB config for load balancing mode %hu
+// QuicTraceLogError(LibraryLoadBalancingModeMissingConfig, "[ lib] No valid QUIC-LB config for load balancing mode %hu", *(uint16_t*)Buffer);
+// arg2 = arg2 = *(uint16_t*)Buffer = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_LibraryLoadBalancingModeMissingConfig
+#define _clog_3_ARGS_TRACE_LibraryLoadBalancingModeMissingConfig(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingModeMissingConfig , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigSetAfterInUse
+// [ lib] Tried to change load balancing config after library in use!
+// QuicTraceLogError(LibraryLoadBalancingConfigSetAfterInUse, "[ lib] Tried to change load balancing config after library in use!");
+----------------------------------------------------------*/
+#ifndef _clog_2_ARGS_TRACE_LibraryLoadBalancingConfigSetAfterInUse
+#define _clog_2_ARGS_TRACE_LibraryLoadBalancingConfigSetAfterInUse(uniqueId, encoded_arg_string)\
+tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingConfigSetAfterInUse );\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigSet
+// [ lib] Updated load balancing config, ID = %hhu, server ID length = %hhu
+// QuicTraceLogInfo(LibraryLoadBalancingConfigSet, "[ lib] Updated load balancing config, ID = %hhu, server ID length = %hhu", Config->ConfigId, Config->ServerIdLength);
+// arg2 = arg2 = Config->ConfigId = arg2
+// arg3 = arg3 = Config->ServerIdLength = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_LibraryLoadBalancingConfigSet
+#define _clog_4_ARGS_TRACE_LibraryLoadBalancingConfigSet(uniqueId, encoded_arg_string, arg2, arg3)\
+tracepoint(CLOG_LIBRARY_C, LibraryLoadBalancingConfigSet , arg2, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -551,3 +551,68 @@ TRACEPOINT_EVENT(CLOG_LIBRARY_C, PerfCountersRundown,
         ctf_sequence(char, arg2, arg2, unsigned int, arg2_len)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigMissing
+// [ lib] No valid QUIC-LB config for load balancing mode %hu
+// QuicTraceLogWarning(LibraryLoadBalancingConfigMissing, "[ lib] No valid QUIC-LB config for load balancing mode %hu", Mode);
+// arg2 = arg2 = Mode = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingConfigMissing,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingModeMissingConfig
+// [ lib] No valid QUIC-LB config for load balancing mode %hu
+// QuicTraceLogError(LibraryLoadBalancingModeMissingConfig, "[ lib] No valid QUIC-LB config for load balancing mode %hu", *(uint16_t*)Buffer);
+// arg2 = arg2 = *(uint16_t*)Buffer = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingModeMissingConfig,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigSetAfterInUse
+// [ lib] Tried to change load balancing config after library in use!
+// QuicTraceLogError(LibraryLoadBalancingConfigSetAfterInUse, "[ lib] Tried to change load balancing config after library in use!");
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingConfigSetAfterInUse,
+    TP_ARGS(
+), 
+    TP_FIELDS(
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for LibraryLoadBalancingConfigSet
+// [ lib] Updated load balancing config, ID = %hhu, server ID length = %hhu
+// QuicTraceLogInfo(LibraryLoadBalancingConfigSet, "[ lib] Updated load balancing config, ID = %hhu, server ID length = %hhu", Config->ConfigId, Config->ServerIdLength);
+// arg2 = arg2 = Config->ConfigId = arg2
+// arg3 = arg3 = Config->ServerIdLength = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LIBRARY_C, LibraryLoadBalancingConfigSet,
+    TP_ARGS(
+        unsigned char, arg2,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
@@ -447,6 +447,38 @@ tracepoint(CLOG_LOSS_DETECTION_C, ConnError , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EcnValidationFailure
+// [conn][%p] Path[%hhu] ECN validation failed
+// QuicTraceLogConnInfo(EcnValidationFailure, Connection, "Path[%hhu] ECN validation failed", Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_EcnValidationFailure
+#define _clog_4_ARGS_TRACE_EcnValidationFailure(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_LOSS_DETECTION_C, EcnValidationFailure , arg1, arg3);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for EcnValidationSuccess
+// [conn][%p] Path[%hhu] ECN validation succeeded
+// QuicTraceLogConnInfo(EcnValidationSuccess, Connection, "Path[%hhu] ECN validation succeeded", Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_EcnValidationSuccess
+#define _clog_4_ARGS_TRACE_EcnValidationSuccess(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_LOSS_DETECTION_C, EcnValidationSuccess , arg1, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -486,3 +486,41 @@ TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, ConnError,
         ctf_string(arg3, arg3)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for EcnValidationFailure
+// [conn][%p] Path[%hhu] ECN validation failed
+// QuicTraceLogConnInfo(EcnValidationFailure, Connection, "Path[%hhu] ECN validation failed", Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, EcnValidationFailure,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for EcnValidationSuccess
+// [conn][%p] Path[%hhu] ECN validation succeeded
+// QuicTraceLogConnInfo(EcnValidationSuccess, Connection, "Path[%hhu] ECN validation succeeded", Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_LOSS_DETECTION_C, EcnValidationSuccess,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
@@ -105,6 +105,22 @@ tracepoint(CLOG_PATH_C, PathActive , arg1, arg3, arg4);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for EcnValidationUnknown
+// [conn][%p] Path[%hhu] ECN validation testing complete; state unknown
+// QuicTraceLogConnInfo(EcnValidationUnknown, Connection, "Path[%hhu] ECN validation testing complete; state unknown", Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+#ifndef _clog_4_ARGS_TRACE_EcnValidationUnknown
+#define _clog_4_ARGS_TRACE_EcnValidationUnknown(uniqueId, arg1, encoded_arg_string, arg3)\
+tracepoint(CLOG_PATH_C, EcnValidationUnknown , arg1, arg3);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
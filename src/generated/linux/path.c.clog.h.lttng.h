@@ -98,3 +98,22 @@ TRACEPOINT_EVENT(CLOG_PATH_C, PathActive,
         ctf_integer(unsigned char, arg4, arg4)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for EcnValidationUnknown
+// [conn][%p] Path[%hhu] ECN validation testing complete; state unknown
+// QuicTraceLogConnInfo(EcnValidationUnknown, Connection, "Path[%hhu] ECN validation testing complete; state unknown", Path->ID);
+// arg1 = arg1 = Connection = arg1
+// arg3 = arg3 = Path->ID = arg3
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_PATH_C, EcnValidationUnknown,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned char, arg3), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(unsigned char, arg3, arg3)
+    )
+)
+
+
+
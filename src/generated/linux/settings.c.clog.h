@@ -609,6 +609,156 @@ tracepoint(CLOG_SETTINGS_C, AllocFailure , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpEcnEnabled
+// [sett] EcnEnabled             = %hhu
+// QuicTraceLogVerbose(SettingDumpEcnEnabled, "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
+// arg2 = arg2 = Settings->EcnEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpEcnEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpEcnEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpEcnEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpL4sEnabled
+// [sett] L4sEnabled             = %hhu
+// QuicTraceLogVerbose(SettingDumpL4sEnabled, "[sett] L4sEnabled             = %hhu", Settings->L4sEnabled);
+// arg2 = arg2 = Settings->L4sEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpL4sEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpL4sEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpL4sEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpWorkerTimerSpinUs
+// [sett] WorkerTimerSpinUs      = %hu
+// QuicTraceLogVerbose(SettingDumpWorkerTimerSpinUs, "[sett] WorkerTimerSpinUs      = %hu", Settings->WorkerTimerSpinUs);
+// arg2 = arg2 = Settings->WorkerTimerSpinUs = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpWorkerTimerSpinUs
+#define _clog_3_ARGS_TRACE_SettingDumpWorkerTimerSpinUs(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpWorkerTimerSpinUs , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpPacingOffloadEnabled
+// [sett] PacingOffloadEnabled   = %hhu
+// QuicTraceLogVerbose(SettingDumpPacingOffloadEnabled, "[sett] PacingOffloadEnabled   = %hhu", Settings->PacingOffloadEnabled);
+// arg2 = arg2 = Settings->PacingOffloadEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpPacingOffloadEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpPacingOffloadEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpPacingOffloadEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpStreamCacheSize
+// [sett] StreamCacheSize        = %hu
+// QuicTraceLogVerbose(SettingDumpStreamCacheSize, "[sett] StreamCacheSize        = %hu", Settings->StreamCacheSize);
+// arg2 = arg2 = Settings->StreamCacheSize = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpStreamCacheSize
+#define _clog_3_ARGS_TRACE_SettingDumpStreamCacheSize(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpStreamCacheSize , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpRecvWindowMemoryLimit
+// [sett] RecvWindowMemoryLimit  = %hu
+// QuicTraceLogVerbose(SettingDumpRecvWindowMemoryLimit, "[sett] RecvWindowMemoryLimit  = %hu", Settings->RecvWindowMemoryLimit);
+// arg2 = arg2 = Settings->RecvWindowMemoryLimit = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpRecvWindowMemoryLimit
+#define _clog_3_ARGS_TRACE_SettingDumpRecvWindowMemoryLimit(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpRecvWindowMemoryLimit , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpCidSteeringEnabled
+// [sett] CidSteeringEnabled     = %hu
+// QuicTraceLogVerbose(SettingDumpCidSteeringEnabled,      "[sett] CidSteeringEnabled     = %hu", Settings->CidSteeringEnabled);
+// arg2 = arg2 = Settings->CidSteeringEnabled = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpCidSteeringEnabled
+#define _clog_3_ARGS_TRACE_SettingDumpCidSteeringEnabled(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpCidSteeringEnabled , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpDatagramSendTtlMs
+// [sett] DatagramSendTtlMs      = %u
+// QuicTraceLogVerbose(SettingDumpDatagramSendTtlMs, "[sett] DatagramSendTtlMs      = %u", Settings->DatagramSendTtlMs);
+// arg2 = arg2 = Settings->DatagramSendTtlMs = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpDatagramSendTtlMs
+#define _clog_3_ARGS_TRACE_SettingDumpDatagramSendTtlMs(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpDatagramSendTtlMs , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpDatagramSendQueueLimit
+// [sett] DatagramSendQueueLimit = %hu
+// QuicTraceLogVerbose(SettingDumpDatagramSendQueueLimit, "[sett] DatagramSendQueueLimit = %hu", Settings->DatagramSendQueueLimit);
+// arg2 = arg2 = Settings->DatagramSendQueueLimit = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpDatagramSendQueueLimit
+#define _clog_3_ARGS_TRACE_SettingDumpDatagramSendQueueLimit(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpDatagramSendQueueLimit , arg2);\
+
+#endif
+
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpDatagramSendDropPolicy
+// [sett] DatagramSendDropPolicy = %hhu
+// QuicTraceLogVerbose(SettingDumpDatagramSendDropPolicy, "[sett] DatagramSendDropPolicy = %hhu", Settings->DatagramSendDropPolicy);
+// arg2 = arg2 = Settings->DatagramSendDropPolicy = arg2
+----------------------------------------------------------*/
+#ifndef _clog_3_ARGS_TRACE_SettingDumpDatagramSendDropPolicy
+#define _clog_3_ARGS_TRACE_SettingDumpDatagramSendDropPolicy(uniqueId, encoded_arg_string, arg2)\
+tracepoint(CLOG_SETTINGS_C, SettingDumpDatagramSendDropPolicy , arg2);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
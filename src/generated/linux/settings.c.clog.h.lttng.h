@@ -620,3 +620,163 @@ TRACEPOINT_EVENT(CLOG_SETTINGS_C, AllocFailure,
         ctf_integer(uint64_t, arg3, arg3)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpEcnEnabled
+// [sett] EcnEnabled             = %hhu
+// QuicTraceLogVerbose(SettingDumpEcnEnabled, "[sett] EcnEnabled             = %hhu", Settings->EcnEnabled);
+// arg2 = arg2 = Settings->EcnEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpEcnEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpL4sEnabled
+// [sett] L4sEnabled             = %hhu
+// QuicTraceLogVerbose(SettingDumpL4sEnabled, "[sett] L4sEnabled             = %hhu", Settings->L4sEnabled);
+// arg2 = arg2 = Settings->L4sEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpL4sEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpWorkerTimerSpinUs
+// [sett] WorkerTimerSpinUs      = %hu
+// QuicTraceLogVerbose(SettingDumpWorkerTimerSpinUs, "[sett] WorkerTimerSpinUs      = %hu", Settings->WorkerTimerSpinUs);
+// arg2 = arg2 = Settings->WorkerTimerSpinUs = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpWorkerTimerSpinUs,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpPacingOffloadEnabled
+// [sett] PacingOffloadEnabled   = %hhu
+// QuicTraceLogVerbose(SettingDumpPacingOffloadEnabled, "[sett] PacingOffloadEnabled   = %hhu", Settings->PacingOffloadEnabled);
+// arg2 = arg2 = Settings->PacingOffloadEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpPacingOffloadEnabled,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpStreamCacheSize
+// [sett] StreamCacheSize        = %hu
+// QuicTraceLogVerbose(SettingDumpStreamCacheSize, "[sett] StreamCacheSize        = %hu", Settings->StreamCacheSize);
+// arg2 = arg2 = Settings->StreamCacheSize = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpStreamCacheSize,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpRecvWindowMemoryLimit
+// [sett] RecvWindowMemoryLimit  = %hu
+// QuicTraceLogVerbose(SettingDumpRecvWindowMemoryLimit, "[sett] RecvWindowMemoryLimit  = %hu", Settings->RecvWindowMemoryLimit);
+// arg2 = arg2 = Settings->RecvWindowMemoryLimit = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpRecvWindowMemoryLimit,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpCidSteeringEnabled
+// [sett] CidSteeringEnabled     = %hu
+// QuicTraceLogVerbose(SettingDumpCidSteeringEnabled,      "[sett] CidSteeringEnabled     = %hu", Settings->CidSteeringEnabled);
+// arg2 = arg2 = Settings->CidSteeringEnabled = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpCidSteeringEnabled,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpDatagramSendTtlMs
+// [sett] DatagramSendTtlMs      = %u
+// QuicTraceLogVerbose(SettingDumpDatagramSendTtlMs, "[sett] DatagramSendTtlMs      = %u", Settings->DatagramSendTtlMs);
+// arg2 = arg2 = Settings->DatagramSendTtlMs = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpDatagramSendTtlMs,
+    TP_ARGS(
+        unsigned int, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned int, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpDatagramSendQueueLimit
+// [sett] DatagramSendQueueLimit = %hu
+// QuicTraceLogVerbose(SettingDumpDatagramSendQueueLimit, "[sett] DatagramSendQueueLimit = %hu", Settings->DatagramSendQueueLimit);
+// arg2 = arg2 = Settings->DatagramSendQueueLimit = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpDatagramSendQueueLimit,
+    TP_ARGS(
+        unsigned short, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned short, arg2, arg2)
+    )
+)
+
+
+
+/*----------------------------------------------------------
+// Decoder Ring for SettingDumpDatagramSendDropPolicy
+// [sett] DatagramSendDropPolicy = %hhu
+// QuicTraceLogVerbose(SettingDumpDatagramSendDropPolicy, "[sett] DatagramSendDropPolicy = %hhu", Settings->DatagramSendDropPolicy);
+// arg2 = arg2 = Settings->DatagramSendDropPolicy = arg2
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_SETTINGS_C, SettingDumpDatagramSendDropPolicy,
+    TP_ARGS(
+        unsigned char, arg2), 
+    TP_FIELDS(
+        ctf_integer(unsigned char, arg2, arg2)
+    )
+)
+
+
+
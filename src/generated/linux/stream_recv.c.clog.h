@@ -519,6 +519,23 @@ tracepoint(CLOG_STREAM_RECV_C, StreamAppReceiveComplete , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for ProvideRecvBuffers
+// [strm][%p] App provided %u receive buffers, window end %llu
+// QuicTraceLogStreamVerbose(ProvideRecvBuffers, Stream, "App provided %u receive buffers, window end %llu", BufferCount, NewMaxAllowedRecvOffset);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = BufferCount = arg3
+// arg4 = arg4 = NewMaxAllowedRecvOffset = arg4
+----------------------------------------------------------*/
+#ifndef _clog_5_ARGS_TRACE_ProvideRecvBuffers
+#define _clog_5_ARGS_TRACE_ProvideRecvBuffers(uniqueId, arg1, encoded_arg_string, arg3, arg4)\
+tracepoint(CLOG_STREAM_RECV_C, ProvideRecvBuffers , arg1, arg3, arg4);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
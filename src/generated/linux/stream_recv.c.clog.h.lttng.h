@@ -545,3 +545,25 @@ TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, StreamAppReceiveComplete,
         ctf_integer(uint64_t, arg3, arg3)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for ProvideRecvBuffers
+// [strm][%p] App provided %u receive buffers, window end %llu
+// QuicTraceLogStreamVerbose(ProvideRecvBuffers, Stream, "App provided %u receive buffers, window end %llu", BufferCount, NewMaxAllowedRecvOffset);
+// arg1 = arg1 = Stream = arg1
+// arg3 = arg3 = BufferCount = arg3
+// arg4 = arg4 = NewMaxAllowedRecvOffset = arg4
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_STREAM_RECV_C, ProvideRecvBuffers,
+    TP_ARGS(
+        const void *, arg1,
+        unsigned int, arg3,
+        unsigned long long, arg4), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg1, arg1)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(uint64_t, arg4, arg4)
+    )
+)
+
+
+
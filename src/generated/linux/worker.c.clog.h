@@ -22,6 +22,10 @@
 #define _clog_MACRO_QuicTraceEvent  1
 #define QuicTraceEvent(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
 #endif
+#ifndef _clog_MACRO_QuicTraceLogVerbose
+#define _clog_MACRO_QuicTraceLogVerbose  1
+#define QuicTraceLogVerbose(a, ...) _clog_CAT(_clog_ARGN_SELECTOR(__VA_ARGS__), _clog_CAT(_,a(#a, __VA_ARGS__)))
+#endif
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -279,6 +283,25 @@ tracepoint(CLOG_WORKER_C, AllocFailure , arg2, arg3);\
 
 
 
+/*----------------------------------------------------------
+// Decoder Ring for WorkerTimerStats
+// [wrkr][%p] Timer wakeups %u (spun %u), lateness avg %llu us, max %llu us
+// QuicTraceLogVerbose(WorkerTimerStats, "[wrkr][%p] Timer wakeups %u (spun %u), lateness avg %llu us, max %llu us", Worker, Worker->TimerStats.Wakeups, Worker->TimerStats.SpinWakeups, Worker->TimerStats.TotalLatenessUs / Worker->TimerStats.Wakeups, Worker->TimerStats.MaxLatenessUs);
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = Worker->TimerStats.Wakeups = arg3
+// arg4 = arg4 = Worker->TimerStats.SpinWakeups = arg4
+// arg5 = arg5 = Worker->TimerStats.TotalLatenessUs / Worker->TimerStats.Wakeups = arg5
+// arg6 = arg6 = Worker->TimerStats.MaxLatenessUs = arg6
+----------------------------------------------------------*/
+#ifndef _clog_7_ARGS_TRACE_WorkerTimerStats
+#define _clog_7_ARGS_TRACE_WorkerTimerStats(uniqueId, encoded_arg_string, arg2, arg3, arg4, arg5, arg6)\
+tracepoint(CLOG_WORKER_C, WorkerTimerStats , arg2, arg3, arg4, arg5, arg6);\
+
+#endif
+
+
+
+
 #ifdef __cplusplus
 }
 #endif
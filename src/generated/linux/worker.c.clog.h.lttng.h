@@ -285,3 +285,31 @@ TRACEPOINT_EVENT(CLOG_WORKER_C, AllocFailure,
         ctf_integer(uint64_t, arg3, arg3)
     )
 )
+/*----------------------------------------------------------
+// Decoder Ring for WorkerTimerStats
+// [wrkr][%p] Timer wakeups %u (spun %u), lateness avg %llu us, max %llu us
+// QuicTraceLogVerbose(WorkerTimerStats, "[wrkr][%p] Timer wakeups %u (spun %u), lateness avg %llu us, max %llu us", Worker, Worker->TimerStats.Wakeups, Worker->TimerStats.SpinWakeups, Worker->TimerStats.TotalLatenessUs / Worker->TimerStats.Wakeups, Worker->TimerStats.MaxLatenessUs);
+// arg2 = arg2 = Worker = arg2
+// arg3 = arg3 = Worker->TimerStats.Wakeups = arg3
+// arg4 = arg4 = Worker->TimerStats.SpinWakeups = arg4
+// arg5 = arg5 = Worker->TimerStats.TotalLatenessUs / Worker->TimerStats.Wakeups = arg5
+// arg6 = arg6 = Worker->TimerStats.MaxLatenessUs = arg6
+----------------------------------------------------------*/
+TRACEPOINT_EVENT(CLOG_WORKER_C, WorkerTimerStats,
+    TP_ARGS(
+        const void *, arg2,
+        unsigned int, arg3,
+        unsigned int, arg4,
+        unsigned long long, arg5,
+        unsigned long long, arg6), 
+    TP_FIELDS(
+        ctf_integer_hex(uint64_t, arg2, arg2)
+        ctf_integer(unsigned int, arg3, arg3)
+        ctf_integer(unsigned int, arg4, arg4)
+        ctf_integer(uint64_t, arg5, arg5)
+        ctf_integer(uint64_t, arg6, arg6)
+    )
+)
+
+
+
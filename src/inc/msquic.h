@@ -80,6 +80,10 @@ typedef enum QUIC_EXECUTION_PROFILE {
 typedef enum QUIC_LOAD_BALANCING_MODE {
     QUIC_LOAD_BALANCING_DISABLED,               // Default
     QUIC_LOAD_BALANCING_SERVER_ID_IP,           // Encodes IP address in Server ID
+    QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT,      // QUIC-LB plaintext server ID
+    QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED,      // QUIC-LB single pass encrypted server ID
+    QUIC_LOAD_BALANCING_COUNT,                  // The number of supported load balancing modes
+                                                // MUST BE LAST
 } QUIC_LOAD_BALANCING_MODE;
 
 typedef enum QUIC_CREDENTIAL_TYPE {
@@ -152,6 +156,7 @@ DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_RESUMPTION_FLAGS)
 typedef enum QUIC_STREAM_SCHEDULING_SCHEME {
     QUIC_STREAM_SCHEDULING_SCHEME_FIFO          = 0x0000,   // Sends stream data first come, first served. (Default)
     QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN   = 0x0001,   // Sends stream data evenly multiplexed.
+    QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY = 0x0002, // Sends stream data by RFC 9218 urgency and incremental flag.
     QUIC_STREAM_SCHEDULING_SCHEME_COUNT,                    // The number of stream scheduling schemes.
 } QUIC_STREAM_SCHEDULING_SCHEME;
 
@@ -159,6 +164,7 @@ typedef enum QUIC_STREAM_OPEN_FLAGS {
     QUIC_STREAM_OPEN_FLAG_NONE              = 0x0000,
     QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL    = 0x0001,   // Indicates the stream is unidirectional.
     QUIC_STREAM_OPEN_FLAG_0_RTT             = 0x0002,   // The stream was opened via a 0-RTT packet.
+    QUIC_STREAM_OPEN_FLAG_APP_OWNED_BUFFERS = 0x0004,   // Stream data is received into buffers provided by the app.
 } QUIC_STREAM_OPEN_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_STREAM_OPEN_FLAGS)
@@ -201,6 +207,7 @@ typedef enum QUIC_SEND_FLAGS {
     QUIC_SEND_FLAG_FIN                      = 0x0004,   // Indicates the request is the one last sent on the stream.
     QUIC_SEND_FLAG_DGRAM_PRIORITY           = 0x0008,   // Indicates the datagram is higher priority than others.
     QUIC_SEND_FLAG_DELAY_SEND               = 0x0010,   // Indicates the send should be delayed because more will be queued soon.
+    QUIC_SEND_FLAG_DGRAM_EXPIRE             = 0x0020,   // Indicates the datagram is dropped if not sent within DatagramSendTtlMs.
 } QUIC_SEND_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_FLAGS)
@@ -361,9 +368,16 @@ typedef enum QUIC_CIPHER_SUITE {
 
 typedef enum QUIC_CONGESTION_CONTROL_ALGORITHM {
     QUIC_CONGESTION_CONTROL_ALGORITHM_CUBIC,
+    QUIC_CONGESTION_CONTROL_ALGORITHM_BBR,
     QUIC_CONGESTION_CONTROL_ALGORITHM_MAX,
 } QUIC_CONGESTION_CONTROL_ALGORITHM;
 
+typedef enum QUIC_DATAGRAM_DROP_POLICY {
+    QUIC_DATAGRAM_DROP_OLDEST,      // Cancel the oldest queued datagram to make room.
+    QUIC_DATAGRAM_DROP_NEWEST,      // Cancel the newly sent datagram.
+    QUIC_DATAGRAM_DROP_POLICY_MAX,
+} QUIC_DATAGRAM_DROP_POLICY;
+
 //
 // All the available information describing a handshake.
 //
@@ -467,6 +481,16 @@ typedef struct QUIC_STATISTICS_V2 {
     uint32_t KeyUpdateCount;
 
     uint32_t SendCongestionWindow;          // Congestion window size
+    uint32_t SendEcnCongestionCount;        // Number of congestion events caused by ECN CE marks
+    uint64_t SendDeliveryRate;              // Latest delivery rate sample, in bytes per second
+    uint64_t SendMaxDeliveryRate;           // Largest delivery rate sample, in bytes per second
+    uint64_t SendBufferBytes;               // Bytes of app data currently copied into the send buffer
+    uint64_t SendBufferAllocatedBytes;      // Bytes of memory currently held by the send buffer
+    uint64_t RecvConnFlowControlWindow;     // Current connection flow control window, after auto-tuning
+    uint32_t RecvMaxStreamFlowControlWindow;// Largest stream flow control window, after auto-tuning
+    uint32_t RecvWindowAutoTuneCount;       // Number of times auto-tuning grew a connection or stream window
+    uint64_t SendDatagramsExpired;          // Datagrams canceled because their deadline passed before sending
+    uint64_t SendDatagramsDropped;          // Datagrams canceled because the send queue was full
 
     // N.B. New fields must be appended to end
 
@@ -513,6 +537,11 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_PATH_FAILURE,         // Total path challenges that fail ever.
     QUIC_PERF_COUNTER_SEND_STATELESS_RESET, // Total stateless reset packets sent ever.
     QUIC_PERF_COUNTER_SEND_STATELESS_RETRY, // Total stateless retry packets sent ever.
+    QUIC_PERF_COUNTER_STRM_CACHE_HIT,       // Total streams allocated from a worker's stream cache.
+    QUIC_PERF_COUNTER_STRM_CACHE_MISS,      // Total streams allocated with the stream cache empty.
+    QUIC_PERF_COUNTER_WORK_TIMER_WAKEUPS,   // Total worker wakeups for an expired timer ever.
+    QUIC_PERF_COUNTER_WORK_TIMER_SPINS,     // Total worker timer wakeups that were spun for ever.
+    QUIC_PERF_COUNTER_WORK_TIMER_LATENESS,  // Total microseconds worker timer wakeups were late ever.
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
 
@@ -535,13 +564,36 @@ typedef struct QUIC_GLOBAL_SETTINGS {
         struct {
             uint64_t RetryMemoryLimit                       : 1;
             uint64_t LoadBalancingMode                      : 1;
-            uint64_t RESERVED                               : 62;
+            uint64_t WorkerTimerSpinUs                      : 1;
+            uint64_t StreamCacheSize                        : 1;
+            uint64_t RecvWindowMemoryLimit                  : 1;
+            uint64_t CidSteeringEnabled                     : 1;
+            uint64_t RESERVED                               : 58;
         } IsSet;
     };
     uint16_t RetryMemoryLimit;
     uint16_t LoadBalancingMode;
+    uint16_t WorkerTimerSpinUs;
+    uint16_t StreamCacheSize;
+    uint16_t RecvWindowMemoryLimit;
+    uint16_t CidSteeringEnabled;
 } QUIC_GLOBAL_SETTINGS;
 
+#define QUIC_LOAD_BALANCING_MAX_CONFIG_ID       6
+#define QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH 10
+#define QUIC_LOAD_BALANCING_KEY_LENGTH          16
+
+//
+// QUIC-LB configuration shared with the load balancer. Used by the
+// QUIC_LOAD_BALANCING_QUIC_LB_* modes.
+//
+typedef struct QUIC_LOAD_BALANCING_CONFIG {
+    uint8_t ConfigId;           // Config rotation codepoint (0 - 6)
+    uint8_t ServerIdLength;     // 1 - 10 (plaintext) or 1 - 7 (encrypted)
+    uint8_t ServerId[QUIC_LOAD_BALANCING_MAX_SERVER_ID_LENGTH];
+    uint8_t Key[QUIC_LOAD_BALANCING_KEY_LENGTH]; // AES-128 key (encrypted only)
+} QUIC_LOAD_BALANCING_CONFIG;
+
 typedef struct QUIC_SETTINGS {
 
     union {
@@ -578,7 +630,13 @@ typedef struct QUIC_SETTINGS {
             uint64_t ServerResumptionLevel                  : 1;
             uint64_t MaxOperationsPerDrain                  : 1;
             uint64_t MtuDiscoveryMissingProbeCount          : 1;
-            uint64_t RESERVED                               : 33;
+            uint64_t EcnEnabled                             : 1;
+            uint64_t L4sEnabled                             : 1;
+            uint64_t PacingOffloadEnabled                   : 1;
+            uint64_t DatagramSendTtlMs                      : 1;
+            uint64_t DatagramSendQueueLimit                 : 1;
+            uint64_t DatagramSendDropPolicy                 : 1;
+            uint64_t RESERVED                               : 27;
         } IsSet;
     };
 
@@ -611,9 +669,20 @@ typedef struct QUIC_SETTINGS {
     uint8_t MigrationEnabled                : 1;
     uint8_t DatagramReceiveEnabled          : 1;
     uint8_t ServerResumptionLevel           : 2;    // QUIC_SERVER_RESUMPTION_LEVEL
-    uint8_t RESERVED                        : 2;
+    uint8_t EcnEnabled                      : 1;
+    uint8_t L4sEnabled                      : 1;
     uint8_t MaxOperationsPerDrain;
     uint8_t MtuDiscoveryMissingProbeCount;
+    union {
+        uint64_t Flags;
+        struct {
+            uint64_t PacingOffloadEnabled           : 1;
+            uint64_t ReservedFlags                  : 63;
+        };
+    };
+    uint32_t DatagramSendTtlMs;
+    uint16_t DatagramSendQueueLimit;
+    uint8_t DatagramSendDropPolicy;                 // QUIC_DATAGRAM_DROP_POLICY
 
 } QUIC_SETTINGS;
 
@@ -705,6 +774,7 @@ void
 #define QUIC_PARAM_GLOBAL_VERSION_SETTINGS              0x01000007  // QUIC_VERSION_SETTINGS
 #define QUIC_PARAM_GLOBAL_LIBRARY_GIT_HASH              0x01000008  // char[64]
 #endif
+#define QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG         0x01000009  // QUIC_LOAD_BALANCING_CONFIG
 
 //
 // Parameters for Registration.
@@ -782,6 +852,20 @@ typedef struct QUIC_SCHANNEL_CONTEXT_ATTRIBUTE_W {
 #define QUIC_PARAM_STREAM_IDEAL_SEND_BUFFER_SIZE        0x08000002  // uint64_t - bytes
 #define QUIC_PARAM_STREAM_PRIORITY                      0x08000003  // uint16_t - 0 (low) to 0xFFFF (high) - 0x7FFF (default)
 
+//
+// With QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY, the top three bits of
+// QUIC_PARAM_STREAM_PRIORITY select one of the eight RFC 9218 urgency levels
+// (higher priority is lower urgency) and the stream is incremental if bit 12
+// is clear. The default priority is urgency 4, not incremental.
+//
+#define QUIC_STREAM_PRIORITY_URGENCY_COUNT              8
+#define QUIC_STREAM_PRIORITY_URGENCY(Priority) \
+    ((uint8_t)((QUIC_STREAM_PRIORITY_URGENCY_COUNT - 1) - ((uint16_t)(Priority) >> 13)))
+#define QUIC_STREAM_PRIORITY_INCREMENTAL(Priority) \
+    (((uint16_t)(Priority) & 0x1000) == 0)
+#define QUIC_STREAM_PRIORITY_FROM_URGENCY(Urgency, Incremental) \
+    ((uint16_t)((((QUIC_STREAM_PRIORITY_URGENCY_COUNT - 1) - (Urgency)) << 13) | ((Incremental) ? 0 : 0x1FFF)))
+
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
@@ -1325,6 +1409,20 @@ QUIC_STATUS
     _In_ BOOLEAN IsEnabled
     );
 
+//
+// Provides buffers for the stream to receive data into, for streams using app
+// owned receive buffers.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_PROVIDE_RECEIVE_BUFFERS_FN)(
+    _In_ _Pre_defensive_ HQUIC Stream,
+    _In_ uint32_t BufferCount,
+    _In_reads_(BufferCount) _Pre_defensive_
+        const QUIC_BUFFER* Buffers
+    );
+
 //
 // Datagrams
 //
@@ -1345,6 +1443,30 @@ QUIC_STATUS
     _In_opt_ void* ClientSendContext
     );
 
+typedef struct QUIC_DATAGRAM_SEND_ENTRY {
+    HQUIC Connection;
+    const QUIC_BUFFER* Buffers;
+    uint32_t BufferCount;
+    QUIC_SEND_FLAGS Flags;
+    void* ClientSendContext;
+    QUIC_STATUS Status;         // Out: the result of the send for this entry.
+} QUIC_DATAGRAM_SEND_ENTRY;
+
+//
+// Sends a batch of unreliable datagrams, on one or more connections. Each
+// entry is handled as if it were passed to DatagramSend, and its result is
+// written to its Status field. Consecutive entries for the same connection
+// are queued together.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_DATAGRAM_SEND_BATCH_FN)(
+    _In_ uint32_t EntryCount,
+    _Inout_updates_(EntryCount) _Pre_defensive_
+        QUIC_DATAGRAM_SEND_ENTRY* Entries
+    );
+
 //
 // Version 2 API Function Table. Returned from MsQuicOpenVersion when Version
 // is 2. Also returned from MsQuicOpen2.
@@ -1390,6 +1512,11 @@ typedef struct QUIC_API_TABLE {
 
     QUIC_DATAGRAM_SEND_FN               DatagramSend;
 
+    QUIC_STREAM_PROVIDE_RECEIVE_BUFFERS_FN
+                                        StreamProvideReceiveBuffers;
+
+    QUIC_DATAGRAM_SEND_BATCH_FN         DatagramSendBatch;
+
 } QUIC_API_TABLE;
 
 #define QUIC_API_VERSION_1      1 // Not supported any more
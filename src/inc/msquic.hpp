@@ -394,6 +394,12 @@ public:
     MsQuicSettings& SetMigrationEnabled(bool Value) { MigrationEnabled = Value; IsSet.MigrationEnabled = TRUE; return *this; }
     MsQuicSettings& SetDatagramReceiveEnabled(bool Value) { DatagramReceiveEnabled = Value; IsSet.DatagramReceiveEnabled = TRUE; return *this; }
     MsQuicSettings& SetServerResumptionLevel(QUIC_SERVER_RESUMPTION_LEVEL Value) { ServerResumptionLevel = (uint8_t)Value; IsSet.ServerResumptionLevel = TRUE; return *this; }
+    MsQuicSettings& SetEcnEnabled(bool Value) { EcnEnabled = Value; IsSet.EcnEnabled = TRUE; return *this; }
+    MsQuicSettings& SetL4sEnabled(bool Value) { L4sEnabled = Value; IsSet.L4sEnabled = TRUE; return *this; }
+    MsQuicSettings& SetPacingOffloadEnabled(bool Value) { PacingOffloadEnabled = Value; IsSet.PacingOffloadEnabled = TRUE; return *this; }
+    MsQuicSettings& SetDatagramSendTtlMs(uint32_t Value) { DatagramSendTtlMs = Value; IsSet.DatagramSendTtlMs = TRUE; return *this; }
+    MsQuicSettings& SetDatagramSendQueueLimit(uint16_t Value) { DatagramSendQueueLimit = Value; IsSet.DatagramSendQueueLimit = TRUE; return *this; }
+    MsQuicSettings& SetDatagramSendDropPolicy(QUIC_DATAGRAM_DROP_POLICY Value) { DatagramSendDropPolicy = (uint8_t)Value; IsSet.DatagramSendDropPolicy = TRUE; return *this; }
     MsQuicSettings& SetInitialRttMs(uint32_t Value) { InitialRttMs = Value; IsSet.InitialRttMs = TRUE; return *this; }
     MsQuicSettings& SetIdleTimeoutMs(uint64_t Value) { IdleTimeoutMs = Value; IsSet.IdleTimeoutMs = TRUE; return *this; }
     MsQuicSettings& SetHandshakeIdleTimeoutMs(uint64_t Value) { HandshakeIdleTimeoutMs = Value; IsSet.HandshakeIdleTimeoutMs = TRUE; return *this; }
@@ -1220,6 +1226,15 @@ struct MsQuicStream {
         return MsQuic->StreamReceiveSetEnabled(Handle, IsEnabled ? TRUE : FALSE);
     }
 
+    _IRQL_requires_max_(DISPATCH_LEVEL)
+    QUIC_STATUS
+    ProvideReceiveBuffers(
+        _In_ uint32_t BufferCount,
+        _In_reads_(BufferCount) const QUIC_BUFFER* Buffers
+        ) noexcept {
+        return MsQuic->StreamProvideReceiveBuffers(Handle, BufferCount, Buffers);
+    }
+
     QUIC_STATUS
     GetID(_Out_ QUIC_UINT62* ID) const noexcept {
         uint32_t Size = sizeof(*ID);
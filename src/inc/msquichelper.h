@@ -193,6 +193,11 @@ DumpMsQuicPerfCounters(
     printf("  PATH_FAILURE:          %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_PATH_FAILURE]);
     printf("  SEND_STATELESS_RESET:  %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_SEND_STATELESS_RESET]);
     printf("  SEND_STATELESS_RETRY:  %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_SEND_STATELESS_RETRY]);
+    printf("  STRM_CACHE_HIT:        %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_STRM_CACHE_HIT]);
+    printf("  STRM_CACHE_MISS:       %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_STRM_CACHE_MISS]);
+    printf("  WORK_TIMER_WAKEUPS:    %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_TIMER_WAKEUPS]);
+    printf("  WORK_TIMER_SPINS:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_TIMER_SPINS]);
+    printf("  WORK_TIMER_LATENESS:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_TIMER_LATENESS]);
 }
 
 //
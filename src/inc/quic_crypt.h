@@ -20,6 +20,7 @@ extern "C" {
 
 typedef struct CXPLAT_KEY CXPLAT_KEY;
 typedef struct CXPLAT_HP_KEY CXPLAT_HP_KEY;
+typedef struct CXPLAT_BLOCK_KEY CXPLAT_BLOCK_KEY;
 typedef struct CXPLAT_HASH CXPLAT_HASH;
 
 #define CXPLAT_HKDF_PREFIX        "tls13 "
@@ -300,6 +301,49 @@ CxPlatDecrypt(
         uint8_t* Buffer
     );
 
+//
+// A single buffer to be processed as part of a batched AEAD operation. The
+// fields have the same meaning as the parameters to CxPlatEncrypt and
+// CxPlatDecrypt.
+//
+typedef struct CXPLAT_CRYPT_BATCH_ENTRY {
+    uint8_t Iv[CXPLAT_MAX_IV_LENGTH];
+    const uint8_t* AuthData;
+    uint8_t* Buffer;
+    uint16_t AuthDataLength;
+    uint16_t BufferLength;
+} CXPLAT_CRYPT_BATCH_ENTRY;
+
+//
+// Encrypts a batch of buffers with the same key, as if CxPlatEncrypt was
+// called on each entry in order.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatEncryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Batch
+    );
+
+//
+// Decrypts a batch of buffers with the same key, as if CxPlatDecrypt was
+// called on each entry in order. A failure on one entry doesn't stop the rest
+// of the batch; the result of each entry is written to 'Results'. Returns
+// success only if every entry was decrypted and authenticated.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatDecryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Batch,
+    _Out_writes_(BatchSize)
+        QUIC_STATUS* Results
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHpKeyCreate(
@@ -332,6 +376,56 @@ CxPlatHpComputeMask(
         uint8_t* Mask
     );
 
+//
+// The length of a block for the block cipher (AES-128-ECB) interface.
+//
+#define CXPLAT_BLOCK_LENGTH 16
+
+//
+// Creates an AES-128 key for encrypting and decrypting single blocks, as used
+// by QUIC-LB encrypted connection IDs. A key must not be used by more than one
+// thread at a time.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockKeyCreate(
+    _In_reads_(16)
+        const uint8_t* const RawKey,
+    _Out_ CXPLAT_BLOCK_KEY** Key
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatBlockKeyFree(
+    _In_opt_ CXPLAT_BLOCK_KEY* Key
+    );
+
+//
+// Encrypts a single block. Input and Output may be the same buffer.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockEncrypt(
+    _In_ CXPLAT_BLOCK_KEY* Key,
+    _In_reads_bytes_(CXPLAT_BLOCK_LENGTH)
+        const uint8_t* const Input,
+    _Out_writes_bytes_(CXPLAT_BLOCK_LENGTH)
+        uint8_t* Output
+    );
+
+//
+// Decrypts a single block. Input and Output may be the same buffer.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockDecrypt(
+    _In_ CXPLAT_BLOCK_KEY* Key,
+    _In_reads_bytes_(CXPLAT_BLOCK_LENGTH)
+        const uint8_t* const Input,
+    _Out_writes_bytes_(CXPLAT_BLOCK_LENGTH)
+        uint8_t* Output
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHashCreate(
@@ -368,6 +368,7 @@ CxPlatDataPathUninitialize(
 #define CXPLAT_DATAPATH_FEATURE_RECV_COALESCING       0x0002
 #define CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION     0x0004
 #define CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING    0x0008
+#define CXPLAT_DATAPATH_FEATURE_SEND_TXTIME           0x0010
 
 //
 // Queries the currently supported features of the datapath.
@@ -460,6 +461,9 @@ typedef struct CXPLAT_UDP_CONFIG {
     uint32_t Flags;                     // CXPLAT_SOCKET_FLAG_*
     uint32_t InterfaceIndex;            // 0 means any/all
     void* CallbackContext;              // optional
+    uint16_t PartitionCount;            // Server only. Partitions encoded in local CIDs. 0 means none
+    uint16_t PartitionMask;             // Server only. Partition ID bits holding the partition index
+    uint8_t PartitionIdOffset;          // Server only. Offset of the partition ID in local CIDs
 #ifdef QUIC_COMPARTMENT_ID
     QUIC_COMPARTMENT_ID CompartmentId;  // optional
 #endif
@@ -619,6 +623,18 @@ CxPlatSendDataIsFull(
     _In_ CXPLAT_SEND_DATA* SendData
     );
 
+//
+// Sets the earliest time (as returned by CxPlatTimeUs64) the datagrams in the
+// send context should leave the host. Ignored unless the datapath supports
+// CXPLAT_DATAPATH_FEATURE_SEND_TXTIME.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataSetTxTime(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint64_t TxTimeUs
+    );
+
 //
 // Sends the data over the socket.
 //
@@ -631,6 +647,27 @@ CxPlatSocketSend(
     _In_ uint16_t PartitionId
     );
 
+//
+// Opens a send batch on the calling thread. Datapaths that hand sends to the
+// kernel through a submission queue may hold back the sends issued on this
+// thread until the matching CxPlatSocketSendBatchEnd, and then submit them
+// together. Batches may be nested. Other datapaths ignore them.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchBegin(
+    void
+    );
+
+//
+// Closes the calling thread's send batch, submitting any held back sends.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchEnd(
+    void
+    );
+
 //
 // Sets a parameter on the socket.
 //
@@ -143,6 +143,12 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_PLATFORM_WORKER           '94cQ' // Qc49 - QUIC platform worker
 #define QUIC_POOL_ROUTE_RESOLUTION_WORKER   'A4cQ' // Qc4A - QUIC route resolution worker
 #define QUIC_POOL_ROUTE_RESOLUTION_OPER     'B4cQ' // Qc4B - QUIC route resolution operation
+#define QUIC_POOL_SENT_PACKET_RING          'C4cQ' // Qc4C - QUIC sent packet ring
+#define QUIC_POOL_PLATFORM_POOL_MAGAZINE    'D4cQ' // Qc4D - QUIC Platform pool magazine
+#define QUIC_POOL_PROVIDED_RECV_BUFFERS     'E4cQ' // Qc4E - QUIC App provided receive buffers
+#define QUIC_POOL_SENDBUF_SLAB              'F4cQ' // Qc4F - QUIC send buffer slab
+#define QUIC_POOL_STREAM_WINDOW             'G4cQ' // Qc4G - QUIC stream set window
+#define QUIC_POOL_TLS_BLOCK_KEY             'H4cQ' // Qc4H - QUIC Platform block cipher key
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
@@ -91,7 +91,7 @@ extern "C" {
 #ifdef CX_PLATFORM_DARWIN
 #define YieldProcessor()
 #else
-#define YieldProcessor() pthread_yield()
+#define YieldProcessor() sched_yield()
 #endif
 
 inline
@@ -212,6 +212,10 @@ InterlockedIncrement64(
 }
 
 #define QuicReadPtrNoFence(p) ((void*)(*p)) // TODO
+#define QuicReadPtrAcquire(p) __atomic_load_n((void**)(p), __ATOMIC_ACQUIRE)
+#define QuicWritePtrRelease(p, v) __atomic_store_n((void**)(p), (void*)(v), __ATOMIC_RELEASE)
+
+#define MemoryBarrier() __sync_synchronize()
 
 //
 // Assertion interfaces.
@@ -386,58 +390,82 @@ typedef CXPLAT_RW_LOCK CXPLAT_DISPATCH_RW_LOCK;
 
 //
 // Represents a QUIC memory pool used for fixed sized allocations.
-// This must be below the lock definitions.
+//
+// Each thread caches free entries in a pair of per-thread magazines, so most
+// allocations and frees touch no shared state. Full and empty magazines are
+// exchanged with a lock-free depot shared by all threads; this is how entries
+// freed on one thread (e.g. by the datapath) get back to the thread that
+// allocates them (e.g. a worker). The depot's depth adapts: it grows when
+// allocations miss and shrinks when frees overflow it.
+//
+// Both are bounded in bytes as well as entries, so pools of large entries
+// cache fewer of them: a magazine holds at most CXPLAT_POOL_MAGAZINE_BYTES
+// and the depot at most CXPLAT_POOL_MAXIMUM_BYTES of entries (but always at
+// least one entry per magazine and one magazine).
 //
 
-FORCEINLINE
-void
-CxPlatListPushEntry(
-    _Inout_ CXPLAT_SLIST_ENTRY* ListHead,
-    _Inout_ __drv_aliasesMem CXPLAT_SLIST_ENTRY* Entry
-    );
+#define CXPLAT_POOL_MAGAZINE_SIZE   32  // Max entries per magazine
+#define CXPLAT_POOL_DEPOT_SIZE      64  // Max full magazines in the depot (power of 2)
+#define CXPLAT_POOL_MAX_THREADS     256 // Threads with their own magazines
 
-FORCEINLINE
-CXPLAT_SLIST_ENTRY*
-CxPlatListPopEntry(
-    _Inout_ CXPLAT_SLIST_ENTRY* ListHead
-    );
+#define CXPLAT_POOL_DEFAULT_DEPTH   256 // Copied from EX_MAXIMUM_LOOKASIDE_DEPTH_BASE
+#define CXPLAT_POOL_MAXIMUM_DEPTH   (CXPLAT_POOL_DEPOT_SIZE * CXPLAT_POOL_MAGAZINE_SIZE)
+
+#define CXPLAT_POOL_MAGAZINE_BYTES  (64 * 1024)
+#define CXPLAT_POOL_MAXIMUM_BYTES   (4 * 1024 * 1024)
+
+typedef struct CXPLAT_POOL_DEPOT CXPLAT_POOL_DEPOT;
 
 typedef struct CXPLAT_POOL {
 
     //
-    // List of free entries.
+    // The shared magazine depot and per-thread magazines. NULL if they
+    // couldn't be allocated, in which case all entries come from the heap.
     //
 
-    CXPLAT_SLIST_ENTRY ListHead;
+    CXPLAT_POOL_DEPOT* Depot;
 
     //
-    // Number of free entries in the list.
+    // Size of entries.
     //
 
-    uint16_t ListDepth;
+    uint32_t Size;
 
     //
-    // Lock to synchronize access to the List.
-    // LINUX_TODO: Check how to make this lock free?
+    // The memory tag to use for any allocation from this pool.
     //
 
-    CXPLAT_LOCK Lock;
+    uint32_t Tag;
+
+} CXPLAT_POOL;
+
+typedef struct CXPLAT_POOL_STATS {
 
     //
-    // Size of entries.
+    // Allocations satisfied from cached entries.
     //
 
-    uint32_t Size;
+    uint64_t Hits;
 
     //
-    // The memory tag to use for any allocation from this pool.
+    // Allocations that had to go to the heap.
     //
 
-    uint32_t Tag;
+    uint64_t Misses;
 
-} CXPLAT_POOL;
+    //
+    // Free entries currently cached, in per-thread magazines and the depot.
+    //
+
+    uint32_t Depth;
+
+    //
+    // The current (adaptive) limit on the number of entries in the depot.
+    //
 
-#define CXPLAT_POOL_MAXIMUM_DEPTH   256 // Copied from EX_MAXIMUM_LOOKASIDE_DEPTH_BASE
+    uint32_t MaxDepth;
+
+} CXPLAT_POOL_STATS;
 
 #if DEBUG
 typedef struct CXPLAT_POOL_ENTRY {
@@ -451,98 +479,39 @@ CxPlatGetAllocFailDenominator(
     );
 #endif
 
-inline
 void
 CxPlatPoolInitialize(
     _In_ BOOLEAN IsPaged,
     _In_ uint32_t Size,
     _In_ uint32_t Tag,
     _Inout_ CXPLAT_POOL* Pool
-    )
-{
-#if DEBUG
-    CXPLAT_DBG_ASSERT(Size >= sizeof(CXPLAT_POOL_ENTRY));
-#endif
-    Pool->Size = Size;
-    Pool->Tag = Tag;
-    CxPlatLockInitialize(&Pool->Lock);
-    Pool->ListDepth = 0;
-    CxPlatZeroMemory(&Pool->ListHead, sizeof(Pool->ListHead));
-    UNREFERENCED_PARAMETER(IsPaged);
-}
+    );
 
-inline
 void
 CxPlatPoolUninitialize(
     _Inout_ CXPLAT_POOL* Pool
-    )
-{
-    void* Entry;
-    CxPlatLockAcquire(&Pool->Lock);
-    while ((Entry = CxPlatListPopEntry(&Pool->ListHead)) != NULL) {
-        CXPLAT_FRE_ASSERT(Pool->ListDepth > 0);
-        Pool->ListDepth--;
-        CxPlatLockRelease(&Pool->Lock);
-        CxPlatFree(Entry, Pool->Tag);
-        CxPlatLockAcquire(&Pool->Lock);
-    }
-    CxPlatLockRelease(&Pool->Lock);
-    CxPlatLockUninitialize(&Pool->Lock);
-}
+    );
 
-inline
 void*
 CxPlatPoolAlloc(
     _Inout_ CXPLAT_POOL* Pool
-    )
-{
-#if DEBUG
-    if (CxPlatGetAllocFailDenominator()) {
-        return CxPlatAlloc(Pool->Size, Pool->Tag);
-    }
-#endif
-    CxPlatLockAcquire(&Pool->Lock);
-    void* Entry = CxPlatListPopEntry(&Pool->ListHead);
-    if (Entry != NULL) {
-        CXPLAT_FRE_ASSERT(Pool->ListDepth > 0);
-        Pool->ListDepth--;
-    }
-    CxPlatLockRelease(&Pool->Lock);
-    if (Entry == NULL) {
-        Entry = CxPlatAlloc(Pool->Size, Pool->Tag);
-    }
-#if DEBUG
-    if (Entry != NULL) {
-        ((CXPLAT_POOL_ENTRY*)Entry)->SpecialFlag = 0;
-    }
-#endif
-    return Entry;
-}
+    );
 
-inline
 void
 CxPlatPoolFree(
     _Inout_ CXPLAT_POOL* Pool,
     _In_ void* Entry
-    )
-{
-#if DEBUG
-    if (CxPlatGetAllocFailDenominator()) {
-        CxPlatFree(Entry, Pool->Tag);
-        return;
-    }
-    CXPLAT_DBG_ASSERT(((CXPLAT_POOL_ENTRY*)Entry)->SpecialFlag != CXPLAT_POOL_SPECIAL_FLAG);
-    ((CXPLAT_POOL_ENTRY*)Entry)->SpecialFlag = CXPLAT_POOL_SPECIAL_FLAG;
-#endif
-    if (Pool->ListDepth >= CXPLAT_POOL_MAXIMUM_DEPTH) {
-        CxPlatFree(Entry, Pool->Tag);
-    } else {
-        CxPlatLockAcquire(&Pool->Lock);
-        CxPlatListPushEntry(&Pool->ListHead, (CXPLAT_SLIST_ENTRY*)Entry);
-        Pool->ListDepth++;
-        CxPlatLockRelease(&Pool->Lock);
-    }
-}
+    );
+
+//
+// Returns a snapshot of the pool's counters. Values read while other threads
+// use the pool are approximate.
+//
+void
+CxPlatPoolGetStats(
+    _In_ const CXPLAT_POOL* Pool,
+    _Out_ CXPLAT_POOL_STATS* Stats
+    );
 
 //
 // Reference Count Interface
@@ -600,6 +569,12 @@ CxPlatGetAbsoluteTime(
     _Out_ struct timespec *Time
     );
 
+void
+CxPlatGetAbsoluteTimeUs(
+    _In_ uint64_t DeltaUs,
+    _Out_ struct timespec *Time
+    );
+
 #define CxPlatTimeUs32() (uint32_t)CxPlatTimeUs64()
 #define CxPlatTimeMs64()  (CxPlatTimeUs64() / CXPLAT_MICROSEC_PER_MS)
 #define CxPlatTimeMs32() (uint32_t)CxPlatTimeMs64()
@@ -822,9 +797,9 @@ CxPlatInternalEventWaitForever(
 
 inline
 BOOLEAN
-CxPlatInternalEventWaitWithTimeout(
+CxPlatInternalEventWaitWithTimeoutUs(
     _Inout_ CXPLAT_EVENT* Event,
-    _In_ uint32_t TimeoutMs
+    _In_ uint64_t TimeoutUs
     )
 {
     BOOLEAN WaitSatisfied = FALSE;
@@ -835,7 +810,7 @@ CxPlatInternalEventWaitWithTimeout(
     // Get absolute time.
     //
 
-    CxPlatGetAbsoluteTime(TimeoutMs, &Ts);
+    CxPlatGetAbsoluteTimeUs(TimeoutUs, &Ts);
 
     Result = pthread_mutex_lock(&Event->Mutex);
     CXPLAT_FRE_ASSERT(Result == 0);
@@ -867,11 +842,22 @@ Exit:
     return WaitSatisfied;
 }
 
+inline
+BOOLEAN
+CxPlatInternalEventWaitWithTimeout(
+    _Inout_ CXPLAT_EVENT* Event,
+    _In_ uint32_t TimeoutMs
+    )
+{
+    return CxPlatInternalEventWaitWithTimeoutUs(Event, MS_TO_US((uint64_t)TimeoutMs));
+}
+
 #define CxPlatEventUninitialize(Event) CxPlatInternalEventUninitialize(&Event)
 #define CxPlatEventSet(Event) CxPlatInternalEventSet(&Event)
 #define CxPlatEventReset(Event) CxPlatInternalEventReset(&Event)
 #define CxPlatEventWaitForever(Event) CxPlatInternalEventWaitForever(&Event)
 #define CxPlatEventWaitWithTimeout(Event, TimeoutMs) CxPlatInternalEventWaitWithTimeout(&Event, TimeoutMs)
+#define CxPlatEventWaitWithTimeoutUs(Event, TimeoutUs) CxPlatInternalEventWaitWithTimeoutUs(&Event, TimeoutUs)
 
 //
 // Thread Interfaces.
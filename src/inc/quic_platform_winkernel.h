@@ -330,6 +330,8 @@ typedef struct CXPLAT_DISPATCH_RW_LOCK {
 #define QuicReadLongPtrNoFence ReadNoFence
 #endif
 #define QuicReadPtrNoFence ReadPointerNoFence
+#define QuicReadPtrAcquire(p) ReadPointerAcquire((PVOID*)(p))
+#define QuicWritePtrRelease(p, v) WritePointerRelease((PVOID*)(p), (PVOID)(v))
 
 typedef LONG_PTR CXPLAT_REF_COUNT;
 
@@ -448,6 +450,19 @@ _CxPlatEventWaitWithTimeout(
 }
 #define CxPlatEventWaitWithTimeout(Event, TimeoutMs) \
     (STATUS_SUCCESS == _CxPlatEventWaitWithTimeout(&Event, TimeoutMs))
+inline
+NTSTATUS
+_CxPlatEventWaitWithTimeoutUs(
+    _In_ CXPLAT_EVENT* Event,
+    _In_ uint64_t TimeoutUs
+    )
+{
+    LARGE_INTEGER Timeout100Ns;
+    Timeout100Ns.QuadPart = -(int64_t)(TimeoutUs * 10);
+    return KeWaitForSingleObject(Event, Executive, KernelMode, FALSE, &Timeout100Ns);
+}
+#define CxPlatEventWaitWithTimeoutUs(Event, TimeoutUs) \
+    (STATUS_SUCCESS == _CxPlatEventWaitWithTimeoutUs(&Event, TimeoutUs))
 
 //
 // Time Measurement Interfaces
@@ -436,8 +436,12 @@ typedef SRWLOCK CXPLAT_DISPATCH_RW_LOCK;
 
 #ifdef QUIC_RESTRICTED_BUILD
 #define QuicReadPtrNoFence(p) ((void*)(*p))
+#define QuicReadPtrAcquire(p) InterlockedCompareExchangePointer((PVOID*)(p), NULL, NULL)
+#define QuicWritePtrRelease(p, v) (void)InterlockedExchangePointer((PVOID*)(p), (PVOID)(v))
 #else
 #define QuicReadPtrNoFence ReadPointerNoFence
+#define QuicReadPtrAcquire(p) ReadPointerAcquire((PVOID*)(p))
+#define QuicWritePtrRelease(p, v) WritePointerRelease((PVOID*)(p), (PVOID)(v))
 #endif
 
 typedef LONG_PTR CXPLAT_REF_COUNT;
@@ -547,6 +551,11 @@ typedef HANDLE CXPLAT_EVENT;
 #define CxPlatEventWaitForever(Event) WaitForSingleObject(Event, INFINITE)
 #define CxPlatEventWaitWithTimeout(Event, timeoutMs) \
     (WAIT_OBJECT_0 == WaitForSingleObject(Event, timeoutMs))
+//
+// WaitForSingleObject only has millisecond resolution, so round up.
+//
+#define CxPlatEventWaitWithTimeoutUs(Event, timeoutUs) \
+    (WAIT_OBJECT_0 == WaitForSingleObject(Event, (DWORD)US_TO_MS((timeoutUs) + 999)))
 
 //
 // Time Measurement Interfaces
@@ -94,6 +94,8 @@ typedef enum QUIC_TRACE_API_TYPE {
     QUIC_TRACE_API_STREAM_RECEIVE_COMPLETE,
     QUIC_TRACE_API_STREAM_RECEIVE_SET_ENABLED,
     QUIC_TRACE_API_DATAGRAM_SEND,
+    QUIC_TRACE_API_STREAM_PROVIDE_RECEIVE_BUFFERS,
+    QUIC_TRACE_API_DATAGRAM_SEND_BATCH,
     QUIC_TRACE_API_COUNT // Must be last
 } QUIC_TRACE_API_TYPE;
 
@@ -134,6 +134,8 @@ pub const EXECUTION_PROFILE_TYPE_REAL_TIME: ExecutionProfile = 3;
 pub type LoadBalancingMode = u32;
 pub const LOAD_BALANCING_DISABLED: LoadBalancingMode = 0;
 pub const LOAD_BALANCING_SERVER_ID_IP: LoadBalancingMode = 1;
+pub const LOAD_BALANCING_QUIC_LB_PLAINTEXT: LoadBalancingMode = 2;
+pub const LOAD_BALANCING_QUIC_LB_ENCRYPTED: LoadBalancingMode = 3;
 
 /// Type of credentials used for a connection.
 pub type CredentialType = u32;
@@ -196,12 +198,14 @@ pub const SEND_RESUMPTION_FLAG_FINAL: SendResumptionFlags = 1;
 pub type StreamSchedulingScheme = u32;
 pub const STREAM_SCHEDULING_SCHEME_FIFO: StreamSchedulingScheme = 0;
 pub const STREAM_SCHEDULING_SCHEME_ROUND_ROBIN: StreamSchedulingScheme = 1;
-pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY: StreamSchedulingScheme = 2;
+pub const STREAM_SCHEDULING_SCHEME_COUNT: StreamSchedulingScheme = 3;
 
 pub type StreamOpenFlags = u32;
 pub const STREAM_OPEN_FLAG_NONE: StreamOpenFlags = 0;
 pub const STREAM_OPEN_FLAG_UNIDIRECTIONAL: StreamOpenFlags = 1;
 pub const STREAM_OPEN_FLAG_0_RTT: StreamOpenFlags = 2;
+pub const STREAM_OPEN_FLAG_APP_OWNED_BUFFERS: StreamOpenFlags = 4;
 
 pub type StreamStartFlags = u32;
 pub const STREAM_START_FLAG_NONE: StreamStartFlags = 0;
@@ -232,6 +236,7 @@ pub const SEND_FLAG_START: SendFlags = 2;
 pub const SEND_FLAG_FIN: SendFlags = 4;
 pub const SEND_FLAG_DGRAM_PRIORITY: SendFlags = 8;
 pub const SEND_FLAG_DELAY_SEND: SendFlags = 16;
+pub const SEND_FLAG_DGRAM_EXPIRE: SendFlags = 32;
 
 pub type DatagramSendState = u32;
 pub const DATAGRAM_SEND_SENT: DatagramSendState = 0;
@@ -335,6 +340,16 @@ pub struct TicketKeyConfig {
     pub material_length: u8,
 }
 
+/// QUIC-LB configuration shared with the load balancer.
+#[repr(C)]
+#[derive(Copy, Clone)]
+pub struct LoadBalancingConfig {
+    pub config_id: u8,
+    pub server_id_length: u8,
+    pub server_id: [u8; 10usize],
+    pub key: [u8; 16usize],
+}
+
 /// A generic wrapper for contiguous buffer.
 #[repr(C)]
 #[derive(Debug, Copy, Clone)]
@@ -558,6 +573,7 @@ pub const PARAM_GLOBAL_SETTINGS: u32 = 0x01000005;
 pub const PARAM_GLOBAL_GLOBAL_SETTINGS: u32 = 0x01000006;
 pub const PARAM_GLOBAL_VERSION_SETTINGS: u32 = 0x01000007;
 pub const PARAM_GLOBAL_LIBRARY_GIT_HASH: u32 = 0x01000008;
+pub const PARAM_GLOBAL_LOAD_BALANCING_CONFIG: u32 = 0x01000009;
 
 pub const PARAM_CONFIGURATION_SETTINGS: u32 = 0x03000000;
 pub const PARAM_CONFIGURATION_TICKET_KEYS: u32 = 0x03000001;
@@ -774,6 +790,17 @@ pub struct StreamEvent {
 pub type StreamEventHandler =
     extern "C" fn(stream: Handle, context: *mut c_void, event: &StreamEvent) -> u32;
 
+#[repr(C)]
+#[derive(Debug, Copy, Clone)]
+pub struct DatagramSendEntry {
+    pub connection: Handle,
+    pub buffers: *const Buffer,
+    pub buffer_count: u32,
+    pub flags: SendFlags,
+    pub client_send_context: *const c_void,
+    pub status: u32,
+}
+
 #[repr(C)]
 struct ApiTable {
     set_context: extern "C" fn(handle: Handle, context: *const c_void),
@@ -872,6 +899,10 @@ struct ApiTable {
         flags: SendFlags,
         client_send_context: *const c_void,
     ) -> u32,
+    stream_provide_receive_buffers:
+        extern "C" fn(stream: Handle, buffer_count: u32, buffers: *const Buffer) -> u32,
+    datagram_send_batch:
+        extern "C" fn(entry_count: u32, entries: *mut DatagramSendEntry) -> u32,
 }
 
 #[link(name = "msquic")]
@@ -43,6 +43,28 @@ PerfServer::Init(
         }
     }
 
+    uint8_t LbServerId;
+    if (TryGetValue(argc, argv, "lbsid", &LbServerId)) {
+        QUIC_LOAD_BALANCING_CONFIG LbConfig = {0};
+        LbConfig.ServerIdLength = 1;
+        LbConfig.ServerId[0] = LbServerId;
+        uint16_t LbMode = QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT;
+        const char* LbKey = nullptr;
+        if (TryGetValue(argc, argv, "lbkey", &LbKey)) {
+            if (DecodeHexBuffer(LbKey, sizeof(LbConfig.Key), LbConfig.Key) != sizeof(LbConfig.Key)) {
+                WriteOutput("QUIC-LB key must be a 16 byte hex string.\n");
+                return QUIC_STATUS_INVALID_PARAMETER;
+            }
+            LbMode = QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED;
+        }
+        QUIC_STATUS Status;
+        if (QUIC_FAILED(Status = MsQuic->SetParam(nullptr, QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG, sizeof(LbConfig), &LbConfig)) ||
+            QUIC_FAILED(Status = MsQuic->SetParam(nullptr, QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE, sizeof(LbMode), &LbMode))) {
+            WriteOutput("Failed to set QUIC-LB config, 0x%x!\n", Status);
+            return Status;
+        }
+    }
+
     DataBuffer = (QUIC_BUFFER*)CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_BUFFER) + PERF_DEFAULT_IO_SIZE, QUIC_POOL_PERF);
     if (!DataBuffer) {
         return QUIC_STATUS_OUT_OF_MEMORY;
@@ -85,6 +85,8 @@ PrintHelp(
         "\n"
         "  -bind:<addr>                A local IP address to bind to.\n"
         "  -cibir:<hex_bytes>          A CIBIR well-known idenfitier.\n"
+        "  -lbsid:<0-255>              Use QUIC-LB CIDs with this server ID.\n"
+        "  -lbkey:<hex_bytes>          The 16 byte QUIC-LB key. Encrypts the CIDs.\n"
         "\n"
         "Client: secnetperf -TestName:<Throughput|RPS|HPS> [options]\n"
         "\n"
@@ -489,6 +489,65 @@ CxPlatDecrypt(
     return NtStatusToQuicStatus(Status);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatEncryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Batch
+    )
+{
+    //
+    // BCrypt has no multi-buffer AEAD API. Encrypt the packets back to back
+    // with the same key handle.
+    //
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        QUIC_STATUS Status =
+            CxPlatEncrypt(
+                Key,
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                Batch[i].AuthData,
+                Batch[i].BufferLength,
+                Batch[i].Buffer);
+        if (QUIC_FAILED(Status)) {
+            return Status;
+        }
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatDecryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Batch,
+    _Out_writes_(BatchSize)
+        QUIC_STATUS* Results
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        Results[i] =
+            CxPlatDecrypt(
+                Key,
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                Batch[i].AuthData,
+                Batch[i].BufferLength,
+                Batch[i].Buffer);
+        if (QUIC_FAILED(Results[i])) {
+            Status = Results[i];
+        }
+    }
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHpKeyCreate(
@@ -653,6 +712,115 @@ CxPlatHpComputeMask(
     return Status;
 }
 
+typedef struct CXPLAT_BLOCK_KEY {
+    BCRYPT_KEY_HANDLE Key;
+} CXPLAT_BLOCK_KEY;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockKeyCreate(
+    _In_reads_(16)
+        const uint8_t* const RawKey,
+    _Out_ CXPLAT_BLOCK_KEY** NewKey
+    )
+{
+    CXPLAT_BLOCK_KEY* Key = CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_BLOCK_KEY), QUIC_POOL_TLS_BLOCK_KEY);
+    if (Key == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_BLOCK_KEY",
+            sizeof(CXPLAT_BLOCK_KEY));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    NTSTATUS Status =
+        BCryptGenerateSymmetricKey(
+            CXPLAT_AES_ECB_ALG_HANDLE,
+            &Key->Key,
+            NULL, // Let BCrypt manage the memory for this key.
+            0,
+            (uint8_t*)RawKey,
+            16,
+            0);
+    if (!NT_SUCCESS(Status)) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BCryptGenerateSymmetricKey (block)");
+        CXPLAT_FREE(Key, QUIC_POOL_TLS_BLOCK_KEY);
+        return NtStatusToQuicStatus(Status);
+    }
+
+    *NewKey = Key;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatBlockKeyFree(
+    _In_opt_ CXPLAT_BLOCK_KEY* Key
+    )
+{
+    if (Key) {
+        BCryptDestroyKey(Key->Key);
+        CXPLAT_FREE(Key, QUIC_POOL_TLS_BLOCK_KEY);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockEncrypt(
+    _In_ CXPLAT_BLOCK_KEY* Key,
+    _In_reads_bytes_(CXPLAT_BLOCK_LENGTH)
+        const uint8_t* const Input,
+    _Out_writes_bytes_(CXPLAT_BLOCK_LENGTH)
+        uint8_t* Output
+    )
+{
+    ULONG TempSize = 0;
+    return
+        NtStatusToQuicStatus(
+        BCryptEncrypt(
+            Key->Key,
+            (uint8_t*)Input,
+            CXPLAT_BLOCK_LENGTH,
+            NULL,
+            NULL,
+            0,
+            Output,
+            CXPLAT_BLOCK_LENGTH,
+            &TempSize,
+            0));
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockDecrypt(
+    _In_ CXPLAT_BLOCK_KEY* Key,
+    _In_reads_bytes_(CXPLAT_BLOCK_LENGTH)
+        const uint8_t* const Input,
+    _Out_writes_bytes_(CXPLAT_BLOCK_LENGTH)
+        uint8_t* Output
+    )
+{
+    ULONG TempSize = 0;
+    return
+        NtStatusToQuicStatus(
+        BCryptDecrypt(
+            Key->Key,
+            (uint8_t*)Input,
+            CXPLAT_BLOCK_LENGTH,
+            NULL,
+            NULL,
+            0,
+            Output,
+            CXPLAT_BLOCK_LENGTH,
+            &TempSize,
+            0));
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHashCreate(
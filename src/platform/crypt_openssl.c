@@ -37,6 +37,19 @@ Abstract:
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
+#if defined(__x86_64__) || defined(_M_X64)
+#define CXPLAT_CHACHA20_HP_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CXPLAT_AVX2_TARGET
+#else
+#define CXPLAT_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CXPLAT_CHACHA20_HP_NEON 1
+#include <arm_neon.h>
+#endif
 #ifdef QUIC_CLOG
 #include "crypt_openssl.c.clog.h"
 #endif
@@ -44,8 +57,227 @@ Abstract:
 typedef struct CXPLAT_HP_KEY {
     EVP_CIPHER_CTX* CipherCtx;
     CXPLAT_AEAD_TYPE Aead;
+    //
+    // The raw key, as little-endian words, for the vectorized ChaCha20 mask.
+    //
+    uint32_t ChaCha20Key[8];
+#ifdef CXPLAT_CHACHA20_HP_AVX2
+    //
+    // Whether the CPU and OS support AVX2, for the vectorized ChaCha20 mask.
+    //
+    BOOLEAN Avx2Supported;
+#endif
 } CXPLAT_HP_KEY;
 
+#if defined(CXPLAT_CHACHA20_HP_AVX2) || defined(CXPLAT_CHACHA20_HP_NEON)
+
+//
+// ChaCha20 header protection (RFC 9001, Section 5.4.4) runs a single ChaCha20
+// block per packet, with the first 4 bytes of the sample as the block counter
+// and the remaining 12 bytes as the nonce. Instead of one EVP call per sample,
+// the batch is computed with each vector lane holding the block of a different
+// sample. Only the first 16 bytes of each block are written to the mask.
+//
+
+#define CXPLAT_CHACHA20_CONST0 0x61707865
+#define CXPLAT_CHACHA20_CONST1 0x3320646e
+#define CXPLAT_CHACHA20_CONST2 0x79622d32
+#define CXPLAT_CHACHA20_CONST3 0x6b206574
+
+#endif
+
+#ifdef CXPLAT_CHACHA20_HP_AVX2
+
+static
+BOOLEAN
+CxPlatCryptIsAvx2Supported(
+    void
+    )
+{
+#ifdef _MSC_VER
+    int CpuInfo[4];
+    __cpuid(CpuInfo, 0);
+    if (CpuInfo[0] < 7) {
+        return FALSE;
+    }
+    __cpuid(CpuInfo, 1);
+    if ((CpuInfo[2] & (1 << 27)) == 0 || // OSXSAVE
+        (_xgetbv(0) & 0x6) != 0x6) {     // XMM and YMM state
+        return FALSE;
+    }
+    __cpuidex(CpuInfo, 7, 0);
+    return (CpuInfo[1] & (1 << 5)) != 0; // AVX2
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#define CXPLAT_ROTL_AVX2(x, n) \
+    _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+
+#define CXPLAT_QR_AVX2(a, b, c, d) \
+    a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), Rot16); \
+    c = _mm256_add_epi32(c, d); b = CXPLAT_ROTL_AVX2(_mm256_xor_si256(b, c), 12); \
+    a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), Rot8); \
+    c = _mm256_add_epi32(c, d); b = CXPLAT_ROTL_AVX2(_mm256_xor_si256(b, c), 7)
+
+//
+// Computes up to 8 masks at once, one per 32-bit lane.
+//
+CXPLAT_AVX2_TARGET
+static
+void
+CxPlatChaCha20HpMaskAvx2(
+    _In_reads_(8) const uint32_t* Key,
+    _In_ uint8_t BatchSize,
+    _In_reads_bytes_(CXPLAT_HP_SAMPLE_LENGTH * BatchSize)
+        const uint8_t* const Cipher,
+    _Out_writes_bytes_(CXPLAT_HP_SAMPLE_LENGTH * BatchSize)
+        uint8_t* Mask
+    )
+{
+    CXPLAT_DBG_ASSERT(BatchSize <= 8);
+
+    uint32_t Samples[8 * 4] = {0};
+    CxPlatCopyMemory(Samples, Cipher, CXPLAT_HP_SAMPLE_LENGTH * BatchSize);
+
+    const __m256i Rot16 =
+        _mm256_setr_epi8(
+            2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+            2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i Rot8 =
+        _mm256_setr_epi8(
+            3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+            3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    const __m256i Stride = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+
+    __m256i In[16];
+    In[0] = _mm256_set1_epi32((int)CXPLAT_CHACHA20_CONST0);
+    In[1] = _mm256_set1_epi32((int)CXPLAT_CHACHA20_CONST1);
+    In[2] = _mm256_set1_epi32((int)CXPLAT_CHACHA20_CONST2);
+    In[3] = _mm256_set1_epi32((int)CXPLAT_CHACHA20_CONST3);
+    for (uint32_t i = 0; i < 8; ++i) {
+        In[4 + i] = _mm256_set1_epi32((int)Key[i]);
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        In[12 + i] = _mm256_i32gather_epi32((const int*)(Samples + i), Stride, 4);
+    }
+
+    __m256i x0 = In[0], x1 = In[1], x2 = In[2], x3 = In[3];
+    __m256i x4 = In[4], x5 = In[5], x6 = In[6], x7 = In[7];
+    __m256i x8 = In[8], x9 = In[9], x10 = In[10], x11 = In[11];
+    __m256i x12 = In[12], x13 = In[13], x14 = In[14], x15 = In[15];
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        CXPLAT_QR_AVX2(x0, x4, x8, x12);
+        CXPLAT_QR_AVX2(x1, x5, x9, x13);
+        CXPLAT_QR_AVX2(x2, x6, x10, x14);
+        CXPLAT_QR_AVX2(x3, x7, x11, x15);
+        CXPLAT_QR_AVX2(x0, x5, x10, x15);
+        CXPLAT_QR_AVX2(x1, x6, x11, x12);
+        CXPLAT_QR_AVX2(x2, x7, x8, x13);
+        CXPLAT_QR_AVX2(x3, x4, x9, x14);
+    }
+
+    //
+    // Only the first 4 words of each block are needed. Transpose them back
+    // so each sample's words are contiguous.
+    //
+    uint32_t Out[4][8];
+    _mm256_storeu_si256((__m256i*)Out[0], _mm256_add_epi32(x0, In[0]));
+    _mm256_storeu_si256((__m256i*)Out[1], _mm256_add_epi32(x1, In[1]));
+    _mm256_storeu_si256((__m256i*)Out[2], _mm256_add_epi32(x2, In[2]));
+    _mm256_storeu_si256((__m256i*)Out[3], _mm256_add_epi32(x3, In[3]));
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+            CxPlatCopyMemory(Mask + i * CXPLAT_HP_SAMPLE_LENGTH + j * 4, &Out[j][i], 4);
+        }
+    }
+}
+
+#endif // CXPLAT_CHACHA20_HP_AVX2
+
+#ifdef CXPLAT_CHACHA20_HP_NEON
+
+#define CXPLAT_ROTL_NEON(x, n) \
+    vorrq_u32(vshlq_n_u32(x, n), vshrq_n_u32(x, 32 - (n)))
+
+#define CXPLAT_QR_NEON(a, b, c, d) \
+    a = vaddq_u32(a, b); d = vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(veorq_u32(d, a)))); \
+    c = vaddq_u32(c, d); b = CXPLAT_ROTL_NEON(veorq_u32(b, c), 12); \
+    a = vaddq_u32(a, b); d = CXPLAT_ROTL_NEON(veorq_u32(d, a), 8); \
+    c = vaddq_u32(c, d); b = CXPLAT_ROTL_NEON(veorq_u32(b, c), 7)
+
+//
+// Computes up to 4 masks at once, one per 32-bit lane.
+//
+static
+void
+CxPlatChaCha20HpMaskNeon4(
+    _In_reads_(8) const uint32_t* Key,
+    _In_ uint8_t BatchSize,
+    _In_reads_bytes_(CXPLAT_HP_SAMPLE_LENGTH * BatchSize)
+        const uint8_t* const Cipher,
+    _Out_writes_bytes_(CXPLAT_HP_SAMPLE_LENGTH * BatchSize)
+        uint8_t* Mask
+    )
+{
+    CXPLAT_DBG_ASSERT(BatchSize <= 4);
+
+    uint32_t Samples[4 * 4] = {0};
+    CxPlatCopyMemory(Samples, Cipher, CXPLAT_HP_SAMPLE_LENGTH * BatchSize);
+
+    //
+    // The de-interleaving load transposes the samples so each vector holds
+    // the same word of every sample.
+    //
+    const uint32x4x4_t Nonce = vld4q_u32(Samples);
+
+    uint32x4_t In[16];
+    In[0] = vdupq_n_u32(CXPLAT_CHACHA20_CONST0);
+    In[1] = vdupq_n_u32(CXPLAT_CHACHA20_CONST1);
+    In[2] = vdupq_n_u32(CXPLAT_CHACHA20_CONST2);
+    In[3] = vdupq_n_u32(CXPLAT_CHACHA20_CONST3);
+    for (uint32_t i = 0; i < 8; ++i) {
+        In[4 + i] = vdupq_n_u32(Key[i]);
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        In[12 + i] = Nonce.val[i];
+    }
+
+    uint32x4_t x0 = In[0], x1 = In[1], x2 = In[2], x3 = In[3];
+    uint32x4_t x4 = In[4], x5 = In[5], x6 = In[6], x7 = In[7];
+    uint32x4_t x8 = In[8], x9 = In[9], x10 = In[10], x11 = In[11];
+    uint32x4_t x12 = In[12], x13 = In[13], x14 = In[14], x15 = In[15];
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        CXPLAT_QR_NEON(x0, x4, x8, x12);
+        CXPLAT_QR_NEON(x1, x5, x9, x13);
+        CXPLAT_QR_NEON(x2, x6, x10, x14);
+        CXPLAT_QR_NEON(x3, x7, x11, x15);
+        CXPLAT_QR_NEON(x0, x5, x10, x15);
+        CXPLAT_QR_NEON(x1, x6, x11, x12);
+        CXPLAT_QR_NEON(x2, x7, x8, x13);
+        CXPLAT_QR_NEON(x3, x4, x9, x14);
+    }
+
+    //
+    // The interleaving store transposes the first 4 words back so each
+    // sample's mask is contiguous.
+    //
+    uint32x4x4_t Block;
+    Block.val[0] = vaddq_u32(x0, In[0]);
+    Block.val[1] = vaddq_u32(x1, In[1]);
+    Block.val[2] = vaddq_u32(x2, In[2]);
+    Block.val[3] = vaddq_u32(x3, In[3]);
+    uint32_t Out[4 * 4];
+    vst4q_u32(Out, Block);
+    CxPlatCopyMemory(Mask, Out, CXPLAT_HP_SAMPLE_LENGTH * BatchSize);
+}
+
+#endif // CXPLAT_CHACHA20_HP_NEON
+
 QUIC_STATUS
 CxPlatCryptInitialize(
     void
@@ -295,6 +527,67 @@ CxPlatDecrypt(
     return QUIC_STATUS_SUCCESS;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatEncryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Batch
+    )
+{
+    //
+    // OpenSSL doesn't expose multi-buffer AES-GCM, but the cipher context
+    // already holds the expanded key, so each packet only needs a new IV. Run
+    // the whole batch back to back to keep the key schedule and GHASH tables
+    // hot in the cache.
+    //
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        QUIC_STATUS Status =
+            CxPlatEncrypt(
+                Key,
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                Batch[i].AuthData,
+                Batch[i].BufferLength,
+                Batch[i].Buffer);
+        if (QUIC_FAILED(Status)) {
+            return Status;
+        }
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatDecryptBatch(
+    _In_ CXPLAT_KEY* Key,
+    _In_ uint8_t BatchSize,
+    _Inout_updates_(BatchSize)
+        CXPLAT_CRYPT_BATCH_ENTRY* Batch,
+    _Out_writes_(BatchSize)
+        QUIC_STATUS* Results
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    for (uint8_t i = 0; i < BatchSize; ++i) {
+        Results[i] =
+            CxPlatDecrypt(
+                Key,
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                Batch[i].AuthData,
+                Batch[i].BufferLength,
+                Batch[i].Buffer);
+        if (QUIC_FAILED(Results[i])) {
+            Status = Results[i];
+        }
+    }
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatHpKeyCreate(
@@ -339,6 +632,10 @@ CxPlatHpKeyCreate(
         break;
     case CXPLAT_AEAD_CHACHA20_POLY1305:
         Aead = EVP_chacha20();
+        CxPlatCopyMemory(Key->ChaCha20Key, RawKey, sizeof(Key->ChaCha20Key));
+#ifdef CXPLAT_CHACHA20_HP_AVX2
+        Key->Avx2Supported = CxPlatCryptIsAvx2Supported();
+#endif
         break;
     default:
         Status = QUIC_STATUS_NOT_SUPPORTED;
@@ -372,6 +669,7 @@ CxPlatHpKeyFree(
 {
     if (Key != NULL) {
         EVP_CIPHER_CTX_free(Key->CipherCtx);
+        CxPlatSecureZeroMemory(Key->ChaCha20Key, sizeof(Key->ChaCha20Key));
         CXPLAT_FREE(Key, QUIC_POOL_TLS_HP_KEY);
     }
 }
@@ -389,6 +687,29 @@ CxPlatHpComputeMask(
 {
     int OutLen = 0;
     if (Key->Aead == CXPLAT_AEAD_CHACHA20_POLY1305) {
+#if defined(CXPLAT_CHACHA20_HP_AVX2)
+        if (Key->Avx2Supported) {
+            for (uint8_t i = 0; i < BatchSize; i += 8) {
+                const uint8_t Count = (uint8_t)CXPLAT_MIN(BatchSize - i, 8);
+                CxPlatChaCha20HpMaskAvx2(
+                    Key->ChaCha20Key,
+                    Count,
+                    Cipher + i * CXPLAT_HP_SAMPLE_LENGTH,
+                    Mask + i * CXPLAT_HP_SAMPLE_LENGTH);
+            }
+            return QUIC_STATUS_SUCCESS;
+        }
+#endif
+#if defined(CXPLAT_CHACHA20_HP_NEON)
+        for (uint8_t i = 0; i < BatchSize; i += 4) {
+            const uint8_t Count = (uint8_t)CXPLAT_MIN(BatchSize - i, 4);
+            CxPlatChaCha20HpMaskNeon4(
+                Key->ChaCha20Key,
+                Count,
+                Cipher + i * CXPLAT_HP_SAMPLE_LENGTH,
+                Mask + i * CXPLAT_HP_SAMPLE_LENGTH);
+        }
+#else
         static const uint8_t Zero[] = { 0, 0, 0, 0, 0 };
         for (uint32_t i = 0, Offset = 0; i < BatchSize; ++i, Offset += CXPLAT_HP_SAMPLE_LENGTH) {
             if (EVP_EncryptInit_ex(Key->CipherCtx, NULL, NULL, NULL, Cipher + Offset) != 1) {
@@ -406,6 +727,7 @@ CxPlatHpComputeMask(
                 return QUIC_STATUS_TLS_ERROR;
             }
         }
+#endif
     } else {
         if (EVP_EncryptUpdate(Key->CipherCtx, Mask, &OutLen, Cipher, CXPLAT_HP_SAMPLE_LENGTH * BatchSize) != 1) {
             QuicTraceEvent(
@@ -418,6 +740,128 @@ CxPlatHpComputeMask(
     return QUIC_STATUS_SUCCESS;
 }
 
+//
+// Block cipher abstraction
+//
+
+typedef struct CXPLAT_BLOCK_KEY {
+    EVP_CIPHER_CTX* EncryptCtx;
+    EVP_CIPHER_CTX* DecryptCtx;
+} CXPLAT_BLOCK_KEY;
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockKeyCreate(
+    _In_reads_(16)
+        const uint8_t* const RawKey,
+    _Out_ CXPLAT_BLOCK_KEY** NewKey
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CXPLAT_BLOCK_KEY* Key = CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_BLOCK_KEY), QUIC_POOL_TLS_BLOCK_KEY);
+    if (Key == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_BLOCK_KEY",
+            sizeof(CXPLAT_BLOCK_KEY));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    Key->EncryptCtx = EVP_CIPHER_CTX_new();
+    Key->DecryptCtx = EVP_CIPHER_CTX_new();
+    if (Key->EncryptCtx == NULL || Key->DecryptCtx == NULL) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "Cipherctx alloc failed");
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Exit;
+    }
+
+    if (EVP_EncryptInit_ex(Key->EncryptCtx, EVP_aes_128_ecb(), NULL, RawKey, NULL) != 1 ||
+        EVP_DecryptInit_ex(Key->DecryptCtx, EVP_aes_128_ecb(), NULL, RawKey, NULL) != 1) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "EVP_EncryptInit_ex (block) failed");
+        Status = QUIC_STATUS_TLS_ERROR;
+        goto Exit;
+    }
+
+    //
+    // Without padding, each update produces its block immediately.
+    //
+    EVP_CIPHER_CTX_set_padding(Key->EncryptCtx, 0);
+    EVP_CIPHER_CTX_set_padding(Key->DecryptCtx, 0);
+
+    *NewKey = Key;
+    Key = NULL;
+
+Exit:
+
+    CxPlatBlockKeyFree(Key);
+
+    return Status;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatBlockKeyFree(
+    _In_opt_ CXPLAT_BLOCK_KEY* Key
+    )
+{
+    if (Key != NULL) {
+        EVP_CIPHER_CTX_free(Key->EncryptCtx);
+        EVP_CIPHER_CTX_free(Key->DecryptCtx);
+        CXPLAT_FREE(Key, QUIC_POOL_TLS_BLOCK_KEY);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockEncrypt(
+    _In_ CXPLAT_BLOCK_KEY* Key,
+    _In_reads_bytes_(CXPLAT_BLOCK_LENGTH)
+        const uint8_t* const Input,
+    _Out_writes_bytes_(CXPLAT_BLOCK_LENGTH)
+        uint8_t* Output
+    )
+{
+    int OutLen = 0;
+    if (EVP_EncryptUpdate(Key->EncryptCtx, Output, &OutLen, Input, CXPLAT_BLOCK_LENGTH) != 1 ||
+        OutLen != CXPLAT_BLOCK_LENGTH) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "EVP_EncryptUpdate (block) failed");
+        return QUIC_STATUS_TLS_ERROR;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+CxPlatBlockDecrypt(
+    _In_ CXPLAT_BLOCK_KEY* Key,
+    _In_reads_bytes_(CXPLAT_BLOCK_LENGTH)
+        const uint8_t* const Input,
+    _Out_writes_bytes_(CXPLAT_BLOCK_LENGTH)
+        uint8_t* Output
+    )
+{
+    int OutLen = 0;
+    if (EVP_DecryptUpdate(Key->DecryptCtx, Output, &OutLen, Input, CXPLAT_BLOCK_LENGTH) != 1 ||
+        OutLen != CXPLAT_BLOCK_LENGTH) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "EVP_DecryptUpdate (block) failed");
+        return QUIC_STATUS_TLS_ERROR;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
 //
 // Hash abstraction
 //
@@ -16,11 +16,14 @@ Environment:
 #include "platform_internal.h"
 #include <arpa/inet.h>
 #include <inttypes.h>
+#include <linux/bpf.h>
 #include <linux/filter.h>
 #include <linux/in6.h>
+#include <linux/net_tstamp.h>
 #include <netinet/udp.h>
 #include <sys/epoll.h>
 #include <sys/eventfd.h>
+#include <sys/syscall.h>
 #ifdef QUIC_CLOG
 #include "datapath_epoll.c.clog.h"
 #endif
@@ -65,6 +68,22 @@ cxplat_sendmmsg_shim(
 #endif
 #endif
 
+//
+// UDP receive coalescing (GRO) is opt-in, as it trades receive buffer memory
+// for fewer receive syscalls.
+//
+#ifndef ENABLE_POSIX_GRO
+#ifdef UDP_GRO
+#undef UDP_GRO
+#endif
+#endif
+
+#ifdef DISABLE_POSIX_TXTIME
+#ifdef SO_TXTIME
+#undef SO_TXTIME
+#endif
+#endif
+
 //
 // If we have UDP segmentation support, use a single batch. Without UDP
 // segmentation, increase batch size to gain back some performance
@@ -77,7 +96,25 @@ cxplat_sendmmsg_shim(
 #define CXPLAT_MAX_BATCH_RECEIVE 43
 
 //
-// A receive block to receive a UDP packet over the sockets.
+// When receive coalescing is enabled, each receive slot holds a coalesced
+// payload, so fewer slots are needed per recvmmsg call.
+//
+#define CXPLAT_MAX_BATCH_RECEIVE_GRO 8
+
+//
+// The maximum UDP receive coalescing payload.
+//
+#define CXPLAT_MAX_GRO_PAYLOAD_LENGTH (UINT16_MAX - CXPLAT_UDP_HEADER_SIZE)
+
+//
+// The maximum number of UDP datagrams to preallocate for a single coalesced
+// receive.
+//
+#define CXPLAT_MAX_GRO_DATAGRAMS 64
+
+//
+// A receive block to receive a UDP packet (or a coalesced set of UDP packets)
+// over the sockets.
 //
 typedef struct CXPLAT_DATAPATH_RECV_BLOCK {
     //
@@ -86,9 +123,10 @@ typedef struct CXPLAT_DATAPATH_RECV_BLOCK {
     CXPLAT_POOL* OwningPool;
 
     //
-    // The recv buffer used by MsQuic.
+    // The number of datagrams indicated from this block that have not been
+    // returned yet.
     //
-    CXPLAT_RECV_DATA RecvPacket;
+    long ReferenceCount;
 
     //
     // Represents the network route.
@@ -96,16 +134,33 @@ typedef struct CXPLAT_DATAPATH_RECV_BLOCK {
     CXPLAT_ROUTE Route;
 
     //
-    // Buffer that actually stores the UDP payload.
+    // This is followed by the datagram contexts (CXPLAT_DATAPATH_RECV_DATA),
+    // each Datapath->DatagramStride apart, and then by the buffer that
+    // actually stores the UDP payload, at Datapath->RecvPayloadOffset.
     //
-    uint8_t Buffer[MAX_UDP_PAYLOAD_LENGTH];
 
+} CXPLAT_DATAPATH_RECV_BLOCK;
+
+//
+// A single datagram indicated out of a receive block.
+//
+typedef struct CXPLAT_DATAPATH_RECV_DATA {
     //
-    // This follows the recv block.
+    // The recv buffer used by MsQuic.
+    //
+    CXPLAT_RECV_DATA RecvData;
+
+    //
+    // The receive block that holds the payload for this datagram.
+    //
+    CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock;
+
+    //
+    // This follows the recv data.
     //
     // CXPLAT_RECV_PACKET RecvContext;
 
-} CXPLAT_DATAPATH_RECV_BLOCK;
+} CXPLAT_DATAPATH_RECV_DATA;
 
 //
 // Send context.
@@ -157,6 +212,12 @@ typedef struct CXPLAT_SEND_DATA {
     //
     uint32_t TotalSize;
 
+    //
+    // The earliest departure time (in CxPlatTimeUs64 microseconds) passed to
+    // the kernel with SCM_TXTIME; zero to send immediately.
+    //
+    uint64_t TxTime;
+
     //
     // BufferCount - The buffer count in use.
     //
@@ -184,6 +245,9 @@ typedef struct CXPLAT_SEND_DATA {
 typedef struct CXPLAT_RECV_MSG_CONTROL_BUFFER {
     char Data[CMSG_SPACE(sizeof(struct in6_pktinfo)) +
               CMSG_SPACE(sizeof(struct in_pktinfo)) +
+#ifdef UDP_GRO
+              CMSG_SPACE(sizeof(int)) +
+#endif
               2 * CMSG_SPACE(sizeof(int))];
 } CXPLAT_RECV_MSG_CONTROL_BUFFER;
 
@@ -413,6 +477,26 @@ typedef struct CXPLAT_DATAPATH {
     //
     size_t ClientRecvContextLength;
 
+    //
+    // The number of receive blocks posted per recvmmsg call.
+    //
+    uint32_t RecvBatchSize;
+
+    //
+    // The size of each datagram context in a receive block.
+    //
+    uint32_t DatagramStride;
+
+    //
+    // The offset of the payload buffer in a receive block.
+    //
+    uint32_t RecvPayloadOffset;
+
+    //
+    // The length of the payload buffer in a receive block.
+    //
+    uint32_t RecvPayloadLength;
+
     //
     // The proc count to create per proc datapath state.
     //
@@ -434,14 +518,13 @@ CxPlatSocketSendInternal(
     _In_ BOOLEAN IsPendedSend
     );
 
-#ifdef UDP_SEGMENT
+#if defined(UDP_SEGMENT) || defined(UDP_GRO) || defined(SO_TXTIME)
 QUIC_STATUS
 CxPlatDataPathQuerySockoptSupport(
     _Inout_ CXPLAT_DATAPATH* Datapath
     )
 {
     int Result;
-    socklen_t OptionLength;
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
 
     int UdpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
@@ -454,8 +537,9 @@ CxPlatDataPathQuerySockoptSupport(
         goto Error;
     }
 
+#ifdef UDP_SEGMENT
     int SegmentSize;
-    OptionLength = sizeof(SegmentSize);
+    socklen_t OptionLength = sizeof(SegmentSize);
     Result =
         getsockopt(
             UdpSocket,
@@ -472,6 +556,52 @@ CxPlatDataPathQuerySockoptSupport(
     } else {
         Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION;
     }
+#endif
+
+#ifdef UDP_GRO
+    int Option = TRUE;
+    Result =
+        setsockopt(
+            UdpSocket,
+            IPPROTO_UDP,
+            UDP_GRO,
+            &Option,
+            sizeof(Option));
+    if (Result != 0) {
+        int SockError = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            SockError,
+            "setsockopt(UDP_GRO) not supported");
+    } else {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_RECV_COALESCING;
+    }
+#endif
+
+#ifdef SO_TXTIME
+    struct sock_txtime TxTimeConfig = {
+        .clockid = CLOCK_MONOTONIC,
+        .flags = 0
+    };
+    Result =
+        setsockopt(
+            UdpSocket,
+            SOL_SOCKET,
+            SO_TXTIME,
+            &TxTimeConfig,
+            sizeof(TxTimeConfig));
+    if (Result != 0) {
+        int SockError = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            SockError,
+            "setsockopt(SO_TXTIME) not supported");
+    } else {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_TXTIME;
+    }
+#endif
 
 Error:
     if (UdpSocket != INVALID_SOCKET) {
@@ -519,7 +649,7 @@ CxPlatProcessorContextInitialize(
     CXPLAT_DBG_ASSERT(Datapath != NULL);
 
     RecvPacketLength =
-        sizeof(CXPLAT_DATAPATH_RECV_BLOCK) + Datapath->ClientRecvContextLength;
+        Datapath->RecvPayloadOffset + Datapath->RecvPayloadLength;
 
     ProcContext->Index = Index;
     CxPlatPoolInitialize(
@@ -665,13 +795,36 @@ CxPlatDataPathInitialize(
     Datapath->Features = CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING;
     CxPlatRundownInitialize(&Datapath->BindingsRundown);
 
-#ifdef UDP_SEGMENT
+#if defined(UDP_SEGMENT) || defined(UDP_GRO) || defined(SO_TXTIME)
     Status = CxPlatDataPathQuerySockoptSupport(Datapath);
     if (QUIC_FAILED(Status)) {
         goto Exit;
     }
 #endif
 
+    //
+    // Size the receive blocks. With receive coalescing, a single receive
+    // block holds up to CXPLAT_MAX_GRO_DATAGRAMS datagrams which all share the
+    // same payload buffer.
+    //
+    uint32_t MessageCount;
+    if (Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING) {
+        MessageCount = CXPLAT_MAX_GRO_DATAGRAMS;
+        Datapath->RecvBatchSize = CXPLAT_MAX_BATCH_RECEIVE_GRO;
+        Datapath->RecvPayloadLength = CXPLAT_MAX_GRO_PAYLOAD_LENGTH;
+    } else {
+        MessageCount = 1;
+        Datapath->RecvBatchSize = CXPLAT_MAX_BATCH_RECEIVE;
+        Datapath->RecvPayloadLength = MAX_UDP_PAYLOAD_LENGTH;
+    }
+    Datapath->DatagramStride =
+        (uint32_t)ALIGN_UP(
+            sizeof(CXPLAT_DATAPATH_RECV_DATA) + ClientRecvContextLength,
+            void*);
+    Datapath->RecvPayloadOffset =
+        (uint32_t)ALIGN_UP(sizeof(CXPLAT_DATAPATH_RECV_BLOCK), void*) +
+        MessageCount * Datapath->DatagramStride;
+
     //
     // Initialize the per processor contexts.
     //
@@ -752,12 +905,32 @@ CxPlatDataPathAllocRecvBlock(
     } else {
         CxPlatZeroMemory(RecvBlock, sizeof(*RecvBlock));
         RecvBlock->OwningPool = &DatapathProc->RecvBlockPool;
-        RecvBlock->RecvPacket.Buffer = RecvBlock->Buffer;
-        RecvBlock->RecvPacket.Allocated = TRUE;
     }
     return RecvBlock;
 }
 
+CXPLAT_DATAPATH_RECV_DATA*
+CxPlatDataPathRecvBlockGetDatagram(
+    _In_ const CXPLAT_DATAPATH* Datapath,
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock,
+    _In_ uint32_t Index
+    )
+{
+    return (CXPLAT_DATAPATH_RECV_DATA*)
+        ((uint8_t*)RecvBlock +
+            ALIGN_UP(sizeof(CXPLAT_DATAPATH_RECV_BLOCK), void*) +
+            Index * Datapath->DatagramStride);
+}
+
+uint8_t*
+CxPlatDataPathRecvBlockGetPayload(
+    _In_ const CXPLAT_DATAPATH* Datapath,
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock
+    )
+{
+    return (uint8_t*)RecvBlock + Datapath->RecvPayloadOffset;
+}
+
 void
 CxPlatDataPathPopulateTargetAddress(
     _In_ QUIC_ADDRESS_FAMILY Family,
@@ -900,6 +1073,117 @@ Exit:
     return Status;
 }
 
+#define CXPLAT_BPF_INSN(Code, Dst, Src, Off, Imm) \
+    { .code = (Code), .dst_reg = (Dst), .src_reg = (Src), .off = (Off), .imm = (Imm) }
+
+//
+// Attaches an eBPF program that steers each short header packet to the socket
+// of the partition encoded in its destination CID, so that it is received on
+// the processor of the worker that owns the connection. Long header packets
+// may still carry client chosen CIDs, so they fall back to the kernel's
+// 4-tuple hash. That keeps a new connection's handshake on the socket its
+// Initial arrived on, whose partition the connection then encodes in its CIDs.
+//
+QUIC_STATUS
+CxPlatSocketConfigureCidSteering(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const CXPLAT_UDP_CONFIG* Config
+    )
+{
+#ifdef SO_ATTACH_REUSEPORT_EBPF
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    int Result = 0;
+    const int32_t PartitionIdOffset = 1 + Config->PartitionIdOffset;
+
+    //
+    // The core copies the partition ID into the CID in host byte order.
+    //
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const int32_t PartitionIdLowByte = PartitionIdOffset;
+    const int32_t PartitionIdHighByte = PartitionIdOffset + 1;
+#else
+    const int32_t PartitionIdLowByte = PartitionIdOffset + 1;
+    const int32_t PartitionIdHighByte = PartitionIdOffset;
+#endif
+
+    //
+    // The program runs on the UDP payload, and its return value is the index
+    // of the socket in the reuseport group, which is the index of its socket
+    // context. Any index past the last socket selects by hash.
+    //
+    struct bpf_insn Program[] = {
+        // R6 = skb (for BPF_LD_ABS)
+        CXPLAT_BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_6, BPF_REG_1, 0, 0),
+        // if (skb->len < PartitionIdOffset + 2) goto Hash
+        CXPLAT_BPF_INSN(BPF_LDX | BPF_MEM | BPF_W, BPF_REG_0, BPF_REG_6, offsetof(struct __sk_buff, len), 0),
+        CXPLAT_BPF_INSN(BPF_JMP | BPF_JLT | BPF_K, BPF_REG_0, 0, 10, PartitionIdOffset + 2),
+        // if (Packet[0] & 0x80 /* long header */) goto Hash
+        CXPLAT_BPF_INSN(BPF_LD | BPF_ABS | BPF_B, 0, 0, 0, 0),
+        CXPLAT_BPF_INSN(BPF_JMP | BPF_JSET | BPF_K, BPF_REG_0, 0, 8, 0x80),
+        // R0 = PartitionId (host byte order)
+        CXPLAT_BPF_INSN(BPF_LD | BPF_ABS | BPF_B, 0, 0, 0, PartitionIdHighByte),
+        CXPLAT_BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, BPF_REG_7, BPF_REG_0, 0, 0),
+        CXPLAT_BPF_INSN(BPF_LD | BPF_ABS | BPF_B, 0, 0, 0, PartitionIdLowByte),
+        CXPLAT_BPF_INSN(BPF_ALU64 | BPF_LSH | BPF_K, BPF_REG_7, 0, 0, 8),
+        CXPLAT_BPF_INSN(BPF_ALU64 | BPF_OR | BPF_X, BPF_REG_0, BPF_REG_7, 0, 0),
+        // return (PartitionId & PartitionMask) % PartitionCount
+        CXPLAT_BPF_INSN(BPF_ALU64 | BPF_AND | BPF_K, BPF_REG_0, 0, 0, Config->PartitionMask),
+        CXPLAT_BPF_INSN(BPF_ALU64 | BPF_MOD | BPF_K, BPF_REG_0, 0, 0, Config->PartitionCount),
+        CXPLAT_BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0),
+        // Hash: return UINT32_MAX
+        CXPLAT_BPF_INSN(BPF_ALU | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, -1),
+        CXPLAT_BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0)
+    };
+
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.prog_type = BPF_PROG_TYPE_SOCKET_FILTER;
+    Attr.insns = (uint64_t)(size_t)Program;
+    Attr.insn_cnt = ARRAYSIZE(Program);
+    Attr.license = (uint64_t)(size_t)"MIT";
+
+    int ProgramFd = (int)syscall(__NR_bpf, BPF_PROG_LOAD, &Attr, sizeof(Attr));
+    if (ProgramFd < 0) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            Status,
+            "bpf(BPF_PROG_LOAD) failed");
+        return Status;
+    }
+
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            SOL_SOCKET,
+            SO_ATTACH_REUSEPORT_EBPF,
+            (const void*)&ProgramFd,
+            sizeof(ProgramFd));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            Status,
+            "setsockopt(SO_ATTACH_REUSEPORT_EBPF) failed");
+    }
+
+    //
+    // The reuseport group holds its own reference on the program.
+    //
+    close(ProgramFd);
+
+    return Status;
+#else
+    UNREFERENCED_PARAMETER(SocketContext);
+    UNREFERENCED_PARAMETER(Config);
+    return QUIC_STATUS_NOT_SUPPORTED;
+#endif
+}
+
 QUIC_STATUS
 CxPlatSocketConfigureRss(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
@@ -1184,6 +1468,59 @@ CxPlatSocketContextInitialize(
         goto Exit;
     }
 
+#ifdef UDP_GRO
+    if (Binding->Datapath->Features & CXPLAT_DATAPATH_FEATURE_RECV_COALESCING) {
+        Option = TRUE;
+        Result =
+            setsockopt(
+                SocketContext->SocketFd,
+                IPPROTO_UDP,
+                UDP_GRO,
+                (const void*)&Option,
+                sizeof(Option));
+        if (Result == SOCKET_ERROR) {
+            Status = errno;
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                Status,
+                "setsockopt(UDP_GRO) failed");
+            goto Exit;
+        }
+    }
+#endif
+
+#ifdef SO_TXTIME
+    if (Binding->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME) {
+        //
+        // Departure times are in CLOCK_MONOTONIC, the same clock as
+        // CxPlatTimeUs64, which is what the fq qdisc expects.
+        //
+        struct sock_txtime TxTimeConfig = {
+            .clockid = CLOCK_MONOTONIC,
+            .flags = 0
+        };
+        Result =
+            setsockopt(
+                SocketContext->SocketFd,
+                SOL_SOCKET,
+                SO_TXTIME,
+                (const void*)&TxTimeConfig,
+                sizeof(TxTimeConfig));
+        if (Result == SOCKET_ERROR) {
+            Status = errno;
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                Status,
+                "setsockopt(SO_TXTIME) failed");
+            goto Exit;
+        }
+    }
+#endif
+
     //
     // The socket is shared by multiple QUIC endpoints, so increase the receive
     // buffer size.
@@ -1340,7 +1677,10 @@ CxPlatSocketContextUninitializeComplete(
 {
     for (ssize_t i = 0; i < CXPLAT_MAX_BATCH_RECEIVE; i++) {
         if (SocketContext->CurrentRecvBlocks[i] != NULL) {
-            CxPlatRecvDataReturn(&SocketContext->CurrentRecvBlocks[i]->RecvPacket);
+            CxPlatPoolFree(
+                SocketContext->CurrentRecvBlocks[i]->OwningPool,
+                SocketContext->CurrentRecvBlocks[i]);
+            SocketContext->CurrentRecvBlocks[i] = NULL;
         }
     }
 
@@ -1383,10 +1723,12 @@ CxPlatSocketContextPrepareReceive(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
     )
 {
+    const CXPLAT_DATAPATH* Datapath = SocketContext->ProcContext->Datapath;
+
     CxPlatZeroMemory(&SocketContext->RecvMsgHdr, sizeof(SocketContext->RecvMsgHdr));
     CxPlatZeroMemory(&SocketContext->RecvMsgControl, sizeof(SocketContext->RecvMsgControl));
 
-    for (ssize_t i = 0; i < CXPLAT_MAX_BATCH_RECEIVE; i++) {
+    for (uint32_t i = 0; i < Datapath->RecvBatchSize; i++) {
         if (SocketContext->CurrentRecvBlocks[i] == NULL) {
             SocketContext->CurrentRecvBlocks[i] =
                 CxPlatDataPathAllocRecvBlock(SocketContext->ProcContext);
@@ -1402,12 +1744,12 @@ CxPlatSocketContextPrepareReceive(
         CXPLAT_DATAPATH_RECV_BLOCK* CurrentBlock = SocketContext->CurrentRecvBlocks[i];
         struct msghdr* MsgHdr = &SocketContext->RecvMsgHdr[i].msg_hdr;
 
-        SocketContext->RecvIov[i].iov_base = CurrentBlock->RecvPacket.Buffer;
-        CurrentBlock->RecvPacket.BufferLength = SocketContext->RecvIov[i].iov_len;
-        CurrentBlock->RecvPacket.Route = &CurrentBlock->Route;
+        SocketContext->RecvIov[i].iov_base =
+            CxPlatDataPathRecvBlockGetPayload(Datapath, CurrentBlock);
+        SocketContext->RecvIov[i].iov_len = Datapath->RecvPayloadLength;
 
-        MsgHdr->msg_name = &CurrentBlock->RecvPacket.Route->RemoteAddress;
-        MsgHdr->msg_namelen = sizeof(CurrentBlock->RecvPacket.Route->RemoteAddress);
+        MsgHdr->msg_name = &CurrentBlock->Route.RemoteAddress;
+        MsgHdr->msg_namelen = sizeof(CurrentBlock->Route.RemoteAddress);
         MsgHdr->msg_iov = &SocketContext->RecvIov[i];
         MsgHdr->msg_iovlen = 1;
         MsgHdr->msg_control = &SocketContext->RecvMsgControl[i].Data;
@@ -1455,7 +1797,10 @@ CxPlatSocketContextStartReceive(
         //
         for (ssize_t i = 0; i < CXPLAT_MAX_BATCH_RECEIVE; i++) {
             if (SocketContext->CurrentRecvBlocks[i] != NULL) {
-                CxPlatRecvDataReturn(&SocketContext->CurrentRecvBlocks[i]->RecvPacket);
+                CxPlatPoolFree(
+                    SocketContext->CurrentRecvBlocks[i]->OwningPool,
+                    SocketContext->CurrentRecvBlocks[i]);
+                SocketContext->CurrentRecvBlocks[i] = NULL;
             }
         }
 
@@ -1475,41 +1820,33 @@ CxPlatSocketContextRecvComplete(
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     uint32_t BytesTransferred = 0;
+    const CXPLAT_DATAPATH* Datapath = SocketContext->ProcContext->Datapath;
 
-    CXPLAT_FRE_ASSERT(MessagesReceived <= CXPLAT_MAX_BATCH_RECEIVE);
+    CXPLAT_FRE_ASSERT(MessagesReceived <= (int)Datapath->RecvBatchSize);
 
     CXPLAT_RECV_DATA* DatagramHead = NULL;
-    CXPLAT_RECV_DATA* DatagramTail = NULL;
+    CXPLAT_RECV_DATA** DatagramTail = &DatagramHead;
 
     for (int CurrentMessage = 0; CurrentMessage < MessagesReceived; CurrentMessage++) {
         CXPLAT_DATAPATH_RECV_BLOCK* CurrentBlock = SocketContext->CurrentRecvBlocks[CurrentMessage];
         SocketContext->CurrentRecvBlocks[CurrentMessage] = NULL;
-        CXPLAT_RECV_DATA* RecvPacket = &CurrentBlock->RecvPacket;
-
-        if (DatagramHead == NULL) {
-            DatagramHead = RecvPacket;
-            DatagramTail = DatagramHead;
-        } else {
-            DatagramTail->Next = RecvPacket;
-            DatagramTail = DatagramTail->Next;
-        }
 
         BOOLEAN FoundLocalAddr = FALSE;
         BOOLEAN FoundTOS = FALSE;
-        QUIC_ADDR* LocalAddr = &RecvPacket->Route->LocalAddress;
+        uint8_t TypeOfService = 0;
+        QUIC_ADDR* LocalAddr = &CurrentBlock->Route.LocalAddress;
         if (LocalAddr->Ipv6.sin6_family == AF_INET6) {
             LocalAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
         }
-        QUIC_ADDR* RemoteAddr = &RecvPacket->Route->RemoteAddress;
+        QUIC_ADDR* RemoteAddr = &CurrentBlock->Route.RemoteAddress;
         if (RemoteAddr->Ipv6.sin6_family == AF_INET6) {
             RemoteAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
         }
         CxPlatConvertFromMappedV6(RemoteAddr, RemoteAddr);
 
-        RecvPacket->BufferLength = SocketContext->RecvMsgHdr[CurrentMessage].msg_len;
-        BytesTransferred += RecvPacket->BufferLength;
-
-        RecvPacket->TypeOfService = 0;
+        uint32_t MessageBytes = SocketContext->RecvMsgHdr[CurrentMessage].msg_len;
+        uint32_t SegmentLength = MessageBytes;
+        BytesTransferred += MessageBytes;
 
         struct cmsghdr *CMsg;
         struct msghdr* Msg = &SocketContext->RecvMsgHdr[CurrentMessage].msg_hdr;
@@ -1528,7 +1865,7 @@ CxPlatSocketContextRecvComplete(
                     LocalAddr->Ipv6.sin6_scope_id = PktInfo6->ipi6_ifindex;
                     FoundLocalAddr = TRUE;
                 } else if (CMsg->cmsg_type == IPV6_TCLASS) {
-                    RecvPacket->TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
+                    TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
                     FoundTOS = TRUE;
                 }
             } else if (CMsg->cmsg_level == IPPROTO_IP) {
@@ -1540,25 +1877,92 @@ CxPlatSocketContextRecvComplete(
                     LocalAddr->Ipv6.sin6_scope_id = PktInfo->ipi_ifindex;
                     FoundLocalAddr = TRUE;
                 } else if (CMsg->cmsg_type == IP_TOS) {
-                    RecvPacket->TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
+                    TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
                     FoundTOS = TRUE;
                 }
+#ifdef UDP_GRO
+            } else if (CMsg->cmsg_level == IPPROTO_UDP) {
+                if (CMsg->cmsg_type == UDP_GRO) {
+                    //
+                    // The payload is a set of coalesced datagrams, all of
+                    // the given length except possibly the last one.
+                    //
+                    int GroSize = *(int*)CMSG_DATA(CMsg);
+                    CXPLAT_DBG_ASSERT(GroSize > 0 && GroSize <= CXPLAT_MAX_GRO_PAYLOAD_LENGTH);
+                    if (GroSize > 0 && (uint32_t)GroSize < SegmentLength) {
+                        SegmentLength = (uint32_t)GroSize;
+                    }
+                }
+#endif
             }
         }
 
         CXPLAT_FRE_ASSERT(FoundLocalAddr);
         CXPLAT_FRE_ASSERT(FoundTOS);
 
-        RecvPacket->PartitionIndex = SocketContext->ProcContext->Index;
-
         QuicTraceEvent(
             DatapathRecv,
             "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
             SocketContext->Binding,
-            (uint32_t)RecvPacket->BufferLength,
-            (uint32_t)RecvPacket->BufferLength,
+            MessageBytes,
+            (uint16_t)SegmentLength,
             CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddr), LocalAddr),
             CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddr), RemoteAddr));
+
+        if (MessageBytes == 0) {
+            CxPlatPoolFree(CurrentBlock->OwningPool, CurrentBlock);
+            continue;
+        }
+
+        //
+        // Split the (possibly coalesced) payload into individual datagrams
+        // that all share the receive block's payload buffer.
+        //
+        uint8_t* RecvPayload = CxPlatDataPathRecvBlockGetPayload(Datapath, CurrentBlock);
+        uint32_t MessageCount = 0;
+        while (MessageBytes != 0) {
+            if (MessageCount == CXPLAT_MAX_GRO_DATAGRAMS) {
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    SocketContext->Binding,
+                    MessageBytes,
+                    "Exceeded GRO preallocation capacity");
+                break;
+            }
+
+            if (SegmentLength > MessageBytes) {
+                //
+                // The last message is smaller than all the rest.
+                //
+                SegmentLength = MessageBytes;
+            }
+
+            CXPLAT_DATAPATH_RECV_DATA* RecvData =
+                CxPlatDataPathRecvBlockGetDatagram(Datapath, CurrentBlock, MessageCount);
+            CXPLAT_RECV_DATA* Datagram = &RecvData->RecvData;
+            CxPlatZeroMemory(Datagram, sizeof(*Datagram));
+            RecvData->RecvBlock = CurrentBlock;
+            Datagram->Buffer = RecvPayload;
+            Datagram->BufferLength = (uint16_t)SegmentLength;
+            Datagram->Route = &CurrentBlock->Route;
+            Datagram->PartitionIndex = SocketContext->ProcContext->Index;
+            Datagram->TypeOfService = TypeOfService;
+            Datagram->Allocated = TRUE;
+
+            *DatagramTail = Datagram;
+            DatagramTail = &Datagram->Next;
+
+            RecvPayload += SegmentLength;
+            MessageBytes -= SegmentLength;
+            MessageCount++;
+        }
+
+        if (MessageCount == 0) {
+            CxPlatPoolFree(CurrentBlock->OwningPool, CurrentBlock);
+        } else {
+            CurrentBlock->ReferenceCount = (long)MessageCount;
+        }
     }
 
     if (BytesTransferred == 0 || DatagramHead == NULL) {
@@ -1771,7 +2175,9 @@ CxPlatSocketContextProcessEvents(
     if (EPOLLIN & Events) {
         while (TRUE) {
 
-            for (ssize_t i = 0; i < CXPLAT_MAX_BATCH_RECEIVE; i++) {
+            const uint32_t RecvBatchSize =
+                SocketContext->ProcContext->Datapath->RecvBatchSize;
+            for (uint32_t i = 0; i < RecvBatchSize; i++) {
                 CXPLAT_DBG_ASSERT(SocketContext->CurrentRecvBlocks[i] != NULL);
             }
 
@@ -1779,7 +2185,7 @@ CxPlatSocketContextProcessEvents(
                 recvmmsg(
                     SocketContext->SocketFd,
                     SocketContext->RecvMsgHdr,
-                    CXPLAT_MAX_BATCH_RECEIVE,
+                    RecvBatchSize,
                     0,
                     NULL);
             if (Ret < 0) {
@@ -1860,10 +2266,6 @@ CxPlatSocketCreateUdp(
         Binding->SocketContexts[i].Binding = Binding;
         Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
         Binding->SocketContexts[i].CleanupFd = INVALID_SOCKET;
-        for (ssize_t j = 0; j < CXPLAT_MAX_BATCH_RECEIVE; j++) {
-            Binding->SocketContexts[i].RecvIov[j].iov_len =
-                Binding->Mtu - CXPLAT_MIN_IPV4_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE;
-        }
         Binding->SocketContexts[i].ProcContext = &Datapath->ProcContexts[IsServerSocket ? i : CurrentProc];
         CxPlatListInitializeHead(&Binding->SocketContexts[i].PendingSendDataHead);
         CxPlatLockInitialize(&Binding->SocketContexts[i].PendingSendDataLock);
@@ -1892,9 +2294,15 @@ CxPlatSocketCreateUdp(
         // The return value is being ignored here, as if a system does not support
         // bpf we still want the server to work. If this happens, the sockets will
         // round robin, but each flow will be sent to the same socket, just not
-        // based on RSS.
+        // based on RSS. Steering by the partition in the CID, when the core
+        // asks for it with a non-zero PartitionCount, needs eBPF, which the
+        // kernel may not allow the process to load.
         //
-        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        if (Config->PartitionCount == 0 ||
+            QUIC_FAILED(
+                CxPlatSocketConfigureCidSteering(&Binding->SocketContexts[0], Config))) {
+            (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+        }
     }
 
     CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
@@ -2105,11 +2513,8 @@ CxPlatDataPathRecvPacketToRecvData(
     _In_ const CXPLAT_RECV_PACKET* const Packet
     )
 {
-    CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
-        (CXPLAT_DATAPATH_RECV_BLOCK*)
-            ((char *)Packet - sizeof(CXPLAT_DATAPATH_RECV_BLOCK));
-
-    return &RecvBlock->RecvPacket;
+    return (CXPLAT_RECV_DATA*)
+        (((uint8_t*)Packet) - sizeof(CXPLAT_DATAPATH_RECV_DATA));
 }
 
 CXPLAT_RECV_PACKET*
@@ -2117,10 +2522,8 @@ CxPlatDataPathRecvDataToRecvPacket(
     _In_ const CXPLAT_RECV_DATA* const RecvData
     )
 {
-    CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
-        CXPLAT_CONTAINING_RECORD(RecvData, CXPLAT_DATAPATH_RECV_BLOCK, RecvPacket);
-
-    return (CXPLAT_RECV_PACKET*)(RecvBlock + 1);
+    return (CXPLAT_RECV_PACKET*)
+        (((uint8_t*)RecvData) + sizeof(CXPLAT_DATAPATH_RECV_DATA));
 }
 
 void
@@ -2131,9 +2534,12 @@ CxPlatRecvDataReturn(
     CXPLAT_RECV_DATA* Datagram;
     while ((Datagram = RecvDataChain) != NULL) {
         RecvDataChain = RecvDataChain->Next;
+        Datagram->Allocated = FALSE;
         CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
-            CXPLAT_CONTAINING_RECORD(Datagram, CXPLAT_DATAPATH_RECV_BLOCK, RecvPacket);
-        CxPlatPoolFree(RecvBlock->OwningPool, RecvBlock);
+            CXPLAT_CONTAINING_RECORD(Datagram, CXPLAT_DATAPATH_RECV_DATA, RecvData)->RecvBlock;
+        if (InterlockedDecrement(&RecvBlock->ReferenceCount) == 0) {
+            CxPlatPoolFree(RecvBlock->OwningPool, RecvBlock);
+        }
     }
 }
 
@@ -2408,6 +2814,16 @@ CxPlatSendDataIsFull(
     return !CxPlatSendDataCanAllocSend(SendData, SendData->SegmentSize);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataSetTxTime(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint64_t TxTimeUs
+    )
+{
+    SendData->TxTime = TxTimeUs;
+}
+
 void
 CxPlatSendDataComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketProc,
@@ -2466,6 +2882,9 @@ CxPlatSocketSendInternal(
         CMSG_SPACE(sizeof(int))
     #ifdef UDP_SEGMENT
         + CMSG_SPACE(sizeof(uint16_t))
+    #endif
+    #ifdef SO_TXTIME
+        + CMSG_SPACE(sizeof(uint64_t))
     #endif
         ] = {0};
 
@@ -2577,6 +2996,18 @@ CxPlatSocketSendInternal(
             *((uint16_t*) CMSG_DATA(CMsg)) = SendData->SegmentSize;
         }
 #endif
+
+#ifdef SO_TXTIME
+        if (SendData->TxTime != 0) {
+            Mhdr->msg_controllen += CMSG_SPACE(sizeof(uint64_t));
+            CMsg = CMSG_NXTHDR(Mhdr, CMsg);
+            CXPLAT_DBG_ASSERT(CMsg != NULL);
+            CMsg->cmsg_level = SOL_SOCKET;
+            CMsg->cmsg_type = SCM_TXTIME;
+            CMsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+            *((uint64_t*) CMSG_DATA(CMsg)) = US_TO_NS(SendData->TxTime);
+        }
+#endif
     }
 
     while (SendData->SentMessagesCount < TotalMessagesCount) {
@@ -2670,6 +3101,22 @@ Exit:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchBegin(
+    void
+    )
+{
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchEnd(
+    void
+    )
+{
+}
+
 QUIC_STATUS
 CxPlatSocketSend(
     _In_ CXPLAT_SOCKET* Socket,
@@ -2000,6 +2000,17 @@ CxPlatSendDataIsFull(
     return !CxPlatSendDataCanAllocSend(SendData, SendData->SegmentSize);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataSetTxTime(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint64_t TxTimeUs
+    )
+{
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(TxTimeUs);
+}
+
 void
 CxPlatSendDataComplete(
     _In_ CXPLAT_SOCKET_CONTEXT* SocketProc,
@@ -2221,6 +2232,22 @@ Exit:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchBegin(
+    void
+    )
+{
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchEnd(
+    void
+    )
+{
+}
+
 QUIC_STATUS
 CxPlatSocketSend(
     _In_ CXPLAT_SOCKET* Socket,
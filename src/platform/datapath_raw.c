@@ -14,6 +14,11 @@ Abstract:
 #include "datapath_raw.c.clog.h"
 #endif
 
+#ifndef _WIN32
+#include <dirent.h>
+#include <stdio.h>
+#endif
+
 #pragma warning(disable:4116) // unnamed type definition in parentheses
 #pragma warning(disable:4100) // unreferenced formal parameter
 
@@ -176,24 +181,67 @@ CxPlatDataPathUninitialize(
     CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
 }
 
+#ifdef _WIN32
+#define CxPlatDpRawGetNumaNode(Cpu) ((uint8_t)CxPlatProcessorInfo[Cpu].NumaNode)
+#else
+//
+// Sysfs links each processor to its NUMA node with a "node<N>" entry.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+static
+uint8_t
+CxPlatDpRawGetNumaNode(
+    _In_ uint16_t Cpu
+    )
+{
+    char Path[64];
+    uint8_t NumaNode = 0;
+    snprintf(Path, sizeof(Path), "/sys/devices/system/cpu/cpu%hu", Cpu);
+    DIR* Dir = opendir(Path);
+    if (Dir != NULL) {
+        struct dirent* Entry;
+        unsigned int Node;
+        while ((Entry = readdir(Dir)) != NULL) {
+            if (sscanf(Entry->d_name, "node%u", &Node) == 1) {
+                NumaNode = (uint8_t)Node;
+                break;
+            }
+        }
+        closedir(Dir);
+    }
+    return NumaNode;
+}
+#endif
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 CxPlatDpRawGenerateCpuTable(
     _Inout_ CXPLAT_DATAPATH* Datapath
     )
 {
-    Datapath->NumaNode = (uint8_t)CxPlatProcessorInfo[Datapath->Cpu].NumaNode;
+    Datapath->NumaNode = CxPlatDpRawGetNumaNode(Datapath->Cpu);
 
     //
     // Build up the set of CPUs that are on the same NUMA node as this one.
     //
     Datapath->CpuTableSize = 0;
     for (uint16_t i = 0; i < CxPlatProcMaxCount(); i++) {
+        if (Datapath->CpuTableSize == ARRAYSIZE(Datapath->CpuTable)) {
+            break;
+        }
         if (i != Datapath->Cpu && // Skip raw layer's CPU
-            CxPlatProcessorInfo[i].NumaNode == Datapath->NumaNode) {
+            CxPlatDpRawGetNumaNode(i) == Datapath->NumaNode) {
             Datapath->CpuTable[Datapath->CpuTableSize++] = i;
         }
     }
+
+    if (Datapath->CpuTableSize == 0) {
+        //
+        // Single processor system; the raw layer's CPU has to process the
+        // received packets too.
+        //
+        Datapath->CpuTable[Datapath->CpuTableSize++] = Datapath->Cpu;
+    }
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -202,6 +250,7 @@ CxPlatDataPathGetSupportedFeatures(
     _In_ CXPLAT_DATAPATH* Datapath
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
     return 0;
 }
 
@@ -211,6 +260,7 @@ CxPlatDataPathIsPaddingPreferred(
     _In_ CXPLAT_DATAPATH* Datapath
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
     return FALSE;
 }
 
@@ -224,6 +274,9 @@ CxPlatDataPathGetLocalAddresses(
     _Out_ uint32_t* AddressesCount
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(Addresses);
+    UNREFERENCED_PARAMETER(AddressesCount);
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
@@ -237,6 +290,9 @@ CxPlatDataPathGetGatewayAddresses(
     _Out_ uint32_t* GatewayAddressesCount
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(GatewayAddresses);
+    UNREFERENCED_PARAMETER(GatewayAddressesCount);
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
@@ -248,6 +304,7 @@ CxPlatDataPathResolveAddress(
     _Inout_ QUIC_ADDR* Address
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
     if (QuicAddrFromString(HostName, 0, Address)) {
         return QUIC_STATUS_SUCCESS;
     }
@@ -348,6 +405,11 @@ CxPlatSocketCreateTcp(
     _Out_ CXPLAT_SOCKET** Socket
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(RemoteAddress);
+    UNREFERENCED_PARAMETER(CallbackContext);
+    UNREFERENCED_PARAMETER(Socket);
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
@@ -360,6 +422,10 @@ CxPlatSocketCreateTcpListener(
     _Out_ CXPLAT_SOCKET** NewSocket
     )
 {
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(RecvCallbackContext);
+    UNREFERENCED_PARAMETER(NewSocket);
     return QUIC_STATUS_NOT_SUPPORTED;
 }
 
@@ -376,11 +442,12 @@ CxPlatSocketDelete(
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
-UINT16
+uint16_t
 CxPlatSocketGetLocalMtu(
     _In_ CXPLAT_SOCKET* Socket
     )
 {
+    UNREFERENCED_PARAMETER(Socket);
     return 1500;
 }
 
@@ -506,6 +573,8 @@ CxPlatSendDataFreeBuffer(
     _In_ QUIC_BUFFER* Buffer
     )
 {
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(Buffer);
     // No-op
 }
 
@@ -515,9 +584,37 @@ CxPlatSendDataIsFull(
     _In_ CXPLAT_SEND_DATA* SendData
     )
 {
+    UNREFERENCED_PARAMETER(SendData);
     return TRUE;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataSetTxTime(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint64_t TxTimeUs
+    )
+{
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(TxTimeUs);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchBegin(
+    void
+    )
+{
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchEnd(
+    void
+    )
+{
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatSocketSend(
@@ -527,6 +624,7 @@ CxPlatSocketSend(
     _In_ uint16_t IdealProcessor
     )
 {
+    UNREFERENCED_PARAMETER(IdealProcessor);
     QuicTraceEvent(
         DatapathSend,
         "[data][%p] Send %u bytes in %hhu buffers (segment=%hu) Dst=%!ADDR!, Src=%!ADDR!",
@@ -553,7 +651,7 @@ CxPlatSocketSetParam(
     _In_ CXPLAT_SOCKET* Socket,
     _In_ uint32_t Param,
     _In_ uint32_t BufferLength,
-    _In_reads_bytes_(BufferLength) const UINT8 * Buffer
+    _In_reads_bytes_(BufferLength) const uint8_t * Buffer
     )
 {
     UNREFERENCED_PARAMETER(Socket);
@@ -568,8 +666,8 @@ QUIC_STATUS
 CxPlatSocketGetParam(
     _In_ CXPLAT_SOCKET* Socket,
     _In_ uint32_t Param,
-    _Inout_ PUINT32 BufferLength,
-    _Out_writes_bytes_opt_(*BufferLength) UINT8 * Buffer
+    _Inout_ uint32_t* BufferLength,
+    _Out_writes_bytes_opt_(*BufferLength) uint8_t * Buffer
     )
 {
     UNREFERENCED_PARAMETER(Socket);
@@ -598,6 +696,7 @@ CXPLAT_THREAD_CALLBACK(CxPlatRouteResolutionWorkerThread, Context)
             CXPLAT_ROUTE_RESOLUTION_OPERATION* Operation =
                 CXPLAT_CONTAINING_RECORD(
                     CxPlatListRemoveHead(&Operations), CXPLAT_ROUTE_RESOLUTION_OPERATION, WorkerLink);
+#ifdef _WIN32
             NETIO_STATUS Status =
             Status = GetIpNetEntry2(&Operation->IpnetRow);
             if (Status != ERROR_SUCCESS || Operation->IpnetRow.State <= NlnsIncomplete) {
@@ -620,6 +719,22 @@ CXPLAT_THREAD_CALLBACK(CxPlatRouteResolutionWorkerThread, Context)
                 Operation->Callback(
                     Operation->Context, Operation->IpnetRow.PhysicalAddress, Operation->PathId, TRUE);
             }
+#else
+            QUIC_STATUS Status = CxPlatResolveNeighbor(&Operation->NeighborRow);
+            if (QUIC_FAILED(Status)) {
+                QuicTraceEvent(
+                    DatapathErrorStatus,
+                    "[data][%p] ERROR, %u, %s.",
+                    Operation,
+                    Status,
+                    "CxPlatResolveNeighbor");
+                Operation->Callback(
+                    Operation->Context, NULL, Operation->PathId, FALSE);
+            } else {
+                Operation->Callback(
+                    Operation->Context, Operation->NeighborRow.PhysicalAddress, Operation->PathId, TRUE);
+            }
+#endif
 
             CxPlatPoolFree(&Worker->OperationPool, Operation);
         }
@@ -41,13 +41,28 @@ typedef struct QUIC_CACHEALIGN CXPLAT_ROUTE_RESOLUTION_WORKER {
     CXPLAT_LIST_ENTRY Operations;
 } CXPLAT_ROUTE_RESOLUTION_WORKER;
 
+#ifndef _WIN32
+//
+// A neighbor (ARP/NDP) table entry on the given interface.
+//
+typedef struct CXPLAT_NEIGHBOR_ROW {
+    uint32_t IfIndex;
+    QUIC_ADDR Address;
+    uint8_t PhysicalAddress[6];
+} CXPLAT_NEIGHBOR_ROW;
+#endif
+
 typedef struct CXPLAT_ROUTE_RESOLUTION_OPERATION {
     //
     // Link in the worker's operation queue.
     // N.B. Multi-threaded access, synchronized by worker's operation lock.
     //
     CXPLAT_LIST_ENTRY WorkerLink;
+#ifdef _WIN32
     MIB_IPNET_ROW2 IpnetRow;
+#else
+    CXPLAT_NEIGHBOR_ROW NeighborRow;
+#endif
     void* Context;
     uint8_t PathId;
     CXPLAT_ROUTE_RESOLUTION_CALLBACK_HANDLER Callback;
@@ -76,7 +91,7 @@ typedef struct CXPLAT_DATAPATH {
 typedef struct CXPLAT_INTERFACE {
     CXPLAT_LIST_ENTRY Link;
     uint32_t IfIndex;
-    UCHAR PhysicalAddress[ETH_MAC_ADDR_LEN];
+    uint8_t PhysicalAddress[ETH_MAC_ADDR_LEN];
     struct {
         struct {
             BOOLEAN NetworkLayerXsum : 1;
@@ -252,7 +267,11 @@ typedef struct CXPLAT_SOCKET {
     CXPLAT_HASHTABLE_ENTRY Entry;
     CXPLAT_RUNDOWN_REF Rundown;
     CXPLAT_DATAPATH* Datapath;
+#ifdef _WIN32
     SOCKET AuxSocket;
+#else
+    int AuxSocket;
+#endif
     void* CallbackContext;
     QUIC_ADDR LocalAddress;
     QUIC_ADDR RemoteAddress;
@@ -282,7 +301,7 @@ CxPlatSockPoolUninitialize(
 // so it assumes that matches already.
 //
 inline
-BOOL
+BOOLEAN
 CxPlatSocketCompare(
     _In_ CXPLAT_SOCKET* Socket,
     _In_ const QUIC_ADDR* LocalAddress,
@@ -325,6 +344,19 @@ CxPlatRemoveSocket(
     _In_ CXPLAT_SOCKET* Socket
     );
 
+#ifndef _WIN32
+//
+// Looks up the link-layer address of a neighbor, soliciting it from the
+// network if it isn't already known. Blocks, so should only be called from the
+// route resolution worker.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatResolveNeighbor(
+    _Inout_ CXPLAT_NEIGHBOR_ROW* NeighborRow
+    );
+#endif
+
 //
 // Network framing helpers. Used for Ethernet, IP (v4 & v6) and UDP.
 //
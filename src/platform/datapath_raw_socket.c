@@ -15,6 +15,11 @@ Abstract:
 #endif
 
 #include <stdio.h>
+#ifndef _WIN32
+#include <net/if.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#endif
 
 #pragma warning(disable:4116) // unnamed type definition in parentheses
 #pragma warning(disable:4100) // unreferenced formal parameter
@@ -23,8 +28,21 @@ Abstract:
 #define SocketError() WSAGetLastError()
 #else
 #define SocketError() errno
+#define closesocket(s) close(s)
 #endif // _WIN32
 
+#ifndef _WIN32
+//
+// External definition of the C99 inline function (see inline.c).
+//
+BOOLEAN
+CxPlatSocketCompare(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress
+    );
+#endif
+
 //
 // Socket Pool Logic
 //
@@ -79,7 +97,7 @@ CxPlatGetSocket(
     CxPlatRwLockAcquireShared(&((CXPLAT_SOCKET_POOL*)Pool)->Lock);
     Entry = CxPlatHashtableLookup(&Pool->Sockets, LocalAddress->Ipv4.sin_port, &Context);
     while (Entry != NULL) {
-        CXPLAT_SOCKET* Temp = CONTAINING_RECORD(Entry, CXPLAT_SOCKET, Entry);
+        CXPLAT_SOCKET* Temp = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SOCKET, Entry);
         if (CxPlatSocketCompare(Temp, LocalAddress, RemoteAddress)) {
             if (CxPlatRundownAcquire(&Temp->Rundown)) {
                 Socket = Temp;
@@ -219,7 +237,7 @@ CxPlatTryAddSocket(
         }
     }
 
-    int AssignedLocalAddressLength = sizeof(Socket->LocalAddress);
+    socklen_t AssignedLocalAddressLength = sizeof(Socket->LocalAddress);
     Result =
         getsockname(
             Socket->AuxSocket,
@@ -242,7 +260,7 @@ CxPlatTryAddSocket(
     Success = TRUE;
     Entry = CxPlatHashtableLookup(&Pool->Sockets, Socket->LocalAddress.Ipv4.sin_port, &Context);
     while (Entry != NULL) {
-        CXPLAT_SOCKET* Temp = CONTAINING_RECORD(Entry, CXPLAT_SOCKET, Entry);
+        CXPLAT_SOCKET* Temp = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_SOCKET, Entry);
         if (CxPlatSocketCompare(Temp, &Socket->LocalAddress, &Socket->RemoteAddress)) {
             Success = FALSE;
             break;
@@ -286,9 +304,315 @@ CxPlatRemoveSocket(
     CxPlatRwLockReleaseExclusive(&Pool->Lock);
 }
 
+#ifndef _WIN32
+
+#define NETLINK_BUFFER_SIZE 4096
+
+typedef struct NETLINK_REQUEST {
+    struct nlmsghdr Header;
+    union {
+        struct rtmsg Route;
+        struct ndmsg Neighbor;
+    };
+    uint8_t Attributes[64];
+} NETLINK_REQUEST;
+
+static
+void
+CxPlatNetlinkAddAttribute(
+    _Inout_ NETLINK_REQUEST* Request,
+    _In_ uint16_t Type,
+    _In_reads_bytes_(Length) const void* Data,
+    _In_ uint16_t Length
+    )
+{
+    struct rtattr* Attribute =
+        (struct rtattr*)((uint8_t*)Request + NLMSG_ALIGN(Request->Header.nlmsg_len));
+    CXPLAT_DBG_ASSERT(
+        NLMSG_ALIGN(Request->Header.nlmsg_len) + RTA_SPACE(Length) <= sizeof(*Request));
+    Attribute->rta_type = Type;
+    Attribute->rta_len = (unsigned short)RTA_LENGTH(Length);
+    memcpy(RTA_DATA(Attribute), Data, Length);
+    Request->Header.nlmsg_len = NLMSG_ALIGN(Request->Header.nlmsg_len) + RTA_SPACE(Length);
+}
+
+static
+const void*
+CxPlatAddrGetIp(
+    _In_ const QUIC_ADDR* Address,
+    _Out_ uint16_t* Length
+    )
+{
+    if (QuicAddrGetFamily(Address) == QUIC_ADDRESS_FAMILY_INET) {
+        *Length = sizeof(Address->Ipv4.sin_addr);
+        return &Address->Ipv4.sin_addr;
+    }
+    *Length = sizeof(Address->Ipv6.sin6_addr);
+    return &Address->Ipv6.sin6_addr;
+}
+
+static
+void
+CxPlatAddrSetIp(
+    _Inout_ QUIC_ADDR* Address,
+    _In_ QUIC_ADDRESS_FAMILY Family,
+    _In_reads_bytes_(Length) const void* Data,
+    _In_ size_t Length
+    )
+{
+    QuicAddrSetFamily(Address, Family);
+    if (Family == QUIC_ADDRESS_FAMILY_INET) {
+        if (Length == sizeof(Address->Ipv4.sin_addr)) {
+            memcpy(&Address->Ipv4.sin_addr, Data, Length);
+        }
+    } else if (Length == sizeof(Address->Ipv6.sin6_addr)) {
+        memcpy(&Address->Ipv6.sin6_addr, Data, Length);
+    }
+}
+
+//
+// Sends a single rtnetlink request and receives its (single message) reply.
+//
+static
+QUIC_STATUS
+CxPlatNetlinkTransact(
+    _Inout_ NETLINK_REQUEST* Request,
+    _Out_writes_bytes_(NETLINK_BUFFER_SIZE) uint8_t* Response,
+    _Out_ struct nlmsghdr** Reply
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    struct sockaddr_nl Kernel = { .nl_family = AF_NETLINK };
+
+    int Fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (Fd == INVALID_SOCKET) {
+        Status = errno;
+        goto Exit;
+    }
+
+    Request->Header.nlmsg_flags = NLM_F_REQUEST;
+    Request->Header.nlmsg_seq = 1;
+    if (sendto(
+            Fd, Request, Request->Header.nlmsg_len, 0,
+            (struct sockaddr*)&Kernel, sizeof(Kernel)) < 0) {
+        Status = errno;
+        goto Exit;
+    }
+
+    ssize_t Length = recv(Fd, Response, NETLINK_BUFFER_SIZE, 0);
+    if (Length < 0) {
+        Status = errno;
+        goto Exit;
+    }
+
+    struct nlmsghdr* Header = (struct nlmsghdr*)Response;
+    if (!NLMSG_OK(Header, (uint32_t)Length)) {
+        Status = QUIC_STATUS_INVALID_STATE;
+        goto Exit;
+    }
+
+    if (Header->nlmsg_type == NLMSG_ERROR) {
+        const struct nlmsgerr* Error = (const struct nlmsgerr*)NLMSG_DATA(Header);
+        Status = Error->error == 0 ? QUIC_STATUS_INVALID_STATE : (QUIC_STATUS)-Error->error;
+        goto Exit;
+    }
+
+    *Reply = Header;
+
+Exit:
+
+    if (Fd != INVALID_SOCKET) {
+        close(Fd);
+    }
+
+    return Status;
+}
+
+//
+// Linux equivalent of GetBestRoute2: queries the kernel routing table for the
+// outgoing interface, next hop and preferred source address.
+//
+static
+QUIC_STATUS
+CxPlatGetBestRoute(
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _Out_ uint32_t* IfIndex,
+    _Out_ QUIC_ADDR* NextHop,
+    _Out_ QUIC_ADDR* BestSourceAddress
+    )
+{
+    QUIC_STATUS Status;
+    NETLINK_REQUEST Request = {0};
+    uint8_t Response[NETLINK_BUFFER_SIZE];
+    struct nlmsghdr* Reply = NULL;
+    const QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(RemoteAddress);
+    uint16_t AddressLength;
+    const void* Address;
+
+    *IfIndex = 0;
+    CxPlatZeroMemory(NextHop, sizeof(*NextHop));
+    CxPlatZeroMemory(BestSourceAddress, sizeof(*BestSourceAddress));
+    QuicAddrSetFamily(NextHop, Family);
+
+    Request.Header.nlmsg_len = NLMSG_LENGTH(sizeof(Request.Route));
+    Request.Header.nlmsg_type = RTM_GETROUTE;
+    Request.Route.rtm_family = (uint8_t)Family;
+
+    Address = CxPlatAddrGetIp(RemoteAddress, &AddressLength);
+    Request.Route.rtm_dst_len = (uint8_t)(AddressLength * 8);
+    CxPlatNetlinkAddAttribute(&Request, RTA_DST, Address, AddressLength);
+    if (!QuicAddrIsWildCard(LocalAddress) && QuicAddrGetFamily(LocalAddress) == Family) {
+        Address = CxPlatAddrGetIp(LocalAddress, &AddressLength);
+        Request.Route.rtm_src_len = (uint8_t)(AddressLength * 8);
+        CxPlatNetlinkAddAttribute(&Request, RTA_SRC, Address, AddressLength);
+    }
+
+    Status = CxPlatNetlinkTransact(&Request, Response, &Reply);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    if (Reply->nlmsg_type != RTM_NEWROUTE) {
+        return QUIC_STATUS_NOT_FOUND;
+    }
+
+    struct rtmsg* Route = (struct rtmsg*)NLMSG_DATA(Reply);
+    int AttributesLength = (int)RTM_PAYLOAD(Reply);
+    for (struct rtattr* Attribute = RTM_RTA(Route);
+         RTA_OK(Attribute, AttributesLength);
+         Attribute = RTA_NEXT(Attribute, AttributesLength)) {
+        switch (Attribute->rta_type) {
+        case RTA_OIF:
+            *IfIndex = *(uint32_t*)RTA_DATA(Attribute);
+            break;
+        case RTA_GATEWAY:
+            CxPlatAddrSetIp(NextHop, Family, RTA_DATA(Attribute), RTA_PAYLOAD(Attribute));
+            break;
+        case RTA_PREFSRC:
+            CxPlatAddrSetIp(
+                BestSourceAddress, Family, RTA_DATA(Attribute), RTA_PAYLOAD(Attribute));
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (*IfIndex == 0) {
+        return QUIC_STATUS_NOT_FOUND;
+    }
+
+    if (QuicAddrGetFamily(BestSourceAddress) != Family) {
+        *BestSourceAddress = *LocalAddress;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Linux equivalent of GetIpNetEntry2: looks up a usable neighbor table entry.
+//
+static
+QUIC_STATUS
+CxPlatGetNeighbor(
+    _Inout_ CXPLAT_NEIGHBOR_ROW* NeighborRow
+    )
+{
+    QUIC_STATUS Status;
+    NETLINK_REQUEST Request = {0};
+    uint8_t Response[NETLINK_BUFFER_SIZE];
+    struct nlmsghdr* Reply = NULL;
+    uint16_t AddressLength;
+    const void* Address = CxPlatAddrGetIp(&NeighborRow->Address, &AddressLength);
+    BOOLEAN Found = FALSE;
+
+    Request.Header.nlmsg_len = NLMSG_LENGTH(sizeof(Request.Neighbor));
+    Request.Header.nlmsg_type = RTM_GETNEIGH;
+    Request.Neighbor.ndm_family = (uint8_t)QuicAddrGetFamily(&NeighborRow->Address);
+    Request.Neighbor.ndm_ifindex = (int)NeighborRow->IfIndex;
+    CxPlatNetlinkAddAttribute(&Request, NDA_DST, Address, AddressLength);
+
+    Status = CxPlatNetlinkTransact(&Request, Response, &Reply);
+    if (QUIC_FAILED(Status)) {
+        return Status;
+    }
+
+    if (Reply->nlmsg_type != RTM_NEWNEIGH) {
+        return QUIC_STATUS_NOT_FOUND;
+    }
+
+    struct ndmsg* Neighbor = (struct ndmsg*)NLMSG_DATA(Reply);
+    if (!(Neighbor->ndm_state & (NUD_REACHABLE | NUD_STALE | NUD_DELAY | NUD_PROBE | NUD_PERMANENT))) {
+        return QUIC_STATUS_NOT_FOUND;
+    }
+
+    int AttributesLength = (int)NLMSG_PAYLOAD(Reply, sizeof(*Neighbor));
+    for (struct rtattr* Attribute = (struct rtattr*)((uint8_t*)Neighbor + NLMSG_ALIGN(sizeof(*Neighbor)));
+         RTA_OK(Attribute, AttributesLength);
+         Attribute = RTA_NEXT(Attribute, AttributesLength)) {
+        if (Attribute->rta_type == NDA_LLADDR &&
+            RTA_PAYLOAD(Attribute) == sizeof(NeighborRow->PhysicalAddress)) {
+            memcpy(
+                NeighborRow->PhysicalAddress, RTA_DATA(Attribute),
+                sizeof(NeighborRow->PhysicalAddress));
+            Found = TRUE;
+        }
+    }
+
+    return Found ? QUIC_STATUS_SUCCESS : QUIC_STATUS_NOT_FOUND;
+}
+
+#define NEIGHBOR_SOLICIT_TIMEOUT_MS 3000
+#define NEIGHBOR_SOLICIT_POLL_MS    10
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatResolveNeighbor(
+    _Inout_ CXPLAT_NEIGHBOR_ROW* NeighborRow
+    )
+{
+    QUIC_STATUS Status = CxPlatGetNeighbor(NeighborRow);
+    if (QUIC_SUCCEEDED(Status)) {
+        return Status;
+    }
+
+    //
+    // Linux has no API to explicitly start neighbor solicitation, so send an
+    // empty datagram (to the discard port) out the interface to make the kernel
+    // resolve the address, and then poll for the result.
+    //
+    QUIC_ADDR Target = NeighborRow->Address;
+    QuicAddrSetPort(&Target, 9);
+    int Fd = socket(QuicAddrGetFamily(&Target), SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (Fd == INVALID_SOCKET) {
+        return errno;
+    }
+    char IfName[IF_NAMESIZE];
+    if (if_indextoname(NeighborRow->IfIndex, IfName) != NULL) {
+        (void)setsockopt(Fd, SOL_SOCKET, SO_BINDTODEVICE, IfName, (socklen_t)strlen(IfName));
+    }
+    (void)sendto(
+        Fd, NULL, 0, MSG_DONTWAIT, (struct sockaddr*)&Target,
+        QuicAddrGetFamily(&Target) == QUIC_ADDRESS_FAMILY_INET ?
+            sizeof(Target.Ipv4) : sizeof(Target.Ipv6));
+    close(Fd);
+
+    for (uint32_t Waited = 0; Waited < NEIGHBOR_SOLICIT_TIMEOUT_MS; Waited += NEIGHBOR_SOLICIT_POLL_MS) {
+        CxPlatSleep(NEIGHBOR_SOLICIT_POLL_MS);
+        Status = CxPlatGetNeighbor(NeighborRow);
+        if (QUIC_SUCCEEDED(Status)) {
+            break;
+        }
+    }
+
+    return Status;
+}
+
+#endif // _WIN32
+
 void
 CxPlatResolveRouteComplete(
-    _In_ QUIC_CONNECTION* Connection,
+    _In_ void* Connection,
     _Inout_ CXPLAT_ROUTE* Route,
     _In_reads_bytes_(6) const uint8_t* PhysicalAddress,
     _In_ uint8_t PathId
@@ -372,7 +696,7 @@ CxPlatResolveRoute(
     //
     CXPLAT_LIST_ENTRY* Entry = Socket->Datapath->Interfaces.Flink;
     for (; Entry != &Socket->Datapath->Interfaces; Entry = Entry->Flink) {
-        CXPLAT_INTERFACE* Interface = CONTAINING_RECORD(Entry, CXPLAT_INTERFACE, Link);
+        CXPLAT_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_INTERFACE, Link);
         if (Interface->IfIndex == IpforwardRow.InterfaceIndex) {
             CxPlatDpRawAssignQueue(Interface, Route);
             break;
@@ -479,7 +803,138 @@ Done:
         return HRESULT_FROM_WIN32(Status);
     }
 #else // _WIN32
-    return QUIC_STATUS_NOT_SUPPORTED;
+    QUIC_STATUS Status;
+    CXPLAT_ROUTE_STATE State = Route->State;
+    QUIC_ADDR LocalAddress = {0};
+    QUIC_ADDR NextHop = {0};
+    uint32_t IfIndex = 0;
+    CXPLAT_INTERFACE* Interface = NULL;
+
+    CXPLAT_DBG_ASSERT(!QuicAddrIsWildCard(&Route->RemoteAddress));
+
+    //
+    // Find the best next hop IP address.
+    //
+    Status =
+        CxPlatGetBestRoute(
+            &Route->LocalAddress,
+            &Route->RemoteAddress,
+            &IfIndex,
+            &NextHop,
+            &LocalAddress);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "CxPlatGetBestRoute");
+        goto Done;
+    }
+
+    if (State == RouteSuspected && !QuicAddrCompareIp(&LocalAddress, &Route->LocalAddress)) {
+        //
+        // We can't handle local address change here easily due to lack of full migration support.
+        //
+        Status = QUIC_STATUS_INVALID_STATE;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "CxPlatGetBestRoute returned different local address for the suspected route");
+        goto Done;
+    } else {
+        LocalAddress.Ipv4.sin_port = Route->LocalAddress.Ipv4.sin_port; // Preserve local port.
+        Route->LocalAddress = LocalAddress;
+    }
+
+    //
+    // Find the interface that matches the route we just looked up.
+    //
+    CXPLAT_LIST_ENTRY* Entry = Socket->Datapath->Interfaces.Flink;
+    for (; Entry != &Socket->Datapath->Interfaces; Entry = Entry->Flink) {
+        CXPLAT_INTERFACE* Temp = CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_INTERFACE, Link);
+        if (Temp->IfIndex == IfIndex) {
+            Interface = Temp;
+            CxPlatDpRawAssignQueue(Interface, Route);
+            break;
+        }
+    }
+
+    if (Interface == NULL || Route->Queue == NULL) {
+        Status = QUIC_STATUS_NOT_FOUND;
+        QuicTraceEvent(
+            DatapathError,
+            "[data][%p] ERROR, %s.",
+            Socket,
+            "no matching interface/queue");
+        goto Done;
+    }
+
+    CxPlatCopyMemory(
+        &Route->LocalLinkLayerAddress, Interface->PhysicalAddress,
+        sizeof(Route->LocalLinkLayerAddress));
+
+    //
+    // Map the next hop IP address to a link-layer address.
+    //
+    CXPLAT_NEIGHBOR_ROW NeighborRow = {0};
+    NeighborRow.IfIndex = IfIndex;
+    if (QuicAddrIsWildCard(&NextHop)) { // On-link?
+        NeighborRow.Address = Route->RemoteAddress;
+    } else {
+        NeighborRow.Address = NextHop;
+    }
+
+    Status = CxPlatGetNeighbor(&NeighborRow);
+    QuicTraceLogConnInfo(
+        RouteResolutionStart,
+        Context,
+        "Starting to look up neighbor on Path[%hhu] with status %u",
+        PathId,
+        Status);
+    //
+    // See the Windows implementation above for when neighbor solicitation is
+    // forced. It is queued on the route worker because it blocks.
+    //
+    if (QUIC_FAILED(Status) ||
+        (State == RouteSuspected &&
+         memcmp(
+             Route->NextHopLinkLayerAddress,
+             NeighborRow.PhysicalAddress,
+             sizeof(Route->NextHopLinkLayerAddress)) == 0)) {
+        CXPLAT_ROUTE_RESOLUTION_WORKER* Worker = Socket->Datapath->RouteResolutionWorker;
+        CXPLAT_ROUTE_RESOLUTION_OPERATION* Operation = CxPlatPoolAlloc(&Worker->OperationPool);
+        if (Operation == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "CXPLAT_DATAPATH",
+                sizeof(CXPLAT_ROUTE_RESOLUTION_OPERATION));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Done;
+        }
+        Operation->NeighborRow = NeighborRow;
+        Operation->Context = Context;
+        Operation->Callback = Callback;
+        Operation->PathId = PathId;
+        Route->State = RouteResolving;
+        CxPlatDispatchLockAcquire(&Worker->Lock);
+        CxPlatListInsertTail(&Worker->Operations, &Operation->WorkerLink);
+        CxPlatDispatchLockRelease(&Worker->Lock);
+        CxPlatEventSet(Worker->Ready);
+        Status = QUIC_STATUS_PENDING;
+    } else {
+        CxPlatResolveRouteComplete(Context, Route, NeighborRow.PhysicalAddress, PathId);
+    }
+
+Done:
+    if (QUIC_FAILED(Status)) {
+        Callback(Context, NULL, PathId, FALSE);
+    }
+
+    return Status;
 #endif // _WIN32
 }
 
@@ -0,0 +1,1392 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Linux AF_XDP Datapath Implementation (User Mode)
+
+    Each RSS queue of every Ethernet interface gets an AF_XDP socket with its
+    own UMEM, split into RX and TX frames. A small BPF program, attached to the
+    interface, redirects UDP packets destined to ports that have a raw socket
+    bound to the AF_XDP socket for the receiving queue. Everything else is
+    passed up to the kernel networking stack.
+
+    The kernel ABI is used directly (no libbpf/libxdp dependency).
+
+--*/
+
+#include "datapath_raw.h"
+#ifdef QUIC_CLOG
+#include "datapath_raw_xdp_linux.c.clog.h"
+#endif
+
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <netpacket/packet.h>
+#include <stdio.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/bpf.h>
+#include <linux/ethtool.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <linux/sockios.h>
+
+#ifndef AF_XDP
+#define AF_XDP 44
+#endif
+#ifndef SOL_XDP
+#define SOL_XDP 283
+#endif
+
+#define RX_BATCH_SIZE 16
+#define MAX_ETH_FRAME_SIZE 1514
+#define MAX_PORT_RULES 4096
+
+//
+// The kernel places received frames XDP_PACKET_HEADROOM bytes past the UMEM
+// headroom of each chunk. Chunks must be a power of two, between 2KB and a page.
+//
+#define XSK_PACKET_HEADROOM 256
+#define XSK_MIN_CHUNK_SIZE 2048
+#define XSK_MAX_CHUNK_SIZE 4096
+
+typedef struct XDP_INTERFACE XDP_INTERFACE;
+
+typedef struct XSK_RING {
+    uint32_t* Producer;
+    uint32_t* Consumer;
+    uint32_t* Flags;
+    uint8_t* Descriptors;
+    uint32_t Mask;
+    uint32_t ElementSize;
+    void* Mapping;
+    size_t MappingSize;
+} XSK_RING;
+
+typedef struct XDP_QUEUE {
+    const XDP_INTERFACE* Interface;
+    uint32_t QueueId;
+    int Xsk;
+    uint8_t* Umem;
+    size_t UmemSize;
+    uint8_t* TxBuffers;
+    XSK_RING RxFillRing;
+    XSK_RING RxRing;
+    XSK_RING TxRing;
+    XSK_RING TxCompletionRing;
+
+    CXPLAT_LIST_ENTRY WorkerTxQueue;
+    CXPLAT_SLIST_ENTRY WorkerRxPool;
+
+    CXPLAT_LOCK RxPoolLock;
+    CXPLAT_SLIST_ENTRY RxPool;
+
+    CXPLAT_LOCK TxPoolLock;
+    CXPLAT_SLIST_ENTRY TxPool;
+
+    CXPLAT_LOCK TxLock;
+    CXPLAT_LIST_ENTRY TxQueue;
+} XDP_QUEUE;
+
+typedef struct XDP_INTERFACE {
+    CXPLAT_INTERFACE;
+    uint8_t QueueCount;
+    char IfName[IF_NAMESIZE];
+    CXPLAT_LOCK RuleLock;
+    int XskMap;     // BPF_MAP_TYPE_XSKMAP: RX queue ID -> AF_XDP socket.
+    int PortMap;    // BPF_MAP_TYPE_HASH: UDP port -> number of raw sockets.
+    int Program;
+    int ProgramLink;
+    XDP_QUEUE* Queues;
+} XDP_INTERFACE;
+
+typedef struct XDP_DATAPATH {
+    CXPLAT_DATAPATH;
+
+    BOOLEAN Running;
+    CXPLAT_EVENT CompletionEvent;
+
+    //
+    // Currently, all XDP interfaces share the same config.
+    //
+    uint32_t RxBufferCount;
+    uint32_t RxRingSize;
+    uint32_t TxBufferCount;
+    uint32_t TxRingSize;
+    uint32_t ChunkSize;
+    BOOLEAN TxAlwaysPoke;
+    BOOLEAN SkipXsum;
+    BOOLEAN ForceGeneric;
+    char InterfaceName[IF_NAMESIZE];
+} XDP_DATAPATH;
+
+typedef struct XDP_RX_PACKET {
+    CXPLAT_RECV_DATA;
+    CXPLAT_ROUTE RouteStorage;
+    XDP_QUEUE* Queue;
+    // Followed by:
+    // uint8_t ClientContext[...];
+    // uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE];
+} XDP_RX_PACKET;
+
+typedef struct XDP_TX_PACKET {
+    CXPLAT_SEND_DATA;
+    XDP_QUEUE* Queue;
+    CXPLAT_LIST_ENTRY Link;
+    uint8_t FrameBuffer[MAX_ETH_FRAME_SIZE];
+} XDP_TX_PACKET;
+
+CXPLAT_STATIC_ASSERT(
+    sizeof(XDP_TX_PACKET) <= XSK_MIN_CHUNK_SIZE,
+    "TX packets must fit in the smallest UMEM chunk");
+
+CXPLAT_RECV_DATA*
+CxPlatDataPathRecvPacketToRecvData(
+    _In_ const CXPLAT_RECV_PACKET* const Context
+    )
+{
+    return (CXPLAT_RECV_DATA*)(((uint8_t*)Context) - sizeof(XDP_RX_PACKET));
+}
+
+CXPLAT_RECV_PACKET*
+CxPlatDataPathRecvDataToRecvPacket(
+    _In_ const CXPLAT_RECV_DATA* const Datagram
+    )
+{
+    return (CXPLAT_RECV_PACKET*)(((uint8_t*)Datagram) + sizeof(XDP_RX_PACKET));
+}
+
+//
+// AF_XDP ring helpers. Each ring has a single producer and a single consumer;
+// one side is always the kernel.
+//
+
+static
+uint32_t
+XskRingProducerReserve(
+    _In_ XSK_RING* Ring,
+    _In_ uint32_t MaxCount,
+    _Out_ uint32_t* Index
+    )
+{
+    const uint32_t Consumer = __atomic_load_n(Ring->Consumer, __ATOMIC_ACQUIRE);
+    const uint32_t Producer = *Ring->Producer;
+    const uint32_t Available = (Ring->Mask + 1) - (Producer - Consumer);
+    *Index = Producer;
+    return CXPLAT_MIN(Available, MaxCount);
+}
+
+static
+void
+XskRingProducerSubmit(
+    _In_ XSK_RING* Ring,
+    _In_ uint32_t Count
+    )
+{
+    __atomic_store_n(Ring->Producer, *Ring->Producer + Count, __ATOMIC_RELEASE);
+}
+
+static
+BOOLEAN
+XskRingProducerNeedPoke(
+    _In_ const XSK_RING* Ring
+    )
+{
+    return !!(__atomic_load_n(Ring->Flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP);
+}
+
+static
+uint32_t
+XskRingConsumerReserve(
+    _In_ XSK_RING* Ring,
+    _In_ uint32_t MaxCount,
+    _Out_ uint32_t* Index
+    )
+{
+    const uint32_t Producer = __atomic_load_n(Ring->Producer, __ATOMIC_ACQUIRE);
+    const uint32_t Consumer = *Ring->Consumer;
+    *Index = Consumer;
+    return CXPLAT_MIN(Producer - Consumer, MaxCount);
+}
+
+static
+void
+XskRingConsumerRelease(
+    _In_ XSK_RING* Ring,
+    _In_ uint32_t Count
+    )
+{
+    __atomic_store_n(Ring->Consumer, *Ring->Consumer + Count, __ATOMIC_RELEASE);
+}
+
+static
+void*
+XskRingGetElement(
+    _In_ XSK_RING* Ring,
+    _In_ uint32_t Index
+    )
+{
+    return Ring->Descriptors + (size_t)(Index & Ring->Mask) * Ring->ElementSize;
+}
+
+static
+QUIC_STATUS
+XskRingInitialize(
+    _In_ int Xsk,
+    _In_ const struct xdp_ring_offset* Offsets,
+    _In_ uint64_t PageOffset,
+    _In_ uint32_t Size,
+    _In_ uint32_t ElementSize,
+    _Out_ XSK_RING* Ring
+    )
+{
+    Ring->MappingSize = Offsets->desc + (size_t)Size * ElementSize;
+    Ring->Mapping =
+        mmap(
+            NULL, Ring->MappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            Xsk, (off_t)PageOffset);
+    if (Ring->Mapping == MAP_FAILED) {
+        Ring->Mapping = NULL;
+        return errno;
+    }
+
+    Ring->Producer = (uint32_t*)((uint8_t*)Ring->Mapping + Offsets->producer);
+    Ring->Consumer = (uint32_t*)((uint8_t*)Ring->Mapping + Offsets->consumer);
+    Ring->Flags = (uint32_t*)((uint8_t*)Ring->Mapping + Offsets->flags);
+    Ring->Descriptors = (uint8_t*)Ring->Mapping + Offsets->desc;
+    Ring->Mask = Size - 1;
+    Ring->ElementSize = ElementSize;
+    return QUIC_STATUS_SUCCESS;
+}
+
+static
+void
+XskRingUninitialize(
+    _Inout_ XSK_RING* Ring
+    )
+{
+    if (Ring->Mapping != NULL) {
+        munmap(Ring->Mapping, Ring->MappingSize);
+        Ring->Mapping = NULL;
+    }
+}
+
+//
+// BPF helpers.
+//
+
+static
+int
+CxPlatBpf(
+    _In_ int Command,
+    _Inout_ union bpf_attr* Attr
+    )
+{
+    return (int)syscall(__NR_bpf, Command, Attr, sizeof(*Attr));
+}
+
+static
+int
+CxPlatBpfMapCreate(
+    _In_ uint32_t Type,
+    _In_ uint32_t KeySize,
+    _In_ uint32_t ValueSize,
+    _In_ uint32_t MaxEntries
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_type = Type;
+    Attr.key_size = KeySize;
+    Attr.value_size = ValueSize;
+    Attr.max_entries = MaxEntries;
+    return CxPlatBpf(BPF_MAP_CREATE, &Attr);
+}
+
+static
+int
+CxPlatBpfMapElem(
+    _In_ int Command,
+    _In_ int Map,
+    _In_ const void* Key,
+    _Inout_opt_ void* Value,
+    _In_ uint64_t Flags
+    )
+{
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.map_fd = (uint32_t)Map;
+    Attr.key = (uint64_t)(uintptr_t)Key;
+    Attr.value = (uint64_t)(uintptr_t)Value;
+    Attr.flags = Flags;
+    return CxPlatBpf(Command, &Attr);
+}
+
+#define BPF_INSN(CODE, DST, SRC, OFF, IMM) \
+    { .code = (CODE), .dst_reg = (DST), .src_reg = (SRC), .off = (OFF), .imm = (IMM) }
+#define BPF_MOV64_REG(DST, SRC) BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_X, DST, SRC, 0, 0)
+#define BPF_MOV64_IMM(DST, IMM) BPF_INSN(BPF_ALU64 | BPF_MOV | BPF_K, DST, 0, 0, IMM)
+#define BPF_ADD64_IMM(DST, IMM) BPF_INSN(BPF_ALU64 | BPF_ADD | BPF_K, DST, 0, 0, IMM)
+#define BPF_LDX_MEM(SIZE, DST, SRC, OFF) BPF_INSN(BPF_LDX | BPF_MEM | (SIZE), DST, SRC, OFF, 0)
+#define BPF_STX_MEM(SIZE, DST, SRC, OFF) BPF_INSN(BPF_STX | BPF_MEM | (SIZE), DST, SRC, OFF, 0)
+#define BPF_JMP_REG(OP, DST, SRC, OFF) BPF_INSN(BPF_JMP | (OP) | BPF_X, DST, SRC, OFF, 0)
+#define BPF_JMP_IMM(OP, DST, IMM, OFF) BPF_INSN(BPF_JMP | (OP) | BPF_K, DST, 0, OFF, IMM)
+#define BPF_LD_MAP_FD(DST, FD) \
+    BPF_INSN(BPF_LD | BPF_DW | BPF_IMM, DST, BPF_PSEUDO_MAP_FD, 0, FD), BPF_INSN(0, 0, 0, 0, 0)
+#define BPF_CALL_FUNC(FUNC) BPF_INSN(BPF_JMP | BPF_CALL, 0, 0, 0, FUNC)
+#define BPF_EXIT_INSN() BPF_INSN(BPF_JMP | BPF_EXIT, 0, 0, 0, 0)
+
+//
+// Instruction indexes of the jump targets in the program below. Jump offsets
+// are relative to the instruction following the jump.
+//
+#define XDP_PROG_IPV4   16
+#define XDP_PROG_LOOKUP 24
+#define XDP_PROG_PASS   37
+
+//
+// Loads the program that redirects UDP packets whose destination port is in the
+// interface's port map to the AF_XDP socket of the receiving queue. Only
+// untagged frames and IPv4 headers without options are matched; everything
+// else is passed to the kernel.
+//
+static
+int
+CxPlatXdpLoadProgram(
+    _In_ const XDP_INTERFACE* Interface
+    )
+{
+    const struct bpf_insn Program[] = {
+        /*  0 */ BPF_MOV64_REG(BPF_REG_6, BPF_REG_1),
+        /*  1 */ BPF_LDX_MEM(BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, data)),
+        /*  2 */ BPF_LDX_MEM(BPF_W, BPF_REG_3, BPF_REG_6, offsetof(struct xdp_md, data_end)),
+        /*  3 */ BPF_MOV64_REG(BPF_REG_4, BPF_REG_2),
+        /*  4 */ BPF_ADD64_IMM(BPF_REG_4, 14),
+        /*  5 */ BPF_JMP_REG(BPF_JGT, BPF_REG_4, BPF_REG_3, XDP_PROG_PASS - 6),
+        /*  6 */ BPF_LDX_MEM(BPF_H, BPF_REG_5, BPF_REG_2, 12),
+        /*  7 */ BPF_JMP_IMM(BPF_JEQ, BPF_REG_5, htons(0x0800), XDP_PROG_IPV4 - 8),
+        /*  8 */ BPF_JMP_IMM(BPF_JNE, BPF_REG_5, htons(0x86DD), XDP_PROG_PASS - 9),
+        // IPv6
+        /*  9 */ BPF_MOV64_REG(BPF_REG_4, BPF_REG_2),
+        /* 10 */ BPF_ADD64_IMM(BPF_REG_4, 14 + 40 + 8),
+        /* 11 */ BPF_JMP_REG(BPF_JGT, BPF_REG_4, BPF_REG_3, XDP_PROG_PASS - 12),
+        /* 12 */ BPF_LDX_MEM(BPF_B, BPF_REG_5, BPF_REG_2, 14 + 6),
+        /* 13 */ BPF_JMP_IMM(BPF_JNE, BPF_REG_5, IPPROTO_UDP, XDP_PROG_PASS - 14),
+        /* 14 */ BPF_LDX_MEM(BPF_H, BPF_REG_5, BPF_REG_2, 14 + 40 + 2),
+        /* 15 */ BPF_INSN(BPF_JMP | BPF_JA, 0, 0, XDP_PROG_LOOKUP - 16, 0),
+        // IPv4
+        /* 16 */ BPF_MOV64_REG(BPF_REG_4, BPF_REG_2),
+        /* 17 */ BPF_ADD64_IMM(BPF_REG_4, 14 + 20 + 8),
+        /* 18 */ BPF_JMP_REG(BPF_JGT, BPF_REG_4, BPF_REG_3, XDP_PROG_PASS - 19),
+        /* 19 */ BPF_LDX_MEM(BPF_B, BPF_REG_5, BPF_REG_2, 14),
+        /* 20 */ BPF_JMP_IMM(BPF_JNE, BPF_REG_5, 0x45, XDP_PROG_PASS - 21),
+        /* 21 */ BPF_LDX_MEM(BPF_B, BPF_REG_5, BPF_REG_2, 14 + 9),
+        /* 22 */ BPF_JMP_IMM(BPF_JNE, BPF_REG_5, IPPROTO_UDP, XDP_PROG_PASS - 23),
+        /* 23 */ BPF_LDX_MEM(BPF_H, BPF_REG_5, BPF_REG_2, 14 + 20 + 2),
+        // Look up the destination port.
+        /* 24 */ BPF_STX_MEM(BPF_H, BPF_REG_10, BPF_REG_5, -2),
+        /* 25 */ BPF_MOV64_REG(BPF_REG_2, BPF_REG_10),
+        /* 26 */ BPF_ADD64_IMM(BPF_REG_2, -2),
+        /* 27 */ BPF_LD_MAP_FD(BPF_REG_1, Interface->PortMap),
+        /* 29 */ BPF_CALL_FUNC(BPF_FUNC_map_lookup_elem),
+        /* 30 */ BPF_JMP_IMM(BPF_JEQ, BPF_REG_0, 0, XDP_PROG_PASS - 31),
+        /* 31 */ BPF_LDX_MEM(BPF_W, BPF_REG_2, BPF_REG_6, offsetof(struct xdp_md, rx_queue_index)),
+        /* 32 */ BPF_LD_MAP_FD(BPF_REG_1, Interface->XskMap),
+        /* 34 */ BPF_MOV64_IMM(BPF_REG_3, XDP_PASS), // Action if the queue has no socket.
+        /* 35 */ BPF_CALL_FUNC(BPF_FUNC_redirect_map),
+        /* 36 */ BPF_EXIT_INSN(),
+        // Pass
+        /* 37 */ BPF_MOV64_IMM(BPF_REG_0, XDP_PASS),
+        /* 38 */ BPF_EXIT_INSN(),
+    };
+    CXPLAT_STATIC_ASSERT(ARRAYSIZE(Program) == XDP_PROG_PASS + 2, "Jump targets out of date");
+
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.prog_type = BPF_PROG_TYPE_XDP;
+    Attr.insns = (uint64_t)(uintptr_t)Program;
+    Attr.insn_cnt = ARRAYSIZE(Program);
+    Attr.license = (uint64_t)(uintptr_t)"Dual MIT/GPL";
+    return CxPlatBpf(BPF_PROG_LOAD, &Attr);
+}
+
+static
+QUIC_STATUS
+CxPlatGetInterfaceRssQueueCount(
+    _In_z_ const char* IfName,
+    _Out_ uint8_t* Count
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    struct ethtool_channels Channels = { .cmd = ETHTOOL_GCHANNELS };
+    struct ifreq Request;
+    CxPlatZeroMemory(&Request, sizeof(Request));
+    memcpy(Request.ifr_name, IfName, sizeof(Request.ifr_name));
+    Request.ifr_data = (char*)&Channels;
+
+    *Count = 1;
+
+    int Fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (Fd == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "socket");
+        return Status;
+    }
+
+    if (ioctl(Fd, SIOCETHTOOL, &Request) == 0) {
+        uint32_t Queues = CXPLAT_MAX(Channels.combined_count, Channels.rx_count);
+        if (Queues > UINT8_MAX) {
+            Queues = UINT8_MAX;
+        }
+        if (Queues > 0) {
+            *Count = (uint8_t)Queues;
+        }
+    }
+    //
+    // Otherwise, the driver doesn't expose channels. Assume a single queue.
+    //
+
+    close(Fd);
+    return Status;
+}
+
+static
+BOOLEAN
+CxPlatIsPowerOfTwo(
+    _In_ uint32_t Value
+    )
+{
+    return Value != 0 && (Value & (Value - 1)) == 0;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatXdpReadConfig(
+    _Inout_ XDP_DATAPATH* Xdp
+    )
+{
+    // Default config
+    Xdp->RxBufferCount = 4096;
+    Xdp->RxRingSize = 128;
+    Xdp->TxBufferCount = 4096;
+    Xdp->TxRingSize = 128;
+    Xdp->TxAlwaysPoke = FALSE;
+    Xdp->ForceGeneric = FALSE;
+    Xdp->Cpu = (uint16_t)(CxPlatProcMaxCount() - 1);
+
+    FILE *File = fopen("xdp.ini", "r");
+    if (File == NULL) {
+        return;
+    }
+
+    char Line[256];
+    while (fgets(Line, sizeof(Line), File) != NULL) {
+        char* Value = strchr(Line, '=');
+        if (Value == NULL) {
+            continue;
+        }
+        *Value++ = '\0';
+        if (Value[strlen(Value) - 1] == '\n') {
+            Value[strlen(Value) - 1] = '\0';
+        }
+
+        if (strcmp(Line, "CpuNumber") == 0) {
+             Xdp->Cpu = (uint16_t)strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "RxBufferCount") == 0) {
+             Xdp->RxBufferCount = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "RxRingSize") == 0) {
+             Xdp->RxRingSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "TxBufferCount") == 0) {
+             Xdp->TxBufferCount = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "TxRingSize") == 0) {
+             Xdp->TxRingSize = strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "TxAlwaysPoke") == 0) {
+             Xdp->TxAlwaysPoke = !!strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "SkipXsum") == 0) {
+            BOOLEAN State = !!strtoul(Value, NULL, 10);
+            Xdp->SkipXsum = State;
+            printf("SkipXsum: %u\n", State);
+        } else if (strcmp(Line, "ForceGeneric") == 0) {
+            Xdp->ForceGeneric = !!strtoul(Value, NULL, 10);
+        } else if (strcmp(Line, "Interface") == 0) {
+            strncpy(Xdp->InterfaceName, Value, sizeof(Xdp->InterfaceName) - 1);
+        }
+    }
+
+    fclose(File);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+size_t
+CxPlatDpRawGetDapathSize(
+    void
+    )
+{
+    return sizeof(XDP_DATAPATH);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawInterfaceUninitialize(
+    _Inout_ XDP_INTERFACE* Interface
+    )
+{
+    //
+    // Closing the link detaches the program from the interface.
+    //
+    if (Interface->ProgramLink >= 0) {
+        close(Interface->ProgramLink);
+    }
+    if (Interface->Program >= 0) {
+        close(Interface->Program);
+    }
+
+    for (uint32_t i = 0; Interface->Queues != NULL && i < Interface->QueueCount; i++) {
+        XDP_QUEUE *Queue = &Interface->Queues[i];
+
+        if (Queue->Xsk >= 0) {
+#if DEBUG
+            struct xdp_statistics Stats;
+            socklen_t StatsSize = sizeof(Stats);
+            if (getsockopt(Queue->Xsk, SOL_XDP, XDP_STATISTICS, &Stats, &StatsSize) == 0) {
+                printf("[%u-%u]rxDropped: %llu\n", Interface->IfIndex, i, (unsigned long long)Stats.rx_dropped);
+                printf("[%u-%u]rxInvalidDescriptors: %llu\n", Interface->IfIndex, i, (unsigned long long)Stats.rx_invalid_descs);
+                printf("[%u-%u]txInvalidDescriptors: %llu\n", Interface->IfIndex, i, (unsigned long long)Stats.tx_invalid_descs);
+            }
+#endif
+            XskRingUninitialize(&Queue->TxCompletionRing);
+            XskRingUninitialize(&Queue->TxRing);
+            XskRingUninitialize(&Queue->RxRing);
+            XskRingUninitialize(&Queue->RxFillRing);
+            close(Queue->Xsk);
+        }
+
+        if (Queue->Umem != NULL) {
+            munmap(Queue->Umem, Queue->UmemSize);
+        }
+
+        CxPlatLockUninitialize(&Queue->TxLock);
+        CxPlatLockUninitialize(&Queue->TxPoolLock);
+        CxPlatLockUninitialize(&Queue->RxPoolLock);
+    }
+
+    if (Interface->Queues != NULL) {
+        CXPLAT_FREE(Interface->Queues, QUIC_POOL_DATAPATH);
+    }
+
+    if (Interface->PortMap >= 0) {
+        close(Interface->PortMap);
+    }
+    if (Interface->XskMap >= 0) {
+        close(Interface->XskMap);
+    }
+
+    CxPlatLockUninitialize(&Interface->RuleLock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawQueueInitialize(
+    _In_ XDP_DATAPATH* Xdp,
+    _In_ XDP_INTERFACE* Interface,
+    _In_ uint32_t RxHeadroom,
+    _Inout_ XDP_QUEUE* Queue
+    )
+{
+    QUIC_STATUS Status;
+    const uint32_t BufferCount = Xdp->RxBufferCount + Xdp->TxBufferCount;
+
+    Queue->UmemSize = (size_t)BufferCount * Xdp->ChunkSize;
+    Queue->Umem =
+        mmap(
+            NULL, Queue->UmemSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Queue->Umem == MAP_FAILED) {
+        Queue->Umem = NULL;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP UMEM",
+            Queue->UmemSize);
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+    Queue->TxBuffers = Queue->Umem + (size_t)Xdp->RxBufferCount * Xdp->ChunkSize;
+
+    Queue->Xsk = socket(AF_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+    if (Queue->Xsk == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "socket(AF_XDP)");
+        goto Error;
+    }
+
+    struct xdp_umem_reg Umem = {0};
+    Umem.addr = (uint64_t)(uintptr_t)Queue->Umem;
+    Umem.len = Queue->UmemSize;
+    Umem.chunk_size = Xdp->ChunkSize;
+    Umem.headroom = RxHeadroom;
+
+    if (setsockopt(Queue->Xsk, SOL_XDP, XDP_UMEM_REG, &Umem, sizeof(Umem)) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "setsockopt(XDP_UMEM_REG)");
+        goto Error;
+    }
+
+    if (setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_UMEM_FILL_RING, &Xdp->RxRingSize,
+            sizeof(Xdp->RxRingSize)) != 0 ||
+        setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_RX_RING, &Xdp->RxRingSize,
+            sizeof(Xdp->RxRingSize)) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "setsockopt(XDP_RX_RING)");
+        goto Error;
+    }
+
+    if (setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_UMEM_COMPLETION_RING, &Xdp->TxRingSize,
+            sizeof(Xdp->TxRingSize)) != 0 ||
+        setsockopt(
+            Queue->Xsk, SOL_XDP, XDP_TX_RING, &Xdp->TxRingSize,
+            sizeof(Xdp->TxRingSize)) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "setsockopt(XDP_TX_RING)");
+        goto Error;
+    }
+
+    struct xdp_mmap_offsets Offsets;
+    socklen_t OffsetsSize = sizeof(Offsets);
+    if (getsockopt(Queue->Xsk, SOL_XDP, XDP_MMAP_OFFSETS, &Offsets, &OffsetsSize) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "getsockopt(XDP_MMAP_OFFSETS)");
+        goto Error;
+    }
+
+    if (QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Xsk, &Offsets.fr, XDP_UMEM_PGOFF_FILL_RING, Xdp->RxRingSize,
+                sizeof(uint64_t), &Queue->RxFillRing)) ||
+        QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Xsk, &Offsets.rx, XDP_PGOFF_RX_RING, Xdp->RxRingSize,
+                sizeof(struct xdp_desc), &Queue->RxRing)) ||
+        QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Xsk, &Offsets.cr, XDP_UMEM_PGOFF_COMPLETION_RING, Xdp->TxRingSize,
+                sizeof(uint64_t), &Queue->TxCompletionRing)) ||
+        QUIC_FAILED(Status =
+            XskRingInitialize(
+                Queue->Xsk, &Offsets.tx, XDP_PGOFF_TX_RING, Xdp->TxRingSize,
+                sizeof(struct xdp_desc), &Queue->TxRing))) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(XSK ring)");
+        goto Error;
+    }
+
+    struct sockaddr_xdp Address = {0};
+    Address.sxdp_family = AF_XDP;
+    Address.sxdp_flags = XDP_USE_NEED_WAKEUP;
+    if (Xdp->ForceGeneric) {
+        Address.sxdp_flags |= XDP_COPY;
+    }
+    Address.sxdp_ifindex = Interface->IfIndex;
+    Address.sxdp_queue_id = Queue->QueueId;
+    if (bind(Queue->Xsk, (struct sockaddr*)&Address, sizeof(Address)) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "bind(AF_XDP)");
+        goto Error;
+    }
+
+    int Xsk = Queue->Xsk;
+    if (CxPlatBpfMapElem(
+            BPF_MAP_UPDATE_ELEM, Interface->XskMap, &Queue->QueueId, &Xsk, BPF_ANY) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_MAP_UPDATE_ELEM(XSKMAP)");
+        goto Error;
+    }
+
+    for (uint32_t j = 0; j < Xdp->RxBufferCount; j++) {
+        CxPlatListPushEntry(
+            &Queue->RxPool, (CXPLAT_SLIST_ENTRY*)&Queue->Umem[(size_t)j * Xdp->ChunkSize]);
+    }
+
+    for (uint32_t j = 0; j < Xdp->TxBufferCount; j++) {
+        CxPlatListPushEntry(
+            &Queue->TxPool, (CXPLAT_SLIST_ENTRY*)&Queue->TxBuffers[(size_t)j * Xdp->ChunkSize]);
+    }
+
+    Status = QUIC_STATUS_SUCCESS;
+
+Error:
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInterfaceInitialize(
+    _In_ XDP_DATAPATH* Xdp,
+    _Inout_ XDP_INTERFACE* Interface,
+    _In_ uint32_t ClientRecvContextLength
+    )
+{
+    const uint32_t RxHeadroom = sizeof(XDP_RX_PACKET) + ALIGN_UP(ClientRecvContextLength, uint32_t);
+    QUIC_STATUS Status;
+
+    CxPlatLockInitialize(&Interface->RuleLock);
+    Interface->XskMap = -1;
+    Interface->PortMap = -1;
+    Interface->Program = -1;
+    Interface->ProgramLink = -1;
+    Interface->OffloadStatus.Receive.NetworkLayerXsum = Xdp->SkipXsum;
+    Interface->OffloadStatus.Receive.TransportLayerXsum = Xdp->SkipXsum;
+    Interface->OffloadStatus.Transmit.NetworkLayerXsum = Xdp->SkipXsum;
+    Interface->OffloadStatus.Transmit.TransportLayerXsum = Xdp->SkipXsum;
+
+    if (RxHeadroom + XSK_PACKET_HEADROOM + MAX_ETH_FRAME_SIZE > Xdp->ChunkSize) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "Receive context too large for UMEM chunk");
+        goto Error;
+    }
+
+    Status = CxPlatGetInterfaceRssQueueCount(Interface->IfName, &Interface->QueueCount);
+    if (QUIC_FAILED(Status)) {
+        goto Error;
+    }
+
+    Interface->XskMap =
+        CxPlatBpfMapCreate(
+            BPF_MAP_TYPE_XSKMAP, sizeof(uint32_t), sizeof(int), Interface->QueueCount);
+    if (Interface->XskMap < 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_MAP_CREATE(XSKMAP)");
+        goto Error;
+    }
+
+    Interface->PortMap =
+        CxPlatBpfMapCreate(
+            BPF_MAP_TYPE_HASH, sizeof(uint16_t), sizeof(uint32_t), MAX_PORT_RULES);
+    if (Interface->PortMap < 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_MAP_CREATE(HASH)");
+        goto Error;
+    }
+
+    Interface->Queues =
+        CXPLAT_ALLOC_NONPAGED(Interface->QueueCount * sizeof(*Interface->Queues), QUIC_POOL_DATAPATH);
+    if (Interface->Queues == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "XDP Queues",
+            Interface->QueueCount * sizeof(*Interface->Queues));
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
+    }
+
+    CxPlatZeroMemory(Interface->Queues, Interface->QueueCount * sizeof(*Interface->Queues));
+
+    for (uint32_t i = 0; i < Interface->QueueCount; i++) {
+        XDP_QUEUE* Queue = &Interface->Queues[i];
+
+        Queue->Interface = Interface;
+        Queue->QueueId = i;
+        Queue->Xsk = INVALID_SOCKET;
+        CxPlatLockInitialize(&Queue->RxPoolLock);
+        CxPlatLockInitialize(&Queue->TxPoolLock);
+        CxPlatLockInitialize(&Queue->TxLock);
+        CxPlatListInitializeHead(&Queue->TxQueue);
+        CxPlatListInitializeHead(&Queue->WorkerTxQueue);
+
+        Status = CxPlatDpRawQueueInitialize(Xdp, Interface, RxHeadroom, Queue);
+        if (QUIC_FAILED(Status)) {
+            goto Error;
+        }
+    }
+
+    Interface->Program = CxPlatXdpLoadProgram(Interface);
+    if (Interface->Program < 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_PROG_LOAD");
+        goto Error;
+    }
+
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.link_create.prog_fd = (uint32_t)Interface->Program;
+    Attr.link_create.target_ifindex = Interface->IfIndex;
+    Attr.link_create.attach_type = BPF_XDP;
+    Attr.link_create.flags = Xdp->ForceGeneric ? XDP_FLAGS_SKB_MODE : 0;
+    Interface->ProgramLink = CxPlatBpf(BPF_LINK_CREATE, &Attr);
+    if (Interface->ProgramLink < 0 && !Xdp->ForceGeneric) {
+        //
+        // The driver has no native XDP support (e.g. veth without GRO, or
+        // most virtual NICs). Fall back to generic (SKB) mode.
+        //
+        Attr.link_create.flags = XDP_FLAGS_SKB_MODE;
+        Interface->ProgramLink = CxPlatBpf(BPF_LINK_CREATE, &Attr);
+    }
+    if (Interface->ProgramLink < 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "BPF_LINK_CREATE(BPF_XDP)");
+        goto Error;
+    }
+
+    Status = QUIC_STATUS_SUCCESS;
+
+Error:
+    if (QUIC_FAILED(Status)) {
+        CxPlatDpRawInterfaceUninitialize(Interface);
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawInterfaceUpdatePort(
+    _In_ XDP_INTERFACE* Interface,
+    _In_ uint16_t Port,
+    _In_ BOOLEAN IsCreated
+    )
+{
+    uint32_t SocketCount = 0;
+
+    CxPlatLockAcquire(&Interface->RuleLock);
+
+    (void)CxPlatBpfMapElem(BPF_MAP_LOOKUP_ELEM, Interface->PortMap, &Port, &SocketCount, 0);
+
+    int Result;
+    if (IsCreated) {
+        SocketCount++;
+        Result = CxPlatBpfMapElem(BPF_MAP_UPDATE_ELEM, Interface->PortMap, &Port, &SocketCount, BPF_ANY);
+    } else if (SocketCount > 1) {
+        SocketCount--;
+        Result = CxPlatBpfMapElem(BPF_MAP_UPDATE_ELEM, Interface->PortMap, &Port, &SocketCount, BPF_ANY);
+    } else {
+        Result = CxPlatBpfMapElem(BPF_MAP_DELETE_ELEM, Interface->PortMap, &Port, NULL, 0);
+    }
+
+    if (Result != 0) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            errno,
+            "Update XDP port map");
+    }
+
+    CxPlatLockRelease(&Interface->RuleLock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatDpRawInitialize(
+    _Inout_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint32_t ClientRecvContextLength
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+    struct ifaddrs* Addresses = NULL;
+    QUIC_STATUS Status;
+
+    CxPlatXdpReadConfig(Xdp);
+    CxPlatDpRawGenerateCpuTable(Datapath);
+    CxPlatListInitializeHead(&Xdp->Interfaces);
+
+    if (!CxPlatIsPowerOfTwo(Xdp->RxRingSize) || !CxPlatIsPowerOfTwo(Xdp->TxRingSize)) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "XDP ring sizes must be a power of two");
+        goto Error;
+    }
+
+    const uint32_t RxHeadroom = sizeof(XDP_RX_PACKET) + ALIGN_UP(ClientRecvContextLength, uint32_t);
+    Xdp->ChunkSize =
+        RxHeadroom + XSK_PACKET_HEADROOM + MAX_ETH_FRAME_SIZE <= XSK_MIN_CHUNK_SIZE ?
+            XSK_MIN_CHUNK_SIZE : XSK_MAX_CHUNK_SIZE;
+
+    if (getifaddrs(&Addresses) != 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "getifaddrs");
+        goto Error;
+    }
+
+    for (struct ifaddrs* Adapter = Addresses; Adapter != NULL; Adapter = Adapter->ifa_next) {
+        const struct sockaddr_ll* Link = (const struct sockaddr_ll*)Adapter->ifa_addr;
+        if (Link == NULL ||
+            Link->sll_family != AF_PACKET ||
+            Link->sll_hatype != ARPHRD_ETHER ||
+            Link->sll_halen != ETH_MAC_ADDR_LEN ||
+            !(Adapter->ifa_flags & IFF_UP) ||
+            (Adapter->ifa_flags & IFF_LOOPBACK)) {
+            continue;
+        }
+
+        if (Xdp->InterfaceName[0] != '\0' &&
+            strcmp(Xdp->InterfaceName, Adapter->ifa_name) != 0) {
+            continue;
+        }
+
+        XDP_INTERFACE* Interface = CXPLAT_ALLOC_NONPAGED(sizeof(XDP_INTERFACE), QUIC_POOL_DATAPATH);
+        if (Interface == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "XDP interface",
+                sizeof(*Interface));
+            Status = QUIC_STATUS_OUT_OF_MEMORY;
+            goto Error;
+        }
+
+        CxPlatZeroMemory(Interface, sizeof(*Interface));
+        Interface->IfIndex = (uint32_t)Link->sll_ifindex;
+        strncpy(Interface->IfName, Adapter->ifa_name, sizeof(Interface->IfName) - 1);
+        memcpy(
+            Interface->PhysicalAddress, Link->sll_addr,
+            sizeof(Interface->PhysicalAddress));
+
+        Status =
+            CxPlatDpRawInterfaceInitialize(
+                Xdp, Interface, ClientRecvContextLength);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "CxPlatDpRawInterfaceInitialize");
+            CXPLAT_FREE(Interface, QUIC_POOL_DATAPATH);
+            continue;
+        }
+#if DEBUG
+        printf("Bound XDP to interface %u (%s)\n", Interface->IfIndex, Interface->IfName);
+#endif
+        CxPlatListInsertTail(&Xdp->Interfaces, &Interface->Link);
+    }
+
+    if (CxPlatListIsEmpty(&Xdp->Interfaces)) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "no XDP capable interface");
+        Status = QUIC_STATUS_NOT_FOUND;
+        goto Error;
+    }
+
+    Xdp->Running = TRUE;
+    CxPlatEventInitialize(&Xdp->CompletionEvent, TRUE, FALSE);
+    CxPlatWorkerRegisterDataPath(Xdp->Cpu, Xdp);
+    Status = QUIC_STATUS_SUCCESS;
+
+Error:
+
+    if (Addresses != NULL) {
+        freeifaddrs(Addresses);
+    }
+
+    if (QUIC_FAILED(Status)) {
+        CxPlatDpRawUninitialize(Datapath);
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Datapath;
+
+    if (Xdp->Running) {
+        Xdp->Running = FALSE;
+        CxPlatEventWaitForever(Xdp->CompletionEvent);
+        CxPlatEventUninitialize(Xdp->CompletionEvent);
+    }
+
+    while (!CxPlatListIsEmpty(&Xdp->Interfaces)) {
+        XDP_INTERFACE* Interface =
+            CXPLAT_CONTAINING_RECORD(CxPlatListRemoveHead(&Xdp->Interfaces), XDP_INTERFACE, Link);
+        CxPlatDpRawInterfaceUninitialize(Interface);
+        CXPLAT_FREE(Interface, QUIC_POOL_DATAPATH);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawPlumbRulesOnSocket(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ BOOLEAN IsCreated
+    )
+{
+    XDP_DATAPATH* Xdp = (XDP_DATAPATH*)Socket->Datapath;
+
+    //
+    // All sockets are matched by UDP destination port only. The port is
+    // reserved by the socket's auxiliary OS socket, so the only sockets that
+    // share one are CIBIR listeners, which are then demultiplexed by
+    // CxPlatGetSocket.
+    //
+    // TODO - Optimization: apply only to the correct interface.
+    //
+    CXPLAT_LIST_ENTRY* Entry;
+    for (Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        CxPlatDpRawInterfaceUpdatePort(Interface, Socket->LocalAddress.Ipv4.sin_port, IsCreated);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDpRawAssignQueue(
+    _In_ const CXPLAT_INTERFACE* _Interface,
+    _Inout_ CXPLAT_ROUTE* Route
+    )
+{
+    const XDP_INTERFACE* Interface = (const XDP_INTERFACE*)_Interface;
+    Route->Queue = &Interface->Queues[0];
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+const CXPLAT_INTERFACE*
+CxPlatDpRawGetInterfaceFromQueue(
+    _In_ const void* Queue
+    )
+{
+    return (const CXPLAT_INTERFACE*)((XDP_QUEUE*)Queue)->Interface;
+}
+
+static
+void
+CxPlatXdpRx(
+    _In_ XDP_DATAPATH* Xdp,
+    _In_ XDP_QUEUE* Queue
+    )
+{
+    CXPLAT_RECV_DATA* Buffers[RX_BATCH_SIZE];
+    uint32_t RxIndex;
+    uint32_t FillIndex;
+    uint32_t ProdCount = 0;
+    uint32_t PacketCount = 0;
+    const uint64_t ChunkMask = ~((uint64_t)Xdp->ChunkSize - 1);
+    const uint32_t BuffersCount = XskRingConsumerReserve(&Queue->RxRing, RX_BATCH_SIZE, &RxIndex);
+
+    for (uint32_t i = 0; i < BuffersCount; i++) {
+        struct xdp_desc* Buffer = XskRingGetElement(&Queue->RxRing, RxIndex++);
+        XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)(Queue->Umem + (Buffer->addr & ChunkMask));
+        uint8_t* FrameBuffer = Queue->Umem + Buffer->addr;
+
+        CxPlatZeroMemory(Packet, sizeof(XDP_RX_PACKET));
+        Packet->Route = &Packet->RouteStorage;
+        Packet->RouteStorage.Queue = Queue;
+
+        CxPlatDpRawParseEthernet(
+            (CXPLAT_DATAPATH*)Xdp,
+            (CXPLAT_RECV_DATA*)Packet,
+            FrameBuffer,
+            (uint16_t)Buffer->len);
+
+        if (Packet->Buffer) {
+            Packet->Allocated = TRUE;
+            Packet->Queue = Queue;
+            Buffers[PacketCount++] = (CXPLAT_RECV_DATA*)Packet;
+        } else {
+            CxPlatListPushEntry(&Queue->WorkerRxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+        }
+    }
+
+    if (BuffersCount > 0) {
+        XskRingConsumerRelease(&Queue->RxRing, BuffersCount);
+    }
+
+    uint32_t FillAvailable = XskRingProducerReserve(&Queue->RxFillRing, UINT32_MAX, &FillIndex);
+    while (FillAvailable-- > 0) {
+        if (Queue->WorkerRxPool.Next == NULL &&
+            __atomic_load_n(&Queue->RxPool.Next, __ATOMIC_RELAXED) != NULL) {
+            CxPlatLockAcquire(&Queue->RxPoolLock);
+            Queue->WorkerRxPool.Next = Queue->RxPool.Next;
+            Queue->RxPool.Next = NULL;
+            CxPlatLockRelease(&Queue->RxPoolLock);
+        }
+
+        XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)CxPlatListPopEntry(&Queue->WorkerRxPool);
+        if (Packet == NULL) {
+            break;
+        }
+
+        uint64_t* FillDesc = XskRingGetElement(&Queue->RxFillRing, FillIndex++);
+        *FillDesc = (uint64_t)((uint8_t*)Packet - Queue->Umem);
+        ProdCount++;
+    }
+
+    if (ProdCount > 0) {
+        XskRingProducerSubmit(&Queue->RxFillRing, ProdCount);
+        if (XskRingProducerNeedPoke(&Queue->RxFillRing)) {
+            (void)recvfrom(Queue->Xsk, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+        }
+    }
+
+    if (PacketCount > 0) {
+        CxPlatDpRawRxEthernet((CXPLAT_DATAPATH*)Xdp, Buffers, (uint16_t)PacketCount);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawRxFree(
+    _In_opt_ const CXPLAT_RECV_DATA* PacketChain
+    )
+{
+    CXPLAT_SLIST_ENTRY* Head = NULL;
+    CXPLAT_SLIST_ENTRY** Tail = &Head;
+    XDP_QUEUE* Queue = NULL;
+
+    while (PacketChain) {
+        const XDP_RX_PACKET* Packet = (XDP_RX_PACKET*)PacketChain;
+        PacketChain = PacketChain->Next;
+        // Packet->Allocated = FALSE; (other data paths don't clear this flag?)
+
+        if (Queue != Packet->Queue) {
+            if (Head != NULL) {
+                CxPlatLockAcquire(&Queue->RxPoolLock);
+                *Tail = Queue->RxPool.Next;
+                Queue->RxPool.Next = Head;
+                CxPlatLockRelease(&Queue->RxPoolLock);
+                Head = NULL;
+                Tail = &Head;
+            }
+
+            Queue = Packet->Queue;
+        }
+
+        *Tail = (CXPLAT_SLIST_ENTRY*)Packet;
+        Tail = &((CXPLAT_SLIST_ENTRY*)Packet)->Next;
+    }
+
+    if (Head != NULL) {
+        CxPlatLockAcquire(&Queue->RxPoolLock);
+        *Tail = Queue->RxPool.Next;
+        Queue->RxPool.Next = Head;
+        CxPlatLockRelease(&Queue->RxPoolLock);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+CXPLAT_SEND_DATA*
+CxPlatDpRawTxAlloc(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ CXPLAT_ECN_TYPE ECN, // unused currently
+    _In_ uint16_t MaxPacketSize,
+    _Inout_ CXPLAT_ROUTE* Route
+    )
+{
+    QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(&Route->RemoteAddress);
+    XDP_QUEUE* Queue = Route->Queue;
+
+    UNREFERENCED_PARAMETER(ECN);
+    UNREFERENCED_PARAMETER(Datapath);
+
+    CxPlatLockAcquire(&Queue->TxPoolLock);
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)CxPlatListPopEntry(&Queue->TxPool);
+    CxPlatLockRelease(&Queue->TxPoolLock);
+
+    if (Packet) {
+        HEADER_BACKFILL HeaderBackfill = CxPlatDpRawCalculateHeaderBackFill(Family); // TODO - Cache in Route?
+        CXPLAT_DBG_ASSERT(MaxPacketSize <= sizeof(Packet->FrameBuffer) - HeaderBackfill.AllLayer);
+        Packet->Queue = Queue;
+        Packet->Buffer.Length = MaxPacketSize;
+        Packet->Buffer.Buffer = &Packet->FrameBuffer[HeaderBackfill.AllLayer];
+    }
+
+    return (CXPLAT_SEND_DATA*)Packet;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)SendData;
+    XDP_QUEUE* Queue = Packet->Queue;
+    CxPlatLockAcquire(&Queue->TxPoolLock);
+    CxPlatListPushEntry(&Queue->TxPool, (CXPLAT_SLIST_ENTRY*)Packet);
+    CxPlatLockRelease(&Queue->TxPoolLock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatDpRawTxEnqueue(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)SendData;
+
+    CxPlatLockAcquire(&Packet->Queue->TxLock);
+    CxPlatListInsertTail(&Packet->Queue->TxQueue, &Packet->Link);
+    CxPlatLockRelease(&Packet->Queue->TxLock);
+}
+
+static
+void
+CxPlatXdpTx(
+    _In_ XDP_DATAPATH* Xdp,
+    _In_ XDP_QUEUE* Queue
+    )
+{
+    uint32_t ProdCount = 0;
+    uint32_t CompCount = 0;
+    CXPLAT_SLIST_ENTRY* TxCompleteHead = NULL;
+    CXPLAT_SLIST_ENTRY** TxCompleteTail = &TxCompleteHead;
+    const uint64_t ChunkMask = ~((uint64_t)Xdp->ChunkSize - 1);
+
+    if (CxPlatListIsEmpty(&Queue->WorkerTxQueue) &&
+        __atomic_load_n(&Queue->TxQueue.Flink, __ATOMIC_RELAXED) != &Queue->TxQueue) {
+        CxPlatLockAcquire(&Queue->TxLock);
+        CxPlatListMoveItems(&Queue->TxQueue, &Queue->WorkerTxQueue);
+        CxPlatLockRelease(&Queue->TxLock);
+    }
+
+    uint32_t TxIndex;
+    uint32_t TxAvailable = XskRingProducerReserve(&Queue->TxRing, UINT32_MAX, &TxIndex);
+    while (TxAvailable-- > 0 && !CxPlatListIsEmpty(&Queue->WorkerTxQueue)) {
+        struct xdp_desc* Buffer = XskRingGetElement(&Queue->TxRing, TxIndex++);
+        CXPLAT_LIST_ENTRY* Entry = CxPlatListRemoveHead(&Queue->WorkerTxQueue);
+        XDP_TX_PACKET* Packet = CXPLAT_CONTAINING_RECORD(Entry, XDP_TX_PACKET, Link);
+
+        Buffer->addr =
+            (uint64_t)((uint8_t*)Packet - Queue->Umem) + FIELD_OFFSET(XDP_TX_PACKET, FrameBuffer);
+        Buffer->len = Packet->Buffer.Length;
+        Buffer->options = 0;
+        ProdCount++;
+    }
+
+    if (ProdCount > 0) {
+        XskRingProducerSubmit(&Queue->TxRing, ProdCount);
+        if (Xdp->TxAlwaysPoke || XskRingProducerNeedPoke(&Queue->TxRing)) {
+            (void)sendto(Queue->Xsk, NULL, 0, MSG_DONTWAIT, NULL, 0);
+        }
+    }
+
+    uint32_t CompIndex;
+    uint32_t CompAvailable =
+        XskRingConsumerReserve(&Queue->TxCompletionRing, UINT32_MAX, &CompIndex);
+    while (CompAvailable-- > 0) {
+        uint64_t* CompDesc = XskRingGetElement(&Queue->TxCompletionRing, CompIndex++);
+        XDP_TX_PACKET* Packet = (XDP_TX_PACKET*)(Queue->Umem + (*CompDesc & ChunkMask));
+        *TxCompleteTail = (CXPLAT_SLIST_ENTRY*)Packet;
+        TxCompleteTail = &((CXPLAT_SLIST_ENTRY*)Packet)->Next;
+        CompCount++;
+    }
+
+    if (CompCount > 0) {
+        XskRingConsumerRelease(&Queue->TxCompletionRing, CompCount);
+        CxPlatLockAcquire(&Queue->TxPoolLock);
+        *TxCompleteTail = Queue->TxPool.Next;
+        Queue->TxPool.Next = TxCompleteHead;
+        CxPlatLockRelease(&Queue->TxPoolLock);
+    }
+}
+
+void
+CxPlatDataPathWake(
+    _In_ void* Context
+    )
+{
+    // No-op - XDP never sleeps!
+    UNREFERENCED_PARAMETER(Context);
+}
+
+void
+CxPlatDataPathRunEC(
+    _In_ void** Context,
+    _In_ CXPLAT_THREAD_ID CurThreadId,
+    _In_ uint32_t WaitTime
+    )
+{
+    XDP_DATAPATH* Xdp = *(XDP_DATAPATH**)Context;
+
+    UNREFERENCED_PARAMETER(CurThreadId);
+    UNREFERENCED_PARAMETER(WaitTime);
+
+    if (!Xdp->Running) {
+        *Context = NULL;
+        CxPlatEventSet(Xdp->CompletionEvent);
+        return;
+    }
+
+    CXPLAT_LIST_ENTRY* Entry;
+    for (Entry = Xdp->Interfaces.Flink; Entry != &Xdp->Interfaces; Entry = Entry->Flink) {
+        XDP_INTERFACE* Interface = CXPLAT_CONTAINING_RECORD(Entry, XDP_INTERFACE, Link);
+        for (uint8_t QueueId = 0; QueueId < Interface->QueueCount; QueueId++) {
+            CxPlatXdpRx(Xdp, &Interface->Queues[QueueId]);
+            CxPlatXdpTx(Xdp, &Interface->Queues[QueueId]);
+        }
+    }
+}
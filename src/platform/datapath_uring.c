@@ -0,0 +1,3444 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC datapath Abstraction Layer, implemented with io_uring.
+
+    Receives use one multishot recvmsg per socket, which pulls its buffers
+    from a per-processor provided buffer ring. Sends are queued as sendmsg
+    submissions on the socket's ring, and completions for all the sockets of a
+    processor are reaped by that processor's worker thread.
+
+Environment:
+
+    Linux
+
+--*/
+
+#include "platform_internal.h"
+#include <arpa/inet.h>
+#include <inttypes.h>
+#include <linux/filter.h>
+#include <linux/in6.h>
+#include <linux/io_uring.h>
+#include <linux/net_tstamp.h>
+#include <netinet/udp.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#ifdef QUIC_CLOG
+#include "datapath_uring.c.clog.h"
+#endif
+
+CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Length) <= sizeof(size_t)), "(sizeof(QUIC_BUFFER.Length) == sizeof(size_t) must be TRUE.");
+CXPLAT_STATIC_ASSERT((SIZEOF_STRUCT_MEMBER(QUIC_BUFFER, Buffer) == sizeof(void*)), "(sizeof(QUIC_BUFFER.Buffer) == sizeof(void*) must be TRUE.");
+
+//
+// The maximum single buffer size for sending coalesced payloads.
+//
+#define CXPLAT_LARGE_SEND_BUFFER_SIZE         0xFFFF
+
+#ifdef DISABLE_POSIX_GSO
+#ifdef UDP_SEGMENT
+#undef UDP_SEGMENT
+#endif
+#endif
+
+#ifdef DISABLE_POSIX_TXTIME
+#ifdef SO_TXTIME
+#undef SO_TXTIME
+#endif
+#endif
+
+//
+// If we have UDP segmentation support, use a single batch. Without UDP
+// segmentation, increase batch size to gain back some performance
+//
+#ifdef UDP_SEGMENT
+#define CXPLAT_MAX_BATCH_SEND 1
+#else
+#define CXPLAT_MAX_BATCH_SEND 43
+#endif
+
+//
+// The maximum number of received datagrams indicated in one chain.
+//
+#define CXPLAT_MAX_BATCH_RECEIVE 43
+
+//
+// The number of submission queue entries for each processor's ring.
+//
+#define CXPLAT_URING_SQ_ENTRIES 1024
+
+//
+// The number of completion queue entries for each processor's ring. This is
+// sized to absorb completions for all outstanding sends plus a full buffer
+// ring's worth of receives.
+//
+#define CXPLAT_URING_CQ_ENTRIES 8192
+
+//
+// The number of receive buffers in each processor's provided buffer ring. Must
+// be a power of two.
+//
+#define CXPLAT_URING_RECV_BUFFER_COUNT 1024
+
+//
+// The buffer group ID used for the provided receive buffer ring.
+//
+#define CXPLAT_URING_RECV_BUFFER_GROUP 0
+
+//
+// How long (in milliseconds) the kernel submission thread spins before going
+// idle, in SQPOLL mode.
+//
+#define CXPLAT_URING_SQ_THREAD_IDLE_MS 50
+
+//
+// The maximum number of rings a thread's open send batch defers submissions
+// on. Sends to any further ring are submitted immediately.
+//
+#define CXPLAT_URING_MAX_BATCH_RINGS 4
+
+//
+// The type of operation a completion is for, encoded in the low bits of the
+// submission's user data.
+//
+#define CXPLAT_URING_OP_RECV    0x0
+#define CXPLAT_URING_OP_SEND    0x1
+#define CXPLAT_URING_OP_WAKE    0x2
+#define CXPLAT_URING_OP_CANCEL  0x3
+#define CXPLAT_URING_OP_MASK    0x3
+
+CXPLAT_STATIC_ASSERT(
+    CXPLAT_URING_RECV_BUFFER_COUNT <= UINT16_MAX + 1 &&
+    (CXPLAT_URING_RECV_BUFFER_COUNT & (CXPLAT_URING_RECV_BUFFER_COUNT - 1)) == 0,
+    "Buffer ring size must be a power of two that fits buffer IDs");
+
+//
+// A minimal io_uring instance, driven directly through the kernel ABI.
+//
+typedef struct CXPLAT_URING {
+
+    //
+    // The io_uring file descriptor.
+    //
+    int RingFd;
+
+    //
+    // Flags the ring was set up with.
+    //
+    uint32_t SetupFlags;
+
+    //
+    // Submission queue state shared with the kernel.
+    //
+    uint32_t* SqHead;
+    uint32_t* SqTail;
+    uint32_t* SqFlags;
+    uint32_t* SqArray;
+    uint32_t SqMask;
+    uint32_t SqEntries;
+    struct io_uring_sqe* Sqes;
+
+    //
+    // The tail of the locally prepared, but not yet published, submissions.
+    //
+    uint32_t SqLocalTail;
+
+    //
+    // Completion queue state shared with the kernel.
+    //
+    uint32_t* CqHead;
+    uint32_t* CqTail;
+    uint32_t CqMask;
+    struct io_uring_cqe* Cqes;
+
+    //
+    // The memory mappings backing the queues.
+    //
+    void* SqRing;
+    size_t SqRingSize;
+    void* CqRing;
+    size_t CqRingSize;
+    size_t SqesSize;
+
+} CXPLAT_URING;
+
+typedef struct CXPLAT_DATAPATH_PROC_CONTEXT CXPLAT_DATAPATH_PROC_CONTEXT;
+typedef struct CXPLAT_SOCKET_CONTEXT CXPLAT_SOCKET_CONTEXT;
+
+//
+// A receive block to receive a UDP packet over the sockets. Receive blocks
+// live in one contiguous per-processor allocation and are lent to the kernel
+// through the provided buffer ring.
+//
+typedef struct CXPLAT_DATAPATH_RECV_BLOCK {
+    //
+    // The processor context owning this recv block.
+    //
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext;
+
+    //
+    // The ID of this block in the provided buffer ring.
+    //
+    uint16_t BufferId;
+
+    //
+    // Represents the network route.
+    //
+    CXPLAT_ROUTE Route;
+
+    //
+    // The recv buffer used by MsQuic.
+    //
+    CXPLAT_RECV_DATA RecvData;
+
+    //
+    // This follows the recv block.
+    //
+    // CXPLAT_RECV_PACKET RecvContext;
+    //
+    // Then, at Datapath->RecvBufferOffset, the buffer the kernel fills in:
+    //
+    // struct io_uring_recvmsg_out;
+    // QUIC_ADDR RemoteAddress;
+    // CXPLAT_RECV_MSG_CONTROL_BUFFER Control;
+    // uint8_t Payload[MAX_UDP_PAYLOAD_LENGTH];
+    //
+
+} CXPLAT_DATAPATH_RECV_BLOCK;
+
+//
+// Send context.
+//
+
+typedef struct CXPLAT_SEND_DATA {
+    //
+    // The type of ECN markings needed for send.
+    //
+    CXPLAT_ECN_TYPE ECN;
+
+    //
+    // The proc context owning this send context.
+    //
+    CXPLAT_DATAPATH_PROC_CONTEXT* Owner;
+
+    //
+    // The socket context this send was submitted on.
+    //
+    CXPLAT_SOCKET_CONTEXT* SocketContext;
+
+    //
+    // The number of submitted messages that have not completed yet. Only
+    // accessed on the socket context's processor thread once submitted.
+    //
+    uint32_t PendingMessagesCount;
+
+    //
+    // The send segmentation size; zero if segmentation is not performed.
+    //
+    uint16_t SegmentSize;
+
+    //
+    // The total buffer size for Buffers.
+    //
+    uint32_t TotalSize;
+
+    //
+    // The earliest departure time (in CxPlatTimeUs64 microseconds) passed to
+    // the kernel with SCM_TXTIME; zero to send immediately.
+    //
+    uint64_t TxTime;
+
+    //
+    // The remote address to send to, mapped to the dual-stack socket format.
+    //
+    QUIC_ADDR MappedRemoteAddress;
+
+    //
+    // BufferCount - The buffer count in use.
+    //
+    // Buffers - Send buffers.
+    //
+    // Iovs - IO vectors used for doing sends on the socket.
+    //
+    size_t BufferCount;
+    QUIC_BUFFER Buffers[CXPLAT_MAX_BATCH_SEND];
+    struct iovec Iovs[CXPLAT_MAX_BATCH_SEND];
+
+    //
+    // The message headers and their control data. These must stay valid until
+    // the submissions complete.
+    //
+    struct msghdr MsgHdrs[CXPLAT_MAX_BATCH_SEND];
+    char ControlBuffers[CXPLAT_MAX_BATCH_SEND][
+        CMSG_SPACE(sizeof(struct in6_pktinfo)) +
+        CMSG_SPACE(sizeof(int))
+#ifdef UDP_SEGMENT
+        + CMSG_SPACE(sizeof(uint16_t))
+#endif
+#ifdef SO_TXTIME
+        + CMSG_SPACE(sizeof(uint64_t))
+#endif
+        ];
+
+    //
+    // The QUIC_BUFFER returned to the client for segmented sends.
+    //
+    QUIC_BUFFER ClientBuffer;
+
+} CXPLAT_SEND_DATA;
+
+typedef struct CXPLAT_RECV_MSG_CONTROL_BUFFER {
+    char Data[CMSG_SPACE(sizeof(struct in6_pktinfo)) +
+              CMSG_SPACE(sizeof(struct in_pktinfo)) +
+              2 * CMSG_SPACE(sizeof(int))];
+} CXPLAT_RECV_MSG_CONTROL_BUFFER;
+
+//
+// Socket context.
+//
+typedef struct CXPLAT_SOCKET_CONTEXT {
+
+    //
+    // The datapath binding this socket context belongs to.
+    //
+    CXPLAT_SOCKET* Binding;
+
+    //
+    // The datapath proc context this socket belongs to.
+    //
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext;
+
+    //
+    // The socket FD used by this socket context.
+    //
+    int SocketFd;
+
+    //
+    // The number of references keeping the socket context alive: one for the
+    // socket itself, one for the armed receive and one per submitted send.
+    //
+    long IoCount;
+
+    //
+    // Indicates the socket context is queued on its processor's list of
+    // sockets whose receive must be (re-)armed. Protected by the processor's
+    // SubmitLock.
+    //
+    BOOLEAN RecvStarved;
+
+    //
+    // Indicates the socket context has been uninitialized and must not be
+    // re-armed. Protected by the processor's SubmitLock.
+    //
+    BOOLEAN Uninitialized;
+
+    //
+    // Indicates the binding rundown reference for this socket context was
+    // already released, because the binding was deleted on this socket
+    // context's own worker thread. Only accessed on that thread.
+    //
+    BOOLEAN RundownReleased;
+
+    //
+    // Linkage in the processor's list of receive-starved sockets.
+    //
+    CXPLAT_LIST_ENTRY StarvedLinkage;
+
+    //
+    // The message header template used by the multishot receive.
+    //
+    struct msghdr RecvMsgHdr;
+
+} CXPLAT_SOCKET_CONTEXT;
+
+//
+// Datapath binding.
+//
+typedef struct CXPLAT_SOCKET {
+
+    //
+    // Synchronization mechanism for cleanup.
+    // Make sure events are in front for cache alignment.
+    //
+    CXPLAT_RUNDOWN_REF Rundown;
+
+    //
+    // A pointer to datapath object.
+    //
+    CXPLAT_DATAPATH* Datapath;
+
+    //
+    // The client context for this binding.
+    //
+    void *ClientContext;
+
+    //
+    // The local address for the binding.
+    //
+    QUIC_ADDR LocalAddress;
+
+    //
+    //  The remote address for the binding.
+    //
+    QUIC_ADDR RemoteAddress;
+
+    //
+    // The number of references to the binding's memory. Socket contexts may
+    // be drained on their processor after CxPlatSocketDelete returns.
+    //
+    long RefCount;
+
+    //
+    // Indicates the binding connected to a remote IP address.
+    //
+    BOOLEAN Connected : 1;
+
+    //
+    // Indicates the binding is shut down.
+    //
+    BOOLEAN Shutdown : 1;
+
+    //
+    // Flag indicates the socket has a default remote destination.
+    //
+    BOOLEAN HasFixedRemoteAddress : 1;
+
+    //
+    // Flag indicates the binding is being used for PCP.
+    //
+    BOOLEAN PcpBinding : 1;
+
+    //
+    // The MTU for this binding.
+    //
+    uint16_t Mtu;
+
+    //
+    // The number of socket contexts.
+    //
+    uint32_t SocketCount;
+
+    //
+    // Set of socket contexts one per proc.
+    //
+    CXPLAT_SOCKET_CONTEXT SocketContexts[];
+
+} CXPLAT_SOCKET;
+
+//
+// A per processor datapath context.
+//
+typedef struct CXPLAT_DATAPATH_PROC_CONTEXT {
+
+    //
+    // A pointer to the datapath.
+    //
+    CXPLAT_DATAPATH* Datapath;
+
+    //
+    // The io_uring instance for this proc context.
+    //
+    CXPLAT_URING Ring;
+
+    //
+    // Serializes submissions to the ring, which may come from any thread.
+    //
+    CXPLAT_LOCK SubmitLock;
+
+    //
+    // The event FD for this proc context.
+    //
+    int EventFd;
+
+    //
+    // The value read from EventFd.
+    //
+    eventfd_t EventFdValue;
+
+    //
+    // The index of the context in the datapath's array.
+    //
+    uint32_t Index;
+
+    //
+    // Thread ID of the worker thread that drives execution.
+    //
+    CXPLAT_THREAD_ID ThreadId;
+
+    //
+    // Completion event to indicate the worker has cleaned up.
+    //
+    CXPLAT_EVENT CompletionEvent;
+
+    //
+    // The provided buffer ring for receives, and the memory backing it.
+    //
+    struct io_uring_buf_ring* RecvBufferRing;
+    size_t RecvBufferRingSize;
+    uint8_t* RecvBlocks;
+    size_t RecvBlocksSize;
+
+    //
+    // The tail of the provided buffer ring. Protected by RecvBufferLock.
+    //
+    uint16_t RecvBufferRingTail;
+
+    //
+    // Serializes returning buffers to the ring, which may come from any thread.
+    //
+    CXPLAT_LOCK RecvBufferLock;
+
+    //
+    // The number of provided buffers the kernel has handed back in receive
+    // completions. Only accessed on the proc thread.
+    //
+    uint16_t RecvBuffersConsumed;
+
+    //
+    // Indicates the proc thread is waiting for receive buffers to be returned
+    // before it can re-arm its starved sockets.
+    //
+    BOOLEAN volatile RecvStarved;
+
+    //
+    // Sockets whose multishot receive must be (re-)armed by the proc thread.
+    // Protected by SubmitLock.
+    //
+    CXPLAT_LIST_ENTRY StarvedSockets;
+
+    //
+    // Pool of send buffers to be shared by all sockets on this core.
+    //
+    CXPLAT_POOL SendBufferPool;
+
+    //
+    // Pool of large segmented send buffers to be shared by all sockets on this
+    // core.
+    //
+    CXPLAT_POOL LargeSendBufferPool;
+
+    //
+    // Pool of send data contexts to be shared by all sockets on this core.
+    //
+    CXPLAT_POOL SendDataPool;
+
+} CXPLAT_DATAPATH_PROC_CONTEXT;
+
+//
+// A thread's open send batch. While open, sends only queue their submission
+// entries, and the rings they were queued on are submitted when it closes.
+//
+typedef struct CXPLAT_URING_SEND_BATCH {
+
+    //
+    // The nesting depth of CxPlatSocketSendBatchBegin calls.
+    //
+    uint32_t Depth;
+
+    //
+    // The rings with deferred submissions.
+    //
+    uint32_t ProcContextCount;
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContexts[CXPLAT_URING_MAX_BATCH_RINGS];
+
+} CXPLAT_URING_SEND_BATCH;
+
+static __thread CXPLAT_URING_SEND_BATCH CxPlatUringSendBatch;
+
+//
+// Represents a datapath object.
+//
+
+typedef struct CXPLAT_DATAPATH {
+
+    //
+    // A reference rundown on the datapath binding.
+    // Make sure events are in front for cache alignment.
+    //
+    CXPLAT_RUNDOWN_REF BindingsRundown;
+
+    //
+    // Set of supported features.
+    //
+    uint32_t Features;
+
+    //
+    // If datapath is shutting down.
+    //
+    BOOLEAN volatile Shutdown;
+
+    //
+    // The max send batch size.
+    //
+    uint8_t MaxSendBatchSize;
+
+    //
+    // UDP handlers.
+    //
+    CXPLAT_UDP_DATAPATH_CALLBACKS UdpHandlers;
+
+    //
+    // The length of recv context used by MsQuic.
+    //
+    size_t ClientRecvContextLength;
+
+    //
+    // The offset of the kernel-filled buffer in a receive block.
+    //
+    uint32_t RecvBufferOffset;
+
+    //
+    // The size of the kernel-filled buffer in a receive block.
+    //
+    uint32_t RecvBufferLength;
+
+    //
+    // The size of each receive block.
+    //
+    uint32_t RecvBlockStride;
+
+    //
+    // The proc count to create per proc datapath state.
+    //
+    uint32_t ProcCount;
+
+    //
+    // The per proc datapath contexts.
+    //
+    CXPLAT_DATAPATH_PROC_CONTEXT ProcContexts[];
+
+} CXPLAT_DATAPATH;
+
+//
+// io_uring kernel ABI helpers.
+//
+
+static
+int
+CxPlatUringSetup(
+    _In_ uint32_t Entries,
+    _Inout_ struct io_uring_params* Params
+    )
+{
+    return (int)syscall(__NR_io_uring_setup, Entries, Params);
+}
+
+static
+int
+CxPlatUringEnter(
+    _In_ int RingFd,
+    _In_ uint32_t ToSubmit,
+    _In_ uint32_t MinComplete,
+    _In_ uint32_t Flags,
+    _In_opt_ const void* Arg,
+    _In_ size_t ArgSize
+    )
+{
+    return (int)syscall(__NR_io_uring_enter, RingFd, ToSubmit, MinComplete, Flags, Arg, ArgSize);
+}
+
+static
+int
+CxPlatUringRegister(
+    _In_ int RingFd,
+    _In_ uint32_t Opcode,
+    _In_opt_ const void* Arg,
+    _In_ uint32_t ArgCount
+    )
+{
+    return (int)syscall(__NR_io_uring_register, RingFd, Opcode, Arg, ArgCount);
+}
+
+void
+CxPlatUringUninitialize(
+    _In_ CXPLAT_URING* Ring
+    )
+{
+    if (Ring->Sqes != NULL) {
+        munmap(Ring->Sqes, Ring->SqesSize);
+    }
+    if (Ring->CqRing != NULL && Ring->CqRing != Ring->SqRing) {
+        munmap(Ring->CqRing, Ring->CqRingSize);
+    }
+    if (Ring->SqRing != NULL) {
+        munmap(Ring->SqRing, Ring->SqRingSize);
+    }
+    if (Ring->RingFd != INVALID_SOCKET) {
+        close(Ring->RingFd);
+    }
+    CxPlatZeroMemory(Ring, sizeof(*Ring));
+    Ring->RingFd = INVALID_SOCKET;
+}
+
+QUIC_STATUS
+CxPlatUringInitialize(
+    _In_ uint32_t ProcIndex,
+    _Out_ CXPLAT_URING* Ring
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    struct io_uring_params Params;
+
+    CxPlatZeroMemory(Ring, sizeof(*Ring));
+    CxPlatZeroMemory(&Params, sizeof(Params));
+
+    Params.flags = IORING_SETUP_CQSIZE;
+    Params.cq_entries = CXPLAT_URING_CQ_ENTRIES;
+#ifdef CXPLAT_URING_SQPOLL
+    //
+    // A kernel thread polls the submission queue, so submitting sends does not
+    // need a syscall while the thread is awake.
+    //
+    Params.flags |= IORING_SETUP_SQPOLL | IORING_SETUP_SQ_AFF;
+    Params.sq_thread_cpu = ProcIndex;
+    Params.sq_thread_idle = CXPLAT_URING_SQ_THREAD_IDLE_MS;
+#else
+    UNREFERENCED_PARAMETER(ProcIndex);
+#endif
+
+    Ring->RingFd = CxPlatUringSetup(CXPLAT_URING_SQ_ENTRIES, &Params);
+    if (Ring->RingFd < 0) {
+        Status = errno;
+        Ring->RingFd = INVALID_SOCKET;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring_setup failed");
+        goto Exit;
+    }
+
+    if (!(Params.features & IORING_FEAT_SINGLE_MMAP) ||
+        !(Params.features & IORING_FEAT_NODROP) ||
+        !(Params.features & IORING_FEAT_EXT_ARG)) {
+        Status = QUIC_STATUS_NOT_SUPPORTED;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring features missing");
+        goto Exit;
+    }
+
+    Ring->SetupFlags = Params.flags;
+    Ring->SqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(uint32_t);
+    Ring->CqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(struct io_uring_cqe);
+    if (Ring->CqRingSize > Ring->SqRingSize) {
+        Ring->SqRingSize = Ring->CqRingSize;
+    }
+    Ring->CqRingSize = Ring->SqRingSize;
+
+    Ring->SqRing =
+        mmap(
+            NULL,
+            Ring->SqRingSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            Ring->RingFd,
+            IORING_OFF_SQ_RING);
+    if (Ring->SqRing == MAP_FAILED) {
+        Status = errno;
+        Ring->SqRing = NULL;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(IORING_OFF_SQ_RING) failed");
+        goto Exit;
+    }
+    Ring->CqRing = Ring->SqRing;
+
+    Ring->SqesSize = Params.sq_entries * sizeof(struct io_uring_sqe);
+    Ring->Sqes =
+        mmap(
+            NULL,
+            Ring->SqesSize,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            Ring->RingFd,
+            IORING_OFF_SQES);
+    if (Ring->Sqes == MAP_FAILED) {
+        Status = errno;
+        Ring->Sqes = NULL;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "mmap(IORING_OFF_SQES) failed");
+        goto Exit;
+    }
+
+    uint8_t* SqRing = (uint8_t*)Ring->SqRing;
+    Ring->SqHead = (uint32_t*)(SqRing + Params.sq_off.head);
+    Ring->SqTail = (uint32_t*)(SqRing + Params.sq_off.tail);
+    Ring->SqFlags = (uint32_t*)(SqRing + Params.sq_off.flags);
+    Ring->SqArray = (uint32_t*)(SqRing + Params.sq_off.array);
+    Ring->SqMask = *(uint32_t*)(SqRing + Params.sq_off.ring_mask);
+    Ring->SqEntries = *(uint32_t*)(SqRing + Params.sq_off.ring_entries);
+    Ring->SqLocalTail = *Ring->SqTail;
+
+    uint8_t* CqRing = (uint8_t*)Ring->CqRing;
+    Ring->CqHead = (uint32_t*)(CqRing + Params.cq_off.head);
+    Ring->CqTail = (uint32_t*)(CqRing + Params.cq_off.tail);
+    Ring->CqMask = *(uint32_t*)(CqRing + Params.cq_off.ring_mask);
+    Ring->Cqes = (struct io_uring_cqe*)(CqRing + Params.cq_off.cqes);
+
+Exit:
+
+    if (QUIC_FAILED(Status)) {
+        CxPlatUringUninitialize(Ring);
+    }
+
+    return Status;
+}
+
+//
+// Gets the next free submission entry, or NULL if the queue is full.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+static
+struct io_uring_sqe*
+CxPlatUringGetSqe(
+    _In_ CXPLAT_URING* Ring
+    )
+{
+    const uint32_t Head = __atomic_load_n(Ring->SqHead, __ATOMIC_ACQUIRE);
+    if (Ring->SqLocalTail - Head >= Ring->SqEntries) {
+        return NULL;
+    }
+    const uint32_t Index = Ring->SqLocalTail & Ring->SqMask;
+    struct io_uring_sqe* Sqe = &Ring->Sqes[Index];
+    CxPlatZeroMemory(Sqe, sizeof(*Sqe));
+    Ring->SqArray[Index] = Index;
+    Ring->SqLocalTail++;
+    return Sqe;
+}
+
+//
+// Publishes all prepared submission entries to the kernel.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+static
+int
+CxPlatUringSubmit(
+    _In_ CXPLAT_URING* Ring
+    )
+{
+    const uint32_t ToSubmit = Ring->SqLocalTail - *Ring->SqTail;
+    __atomic_store_n(Ring->SqTail, Ring->SqLocalTail, __ATOMIC_RELEASE);
+
+    if (Ring->SetupFlags & IORING_SETUP_SQPOLL) {
+        //
+        // The kernel thread picks up submissions on its own, unless it went
+        // idle and needs to be woken up.
+        //
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(Ring->SqFlags, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP) {
+            if (CxPlatUringEnter(Ring->RingFd, 0, 0, IORING_ENTER_SQ_WAKEUP, NULL, 0) < 0) {
+                return -errno;
+            }
+        }
+        return 0;
+    }
+
+    if (ToSubmit == 0) {
+        return 0;
+    }
+
+    int Result;
+    do {
+        Result = CxPlatUringEnter(Ring->RingFd, ToSubmit, 0, 0, NULL, 0);
+    } while (Result < 0 && errno == EINTR);
+
+    return Result < 0 ? -errno : 0;
+}
+
+//
+// Gets a free submission entry, flushing the queue to the kernel if it is full.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+static
+struct io_uring_sqe*
+CxPlatUringGetSqeOrFlush(
+    _In_ CXPLAT_URING* Ring
+    )
+{
+    struct io_uring_sqe* Sqe = CxPlatUringGetSqe(Ring);
+    if (Sqe == NULL) {
+        (void)CxPlatUringSubmit(Ring);
+        Sqe = CxPlatUringGetSqe(Ring);
+    }
+    return Sqe;
+}
+
+//
+// Gets a free submission entry, waiting for the kernel to drain the queue if
+// necessary. Used for submissions that cannot fail.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+static
+struct io_uring_sqe*
+CxPlatUringGetSqeBlocking(
+    _In_ CXPLAT_URING* Ring
+    )
+{
+    struct io_uring_sqe* Sqe;
+    while ((Sqe = CxPlatUringGetSqeOrFlush(Ring)) == NULL) {
+        sched_yield();
+    }
+    return Sqe;
+}
+
+//
+// Returns the number of free submission entries, flushing the queue to the
+// kernel first if fewer than Needed are available.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+static
+uint32_t
+CxPlatUringReserveSqes(
+    _In_ CXPLAT_URING* Ring,
+    _In_ uint32_t Needed
+    )
+{
+    uint32_t Available =
+        Ring->SqEntries -
+        (Ring->SqLocalTail - __atomic_load_n(Ring->SqHead, __ATOMIC_ACQUIRE));
+    if (Available < Needed) {
+        (void)CxPlatUringSubmit(Ring);
+        Available =
+            Ring->SqEntries -
+            (Ring->SqLocalTail - __atomic_load_n(Ring->SqHead, __ATOMIC_ACQUIRE));
+    }
+    return Available;
+}
+
+static
+void
+CxPlatUringPrepareRecv(
+    _In_ struct io_uring_sqe* Sqe,
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    Sqe->opcode = IORING_OP_RECVMSG;
+    Sqe->fd = SocketContext->SocketFd;
+    Sqe->addr = (uint64_t)(uintptr_t)&SocketContext->RecvMsgHdr;
+    Sqe->len = 1;
+    Sqe->ioprio = IORING_RECV_MULTISHOT;
+    Sqe->flags = IOSQE_BUFFER_SELECT;
+    Sqe->buf_group = CXPLAT_URING_RECV_BUFFER_GROUP;
+    Sqe->user_data = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_RECV;
+}
+
+//
+// Provided receive buffer ring helpers.
+//
+
+CXPLAT_DATAPATH_RECV_BLOCK*
+CxPlatDataPathGetRecvBlock(
+    _In_ const CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext,
+    _In_ uint16_t BufferId
+    )
+{
+    return (CXPLAT_DATAPATH_RECV_BLOCK*)
+        (ProcContext->RecvBlocks +
+            (size_t)BufferId * ProcContext->Datapath->RecvBlockStride);
+}
+
+uint8_t*
+CxPlatDataPathGetRecvBuffer(
+    _In_ const CXPLAT_DATAPATH* Datapath,
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock
+    )
+{
+    return (uint8_t*)RecvBlock + Datapath->RecvBufferOffset;
+}
+
+//
+// Hands a receive block's buffer to the kernel. The new tail is published by
+// the caller.
+//
+// N.B. Requires the proc context's RecvBufferLock to be held.
+//
+static
+void
+CxPlatDataPathProvideRecvBlock(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext,
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock
+    )
+{
+    struct io_uring_buf* Buf =
+        &ProcContext->RecvBufferRing->bufs[
+            ProcContext->RecvBufferRingTail & (CXPLAT_URING_RECV_BUFFER_COUNT - 1)];
+    Buf->addr = (uint64_t)(uintptr_t)CxPlatDataPathGetRecvBuffer(ProcContext->Datapath, RecvBlock);
+    Buf->len = ProcContext->Datapath->RecvBufferLength;
+    Buf->bid = RecvBlock->BufferId;
+    ProcContext->RecvBufferRingTail++;
+}
+
+//
+// Publishes the buffers added to the ring and releases the RecvBufferLock.
+// Wakes up the proc thread if it is waiting for buffers to re-arm receives.
+//
+static
+void
+CxPlatDataPathRecvBuffersPublish(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    __atomic_store_n(
+        &ProcContext->RecvBufferRing->tail,
+        ProcContext->RecvBufferRingTail,
+        __ATOMIC_SEQ_CST);
+    CxPlatLockRelease(&ProcContext->RecvBufferLock);
+
+    if (__atomic_load_n(&ProcContext->RecvStarved, __ATOMIC_SEQ_CST) &&
+        __atomic_exchange_n(&ProcContext->RecvStarved, FALSE, __ATOMIC_SEQ_CST)) {
+        CxPlatDataPathWake(ProcContext);
+    }
+}
+
+void
+CxPlatDataPathRecvBuffersUninitialize(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    if (ProcContext->RecvBufferRing != NULL) {
+        if (ProcContext->Ring.RingFd != INVALID_SOCKET) {
+            struct io_uring_buf_reg Reg;
+            CxPlatZeroMemory(&Reg, sizeof(Reg));
+            Reg.bgid = CXPLAT_URING_RECV_BUFFER_GROUP;
+            (void)CxPlatUringRegister(ProcContext->Ring.RingFd, IORING_UNREGISTER_PBUF_RING, &Reg, 1);
+        }
+        munmap(ProcContext->RecvBufferRing, ProcContext->RecvBufferRingSize);
+        ProcContext->RecvBufferRing = NULL;
+    }
+    if (ProcContext->RecvBlocks != NULL) {
+        munmap(ProcContext->RecvBlocks, ProcContext->RecvBlocksSize);
+        ProcContext->RecvBlocks = NULL;
+    }
+}
+
+QUIC_STATUS
+CxPlatDataPathRecvBuffersInitialize(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    const CXPLAT_DATAPATH* Datapath = ProcContext->Datapath;
+
+    ProcContext->RecvBufferRingSize =
+        CXPLAT_URING_RECV_BUFFER_COUNT * sizeof(struct io_uring_buf);
+    ProcContext->RecvBufferRing =
+        mmap(
+            NULL,
+            ProcContext->RecvBufferRingSize,
+            PROT_READ | PROT_WRITE,
+            MAP_ANONYMOUS | MAP_PRIVATE,
+            -1,
+            0);
+    if (ProcContext->RecvBufferRing == MAP_FAILED) {
+        ProcContext->RecvBufferRing = NULL;
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "io_uring_buf_ring",
+            ProcContext->RecvBufferRingSize);
+        goto Exit;
+    }
+
+    ProcContext->RecvBlocksSize =
+        (size_t)CXPLAT_URING_RECV_BUFFER_COUNT * Datapath->RecvBlockStride;
+    ProcContext->RecvBlocks =
+        mmap(
+            NULL,
+            ProcContext->RecvBlocksSize,
+            PROT_READ | PROT_WRITE,
+            MAP_ANONYMOUS | MAP_PRIVATE,
+            -1,
+            0);
+    if (ProcContext->RecvBlocks == MAP_FAILED) {
+        ProcContext->RecvBlocks = NULL;
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_DATAPATH_RECV_BLOCK",
+            ProcContext->RecvBlocksSize);
+        goto Exit;
+    }
+
+    struct io_uring_buf_reg Reg;
+    CxPlatZeroMemory(&Reg, sizeof(Reg));
+    Reg.ring_addr = (uint64_t)(uintptr_t)ProcContext->RecvBufferRing;
+    Reg.ring_entries = CXPLAT_URING_RECV_BUFFER_COUNT;
+    Reg.bgid = CXPLAT_URING_RECV_BUFFER_GROUP;
+    if (CxPlatUringRegister(ProcContext->Ring.RingFd, IORING_REGISTER_PBUF_RING, &Reg, 1) < 0) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring_register(IORING_REGISTER_PBUF_RING) failed");
+        munmap(ProcContext->RecvBufferRing, ProcContext->RecvBufferRingSize);
+        ProcContext->RecvBufferRing = NULL;
+        goto Exit;
+    }
+
+    ProcContext->RecvBufferRingTail = 0;
+    for (uint32_t i = 0; i < CXPLAT_URING_RECV_BUFFER_COUNT; i++) {
+        CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
+            CxPlatDataPathGetRecvBlock(ProcContext, (uint16_t)i);
+        RecvBlock->ProcContext = ProcContext;
+        RecvBlock->BufferId = (uint16_t)i;
+        CxPlatDataPathProvideRecvBlock(ProcContext, RecvBlock);
+    }
+    __atomic_store_n(
+        &ProcContext->RecvBufferRing->tail,
+        ProcContext->RecvBufferRingTail,
+        __ATOMIC_RELEASE);
+
+Exit:
+
+    if (QUIC_FAILED(Status)) {
+        CxPlatDataPathRecvBuffersUninitialize(ProcContext);
+    }
+
+    return Status;
+}
+
+//
+// Queues a read on the proc context's event FD so that CxPlatDataPathWake can
+// interrupt the worker thread waiting on the ring.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+static
+BOOLEAN
+CxPlatProcessorContextArmWake(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    struct io_uring_sqe* Sqe = CxPlatUringGetSqeOrFlush(&ProcContext->Ring);
+    if (Sqe == NULL) {
+        return FALSE;
+    }
+    Sqe->opcode = IORING_OP_READ;
+    Sqe->fd = ProcContext->EventFd;
+    Sqe->addr = (uint64_t)(uintptr_t)&ProcContext->EventFdValue;
+    Sqe->len = sizeof(ProcContext->EventFdValue);
+    Sqe->user_data = (uint64_t)(uintptr_t)ProcContext | CXPLAT_URING_OP_WAKE;
+    return TRUE;
+}
+
+void
+CxPlatProcessorContextUninitialize(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    const eventfd_t Value = 1;
+    eventfd_write(ProcContext->EventFd, Value);
+    CxPlatEventWaitForever(ProcContext->CompletionEvent);
+    CxPlatEventUninitialize(ProcContext->CompletionEvent);
+
+    CxPlatDataPathRecvBuffersUninitialize(ProcContext);
+    CxPlatUringUninitialize(&ProcContext->Ring);
+    close(ProcContext->EventFd);
+
+    CxPlatLockUninitialize(&ProcContext->SubmitLock);
+    CxPlatLockUninitialize(&ProcContext->RecvBufferLock);
+    CxPlatPoolUninitialize(&ProcContext->LargeSendBufferPool);
+    CxPlatPoolUninitialize(&ProcContext->SendBufferPool);
+    CxPlatPoolUninitialize(&ProcContext->SendDataPool);
+}
+
+QUIC_STATUS
+CxPlatProcessorContextInitialize(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint32_t Index,
+    _Out_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    int EventFd = INVALID_SOCKET;
+
+    CXPLAT_DBG_ASSERT(Datapath != NULL);
+
+    ProcContext->Datapath = Datapath;
+    ProcContext->Index = Index;
+    ProcContext->Ring.RingFd = INVALID_SOCKET;
+    CxPlatLockInitialize(&ProcContext->SubmitLock);
+    CxPlatLockInitialize(&ProcContext->RecvBufferLock);
+    CxPlatListInitializeHead(&ProcContext->StarvedSockets);
+    CxPlatPoolInitialize(
+        TRUE,
+        MAX_UDP_PAYLOAD_LENGTH,
+        QUIC_POOL_DATA,
+        &ProcContext->SendBufferPool);
+    CxPlatPoolInitialize(
+        TRUE,
+        CXPLAT_LARGE_SEND_BUFFER_SIZE,
+        QUIC_POOL_DATA,
+        &ProcContext->LargeSendBufferPool);
+    CxPlatPoolInitialize(
+        TRUE,
+        sizeof(CXPLAT_SEND_DATA),
+        QUIC_POOL_PLATFORM_SENDCTX,
+        &ProcContext->SendDataPool);
+
+    Status = CxPlatUringInitialize(Index, &ProcContext->Ring);
+    if (QUIC_FAILED(Status)) {
+        goto Exit;
+    }
+
+    Status = CxPlatDataPathRecvBuffersInitialize(ProcContext);
+    if (QUIC_FAILED(Status)) {
+        goto Exit;
+    }
+
+    EventFd = eventfd(0, EFD_CLOEXEC);
+    if (EventFd == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "eventfd failed");
+        goto Exit;
+    }
+
+    ProcContext->EventFd = EventFd;
+    ProcContext->ThreadId = 0;
+
+    CxPlatLockAcquire(&ProcContext->SubmitLock);
+    if (!CxPlatProcessorContextArmWake(ProcContext)) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+    } else {
+        int Result = CxPlatUringSubmit(&ProcContext->Ring);
+        if (Result < 0) {
+            Status = -Result;
+        }
+    }
+    CxPlatLockRelease(&ProcContext->SubmitLock);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "io_uring_enter(eventfd read) failed");
+        goto Exit;
+    }
+
+    //
+    // Starting the thread must be done after the rest of the ProcContext
+    // members have been initialized. Because the thread start routine accesses
+    // ProcContext members.
+    //
+
+    CxPlatEventInitialize(&ProcContext->CompletionEvent, TRUE, FALSE);
+    CxPlatWorkerRegisterDataPath((uint16_t)Index, ProcContext);
+
+Exit:
+
+    if (QUIC_FAILED(Status)) {
+        CxPlatDataPathRecvBuffersUninitialize(ProcContext);
+        CxPlatUringUninitialize(&ProcContext->Ring);
+        if (EventFd != INVALID_SOCKET) {
+            close(EventFd);
+        }
+        CxPlatLockUninitialize(&ProcContext->SubmitLock);
+        CxPlatLockUninitialize(&ProcContext->RecvBufferLock);
+        CxPlatPoolUninitialize(&ProcContext->LargeSendBufferPool);
+        CxPlatPoolUninitialize(&ProcContext->SendBufferPool);
+        CxPlatPoolUninitialize(&ProcContext->SendDataPool);
+    }
+
+    return Status;
+}
+
+#if defined(UDP_SEGMENT) || defined(SO_TXTIME)
+QUIC_STATUS
+CxPlatDataPathQuerySockoptSupport(
+    _Inout_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    int Result;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    int UdpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (UdpSocket == INVALID_SOCKET) {
+        int SockError = errno;
+        QuicTraceLogWarning(
+            DatapathOpenUdpSocketFailed,
+            "[data] UDP send segmentation helper socket failed to open, 0x%x",
+            SockError);
+        goto Error;
+    }
+
+#ifdef UDP_SEGMENT
+    int SegmentSize;
+    socklen_t OptionLength = sizeof(SegmentSize);
+    Result =
+        getsockopt(
+            UdpSocket,
+            IPPROTO_UDP,
+            UDP_SEGMENT,
+            &SegmentSize,
+            &OptionLength);
+    if (Result != 0) {
+        int SockError = errno;
+        QuicTraceLogWarning(
+            DatapathQueryUdpSegmentFailed,
+            "[data] Query for UDP_SEGMENT failed, 0x%x",
+            SockError);
+    } else {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION;
+    }
+#endif
+
+#ifdef SO_TXTIME
+    struct sock_txtime TxTimeConfig = {
+        .clockid = CLOCK_MONOTONIC,
+        .flags = 0
+    };
+    Result =
+        setsockopt(
+            UdpSocket,
+            SOL_SOCKET,
+            SO_TXTIME,
+            &TxTimeConfig,
+            sizeof(TxTimeConfig));
+    if (Result != 0) {
+        int SockError = errno;
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            SockError,
+            "setsockopt(SO_TXTIME) not supported");
+    } else {
+        Datapath->Features |= CXPLAT_DATAPATH_FEATURE_SEND_TXTIME;
+    }
+#endif
+
+Error:
+    if (UdpSocket != INVALID_SOCKET) {
+        close(UdpSocket);
+    }
+
+    return Status;
+}
+#endif
+
+QUIC_STATUS
+CxPlatDataPathInitialize(
+    _In_ uint32_t ClientRecvContextLength,
+    _In_opt_ const CXPLAT_UDP_DATAPATH_CALLBACKS* UdpCallbacks,
+    _In_opt_ const CXPLAT_TCP_DATAPATH_CALLBACKS* TcpCallbacks,
+    _Out_ CXPLAT_DATAPATH** NewDataPath
+    )
+{
+    UNREFERENCED_PARAMETER(TcpCallbacks);
+    if (NewDataPath == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+    if (UdpCallbacks != NULL) {
+        if (UdpCallbacks->Receive == NULL || UdpCallbacks->Unreachable == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    size_t DatapathLength =
+        sizeof(CXPLAT_DATAPATH) +
+            CxPlatProcMaxCount() * sizeof(CXPLAT_DATAPATH_PROC_CONTEXT);
+
+    CXPLAT_DATAPATH* Datapath = (CXPLAT_DATAPATH*)CXPLAT_ALLOC_PAGED(DatapathLength, QUIC_POOL_DATAPATH);
+    if (Datapath == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_DATAPATH",
+            DatapathLength);
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Exit;
+    }
+
+    CxPlatZeroMemory(Datapath, DatapathLength);
+    if (UdpCallbacks) {
+        Datapath->UdpHandlers = *UdpCallbacks;
+    }
+    Datapath->ClientRecvContextLength = ClientRecvContextLength;
+    Datapath->ProcCount = CxPlatProcMaxCount();
+    Datapath->MaxSendBatchSize = CXPLAT_MAX_BATCH_SEND;
+    Datapath->Features = CXPLAT_DATAPATH_FEATURE_LOCAL_PORT_SHARING;
+    CxPlatRundownInitialize(&Datapath->BindingsRundown);
+
+#if defined(UDP_SEGMENT) || defined(SO_TXTIME)
+    Status = CxPlatDataPathQuerySockoptSupport(Datapath);
+    if (QUIC_FAILED(Status)) {
+        goto Exit;
+    }
+#endif
+
+    //
+    // Each receive block holds the MsQuic receive data and client context,
+    // followed by the buffer lent to the kernel. The kernel writes the
+    // recvmsg header, source address and control data in front of the
+    // payload.
+    //
+    Datapath->RecvBufferOffset =
+        (uint32_t)ALIGN_UP(
+            sizeof(CXPLAT_DATAPATH_RECV_BLOCK) + ClientRecvContextLength,
+            void*);
+    Datapath->RecvBufferLength =
+        (uint32_t)(sizeof(struct io_uring_recvmsg_out) +
+        sizeof(QUIC_ADDR) +
+        sizeof(CXPLAT_RECV_MSG_CONTROL_BUFFER) +
+        MAX_UDP_PAYLOAD_LENGTH);
+    Datapath->RecvBlockStride =
+        (uint32_t)ALIGN_UP(
+            Datapath->RecvBufferOffset + Datapath->RecvBufferLength,
+            void*);
+
+    //
+    // Initialize the per processor contexts.
+    //
+    for (uint32_t i = 0; i < Datapath->ProcCount; i++) {
+        Status = CxPlatProcessorContextInitialize(Datapath, i, &Datapath->ProcContexts[i]);
+        if (QUIC_FAILED(Status)) {
+            Datapath->Shutdown = TRUE;
+            for (uint32_t j = 0; j < i; j++) {
+                CxPlatProcessorContextUninitialize(&Datapath->ProcContexts[j]);
+            }
+            goto Exit;
+        }
+    }
+
+    *NewDataPath = Datapath;
+    Datapath = NULL;
+
+Exit:
+
+    if (Datapath != NULL) {
+        CxPlatRundownUninitialize(&Datapath->BindingsRundown);
+        CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+    }
+
+    return Status;
+}
+
+void
+CxPlatDataPathUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    if (Datapath == NULL) {
+        return;
+    }
+
+    CxPlatRundownReleaseAndWait(&Datapath->BindingsRundown);
+
+    Datapath->Shutdown = TRUE;
+    for (uint32_t i = 0; i < Datapath->ProcCount; i++) {
+        CxPlatProcessorContextUninitialize(&Datapath->ProcContexts[i]);
+    }
+
+    CxPlatRundownUninitialize(&Datapath->BindingsRundown);
+    CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CxPlatDataPathGetSupportedFeatures(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return Datapath->Features;
+}
+
+BOOLEAN
+CxPlatDataPathIsPaddingPreferred(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    return !!(Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION);
+}
+
+void
+CxPlatDataPathPopulateTargetAddress(
+    _In_ QUIC_ADDRESS_FAMILY Family,
+    _In_ ADDRINFO* AddrInfo,
+    _Out_ QUIC_ADDR* Address
+    )
+{
+    struct sockaddr_in6* SockAddrIn6 = NULL;
+    struct sockaddr_in* SockAddrIn = NULL;
+
+    CxPlatZeroMemory(Address, sizeof(QUIC_ADDR));
+
+    if (AddrInfo->ai_addr->sa_family == AF_INET6) {
+        CXPLAT_DBG_ASSERT(sizeof(struct sockaddr_in6) == AddrInfo->ai_addrlen);
+
+        //
+        // Is this a mapped ipv4 one?
+        //
+
+        SockAddrIn6 = (struct sockaddr_in6*)AddrInfo->ai_addr;
+
+        if (Family == QUIC_ADDRESS_FAMILY_UNSPEC && IN6_IS_ADDR_V4MAPPED(&SockAddrIn6->sin6_addr)) {
+            SockAddrIn = &Address->Ipv4;
+
+            //
+            // Get the ipv4 address from the mapped address.
+            //
+
+            SockAddrIn->sin_family = QUIC_ADDRESS_FAMILY_INET;
+            memcpy(&SockAddrIn->sin_addr.s_addr, &SockAddrIn6->sin6_addr.s6_addr[12], 4);
+            SockAddrIn->sin_port = SockAddrIn6->sin6_port;
+
+            return;
+        }
+        Address->Ipv6 = *SockAddrIn6;
+        Address->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
+        return;
+    }
+
+    if (AddrInfo->ai_addr->sa_family == AF_INET) {
+        CXPLAT_DBG_ASSERT(sizeof(struct sockaddr_in) == AddrInfo->ai_addrlen);
+        SockAddrIn = (struct sockaddr_in*)AddrInfo->ai_addr;
+        Address->Ipv4 = *SockAddrIn;
+        Address->Ipv4.sin_family = QUIC_ADDRESS_FAMILY_INET;
+        return;
+    }
+
+    CXPLAT_FRE_ASSERT(FALSE);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Success_(QUIC_SUCCEEDED(return))
+QUIC_STATUS
+CxPlatDataPathGetLocalAddresses(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Outptr_ _At_(*Addresses, __drv_allocatesMem(Mem))
+        CXPLAT_ADAPTER_ADDRESS** Addresses,
+    _Out_ uint32_t* AddressesCount
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    *Addresses = NULL;
+    *AddressesCount = 0;
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+QUIC_STATUS
+CxPlatDataPathGetGatewayAddresses(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Outptr_ _At_(*GatewayAddresses, __drv_allocatesMem(Mem))
+        QUIC_ADDR** GatewayAddresses,
+    _Out_ uint32_t* GatewayAddressesCount
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    *GatewayAddresses = NULL;
+    *GatewayAddressesCount = 0;
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+QUIC_STATUS
+CxPlatDataPathResolveAddress(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_z_ const char* HostName,
+    _Inout_ QUIC_ADDR* Address
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    ADDRINFO Hints = {0};
+    ADDRINFO* AddrInfo = NULL;
+    int Result = 0;
+
+    //
+    // Prepopulate hint with input family. It might be unspecified.
+    //
+    Hints.ai_family = Address->Ip.sa_family;
+    if (Hints.ai_family == QUIC_ADDRESS_FAMILY_INET6) {
+        Hints.ai_family = AF_INET6;
+    }
+
+    //
+    // Try numeric name first.
+    //
+    Hints.ai_flags = AI_NUMERICHOST;
+    Result = getaddrinfo(HostName, NULL, &Hints, &AddrInfo);
+    if (Result == 0) {
+        CxPlatDataPathPopulateTargetAddress(Hints.ai_family, AddrInfo, Address);
+        freeaddrinfo(AddrInfo);
+        AddrInfo = NULL;
+        goto Exit;
+    }
+
+    //
+    // Try canonical host name.
+    //
+    Hints.ai_flags = AI_CANONNAME;
+    Result = getaddrinfo(HostName, NULL, &Hints, &AddrInfo);
+    if (Result == 0) {
+        CxPlatDataPathPopulateTargetAddress(Hints.ai_family, AddrInfo, Address);
+        freeaddrinfo(AddrInfo);
+        AddrInfo = NULL;
+        goto Exit;
+    }
+
+    QuicTraceEvent(
+        LibraryErrorStatus,
+        "[ lib] ERROR, %u, %s.",
+        (uint32_t)Result,
+        "Resolving hostname to IP");
+    QuicTraceLogError(
+        DatapathResolveHostNameFailed,
+        "[%p] Couldn't resolve hostname '%s' to an IP address",
+        Datapath,
+        HostName);
+    Status = (QUIC_STATUS)Result;
+
+Exit:
+
+    return Status;
+}
+
+QUIC_STATUS
+CxPlatSocketConfigureRss(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ uint32_t SocketCount
+    )
+{
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    int Result = 0;
+
+    struct sock_filter BpfCode[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, SKF_AD_OFF | SKF_AD_CPU},
+        {BPF_ALU | BPF_MOD, 0, 0, SocketCount},
+        {BPF_RET | BPF_A, 0, 0, 0}
+    };
+
+    struct sock_fprog BpfConfig = {
+        .len = ARRAYSIZE(BpfCode),
+        .filter = BpfCode
+    };
+
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            SOL_SOCKET,
+            SO_ATTACH_REUSEPORT_CBPF,
+            (const void*)&BpfConfig,
+            sizeof(BpfConfig));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            SocketContext->Binding,
+            Status,
+            "setsockopt(SO_ATTACH_REUSEPORT_CBPF) failed");
+    }
+
+    return Status;
+#else
+    UNREFERENCED_PARAMETER(SocketContext);
+    UNREFERENCED_PARAMETER(SocketCount);
+    return QUIC_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+//
+// Socket context interface. It abstracts a (generally per-processor) UDP socket
+// and the corresponding logic/functionality like send and receive processing.
+//
+
+QUIC_STATUS
+CxPlatSocketContextInitialize(
+    _Inout_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ BOOLEAN ForceShare
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    int Result = 0;
+    int Option = 0;
+    QUIC_ADDR MappedAddress = {0};
+    socklen_t AssignedLocalAddressLength = 0;
+
+    CXPLAT_SOCKET* Binding = SocketContext->Binding;
+
+    //
+    // Create datagram socket. The socket is left blocking: io_uring polls for
+    // readiness itself, but would fail requests on a non-blocking socket.
+    //
+    SocketContext->SocketFd =
+        socket(
+            AF_INET6,
+            SOCK_DGRAM | SOCK_CLOEXEC, // TODO check if SOCK_CLOEXEC is required?
+            IPPROTO_UDP);
+    if (SocketContext->SocketFd == INVALID_SOCKET) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "socket failed");
+        goto Exit;
+    }
+
+    //
+    // Set dual (IPv4 & IPv6) socket mode.
+    //
+    Option = FALSE;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IPV6,
+            IPV6_V6ONLY,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IPV6_V6ONLY) failed");
+        goto Exit;
+    }
+
+    //
+    // Set DON'T FRAG socket option.
+    //
+
+    //
+    // Windows: setsockopt IPPROTO_IP IP_DONTFRAGMENT TRUE.
+    // Linux: IP_DONTFRAGMENT option is not available. IPV6_MTU_DISCOVER is the
+    // apparent alternative.
+    // TODO: Verify this.
+    //
+    Option = IP_PMTUDISC_DO;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IP,
+            IP_MTU_DISCOVER,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IP_MTU_DISCOVER) failed");
+        goto Exit;
+    }
+
+    Option = TRUE;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IPV6,
+            IPV6_DONTFRAG,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IPV6_DONTFRAG) failed");
+        goto Exit;
+    }
+
+    //
+    // Set socket option to receive ancillary data about the incoming packets.
+    //
+
+    //
+    // Windows: setsockopt IPPROTO_IPV6 IPV6_PKTINFO TRUE.
+    // Android: Returns EINVAL. IPV6_PKTINFO option is not present in documentation.
+    // IPV6_RECVPKTINFO seems like is the alternative.
+    // TODO: Check if this works as expected?
+    //
+    Option = TRUE;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IPV6,
+            IPV6_RECVPKTINFO,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IPV6_RECVPKTINFO) failed");
+        goto Exit;
+    }
+
+    Option = TRUE;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IP,
+            IP_PKTINFO,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IP_PKTINFO) failed");
+        goto Exit;
+    }
+
+    //
+    // Set socket option to receive TOS (= DSCP + ECN) information from the
+    // incoming packet.
+    //
+    Option = TRUE;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IPV6,
+            IPV6_RECVTCLASS,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IPV6_RECVTCLASS) failed");
+        goto Exit;
+    }
+
+    Option = TRUE;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            IPPROTO_IP,
+            IP_RECVTOS,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(IP_RECVTOS) failed");
+        goto Exit;
+    }
+
+    //
+    // The socket is shared by multiple QUIC endpoints, so increase the receive
+    // buffer size.
+    //
+    Option = INT32_MAX;
+    Result =
+        setsockopt(
+            SocketContext->SocketFd,
+            SOL_SOCKET,
+            SO_RCVBUF,
+            (const void*)&Option,
+            sizeof(Option));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "setsockopt(SO_RCVBUF) failed");
+        goto Exit;
+    }
+
+#ifdef SO_TXTIME
+    if (Binding->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_TXTIME) {
+        //
+        // Departure times are in CLOCK_MONOTONIC, the same clock as
+        // CxPlatTimeUs64, which is what the fq qdisc expects.
+        //
+        struct sock_txtime TxTimeConfig = {
+            .clockid = CLOCK_MONOTONIC,
+            .flags = 0
+        };
+        Result =
+            setsockopt(
+                SocketContext->SocketFd,
+                SOL_SOCKET,
+                SO_TXTIME,
+                (const void*)&TxTimeConfig,
+                sizeof(TxTimeConfig));
+        if (Result == SOCKET_ERROR) {
+            Status = errno;
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                Status,
+                "setsockopt(SO_TXTIME) failed");
+            goto Exit;
+        }
+    }
+#endif
+
+    //
+    // Only set SO_REUSEPORT on a server socket, otherwise the client could be
+    // assigned a server port (unless it's forcing sharing).
+    //
+    if (ForceShare || RemoteAddress == NULL) {
+        //
+        // The port is shared across processors.
+        //
+        Option = TRUE;
+        Result =
+            setsockopt(
+                SocketContext->SocketFd,
+                SOL_SOCKET,
+                SO_REUSEPORT,
+                (const void*)&Option,
+                sizeof(Option));
+        if (Result == SOCKET_ERROR) {
+            Status = errno;
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                Status,
+                "setsockopt(SO_REUSEPORT) failed");
+            goto Exit;
+        }
+    }
+
+    CxPlatCopyMemory(&MappedAddress, &Binding->LocalAddress, sizeof(MappedAddress));
+    if (MappedAddress.Ipv6.sin6_family == QUIC_ADDRESS_FAMILY_INET6) {
+        MappedAddress.Ipv6.sin6_family = AF_INET6;
+    }
+
+    Result =
+        bind(
+            SocketContext->SocketFd,
+            &MappedAddress.Ip,
+            sizeof(MappedAddress));
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "bind failed");
+        goto Exit;
+    }
+
+    if (RemoteAddress != NULL) {
+        CxPlatZeroMemory(&MappedAddress, sizeof(MappedAddress));
+        CxPlatConvertToMappedV6(RemoteAddress, &MappedAddress);
+
+        if (MappedAddress.Ipv6.sin6_family == QUIC_ADDRESS_FAMILY_INET6) {
+            MappedAddress.Ipv6.sin6_family = AF_INET6;
+        }
+
+        Result =
+            connect(
+                SocketContext->SocketFd,
+                &MappedAddress.Ip,
+                sizeof(MappedAddress));
+
+        if (Result == SOCKET_ERROR) {
+            Status = errno;
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                Binding,
+                Status,
+                "connect failed");
+            goto Exit;
+        }
+        Binding->Connected = TRUE;
+    }
+
+    //
+    // If no specific local port was indicated, then the stack just
+    // assigned this socket a port. We need to query it and use it for
+    // all the other sockets we are going to create.
+    //
+    AssignedLocalAddressLength = sizeof(Binding->LocalAddress);
+    Result =
+        getsockname(
+            SocketContext->SocketFd,
+            (struct sockaddr *)&Binding->LocalAddress,
+            &AssignedLocalAddressLength);
+    if (Result == SOCKET_ERROR) {
+        Status = errno;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Binding,
+            Status,
+            "getsockname failed");
+        goto Exit;
+    }
+
+#if DEBUG
+    if (LocalAddress && LocalAddress->Ipv4.sin_port != 0) {
+        CXPLAT_DBG_ASSERT(LocalAddress->Ipv4.sin_port == Binding->LocalAddress.Ipv4.sin_port);
+    } else if (RemoteAddress && LocalAddress && LocalAddress->Ipv4.sin_port == 0) {
+        //
+        // A client socket being assigned the same port as a remote socket causes issues later
+        // in the datapath and binding paths. Check to make sure this case was not given to us.
+        //
+        CXPLAT_DBG_ASSERT(Binding->LocalAddress.Ipv4.sin_port != RemoteAddress->Ipv4.sin_port);
+    }
+#else
+    UNREFERENCED_PARAMETER(LocalAddress);
+#endif
+
+    if (Binding->LocalAddress.Ipv6.sin6_family == AF_INET6) {
+        Binding->LocalAddress.Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
+    }
+
+Exit:
+
+    if (QUIC_FAILED(Status)) {
+        close(SocketContext->SocketFd);
+        SocketContext->SocketFd = INVALID_SOCKET;
+    }
+
+    return Status;
+}
+
+void
+CxPlatSocketRelease(
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    if (InterlockedDecrement(&Socket->RefCount) == 0) {
+        CXPLAT_DATAPATH* Datapath = Socket->Datapath;
+        CxPlatRundownUninitialize(&Socket->Rundown);
+        CXPLAT_FREE(Socket, QUIC_POOL_SOCKET);
+        CxPlatRundownRelease(&Datapath->BindingsRundown);
+    }
+}
+
+//
+// Called once the last outstanding I/O of a socket context has completed.
+//
+void
+CxPlatSocketContextUninitializeComplete(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = SocketContext->ProcContext;
+    CXPLAT_SOCKET* Binding = SocketContext->Binding;
+
+    CxPlatLockAcquire(&ProcContext->SubmitLock);
+    if (SocketContext->RecvStarved) {
+        CxPlatListEntryRemove(&SocketContext->StarvedLinkage);
+        SocketContext->RecvStarved = FALSE;
+    }
+    CxPlatLockRelease(&ProcContext->SubmitLock);
+
+    if (SocketContext->SocketFd != INVALID_SOCKET) {
+        close(SocketContext->SocketFd);
+        SocketContext->SocketFd = INVALID_SOCKET;
+    }
+
+    if (!SocketContext->RundownReleased) {
+        SocketContext->RundownReleased = TRUE;
+        CxPlatRundownRelease(&Binding->Rundown);
+    }
+
+    CxPlatSocketRelease(Binding);
+}
+
+void
+CxPlatSocketContextRelease(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    if (InterlockedDecrement(&SocketContext->IoCount) == 0) {
+        CxPlatSocketContextUninitializeComplete(SocketContext);
+    }
+}
+
+void
+CxPlatSocketContextUninitialize(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = SocketContext->ProcContext;
+
+    //
+    // Cancel the multishot receive. The cancel completion releases the socket
+    // context's initial reference, so the socket context is always cleaned up
+    // on its own processor's thread once the kernel is done with it.
+    //
+    CxPlatLockAcquire(&ProcContext->SubmitLock);
+    SocketContext->Uninitialized = TRUE;
+    struct io_uring_sqe* Sqe = CxPlatUringGetSqeBlocking(&ProcContext->Ring);
+    Sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    Sqe->fd = -1;
+    Sqe->addr = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_RECV;
+    Sqe->user_data = (uint64_t)(uintptr_t)SocketContext | CXPLAT_URING_OP_CANCEL;
+    (void)CxPlatUringSubmit(&ProcContext->Ring);
+    CxPlatLockRelease(&ProcContext->SubmitLock);
+
+    if (CxPlatCurThreadID() == ProcContext->ThreadId) {
+        //
+        // The caller is this socket context's worker thread, so waiting for
+        // the cancel to complete would deadlock. No more upcalls can happen
+        // in parallel, and the binding memory is kept alive until the socket
+        // context drains.
+        //
+        SocketContext->RundownReleased = TRUE;
+        CxPlatRundownRelease(&SocketContext->Binding->Rundown);
+    }
+}
+
+//
+// Queues the socket context's receive to be (re-)armed by its processor's
+// thread, so that receive completions are delivered in that thread's context.
+//
+// N.B. Requires the proc context's SubmitLock to be held.
+//
+void
+CxPlatSocketContextQueueReceive(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    if (!SocketContext->RecvStarved && !SocketContext->Uninitialized) {
+        SocketContext->RecvStarved = TRUE;
+        CxPlatListInsertTail(
+            &SocketContext->ProcContext->StarvedSockets,
+            &SocketContext->StarvedLinkage);
+    }
+}
+
+void
+CxPlatSocketContextStartReceive(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = SocketContext->ProcContext;
+
+    CxPlatZeroMemory(&SocketContext->RecvMsgHdr, sizeof(SocketContext->RecvMsgHdr));
+    SocketContext->RecvMsgHdr.msg_namelen = sizeof(QUIC_ADDR);
+    SocketContext->RecvMsgHdr.msg_controllen = sizeof(CXPLAT_RECV_MSG_CONTROL_BUFFER);
+
+    CxPlatLockAcquire(&ProcContext->SubmitLock);
+    CxPlatSocketContextQueueReceive(SocketContext);
+    CxPlatLockRelease(&ProcContext->SubmitLock);
+
+    CxPlatDataPathWake(ProcContext);
+}
+
+//
+// Returns the number of receive buffers currently available to the kernel,
+// as far as the proc thread knows.
+//
+static
+uint16_t
+CxPlatDataPathRecvBuffersAvailable(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    return (uint16_t)(
+        __atomic_load_n(&ProcContext->RecvBufferRing->tail, __ATOMIC_ACQUIRE) -
+        ProcContext->RecvBuffersConsumed);
+}
+
+//
+// Arms the multishot receive of all queued socket contexts, once the kernel
+// has buffers to receive into.
+//
+void
+CxPlatDataPathArmReceives(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    if (CxPlatListIsEmpty(&ProcContext->StarvedSockets)) {
+        return;
+    }
+
+    //
+    // Flag the starvation before checking for buffers, so that a concurrent
+    // CxPlatRecvDataReturn either makes its buffers visible here or sees the
+    // flag and wakes this thread up.
+    //
+    __atomic_store_n(&ProcContext->RecvStarved, TRUE, __ATOMIC_SEQ_CST);
+    if (CxPlatDataPathRecvBuffersAvailable(ProcContext) == 0) {
+        return;
+    }
+    ProcContext->RecvStarved = FALSE;
+
+    CxPlatLockAcquire(&ProcContext->SubmitLock);
+    while (!CxPlatListIsEmpty(&ProcContext->StarvedSockets)) {
+        CXPLAT_SOCKET_CONTEXT* SocketContext =
+            CXPLAT_CONTAINING_RECORD(
+                ProcContext->StarvedSockets.Flink,
+                CXPLAT_SOCKET_CONTEXT,
+                StarvedLinkage);
+        if (!SocketContext->Uninitialized) {
+            struct io_uring_sqe* Sqe = CxPlatUringGetSqeOrFlush(&ProcContext->Ring);
+            if (Sqe == NULL) {
+                break;
+            }
+            InterlockedIncrement(&SocketContext->IoCount);
+            CxPlatUringPrepareRecv(Sqe, SocketContext);
+        }
+        CxPlatListRemoveHead(&ProcContext->StarvedSockets);
+        SocketContext->RecvStarved = FALSE;
+    }
+    int Result = CxPlatUringSubmit(&ProcContext->Ring);
+    CxPlatLockRelease(&ProcContext->SubmitLock);
+
+    if (Result < 0) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            -Result,
+            "io_uring_enter(recvmsg) failed");
+    }
+}
+
+//
+// Indicates a chain of received datagrams to the binding, or drops them if
+// the binding is being deleted.
+//
+void
+CxPlatSocketContextIndicateReceive(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ CXPLAT_RECV_DATA* DatagramHead
+    )
+{
+    CXPLAT_SOCKET* Binding = SocketContext->Binding;
+
+    if (Binding->Shutdown || SocketContext->Uninitialized) {
+        CxPlatRecvDataReturn(DatagramHead);
+    } else if (!Binding->PcpBinding) {
+        CXPLAT_DBG_ASSERT(Binding->Datapath->UdpHandlers.Receive);
+        Binding->Datapath->UdpHandlers.Receive(
+            Binding,
+            Binding->ClientContext,
+            DatagramHead);
+    } else{
+        CxPlatPcpRecvCallback(
+            Binding,
+            Binding->ClientContext,
+            DatagramHead);
+    }
+}
+
+//
+// Parses a received message out of its provided buffer. Returns NULL if the
+// message must be dropped, in which case the buffer has been returned.
+//
+CXPLAT_RECV_DATA*
+CxPlatSocketContextRecvComplete(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock,
+    _In_ uint32_t BytesTransferred
+    )
+{
+    const CXPLAT_DATAPATH* Datapath = SocketContext->ProcContext->Datapath;
+    uint8_t* Buffer = CxPlatDataPathGetRecvBuffer(Datapath, RecvBlock);
+    struct io_uring_recvmsg_out* RecvOut = (struct io_uring_recvmsg_out*)Buffer;
+
+    if (BytesTransferred < sizeof(*RecvOut) ||
+        RecvOut->namelen > sizeof(QUIC_ADDR) ||
+        RecvOut->controllen > sizeof(CXPLAT_RECV_MSG_CONTROL_BUFFER) ||
+        (RecvOut->flags & MSG_TRUNC) ||
+        RecvOut->payloadlen == 0) {
+        QuicTraceLogWarning(
+            DatapathRecvEmpty,
+            "[data][%p] Dropping datagram with empty payload.",
+            SocketContext->Binding);
+        CxPlatRecvDataReturn(&RecvBlock->RecvData);
+        return NULL;
+    }
+
+    uint8_t* Name = Buffer + sizeof(*RecvOut);
+    uint8_t* Control = Name + sizeof(QUIC_ADDR);
+    uint8_t* Payload = Control + sizeof(CXPLAT_RECV_MSG_CONTROL_BUFFER);
+
+    CxPlatZeroMemory(&RecvBlock->Route, sizeof(RecvBlock->Route));
+    BOOLEAN FoundLocalAddr = FALSE;
+    BOOLEAN FoundTOS = FALSE;
+    uint8_t TypeOfService = 0;
+    QUIC_ADDR* LocalAddr = &RecvBlock->Route.LocalAddress;
+    QUIC_ADDR* RemoteAddr = &RecvBlock->Route.RemoteAddress;
+    CxPlatCopyMemory(RemoteAddr, Name, RecvOut->namelen);
+    if (RemoteAddr->Ipv6.sin6_family == AF_INET6) {
+        RemoteAddr->Ipv6.sin6_family = QUIC_ADDRESS_FAMILY_INET6;
+    }
+    CxPlatConvertFromMappedV6(RemoteAddr, RemoteAddr);
+
+    struct msghdr Msg;
+    CxPlatZeroMemory(&Msg, sizeof(Msg));
+    Msg.msg_control = Control;
+    Msg.msg_controllen = RecvOut->controllen;
+
+    struct cmsghdr *CMsg;
+    for (CMsg = CMSG_FIRSTHDR(&Msg);
+        CMsg != NULL;
+        CMsg = CMSG_NXTHDR(&Msg, CMsg)) {
+
+        if (CMsg->cmsg_level == IPPROTO_IPV6) {
+            if (CMsg->cmsg_type == IPV6_PKTINFO) {
+                struct in6_pktinfo* PktInfo6 = (struct in6_pktinfo*) CMSG_DATA(CMsg);
+                LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET6;
+                LocalAddr->Ipv6.sin6_addr = PktInfo6->ipi6_addr;
+                LocalAddr->Ipv6.sin6_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
+                CxPlatConvertFromMappedV6(LocalAddr, LocalAddr);
+
+                LocalAddr->Ipv6.sin6_scope_id = PktInfo6->ipi6_ifindex;
+                FoundLocalAddr = TRUE;
+            } else if (CMsg->cmsg_type == IPV6_TCLASS) {
+                TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
+                FoundTOS = TRUE;
+            }
+        } else if (CMsg->cmsg_level == IPPROTO_IP) {
+            if (CMsg->cmsg_type == IP_PKTINFO) {
+                struct in_pktinfo* PktInfo = (struct in_pktinfo*)CMSG_DATA(CMsg);
+                LocalAddr->Ip.sa_family = QUIC_ADDRESS_FAMILY_INET;
+                LocalAddr->Ipv4.sin_addr = PktInfo->ipi_addr;
+                LocalAddr->Ipv4.sin_port = SocketContext->Binding->LocalAddress.Ipv6.sin6_port;
+                LocalAddr->Ipv6.sin6_scope_id = PktInfo->ipi_ifindex;
+                FoundLocalAddr = TRUE;
+            } else if (CMsg->cmsg_type == IP_TOS) {
+                TypeOfService = *(uint8_t *)CMSG_DATA(CMsg);
+                FoundTOS = TRUE;
+            }
+        }
+    }
+
+    CXPLAT_FRE_ASSERT(FoundLocalAddr);
+    CXPLAT_FRE_ASSERT(FoundTOS);
+
+    QuicTraceEvent(
+        DatapathRecv,
+        "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+        SocketContext->Binding,
+        RecvOut->payloadlen,
+        (uint16_t)RecvOut->payloadlen,
+        CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddr), LocalAddr),
+        CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddr), RemoteAddr));
+
+    CXPLAT_RECV_DATA* Datagram = &RecvBlock->RecvData;
+    CxPlatZeroMemory(Datagram, sizeof(*Datagram));
+    Datagram->Buffer = Payload;
+    Datagram->BufferLength = (uint16_t)RecvOut->payloadlen;
+    Datagram->Route = &RecvBlock->Route;
+    Datagram->PartitionIndex = SocketContext->ProcContext->Index;
+    Datagram->TypeOfService = TypeOfService;
+    Datagram->Allocated = TRUE;
+
+    return Datagram;
+}
+
+//
+// Datapath binding interface.
+//
+
+QUIC_STATUS
+CxPlatSocketCreateUdp(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ const CXPLAT_UDP_CONFIG* Config,
+    _Out_ CXPLAT_SOCKET** NewBinding
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    BOOLEAN IsServerSocket = Config->RemoteAddress == NULL;
+
+    CXPLAT_DBG_ASSERT(Datapath->UdpHandlers.Receive != NULL || Config->Flags & CXPLAT_SOCKET_FLAG_PCP);
+
+    uint32_t SocketCount = IsServerSocket ? Datapath->ProcCount : 1;
+    uint32_t CurrentProc = CxPlatProcCurrentNumber() % Datapath->ProcCount;
+    CXPLAT_FRE_ASSERT(SocketCount > 0);
+    size_t BindingLength =
+        sizeof(CXPLAT_SOCKET) +
+        SocketCount * sizeof(CXPLAT_SOCKET_CONTEXT);
+
+    CXPLAT_SOCKET* Binding =
+        (CXPLAT_SOCKET*)CXPLAT_ALLOC_PAGED(BindingLength, QUIC_POOL_SOCKET);
+    if (Binding == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_SOCKET",
+            BindingLength);
+        goto Exit;
+    }
+
+    QuicTraceEvent(
+        DatapathCreated,
+        "[data][%p] Created, local=%!ADDR!, remote=%!ADDR!",
+        Binding,
+        CASTED_CLOG_BYTEARRAY(Config->LocalAddress ? sizeof(*Config->LocalAddress) : 0, Config->LocalAddress),
+        CASTED_CLOG_BYTEARRAY(Config->RemoteAddress ? sizeof(*Config->RemoteAddress) : 0, Config->RemoteAddress));
+
+    CxPlatZeroMemory(Binding, BindingLength);
+    Binding->Datapath = Datapath;
+    Binding->ClientContext = Config->CallbackContext;
+    Binding->HasFixedRemoteAddress = (Config->RemoteAddress != NULL);
+    Binding->Mtu = CXPLAT_MAX_MTU;
+    Binding->RefCount = 1;
+    CxPlatRundownInitialize(&Binding->Rundown);
+    if (Config->LocalAddress) {
+        CxPlatConvertToMappedV6(Config->LocalAddress, &Binding->LocalAddress);
+    } else {
+        Binding->LocalAddress.Ip.sa_family = QUIC_ADDRESS_FAMILY_INET6;
+    }
+    for (uint32_t i = 0; i < SocketCount; i++) {
+        Binding->SocketContexts[i].Binding = Binding;
+        Binding->SocketContexts[i].SocketFd = INVALID_SOCKET;
+        Binding->SocketContexts[i].ProcContext = &Datapath->ProcContexts[IsServerSocket ? i : CurrentProc];
+        Binding->SocketContexts[i].IoCount = 1;
+        CxPlatRundownAcquire(&Binding->Rundown);
+        InterlockedIncrement(&Binding->RefCount);
+    }
+
+    CxPlatRundownAcquire(&Datapath->BindingsRundown);
+    if (Config->Flags & CXPLAT_SOCKET_FLAG_PCP) {
+        Binding->PcpBinding = TRUE;
+    }
+
+    for (uint32_t i = 0; i < SocketCount; i++) {
+        Status =
+            CxPlatSocketContextInitialize(
+                &Binding->SocketContexts[i],
+                Config->LocalAddress,
+                Config->RemoteAddress,
+                Config->Flags & CXPLAT_SOCKET_FLAG_SHARE);
+        if (QUIC_FAILED(Status)) {
+            goto Exit;
+        }
+    }
+
+    if (IsServerSocket) {
+        //
+        // The return value is being ignored here, as if a system does not support
+        // bpf we still want the server to work. If this happens, the sockets will
+        // round robin, but each flow will be sent to the same socket, just not
+        // based on RSS.
+        //
+        (void)CxPlatSocketConfigureRss(&Binding->SocketContexts[0], SocketCount);
+    }
+
+    CxPlatConvertFromMappedV6(&Binding->LocalAddress, &Binding->LocalAddress);
+    Binding->LocalAddress.Ipv6.sin6_scope_id = 0;
+
+    if (Config->RemoteAddress != NULL) {
+        Binding->RemoteAddress = *Config->RemoteAddress;
+    } else {
+        Binding->RemoteAddress.Ipv4.sin_port = 0;
+    }
+
+    //
+    // Must set output pointer before starting receive path, as the receive path
+    // will try to use the output.
+    //
+    *NewBinding = Binding;
+
+    for (uint32_t i = 0; i < SocketCount; i++) {
+        CxPlatSocketContextStartReceive(&Binding->SocketContexts[i]);
+    }
+
+Exit:
+
+    if (QUIC_FAILED(Status)) {
+        if (Binding != NULL) {
+            QuicTraceEvent(
+                DatapathDestroyed,
+                "[data][%p] Destroyed",
+                Binding);
+
+            //
+            // No receives were started, so there is no outstanding I/O on any
+            // socket context yet.
+            //
+            for (uint32_t i = 0; i < SocketCount; i++) {
+                CxPlatSocketContextUninitializeComplete(&Binding->SocketContexts[i]);
+            }
+            CxPlatRundownReleaseAndWait(&Binding->Rundown);
+            CxPlatSocketRelease(Binding);
+            Binding = NULL;
+        }
+    }
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketCreateTcp(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_opt_ void* CallbackContext,
+    _Out_ CXPLAT_SOCKET** Socket
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(RemoteAddress);
+    UNREFERENCED_PARAMETER(CallbackContext);
+    UNREFERENCED_PARAMETER(Socket);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketCreateTcpListener(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_opt_ void* CallbackContext,
+    _Out_ CXPLAT_SOCKET** Socket
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(CallbackContext);
+    UNREFERENCED_PARAMETER(Socket);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+void
+CxPlatSocketDelete(
+    _Inout_ CXPLAT_SOCKET* Socket
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    QuicTraceEvent(
+        DatapathDestroyed,
+        "[data][%p] Destroyed",
+        Socket);
+
+    //
+    // The function is called by the upper layer when it is completely done
+    // with the UDP binding. It expects that after this call returns there will
+    // be no additional upcalls related to this binding, and all outstanding
+    // upcalls on different threads will be completed.
+    //
+
+    Socket->Shutdown = TRUE;
+    uint32_t SocketCount = Socket->HasFixedRemoteAddress ? 1 : Socket->Datapath->ProcCount;
+    for (uint32_t i = 0; i < SocketCount; ++i) {
+        CxPlatSocketContextUninitialize(&Socket->SocketContexts[i]);
+    }
+
+    CxPlatRundownReleaseAndWait(&Socket->Rundown);
+    CxPlatSocketRelease(Socket);
+}
+
+void
+CxPlatSocketGetLocalAddress(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ QUIC_ADDR* Address
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    *Address = Socket->LocalAddress;
+}
+
+void
+CxPlatSocketGetRemoteAddress(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ QUIC_ADDR* Address
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    *Address = Socket->RemoteAddress;
+}
+
+QUIC_STATUS
+CxPlatSocketSetParam(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint32_t Param,
+    _In_ uint32_t BufferLength,
+    _In_reads_bytes_(BufferLength) const uint8_t * Buffer
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Param);
+    UNREFERENCED_PARAMETER(BufferLength);
+    UNREFERENCED_PARAMETER(Buffer);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+QUIC_STATUS
+CxPlatSocketGetParam(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint32_t Param,
+    _Inout_ uint32_t* BufferLength,
+    _Out_writes_bytes_opt_(*BufferLength) uint8_t * Buffer
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Param);
+    UNREFERENCED_PARAMETER(BufferLength);
+    UNREFERENCED_PARAMETER(Buffer);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+CXPLAT_RECV_DATA*
+CxPlatDataPathRecvPacketToRecvData(
+    _In_ const CXPLAT_RECV_PACKET* const Packet
+    )
+{
+    return (CXPLAT_RECV_DATA*)
+        (((uint8_t*)Packet) -
+            sizeof(CXPLAT_DATAPATH_RECV_BLOCK) +
+            offsetof(CXPLAT_DATAPATH_RECV_BLOCK, RecvData));
+}
+
+CXPLAT_RECV_PACKET*
+CxPlatDataPathRecvDataToRecvPacket(
+    _In_ const CXPLAT_RECV_DATA* const RecvData
+    )
+{
+    return (CXPLAT_RECV_PACKET*)
+        (((uint8_t*)RecvData) -
+            offsetof(CXPLAT_DATAPATH_RECV_BLOCK, RecvData) +
+            sizeof(CXPLAT_DATAPATH_RECV_BLOCK));
+}
+
+void
+CxPlatRecvDataReturn(
+    _In_opt_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = NULL;
+    CXPLAT_RECV_DATA* Datagram;
+
+    //
+    // Hand the buffers back to the kernel, batching consecutive buffers that
+    // belong to the same processor under a single lock acquisition.
+    //
+    while ((Datagram = RecvDataChain) != NULL) {
+        RecvDataChain = RecvDataChain->Next;
+        Datagram->Allocated = FALSE;
+        CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
+            CXPLAT_CONTAINING_RECORD(Datagram, CXPLAT_DATAPATH_RECV_BLOCK, RecvData);
+        if (RecvBlock->ProcContext != ProcContext) {
+            if (ProcContext != NULL) {
+                CxPlatDataPathRecvBuffersPublish(ProcContext);
+            }
+            ProcContext = RecvBlock->ProcContext;
+            CxPlatLockAcquire(&ProcContext->RecvBufferLock);
+        }
+        CxPlatDataPathProvideRecvBlock(ProcContext, RecvBlock);
+    }
+
+    if (ProcContext != NULL) {
+        CxPlatDataPathRecvBuffersPublish(ProcContext);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+CXPLAT_SEND_DATA*
+CxPlatSendDataAlloc(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ CXPLAT_ECN_TYPE ECN,
+    _In_ uint16_t MaxPacketSize,
+    _Inout_ CXPLAT_ROUTE* Route
+    )
+{
+    UNREFERENCED_PARAMETER(Route);
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+
+    CXPLAT_DATAPATH_PROC_CONTEXT* DatapathProc =
+        &Socket->Datapath->ProcContexts[CxPlatProcCurrentNumber() % Socket->Datapath->ProcCount];
+
+    CXPLAT_SEND_DATA* SendData =
+        CxPlatPoolAlloc(&DatapathProc->SendDataPool);
+
+    if (SendData == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_SEND_DATA",
+            0);
+        goto Exit;
+    }
+
+    CxPlatZeroMemory(SendData, sizeof(*SendData));
+
+    SendData->Owner = DatapathProc;
+    SendData->ECN = ECN;
+    SendData->SegmentSize =
+        (Socket->Datapath->Features & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION)
+            ? MaxPacketSize : 0;
+
+Exit:
+    return SendData;
+}
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT* DatapathProc = SendData->Owner;
+    CXPLAT_POOL* BufferPool =
+        SendData->SegmentSize > 0 ?
+            &DatapathProc->LargeSendBufferPool : &DatapathProc->SendBufferPool;
+
+    for (size_t i = 0; i < SendData->BufferCount; ++i) {
+        CxPlatPoolFree(BufferPool, SendData->Buffers[i].Buffer);
+    }
+
+    CxPlatPoolFree(&DatapathProc->SendDataPool, SendData);
+}
+
+static
+BOOLEAN
+CxPlatSendDataCanAllocSendSegment(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    if (!SendData->ClientBuffer.Buffer) {
+        return FALSE;
+    }
+
+    CXPLAT_DBG_ASSERT(SendData->SegmentSize > 0);
+    CXPLAT_DBG_ASSERT(SendData->BufferCount > 0);
+
+    uint64_t BytesAvailable =
+        CXPLAT_LARGE_SEND_BUFFER_SIZE -
+            SendData->Buffers[SendData->BufferCount - 1].Length -
+            SendData->ClientBuffer.Length;
+
+    return MaxBufferLength <= BytesAvailable;
+}
+
+static
+BOOLEAN
+CxPlatSendDataCanAllocSend(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    return
+        (SendData->BufferCount < SendData->Owner->Datapath->MaxSendBatchSize) ||
+        ((SendData->SegmentSize > 0) &&
+            CxPlatSendDataCanAllocSendSegment(SendData, MaxBufferLength));
+}
+
+static
+void
+CxPlatSendDataFinalizeSendBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    if (SendData->ClientBuffer.Length == 0) {
+        //
+        // There is no buffer segment outstanding at the client.
+        //
+        if (SendData->BufferCount > 0) {
+            CXPLAT_DBG_ASSERT(SendData->Buffers[SendData->BufferCount - 1].Length < UINT16_MAX);
+            SendData->TotalSize +=
+                SendData->Buffers[SendData->BufferCount - 1].Length;
+        }
+        return;
+    }
+
+    CXPLAT_DBG_ASSERT(SendData->SegmentSize > 0 && SendData->BufferCount > 0);
+    CXPLAT_DBG_ASSERT(SendData->ClientBuffer.Length > 0 && SendData->ClientBuffer.Length <= SendData->SegmentSize);
+    CXPLAT_DBG_ASSERT(CxPlatSendDataCanAllocSendSegment(SendData, 0));
+
+    //
+    // Append the client's buffer segment to our internal send buffer.
+    //
+    SendData->Buffers[SendData->BufferCount - 1].Length +=
+        SendData->ClientBuffer.Length;
+    SendData->TotalSize += SendData->ClientBuffer.Length;
+
+    if (SendData->ClientBuffer.Length == SendData->SegmentSize) {
+        SendData->ClientBuffer.Buffer += SendData->SegmentSize;
+        SendData->ClientBuffer.Length = 0;
+    } else {
+        //
+        // The next segment allocation must create a new backing buffer.
+        //
+        SendData->ClientBuffer.Buffer = NULL;
+        SendData->ClientBuffer.Length = 0;
+    }
+}
+
+_Success_(return != NULL)
+static
+QUIC_BUFFER*
+CxPlatSendDataAllocDataBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ CXPLAT_POOL* BufferPool
+    )
+{
+    CXPLAT_DBG_ASSERT(SendData->BufferCount < SendData->Owner->Datapath->MaxSendBatchSize);
+
+    QUIC_BUFFER* Buffer = &SendData->Buffers[SendData->BufferCount];
+    Buffer->Buffer = CxPlatPoolAlloc(BufferPool);
+    if (Buffer->Buffer == NULL) {
+        return NULL;
+    }
+    ++SendData->BufferCount;
+
+    return Buffer;
+}
+
+_Success_(return != NULL)
+static
+QUIC_BUFFER*
+CxPlatSendDataAllocPacketBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    QUIC_BUFFER* Buffer =
+        CxPlatSendDataAllocDataBuffer(SendData, &SendData->Owner->SendBufferPool);
+    if (Buffer != NULL) {
+        Buffer->Length = MaxBufferLength;
+    }
+    return Buffer;
+}
+
+_Success_(return != NULL)
+static
+QUIC_BUFFER*
+CxPlatSendDataAllocSegmentBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT(SendData->SegmentSize > 0);
+    CXPLAT_DBG_ASSERT(MaxBufferLength <= SendData->SegmentSize);
+
+    if (CxPlatSendDataCanAllocSendSegment(SendData, MaxBufferLength)) {
+
+        //
+        // All clear to return the next segment of our contiguous buffer.
+        //
+        SendData->ClientBuffer.Length = MaxBufferLength;
+        return &SendData->ClientBuffer;
+    }
+
+    QUIC_BUFFER* Buffer = CxPlatSendDataAllocDataBuffer(SendData, &SendData->Owner->LargeSendBufferPool);
+    if (Buffer == NULL) {
+        return NULL;
+    }
+
+    //
+    // Provide a virtual QUIC_BUFFER to the client. Once the client has committed
+    // to a final send size, we'll append it to our internal backing buffer.
+    //
+    Buffer->Length = 0;
+    SendData->ClientBuffer.Buffer = Buffer->Buffer;
+    SendData->ClientBuffer.Length = MaxBufferLength;
+
+    return &SendData->ClientBuffer;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != NULL)
+QUIC_BUFFER*
+CxPlatSendDataAllocBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT(SendData != NULL);
+    CXPLAT_DBG_ASSERT(MaxBufferLength > 0);
+    //CXPLAT_DBG_ASSERT(MaxBufferLength <= CXPLAT_MAX_MTU - CXPLAT_MIN_IPV4_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE);
+
+    CxPlatSendDataFinalizeSendBuffer(SendData);
+
+    if (!CxPlatSendDataCanAllocSend(SendData, MaxBufferLength)) {
+        return NULL;
+    }
+
+    if (SendData->SegmentSize == 0) {
+        return CxPlatSendDataAllocPacketBuffer(SendData, MaxBufferLength);
+    }
+    return CxPlatSendDataAllocSegmentBuffer(SendData, MaxBufferLength);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataFreeBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ QUIC_BUFFER* Buffer
+    )
+{
+    //
+    // This must be the final send buffer; intermediate buffers cannot be freed.
+    //
+    CXPLAT_DATAPATH_PROC_CONTEXT* DatapathProc = SendData->Owner;
+    uint8_t* TailBuffer = SendData->Buffers[SendData->BufferCount - 1].Buffer;
+
+    if (SendData->SegmentSize == 0) {
+        CXPLAT_DBG_ASSERT(Buffer->Buffer == (uint8_t*)TailBuffer);
+
+        CxPlatPoolFree(&DatapathProc->SendBufferPool, Buffer->Buffer);
+        --SendData->BufferCount;
+    } else {
+        TailBuffer += SendData->Buffers[SendData->BufferCount - 1].Length;
+        CXPLAT_DBG_ASSERT(Buffer->Buffer == (uint8_t*)TailBuffer);
+
+        if (SendData->Buffers[SendData->BufferCount - 1].Length == 0) {
+            CxPlatPoolFree(&DatapathProc->LargeSendBufferPool, Buffer->Buffer);
+            --SendData->BufferCount;
+        }
+
+        SendData->ClientBuffer.Buffer = NULL;
+        SendData->ClientBuffer.Length = 0;
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+CxPlatSendDataIsFull(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    return !CxPlatSendDataCanAllocSend(SendData, SendData->SegmentSize);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataSetTxTime(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint64_t TxTimeUs
+    )
+{
+    SendData->TxTime = TxTimeUs;
+}
+
+
+void
+CxPlatSocketContextSendError(
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ QUIC_STATUS Status
+    )
+{
+    QuicTraceEvent(
+        DatapathErrorStatus,
+        "[data][%p] ERROR, %u, %s.",
+        SocketContext->Binding,
+        Status,
+        "sendmsg completion");
+
+    //
+    // Send unreachable notification to MsQuic if any related errors were
+    // received.
+    //
+    if ((Status == ECONNREFUSED ||
+         Status == EHOSTUNREACH ||
+         Status == ENETUNREACH) &&
+        !SocketContext->Binding->PcpBinding &&
+        !SocketContext->Binding->Shutdown) {
+        SocketContext->Binding->Datapath->UdpHandlers.Unreachable(
+            SocketContext->Binding,
+            SocketContext->Binding->ClientContext,
+            &SocketContext->Binding->RemoteAddress);
+    }
+}
+
+//
+// Builds the message header for the send buffer at the given index.
+//
+static
+void
+CxPlatSendDataPrepareMessage(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ size_t Index,
+    _In_ const CXPLAT_SOCKET* Socket,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress
+    )
+{
+    struct cmsghdr *CMsg = NULL;
+    struct in_pktinfo *PktInfo = NULL;
+    struct in6_pktinfo *PktInfo6 = NULL;
+
+    CXPLAT_STATIC_ASSERT(
+        CMSG_SPACE(sizeof(struct in6_pktinfo)) >= CMSG_SPACE(sizeof(struct in_pktinfo)),
+        "sizeof(struct in6_pktinfo) >= sizeof(struct in_pktinfo) failed");
+
+    SendData->Iovs[Index].iov_base = SendData->Buffers[Index].Buffer;
+    SendData->Iovs[Index].iov_len = SendData->Buffers[Index].Length;
+
+    CxPlatZeroMemory(SendData->ControlBuffers[Index], sizeof(SendData->ControlBuffers[Index]));
+    struct msghdr* Mhdr = &SendData->MsgHdrs[Index];
+    Mhdr->msg_name = &SendData->MappedRemoteAddress;
+    Mhdr->msg_namelen = sizeof(SendData->MappedRemoteAddress);
+    Mhdr->msg_iov = &SendData->Iovs[Index];
+    Mhdr->msg_iovlen = 1;
+    Mhdr->msg_control = SendData->ControlBuffers[Index];
+    Mhdr->msg_controllen = CMSG_SPACE(sizeof(int));
+    Mhdr->msg_flags = 0;
+
+    CMsg = CMSG_FIRSTHDR(Mhdr);
+    CMsg->cmsg_level = RemoteAddress->Ip.sa_family == QUIC_ADDRESS_FAMILY_INET ? IPPROTO_IP : IPPROTO_IPV6;
+    CMsg->cmsg_type = RemoteAddress->Ip.sa_family == QUIC_ADDRESS_FAMILY_INET ? IP_TOS : IPV6_TCLASS;
+    CMsg->cmsg_len = CMSG_LEN(sizeof(int));
+    *(int *)CMSG_DATA(CMsg) = SendData->ECN;
+
+    if (!Socket->Connected) {
+        Mhdr->msg_controllen += CMSG_SPACE(sizeof(struct in6_pktinfo));
+        CMsg = CMSG_NXTHDR(Mhdr, CMsg);
+        CXPLAT_DBG_ASSERT(LocalAddress != NULL);
+        CXPLAT_DBG_ASSERT(CMsg != NULL);
+        if (RemoteAddress->Ip.sa_family == QUIC_ADDRESS_FAMILY_INET) {
+            CMsg->cmsg_level = IPPROTO_IP;
+            CMsg->cmsg_type = IP_PKTINFO;
+            CMsg->cmsg_len = CMSG_LEN(sizeof(struct in_pktinfo));
+            PktInfo = (struct in_pktinfo*) CMSG_DATA(CMsg);
+            // TODO: Use Ipv4 instead of Ipv6.
+            PktInfo->ipi_ifindex = LocalAddress->Ipv6.sin6_scope_id;
+            PktInfo->ipi_addr = LocalAddress->Ipv4.sin_addr;
+        } else {
+            CMsg->cmsg_level = IPPROTO_IPV6;
+            CMsg->cmsg_type = IPV6_PKTINFO;
+            CMsg->cmsg_len = CMSG_LEN(sizeof(struct in6_pktinfo));
+            PktInfo6 = (struct in6_pktinfo*) CMSG_DATA(CMsg);
+            PktInfo6->ipi6_ifindex = LocalAddress->Ipv6.sin6_scope_id;
+            PktInfo6->ipi6_addr = LocalAddress->Ipv6.sin6_addr;
+        }
+    }
+
+#ifdef UDP_SEGMENT
+    if (SendData->SegmentSize > 0 && SendData->Iovs[Index].iov_len > SendData->SegmentSize) {
+        Mhdr->msg_controllen += CMSG_SPACE(sizeof(uint16_t));
+        CMsg = CMSG_NXTHDR(Mhdr, CMsg);
+        CXPLAT_DBG_ASSERT(CMsg != NULL);
+        CMsg->cmsg_level = SOL_UDP;
+        CMsg->cmsg_type = UDP_SEGMENT;
+        CMsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        *((uint16_t*) CMSG_DATA(CMsg)) = SendData->SegmentSize;
+    }
+#endif
+
+#ifdef SO_TXTIME
+    if (SendData->TxTime != 0) {
+        Mhdr->msg_controllen += CMSG_SPACE(sizeof(uint64_t));
+        CMsg = CMSG_NXTHDR(Mhdr, CMsg);
+        CXPLAT_DBG_ASSERT(CMsg != NULL);
+        CMsg->cmsg_level = SOL_SOCKET;
+        CMsg->cmsg_type = SCM_TXTIME;
+        CMsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        *((uint64_t*) CMSG_DATA(CMsg)) = US_TO_NS(SendData->TxTime);
+    }
+#endif
+}
+
+//
+// Adds the ring to the current thread's open send batch, if there is one.
+// Returns FALSE if the caller must submit now.
+//
+static
+BOOLEAN
+CxPlatUringSendBatchDefer(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext
+    )
+{
+    CXPLAT_URING_SEND_BATCH* Batch = &CxPlatUringSendBatch;
+    if (Batch->Depth == 0) {
+        return FALSE;
+    }
+    for (uint32_t i = 0; i < Batch->ProcContextCount; ++i) {
+        if (Batch->ProcContexts[i] == ProcContext) {
+            return TRUE;
+        }
+    }
+    if (Batch->ProcContextCount == CXPLAT_URING_MAX_BATCH_RINGS) {
+        return FALSE;
+    }
+    Batch->ProcContexts[Batch->ProcContextCount++] = ProcContext;
+    return TRUE;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchBegin(
+    void
+    )
+{
+    CxPlatUringSendBatch.Depth++;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchEnd(
+    void
+    )
+{
+    CXPLAT_URING_SEND_BATCH* Batch = &CxPlatUringSendBatch;
+    CXPLAT_DBG_ASSERT(Batch->Depth > 0);
+    if (--Batch->Depth != 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < Batch->ProcContextCount; ++i) {
+        CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = Batch->ProcContexts[i];
+        CxPlatLockAcquire(&ProcContext->SubmitLock);
+        int Result = CxPlatUringSubmit(&ProcContext->Ring);
+        CxPlatLockRelease(&ProcContext->SubmitLock);
+        if (Result < 0) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                ProcContext,
+                -Result,
+                "io_uring_enter(sendmsg) failed");
+        }
+    }
+    Batch->ProcContextCount = 0;
+}
+
+QUIC_STATUS
+CxPlatSocketSend(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const CXPLAT_ROUTE* Route,
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t IdealProcessor
+    )
+{
+    UNREFERENCED_PARAMETER(IdealProcessor);
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    CXPLAT_SOCKET_CONTEXT* SocketContext = NULL;
+    const QUIC_ADDR* LocalAddress = &Route->LocalAddress;
+    const QUIC_ADDR* RemoteAddress = &Route->RemoteAddress;
+
+    CXPLAT_DBG_ASSERT(Socket != NULL && SendData != NULL);
+
+    if (Socket->HasFixedRemoteAddress) {
+        SocketContext = &Socket->SocketContexts[0];
+    } else {
+        uint32_t ProcNumber = CxPlatProcCurrentNumber() % Socket->Datapath->ProcCount;
+        SocketContext = &Socket->SocketContexts[ProcNumber];
+    }
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = SocketContext->ProcContext;
+
+    CxPlatSendDataFinalizeSendBuffer(SendData);
+    QuicTraceEvent(
+        DatapathSend,
+        "[data][%p] Send %u bytes in %hhu buffers (segment=%hu) Dst=%!ADDR!, Src=%!ADDR!",
+        Socket,
+        SendData->TotalSize,
+        SendData->BufferCount,
+        SendData->SegmentSize,
+        CASTED_CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress),
+        CASTED_CLOG_BYTEARRAY(sizeof(*LocalAddress), LocalAddress));
+
+    if (SendData->BufferCount == 0) {
+        goto Exit;
+    }
+
+    //
+    // Map V4 address to dual-stack socket format.
+    //
+    CxPlatConvertToMappedV6(RemoteAddress, &SendData->MappedRemoteAddress);
+
+    if (SendData->MappedRemoteAddress.Ipv6.sin6_family == QUIC_ADDRESS_FAMILY_INET6) {
+        SendData->MappedRemoteAddress.Ipv6.sin6_family = AF_INET6;
+    }
+
+    for (size_t i = 0; i < SendData->BufferCount; ++i) {
+        CxPlatSendDataPrepareMessage(SendData, i, Socket, LocalAddress, RemoteAddress);
+    }
+
+    SendData->SocketContext = SocketContext;
+    SendData->PendingMessagesCount = (uint32_t)SendData->BufferCount;
+
+    CxPlatLockAcquire(&ProcContext->SubmitLock);
+    if (CxPlatUringReserveSqes(&ProcContext->Ring, (uint32_t)SendData->BufferCount) <
+            SendData->BufferCount) {
+        CxPlatLockRelease(&ProcContext->SubmitLock);
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "io_uring submission queue full");
+        goto Exit;
+    }
+
+    //
+    // The send holds a reference on the socket context until all of its
+    // messages complete.
+    //
+    InterlockedIncrement(&SocketContext->IoCount);
+    for (size_t i = 0; i < SendData->BufferCount; ++i) {
+        struct io_uring_sqe* Sqe = CxPlatUringGetSqe(&ProcContext->Ring);
+        CXPLAT_DBG_ASSERT(Sqe != NULL);
+        Sqe->opcode = IORING_OP_SENDMSG;
+        Sqe->fd = SocketContext->SocketFd;
+        Sqe->addr = (uint64_t)(uintptr_t)&SendData->MsgHdrs[i];
+        Sqe->len = 1;
+        Sqe->user_data = (uint64_t)(uintptr_t)SendData | CXPLAT_URING_OP_SEND;
+    }
+    int Result = 0;
+    if (!CxPlatUringSendBatchDefer(ProcContext)) {
+        Result = CxPlatUringSubmit(&ProcContext->Ring);
+    }
+    CxPlatLockRelease(&ProcContext->SubmitLock);
+
+    if (Result < 0) {
+        //
+        // The submissions stay queued in the ring and are picked up by the
+        // next successful submit.
+        //
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            -Result,
+            "io_uring_enter(sendmsg) failed");
+    }
+
+    return QUIC_STATUS_SUCCESS;
+
+Exit:
+
+    CxPlatSendDataFree(SendData);
+
+    return Status;
+}
+
+uint16_t
+CxPlatSocketGetLocalMtu(
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    return Socket->Mtu;
+}
+
+void
+CxPlatDataPathWake(
+    _In_ void* Context
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = (CXPLAT_DATAPATH_PROC_CONTEXT*)Context;
+    const eventfd_t Value = 1;
+    eventfd_write(ProcContext->EventFd, Value);
+}
+
+//
+// Processes a single receive completion, appending any received datagram to
+// the pending receive chain.
+//
+static
+void
+CxPlatDataPathProcessRecvCompletion(
+    _In_ CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext,
+    _In_ CXPLAT_SOCKET_CONTEXT* SocketContext,
+    _In_ const struct io_uring_cqe* Cqe,
+    _Inout_ CXPLAT_RECV_DATA*** DatagramTail,
+    _Inout_ uint32_t* DatagramCount
+    )
+{
+    if (Cqe->flags & IORING_CQE_F_BUFFER) {
+        ProcContext->RecvBuffersConsumed++;
+        CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
+            CxPlatDataPathGetRecvBlock(
+                ProcContext, (uint16_t)(Cqe->flags >> IORING_CQE_BUFFER_SHIFT));
+        CXPLAT_RECV_DATA* Datagram =
+            CxPlatSocketContextRecvComplete(
+                SocketContext,
+                RecvBlock,
+                Cqe->res < 0 ? 0 : (uint32_t)Cqe->res);
+        if (Datagram != NULL) {
+            **DatagramTail = Datagram;
+            *DatagramTail = &Datagram->Next;
+            (*DatagramCount)++;
+        }
+    }
+
+    if (!(Cqe->flags & IORING_CQE_F_MORE)) {
+        //
+        // The multishot receive terminated, most commonly because the buffer
+        // ring ran dry. Queue it to be re-armed once buffers are available.
+        //
+        if (Cqe->res < 0 && Cqe->res != -ENOBUFS && Cqe->res != -ECANCELED) {
+            QuicTraceEvent(
+                DatapathErrorStatus,
+                "[data][%p] ERROR, %u, %s.",
+                SocketContext->Binding,
+                -Cqe->res,
+                "recvmsg completion");
+        }
+        CxPlatLockAcquire(&ProcContext->SubmitLock);
+        CxPlatSocketContextQueueReceive(SocketContext);
+        CxPlatLockRelease(&ProcContext->SubmitLock);
+    }
+}
+
+void
+CxPlatDataPathRunEC(
+    _In_ void** Context,
+    _In_ CXPLAT_THREAD_ID CurThreadId,
+    _In_ uint32_t WaitTime
+    )
+{
+    CXPLAT_DATAPATH_PROC_CONTEXT** EcProcContext = (CXPLAT_DATAPATH_PROC_CONTEXT**)Context;
+    CXPLAT_DATAPATH_PROC_CONTEXT* ProcContext = *EcProcContext;
+    CXPLAT_URING* Ring = &ProcContext->Ring;
+    CXPLAT_DBG_ASSERT(ProcContext->Datapath != NULL);
+
+    ProcContext->ThreadId = CurThreadId;
+
+    //
+    // The shutdown wake may already have been consumed while processing the
+    // previous batch of completions, so check before blocking.
+    //
+    if (!ProcContext->Datapath->Shutdown &&
+        __atomic_load_n(Ring->CqHead, __ATOMIC_RELAXED) ==
+        __atomic_load_n(Ring->CqTail, __ATOMIC_ACQUIRE)) {
+        struct __kernel_timespec Timeout = {
+            .tv_sec = WaitTime / 1000,
+            .tv_nsec = (WaitTime % 1000) * 1000000
+        };
+        struct io_uring_getevents_arg Arg;
+        CxPlatZeroMemory(&Arg, sizeof(Arg));
+        if (WaitTime != UINT32_MAX) {
+            Arg.ts = (uint64_t)(uintptr_t)&Timeout;
+        }
+        (void)CxPlatUringEnter(
+            Ring->RingFd,
+            0,
+            WaitTime == 0 ? 0 : 1,
+            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+            &Arg,
+            sizeof(Arg));
+    }
+
+    if (ProcContext->Datapath->Shutdown) {
+        *Context = NULL;
+        CxPlatEventSet(ProcContext->CompletionEvent);
+        return;
+    }
+
+    CXPLAT_SOCKET_CONTEXT* RecvSocketContext = NULL;
+    CXPLAT_RECV_DATA* DatagramHead = NULL;
+    CXPLAT_RECV_DATA** DatagramTail = &DatagramHead;
+    uint32_t DatagramCount = 0;
+
+    uint32_t Head = __atomic_load_n(Ring->CqHead, __ATOMIC_RELAXED);
+    uint32_t Tail = __atomic_load_n(Ring->CqTail, __ATOMIC_ACQUIRE);
+    while (Head != Tail) {
+        const struct io_uring_cqe Cqe = Ring->Cqes[Head & Ring->CqMask];
+        __atomic_store_n(Ring->CqHead, ++Head, __ATOMIC_RELEASE);
+
+        const uint64_t Op = Cqe.user_data & CXPLAT_URING_OP_MASK;
+        void* Ptr = (void*)(uintptr_t)(Cqe.user_data & ~(uint64_t)CXPLAT_URING_OP_MASK);
+
+        //
+        // Consecutive receives on the same socket are indicated as one chain.
+        // Flush the chain before anything else that may upcall or release the
+        // socket context.
+        //
+        if (DatagramHead != NULL &&
+            (Op != CXPLAT_URING_OP_RECV ||
+             Ptr != RecvSocketContext ||
+             !(Cqe.flags & IORING_CQE_F_MORE) ||
+             DatagramCount == CXPLAT_MAX_BATCH_RECEIVE)) {
+            CxPlatSocketContextIndicateReceive(RecvSocketContext, DatagramHead);
+            DatagramHead = NULL;
+            DatagramTail = &DatagramHead;
+            DatagramCount = 0;
+        }
+
+        switch (Op) {
+        case CXPLAT_URING_OP_RECV: {
+            CXPLAT_SOCKET_CONTEXT* SocketContext = (CXPLAT_SOCKET_CONTEXT*)Ptr;
+            RecvSocketContext = SocketContext;
+            CxPlatDataPathProcessRecvCompletion(
+                ProcContext, SocketContext, &Cqe, &DatagramTail, &DatagramCount);
+            if (!(Cqe.flags & IORING_CQE_F_MORE)) {
+                if (DatagramHead != NULL) {
+                    CxPlatSocketContextIndicateReceive(SocketContext, DatagramHead);
+                    DatagramHead = NULL;
+                    DatagramTail = &DatagramHead;
+                    DatagramCount = 0;
+                }
+                CxPlatSocketContextRelease(SocketContext);
+            }
+            break;
+        }
+        case CXPLAT_URING_OP_SEND: {
+            CXPLAT_SEND_DATA* SendData = (CXPLAT_SEND_DATA*)Ptr;
+            CXPLAT_SOCKET_CONTEXT* SocketContext = SendData->SocketContext;
+            if (Cqe.res < 0) {
+                CxPlatSocketContextSendError(SocketContext, (QUIC_STATUS)-Cqe.res);
+            }
+            if (--SendData->PendingMessagesCount == 0) {
+                CxPlatSendDataFree(SendData);
+                CxPlatSocketContextRelease(SocketContext);
+            }
+            break;
+        }
+        case CXPLAT_URING_OP_WAKE:
+            CxPlatLockAcquire(&ProcContext->SubmitLock);
+            (void)CxPlatProcessorContextArmWake(ProcContext);
+            (void)CxPlatUringSubmit(Ring);
+            CxPlatLockRelease(&ProcContext->SubmitLock);
+            break;
+        case CXPLAT_URING_OP_CANCEL:
+            CxPlatSocketContextRelease((CXPLAT_SOCKET_CONTEXT*)Ptr);
+            break;
+        }
+
+        if (Head == Tail) {
+            Tail = __atomic_load_n(Ring->CqTail, __ATOMIC_ACQUIRE);
+        }
+    }
+
+    if (DatagramHead != NULL) {
+        CxPlatSocketContextIndicateReceive(RecvSocketContext, DatagramHead);
+    }
+
+    CxPlatDataPathArmReceives(ProcContext);
+}
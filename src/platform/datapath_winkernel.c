@@ -2902,6 +2902,17 @@ CxPlatSendDataIsFull(
     return !CxPlatSendDataCanAllocSend(SendData, SendData->SegmentSize);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSendDataSetTxTime(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint64_t TxTimeUs
+    )
+{
+    UNREFERENCED_PARAMETER(SendData);
+    UNREFERENCED_PARAMETER(TxTimeUs);
+}
+
 IO_COMPLETION_ROUTINE CxPlatDataPathSendComplete;
 
 _Use_decl_annotations_
@@ -2955,6 +2966,22 @@ CxPlatSocketPrepareSendData(
         TRUE);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchBegin(
+    void
+    )
+{
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+CxPlatSocketSendBatchEnd(
+    void
+    )
+{
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 CxPlatSocketSend(
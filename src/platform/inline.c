@@ -31,30 +31,6 @@ MaxUdpPayloadSizeForFamily(
     _In_ uint16_t Mtu
     );
 
-void
-CxPlatPoolInitialize(
-    _In_ BOOLEAN IsPaged,
-    _In_ uint32_t Size,
-    _In_ uint32_t Tag,
-    _Inout_ CXPLAT_POOL* Pool
-    );
-
-void
-CxPlatPoolUninitialize(
-    _Inout_ CXPLAT_POOL* Pool
-    );
-
-void*
-CxPlatPoolAlloc(
-    _Inout_ CXPLAT_POOL* Pool
-    );
-
-void
-CxPlatPoolFree(
-    _Inout_ CXPLAT_POOL* Pool,
-    _In_ void* Entry
-    );
-
 void
 CxPlatListInitializeHead(
     _Out_ CXPLAT_LIST_ENTRY* ListHead
@@ -366,6 +342,12 @@ CxPlatInternalEventWaitForever(
     _Inout_ CXPLAT_EVENT* Event
     );
 
+BOOLEAN
+CxPlatInternalEventWaitWithTimeoutUs(
+    _Inout_ CXPLAT_EVENT* Event,
+    _In_ uint64_t TimeoutUs
+    );
+
 BOOLEAN
 CxPlatInternalEventWaitWithTimeout(
     _Inout_ CXPLAT_EVENT* Event,
@@ -44,6 +44,30 @@ uint32_t CxPlatProcessorCount;
 
 uint64_t CxPlatTotalMemory;
 
+//
+// Threads using pools are assigned a slot (an index into each pool's thread
+// caches), which is released when they exit and then reused by another thread.
+//
+static pthread_key_t CxPlatPoolThreadKey;
+static BOOLEAN CxPlatPoolThreadKeyCreated = FALSE;
+static uint64_t CxPlatPoolThreadSlots[CXPLAT_POOL_MAX_THREADS / 64];
+static __thread uint32_t CxPlatPoolThreadSlot; // Slot + 1, zero if none
+#define CXPLAT_POOL_NO_SLOT UINT32_MAX
+
+static
+void
+CxPlatPoolThreadExit(
+    _In_ void* Value
+    )
+{
+    const uint32_t Slot = (uint32_t)(uintptr_t)Value - 1;
+    CxPlatPoolThreadSlot = 0;
+    __atomic_fetch_and(
+        &CxPlatPoolThreadSlots[Slot / 64],
+        ~(1ull << (Slot % 64)),
+        __ATOMIC_RELEASE);
+}
+
 #ifdef __clang__
 __attribute__((noinline, noreturn, optnone))
 #else
@@ -98,6 +122,9 @@ CxPlatSystemLoad(
     CxPlatform.AllocCounter = 0;
 #endif
 
+    CxPlatPoolThreadKeyCreated =
+        pthread_key_create(&CxPlatPoolThreadKey, CxPlatPoolThreadExit) == 0;
+
     //
     // N.B.
     // Do not place any initialization code below this point.
@@ -180,6 +207,11 @@ CxPlatSystemUnload(
     void
     )
 {
+    if (CxPlatPoolThreadKeyCreated) {
+        CxPlatPoolThreadKeyCreated = FALSE;
+        pthread_key_delete(CxPlatPoolThreadKey);
+    }
+
     QuicTraceLogInfo(
         PosixUnloaded,
         "[ dso] Unloaded");
@@ -269,6 +301,487 @@ CxPlatFree(
     free(Mem);
 }
 
+//
+// Pool implementation.
+//
+
+typedef struct CXPLAT_POOL_MAGAZINE {
+    uint32_t Count;
+    void* Entries[CXPLAT_POOL_MAGAZINE_SIZE];
+} CXPLAT_POOL_MAGAZINE;
+
+//
+// A thread's magazines for one pool. Only the owning thread modifies it.
+//
+typedef struct CXPLAT_POOL_THREAD_CACHE {
+    CXPLAT_POOL_MAGAZINE* Loaded;
+    CXPLAT_POOL_MAGAZINE* Previous;
+    uint32_t Depth; // Entries in Loaded and Previous
+    uint64_t Hits;
+    uint64_t Misses;
+} CXPLAT_POOL_THREAD_CACHE;
+
+//
+// Bounded lock-free MPMC queue of magazines. Each cell's sequence number says
+// whether it's ready to be written (== position) or read (== position + 1) at
+// a given position, which also protects against ABA.
+//
+typedef struct CXPLAT_POOL_MAGAZINE_QUEUE {
+    struct {
+        uint64_t Sequence;
+        CXPLAT_POOL_MAGAZINE* Magazine;
+    } Cells[CXPLAT_POOL_DEPOT_SIZE];
+    //
+    // The padding keeps the producer and consumer positions (and the cells)
+    // on separate cache lines.
+    //
+    uint8_t Padding0[64];
+    uint64_t EnqueuePos;
+    uint8_t Padding1[64 - sizeof(uint64_t)];
+    uint64_t DequeuePos;
+    uint8_t Padding2[64 - sizeof(uint64_t)];
+} CXPLAT_POOL_MAGAZINE_QUEUE;
+
+struct CXPLAT_POOL_DEPOT {
+    CXPLAT_POOL_MAGAZINE_QUEUE Full;
+    CXPLAT_POOL_MAGAZINE_QUEUE Empty;
+
+    //
+    // The number of entries in a full magazine, and the most full magazines
+    // the depot may keep, for this pool's entry size.
+    //
+    uint32_t MagazineSize;
+    uint32_t MaxTarget;
+
+    //
+    // The number of full magazines the depot currently keeps, between 1 and
+    // MaxTarget.
+    //
+    uint32_t Target;
+
+    CXPLAT_POOL_THREAD_CACHE* ThreadCaches[CXPLAT_POOL_MAX_THREADS];
+};
+
+static
+uint32_t
+CxPlatPoolGetThreadSlot(
+    void
+    )
+{
+    if (CxPlatPoolThreadSlot != 0) {
+        return CxPlatPoolThreadSlot - 1;
+    }
+    if (!CxPlatPoolThreadKeyCreated) {
+        return CXPLAT_POOL_NO_SLOT;
+    }
+
+    for (uint32_t i = 0; i < ARRAYSIZE(CxPlatPoolThreadSlots); ++i) {
+        uint64_t Bits = __atomic_load_n(&CxPlatPoolThreadSlots[i], __ATOMIC_RELAXED);
+        while (Bits != UINT64_MAX) {
+            const uint32_t Bit = (uint32_t)__builtin_ctzll(~Bits);
+            if (__atomic_compare_exchange_n(
+                    &CxPlatPoolThreadSlots[i], &Bits, Bits | (1ull << Bit),
+                    FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                const uint32_t Slot = i * 64 + Bit;
+                if (pthread_setspecific(
+                        CxPlatPoolThreadKey, (void*)(uintptr_t)(Slot + 1)) != 0) {
+                    CxPlatPoolThreadExit((void*)(uintptr_t)(Slot + 1));
+                    return CXPLAT_POOL_NO_SLOT;
+                }
+                CxPlatPoolThreadSlot = Slot + 1;
+                return Slot;
+            }
+        }
+    }
+
+    return CXPLAT_POOL_NO_SLOT; // More threads than slots.
+}
+
+static
+BOOLEAN
+CxPlatPoolQueuePush(
+    _Inout_ CXPLAT_POOL_MAGAZINE_QUEUE* Queue,
+    _In_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    uint64_t Pos = __atomic_load_n(&Queue->EnqueuePos, __ATOMIC_RELAXED);
+    for (;;) {
+        uint32_t Index = (uint32_t)(Pos & (CXPLAT_POOL_DEPOT_SIZE - 1));
+        const uint64_t Sequence =
+            __atomic_load_n(&Queue->Cells[Index].Sequence, __ATOMIC_ACQUIRE);
+        const int64_t Diff = (int64_t)(Sequence - Pos);
+        if (Diff == 0) {
+            if (__atomic_compare_exchange_n(
+                    &Queue->EnqueuePos, &Pos, Pos + 1,
+                    TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                Queue->Cells[Index].Magazine = Magazine;
+                __atomic_store_n(&Queue->Cells[Index].Sequence, Pos + 1, __ATOMIC_RELEASE);
+                return TRUE;
+            }
+        } else if (Diff < 0) {
+            return FALSE; // Full
+        } else {
+            Pos = __atomic_load_n(&Queue->EnqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolQueuePop(
+    _Inout_ CXPLAT_POOL_MAGAZINE_QUEUE* Queue
+    )
+{
+    uint64_t Pos = __atomic_load_n(&Queue->DequeuePos, __ATOMIC_RELAXED);
+    for (;;) {
+        uint32_t Index = (uint32_t)(Pos & (CXPLAT_POOL_DEPOT_SIZE - 1));
+        const uint64_t Sequence =
+            __atomic_load_n(&Queue->Cells[Index].Sequence, __ATOMIC_ACQUIRE);
+        const int64_t Diff = (int64_t)(Sequence - (Pos + 1));
+        if (Diff == 0) {
+            if (__atomic_compare_exchange_n(
+                    &Queue->DequeuePos, &Pos, Pos + 1,
+                    TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                CXPLAT_POOL_MAGAZINE* Magazine = Queue->Cells[Index].Magazine;
+                __atomic_store_n(
+                    &Queue->Cells[Index].Sequence,
+                    Pos + CXPLAT_POOL_DEPOT_SIZE,
+                    __ATOMIC_RELEASE);
+                return Magazine;
+            }
+        } else if (Diff < 0) {
+            return NULL; // Empty
+        } else {
+            Pos = __atomic_load_n(&Queue->DequeuePos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static
+uint32_t
+CxPlatPoolQueueCount(
+    _In_ const CXPLAT_POOL_MAGAZINE_QUEUE* Queue
+    )
+{
+    const uint64_t DequeuePos = __atomic_load_n(&Queue->DequeuePos, __ATOMIC_RELAXED);
+    const uint64_t EnqueuePos = __atomic_load_n(&Queue->EnqueuePos, __ATOMIC_RELAXED);
+    return EnqueuePos > DequeuePos ? (uint32_t)(EnqueuePos - DequeuePos) : 0;
+}
+
+static
+void
+CxPlatPoolAdjustTarget(
+    _Inout_ CXPLAT_POOL_DEPOT* Depot,
+    _In_ BOOLEAN Grow
+    )
+{
+    uint32_t Target = __atomic_load_n(&Depot->Target, __ATOMIC_RELAXED);
+    if (Grow ? Target < Depot->MaxTarget : Target > 1) {
+        __atomic_compare_exchange_n(
+            &Depot->Target, &Target, Grow ? Target + 1 : Target - 1,
+            FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+}
+
+static
+void
+CxPlatPoolMagazineFree(
+    _In_ CXPLAT_POOL* Pool,
+    _In_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    for (uint32_t i = 0; i < Magazine->Count; ++i) {
+        CxPlatFree(Magazine->Entries[i], Pool->Tag);
+    }
+    CxPlatFree(Magazine, QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+}
+
+static
+CXPLAT_POOL_MAGAZINE*
+CxPlatPoolGetEmptyMagazine(
+    _In_ CXPLAT_POOL_DEPOT* Depot
+    )
+{
+    CXPLAT_POOL_MAGAZINE* Magazine = CxPlatPoolQueuePop(&Depot->Empty);
+    if (Magazine == NULL) {
+        Magazine =
+            CxPlatAlloc(sizeof(CXPLAT_POOL_MAGAZINE), QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+        if (Magazine != NULL) {
+            Magazine->Count = 0;
+        }
+    }
+    return Magazine;
+}
+
+static
+void
+CxPlatPoolPutEmptyMagazine(
+    _In_ CXPLAT_POOL_DEPOT* Depot,
+    _In_ CXPLAT_POOL_MAGAZINE* Magazine
+    )
+{
+    CXPLAT_DBG_ASSERT(Magazine->Count == 0);
+    if (!CxPlatPoolQueuePush(&Depot->Empty, Magazine)) {
+        CxPlatFree(Magazine, QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+    }
+}
+
+static
+CXPLAT_POOL_THREAD_CACHE*
+CxPlatPoolGetThreadCache(
+    _In_ CXPLAT_POOL* Pool
+    )
+{
+    if (Pool->Depot == NULL) {
+        return NULL;
+    }
+    const uint32_t Slot = CxPlatPoolGetThreadSlot();
+    if (Slot == CXPLAT_POOL_NO_SLOT) {
+        return NULL;
+    }
+
+    CXPLAT_POOL_THREAD_CACHE* Cache = Pool->Depot->ThreadCaches[Slot];
+    if (Cache != NULL) {
+        return Cache;
+    }
+
+    Cache = CxPlatAlloc(sizeof(CXPLAT_POOL_THREAD_CACHE), QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+    if (Cache == NULL) {
+        return NULL;
+    }
+    CxPlatZeroMemory(Cache, sizeof(*Cache));
+    Cache->Loaded = CxPlatPoolGetEmptyMagazine(Pool->Depot);
+    Cache->Previous = CxPlatPoolGetEmptyMagazine(Pool->Depot);
+    if (Cache->Loaded == NULL || Cache->Previous == NULL) {
+        if (Cache->Loaded != NULL) {
+            CxPlatPoolPutEmptyMagazine(Pool->Depot, Cache->Loaded);
+        }
+        if (Cache->Previous != NULL) {
+            CxPlatPoolPutEmptyMagazine(Pool->Depot, Cache->Previous);
+        }
+        CxPlatFree(Cache, QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+        return NULL;
+    }
+
+    __atomic_store_n(&Pool->Depot->ThreadCaches[Slot], Cache, __ATOMIC_RELEASE);
+    return Cache;
+}
+
+void
+CxPlatPoolInitialize(
+    _In_ BOOLEAN IsPaged,
+    _In_ uint32_t Size,
+    _In_ uint32_t Tag,
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+#if DEBUG
+    CXPLAT_DBG_ASSERT(Size >= sizeof(CXPLAT_POOL_ENTRY));
+#endif
+    UNREFERENCED_PARAMETER(IsPaged);
+    Pool->Size = Size;
+    Pool->Tag = Tag;
+    Pool->Depot = CxPlatAlloc(sizeof(CXPLAT_POOL_DEPOT), QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+    if (Pool->Depot != NULL) {
+        CxPlatZeroMemory(Pool->Depot, sizeof(CXPLAT_POOL_DEPOT));
+        for (uint32_t i = 0; i < CXPLAT_POOL_DEPOT_SIZE; ++i) {
+            Pool->Depot->Full.Cells[i].Sequence = i;
+            Pool->Depot->Empty.Cells[i].Sequence = i;
+        }
+        uint32_t MagazineSize = CXPLAT_POOL_MAGAZINE_BYTES / Size;
+        if (MagazineSize > CXPLAT_POOL_MAGAZINE_SIZE) {
+            MagazineSize = CXPLAT_POOL_MAGAZINE_SIZE;
+        } else if (MagazineSize == 0) {
+            MagazineSize = 1;
+        }
+        uint32_t MaxTarget =
+            (uint32_t)(CXPLAT_POOL_MAXIMUM_BYTES / ((uint64_t)Size * MagazineSize));
+        if (MaxTarget > CXPLAT_POOL_DEPOT_SIZE) {
+            MaxTarget = CXPLAT_POOL_DEPOT_SIZE;
+        } else if (MaxTarget == 0) {
+            MaxTarget = 1;
+        }
+        uint32_t Target = CXPLAT_POOL_DEFAULT_DEPTH / MagazineSize;
+        if (Target > MaxTarget) {
+            Target = MaxTarget;
+        }
+        Pool->Depot->MagazineSize = MagazineSize;
+        Pool->Depot->MaxTarget = MaxTarget;
+        Pool->Depot->Target = Target;
+    }
+}
+
+void
+CxPlatPoolUninitialize(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+    CXPLAT_POOL_DEPOT* Depot = Pool->Depot;
+    if (Depot == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < CXPLAT_POOL_MAX_THREADS; ++i) {
+        CXPLAT_POOL_THREAD_CACHE* Cache =
+            __atomic_load_n(&Depot->ThreadCaches[i], __ATOMIC_ACQUIRE);
+        if (Cache != NULL) {
+            CxPlatPoolMagazineFree(Pool, Cache->Loaded);
+            CxPlatPoolMagazineFree(Pool, Cache->Previous);
+            CxPlatFree(Cache, QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+        }
+    }
+
+    CXPLAT_POOL_MAGAZINE* Magazine;
+    while ((Magazine = CxPlatPoolQueuePop(&Depot->Full)) != NULL) {
+        CxPlatPoolMagazineFree(Pool, Magazine);
+    }
+    while ((Magazine = CxPlatPoolQueuePop(&Depot->Empty)) != NULL) {
+        CxPlatPoolMagazineFree(Pool, Magazine);
+    }
+
+    CxPlatFree(Depot, QUIC_POOL_PLATFORM_POOL_MAGAZINE);
+    Pool->Depot = NULL;
+}
+
+void*
+CxPlatPoolAlloc(
+    _Inout_ CXPLAT_POOL* Pool
+    )
+{
+#if DEBUG
+    if (CxPlatGetAllocFailDenominator()) {
+        return CxPlatAlloc(Pool->Size, Pool->Tag);
+    }
+#endif
+    void* Entry = NULL;
+    CXPLAT_POOL_THREAD_CACHE* Cache = CxPlatPoolGetThreadCache(Pool);
+    if (Cache != NULL) {
+        if (Cache->Loaded->Count == 0 && Cache->Previous->Count != 0) {
+            CXPLAT_POOL_MAGAZINE* Temp = Cache->Loaded;
+            Cache->Loaded = Cache->Previous;
+            Cache->Previous = Temp;
+        }
+
+        if (Cache->Loaded->Count == 0) {
+            //
+            // Both magazines are empty. Trade one for a full one from the
+            // depot, or have the depot keep more entries next time.
+            //
+            CXPLAT_POOL_MAGAZINE* Full = CxPlatPoolQueuePop(&Pool->Depot->Full);
+            if (Full != NULL) {
+                CxPlatPoolPutEmptyMagazine(Pool->Depot, Cache->Previous);
+                Cache->Previous = Cache->Loaded;
+                Cache->Loaded = Full;
+                Cache->Depth += Full->Count;
+            } else {
+                CxPlatPoolAdjustTarget(Pool->Depot, TRUE);
+            }
+        }
+
+        if (Cache->Loaded->Count != 0) {
+            Entry = Cache->Loaded->Entries[--Cache->Loaded->Count];
+            Cache->Depth--;
+            Cache->Hits++;
+        } else {
+            Cache->Misses++;
+        }
+    }
+
+    if (Entry == NULL) {
+        Entry = CxPlatAlloc(Pool->Size, Pool->Tag);
+    }
+#if DEBUG
+    if (Entry != NULL) {
+        ((CXPLAT_POOL_ENTRY*)Entry)->SpecialFlag = 0;
+    }
+#endif
+    return Entry;
+}
+
+void
+CxPlatPoolFree(
+    _Inout_ CXPLAT_POOL* Pool,
+    _In_ void* Entry
+    )
+{
+#if DEBUG
+    if (CxPlatGetAllocFailDenominator()) {
+        CxPlatFree(Entry, Pool->Tag);
+        return;
+    }
+    CXPLAT_DBG_ASSERT(((CXPLAT_POOL_ENTRY*)Entry)->SpecialFlag != CXPLAT_POOL_SPECIAL_FLAG);
+    ((CXPLAT_POOL_ENTRY*)Entry)->SpecialFlag = CXPLAT_POOL_SPECIAL_FLAG;
+#endif
+    CXPLAT_POOL_THREAD_CACHE* Cache = CxPlatPoolGetThreadCache(Pool);
+    if (Cache == NULL) {
+        CxPlatFree(Entry, Pool->Tag);
+        return;
+    }
+
+    CXPLAT_POOL_DEPOT* Depot = Pool->Depot;
+    if (Cache->Loaded->Count == Depot->MagazineSize &&
+        Cache->Previous->Count != Depot->MagazineSize) {
+        CXPLAT_POOL_MAGAZINE* Temp = Cache->Loaded;
+        Cache->Loaded = Cache->Previous;
+        Cache->Previous = Temp;
+    }
+
+    if (Cache->Loaded->Count == Depot->MagazineSize) {
+        //
+        // Both magazines are full. Hand one to the depot if it's below its
+        // target depth, otherwise release its entries and shrink the target.
+        //
+        CXPLAT_POOL_MAGAZINE* Empty = NULL;
+        if (CxPlatPoolQueueCount(&Depot->Full) <
+                __atomic_load_n(&Depot->Target, __ATOMIC_RELAXED) &&
+            (Empty = CxPlatPoolGetEmptyMagazine(Depot)) != NULL &&
+            CxPlatPoolQueuePush(&Depot->Full, Cache->Previous)) {
+            Cache->Depth -= Depot->MagazineSize;
+            Cache->Previous = Cache->Loaded;
+            Cache->Loaded = Empty;
+        } else {
+            if (Empty != NULL) {
+                CxPlatPoolPutEmptyMagazine(Depot, Empty);
+            }
+            CxPlatPoolAdjustTarget(Depot, FALSE);
+            for (uint32_t i = 0; i < Cache->Loaded->Count; ++i) {
+                CxPlatFree(Cache->Loaded->Entries[i], Pool->Tag);
+            }
+            Cache->Depth -= Cache->Loaded->Count;
+            Cache->Loaded->Count = 0;
+        }
+    }
+
+    Cache->Loaded->Entries[Cache->Loaded->Count++] = Entry;
+    Cache->Depth++;
+}
+
+void
+CxPlatPoolGetStats(
+    _In_ const CXPLAT_POOL* Pool,
+    _Out_ CXPLAT_POOL_STATS* Stats
+    )
+{
+    CxPlatZeroMemory(Stats, sizeof(*Stats));
+    const CXPLAT_POOL_DEPOT* Depot = Pool->Depot;
+    if (Depot == NULL) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < CXPLAT_POOL_MAX_THREADS; ++i) {
+        const CXPLAT_POOL_THREAD_CACHE* Cache =
+            __atomic_load_n(&Depot->ThreadCaches[i], __ATOMIC_ACQUIRE);
+        if (Cache != NULL) {
+            Stats->Hits += Cache->Hits;
+            Stats->Misses += Cache->Misses;
+            Stats->Depth += Cache->Depth;
+        }
+    }
+    Stats->Depth += CxPlatPoolQueueCount(&Depot->Full) * Depot->MagazineSize;
+    Stats->MaxDepth =
+        __atomic_load_n(&Depot->Target, __ATOMIC_RELAXED) * Depot->MagazineSize;
+}
+
 void
 CxPlatRefInitialize(
     _Inout_ CXPLAT_REF_COUNT* RefCount
@@ -435,6 +948,15 @@ CxPlatGetAbsoluteTime(
     _In_ unsigned long DeltaMs,
     _Out_ struct timespec *Time
     )
+{
+    CxPlatGetAbsoluteTimeUs(MS_TO_US((uint64_t)DeltaMs), Time);
+}
+
+void
+CxPlatGetAbsoluteTimeUs(
+    _In_ uint64_t DeltaUs,
+    _Out_ struct timespec *Time
+    )
 {
     int ErrorCode = 0;
 
@@ -453,8 +975,8 @@ CxPlatGetAbsoluteTime(
     CXPLAT_DBG_ASSERT(ErrorCode == 0);
     UNREFERENCED_PARAMETER(ErrorCode);
 
-    Time->tv_sec += (DeltaMs / CXPLAT_MS_PER_SECOND);
-    Time->tv_nsec += ((DeltaMs % CXPLAT_MS_PER_SECOND) * CXPLAT_NANOSEC_PER_MS);
+    Time->tv_sec += (DeltaUs / CXPLAT_MICROSEC_PER_SEC);
+    Time->tv_nsec += ((DeltaUs % CXPLAT_MICROSEC_PER_SEC) * CXPLAT_NANOSEC_PER_MICROSEC);
 
     if (Time->tv_nsec >= CXPLAT_NANOSEC_PER_SEC)
     {
@@ -349,6 +349,41 @@ TEST_F(CryptTest, HpMaskChaCha20)
 
     CxPlatHpKeyFree(HpKey);
 }
+
+TEST_F(CryptTest, HpMaskChaCha20Batch)
+{
+    const uint8_t RawKey[] =
+        {0, 1, 2, 3, 4, 5, 6, 7,
+        8, 9, 10, 11, 12, 13, 14, 15,
+        16, 17, 18, 19, 20, 21, 22, 23,
+        24, 25, 26, 27, 28, 29, 30, 31};
+    const uint8_t ExpectedMask[] = {0x39, 0xfd, 0x2b, 0x7d, 0xd9};
+    const uint8_t MaxBatchSize = 8;
+    uint8_t Samples[CXPLAT_HP_SAMPLE_LENGTH * MaxBatchSize];
+    uint8_t Mask[CXPLAT_HP_SAMPLE_LENGTH * MaxBatchSize];
+    uint8_t SingleMask[CXPLAT_HP_SAMPLE_LENGTH];
+    CXPLAT_HP_KEY* HpKey = nullptr;
+    VERIFY_QUIC_SUCCESS(CxPlatHpKeyCreate(CXPLAT_AEAD_CHACHA20_POLY1305, RawKey, &HpKey));
+
+    //
+    // Mix the well-known all zero sample with random ones, for every batch
+    // size, and make sure each mask matches the one computed on its own.
+    //
+    for (uint8_t BatchSize = 1; BatchSize <= MaxBatchSize; ++BatchSize) {
+        CxPlatRandom(sizeof(Samples), Samples);
+        CxPlatZeroMemory(Samples + (BatchSize - 1) * CXPLAT_HP_SAMPLE_LENGTH, CXPLAT_HP_SAMPLE_LENGTH);
+        VERIFY_QUIC_SUCCESS(CxPlatHpComputeMask(HpKey, BatchSize, Samples, Mask));
+
+        ASSERT_EQ(0, memcmp(ExpectedMask, Mask + (BatchSize - 1) * CXPLAT_HP_SAMPLE_LENGTH, sizeof(ExpectedMask)));
+        for (uint8_t i = 0; i < BatchSize; ++i) {
+            VERIFY_QUIC_SUCCESS(
+                CxPlatHpComputeMask(HpKey, 1, Samples + i * CXPLAT_HP_SAMPLE_LENGTH, SingleMask));
+            ASSERT_EQ(0, memcmp(SingleMask, Mask + i * CXPLAT_HP_SAMPLE_LENGTH, sizeof(ExpectedMask)));
+        }
+    }
+
+    CxPlatHpKeyFree(HpKey);
+}
 #endif // QUIC_DISABLE_CHACHA20_TESTS
 
 TEST_F(CryptTest, HpMaskAes256)
@@ -403,6 +438,45 @@ TEST_F(CryptTest, HpMaskAes128)
     CxPlatHpKeyFree(HpKey);
 }
 
+TEST_F(CryptTest, BlockAes128)
+{
+    //
+    // FIPS-197, Appendix C.1.
+    //
+    const uint8_t RawKey[] =
+        {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+    const uint8_t Plaintext[CXPLAT_BLOCK_LENGTH] =
+        {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+    const uint8_t ExpectedCiphertext[CXPLAT_BLOCK_LENGTH] =
+        {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+
+    CXPLAT_BLOCK_KEY* Key = nullptr;
+    VERIFY_QUIC_SUCCESS(CxPlatBlockKeyCreate(RawKey, &Key));
+
+    uint8_t Block[CXPLAT_BLOCK_LENGTH];
+    VERIFY_QUIC_SUCCESS(CxPlatBlockEncrypt(Key, Plaintext, Block));
+    if (memcmp(ExpectedCiphertext, Block, sizeof(Block)) != 0) {
+        LogTestBuffer("Expected Ciphertext:", ExpectedCiphertext, sizeof(Block));
+        LogTestBuffer("Ciphertext:         ", Block, sizeof(Block));
+        FAIL();
+    }
+
+    //
+    // Repeated, in place operations must not depend on the previous block.
+    //
+    for (uint32_t i = 0; i < 2; ++i) {
+        VERIFY_QUIC_SUCCESS(CxPlatBlockDecrypt(Key, Block, Block));
+        ASSERT_EQ(0, memcmp(Plaintext, Block, sizeof(Block)));
+        VERIFY_QUIC_SUCCESS(CxPlatBlockEncrypt(Key, Block, Block));
+        ASSERT_EQ(0, memcmp(ExpectedCiphertext, Block, sizeof(Block)));
+    }
+
+    CxPlatBlockKeyFree(Key);
+}
+
 TEST_P(CryptTest, Encryption)
 {
 
@@ -455,6 +529,111 @@ TEST_P(CryptTest, Encryption)
     ASSERT_FALSE(Key.Decrypt(Iv, sizeof(AuthData), AuthData, sizeof(Buffer), Buffer));
 }
 
+TEST_P(CryptTest, EncryptionBatch)
+{
+    int AEAD = GetParam();
+
+    uint8_t RawKey[32] = {0};
+    uint8_t AuthData[4][20];
+    uint8_t Buffer[4][100];
+    uint8_t Expected[4][100];
+    CXPLAT_CRYPT_BATCH_ENTRY Batch[4];
+
+    QuicKey Key((CXPLAT_AEAD_TYPE)AEAD, RawKey);
+    if (Key.Ptr == NULL) return;
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        CxPlatZeroMemory(&Batch[i], sizeof(Batch[i]));
+        CxPlatRandom(CXPLAT_IV_LENGTH, Batch[i].Iv);
+        CxPlatRandom(sizeof(AuthData[i]), AuthData[i]);
+        CxPlatRandom(sizeof(Buffer[i]), Buffer[i]);
+        Batch[i].AuthData = AuthData[i];
+        Batch[i].AuthDataLength = (uint16_t)(sizeof(AuthData[i]) - i);
+        Batch[i].Buffer = Buffer[i];
+        Batch[i].BufferLength = (uint16_t)(sizeof(Buffer[i]) - i * 10);
+
+        memcpy(Expected[i], Buffer[i], sizeof(Buffer[i]));
+        ASSERT_TRUE(
+            Key.Encrypt(
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                AuthData[i],
+                Batch[i].BufferLength,
+                Expected[i]));
+    }
+
+    VERIFY_QUIC_SUCCESS(CxPlatEncryptBatch(Key.Ptr, 4, Batch));
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(0, memcmp(Expected[i], Buffer[i], sizeof(Buffer[i])));
+        ASSERT_TRUE(
+            Key.Decrypt(
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                AuthData[i],
+                Batch[i].BufferLength,
+                Buffer[i]));
+    }
+}
+
+TEST_P(CryptTest, DecryptionBatch)
+{
+    int AEAD = GetParam();
+
+    uint8_t RawKey[32] = {0};
+    uint8_t AuthData[4][20];
+    uint8_t Buffer[4][100];
+    uint8_t Expected[4][100];
+    CXPLAT_CRYPT_BATCH_ENTRY Batch[4];
+    QUIC_STATUS Results[4];
+
+    QuicKey Key((CXPLAT_AEAD_TYPE)AEAD, RawKey);
+    if (Key.Ptr == NULL) return;
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        CxPlatZeroMemory(&Batch[i], sizeof(Batch[i]));
+        CxPlatRandom(CXPLAT_IV_LENGTH, Batch[i].Iv);
+        CxPlatRandom(sizeof(AuthData[i]), AuthData[i]);
+        CxPlatRandom(sizeof(Expected[i]), Expected[i]);
+        Batch[i].AuthData = AuthData[i];
+        Batch[i].AuthDataLength = (uint16_t)(sizeof(AuthData[i]) - i);
+        Batch[i].Buffer = Buffer[i];
+        Batch[i].BufferLength = (uint16_t)(sizeof(Buffer[i]) - i * 10);
+
+        memcpy(Buffer[i], Expected[i], sizeof(Buffer[i]));
+        ASSERT_TRUE(
+            Key.Encrypt(
+                Batch[i].Iv,
+                Batch[i].AuthDataLength,
+                AuthData[i],
+                Batch[i].BufferLength,
+                Buffer[i]));
+    }
+
+    //
+    // A corrupted entry fails on its own without affecting the rest.
+    //
+    Buffer[1][0] ^= 1;
+
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, CxPlatDecryptBatch(Key.Ptr, 1, Batch, Results));
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Results[0]);
+    ASSERT_NE(QUIC_STATUS_SUCCESS, CxPlatDecryptBatch(Key.Ptr, 3, Batch + 1, Results + 1));
+    ASSERT_NE(QUIC_STATUS_SUCCESS, Results[1]);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Results[2]);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, Results[3]);
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        if (i != 1) {
+            ASSERT_EQ(
+                0,
+                memcmp(
+                    Expected[i],
+                    Buffer[i],
+                    Batch[i].BufferLength - CXPLAT_ENCRYPTION_OVERHEAD));
+        }
+    }
+}
+
 TEST_P(CryptTest, HashWellKnown)
 {
     int HASH = GetParam();
@@ -17,6 +17,19 @@ Abstract:
 #include "DataPathTest.cpp.clog.h"
 #endif
 
+#if defined(QUIC_USE_RAW_DATAPATH) && defined(CX_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#endif
+
+#if !defined(QUIC_USE_RAW_DATAPATH) && defined(CX_PLATFORM_LINUX)
+#include <linux/bpf.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 const uint32_t ExpectedDataSize = 1 * 1024;
 char* ExpectedData;
 
@@ -82,6 +95,31 @@ struct UdpRecvContext {
     }
 };
 
+struct UdpSegmentedRecvContext {
+    uint16_t SegmentSize {0};
+    uint32_t ExpectedCount {0};
+    volatile long ReceivedCount {0};
+    volatile long BadCount {0};
+    CXPLAT_EVENT Completion;
+    UdpSegmentedRecvContext() {
+        CxPlatEventInitialize(&Completion, FALSE, FALSE);
+    }
+    ~UdpSegmentedRecvContext() {
+        CxPlatEventUninitialize(Completion);
+    }
+};
+
+struct UdpSteeringRecvContext {
+    uint16_t PartitionIndex {UINT16_MAX};
+    CXPLAT_EVENT Completion;
+    UdpSteeringRecvContext() {
+        CxPlatEventInitialize(&Completion, FALSE, FALSE);
+    }
+    ~UdpSteeringRecvContext() {
+        CxPlatEventUninitialize(Completion);
+    }
+};
+
 struct TcpClientContext {
     bool Connected : 1;
     bool Disconnected : 1;
@@ -262,6 +300,45 @@ protected:
         CxPlatRecvDataReturn(RecvDataChain);
     }
 
+    static void
+    UdpSegmentedRecvCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* Context,
+        _In_ CXPLAT_RECV_DATA* RecvDataChain
+        )
+    {
+        UdpSegmentedRecvContext* RecvContext = (UdpSegmentedRecvContext*)Context;
+        ASSERT_NE(nullptr, RecvContext);
+
+        for (CXPLAT_RECV_DATA* RecvData = RecvDataChain;
+            RecvData != NULL;
+            RecvData = RecvData->Next) {
+            if (RecvData->BufferLength != RecvContext->SegmentSize ||
+                memcmp(RecvData->Buffer, ExpectedData, RecvData->BufferLength) != 0) {
+                InterlockedIncrement(&RecvContext->BadCount);
+            }
+            if ((uint32_t)InterlockedIncrement(&RecvContext->ReceivedCount) ==
+                RecvContext->ExpectedCount) {
+                CxPlatEventSet(RecvContext->Completion);
+            }
+        }
+
+        CxPlatRecvDataReturn(RecvDataChain);
+    }
+
+    static void
+    UdpSteeringRecvCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* Context,
+        _In_ CXPLAT_RECV_DATA* RecvDataChain
+        )
+    {
+        UdpSteeringRecvContext* RecvContext = (UdpSteeringRecvContext*)Context;
+        RecvContext->PartitionIndex = RecvDataChain->PartitionIndex;
+        CxPlatRecvDataReturn(RecvDataChain);
+        CxPlatEventSet(RecvContext->Completion);
+    }
+
     static void
     EmptyAcceptCallback(
         _In_ CXPLAT_SOCKET* /* ListenerSocket */,
@@ -348,6 +425,16 @@ protected:
         EmptyUnreachableCallback,
     };
 
+    const CXPLAT_UDP_DATAPATH_CALLBACKS UdpSegmentedRecvCallbacks = {
+        UdpSegmentedRecvCallback,
+        EmptyUnreachableCallback,
+    };
+
+    const CXPLAT_UDP_DATAPATH_CALLBACKS UdpSteeringRecvCallbacks = {
+        UdpSteeringRecvCallback,
+        EmptyUnreachableCallback,
+    };
+
     const CXPLAT_TCP_DATAPATH_CALLBACKS EmptyTcpCallbacks = {
         EmptyAcceptCallback,
         EmptyConnectCallback,
@@ -721,6 +808,101 @@ TEST_P(DataPathTest, UdpDataECT0)
     ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.ClientCompletion, 2000));
 }
 
+TEST_P(DataPathTest, UdpDataSegmented)
+{
+    UdpSegmentedRecvContext RecvContext;
+    RecvContext.SegmentSize = 1000;
+    RecvContext.ExpectedCount = 20;
+    CxPlatDataPath Datapath(&UdpSegmentedRecvCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+    if (!(Datapath.GetSupportedFeatures() & CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION)) {
+        std::cout << "SKIP: Send Segmentation Feature Unsupported" << std::endl;
+        return;
+    }
+
+    auto serverAddress = GetNewLocalAddr();
+    CxPlatSocket Server(Datapath, &serverAddress.SockAddr, nullptr, &RecvContext);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        serverAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.CreateUdp(Datapath, &serverAddress.SockAddr, nullptr, &RecvContext);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+    serverAddress.SockAddr = Server.GetLocalAddress();
+
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, nullptr);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    //
+    // A single segmented send, which is delivered either as individual
+    // datagrams or, with receive coalescing, as one coalesced receive that the
+    // datapath splits back into datagrams.
+    //
+    auto ClientSendData =
+        CxPlatSendDataAlloc(Client, CXPLAT_ECN_NON_ECT, RecvContext.SegmentSize, &Client.Route);
+    ASSERT_NE(nullptr, ClientSendData);
+    for (uint32_t i = 0; i < RecvContext.ExpectedCount; ++i) {
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, RecvContext.SegmentSize);
+        ASSERT_NE(nullptr, ClientBuffer);
+        memcpy(ClientBuffer->Buffer, ExpectedData, RecvContext.SegmentSize);
+    }
+
+    VERIFY_QUIC_SUCCESS(Client.Send(ClientSendData));
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Completion, 2000));
+    ASSERT_EQ(0, RecvContext.BadCount);
+}
+
+TEST_P(DataPathTest, UdpDataSendBatch)
+{
+    UdpSegmentedRecvContext RecvContext;
+    RecvContext.SegmentSize = 1000;
+    RecvContext.ExpectedCount = 16;
+    CxPlatDataPath Datapath(&UdpSegmentedRecvCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    auto serverAddress = GetNewLocalAddr();
+    CxPlatSocket Server(Datapath, &serverAddress.SockAddr, nullptr, &RecvContext);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        serverAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.CreateUdp(Datapath, &serverAddress.SockAddr, nullptr, &RecvContext);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+    serverAddress.SockAddr = Server.GetLocalAddress();
+
+    CxPlatSocket Client(Datapath, nullptr, &serverAddress.SockAddr, nullptr);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    CXPLAT_SEND_DATA* ClientSendData[16];
+    for (uint32_t i = 0; i < RecvContext.ExpectedCount; ++i) {
+        ClientSendData[i] =
+            CxPlatSendDataAlloc(Client, CXPLAT_ECN_NON_ECT, 0, &Client.Route);
+        ASSERT_NE(nullptr, ClientSendData[i]);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData[i], RecvContext.SegmentSize);
+        ASSERT_NE(nullptr, ClientBuffer);
+        memcpy(ClientBuffer->Buffer, ExpectedData, RecvContext.SegmentSize);
+    }
+
+    //
+    // Individual sends issued inside a (nested) send batch must all be handed
+    // to the kernel once the outermost batch ends.
+    //
+    CxPlatSocketSendBatchBegin();
+    CxPlatSocketSendBatchBegin();
+    for (uint32_t i = 0; i < RecvContext.ExpectedCount; ++i) {
+        EXPECT_EQ(QUIC_STATUS_SUCCESS, Client.Send(ClientSendData[i]));
+    }
+    CxPlatSocketSendBatchEnd();
+    CxPlatSocketSendBatchEnd();
+
+    ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Completion, 2000));
+    ASSERT_EQ(0, RecvContext.BadCount);
+}
+
 TEST_P(DataPathTest, UdpShareClientSocket)
 {
     UdpRecvContext RecvContext;
@@ -780,6 +962,98 @@ TEST_P(DataPathTest, UdpShareClientSocket)
     CxPlatEventReset(RecvContext.ClientCompletion);
 }
 
+#if !defined(QUIC_USE_RAW_DATAPATH) && defined(CX_PLATFORM_LINUX)
+//
+// Whether the kernel lets this process load the eBPF program that steers
+// received packets by the partition in their CID.
+//
+bool
+CidSteeringSupported()
+{
+    struct bpf_insn Program[] = {
+        { BPF_ALU64 | BPF_MOV | BPF_K, BPF_REG_0, 0, 0, 0 },
+        { BPF_JMP | BPF_EXIT, 0, 0, 0, 0 }
+    };
+    union bpf_attr Attr;
+    CxPlatZeroMemory(&Attr, sizeof(Attr));
+    Attr.prog_type = BPF_PROG_TYPE_SOCKET_FILTER;
+    Attr.insns = (uint64_t)(size_t)Program;
+    Attr.insn_cnt = ARRAYSIZE(Program);
+    Attr.license = (uint64_t)(size_t)"MIT";
+    int ProgramFd = (int)syscall(__NR_bpf, BPF_PROG_LOAD, &Attr, sizeof(Attr));
+    if (ProgramFd < 0) {
+        return false;
+    }
+    close(ProgramFd);
+    return true;
+}
+
+TEST_P(DataPathTest, UdpCidSteering)
+{
+    if (!CidSteeringSupported()) {
+        std::cout << "SKIP: eBPF Unsupported" << std::endl;
+        return;
+    }
+
+    UdpSteeringRecvContext RecvContext;
+    CxPlatDataPath Datapath(&UdpSteeringRecvCallbacks);
+    VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+    ASSERT_NE(nullptr, Datapath.Datapath);
+
+    //
+    // A server socket with a receiving socket per processor, steered by a
+    // partition ID found after a 3 byte server ID, of which only the low byte
+    // selects the partition.
+    //
+    const uint16_t PartitionCount = (uint16_t)CxPlatProcMaxCount();
+    const uint8_t PartitionIdOffset = 3;
+    auto serverAddress = GetNewLocalAddr();
+    CXPLAT_UDP_CONFIG UdpConfig = {0};
+    UdpConfig.LocalAddress = &serverAddress.SockAddr;
+    UdpConfig.Flags = CXPLAT_SOCKET_FLAG_SHARE;
+    UdpConfig.CallbackContext = &RecvContext;
+    UdpConfig.PartitionCount = PartitionCount;
+    UdpConfig.PartitionMask = 0xFF;
+    UdpConfig.PartitionIdOffset = PartitionIdOffset;
+    CxPlatSocket Server;
+    Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    while (Server.GetInitStatus() == QUIC_STATUS_ADDRESS_IN_USE) {
+        serverAddress.SockAddr.Ipv4.sin_port = GetNextPort();
+        Server.InitStatus = CxPlatSocketCreateUdp(Datapath, &UdpConfig, &Server.Socket);
+    }
+    VERIFY_QUIC_SUCCESS(Server.GetInitStatus());
+    ASSERT_NE(nullptr, Server.Socket);
+    QUIC_ADDR ServerAddress;
+    CxPlatSocketGetLocalAddress(Server, &ServerAddress);
+
+    CxPlatSocket Client(Datapath, nullptr, &ServerAddress, nullptr);
+    VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+    ASSERT_NE(nullptr, Client.Socket);
+
+    for (uint16_t i = 0; i < PartitionCount && i < 8; ++i) {
+        //
+        // Short header packets are received on the socket of the partition
+        // encoded in their destination CID, in host byte order.
+        //
+        const uint16_t PartitionId = 0xA500 | (uint16_t)(PartitionCount - 1 - i);
+        auto ClientSendData = CxPlatSendDataAlloc(Client, CXPLAT_ECN_NON_ECT, 0, &Client.Route);
+        ASSERT_NE(nullptr, ClientSendData);
+        auto ClientBuffer = CxPlatSendDataAllocBuffer(ClientSendData, ExpectedDataSize);
+        ASSERT_NE(nullptr, ClientBuffer);
+        CxPlatZeroMemory(ClientBuffer->Buffer, ExpectedDataSize);
+        ClientBuffer->Buffer[0] = 0x40;
+        CxPlatCopyMemory(
+            ClientBuffer->Buffer + 1 + PartitionIdOffset,
+            &PartitionId,
+            sizeof(PartitionId));
+
+        VERIFY_QUIC_SUCCESS(Client.Send(ClientSendData));
+        ASSERT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Completion, 2000));
+        ASSERT_EQ((PartitionId & 0xFF) % PartitionCount, RecvContext.PartitionIndex);
+    }
+}
+#endif
+
 #if WIN32
 TEST_F(DataPathTest, TcpListener)
 {
@@ -945,3 +1219,252 @@ TEST_P(DataPathTest, TcpDataServer)
 #endif // WIN32
 
 INSTANTIATE_TEST_SUITE_P(DataPathTest, DataPathTest, ::testing::Values(4, 6), testing::PrintToStringParamName());
+
+#if defined(QUIC_USE_RAW_DATAPATH) && defined(CX_PLATFORM_LINUX)
+
+//
+// Runs the AF_XDP datapath over a veth pair, in generic (SKB) XDP mode. The
+// peer end of the pair lives in its own network namespace, where a plain UDP
+// socket echoes the datagrams back, so the traffic really crosses the veth
+// instead of being short-circuited by the local routing table. Requires
+// CAP_NET_ADMIN (and iproute2); skipped otherwise.
+//
+
+#define XDP_VETH_NETNS      "msquicxdp"
+#define XDP_VETH_LOCAL      "msquicxdp0"
+#define XDP_VETH_PEER       "msquicxdp1"
+#define XDP_VETH_LOCAL_IP   "10.250.0.1"
+#define XDP_VETH_PEER_IP    "10.250.0.2"
+#define XDP_VETH_PEER_PORT  4433
+#define XDP_VETH_ECHO_COUNT 8
+
+struct XdpVethRecvContext {
+    QUIC_ADDR PeerAddress;
+    volatile long ReceivedCount {0};
+    volatile long BadCount {0};
+    CXPLAT_EVENT Completion;
+    XdpVethRecvContext() {
+        CxPlatEventInitialize(&Completion, FALSE, FALSE);
+    }
+    ~XdpVethRecvContext() {
+        CxPlatEventUninitialize(Completion);
+    }
+};
+
+struct XdpVethRouteContext {
+    CXPLAT_ROUTE* Route;
+    BOOLEAN Succeeded {FALSE};
+    CXPLAT_EVENT Completion;
+    XdpVethRouteContext(CXPLAT_ROUTE* _Route) : Route(_Route) {
+        CxPlatEventInitialize(&Completion, TRUE, FALSE);
+    }
+    ~XdpVethRouteContext() {
+        CxPlatEventUninitialize(Completion);
+    }
+};
+
+struct DataPathXdpTest : public ::testing::Test
+{
+protected:
+    bool VethCreated {false};
+    bool IniCreated {false};
+    pid_t EchoPid {-1};
+
+    static bool Run(const char* Command) {
+        std::string Quiet = std::string(Command) + " > /dev/null 2>&1";
+        return system(Quiet.c_str()) == 0;
+    }
+
+    void SetUp() override {
+        Run("ip netns del " XDP_VETH_NETNS);
+        if (!Run("ip netns add " XDP_VETH_NETNS)) {
+            GTEST_SKIP() << "Creating a network namespace failed (requires CAP_NET_ADMIN)";
+        }
+        VethCreated = true;
+        if (!Run("ip link add " XDP_VETH_LOCAL " type veth peer name " XDP_VETH_PEER " netns " XDP_VETH_NETNS) ||
+            !Run("ip addr add " XDP_VETH_LOCAL_IP "/24 dev " XDP_VETH_LOCAL) ||
+            !Run("ip link set " XDP_VETH_LOCAL " up") ||
+            !Run("ip -n " XDP_VETH_NETNS " addr add " XDP_VETH_PEER_IP "/24 dev " XDP_VETH_PEER) ||
+            !Run("ip -n " XDP_VETH_NETNS " link set " XDP_VETH_PEER " up")) {
+            GTEST_SKIP() << "Creating the veth pair failed";
+        }
+
+        //
+        // The XDP datapath reads its configuration from xdp.ini in the
+        // working directory. Don't clobber a user provided one.
+        //
+        if (access("xdp.ini", F_OK) == 0) {
+            GTEST_SKIP() << "xdp.ini already exists in the working directory";
+        }
+        FILE* Ini = fopen("xdp.ini", "w");
+        ASSERT_NE(nullptr, Ini);
+        IniCreated = true;
+        fprintf(Ini, "Interface=" XDP_VETH_LOCAL "\nForceGeneric=1\n");
+        fclose(Ini);
+
+        StartEcho();
+    }
+
+    void TearDown() override {
+        if (EchoPid > 0) {
+            kill(EchoPid, SIGKILL);
+            waitpid(EchoPid, nullptr, 0);
+        }
+        if (IniCreated) {
+            remove("xdp.ini");
+        }
+        if (VethCreated) {
+            Run("ip netns del " XDP_VETH_NETNS); // Also deletes the veth pair.
+        }
+    }
+
+    //
+    // Forks a child which joins the peer namespace and echoes every datagram
+    // it receives on XDP_VETH_PEER_PORT. Returns once the child is bound.
+    //
+    void StartEcho() {
+        int Ready[2];
+        ASSERT_EQ(0, pipe(Ready));
+        EchoPid = fork();
+        ASSERT_NE(-1, EchoPid);
+        if (EchoPid == 0) {
+            close(Ready[0]);
+            prctl(PR_SET_PDEATHSIG, SIGKILL);
+            int Ns = open("/var/run/netns/" XDP_VETH_NETNS, O_RDONLY);
+            if (Ns < 0 || setns(Ns, CLONE_NEWNET) != 0) {
+                _exit(1);
+            }
+            int Fd = socket(AF_INET, SOCK_DGRAM, 0);
+            struct sockaddr_in Addr = {};
+            Addr.sin_family = AF_INET;
+            Addr.sin_port = htons(XDP_VETH_PEER_PORT);
+            inet_pton(AF_INET, XDP_VETH_PEER_IP, &Addr.sin_addr);
+            if (Fd < 0 || bind(Fd, (struct sockaddr*)&Addr, sizeof(Addr)) != 0) {
+                _exit(1);
+            }
+            char Signal = 1;
+            if (write(Ready[1], &Signal, 1) != 1) {
+                _exit(1);
+            }
+            char Buffer[2048];
+            for (;;) {
+                struct sockaddr_in From;
+                socklen_t FromLength = sizeof(From);
+                ssize_t Length =
+                    recvfrom(Fd, Buffer, sizeof(Buffer), 0, (struct sockaddr*)&From, &FromLength);
+                if (Length > 0) {
+                    sendto(Fd, Buffer, (size_t)Length, 0, (struct sockaddr*)&From, FromLength);
+                }
+            }
+        }
+        close(Ready[1]);
+        char Signal = 0;
+        ASSERT_EQ(1, read(Ready[0], &Signal, 1));
+        close(Ready[0]);
+    }
+
+    static void
+    RecvCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* Context,
+        _In_ CXPLAT_RECV_DATA* RecvDataChain
+        )
+    {
+        XdpVethRecvContext* RecvContext = (XdpVethRecvContext*)Context;
+        for (CXPLAT_RECV_DATA* RecvData = RecvDataChain;
+            RecvData != NULL;
+            RecvData = RecvData->Next) {
+            if (!QuicAddrCompare(&RecvData->Route->RemoteAddress, &RecvContext->PeerAddress) ||
+                RecvData->BufferLength != ExpectedDataSize ||
+                memcmp(RecvData->Buffer, ExpectedData, ExpectedDataSize) != 0) {
+                InterlockedIncrement(&RecvContext->BadCount);
+            } else if (InterlockedIncrement(&RecvContext->ReceivedCount) == XDP_VETH_ECHO_COUNT) {
+                CxPlatEventSet(RecvContext->Completion);
+            }
+        }
+        CxPlatRecvDataReturn(RecvDataChain);
+    }
+
+    static void
+    UnreachableCallback(
+        _In_ CXPLAT_SOCKET* /* Socket */,
+        _In_ void* /* Context */,
+        _In_ const QUIC_ADDR* /* RemoteAddress */
+        )
+    {
+    }
+
+    _IRQL_requires_max_(DISPATCH_LEVEL)
+    _Function_class_(CXPLAT_ROUTE_RESOLUTION_CALLBACK)
+    static void
+    RouteResolutionCallback(
+        _In_ void* Context,
+        _When_(Succeeded == FALSE, _Reserved_)
+        _When_(Succeeded == TRUE, _In_reads_bytes_(6))
+            uint8_t* PhysicalAddress,
+        _In_ uint8_t PathId,
+        _In_ BOOLEAN Succeeded
+        )
+    {
+        XdpVethRouteContext* RouteContext = (XdpVethRouteContext*)Context;
+        if (Succeeded) {
+            CxPlatResolveRouteComplete(nullptr, RouteContext->Route, PhysicalAddress, PathId);
+        }
+        RouteContext->Succeeded = Succeeded;
+        CxPlatEventSet(RouteContext->Completion);
+    }
+};
+
+TEST_F(DataPathXdpTest, VethEcho)
+{
+    ExpectedData = (char*)CXPLAT_ALLOC_NONPAGED(ExpectedDataSize, QUIC_POOL_TEST);
+    ASSERT_NE(nullptr, ExpectedData);
+    for (uint32_t i = 0; i < ExpectedDataSize; ++i) {
+        ExpectedData[i] = (char)i;
+    }
+
+    const CXPLAT_UDP_DATAPATH_CALLBACKS Callbacks = { RecvCallback, UnreachableCallback };
+    XdpVethRecvContext RecvContext;
+    ASSERT_TRUE(QuicAddrFromString(XDP_VETH_PEER_IP, XDP_VETH_PEER_PORT, &RecvContext.PeerAddress));
+
+    {
+        CxPlatDataPath Datapath(&Callbacks);
+        VERIFY_QUIC_SUCCESS(Datapath.GetInitStatus());
+
+        CxPlatSocket Client(Datapath, nullptr, &RecvContext.PeerAddress, &RecvContext);
+        VERIFY_QUIC_SUCCESS(Client.GetInitStatus());
+
+        //
+        // Resolves the next hop through the kernel routing and neighbor
+        // tables, which requires an ARP exchange over the veth.
+        //
+        XdpVethRouteContext RouteContext(&Client.Route);
+        QUIC_STATUS Status =
+            CxPlatResolveRoute(Client, &Client.Route, 0, &RouteContext, RouteResolutionCallback);
+        if (Status == QUIC_STATUS_PENDING) {
+            ASSERT_TRUE(CxPlatEventWaitWithTimeout(RouteContext.Completion, 5000));
+            ASSERT_TRUE(RouteContext.Succeeded);
+        } else {
+            VERIFY_QUIC_SUCCESS(Status);
+        }
+        ASSERT_EQ(RouteResolved, Client.Route.State);
+
+        for (uint32_t i = 0; i < XDP_VETH_ECHO_COUNT; ++i) {
+            auto SendData = CxPlatSendDataAlloc(Client, CXPLAT_ECN_NON_ECT, 0, &Client.Route);
+            ASSERT_NE(nullptr, SendData);
+            auto Buffer = CxPlatSendDataAllocBuffer(SendData, ExpectedDataSize);
+            ASSERT_NE(nullptr, Buffer);
+            memcpy(Buffer->Buffer, ExpectedData, ExpectedDataSize);
+            VERIFY_QUIC_SUCCESS(Client.Send(Client.Route, SendData));
+        }
+
+        EXPECT_TRUE(CxPlatEventWaitWithTimeout(RecvContext.Completion, 5000));
+        EXPECT_EQ(XDP_VETH_ECHO_COUNT, RecvContext.ReceivedCount);
+        EXPECT_EQ(0, RecvContext.BadCount);
+    }
+
+    CXPLAT_FREE(ExpectedData, QUIC_POOL_TEST);
+    ExpectedData = nullptr;
+}
+
+#endif // QUIC_USE_RAW_DATAPATH && CX_PLATFORM_LINUX
@@ -51,3 +51,135 @@ TEST(PlatformTest, QuicAddrParsing)
     }
 }
 
+
+#if !defined(_WIN32) && !defined(_KERNEL_MODE)
+
+#define POOL_TEST_ENTRIES 4096
+
+struct PoolTestContext {
+    CXPLAT_POOL* Pool;
+    void** Entries;
+};
+
+static CXPLAT_THREAD_CALLBACK(PoolFreeThread, Context)
+{
+    PoolTestContext* Ctx = (PoolTestContext*)Context;
+    for (uint32_t i = 0; i < POOL_TEST_ENTRIES; ++i) {
+        CxPlatPoolFree(Ctx->Pool, Ctx->Entries[i]);
+    }
+    CXPLAT_THREAD_RETURN(0);
+}
+
+TEST(PlatformTest, PoolReuse)
+{
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, 64, QUIC_POOL_TEST, &Pool);
+
+    void* Entries[CXPLAT_POOL_MAGAZINE_SIZE];
+    for (uint32_t i = 0; i < ARRAYSIZE(Entries); ++i) {
+        ASSERT_NE(nullptr, Entries[i] = CxPlatPoolAlloc(&Pool));
+    }
+    for (uint32_t i = 0; i < ARRAYSIZE(Entries); ++i) {
+        CxPlatPoolFree(&Pool, Entries[i]);
+    }
+
+    CXPLAT_POOL_STATS Stats;
+    CxPlatPoolGetStats(&Pool, &Stats);
+    ASSERT_EQ((uint32_t)ARRAYSIZE(Entries), Stats.Depth);
+    ASSERT_EQ(0ull, Stats.Hits);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(Entries); ++i) {
+        ASSERT_NE(nullptr, Entries[i] = CxPlatPoolAlloc(&Pool));
+    }
+    CxPlatPoolGetStats(&Pool, &Stats);
+    ASSERT_EQ(0u, Stats.Depth);
+    ASSERT_EQ((uint64_t)ARRAYSIZE(Entries), Stats.Hits);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(Entries); ++i) {
+        CxPlatPoolFree(&Pool, Entries[i]);
+    }
+    CxPlatPoolUninitialize(&Pool);
+}
+
+TEST(PlatformTest, PoolCrossThreadFree)
+{
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, 64, QUIC_POOL_TEST, &Pool);
+
+    void** Entries = new void*[POOL_TEST_ENTRIES];
+    for (uint32_t i = 0; i < POOL_TEST_ENTRIES; ++i) {
+        ASSERT_NE(nullptr, Entries[i] = CxPlatPoolAlloc(&Pool));
+    }
+
+    //
+    // Free everything on another thread; the entries get back to this thread
+    // through the depot.
+    //
+    PoolTestContext Context = { &Pool, Entries };
+    CXPLAT_THREAD_CONFIG Config = {
+        0,
+        0,
+        "PoolFree",
+        PoolFreeThread,
+        &Context
+    };
+    CXPLAT_THREAD Thread;
+    VERIFY_QUIC_SUCCESS(CxPlatThreadCreate(&Config, &Thread));
+    CxPlatThreadWait(&Thread);
+    CxPlatThreadDelete(&Thread);
+
+    CXPLAT_POOL_STATS Stats;
+    CxPlatPoolGetStats(&Pool, &Stats);
+    ASSERT_LE(Stats.Depth, (uint32_t)CXPLAT_POOL_MAXIMUM_DEPTH + 2 * CXPLAT_POOL_MAGAZINE_SIZE);
+    ASSERT_GE(Stats.Depth, (uint32_t)CXPLAT_POOL_DEFAULT_DEPTH);
+
+    const uint64_t HitsBefore = Stats.Hits;
+    for (uint32_t i = 0; i < POOL_TEST_ENTRIES; ++i) {
+        ASSERT_NE(nullptr, Entries[i] = CxPlatPoolAlloc(&Pool));
+    }
+    CxPlatPoolGetStats(&Pool, &Stats);
+    ASSERT_GE(Stats.Hits - HitsBefore, (uint64_t)CXPLAT_POOL_DEFAULT_DEPTH);
+
+    for (uint32_t i = 0; i < POOL_TEST_ENTRIES; ++i) {
+        CxPlatPoolFree(&Pool, Entries[i]);
+    }
+    delete[] Entries;
+    CxPlatPoolUninitialize(&Pool);
+}
+
+TEST(PlatformTest, PoolLargeEntryBytesBounded)
+{
+    const uint32_t Size = 64 * 1024;
+    const uint32_t Count = 256;
+    CXPLAT_POOL Pool;
+    CxPlatPoolInitialize(FALSE, Size, QUIC_POOL_TEST, &Pool);
+
+    void** Entries = new void*[Count];
+    for (uint32_t i = 0; i < Count; ++i) {
+        ASSERT_NE(nullptr, Entries[i] = CxPlatPoolAlloc(&Pool));
+    }
+
+    //
+    // Let the depot grow as far as it will, then free everything: what's
+    // cached is bounded by bytes, not by CXPLAT_POOL_MAXIMUM_DEPTH entries.
+    //
+    for (uint32_t i = 0; i < CXPLAT_POOL_DEPOT_SIZE; ++i) {
+        CxPlatPoolFree(&Pool, CxPlatPoolAlloc(&Pool));
+    }
+    for (uint32_t i = 0; i < Count; ++i) {
+        CxPlatPoolFree(&Pool, Entries[i]);
+    }
+
+    CXPLAT_POOL_STATS Stats;
+    CxPlatPoolGetStats(&Pool, &Stats);
+    ASSERT_NE(0u, Stats.Depth);
+    ASSERT_LE((uint64_t)Stats.MaxDepth * Size, (uint64_t)CXPLAT_POOL_MAXIMUM_BYTES);
+    ASSERT_LE(
+        (uint64_t)Stats.Depth * Size,
+        (uint64_t)CXPLAT_POOL_MAXIMUM_BYTES + 2 * CXPLAT_POOL_MAGAZINE_BYTES);
+
+    delete[] Entries;
+    CxPlatPoolUninitialize(&Pool);
+}
+
+#endif
@@ -232,18 +232,21 @@ EXT_COMMAND(
     Dml("\tOutstanding Packets  ");
 
     auto Loss = Conn.GetLossDetection();
-    auto SendPackets = Loss.GetSendPackets();
+    auto SentPacketsCount = Loss.SentPacketsCount();
 
-    if (SendPackets == 0) {
+    if (SentPacketsCount == 0) {
         Dml("NONE\n");
     } else {
-        while (SendPackets && !CheckControlC()) {
-            auto Packet = SentPacketMetadata(SendPackets);
+        for (UINT32 i = 0; i < SentPacketsCount && !CheckControlC(); i++) {
+            auto SentPacket = Loss.GetSentPacket(i);
+            if (SentPacket == 0) {
+                continue;
+            }
+            auto Packet = SentPacketMetadata(SentPacket);
             Dml("<link cmd=\"!quicpacket 0x%I64X\">%I64u</link>\n"
                 "\t                     ",
                 Packet.Addr,
                 Packet.PacketNumber());
-            SendPackets = Packet.Next();
         }
         Dml("\n");
     }
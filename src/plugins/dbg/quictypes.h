@@ -185,6 +185,12 @@ typedef union QUIC_CONNECTION_STATE {
         //
         BOOLEAN UseRoundRobinStreamScheduling : 1;
 
+        //
+        // Indicates the connection is using the RFC 9218 extensible priority
+        // stream scheduling scheme.
+        //
+        BOOLEAN UseExtensiblePriorityStreamScheduling : 1;
+
         //
         // Indicates that this connection has resumption enabled and needs to
         // keep the TLS state and transport parameters until it is done sending
@@ -429,10 +435,6 @@ struct CidHashEntry : Struct {
 
     CidHashEntry(ULONG64 Addr) : Struct("msquic!QUIC_CID_HASH_ENTRY", Addr) { }
 
-    static CidHashEntry FromEntry(ULONG64 EntryAddr) {
-        return CidHashEntry(LinkEntryToType(EntryAddr, "msquic!QUIC_CID_HASH_ENTRY", "Entry"));
-    }
-
     static CidHashEntry FromLink(ULONG64 LinkAddr) {
         return CidHashEntry(LinkEntryToType(LinkAddr, "msquic!QUIC_CID_HASH_ENTRY", "Link"));
     }
@@ -941,8 +943,23 @@ struct LossDetection : Struct {
         return ReadType<UINT32>("RttVariance"); // Microseconds
     }
 
-    ULONG64 GetSendPackets() {
-        return ReadPointer("SentPackets");
+    UINT32 SentPacketsCount() {
+        return ReadType<UINT32>("SentPackets.Count");
+    }
+
+    //
+    // Returns the outstanding packet at the given offset from the head of the
+    // SentPackets ring, or 0 if the slot is a hole.
+    //
+    ULONG64 GetSentPacket(UINT32 Offset) {
+        ULONG64 Slots = ReadPointer("SentPackets.Slots");
+        UINT32 Capacity = ReadType<UINT32>("SentPackets.Capacity");
+        UINT32 Head = ReadType<UINT32>("SentPackets.Head");
+        ULONG64 Packet = 0;
+        ReadPointerAtAddr(
+            Slots + ((Head + Offset) & (Capacity - 1)) * g_ExtInstance.m_PtrSize,
+            &Packet);
+        return Packet;
     }
 
     ULONG64 GetLostPackets() {
@@ -964,6 +981,7 @@ typedef enum QUIC_API_TYPE {
     QUIC_API_TYPE_STRM_SEND,
     QUIC_API_TYPE_STRM_RECV_COMPLETE,
     QUIC_API_TYPE_STRM_RECV_SET_ENABLED,
+    QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS,
 
     QUIC_API_TYPE_SET_PARAM,
     QUIC_API_TYPE_GET_PARAM,
@@ -1004,6 +1022,8 @@ struct ApiCall : Struct {
             return "API_TYPE_STRM_RECV_COMPLETE";
         case QUIC_API_TYPE_STRM_RECV_SET_ENABLED:
             return "API_TYPE_STRM_RECV_SET_ENABLED";
+        case QUIC_API_TYPE_STRM_PROVIDE_RECV_BUFFERS:
+            return "API_TYPE_STRM_PROVIDE_RECV_BUFFERS";
         case QUIC_API_TYPE_SET_PARAM:
             return "API_SET_PARAM";
         case QUIC_API_TYPE_GET_PARAM:
@@ -1397,12 +1417,48 @@ struct Registration : Struct {
     }
 };
 
+struct CidTable : Struct {
+
+    ULONG SlotCount;
+    ULONG SlotSize;
+    ULONG EntryOffset;
+    ULONG Index;
+
+    CidTable(ULONG64 Addr) : Struct("msquic!QUIC_CID_TABLE", Addr) {
+        SlotCount = Addr == 0 ? 0 : ReadType<ULONG>("Mask") + 1;
+        SlotSize = GetTypeSize("msquic!QUIC_CID_SLOT");
+        GetFieldOffset("msquic!QUIC_CID_SLOT", "Entry", &EntryOffset);
+        Index = 0;
+    }
+
+    //
+    // Returns the next QUIC_CID_HASH_ENTRY in the slot array, skipping empty
+    // slots and tombstones.
+    //
+    bool GetNextEntry(ULONG64* Entry) {
+        ULONG64 Slots = AddrOf("Slots");
+        while (Index < SlotCount) {
+            ULONG64 SlotEntry = 0;
+            ReadPointerAtAddr(Slots + Index++ * SlotSize + EntryOffset, &SlotEntry);
+            if (SlotEntry > 1) {
+                *Entry = SlotEntry;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 struct LookupHashTable : Struct {
 
     LookupHashTable(ULONG64 Addr) : Struct("msquic!QUIC_PARTITIONED_HASHTABLE", Addr) { }
 
+    UINT32 NumEntries() {
+        return ReadType<UINT32>("NumEntries");
+    }
+
     ULONG64 GetTablePtr() {
-        return AddrOf("Table"); // TODO - Need Hash Table Enumeration.
+        return ReadPointer("Table");
     }
 };
 
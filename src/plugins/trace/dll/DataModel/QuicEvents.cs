@@ -39,7 +39,9 @@ namespace QuicTrace.DataModel
         StreamSend,
         StreamReceiveComplete,
         StreamReceiveSetEnabled,
-        StreamDatagramSend
+        StreamDatagramSend,
+        StreamProvideReceiveBuffers,
+        DatagramSendBatch
     }
 
     public enum QuicConnectionState
@@ -124,6 +126,7 @@ namespace QuicTrace.DataModel
         ApiStreamSend,
         ApiStreamReceiveComplete,
         ApiStreamReceiveSetEnabled,
+        ApiStreamProvideReceiveBuffers,
         ApiSetParam,
         ApiGetParam,
         ApiDatagramSend,
@@ -197,6 +197,12 @@ QuicTestLoadBalancedHandshake(
     _In_ int Family
     );
 
+void
+QuicTestQuicLbConnectionIds(
+    _In_ int Family,
+    _In_ bool Encrypted
+    );
+
 void
 QuicTestClientSharedLocalPort(
     _In_ int Family
@@ -437,6 +443,10 @@ void
 QuicTestStreamPriorityInfiniteLoop(
     );
 
+void
+QuicTestStreamPriorityUrgency(
+    );
+
 void
 QuicTestStreamDifferentAbortErrors(
     );
@@ -449,6 +459,19 @@ void
 QuicTestStreamAbortConnFlowControl(
     );
 
+void
+QuicTestSendBufferStatistics(
+    );
+
+void
+QuicTestRecvWindowAutoTune(
+    _In_ bool MemoryLimited
+    );
+
+void
+QuicTestProvideRecvBuffersAfterData(
+    );
+
 //
 // QuicDrill tests
 //
@@ -484,6 +507,16 @@ QuicTestDatagramSend(
     _In_ int Family
     );
 
+void
+QuicTestDatagramDrop(
+    _In_ int Family
+    );
+
+void
+QuicTestDatagramSendBatch(
+    _In_ int Family
+    );
+
 //
 // Platform Specific Functions
 //
@@ -998,4 +1031,34 @@ typedef struct {
 #define IOCTL_QUIC_RUN_STREAM_PRIORITY_INFINITE_LOOP \
     QUIC_CTL_CODE(86, METHOD_BUFFERED, FILE_WRITE_DATA)
 
-#define QUIC_MAX_IOCTL_FUNC_CODE 86
+#define IOCTL_QUIC_RUN_STREAM_PRIORITY_URGENCY \
+    QUIC_CTL_CODE(87, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_DATAGRAM_DROP \
+    QUIC_CTL_CODE(88, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_DATAGRAM_SEND_BATCH \
+    QUIC_CTL_CODE(89, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_SEND_BUFFER_STATISTICS \
+    QUIC_CTL_CODE(90, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+typedef struct {
+    int Family;
+    uint8_t Encrypted;
+} QUIC_RUN_QUIC_LB_CONNECTION_IDS;
+
+#define IOCTL_QUIC_RUN_QUIC_LB_CONNECTION_IDS \
+    QUIC_CTL_CODE(91, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // QUIC_RUN_QUIC_LB_CONNECTION_IDS
+
+#define IOCTL_QUIC_RUN_RECV_WINDOW_AUTO_TUNE \
+    QUIC_CTL_CODE(92, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // uint8_t - MemoryLimited
+
+#define IOCTL_QUIC_RUN_PROVIDE_RECV_BUFFERS_AFTER_DATA \
+    QUIC_CTL_CODE(93, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define QUIC_MAX_IOCTL_FUNC_CODE 93
@@ -1184,6 +1184,32 @@ TEST_P(WithFamilyArgs, LoadBalanced) {
         QuicTestLoadBalancedHandshake(GetParam().Family);
     }
 }
+
+TEST_P(WithFamilyArgs, QuicLbPlaintextConnectionIds) {
+    TestLoggerT<ParamType> Logger("QuicTestQuicLbConnectionIds", GetParam());
+    if (TestingKernelMode) {
+        QUIC_RUN_QUIC_LB_CONNECTION_IDS Params = {
+            GetParam().Family,
+            0
+        };
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_QUIC_LB_CONNECTION_IDS, Params));
+    } else {
+        QuicTestQuicLbConnectionIds(GetParam().Family, false);
+    }
+}
+
+TEST_P(WithFamilyArgs, QuicLbEncryptedConnectionIds) {
+    TestLoggerT<ParamType> Logger("QuicTestQuicLbConnectionIds", GetParam());
+    if (TestingKernelMode) {
+        QUIC_RUN_QUIC_LB_CONNECTION_IDS Params = {
+            GetParam().Family,
+            1
+        };
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_QUIC_LB_CONNECTION_IDS, Params));
+    } else {
+        QuicTestQuicLbConnectionIds(GetParam().Family, true);
+    }
+}
 #endif // QUIC_TEST_DATAPATH_HOOKS_ENABLED
 
 TEST_P(WithSendArgs1, Send) {
@@ -1597,6 +1623,15 @@ TEST(Misc, StreamPriorityInfiniteLoop) {
     }
 }
 
+TEST(Misc, StreamPriorityUrgency) {
+    TestLogger Logger("StreamPriorityUrgency");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_PRIORITY_URGENCY));
+    } else {
+        QuicTestStreamPriorityUrgency();
+    }
+}
+
 TEST(Misc, StreamDifferentAbortErrors) {
     TestLogger Logger("StreamDifferentAbortErrors");
     if (TestingKernelMode) {
@@ -1624,6 +1659,34 @@ TEST(Misc, StreamAbortConnFlowControl) {
     }
 }
 
+TEST(Misc, SendBufferStatistics) {
+    TestLogger Logger("SendBufferStatistics");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_SEND_BUFFER_STATISTICS));
+    } else {
+        QuicTestSendBufferStatistics();
+    }
+}
+
+TEST_P(WithBool, RecvWindowAutoTune) {
+    TestLoggerT<ParamType> Logger("QuicTestRecvWindowAutoTune", GetParam());
+    if (TestingKernelMode) {
+        uint8_t Param = (uint8_t)GetParam();
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_RECV_WINDOW_AUTO_TUNE, Param));
+    } else {
+        QuicTestRecvWindowAutoTune(GetParam());
+    }
+}
+
+TEST(Misc, ProvideRecvBuffersAfterData) {
+    TestLogger Logger("QuicTestProvideRecvBuffersAfterData");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_PROVIDE_RECV_BUFFERS_AFTER_DATA));
+    } else {
+        QuicTestProvideRecvBuffersAfterData();
+    }
+}
+
 TEST(Drill, VarIntEncoder) {
     TestLogger Logger("QuicDrillTestVarIntEncoder");
     if (TestingKernelMode) {
@@ -1685,6 +1748,24 @@ TEST_P(WithFamilyArgs, DatagramSend) {
     }
 }
 
+TEST_P(WithFamilyArgs, DatagramDrop) {
+    TestLoggerT<ParamType> Logger("QuicTestDatagramDrop", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_DATAGRAM_DROP, GetParam().Family));
+    } else {
+        QuicTestDatagramDrop(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, DatagramSendBatch) {
+    TestLoggerT<ParamType> Logger("QuicTestDatagramSendBatch", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_DATAGRAM_SEND_BATCH, GetParam().Family));
+    } else {
+        QuicTestDatagramSendBatch(GetParam().Family);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterValidation,
     WithBool,
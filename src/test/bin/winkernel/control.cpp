@@ -457,6 +457,13 @@ size_t QUIC_IOCTL_BUFFER_SIZES[] =
     sizeof(QUIC_RUN_CRED_VALIDATION),
     sizeof(QUIC_RUN_CIBIR_EXTENSION),
     0,
+    0,
+    sizeof(INT32),
+    sizeof(INT32),
+    0,
+    sizeof(QUIC_RUN_QUIC_LB_CONNECTION_IDS),
+    sizeof(UINT8),
+    0,
 };
 
 CXPLAT_STATIC_ASSERT(
@@ -489,6 +496,8 @@ typedef union {
     QUIC_RUN_REBIND_PARAMS RebindParams;
     UINT8 RejectByClosing;
     QUIC_RUN_CIBIR_EXTENSION CibirParams;
+    QUIC_RUN_QUIC_LB_CONNECTION_IDS QuicLbParams;
+    UINT8 MemoryLimited;
 
 } QUIC_IOCTL_PARAMS;
 
@@ -1186,6 +1195,45 @@ QuicTestCtlEvtIoDeviceControl(
         QuicTestCtlRun(QuicTestStreamPriorityInfiniteLoop());
         break;
 
+    case IOCTL_QUIC_RUN_STREAM_PRIORITY_URGENCY:
+        QuicTestCtlRun(QuicTestStreamPriorityUrgency());
+        break;
+
+    case IOCTL_QUIC_RUN_DATAGRAM_DROP:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestDatagramDrop(
+                Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_DATAGRAM_SEND_BATCH:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestDatagramSendBatch(
+                Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_SEND_BUFFER_STATISTICS:
+        QuicTestCtlRun(QuicTestSendBufferStatistics());
+        break;
+
+    case IOCTL_QUIC_RUN_QUIC_LB_CONNECTION_IDS:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestQuicLbConnectionIds(
+                Params->QuicLbParams.Family,
+                Params->QuicLbParams.Encrypted != 0));
+        break;
+
+    case IOCTL_QUIC_RUN_RECV_WINDOW_AUTO_TUNE:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestRecvWindowAutoTune(Params->MemoryLimited != 0));
+        break;
+
+    case IOCTL_QUIC_RUN_PROVIDE_RECV_BUFFERS_AFTER_DATA:
+        QuicTestCtlRun(QuicTestProvideRecvBuffersAfterData());
+        break;
+
     default:
         Status = STATUS_NOT_IMPLEMENTED;
         break;
@@ -2052,6 +2052,49 @@ QuicTestValidateParamApi()
             QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
             &BufferSize,
             (void*)&LoadBalancingMode));
+
+    LoadBalancingMode = QUIC_LOAD_BALANCING_COUNT;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_INVALID_PARAMETER,
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
+            sizeof(LoadBalancingMode),
+            (void*)&LoadBalancingMode));
+
+    QUIC_LOAD_BALANCING_CONFIG LbConfig;
+    BufferSize = sizeof(LbConfig) - 1;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            &BufferSize,
+            (void*)&LbConfig));
+    TEST_EQUAL(BufferSize, sizeof(LbConfig));
+
+    for (uint8_t i = 0; i < sizeof(LbConfig.Key); ++i) {
+        LbConfig.Key[i] = 0xFF;
+    }
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            &BufferSize,
+            (void*)&LbConfig));
+    for (uint8_t i = 0; i < sizeof(LbConfig.Key); ++i) {
+        TEST_EQUAL(LbConfig.Key[i], 0); // The key is never returned.
+    }
+
+    LbConfig.ConfigId = QUIC_LOAD_BALANCING_MAX_CONFIG_ID + 1;
+    LbConfig.ServerIdLength = 1;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_INVALID_PARAMETER,
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(LbConfig),
+            (void*)&LbConfig));
 }
 
 static
@@ -2459,6 +2459,66 @@ QuicTestStreamPriorityInfiniteLoop(
     TEST_TRUE(Context.AllReceivesComplete.WaitTimeout(TestWaitTimeout));
 }
 
+void
+QuicTestStreamPriorityUrgency(
+    )
+{
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(3), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    StreamPriorityTestContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, StreamPriorityTestContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+
+    QUIC_STREAM_SCHEDULING_SCHEME Value = QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY;
+    TEST_QUIC_SUCCEEDED(Connection.SetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, sizeof(Value), &Value));
+
+    uint8_t RawBuffer[100];
+    QUIC_BUFFER Buffer { sizeof(RawBuffer), RawBuffer };
+
+    MsQuicStream Stream1(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream1.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream1.SetPriority(QUIC_STREAM_PRIORITY_FROM_URGENCY(6, FALSE)));
+    TEST_QUIC_SUCCEEDED(Stream1.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream Stream2(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream2.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream2.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    MsQuicStream Stream3(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream3.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream3.SetPriority(QUIC_STREAM_PRIORITY_FROM_URGENCY(2, TRUE)));
+    TEST_QUIC_SUCCEEDED(Stream3.Send(&Buffer, 1, QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN));
+
+    TEST_QUIC_SUCCEEDED(Stream1.SetPriority(QUIC_STREAM_PRIORITY_FROM_URGENCY(0, FALSE))); // Change to most urgent
+
+    QUIC_STREAM_SCHEDULING_SCHEME Scheme;
+    uint32_t SchemeLength = sizeof(Scheme);
+    TEST_QUIC_SUCCEEDED(Connection.GetParam(QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME, &SchemeLength, &Scheme));
+    TEST_EQUAL(QUIC_STREAM_SCHEDULING_SCHEME_EXTENSIBLE_PRIORITY, Scheme);
+
+    TEST_QUIC_SUCCEEDED(Connection.StartLocalhost(ClientConfiguration, ServerLocalAddr));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    TEST_TRUE(Context.AllReceivesComplete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.ReceiveEvents[0] == Stream1.ID());
+    TEST_TRUE(Context.ReceiveEvents[1] == Stream3.ID());
+    TEST_TRUE(Context.ReceiveEvents[2] == Stream2.ID());
+}
+
 struct StreamDifferentAbortErrors {
     QUIC_UINT62 PeerSendAbortErrorCode {0};
     QUIC_UINT62 PeerRecvAbortErrorCode {0};
@@ -2657,3 +2717,380 @@ QuicTestStreamAbortConnFlowControl(
 
     TEST_TRUE(Context.ClientStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
 }
+
+struct SendBufferStatisticsContext {
+    CxPlatEvent AllSendsComplete;
+    CxPlatEvent ClientStreamShutdownComplete;
+    uint32_t SendsComplete {0};
+    uint32_t SendCount {0};
+
+    static QUIC_STATUS ClientStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (SendBufferStatisticsContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE) {
+            if (++TestContext->SendsComplete == TestContext->SendCount) {
+                TestContext->AllSendsComplete.Set();
+            }
+        } else if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+            TestContext->ClientStreamShutdownComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void*, _Inout_ QUIC_STREAM_EVENT* Event) {
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            return QUIC_STATUS_PENDING; // Never consume, so flow control stays closed.
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestSendBufferStatistics(
+    )
+{
+    const uint32_t SmallSendLength = 500;
+    const uint32_t SmallSendCount = 10;
+    const uint32_t LargeSendLength = 100000;
+    const uint64_t SharedSlabSize = 4096; // Small sends are coalesced into 4KB slabs.
+
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(1).SetConnFlowControlWindow(100), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetSendBufferingEnabled(true), MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    SendBufferStatisticsContext Context;
+    Context.SendCount = SmallSendCount + 1;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, SendBufferStatisticsContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.StartLocalhost(ClientConfiguration, ServerLocalAddr));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    QUIC_STATISTICS_V2 Stats;
+    TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    TEST_EQUAL(0ull, Stats.SendBufferBytes);
+
+    //
+    // The server never reads and only allows 100 bytes of connection flow
+    // control, so no send request is fully acknowledged and all of them stay
+    // in the send buffer, even though buffering completes them right away.
+    //
+    UniquePtr<uint8_t[]> RawBuffer(new(std::nothrow) uint8_t[LargeSendLength]);
+    TEST_NOT_EQUAL(nullptr, RawBuffer.get());
+    QUIC_BUFFER SmallBuffer { SmallSendLength, RawBuffer.get() };
+    QUIC_BUFFER LargeBuffer { LargeSendLength, RawBuffer.get() };
+
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL, CleanUpManual, SendBufferStatisticsContext::ClientStreamCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    for (uint32_t i = 0; i < SmallSendCount; ++i) {
+        TEST_QUIC_SUCCEEDED(Stream.Send(&SmallBuffer, 1, i == 0 ? QUIC_SEND_FLAG_START : QUIC_SEND_FLAG_NONE));
+    }
+    TEST_QUIC_SUCCEEDED(Stream.Send(&LargeBuffer, 1, QUIC_SEND_FLAG_NONE));
+    TEST_TRUE(Context.AllSendsComplete.WaitTimeout(TestWaitTimeout));
+
+    const uint64_t Buffered = SmallSendLength * SmallSendCount + LargeSendLength;
+    TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    TEST_EQUAL(Buffered, Stats.SendBufferBytes);
+    TEST_TRUE(Stats.SendBufferAllocatedBytes >= Stats.SendBufferBytes);
+    TEST_TRUE(Stats.SendBufferAllocatedBytes <= Stats.SendBufferBytes + 2 * SharedSlabSize);
+
+    //
+    // Aborting the stream frees its requests. Only the (empty) shared slab is
+    // still held.
+    //
+    TEST_QUIC_SUCCEEDED(Stream.Shutdown(0, QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND));
+    TEST_TRUE(Context.ClientStreamShutdownComplete.WaitTimeout(TestWaitTimeout));
+
+    TEST_QUIC_SUCCEEDED(Connection.GetStatistics(&Stats));
+    TEST_EQUAL(0ull, Stats.SendBufferBytes);
+    TEST_TRUE(Stats.SendBufferAllocatedBytes <= SharedSlabSize);
+}
+
+//
+// Sets the library's receive window memory budget for the duration of a test.
+//
+struct RecvWindowMemoryLimitScope {
+    uint16_t PreviousLimit {0};
+    RecvWindowMemoryLimitScope(uint16_t Limit) noexcept {
+        QUIC_GLOBAL_SETTINGS Settings{};
+        uint32_t BufferLength = sizeof(Settings);
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->GetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_GLOBAL_SETTINGS,
+                &BufferLength,
+                &Settings));
+        PreviousLimit = Settings.RecvWindowMemoryLimit;
+        Set(Limit);
+    }
+    ~RecvWindowMemoryLimitScope() noexcept {
+        Set(PreviousLimit);
+    }
+    static void Set(uint16_t Limit) noexcept {
+        QUIC_GLOBAL_SETTINGS Settings{};
+        Settings.RecvWindowMemoryLimit = Limit;
+        Settings.IsSet.RecvWindowMemoryLimit = TRUE;
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_GLOBAL_SETTINGS,
+                sizeof(Settings),
+                &Settings));
+    }
+};
+
+struct RecvWindowAutoTuneContext {
+    CxPlatEvent ServerReceiveComplete;
+    MsQuicConnection* ServerConnection {nullptr};
+    QUIC_STATUS StatsStatus {QUIC_STATUS_INVALID_STATE};
+    QUIC_STATISTICS_V2 ServerStats{};
+    uint64_t BytesReceived {0};
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (RecvWindowAutoTuneContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            TestContext->BytesReceived += Event->RECEIVE.TotalBufferLength;
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            //
+            // Everything has been received and delivered, so the windows are
+            // done growing.
+            //
+            TestContext->StatsStatus =
+                TestContext->ServerConnection->GetStatistics(&TestContext->ServerStats);
+            TestContext->ServerReceiveComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection* Connection, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (RecvWindowAutoTuneContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            TestContext->ServerConnection = Connection;
+            new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestRecvWindowAutoTune(
+    _In_ bool MemoryLimited
+    )
+{
+    const uint32_t ConnWindow = 0x20000; // 128KB, twice the default stream window.
+    const uint32_t StreamWindow = 0x10000; // Default stream window.
+    const uint32_t SendLength = 0x100000;
+    const uint32_t SendCount = 16;
+
+    //
+    // With no budget at all, the connection window can't grow past its
+    // initial size, and so neither can the stream windows it caps. Otherwise,
+    // allow all of memory so other tests' connections can't use it up.
+    //
+    RecvWindowMemoryLimitScope LimitScope(MemoryLimited ? 0 : UINT16_MAX);
+
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(1).SetConnFlowControlWindow(ConnWindow), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    RecvWindowAutoTuneContext Context;
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, RecvWindowAutoTuneContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.StartLocalhost(ClientConfiguration, ServerLocalAddr));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    //
+    // The transfer is limited by the small initial windows, so the server's
+    // app drains a full window each round trip, which is what auto-tuning
+    // measures as a high BDP.
+    //
+    UniquePtr<uint8_t[]> RawBuffer(new(std::nothrow) uint8_t[SendLength]);
+    TEST_NOT_EQUAL(nullptr, RawBuffer.get());
+    QUIC_BUFFER Buffer { SendLength, RawBuffer.get() };
+
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    for (uint32_t i = 0; i < SendCount; ++i) {
+        QUIC_SEND_FLAGS Flags = i == 0 ? QUIC_SEND_FLAG_START : QUIC_SEND_FLAG_NONE;
+        if (i == SendCount - 1) {
+            Flags |= QUIC_SEND_FLAG_FIN;
+        }
+        TEST_QUIC_SUCCEEDED(Stream.Send(&Buffer, 1, Flags));
+    }
+
+    TEST_TRUE(Context.ServerReceiveComplete.WaitTimeout(TestWaitTimeout));
+    TEST_QUIC_SUCCEEDED(Context.StatsStatus);
+    TEST_EQUAL((uint64_t)SendLength * SendCount, Context.BytesReceived);
+
+    const QUIC_STATISTICS_V2& Stats = Context.ServerStats;
+    if (MemoryLimited) {
+        TEST_EQUAL((uint64_t)ConnWindow, Stats.RecvConnFlowControlWindow);
+        TEST_TRUE(Stats.RecvMaxStreamFlowControlWindow <= ConnWindow);
+    } else {
+        TEST_TRUE(Stats.RecvConnFlowControlWindow > ConnWindow);
+        TEST_TRUE(Stats.RecvMaxStreamFlowControlWindow > ConnWindow);
+        TEST_TRUE(Stats.RecvWindowAutoTuneCount >= 2);
+    }
+    TEST_TRUE(Stats.RecvMaxStreamFlowControlWindow >= StreamWindow);
+}
+
+const uint32_t ProvideRecvEarlyLength = 0x2000;
+const uint32_t ProvideRecvLateLength = 0x10000;
+const uint32_t ProvideRecvAppBufferLength = 0x20000;
+
+struct ProvideRecvBuffersContext {
+    CxPlatEvent ServerStreamStarted;
+    CxPlatEvent EarlyDataReceived;
+    CxPlatEvent ServerReceiveComplete;
+    MsQuicStream* ServerStream {nullptr};
+    UniquePtr<uint8_t[]> AppMemory {new(std::nothrow) uint8_t[ProvideRecvAppBufferLength]};
+    uint64_t BytesReceived {0};
+    uint64_t BytesInAppMemory {0};
+    bool DataValid {true};
+
+    static QUIC_STATUS ServerStreamCallback(_In_ MsQuicStream*, _In_opt_ void* Context, _Inout_ QUIC_STREAM_EVENT* Event) {
+        auto TestContext = (ProvideRecvBuffersContext*)Context;
+        if (Event->Type == QUIC_STREAM_EVENT_RECEIVE) {
+            uint64_t Offset = Event->RECEIVE.AbsoluteOffset;
+            for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
+                const QUIC_BUFFER* Buffer = &Event->RECEIVE.Buffers[i];
+                for (uint32_t j = 0; j < Buffer->Length; ++j) {
+                    if (Buffer->Buffer[j] != (uint8_t)(Offset + j)) {
+                        TestContext->DataValid = false;
+                    }
+                }
+                if (Buffer->Buffer >= TestContext->AppMemory.get() &&
+                    Buffer->Buffer < TestContext->AppMemory.get() + ProvideRecvAppBufferLength) {
+                    TestContext->BytesInAppMemory += Buffer->Length;
+                }
+                Offset += Buffer->Length;
+            }
+            TestContext->BytesReceived += Event->RECEIVE.TotalBufferLength;
+            if (TestContext->BytesReceived == ProvideRecvEarlyLength) {
+                TestContext->EarlyDataReceived.Set();
+            }
+        } else if (Event->Type == QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN) {
+            TestContext->ServerReceiveComplete.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    static QUIC_STATUS ConnCallback(_In_ MsQuicConnection*, _In_opt_ void* Context, _Inout_ QUIC_CONNECTION_EVENT* Event) {
+        auto TestContext = (ProvideRecvBuffersContext*)Context;
+        if (Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+            //
+            // Buffers aren't provided from the callback, so the first data is
+            // received before the stream has any.
+            //
+            TestContext->ServerStream =
+                new(std::nothrow) MsQuicStream(Event->PEER_STREAM_STARTED.Stream, CleanUpAutoDelete, ServerStreamCallback, Context);
+            TestContext->ServerStreamStarted.Set();
+        }
+        return QUIC_STATUS_SUCCESS;
+    }
+};
+
+void
+QuicTestProvideRecvBuffersAfterData(
+    )
+{
+    //
+    // Declared first, so the server stream is gone before its buffers are.
+    //
+    ProvideRecvBuffersContext Context;
+    TEST_NOT_EQUAL(nullptr, Context.AppMemory.get());
+
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", MsQuicSettings().SetPeerUnidiStreamCount(1), ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, ProvideRecvBuffersContext::ConnCallback, &Context);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest"));
+    QuicAddr ServerLocalAddr;
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.StartLocalhost(ClientConfiguration, ServerLocalAddr));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+
+    const uint32_t SendLength =
+        ProvideRecvEarlyLength + ProvideRecvLateLength;
+    UniquePtr<uint8_t[]> RawBuffer(new(std::nothrow) uint8_t[SendLength]);
+    TEST_NOT_EQUAL(nullptr, RawBuffer.get());
+    for (uint32_t i = 0; i < SendLength; ++i) {
+        RawBuffer[i] = (uint8_t)i;
+    }
+    QUIC_BUFFER EarlyBuffer { ProvideRecvEarlyLength, RawBuffer.get() };
+    QUIC_BUFFER LateBuffer {
+        ProvideRecvLateLength,
+        RawBuffer.get() + ProvideRecvEarlyLength };
+
+    //
+    // The peer sends within the initial window before any buffers are
+    // provided. That data is received into internal buffers.
+    //
+    MsQuicStream Stream(Connection, QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL);
+    TEST_QUIC_SUCCEEDED(Stream.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Stream.Send(&EarlyBuffer, 1, QUIC_SEND_FLAG_START));
+    TEST_TRUE(Context.ServerStreamStarted.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.EarlyDataReceived.WaitTimeout(TestWaitTimeout));
+    TEST_EQUAL(0ull, Context.BytesInAppMemory);
+
+    //
+    // Off the worker thread, the buffers are added asynchronously.
+    //
+    QUIC_BUFFER AppBuffers[] = {
+        { ProvideRecvAppBufferLength / 2, Context.AppMemory.get() },
+        { ProvideRecvAppBufferLength / 2,
+          Context.AppMemory.get() + ProvideRecvAppBufferLength / 2 }
+    };
+    TEST_EQUAL(
+        QUIC_STATUS_PENDING,
+        Context.ServerStream->ProvideReceiveBuffers(ARRAYSIZE(AppBuffers), AppBuffers));
+
+    //
+    // Everything sent afterwards lands in the app's buffers.
+    //
+    TEST_QUIC_SUCCEEDED(Stream.Send(&LateBuffer, 1, QUIC_SEND_FLAG_FIN));
+    TEST_TRUE(Context.ServerReceiveComplete.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Context.DataValid);
+    TEST_EQUAL((uint64_t)SendLength, Context.BytesReceived);
+    TEST_EQUAL((uint64_t)ProvideRecvLateLength, Context.BytesInAppMemory);
+}
@@ -263,3 +263,226 @@ QuicTestDatagramSend(
         }
     }
 }
+
+void
+QuicTestDatagramDrop(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings Settings;
+    Settings.SetDatagramReceiveEnabled(true);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicSettings ClientSettings;
+    ClientSettings.SetDatagramSendTtlMs(50);
+    ClientSettings.SetDatagramSendQueueLimit(2);
+    ClientSettings.SetDatagramSendDropPolicy(QUIC_DATAGRAM_DROP_OLDEST);
+
+    uint8_t RawBuffer[] = "datagram";
+    QUIC_BUFFER DatagramBuffer = { sizeof(RawBuffer), RawBuffer };
+
+    {
+        TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+        TEST_TRUE(Listener.IsValid());
+
+        QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+        QuicAddr ServerLocalAddr(QuicAddrFamily);
+        TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        {
+            UniquePtr<TestConnection> Server;
+            ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+            Listener.Context = &ServerAcceptCtx;
+
+            {
+                TestConnection Client(Registration);
+                TEST_TRUE(Client.IsValid());
+                TEST_QUIC_SUCCEEDED(Client.SetSettings(ClientSettings));
+
+                //
+                // Datagrams queued before the handshake are held until the
+                // peer's transport parameters arrive. The first one expires
+                // while it waits.
+                //
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->DatagramSend(
+                        Client.GetConnection(),
+                        &DatagramBuffer,
+                        1,
+                        QUIC_SEND_FLAG_DGRAM_EXPIRE,
+                        nullptr));
+
+                CxPlatSleep(100);
+
+                //
+                // Queuing the second one fills the queue. The third one finds
+                // the queue full, which removes the expired datagram. The
+                // fourth one then causes the oldest (the second) to be dropped.
+                //
+                for (uint32_t i = 0; i < 3; ++i) {
+                    TEST_QUIC_SUCCEEDED(
+                        MsQuic->DatagramSend(
+                            Client.GetConnection(),
+                            &DatagramBuffer,
+                            1,
+                            QUIC_SEND_FLAG_NONE,
+                            nullptr));
+                }
+
+                uint32_t Tries = 0;
+                while (Client.GetDatagramsCanceled() != 2 && ++Tries < 10) {
+                    CxPlatSleep(100);
+                }
+                TEST_EQUAL(2, Client.GetDatagramsCanceled());
+
+                TEST_QUIC_SUCCEEDED(
+                    Client.Start(
+                        ClientConfiguration,
+                        QuicAddrFamily,
+                        QUIC_LOCALHOST_FOR_AF(QuicAddrFamily),
+                        ServerLocalAddr.GetPort()));
+
+                if (!Client.WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Client.GetIsConnected());
+
+                TEST_NOT_EQUAL(nullptr, Server);
+                if (!Server->WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Server->GetIsConnected());
+
+                Tries = 0;
+                while (Client.GetDatagramsSent() != 2 && ++Tries < 10) {
+                    CxPlatSleep(100);
+                }
+                TEST_EQUAL(2, Client.GetDatagramsSent());
+                TEST_EQUAL(2, Client.GetDatagramsCanceled());
+
+                QUIC_STATISTICS_V2 Stats = Client.GetStatistics();
+                TEST_EQUAL(1, Stats.SendDatagramsExpired);
+                TEST_EQUAL(1, Stats.SendDatagramsDropped);
+
+                Client.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, QUIC_TEST_NO_ERROR);
+                if (!Client.WaitForShutdownComplete()) {
+                    return;
+                }
+
+                TEST_FALSE(Client.GetPeerClosed());
+                TEST_FALSE(Client.GetTransportClosed());
+            }
+        }
+    }
+}
+
+void
+QuicTestDatagramSendBatch(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings Settings;
+    Settings.SetDatagramReceiveEnabled(true);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    uint8_t RawBuffer[] = "datagram";
+    QUIC_BUFFER DatagramBuffer = { sizeof(RawBuffer), RawBuffer };
+
+    {
+        TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+        TEST_TRUE(Listener.IsValid());
+
+        QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+        QuicAddr ServerLocalAddr(QuicAddrFamily);
+        TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        {
+            UniquePtr<TestConnection> Server;
+            ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+            Listener.Context = &ServerAcceptCtx;
+
+            {
+                TestConnection Client(Registration);
+                TEST_TRUE(Client.IsValid());
+
+                TEST_QUIC_SUCCEEDED(
+                    Client.Start(
+                        ClientConfiguration,
+                        QuicAddrFamily,
+                        QUIC_LOCALHOST_FOR_AF(QuicAddrFamily),
+                        ServerLocalAddr.GetPort()));
+
+                if (!Client.WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Client.GetIsConnected());
+
+                TEST_NOT_EQUAL(nullptr, Server);
+                if (!Server->WaitForConnectionComplete()) {
+                    return;
+                }
+                TEST_TRUE(Server->GetIsConnected());
+
+                //
+                // Only the entries with a valid connection and buffers are
+                // queued; the rest fail individually without affecting them.
+                //
+                QUIC_DATAGRAM_SEND_ENTRY Entries[] = {
+                    { Client.GetConnection(), &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, QUIC_STATUS_SUCCESS },
+                    { Client.GetConnection(), &DatagramBuffer, 0, QUIC_SEND_FLAG_NONE, nullptr, QUIC_STATUS_SUCCESS },
+                    { Client.GetConnection(), &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, QUIC_STATUS_SUCCESS },
+                    { nullptr, &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, QUIC_STATUS_SUCCESS },
+                    { Server->GetConnection(), &DatagramBuffer, 1, QUIC_SEND_FLAG_NONE, nullptr, QUIC_STATUS_SUCCESS },
+                };
+
+                TEST_EQUAL(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->DatagramSendBatch(ARRAYSIZE(Entries), Entries));
+                TEST_EQUAL(QUIC_STATUS_PENDING, Entries[0].Status);
+                TEST_EQUAL(QUIC_STATUS_INVALID_PARAMETER, Entries[1].Status);
+                TEST_EQUAL(QUIC_STATUS_PENDING, Entries[2].Status);
+                TEST_EQUAL(QUIC_STATUS_INVALID_PARAMETER, Entries[3].Status);
+                TEST_EQUAL(QUIC_STATUS_PENDING, Entries[4].Status);
+
+                uint32_t Tries = 0;
+                while ((Client.GetDatagramsSent() != 2 || Server->GetDatagramsSent() != 1) && ++Tries < 10) {
+                    CxPlatSleep(100);
+                }
+                TEST_EQUAL(2, Client.GetDatagramsSent());
+                TEST_EQUAL(1, Server->GetDatagramsSent());
+
+                Client.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, QUIC_TEST_NO_ERROR);
+                if (!Client.WaitForShutdownComplete()) {
+                    return;
+                }
+
+                TEST_FALSE(Client.GetPeerClosed());
+                TEST_FALSE(Client.GetTransportClosed());
+            }
+        }
+    }
+}
@@ -2730,6 +2730,228 @@ QuicTestLoadBalancedHandshake(
     Listeners.ValidateLoadBalancing();
 }
 
+//
+// Restores the global load balancing mode once everything using it is closed.
+//
+struct LoadBalancingModeScope {
+    uint16_t PreviousMode {QUIC_LOAD_BALANCING_DISABLED};
+    LoadBalancingModeScope() noexcept {
+        uint32_t BufferLength = sizeof(PreviousMode);
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->GetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
+                &BufferLength,
+                &PreviousMode));
+    }
+    ~LoadBalancingModeScope() noexcept {
+        TEST_QUIC_SUCCEEDED(
+            MsQuic->SetParam(
+                nullptr,
+                QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
+                sizeof(PreviousMode),
+                &PreviousMode));
+    }
+};
+
+//
+// Decodes the server's connection IDs the way a QUIC-LB load balancer would:
+// the source CIDs of its long header packets (including Retry) and the
+// destination CIDs of the short header packets sent to it.
+//
+struct QuicLbCidValidator : public DatapathHook
+{
+    const QUIC_LOAD_BALANCING_CONFIG& Config;
+    const uint8_t CidLength;
+    const uint16_t ServerPort;
+    CXPLAT_BLOCK_KEY* Key {nullptr};
+    CXPLAT_DISPATCH_LOCK Lock;
+    uint32_t LongHeaderCount {0};
+    uint32_t RetryCount {0};
+    uint32_t ShortHeaderCount {0};
+    uint32_t InvalidCount {0};
+    CxPlatEvent ShortHeaderEvent {true};
+    QuicLbCidValidator(
+        _In_ const QUIC_LOAD_BALANCING_CONFIG& Config,
+        _In_ bool Encrypted,
+        _In_ uint16_t ServerPort
+        ) :
+        Config(Config),
+        //
+        // The first octet and one AES block, or the first octet, server ID,
+        // 2 byte partition ID and 7 byte payload.
+        //
+        CidLength((uint8_t)(Encrypted ? 1 + CXPLAT_BLOCK_LENGTH : 1 + Config.ServerIdLength + 9)),
+        ServerPort(ServerPort) {
+        CxPlatDispatchLockInitialize(&Lock);
+        if (Encrypted) {
+            TEST_QUIC_SUCCEEDED(CxPlatBlockKeyCreate(Config.Key, &Key));
+        }
+        DatapathHooks::Instance->AddHook(this);
+    }
+    ~QuicLbCidValidator() {
+        DatapathHooks::Instance->RemoveHook(this);
+        CxPlatBlockKeyFree(Key);
+        CxPlatDispatchLockUninitialize(&Lock);
+    }
+    bool
+    IsRoutable(
+        _In_reads_(Length) const uint8_t* Cid,
+        _In_ uint8_t Length
+        ) {
+        if (Length != CidLength ||
+            (Cid[0] >> 5) != Config.ConfigId ||
+            (Cid[0] & 0x1F) + 1 != Length) {
+            return false;
+        }
+        uint8_t Decrypted[CXPLAT_BLOCK_LENGTH];
+        const uint8_t* ServerId = Cid + 1;
+        if (Key != nullptr) {
+            if (QUIC_FAILED(CxPlatBlockDecrypt(Key, Cid + 1, Decrypted))) {
+                return false;
+            }
+            ServerId = Decrypted;
+        }
+        return memcmp(ServerId, Config.ServerId, Config.ServerIdLength) == 0;
+    }
+    _IRQL_requires_max_(DISPATCH_LEVEL)
+    BOOLEAN
+    Receive(
+        _Inout_ struct CXPLAT_RECV_DATA* Datagram
+        ) {
+        const uint8_t* Buffer = Datagram->Buffer;
+        const uint16_t Length = Datagram->BufferLength;
+        if (QuicAddrGetPort(&Datagram->Route->RemoteAddress) == ServerPort) {
+            //
+            // Long header from the server: flags, version, DCID, SCID.
+            //
+            if (Length < 7 || !(Buffer[0] & 0x80)) {
+                return FALSE;
+            }
+            uint32_t Version;
+            CxPlatCopyMemory(&Version, Buffer + 1, sizeof(Version));
+            const uint16_t SourceCidOffset = (uint16_t)(7 + Buffer[5]);
+            if (Version == 0 || SourceCidOffset > Length ||
+                SourceCidOffset + Buffer[SourceCidOffset - 1] > Length) {
+                return FALSE; // Version negotiation or malformed
+            }
+            CxPlatDispatchLockAcquire(&Lock);
+            if (Version == QUIC_VERSION_1 && ((Buffer[0] >> 4) & 0x3) == 3) {
+                RetryCount++;
+            }
+            LongHeaderCount++;
+            if (!IsRoutable(Buffer + SourceCidOffset, Buffer[SourceCidOffset - 1])) {
+                InvalidCount++;
+            }
+            CxPlatDispatchLockRelease(&Lock);
+
+        } else if (QuicAddrGetPort(&Datagram->Route->LocalAddress) == ServerPort &&
+                   !(Buffer[0] & 0x80) && Length > CidLength) {
+            //
+            // Short header to the server: the DCID immediately follows the
+            // flags, and its length is in its own first octet.
+            //
+            CxPlatDispatchLockAcquire(&Lock);
+            ShortHeaderCount++;
+            if (!IsRoutable(Buffer + 1, (uint8_t)((Buffer[1] & 0x1F) + 1))) {
+                InvalidCount++;
+            }
+            CxPlatDispatchLockRelease(&Lock);
+            ShortHeaderEvent.Set();
+        }
+        return FALSE;
+    }
+};
+
+void
+QuicTestQuicLbConnectionIds(
+    _In_ int Family,
+    _In_ bool Encrypted
+    )
+{
+    QUIC_LOAD_BALANCING_CONFIG LbConfig = {0};
+    LbConfig.ConfigId = 1;
+    LbConfig.ServerIdLength = 3;
+    LbConfig.ServerId[0] = 0x12;
+    LbConfig.ServerId[1] = 0x34;
+    LbConfig.ServerId[2] = 0x56;
+    CxPlatRandom(sizeof(LbConfig.Key), LbConfig.Key);
+    const uint16_t LbMode =
+        Encrypted ?
+            QUIC_LOAD_BALANCING_QUIC_LB_ENCRYPTED :
+            QUIC_LOAD_BALANCING_QUIC_LB_PLAINTEXT;
+    const uint8_t CibirId[] = { 0 /* offset */, 4, 3, 2, 1 };
+
+    LoadBalancingModeScope ModeScope;
+
+    MsQuicRegistration Registration(true);
+    TEST_QUIC_SUCCEEDED(Registration.GetInitStatus());
+
+    MsQuicConfiguration ServerConfiguration(Registration, "MsQuicTest", ServerSelfSignedCredConfig);
+    TEST_QUIC_SUCCEEDED(ServerConfiguration.GetInitStatus());
+
+    MsQuicConfiguration ClientConfiguration(Registration, "MsQuicTest", MsQuicCredentialConfig());
+    TEST_QUIC_SUCCEEDED(ClientConfiguration.GetInitStatus());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+
+    //
+    // Set before the mode changes, to check ListenerStart rejects it.
+    //
+    MsQuicAutoAcceptListener CibirListener(Registration, ServerConfiguration, MsQuicConnection::NoOpCallback);
+    TEST_QUIC_SUCCEEDED(CibirListener.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(CibirListener.SetCibirId(CibirId, sizeof(CibirId)));
+
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_LOAD_BALANCING_CONFIG,
+            sizeof(LbConfig),
+            &LbConfig));
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE,
+            sizeof(LbMode),
+            &LbMode));
+
+    if (Encrypted) {
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_NOT_SUPPORTED,
+            CibirListener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+    }
+
+    MsQuicAutoAcceptListener Listener(Registration, ServerConfiguration, MsQuicConnection::NoOpCallback);
+    TEST_QUIC_SUCCEEDED(Listener.GetInitStatus());
+    if (Encrypted) {
+        TEST_QUIC_STATUS(
+            QUIC_STATUS_NOT_SUPPORTED,
+            Listener.SetCibirId(CibirId, sizeof(CibirId)));
+    }
+    TEST_QUIC_SUCCEEDED(Listener.Start("MsQuicTest", &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    QuicLbCidValidator Validator(LbConfig, Encrypted, ServerLocalAddr.GetPort());
+    StatelessRetryHelper RetryHelper(true);
+
+    MsQuicConnection Connection(Registration);
+    TEST_QUIC_SUCCEEDED(Connection.GetInitStatus());
+    TEST_QUIC_SUCCEEDED(Connection.StartLocalhost(ClientConfiguration, ServerLocalAddr));
+    TEST_TRUE(Connection.HandshakeCompleteEvent.WaitTimeout(TestWaitTimeout));
+    TEST_TRUE(Connection.HandshakeComplete);
+    TEST_TRUE(Validator.ShortHeaderEvent.WaitTimeout(TestWaitTimeout));
+
+    CxPlatDispatchLockAcquire(&Validator.Lock);
+    const uint32_t RetryCount = Validator.RetryCount;
+    const uint32_t LongHeaderCount = Validator.LongHeaderCount;
+    const uint32_t InvalidCount = Validator.InvalidCount;
+    CxPlatDispatchLockRelease(&Validator.Lock);
+    TEST_NOT_EQUAL(0u, RetryCount);
+    TEST_TRUE(LongHeaderCount > RetryCount);
+    TEST_EQUAL(0u, InvalidCount);
+}
+
 void
 QuicTestClientSharedLocalPort(
     _In_ int Family
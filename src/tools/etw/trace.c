@@ -91,7 +91,9 @@ const char* ApiTypeStr[] = {
     "STREAM_SEND",
     "STREAM_RECEIVE_COMPLETE",
     "STREAM_RECEIVE_SET_ENABLED",
-    "DATAGRAM_SEND"
+    "DATAGRAM_SEND",
+    "STREAM_PROVIDE_RECEIVE_BUFFERS",
+    "DATAGRAM_SEND_BATCH"
 };
 
 CXPLAT_STATIC_ASSERT(ARRAYSIZE(ApiTypeStr) == QUIC_API_COUNT, "Keep the count in sync with array");
@@ -308,6 +310,21 @@ QuicTraceGlobalEvent(
             case QUIC_PERF_COUNTER_SEND_STATELESS_RETRY:
                 printf("    Total stateless retry packets sent ever:            ");
                 break;
+            case QUIC_PERF_COUNTER_STRM_CACHE_HIT:
+                printf("    Total streams allocated from the stream cache:      ");
+                break;
+            case QUIC_PERF_COUNTER_STRM_CACHE_MISS:
+                printf("    Total streams allocated with the cache empty:       ");
+                break;
+            case QUIC_PERF_COUNTER_WORK_TIMER_WAKEUPS:
+                printf("    Total worker wakeups for an expired timer ever:     ");
+                break;
+            case QUIC_PERF_COUNTER_WORK_TIMER_SPINS:
+                printf("    Total worker timer wakeups spun for ever:           ");
+                break;
+            case QUIC_PERF_COUNTER_WORK_TIMER_LATENESS:
+                printf("    Total us worker timer wakeups were late ever:       ");
+                break;
             default:
                 printf("    Unknown:                                            ");
                 break;
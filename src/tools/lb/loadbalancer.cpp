@@ -6,23 +6,147 @@
 Abstract:
 
     Load balances QUIC traffic from a public address to a set of private
-    addresses. Requires the use of NAT'ing. Don't use in production.
+    addresses. Packets are routed by decoding the QUIC-LB server ID out of the
+    destination connection ID, so the backend choice needs no per-connection
+    state and survives client migration. Packets without a routable CID fall
+    back to a hash of the addresses.
+
+    The return path is NAT'ed: each client address and backend pair gets its
+    own socket to the backend. These entries expire once idle, and their
+    number is capped; packets from new clients are dropped while the table
+    is full.
 
 --*/
 
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include <mutex>
+#include <atomic>
 
 #include "quic_datapath.h"
+#include "quic_crypt.h"
 #include "quic_toeplitz.h"
 #include "msquichelper.h"
 
+enum LbMode {
+    LbModeHash,         // Only hash the addresses
+    LbModePlaintext,    // QUIC-LB plaintext server ID
+    LbModeEncrypted,    // QUIC-LB single pass encrypted server ID
+};
+
 bool Verbose = false;
 CXPLAT_DATAPATH* Datapath;
 struct LbInterface* PublicInterface;
 std::vector<QUIC_ADDR> PrivateAddrs;
 
+//
+// QUIC-LB config shared with the backends. Each backend's server ID is its
+// index in the private address list, encoded big endian.
+//
+LbMode Mode = LbModeHash;
+uint8_t ConfigId = 0;
+uint8_t ServerIdLength = 1;
+uint8_t LbKey[CXPLAT_BLOCK_LENGTH];
+
+std::atomic<uint64_t> CidRoutedCount;
+std::atomic<uint64_t> HashRoutedCount;
+
+//
+// NAT table limits: how long an entry may go unused, and how many there may be.
+//
+uint32_t NatIdleTimeoutS = 60;
+uint32_t NatMaxEntries = 16384;
+std::atomic<uint64_t> NatFullDropCount;
+std::atomic<uint64_t> NatExpiredCount;
+
+#define QUIC_LB_UNROUTABLE_CONFIG_ID    7
+#define QUIC_LB_ENCRYPTED_CID_LENGTH    (1 + CXPLAT_BLOCK_LENGTH)
+
+//
+// The block key can't be shared between receive threads, so each gets its own.
+//
+struct LbThreadKey {
+    CXPLAT_BLOCK_KEY* BlockKey {nullptr};
+    LbThreadKey() {
+        if (QUIC_FAILED(CxPlatBlockKeyCreate(LbKey, &BlockKey))) {
+            BlockKey = nullptr;
+        }
+    }
+    ~LbThreadKey() {
+        if (BlockKey) {
+            CxPlatBlockKeyFree(BlockKey);
+        }
+    }
+};
+
+//
+// Decodes the backend index out of the packet's destination CID. Returns false
+// if the CID isn't routable with the current config.
+//
+bool
+DecodeBackend(
+    _In_reads_(Length) const uint8_t* Packet,
+    _In_ uint16_t Length,
+    _Out_ uint32_t* Backend
+    )
+{
+    if (Mode == LbModeHash || Length < 1) {
+        return false;
+    }
+
+    const uint8_t* Cid;
+    uint16_t CidLength;
+    if (Packet[0] & 0x80) { // Long header
+        if (Length < 6 || Length < 6 + Packet[5]) {
+            return false;
+        }
+        Cid = Packet + 6;
+        CidLength = Packet[5];
+    } else {
+        Cid = Packet + 1;
+        CidLength = Length - 1;
+    }
+    if (CidLength < 1) {
+        return false;
+    }
+
+    const uint8_t CidConfigId = Cid[0] >> 5;
+    const uint16_t EncodedLength = (Cid[0] & 0x1F) + 1;
+    if (CidConfigId == QUIC_LB_UNROUTABLE_CONFIG_ID ||
+        CidConfigId != ConfigId ||
+        EncodedLength > CidLength) {
+        return false;
+    }
+
+    uint8_t Block[CXPLAT_BLOCK_LENGTH];
+    const uint8_t* ServerId = Cid + 1;
+    if (Mode == LbModeEncrypted) {
+        if (EncodedLength != QUIC_LB_ENCRYPTED_CID_LENGTH) {
+            return false;
+        }
+        thread_local LbThreadKey ThreadKey;
+        if (!ThreadKey.BlockKey ||
+            QUIC_FAILED(CxPlatBlockDecrypt(ThreadKey.BlockKey, Cid + 1, Block))) {
+            return false;
+        }
+        ServerId = Block;
+    } else if (EncodedLength < 1 + ServerIdLength) {
+        return false;
+    }
+
+    uint32_t Index = 0;
+    for (uint8_t i = 0; i < ServerIdLength; ++i) {
+        Index = (Index << 8) | ServerId[i];
+    }
+    if (Index >= PrivateAddrs.size()) {
+        return false;
+    }
+
+    *Backend = Index;
+    return true;
+}
+
 struct LbInterface {
     bool IsPublic;
     CXPLAT_SOCKET* Socket {nullptr};
@@ -97,6 +221,7 @@ struct LbInterface {
 //
 struct LbPrivateInterface : public LbInterface {
     const QUIC_ADDR PeerAddress {0};
+    std::atomic<uint64_t> LastUsedUs {CxPlatTimeUs64()};
 
     LbPrivateInterface(_In_ const QUIC_ADDR* PrivateAddress, _In_ const QUIC_ADDR* PeerAddress)
         : LbInterface(PrivateAddress, false), PeerAddress(*PeerAddress) {
@@ -109,6 +234,7 @@ struct LbPrivateInterface : public LbInterface {
     }
 
     void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) {
+        LastUsedUs.store(CxPlatTimeUs64(), std::memory_order_relaxed);
         PublicInterface->Send(RecvDataChain, &PeerAddress);
     }
 };
@@ -116,56 +242,157 @@ struct LbPrivateInterface : public LbInterface {
 //
 // Represents the public listening socket that load balances (and NATs) UDP
 // packets between public clients and back end (private) server addresses.
+// The datapath receives on a socket per processor, so the NAT table is
+// sharded to keep the receive threads from contending on a single lock.
+//
+// Deleting a private interface closes its socket, which waits on the datapath
+// threads, so it can't be done from a receive callback. Entries are shared
+// with the receive path while it uses them, and only Sweep, on its own
+// thread, removes and deletes them.
 //
 struct LbPublicInterface : public LbInterface {
+    typedef std::pair<QUIC_ADDR, uint32_t> NatKey; // Client address, backend
+
     struct Hasher {
-        CXPLAT_TOEPLITZ_HASH Toeplitz;
-        Hasher() {
-            CxPlatRandom(CXPLAT_TOEPLITZ_KEY_SIZE, &Toeplitz.HashKey);
-            CxPlatToeplitzHashInitialize(&Toeplitz);
-        }
-        size_t operator() (const std::pair<QUIC_ADDR, QUIC_ADDR> key) const {
+        size_t operator() (const NatKey& key) const {
             uint32_t Key = 0, Offset;
-            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.first, &Key, &Offset);
-            CxPlatToeplitzHashComputeAddr(&Toeplitz, &key.second, &Key, &Offset);
-            return Key;
+            CxPlatToeplitzHashComputeAddr(&PublicInterfaceHash(), &key.first, &Key, &Offset);
+            return Key ^ key.second;
         }
     };
 
     struct EqualFn {
-        bool operator() (const std::pair<QUIC_ADDR, QUIC_ADDR>& t1, const std::pair<QUIC_ADDR, QUIC_ADDR>& t2) const {
-            return QuicAddrCompare(&t1.second, &t2.second);
+        bool operator() (const NatKey& t1, const NatKey& t2) const {
+            return t1.second == t2.second && QuicAddrCompare(&t1.first, &t2.first);
         }
     };
 
-    std::unordered_map<std::pair<QUIC_ADDR, QUIC_ADDR>, LbPrivateInterface*, Hasher, EqualFn> PrivateInterfaces;
-    std::mutex Lock;
-    uint32_t NextInterface = 0;
+    typedef std::shared_ptr<LbPrivateInterface> PrivateInterfacePtr;
 
-    LbPublicInterface(_In_ const QUIC_ADDR* PublicAddress) : LbInterface(PublicAddress, true) { }
+    struct Shard {
+        std::mutex Lock;
+        std::unordered_map<NatKey, PrivateInterfacePtr, Hasher, EqualFn> PrivateInterfaces;
+    };
+
+    static constexpr uint32_t ShardCount = 64;
+    Shard Shards[ShardCount];
 
-    ~LbPublicInterface() {
-        // TODO - Iterate over private interfaces and delete
+    static CXPLAT_TOEPLITZ_HASH& PublicInterfaceHash() {
+        static struct Toeplitz {
+            CXPLAT_TOEPLITZ_HASH Hash;
+            Toeplitz() {
+                CxPlatRandom(CXPLAT_TOEPLITZ_KEY_SIZE, &Hash.HashKey);
+                CxPlatToeplitzHashInitialize(&Hash);
+            }
+        } Instance;
+        return Instance.Hash;
     }
 
+    LbPublicInterface(_In_ const QUIC_ADDR* PublicAddress) : LbInterface(PublicAddress, true) { }
+
     void Receive(_In_ CXPLAT_RECV_DATA* RecvDataChain) {
-        auto PrivateInterface =
-            GetPrivateInterface(
-                &RecvDataChain->Route->LocalAddress,
-                &RecvDataChain->Route->RemoteAddress);
-        PrivateInterface->Send(RecvDataChain);
+        //
+        // A receive chain may hold datagrams from different clients, so route
+        // each run of datagrams going to the same private interface together.
+        // Runs without one (the NAT table is full) are dropped.
+        //
+        CXPLAT_RECV_DATA* Run = RecvDataChain;
+        PrivateInterfacePtr RunTarget = GetPrivateInterface(Run);
+        while (Run) {
+            CXPLAT_RECV_DATA* Last = Run;
+            PrivateInterfacePtr NextTarget;
+            while (Last->Next &&
+                   (NextTarget = GetPrivateInterface(Last->Next)) == RunTarget) {
+                Last = Last->Next;
+            }
+            CXPLAT_RECV_DATA* Next = Last->Next;
+            Last->Next = nullptr;
+            if (RunTarget) {
+                RunTarget->Send(Run);
+            }
+            Last->Next = Next; // The whole chain is returned by the caller.
+            Run = Next;
+            RunTarget = std::move(NextTarget);
+        }
     }
 
-    LbInterface* GetPrivateInterface(_In_ const QUIC_ADDR* Local, _In_ const QUIC_ADDR* Remote) {
-        std::lock_guard<std::mutex> Scope(Lock);
-        auto& Entry = PrivateInterfaces[std::pair{*Local, *Remote}];
-        if (!Entry) {
-            Entry = new LbPrivateInterface(&PrivateAddrs[NextInterface++ % PrivateAddrs.size()], Remote);
+    //
+    // Removes and deletes the entries that have been idle for at least
+    // IdleTimeoutUs and aren't being used by a receive.
+    //
+    void Sweep(_In_ uint64_t IdleTimeoutUs) {
+        std::vector<PrivateInterfacePtr> Expired;
+        const uint64_t TimeNow = CxPlatTimeUs64();
+        for (auto& Shard : Shards) {
+            std::lock_guard<std::mutex> Scope(Shard.Lock);
+            auto Entry = Shard.PrivateInterfaces.begin();
+            while (Entry != Shard.PrivateInterfaces.end()) {
+                //
+                // New references are only taken under the lock, so an entry
+                // only the table holds can't be picked up while it's removed.
+                //
+                const uint64_t LastUsed = Entry->second->LastUsedUs.load(std::memory_order_relaxed);
+                if (Entry->second.use_count() == 1 &&
+                    CxPlatTimeDiff64(LastUsed, TimeNow) >= IdleTimeoutUs) {
+                    Expired.push_back(std::move(Entry->second));
+                    Entry = Shard.PrivateInterfaces.erase(Entry);
+                } else {
+                    ++Entry;
+                }
+            }
         }
-        return Entry;
+        NatExpiredCount.fetch_add(Expired.size(), std::memory_order_relaxed);
+        Expired.clear(); // Outside the locks, since it waits on the datapath.
+    }
+
+    PrivateInterfacePtr GetPrivateInterface(_In_ const CXPLAT_RECV_DATA* RecvData) {
+        const QUIC_ADDR* Local = &RecvData->Route->LocalAddress;
+        const QUIC_ADDR* Remote = &RecvData->Route->RemoteAddress;
+
+        uint32_t Backend;
+        if (DecodeBackend(RecvData->Buffer, RecvData->BufferLength, &Backend)) {
+            CidRoutedCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            uint32_t Key = 0, Offset;
+            CxPlatToeplitzHashComputeAddr(&PublicInterfaceHash(), Local, &Key, &Offset);
+            CxPlatToeplitzHashComputeAddr(&PublicInterfaceHash(), Remote, &Key, &Offset);
+            Backend = Key % (uint32_t)PrivateAddrs.size();
+            HashRoutedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const NatKey Key{*Remote, Backend};
+        auto& Shard = Shards[Hasher()(Key) % ShardCount];
+        std::lock_guard<std::mutex> Scope(Shard.Lock);
+        auto Entry = Shard.PrivateInterfaces.find(Key);
+        if (Entry != Shard.PrivateInterfaces.end()) {
+            Entry->second->LastUsedUs.store(CxPlatTimeUs64(), std::memory_order_relaxed);
+            return Entry->second;
+        }
+        if (Shard.PrivateInterfaces.size() >= (NatMaxEntries + ShardCount - 1) / ShardCount) {
+            NatFullDropCount.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return Shard.PrivateInterfaces[Key] =
+            std::make_shared<LbPrivateInterface>(&PrivateAddrs[Backend], Remote);
     }
 };
 
+CXPLAT_EVENT NatSweepStop;
+
+CXPLAT_THREAD_CALLBACK(NatSweepThread, Context)
+{
+    auto Public = (LbPublicInterface*)Context;
+    const uint64_t IdleTimeoutUs = S_TO_US((uint64_t)NatIdleTimeoutS);
+    //
+    // Sweep four times per timeout, but at least every 15 seconds.
+    //
+    const uint32_t IntervalMs = CXPLAT_MIN(NatIdleTimeoutS, 60u) * 250;
+    while (!CxPlatEventWaitWithTimeout(NatSweepStop, IntervalMs)) {
+        Public->Sweep(IdleTimeoutUs);
+    }
+    CXPLAT_THREAD_RETURN(0);
+}
+
 void LbReceive(_In_ CXPLAT_SOCKET*, _In_ void* Context, _In_ CXPLAT_RECV_DATA* RecvDataChain) {
     ((LbInterface*)(Context))->Receive(RecvDataChain);
     CxPlatRecvDataReturn(RecvDataChain);
@@ -181,11 +408,49 @@ main(int argc, char **argv)
     const char* PrivateAddresses = "";
     if (!TryGetValue(argc, argv, "pub", &PublicAddress) ||
         !TryGetValue(argc, argv, "priv", &PrivateAddresses)) {
-        printf("Usage: quiclb -pub:<address> -priv:<address>,<address>\n");
+        printf(
+            "Usage: quiclb -pub:<address> -priv:<address>,<address>\n"
+            "         [-lbmode:<hash|plaintext|encrypted>] [-configid:<0-6>]\n"
+            "         [-sidlen:<1-4>] [-key:<hex_bytes>]\n"
+            "         [-natidle:<seconds>] [-natmax:<entries>] [-v]\n");
         exit(1);
     }
     Verbose = GetFlag(argc, argv, "v") || GetFlag(argc, argv, "verbose");
 
+    const char* ModeStr = "hash";
+    TryGetValue(argc, argv, "lbmode", &ModeStr);
+    if (!strcmp(ModeStr, "plaintext")) {
+        Mode = LbModePlaintext;
+    } else if (!strcmp(ModeStr, "encrypted")) {
+        Mode = LbModeEncrypted;
+    } else if (strcmp(ModeStr, "hash")) {
+        printf("Unknown -lbmode: %s.\n", ModeStr);
+        exit(1);
+    }
+
+    TryGetValue(argc, argv, "configid", &ConfigId);
+    TryGetValue(argc, argv, "sidlen", &ServerIdLength);
+    if (ConfigId >= QUIC_LB_UNROUTABLE_CONFIG_ID ||
+        ServerIdLength == 0 || ServerIdLength > sizeof(uint32_t)) {
+        printf("Invalid -configid or -sidlen.\n");
+        exit(1);
+    }
+
+    TryGetValue(argc, argv, "natidle", &NatIdleTimeoutS);
+    TryGetValue(argc, argv, "natmax", &NatMaxEntries);
+    if (NatIdleTimeoutS == 0 || NatMaxEntries == 0) {
+        printf("Invalid -natidle or -natmax.\n");
+        exit(1);
+    }
+
+    const char* KeyStr = nullptr;
+    if (Mode == LbModeEncrypted &&
+        (!TryGetValue(argc, argv, "key", &KeyStr) ||
+         DecodeHexBuffer(KeyStr, sizeof(LbKey), LbKey) != sizeof(LbKey))) {
+        printf("-lbmode:encrypted needs a 16 byte hex -key.\n");
+        exit(1);
+    }
+
     QUIC_ADDR PublicAddr;
     if (!QuicAddrFromString(PublicAddress, 0, &PublicAddr) ||
         !QuicAddrGetPort(&PublicAddr)) {
@@ -214,15 +479,38 @@ main(int argc, char **argv)
 
     CXPLAT_UDP_DATAPATH_CALLBACKS LbUdpCallbacks { LbReceive, NoOpUnreachable };
     CxPlatDataPathInitialize(0, &LbUdpCallbacks, nullptr, &Datapath);
-    PublicInterface = new LbPublicInterface(&PublicAddr);
+    auto Public = new LbPublicInterface(&PublicAddr);
+    PublicInterface = Public;
+
+    CxPlatEventInitialize(&NatSweepStop, TRUE, FALSE);
+    CXPLAT_THREAD_CONFIG SweepConfig = { 0, 0, "lb_nat_sweep", NatSweepThread, Public };
+    CXPLAT_THREAD SweepThread;
+    if (QUIC_FAILED(CxPlatThreadCreate(&SweepConfig, &SweepThread))) {
+        printf("CxPlatThreadCreate failed.\n");
+        exit(1);
+    }
 
     printf("Press Enter to exit.\n\n");
     getchar();
 
+    CxPlatEventSet(NatSweepStop);
+    CxPlatThreadWait(&SweepThread);
+    CxPlatThreadDelete(&SweepThread);
+    CxPlatEventUninitialize(NatSweepStop);
+
     delete PublicInterface;
     CxPlatDataPathUninitialize(Datapath);
     CxPlatUninitialize();
     CxPlatSystemUnload();
 
+    printf(
+        "Routed %llu packets by CID, %llu by address hash.\n",
+        (unsigned long long)CidRoutedCount.load(),
+        (unsigned long long)HashRoutedCount.load());
+    printf(
+        "Expired %llu NAT entries, dropped %llu packets with the NAT table full.\n",
+        (unsigned long long)NatExpiredCount.load(),
+        (unsigned long long)NatFullDropCount.load());
+
     return 0;
 }